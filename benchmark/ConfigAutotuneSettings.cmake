@@ -33,6 +33,10 @@ function(read_config_autotune_settings file list_across_names list_across output
     set(list_across "${TUNING_TYPES};\
 true;false true;32 64 128 256 512 1024" PARENT_SCOPE)
     set(output_pattern_suffix "@DataType@_@Left@_@InPlace@_@BlockSize@" PARENT_SCOPE)
+  elseif(file STREQUAL "benchmark_device_gather_scatter")
+    set(list_across_names "DataType;Scatter;BlockSize" PARENT_SCOPE)
+    set(list_across "${TUNING_TYPES};false true;64 128 256 512 1024" PARENT_SCOPE)
+    set(output_pattern_suffix "@DataType@_@Scatter@_@BlockSize@" PARENT_SCOPE)
   elseif(file STREQUAL "benchmark_device_histogram")
     set(list_across_names "DataType;BlockSize" PARENT_SCOPE)
     set(list_across "${TUNING_TYPES};64 128 256" PARENT_SCOPE)
@@ -67,10 +71,10 @@ ${TUNING_TYPES};rocprim::empty_type ${LIMITED_TUNING_TYPES};\
 ${TUNING_TYPES};64 128 256;1 2 4 8 16" PARENT_SCOPE)
     set(output_pattern_suffix "@DataType@_@BlockSize@_@ItemsPerThread@" PARENT_SCOPE)
   elseif(file STREQUAL "benchmark_device_scan")
-    set(list_across_names "DataType;Algo" PARENT_SCOPE)
+    set(list_across_names "DataType;Algo;ScanAlgo" PARENT_SCOPE)
     set(list_across "\
-${TUNING_TYPES};using_warp_scan reduce_then_scan" PARENT_SCOPE)
-    set(output_pattern_suffix "@DataType@_@Algo@" PARENT_SCOPE)
+${TUNING_TYPES};using_warp_scan reduce_then_scan;lookback reduce_then_scan" PARENT_SCOPE)
+    set(output_pattern_suffix "@DataType@_@Algo@_@ScanAlgo@" PARENT_SCOPE)
   elseif(file STREQUAL "benchmark_device_scan_by_key")
     set(list_across_names "KeyType;ValueType;Algo" PARENT_SCOPE)
     set(list_across "\
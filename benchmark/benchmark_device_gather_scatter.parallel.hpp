@@ -0,0 +1,256 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef ROCPRIM_BENCHMARK_DEVICE_GATHER_SCATTER_PARALLEL_HPP_
+#define ROCPRIM_BENCHMARK_DEVICE_GATHER_SCATTER_PARALLEL_HPP_
+
+#include "benchmark_utils.hpp"
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// HIP API
+#include <hip/hip_runtime_api.h>
+
+// rocPRIM
+#include <rocprim/device/device_gather_scatter.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+
+// How far the indices are from the identity permutation
+enum class index_locality
+{
+    sorted, // identity
+    nearly_sorted, // every other window of 32 indices is shuffled
+    block_shuffled, // blocks of 1024 consecutive indices in random order
+    random // random permutation
+};
+
+inline std::string index_locality_name(const index_locality locality)
+{
+    switch(locality)
+    {
+        case index_locality::sorted: return "sorted";
+        case index_locality::nearly_sorted: return "nearly_sorted";
+        case index_locality::block_shuffled: return "block_shuffled";
+        case index_locality::random: return "random";
+    }
+    return "unknown";
+}
+
+template<class Index>
+std::vector<Index> generate_indices(const size_t size, const index_locality locality)
+{
+    std::vector<Index> indices(size);
+    std::iota(indices.begin(), indices.end(), Index(0));
+
+    std::mt19937_64 gen{std::random_device{}()};
+    switch(locality)
+    {
+        case index_locality::sorted: break;
+        case index_locality::nearly_sorted:
+        {
+            constexpr size_t window = 32;
+            for(size_t i = 0; i < size; i += 2 * window)
+            {
+                std::shuffle(indices.begin() + i, indices.begin() + std::min(size, i + window), gen);
+            }
+            break;
+        }
+        case index_locality::block_shuffled:
+        {
+            constexpr size_t   block = 1024;
+            std::vector<Index> blocks((size + block - 1) / block);
+            std::iota(blocks.begin(), blocks.end(), Index(0));
+            std::shuffle(blocks.begin(), blocks.end(), gen);
+            for(size_t i = 0; i < size; i++)
+            {
+                // The last block may be partial, only blocks that fit are moved to its place
+                const size_t target = blocks[i / block] * block + i % block;
+                indices[i]          = static_cast<Index>(target < size ? target : i);
+            }
+            break;
+        }
+        case index_locality::random: std::shuffle(indices.begin(), indices.end(), gen); break;
+    }
+    return indices;
+}
+
+template<typename Config>
+std::string config_name()
+{
+    auto config = Config();
+    return "{bs:" + std::to_string(config.block_size)
+           + ",ipt:" + std::to_string(config.items_per_thread)
+           + ",runs:" + std::to_string(config.detect_runs) + "}";
+}
+
+template<>
+inline std::string config_name<rocprim::default_config>()
+{
+    return "default_config";
+}
+
+template<typename T,
+         bool           Scatter,
+         index_locality Locality,
+         typename Config = rocprim::default_config,
+         typename Index  = unsigned int>
+struct device_gather_scatter_benchmark : public config_autotune_interface
+{
+    std::string name() const override
+    {
+        using namespace std::string_literals;
+        return bench_naming::format_name("{lvl:device,algo:"s + (Scatter ? "scatter"s : "gather"s)
+                                         + ",value_type:" + std::string(Traits<T>::name())
+                                         + ",index_type:" + std::string(Traits<Index>::name())
+                                         + ",locality:" + index_locality_name(Locality)
+                                         + ",cfg:" + config_name<Config>() + "}");
+    }
+
+    static constexpr unsigned int batch_size  = 10;
+    static constexpr unsigned int warmup_size = 5;
+
+    hipError_t dispatch(std::false_type /*scatter*/,
+                        const T*          input,
+                        const Index*      indices,
+                        T*                output,
+                        const size_t      size,
+                        const hipStream_t stream) const
+    {
+        return rocprim::gather<Config>(input, indices, output, size, stream);
+    }
+
+    hipError_t dispatch(std::true_type /*scatter*/,
+                        const T*          input,
+                        const Index*      indices,
+                        T*                output,
+                        const size_t      size,
+                        const hipStream_t stream) const
+    {
+        return rocprim::scatter<Config>(input, indices, output, size, stream);
+    }
+
+    void run(benchmark::State& state,
+             const std::size_t size,
+             const hipStream_t stream) const override
+    {
+        // Generate data
+        const std::vector<T>     input   = get_random_data<T>(size, 1, 100);
+        const std::vector<Index> indices = generate_indices<Index>(size, Locality);
+
+        T*     d_input;
+        Index* d_indices;
+        T*     d_output;
+        HIP_CHECK(hipMalloc(&d_input, size * sizeof(T)));
+        HIP_CHECK(hipMalloc(&d_indices, size * sizeof(Index)));
+        HIP_CHECK(hipMalloc(&d_output, size * sizeof(T)));
+        HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+        HIP_CHECK(
+            hipMemcpy(d_indices, indices.data(), size * sizeof(Index), hipMemcpyHostToDevice));
+
+        static constexpr auto scatter_tag = rocprim::detail::bool_constant<Scatter>{};
+
+        // Warm-up
+        for(size_t i = 0; i < warmup_size; i++)
+        {
+            HIP_CHECK(dispatch(scatter_tag, d_input, d_indices, d_output, size, stream));
+        }
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // HIP events creation
+        hipEvent_t start, stop;
+        HIP_CHECK(hipEventCreate(&start));
+        HIP_CHECK(hipEventCreate(&stop));
+
+        // Run
+        for(auto _ : state)
+        {
+            // Record start event
+            HIP_CHECK(hipEventRecord(start, stream));
+
+            for(size_t i = 0; i < batch_size; i++)
+            {
+                HIP_CHECK(dispatch(scatter_tag, d_input, d_indices, d_output, size, stream));
+            }
+
+            // Record stop event and wait until it completes
+            HIP_CHECK(hipEventRecord(stop, stream));
+            HIP_CHECK(hipEventSynchronize(stop));
+
+            float elapsed_mseconds;
+            HIP_CHECK(hipEventElapsedTime(&elapsed_mseconds, start, stop));
+            state.SetIterationTime(elapsed_mseconds / 1000);
+        }
+
+        // Destroy HIP events
+        HIP_CHECK(hipEventDestroy(start));
+        HIP_CHECK(hipEventDestroy(stop));
+
+        // Values are read and written once, indices are read once
+        state.SetBytesProcessed(state.iterations() * batch_size * size
+                                * (2 * sizeof(T) + sizeof(Index)));
+        state.SetItemsProcessed(state.iterations() * batch_size * size);
+
+        HIP_CHECK(hipFree(d_input));
+        HIP_CHECK(hipFree(d_indices));
+        HIP_CHECK(hipFree(d_output));
+    }
+};
+
+// Configs are tuned for random indices, which is the case the defaults must handle well
+template<typename T, unsigned int BlockSize, bool Scatter>
+struct device_gather_scatter_benchmark_generator
+{
+    template<unsigned int ItemsPerThreadExponent>
+    struct create_ipt
+    {
+        static constexpr unsigned int items_per_thread = 1u << ItemsPerThreadExponent;
+        using generated_config
+            = std::conditional_t<Scatter,
+                                 rocprim::scatter_config<BlockSize, items_per_thread>,
+                                 rocprim::gather_config<BlockSize, items_per_thread>>;
+
+        void operator()(std::vector<std::unique_ptr<config_autotune_interface>>& storage)
+        {
+            storage.emplace_back(
+                std::make_unique<device_gather_scatter_benchmark<T,
+                                                                 Scatter,
+                                                                 index_locality::random,
+                                                                 generated_config>>());
+        }
+    };
+
+    static void create(std::vector<std::unique_ptr<config_autotune_interface>>& storage)
+    {
+        static_for_each<make_index_range<unsigned int, 0, 4>, create_ipt>(storage);
+    }
+};
+
+#endif // ROCPRIM_BENCHMARK_DEVICE_GATHER_SCATTER_PARALLEL_HPP_
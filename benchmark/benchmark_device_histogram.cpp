@@ -161,6 +161,25 @@ void run_even_benchmark(benchmark::State& state,
     state.SetBytesProcessed(state.iterations() * batch_size * size * sizeof(T));
     state.SetItemsProcessed(state.iterations() * batch_size * size);
 
+    if(instrumentation_enabled())
+    {
+        add_histogram_counters(state,
+                               stream,
+                               [&]
+                               {
+                                   return rp::histogram_even(d_temporary_storage,
+                                                             temporary_storage_bytes,
+                                                             d_input,
+                                                             size,
+                                                             d_histogram,
+                                                             bins + 1,
+                                                             lower_level,
+                                                             upper_level,
+                                                             stream,
+                                                             false);
+                               });
+    }
+
     HIP_CHECK(hipFree(d_temporary_storage));
     HIP_CHECK(hipFree(d_input));
     HIP_CHECK(hipFree(d_histogram));
@@ -273,6 +292,26 @@ void run_multi_even_benchmark(benchmark::State& state,
     state.SetBytesProcessed(state.iterations() * batch_size * size * Channels * sizeof(T));
     state.SetItemsProcessed(state.iterations() * batch_size * size * Channels);
 
+    if(instrumentation_enabled())
+    {
+        add_histogram_counters(state,
+                               stream,
+                               [&]
+                               {
+                                   return rp::multi_histogram_even<Channels, ActiveChannels>(
+                                       d_temporary_storage,
+                                       temporary_storage_bytes,
+                                       d_input,
+                                       size,
+                                       d_histogram,
+                                       num_levels,
+                                       lower_level,
+                                       upper_level,
+                                       stream,
+                                       false);
+                               });
+    }
+
     HIP_CHECK(hipFree(d_temporary_storage));
     HIP_CHECK(hipFree(d_input));
     for(unsigned int channel = 0; channel < ActiveChannels; channel++)
@@ -376,6 +415,24 @@ void run_range_benchmark(benchmark::State& state, size_t bins, hipStream_t strea
     state.SetBytesProcessed(state.iterations() * batch_size * size * sizeof(T));
     state.SetItemsProcessed(state.iterations() * batch_size * size);
 
+    if(instrumentation_enabled())
+    {
+        add_histogram_counters(state,
+                               stream,
+                               [&]
+                               {
+                                   return rp::histogram_range(d_temporary_storage,
+                                                              temporary_storage_bytes,
+                                                              d_input,
+                                                              size,
+                                                              d_histogram,
+                                                              bins + 1,
+                                                              d_levels,
+                                                              stream,
+                                                              false);
+                               });
+    }
+
     HIP_CHECK(hipFree(d_temporary_storage));
     HIP_CHECK(hipFree(d_input));
     HIP_CHECK(hipFree(d_levels));
@@ -496,6 +553,25 @@ void run_multi_range_benchmark(benchmark::State& state,
     state.SetBytesProcessed(state.iterations() * batch_size * size * Channels * sizeof(T));
     state.SetItemsProcessed(state.iterations() * batch_size * size * Channels);
 
+    if(instrumentation_enabled())
+    {
+        add_histogram_counters(state,
+                               stream,
+                               [&]
+                               {
+                                   return rp::multi_histogram_range<Channels, ActiveChannels>(
+                                       d_temporary_storage,
+                                       temporary_storage_bytes,
+                                       d_input,
+                                       size,
+                                       d_histogram,
+                                       num_levels,
+                                       d_levels,
+                                       stream,
+                                       false);
+                               });
+    }
+
     HIP_CHECK(hipFree(d_temporary_storage));
     HIP_CHECK(hipFree(d_input));
     for(unsigned int channel = 0; channel < ActiveChannels; channel++)
@@ -643,6 +719,10 @@ int main(int argc, char* argv[])
                                      "name_format",
                                      "human",
                                      "either: json,human,txt");
+    parser.set_optional<bool>("instrument",
+                              "instrument",
+                              false,
+                              "report atomic counters (requires ROCPRIM_INSTRUMENT=1)");
 #ifdef BENCHMARK_CONFIG_TUNING
     // optionally run an evenly split subset of benchmarks, when making multiple program invocations
     parser.set_optional<int>("parallel_instance",
@@ -661,6 +741,14 @@ int main(int argc, char* argv[])
     const size_t size   = parser.get<size_t>("size");
     const int    trials = parser.get<int>("trials");
     bench_naming::set_format(parser.get<std::string>("name_format"));
+    instrumentation_enabled() = parser.get<bool>("instrument");
+#if !ROCPRIM_INSTRUMENT
+    if(instrumentation_enabled())
+    {
+        std::cerr << "--instrument requires ROCPRIM_INSTRUMENT=1" << std::endl;
+        return 1;
+    }
+#endif
 
     // HIP
     hipStream_t stream = 0; // default
@@ -411,6 +411,8 @@ void run_benchmark(benchmark::State& state,
 
     state.SetBytesProcessed(state.iterations() * batch_size * size * sizeof(T));
     state.SetItemsProcessed(state.iterations() * batch_size * size);
+    // Every item is read and written, this is the bandwidth that the other benchmarks compare to
+    add_bandwidth_counters(state, batch_size * copy_ideal_bytes(size, sizeof(T)));
 
     HIP_CHECK(hipFree(d_input));
     HIP_CHECK(hipFree(d_output));
@@ -467,6 +469,8 @@ void run_benchmark_memcpy(benchmark::State& state,
 
     state.SetBytesProcessed(state.iterations() * batch_size * size * sizeof(T));
     state.SetItemsProcessed(state.iterations() * batch_size * size);
+    // Every item is read and written, this is the bandwidth that the other benchmarks compare to
+    add_bandwidth_counters(state, batch_size * copy_ideal_bytes(size, sizeof(T)));
 
     HIP_CHECK(hipFree(d_input));
     HIP_CHECK(hipFree(d_output));
@@ -505,6 +509,10 @@ int main(int argc, char *argv[])
                                      "name_format",
                                      "human",
                                      "either: json,human,txt");
+    parser.set_optional<double>("peak_bandwidth",
+                                "peak_bandwidth",
+                                0,
+                                "peak memory bandwidth in GB/s (measured if 0)");
     parser.run_and_exit_if_error();
 
     // Parse argv
@@ -517,6 +525,7 @@ int main(int argc, char *argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_peak_bandwidth(parser.get<double>("peak_bandwidth"), stream);
 
     // Add benchmarks
     std::vector<benchmark::internal::Benchmark*> benchmarks =
@@ -0,0 +1,307 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "benchmark_utils.hpp"
+
+#include <rocprim/device/device_plan.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <hip/hip_runtime.h>
+
+#include <chrono>
+#include <vector>
+
+// Measures the host time of a device-level call with and without an execution plan. Only the
+// time spent in the call is counted, the kernels finish outside of the measured time. The plan
+// is compared against the call with a storage size queried once (cached), as applications
+// usually call the algorithms, and against the size query and call in each iteration (direct).
+
+constexpr size_t plan_benchmark_size = 1 << 16;
+
+enum class call_kind
+{
+    direct, // size query and call in each iteration
+    cached, // call with the storage size queried once
+    plan // execute of a plan made once
+};
+
+template<class Function>
+void run_host_benchmark(benchmark::State& state, const hipStream_t stream, Function&& function)
+{
+    for(auto _ : state)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        function();
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        HIP_CHECK(hipStreamSynchronize(stream));
+        state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+    }
+}
+
+// query(storage_size) and call(storage_size) are the two calls of the regular API,
+// execute() is the call of the plan
+template<class Query, class Call, class Execute>
+void run_call_benchmark(benchmark::State& state,
+                        const hipStream_t stream,
+                        const call_kind   kind,
+                        Query&&           query,
+                        Call&&            call,
+                        Execute&&         execute)
+{
+    switch(kind)
+    {
+        case call_kind::direct:
+            run_host_benchmark(state,
+                               stream,
+                               [&]
+                               {
+                                   size_t storage_size;
+                                   query(storage_size);
+                                   call(storage_size);
+                               });
+            break;
+        case call_kind::cached:
+        {
+            size_t storage_size;
+            query(storage_size);
+            run_host_benchmark(state, stream, [&] { call(storage_size); });
+            break;
+        }
+        case call_kind::plan: run_host_benchmark(state, stream, execute); break;
+    }
+}
+
+static void BM_radix_sort_keys(benchmark::State& state, const call_kind kind)
+{
+    static constexpr hipStream_t stream = 0;
+    const size_t                 size   = plan_benchmark_size;
+
+    std::vector<unsigned int> input = get_random_data<unsigned int>(size, 0, 1 << 30);
+    unsigned int*             d_input;
+    unsigned int*             d_output;
+    HIP_CHECK(hipMalloc(&d_input, size * sizeof(unsigned int)));
+    HIP_CHECK(hipMalloc(&d_output, size * sizeof(unsigned int)));
+    HIP_CHECK(
+        hipMemcpy(d_input, input.data(), size * sizeof(unsigned int), hipMemcpyHostToDevice));
+
+    rocprim::radix_sort_plan<unsigned int> plan;
+    HIP_CHECK(rocprim::make_radix_sort_plan(plan, size));
+    void* d_temp_storage;
+    HIP_CHECK(hipMalloc(&d_temp_storage, plan.temporary_storage_bytes()));
+
+    run_call_benchmark(
+        state,
+        stream,
+        kind,
+        [&](size_t& storage_size)
+        {
+            HIP_CHECK(rocprim::radix_sort_keys(nullptr,
+                                               storage_size,
+                                               d_input,
+                                               d_output,
+                                               size,
+                                               0,
+                                               32,
+                                               stream));
+        },
+        [&](size_t storage_size)
+        {
+            HIP_CHECK(rocprim::radix_sort_keys(d_temp_storage,
+                                               storage_size,
+                                               d_input,
+                                               d_output,
+                                               size,
+                                               0,
+                                               32,
+                                               stream));
+        },
+        [&] { HIP_CHECK(plan.execute(d_temp_storage, d_input, d_output)); });
+
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_temp_storage));
+}
+
+static void BM_merge_sort_keys(benchmark::State& state, const call_kind kind)
+{
+    static constexpr hipStream_t stream = 0;
+    const size_t                 size   = plan_benchmark_size;
+
+    std::vector<int> input = get_random_data<int>(size, 0, 1 << 30);
+    int*             d_input;
+    int*             d_output;
+    HIP_CHECK(hipMalloc(&d_input, size * sizeof(int)));
+    HIP_CHECK(hipMalloc(&d_output, size * sizeof(int)));
+    HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(int), hipMemcpyHostToDevice));
+
+    rocprim::merge_sort_plan<int> plan;
+    HIP_CHECK(rocprim::make_merge_sort_plan(plan, size));
+    void* d_temp_storage;
+    HIP_CHECK(hipMalloc(&d_temp_storage, plan.temporary_storage_bytes()));
+
+    run_call_benchmark(
+        state,
+        stream,
+        kind,
+        [&](size_t& storage_size)
+        {
+            HIP_CHECK(rocprim::merge_sort(nullptr,
+                                          storage_size,
+                                          d_input,
+                                          d_output,
+                                          size,
+                                          rocprim::less<int>(),
+                                          stream));
+        },
+        [&](size_t storage_size)
+        {
+            HIP_CHECK(rocprim::merge_sort(d_temp_storage,
+                                          storage_size,
+                                          d_input,
+                                          d_output,
+                                          size,
+                                          rocprim::less<int>(),
+                                          stream));
+        },
+        [&] { HIP_CHECK(plan.execute(d_temp_storage, d_input, d_output)); });
+
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_temp_storage));
+}
+
+static void BM_reduce(benchmark::State& state, const call_kind kind)
+{
+    static constexpr hipStream_t stream = 0;
+    const size_t                 size   = plan_benchmark_size;
+
+    std::vector<int> input = get_random_data<int>(size, 0, 100);
+    int*             d_input;
+    int*             d_output;
+    HIP_CHECK(hipMalloc(&d_input, size * sizeof(int)));
+    HIP_CHECK(hipMalloc(&d_output, sizeof(int)));
+    HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(int), hipMemcpyHostToDevice));
+
+    rocprim::reduce_plan<int> plan;
+    HIP_CHECK(rocprim::make_reduce_plan(plan, size));
+    void* d_temp_storage;
+    HIP_CHECK(hipMalloc(&d_temp_storage, plan.temporary_storage_bytes()));
+
+    run_call_benchmark(
+        state,
+        stream,
+        kind,
+        [&](size_t& storage_size)
+        {
+            HIP_CHECK(rocprim::reduce(nullptr,
+                                      storage_size,
+                                      d_input,
+                                      d_output,
+                                      size,
+                                      rocprim::plus<int>(),
+                                      stream));
+        },
+        [&](size_t storage_size)
+        {
+            HIP_CHECK(rocprim::reduce(d_temp_storage,
+                                      storage_size,
+                                      d_input,
+                                      d_output,
+                                      size,
+                                      rocprim::plus<int>(),
+                                      stream));
+        },
+        [&] { HIP_CHECK(plan.execute(d_temp_storage, d_input, d_output)); });
+
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_temp_storage));
+}
+
+static void BM_inclusive_scan(benchmark::State& state, const call_kind kind)
+{
+    static constexpr hipStream_t stream = 0;
+    const size_t                 size   = plan_benchmark_size;
+
+    std::vector<int> input = get_random_data<int>(size, 0, 100);
+    int*             d_input;
+    int*             d_output;
+    HIP_CHECK(hipMalloc(&d_input, size * sizeof(int)));
+    HIP_CHECK(hipMalloc(&d_output, size * sizeof(int)));
+    HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(int), hipMemcpyHostToDevice));
+
+    rocprim::inclusive_scan_plan<int> plan;
+    HIP_CHECK(rocprim::make_inclusive_scan_plan(plan, size));
+    void* d_temp_storage;
+    HIP_CHECK(hipMalloc(&d_temp_storage, plan.temporary_storage_bytes()));
+
+    run_call_benchmark(
+        state,
+        stream,
+        kind,
+        [&](size_t& storage_size)
+        {
+            HIP_CHECK(rocprim::inclusive_scan(nullptr,
+                                              storage_size,
+                                              d_input,
+                                              d_output,
+                                              size,
+                                              rocprim::plus<int>(),
+                                              stream));
+        },
+        [&](size_t storage_size)
+        {
+            HIP_CHECK(rocprim::inclusive_scan(d_temp_storage,
+                                              storage_size,
+                                              d_input,
+                                              d_output,
+                                              size,
+                                              rocprim::plus<int>(),
+                                              stream));
+        },
+        [&] { HIP_CHECK(plan.execute(d_temp_storage, d_input, d_output)); });
+
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_temp_storage));
+}
+
+#define CREATE_PLAN_BENCHMARK(FUNCTION)                                      \
+    BENCHMARK_CAPTURE(FUNCTION, direct, call_kind::direct)->UseManualTime(); \
+    BENCHMARK_CAPTURE(FUNCTION, cached, call_kind::cached)->UseManualTime(); \
+    BENCHMARK_CAPTURE(FUNCTION, plan, call_kind::plan)->UseManualTime()
+
+CREATE_PLAN_BENCHMARK(BM_radix_sort_keys);
+CREATE_PLAN_BENCHMARK(BM_merge_sort_keys);
+CREATE_PLAN_BENCHMARK(BM_reduce);
+CREATE_PLAN_BENCHMARK(BM_inclusive_scan);
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    add_common_benchmark_info();
+    benchmark::AddCustomContext("size", std::to_string(plan_benchmark_size));
+    benchmark::RunSpecifiedBenchmarks();
+}
@@ -49,6 +49,10 @@ int main(int argc, char* argv[])
                                      "name_format",
                                      "human",
                                      "either: json,human,txt");
+    parser.set_optional<double>("peak_bandwidth",
+                                "peak_bandwidth",
+                                0,
+                                "peak memory bandwidth in GB/s (measured if 0)");
 #ifdef BENCHMARK_CONFIG_TUNING
     // optionally run an evenly split subset of benchmarks, when making multiple program invocations
     parser.set_optional<int>("parallel_instance",
@@ -73,6 +77,7 @@ int main(int argc, char* argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_peak_bandwidth(parser.get<double>("peak_bandwidth"), stream);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     // Add benchmarks
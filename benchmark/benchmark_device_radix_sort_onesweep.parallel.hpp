@@ -88,6 +88,19 @@ struct device_radix_sort_onesweep_benchmark : public config_autotune_interface
     static constexpr unsigned int batch_size  = 10;
     static constexpr unsigned int warmup_size = 5;
 
+    // Number of digit places, each one is sorted by a pass of onesweep
+    static unsigned int onesweep_passes(const hipStream_t stream)
+    {
+        using config = rp::detail::wrapped_radix_sort_onesweep_config<Config, Key, Value>;
+
+        rp::detail::target_arch target_arch;
+        HIP_CHECK(rp::detail::host_target_arch(stream, target_arch));
+        const rp::detail::radix_sort_onesweep_config_params params
+            = rp::detail::dispatch_target_arch<config>(target_arch);
+        return rp::detail::ceiling_div<unsigned int>(sizeof(Key) * 8,
+                                                     params.radix_bits_per_place);
+    }
+
     static std::vector<Key> generate_keys(size_t size)
     {
         using key_type = Key;
@@ -218,6 +231,12 @@ struct device_radix_sort_onesweep_benchmark : public config_autotune_interface
 
         state.SetBytesProcessed(state.iterations() * batch_size * size * sizeof(key_type));
         state.SetItemsProcessed(state.iterations() * batch_size * size);
+        add_bandwidth_counters(state,
+                               batch_size
+                                   * radix_sort_onesweep_ideal_bytes(size,
+                                                                     sizeof(key_type),
+                                                                     0,
+                                                                     onesweep_passes(stream)));
 
         HIP_CHECK(hipFree(d_temporary_storage));
         HIP_CHECK(hipFree(d_keys_input));
@@ -349,6 +368,12 @@ struct device_radix_sort_onesweep_benchmark : public config_autotune_interface
         state.SetBytesProcessed(state.iterations() * batch_size * size
                                 * (sizeof(key_type) + sizeof(value_type)));
         state.SetItemsProcessed(state.iterations() * batch_size * size);
+        add_bandwidth_counters(state,
+                               batch_size
+                                   * radix_sort_onesweep_ideal_bytes(size,
+                                                                     sizeof(key_type),
+                                                                     sizeof(value_type),
+                                                                     onesweep_passes(stream)));
 
         HIP_CHECK(hipFree(d_temporary_storage));
         HIP_CHECK(hipFree(d_keys_input));
@@ -45,6 +45,30 @@ const size_t DEFAULT_N = 1024 * 1024 * 128;
         REGISTER_BENCHMARK(benchmarks, size, stream, instance); \
     }
 
+// Default config of value type T, but with the given grid launch mode
+template<class T, rocprim::grid_launch_mode LaunchMode>
+using grid_launch_mode_config
+    = rocprim::reduce_config<256,
+                             ::rocprim::max<unsigned int>(
+                                 1u, 16u / ((sizeof(T) + sizeof(int) - 1) / sizeof(int))),
+                             rocprim::block_reduce_algorithm::using_warp_reduce,
+                             ROCPRIM_GRID_SIZE_LIMIT,
+                             LaunchMode>;
+
+// Compares a block per tile with a persistent grid
+#define CREATE_GRID_LAUNCH_MODE_BENCHMARK(T, REDUCE_OP)                                        \
+    {                                                                                          \
+        using config                                                                           \
+            = grid_launch_mode_config<T, rocprim::grid_launch_mode::one_block_per_tile>;       \
+        const device_reduce_benchmark<T, REDUCE_OP, config> instance;                          \
+        REGISTER_BENCHMARK(benchmarks, size, stream, instance);                                \
+    }                                                                                          \
+    {                                                                                          \
+        using config = grid_launch_mode_config<T, rocprim::grid_launch_mode::persistent>;      \
+        const device_reduce_benchmark<T, REDUCE_OP, config> instance;                          \
+        REGISTER_BENCHMARK(benchmarks, size, stream, instance);                                \
+    }
+
 int main(int argc, char *argv[])
 {
     cli::Parser parser(argc, argv);
@@ -54,6 +78,10 @@ int main(int argc, char *argv[])
                                      "name_format",
                                      "human",
                                      "either: json,human,txt");
+    parser.set_optional<double>("peak_bandwidth",
+                                "peak_bandwidth",
+                                0,
+                                "peak memory bandwidth in GB/s (measured if 0)");
 #ifdef BENCHMARK_CONFIG_TUNING
     // optionally run an evenly split subset of benchmarks, when making multiple program invocations
     parser.set_optional<int>("parallel_instance",
@@ -78,6 +106,7 @@ int main(int argc, char *argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_peak_bandwidth(parser.get<double>("peak_bandwidth"), stream);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     // Add benchmarks
@@ -106,6 +135,10 @@ int main(int argc, char *argv[])
 
     CREATE_BENCHMARK(custom_float2, rocprim::plus<custom_float2>)
     CREATE_BENCHMARK(custom_double2, rocprim::plus<custom_double2>)
+
+    CREATE_GRID_LAUNCH_MODE_BENCHMARK(int, rocprim::plus<int>)
+    CREATE_GRID_LAUNCH_MODE_BENCHMARK(float, rocprim::plus<float>)
+    CREATE_GRID_LAUNCH_MODE_BENCHMARK(custom_double2, rocprim::plus<custom_double2>)
 #endif
 
     // Use manual timing
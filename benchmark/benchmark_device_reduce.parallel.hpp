@@ -60,7 +60,11 @@ std::string config_name()
     const rocprim::detail::reduce_config_params config = Config();
     return "{bs:" + std::to_string(config.reduce_config.block_size)
            + ",ipt:" + std::to_string(config.reduce_config.items_per_thread)
-           + ",method:" + std::string(get_reduce_method_name(config.block_reduce_method)) + "}";
+           + ",method:" + std::string(get_reduce_method_name(config.block_reduce_method))
+           + (config.launch_mode == rocprim::grid_launch_mode::default_mode
+                  ? std::string()
+                  : ",launch:" + std::string(get_grid_launch_mode_name(config.launch_mode)))
+           + "}";
 }
 
 template<>
@@ -168,6 +172,7 @@ struct device_reduce_benchmark : public config_autotune_interface
 
         state.SetBytesProcessed(state.iterations() * batch_size * size * sizeof(T));
         state.SetItemsProcessed(state.iterations() * batch_size * size);
+        add_bandwidth_counters(state, batch_size * reduce_ideal_bytes(size, sizeof(T), sizeof(T)));
 
         HIP_CHECK(hipFree(d_input));
         HIP_CHECK(hipFree(d_output));
@@ -0,0 +1,304 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "benchmark_utils.hpp"
+// CmdParser
+#include "cmdparser.hpp"
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// HIP API
+#include <hip/hip_runtime.h>
+
+// rocPRIM
+#include <rocprim/device/device_run_length_decode.hpp>
+
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifndef DEFAULT_N
+const size_t DEFAULT_N = 1024 * 1024 * 32;
+#endif
+
+namespace rp = rocprim;
+
+// Distribution of the run lengths
+enum class run_length_distribution
+{
+    // Uniform in [1, max_length]
+    uniform,
+    // Half of the runs are empty, the others are uniform in [1, max_length]
+    with_empty,
+    // Runs of length 1 and, rarely, runs of length max_length
+    skewed
+};
+
+inline const char* to_string(const run_length_distribution distribution)
+{
+    switch(distribution)
+    {
+        case run_length_distribution::uniform: return "uniform";
+        case run_length_distribution::with_empty: return "with_empty";
+        case run_length_distribution::skewed: return "skewed";
+    }
+    return "unknown";
+}
+
+template<class T, bool WithRelativeOffsets>
+void run_benchmark(benchmark::State&             state,
+                   const run_length_distribution distribution,
+                   const size_t                  max_length,
+                   hipStream_t                   stream,
+                   size_t                        size)
+{
+    using value_type  = T;
+    using length_type = unsigned int;
+
+    // Generate runs until the decoded size is reached
+    std::default_random_engine                 gen(123);
+    std::uniform_int_distribution<length_type> length_dis(1, static_cast<length_type>(max_length));
+    std::uniform_int_distribution<int>         choice_dis(0, 999);
+
+    std::vector<length_type> run_lengths;
+    size_t                   decoded_size = 0;
+    while(decoded_size < size)
+    {
+        length_type length = 1;
+        switch(distribution)
+        {
+            case run_length_distribution::uniform: length = length_dis(gen); break;
+            case run_length_distribution::with_empty:
+                length = choice_dis(gen) < 500 ? 0 : length_dis(gen);
+                break;
+            case run_length_distribution::skewed:
+                length = choice_dis(gen) == 0 ? static_cast<length_type>(max_length) : 1;
+                break;
+        }
+        length = static_cast<length_type>(std::min<size_t>(length, size - decoded_size));
+        run_lengths.push_back(length);
+        decoded_size += length;
+    }
+    const size_t num_runs = run_lengths.size();
+
+    std::vector<value_type> values = get_random_data<value_type>(num_runs, 0, 100);
+
+    value_type*  d_values;
+    length_type* d_run_lengths;
+    value_type*  d_output;
+    length_type* d_relative_offsets = nullptr;
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_values), num_runs * sizeof(value_type)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_run_lengths), num_runs * sizeof(length_type)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_output), size * sizeof(value_type)));
+    if(WithRelativeOffsets)
+    {
+        HIP_CHECK(
+            hipMalloc(reinterpret_cast<void**>(&d_relative_offsets), size * sizeof(length_type)));
+    }
+    HIP_CHECK(hipMemcpy(d_values,
+                        values.data(),
+                        num_runs * sizeof(value_type),
+                        hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_run_lengths,
+                        run_lengths.data(),
+                        num_runs * sizeof(length_type),
+                        hipMemcpyHostToDevice));
+
+    auto decode = [&](void* d_temporary_storage, size_t& temporary_storage_bytes)
+    {
+        if(WithRelativeOffsets)
+        {
+            return rp::run_length_decode(d_temporary_storage,
+                                         temporary_storage_bytes,
+                                         d_values,
+                                         d_run_lengths,
+                                         num_runs,
+                                         d_output,
+                                         d_relative_offsets,
+                                         stream,
+                                         false);
+        }
+        return rp::run_length_decode(d_temporary_storage,
+                                     temporary_storage_bytes,
+                                     d_values,
+                                     d_run_lengths,
+                                     num_runs,
+                                     d_output,
+                                     stream,
+                                     false);
+    };
+
+    void*  d_temporary_storage     = nullptr;
+    size_t temporary_storage_bytes = 0;
+    HIP_CHECK(decode(d_temporary_storage, temporary_storage_bytes));
+    HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Warm-up
+    for(size_t i = 0; i < 10; i++)
+    {
+        HIP_CHECK(decode(d_temporary_storage, temporary_storage_bytes));
+    }
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // HIP events creation
+    hipEvent_t start, stop;
+    HIP_CHECK(hipEventCreate(&start));
+    HIP_CHECK(hipEventCreate(&stop));
+
+    const unsigned int batch_size = 10;
+    for(auto _ : state)
+    {
+        // Record start event
+        HIP_CHECK(hipEventRecord(start, stream));
+
+        for(size_t i = 0; i < batch_size; i++)
+        {
+            decode(d_temporary_storage, temporary_storage_bytes);
+        }
+
+        // Record stop event and wait until it completes
+        HIP_CHECK(hipEventRecord(stop, stream));
+        HIP_CHECK(hipEventSynchronize(stop));
+
+        float elapsed_mseconds;
+        HIP_CHECK(hipEventElapsedTime(&elapsed_mseconds, start, stop));
+        state.SetIterationTime(elapsed_mseconds / 1000);
+    }
+
+    // Destroy HIP events
+    HIP_CHECK(hipEventDestroy(start));
+    HIP_CHECK(hipEventDestroy(stop));
+
+    // Runs are read, decoded items are written
+    const size_t bytes_per_batch
+        = num_runs * (sizeof(value_type) + sizeof(length_type))
+          + size * (sizeof(value_type) + (WithRelativeOffsets ? sizeof(length_type) : 0));
+    state.SetBytesProcessed(state.iterations() * batch_size * bytes_per_batch);
+    state.SetItemsProcessed(state.iterations() * batch_size * size);
+    state.counters["runs"] = static_cast<double>(num_runs);
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_values));
+    HIP_CHECK(hipFree(d_run_lengths));
+    HIP_CHECK(hipFree(d_output));
+    if(WithRelativeOffsets)
+    {
+        HIP_CHECK(hipFree(d_relative_offsets));
+    }
+}
+
+#define CREATE_BENCHMARK(T, WithRelativeOffsets)                                                 \
+    benchmark::RegisterBenchmark(                                                                \
+        bench_naming::format_name("{lvl:device,algo:run_length_decode,value_type:" #T            \
+                                  ",relative_offsets:" #WithRelativeOffsets ",distribution:"    \
+                                  + std::string(to_string(distribution))                         \
+                                  + ",max_length:" + std::to_string(max_length)                  \
+                                  + ",cfg:default_config}")                                      \
+            .c_str(),                                                                            \
+        run_benchmark<T, WithRelativeOffsets>,                                                   \
+        distribution,                                                                            \
+        max_length,                                                                              \
+        stream,                                                                                  \
+        size)
+
+void add_benchmarks(const run_length_distribution                 distribution,
+                    const size_t                                  max_length,
+                    std::vector<benchmark::internal::Benchmark*>& benchmarks,
+                    hipStream_t                                   stream,
+                    size_t                                        size)
+{
+    using custom_double2 = custom_type<double, double>;
+
+    std::vector<benchmark::internal::Benchmark*> bs = {
+        CREATE_BENCHMARK(int, false),
+        CREATE_BENCHMARK(int, true),
+        CREATE_BENCHMARK(int8_t, false),
+        CREATE_BENCHMARK(long long, false),
+        CREATE_BENCHMARK(custom_double2, false),
+    };
+
+    benchmarks.insert(benchmarks.end(), bs.begin(), bs.end());
+}
+
+int main(int argc, char* argv[])
+{
+    cli::Parser parser(argc, argv);
+    parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of decoded values");
+    parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    parser.set_optional<std::string>("name_format",
+                                     "name_format",
+                                     "human",
+                                     "either: json,human,txt");
+    parser.run_and_exit_if_error();
+
+    // Parse argv
+    benchmark::Initialize(&argc, argv);
+    const size_t size   = parser.get<size_t>("size");
+    const int    trials = parser.get<int>("trials");
+    bench_naming::set_format(parser.get<std::string>("name_format"));
+
+    // HIP
+    hipStream_t stream = 0; // default
+
+    // Benchmark info
+    add_common_benchmark_info();
+    benchmark::AddCustomContext("size", std::to_string(size));
+
+    // Add benchmarks
+    std::vector<benchmark::internal::Benchmark*> benchmarks;
+    for(const size_t max_length : {1, 10, 100, 1000})
+    {
+        add_benchmarks(run_length_distribution::uniform, max_length, benchmarks, stream, size);
+    }
+    for(const size_t max_length : {10, 1000})
+    {
+        add_benchmarks(run_length_distribution::with_empty, max_length, benchmarks, stream, size);
+    }
+    for(const size_t max_length : {10000, 1000000})
+    {
+        add_benchmarks(run_length_distribution::skewed, max_length, benchmarks, stream, size);
+    }
+
+    // Use manual timing
+    for(auto& b : benchmarks)
+    {
+        b->UseManualTime();
+        b->Unit(benchmark::kMillisecond);
+    }
+
+    // Force number of iterations
+    if(trials > 0)
+    {
+        for(auto& b : benchmarks)
+        {
+            b->Iterations(trials);
+        }
+    }
+
+    // Run benchmarks
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -49,6 +49,50 @@ const size_t DEFAULT_N = 1024 * 1024 * 32;
     CREATE_EXCL_INCL_BENCHMARK(false, T, SCAN_OP) \
     CREATE_EXCL_INCL_BENCHMARK(true, T, SCAN_OP)
 
+// Default config of value type T, but with the given device scan algorithm and grid launch mode
+template<class T,
+         rocprim::device_scan_algorithm ScanAlgorithm,
+         rocprim::grid_launch_mode      LaunchMode = rocprim::grid_launch_mode::default_mode>
+using scan_algorithm_config
+    = rocprim::scan_config<256,
+                           ::rocprim::max<unsigned int>(
+                               1u, 16u / ((sizeof(T) + sizeof(int) - 1) / sizeof(int))),
+                           rocprim::block_load_method::block_load_transpose,
+                           rocprim::block_store_method::block_store_transpose,
+                           rocprim::block_scan_algorithm::using_warp_scan,
+                           ROCPRIM_GRID_SIZE_LIMIT,
+                           ScanAlgorithm,
+                           LaunchMode>;
+
+#define CREATE_SCAN_ALGORITHM_BENCHMARK(T, SCAN_OP, ALGO)                                     \
+    {                                                                                         \
+        using config = scan_algorithm_config<T, rocprim::device_scan_algorithm::ALGO>;        \
+        const device_scan_benchmark<false, T, SCAN_OP, config> instance;                      \
+        REGISTER_BENCHMARK(benchmarks, size, stream, instance);                               \
+    }
+
+// Compares the look-back scan states for values larger than 4 bytes
+#define CREATE_LOOKBACK_STATE_BENCHMARK(T, SCAN_OP)          \
+    CREATE_SCAN_ALGORITHM_BENCHMARK(T, SCAN_OP, lookback) \
+    CREATE_SCAN_ALGORITHM_BENCHMARK(T, SCAN_OP, lookback_tagged)
+
+// Compares a block per tile with a persistent grid for the look-back scan
+#define CREATE_GRID_LAUNCH_MODE_BENCHMARK(T, SCAN_OP)                                        \
+    {                                                                                        \
+        using config = scan_algorithm_config<T,                                              \
+                                             rocprim::device_scan_algorithm::lookback,       \
+                                             rocprim::grid_launch_mode::one_block_per_tile>; \
+        const device_scan_benchmark<false, T, SCAN_OP, config> instance;                     \
+        REGISTER_BENCHMARK(benchmarks, size, stream, instance);                              \
+    }                                                                                        \
+    {                                                                                        \
+        using config = scan_algorithm_config<T,                                              \
+                                             rocprim::device_scan_algorithm::lookback,       \
+                                             rocprim::grid_launch_mode::persistent>;         \
+        const device_scan_benchmark<false, T, SCAN_OP, config> instance;                     \
+        REGISTER_BENCHMARK(benchmarks, size, stream, instance);                              \
+    }
+
 int main(int argc, char* argv[])
 {
     cli::Parser parser(argc, argv);
@@ -58,6 +102,14 @@ int main(int argc, char* argv[])
                                      "name_format",
                                      "human",
                                      "either: json,human,txt");
+    parser.set_optional<double>("peak_bandwidth",
+                                "peak_bandwidth",
+                                0,
+                                "peak memory bandwidth in GB/s (measured if 0)");
+    parser.set_optional<bool>("instrument",
+                              "instrument",
+                              false,
+                              "report look-back counters (requires ROCPRIM_INSTRUMENT=1)");
 #ifdef BENCHMARK_CONFIG_TUNING
     // optionally run an evenly split subset of benchmarks, when making multiple program invocations
     parser.set_optional<int>("parallel_instance",
@@ -76,12 +128,21 @@ int main(int argc, char* argv[])
     const size_t size   = parser.get<size_t>("size");
     const int    trials = parser.get<int>("trials");
     bench_naming::set_format(parser.get<std::string>("name_format"));
+    instrumentation_enabled() = parser.get<bool>("instrument");
+#if !ROCPRIM_INSTRUMENT
+    if(instrumentation_enabled())
+    {
+        std::cerr << "--instrument requires ROCPRIM_INSTRUMENT=1" << std::endl;
+        return 1;
+    }
+#endif
 
     // HIP
     hipStream_t stream = 0; // default
 
     // Benchmark info
     add_common_benchmark_info();
+    set_peak_bandwidth(parser.get<double>("peak_bandwidth"), stream);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     // Add benchmarks
@@ -109,6 +170,18 @@ int main(int argc, char* argv[])
     CREATE_BENCHMARK(int8_t, rocprim::plus<int8_t>)
     CREATE_BENCHMARK(uint8_t, rocprim::plus<uint8_t>)
     CREATE_BENCHMARK(rocprim::half, rocprim::plus<rocprim::half>)
+
+    // 8, 12 and 16 byte accumulators
+    CREATE_LOOKBACK_STATE_BENCHMARK(long long, rocprim::plus<long long>)
+    CREATE_LOOKBACK_STATE_BENCHMARK(double, rocprim::plus<double>)
+    CREATE_LOOKBACK_STATE_BENCHMARK(custom_float2, rocprim::plus<custom_float2>)
+    CREATE_LOOKBACK_STATE_BENCHMARK(float3, rocprim::plus<float3>)
+    CREATE_LOOKBACK_STATE_BENCHMARK(double2, rocprim::plus<double2>)
+    CREATE_LOOKBACK_STATE_BENCHMARK(custom_double2, rocprim::plus<custom_double2>)
+
+    CREATE_GRID_LAUNCH_MODE_BENCHMARK(int, rocprim::plus<int>)
+    CREATE_GRID_LAUNCH_MODE_BENCHMARK(double, rocprim::plus<double>)
+    CREATE_GRID_LAUNCH_MODE_BENCHMARK(custom_double2, rocprim::plus<custom_double2>)
 #endif
 
     // Use manual timing
@@ -46,7 +46,12 @@ std::string config_name()
     const rocprim::detail::scan_config_params config = Config();
     return "{bs:" + std::to_string(config.kernel_config.block_size)
            + ",ipt:" + std::to_string(config.kernel_config.items_per_thread)
-           + ",method:" + std::string(get_block_scan_method_name(config.block_scan_method)) + "}";
+           + ",method:" + std::string(get_block_scan_method_name(config.block_scan_method))
+           + ",scan_algo:" + std::string(get_device_scan_algorithm_name(config.scan_algorithm))
+           + (config.launch_mode == rocprim::grid_launch_mode::default_mode
+                  ? std::string()
+                  : ",launch:" + std::string(get_grid_launch_mode_name(config.launch_mode)))
+           + "}";
 }
 
 template<>
@@ -196,6 +201,24 @@ struct device_scan_benchmark : public config_autotune_interface
 
         state.SetBytesProcessed(state.iterations() * batch_size * size * sizeof(T));
         state.SetItemsProcessed(state.iterations() * batch_size * size);
+        add_bandwidth_counters(state, batch_size * scan_ideal_bytes(size, sizeof(T), sizeof(T)));
+
+        if(instrumentation_enabled())
+        {
+            add_lookback_counters(state,
+                                  stream,
+                                  [&]
+                                  {
+                                      return run_device_scan(d_temp_storage,
+                                                             temp_storage_size_bytes,
+                                                             d_input,
+                                                             d_output,
+                                                             initial_value,
+                                                             size,
+                                                             scan_op,
+                                                             stream);
+                                  });
+        }
 
         HIP_CHECK(hipFree(d_input));
         HIP_CHECK(hipFree(d_output));
@@ -210,7 +233,9 @@ struct device_scan_benchmark : public config_autotune_interface
 
 #ifdef BENCHMARK_CONFIG_TUNING
 
-template<typename T, rocprim::block_scan_algorithm BlockScanAlgorithm>
+template<typename T,
+         rocprim::block_scan_algorithm  BlockScanAlgorithm,
+         rocprim::device_scan_algorithm ScanAlgorithm>
 struct device_scan_benchmark_generator
 {
     template<typename index_range>
@@ -233,7 +258,9 @@ struct device_scan_benchmark_generator
                                                  ItemsPerThread,
                                                  rocprim::block_load_method::block_load_transpose,
                                                  rocprim::block_store_method::block_store_transpose,
-                                                 BlockScanAlgorithm>>>());
+                                                 BlockScanAlgorithm,
+                                                 ROCPRIM_GRID_SIZE_LIMIT,
+                                                 ScanAlgorithm>>>());
                 }
             };
 
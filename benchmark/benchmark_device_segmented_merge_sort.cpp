@@ -0,0 +1,361 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "benchmark_utils.hpp"
+// CmdParser
+#include "cmdparser.hpp"
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// HIP API
+#include <hip/hip_runtime.h>
+
+// rocPRIM
+#include <rocprim/device/device_segmented_merge_sort.hpp>
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifndef DEFAULT_N
+const size_t DEFAULT_N = 1024 * 1024 * 32;
+#endif
+
+const unsigned int batch_size  = 10;
+const unsigned int warmup_size = 5;
+
+// The default tiles with sorting by the device-wide merge sort disabled, every segment is sorted by
+// a single block
+template<class Key, class Value>
+using block_only_config = rocprim::segmented_merge_sort_config<
+    rocprim::detail::default_segmented_merge_sort_config_base<Key, Value>::type::block_size,
+    rocprim::detail::default_segmented_merge_sort_config_base<Key, Value>::type::items_per_thread,
+    32,
+    rocprim::detail::default_segmented_merge_sort_config_base<Key, Value>::type::
+        items_per_thread_small,
+    256,
+    3000,
+    std::numeric_limits<unsigned int>::max()>;
+
+template<class Config, class Key, class Value>
+hipError_t segmented_merge_sort(void*        temporary_storage,
+                                size_t&      storage_size,
+                                Key*         keys_input,
+                                Key*         keys_output,
+                                Value*       values_input,
+                                Value*       values_output,
+                                size_t       size,
+                                unsigned int segments,
+                                int*         offsets,
+                                hipStream_t  stream,
+                                std::false_type /*with_values*/)
+{
+    (void)values_input;
+    (void)values_output;
+    return rocprim::segmented_merge_sort_keys<Config>(temporary_storage,
+                                                      storage_size,
+                                                      keys_input,
+                                                      keys_output,
+                                                      size,
+                                                      segments,
+                                                      offsets,
+                                                      offsets + 1,
+                                                      rocprim::less<Key>(),
+                                                      stream);
+}
+
+template<class Config, class Key, class Value>
+hipError_t segmented_merge_sort(void*        temporary_storage,
+                                size_t&      storage_size,
+                                Key*         keys_input,
+                                Key*         keys_output,
+                                Value*       values_input,
+                                Value*       values_output,
+                                size_t       size,
+                                unsigned int segments,
+                                int*         offsets,
+                                hipStream_t  stream,
+                                std::true_type /*with_values*/)
+{
+    return rocprim::segmented_merge_sort_pairs<Config>(temporary_storage,
+                                                       storage_size,
+                                                       keys_input,
+                                                       keys_output,
+                                                       values_input,
+                                                       values_output,
+                                                       size,
+                                                       segments,
+                                                       offsets,
+                                                       offsets + 1,
+                                                       rocprim::less<Key>(),
+                                                       stream);
+}
+
+template<class Value>
+void allocate_values(Value*& /*values_input*/,
+                     Value*& /*values_output*/,
+                     size_t /*size*/,
+                     std::false_type /*with_values*/)
+{}
+
+template<class Value>
+void allocate_values(Value*& values_input,
+                     Value*& values_output,
+                     size_t  size,
+                     std::true_type /*with_values*/)
+{
+    std::vector<Value> values(size);
+    std::iota(values.begin(), values.end(), 0);
+    HIP_CHECK(hipMalloc(&values_input, size * sizeof(Value)));
+    HIP_CHECK(hipMalloc(&values_output, size * sizeof(Value)));
+    HIP_CHECK(
+        hipMemcpy(values_input, values.data(), size * sizeof(Value), hipMemcpyHostToDevice));
+}
+
+// With a single segment, the whole input is sorted as one huge segment
+template<class Key, class Value, bool BlockOnly>
+void run_benchmark(benchmark::State& state,
+                   size_t            desired_segments,
+                   hipStream_t       stream,
+                   size_t            size)
+{
+    using offset_type = int;
+    using with_values
+        = std::integral_constant<bool, !std::is_same<Value, rocprim::empty_type>::value>;
+    using Config = typename std::
+        conditional<BlockOnly, block_only_config<Key, Value>, rocprim::default_config>::type;
+
+    // Generate data
+    const unsigned int         seed = 123;
+    std::default_random_engine gen(seed);
+
+    const double avg_segment_length = static_cast<double>(size) / desired_segments;
+    std::uniform_real_distribution<double> segment_length_dis(0, avg_segment_length * 2);
+
+    std::vector<offset_type> offsets;
+    unsigned int             segments_count = 0;
+    size_t                   offset         = 0;
+    while(offset < size)
+    {
+        const size_t segment_length
+            = desired_segments == 1 ? size : std::round(segment_length_dis(gen));
+        offsets.push_back(offset);
+        segments_count++;
+        offset += segment_length;
+    }
+    offsets.push_back(size);
+
+    std::vector<Key> keys_input
+        = get_random_data<Key>(size, static_cast<Key>(-100), static_cast<Key>(100));
+
+    offset_type* d_offsets;
+    HIP_CHECK(hipMalloc(&d_offsets, (segments_count + 1) * sizeof(offset_type)));
+    HIP_CHECK(hipMemcpy(d_offsets,
+                        offsets.data(),
+                        (segments_count + 1) * sizeof(offset_type),
+                        hipMemcpyHostToDevice));
+
+    Key* d_keys_input;
+    Key* d_keys_output;
+    HIP_CHECK(hipMalloc(&d_keys_input, size * sizeof(Key)));
+    HIP_CHECK(hipMalloc(&d_keys_output, size * sizeof(Key)));
+    HIP_CHECK(
+        hipMemcpy(d_keys_input, keys_input.data(), size * sizeof(Key), hipMemcpyHostToDevice));
+
+    Value* d_values_input  = nullptr;
+    Value* d_values_output = nullptr;
+    allocate_values(d_values_input, d_values_output, size, with_values{});
+
+    void*  d_temporary_storage     = nullptr;
+    size_t temporary_storage_bytes = 0;
+    HIP_CHECK(segmented_merge_sort<Config>(d_temporary_storage,
+                                           temporary_storage_bytes,
+                                           d_keys_input,
+                                           d_keys_output,
+                                           d_values_input,
+                                           d_values_output,
+                                           size,
+                                           segments_count,
+                                           d_offsets,
+                                           stream,
+                                           with_values{}));
+
+    HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Warm-up
+    for(size_t i = 0; i < warmup_size; i++)
+    {
+        HIP_CHECK(segmented_merge_sort<Config>(d_temporary_storage,
+                                               temporary_storage_bytes,
+                                               d_keys_input,
+                                               d_keys_output,
+                                               d_values_input,
+                                               d_values_output,
+                                               size,
+                                               segments_count,
+                                               d_offsets,
+                                               stream,
+                                               with_values{}));
+    }
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // HIP events creation
+    hipEvent_t start, stop;
+    HIP_CHECK(hipEventCreate(&start));
+    HIP_CHECK(hipEventCreate(&stop));
+
+    for(auto _ : state)
+    {
+        // Record start event
+        HIP_CHECK(hipEventRecord(start, stream));
+
+        for(size_t i = 0; i < batch_size; i++)
+        {
+            HIP_CHECK(segmented_merge_sort<Config>(d_temporary_storage,
+                                                   temporary_storage_bytes,
+                                                   d_keys_input,
+                                                   d_keys_output,
+                                                   d_values_input,
+                                                   d_values_output,
+                                                   size,
+                                                   segments_count,
+                                                   d_offsets,
+                                                   stream,
+                                                   with_values{}));
+        }
+
+        // Record stop event and wait until it completes
+        HIP_CHECK(hipEventRecord(stop, stream));
+        HIP_CHECK(hipEventSynchronize(stop));
+
+        float elapsed_mseconds;
+        HIP_CHECK(hipEventElapsedTime(&elapsed_mseconds, start, stop));
+        state.SetIterationTime(elapsed_mseconds / 1000);
+    }
+
+    // Destroy HIP events
+    HIP_CHECK(hipEventDestroy(start));
+    HIP_CHECK(hipEventDestroy(stop));
+
+    const size_t item_size = sizeof(Key) + (with_values::value ? sizeof(Value) : 0);
+    state.SetBytesProcessed(state.iterations() * batch_size * size * item_size);
+    state.SetItemsProcessed(state.iterations() * batch_size * size);
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_offsets));
+    HIP_CHECK(hipFree(d_keys_input));
+    HIP_CHECK(hipFree(d_keys_output));
+    HIP_CHECK(hipFree(d_values_input));
+    HIP_CHECK(hipFree(d_values_output));
+}
+
+#define CREATE_BENCHMARK(KEY, VALUE, SEGMENTS, BLOCK_ONLY)                                   \
+    benchmark::RegisterBenchmark(                                                            \
+        bench_naming::format_name("{lvl:device,algo:merge_sort_segmented,key_type:" #KEY     \
+                                  ",value_type:" #VALUE ",segment_count:"                    \
+                                  + std::to_string(SEGMENTS) + ",cfg:"                       \
+                                  + (BLOCK_ONLY ? "block_only" : "default_config") + "}")    \
+            .c_str(),                                                                        \
+        run_benchmark<KEY, VALUE, BLOCK_ONLY>,                                               \
+        SEGMENTS,                                                                            \
+        stream,                                                                              \
+        size)
+
+// One huge segment is sorted with and without the device-wide merge sort
+#define BENCHMARK_TYPE(KEY, VALUE)                  \
+    CREATE_BENCHMARK(KEY, VALUE, 1, false),         \
+    CREATE_BENCHMARK(KEY, VALUE, 1, true),          \
+    CREATE_BENCHMARK(KEY, VALUE, 10, false),        \
+    CREATE_BENCHMARK(KEY, VALUE, 1000, false),      \
+    CREATE_BENCHMARK(KEY, VALUE, 100000, false)
+
+void add_benchmarks(std::vector<benchmark::internal::Benchmark*>& benchmarks,
+                    hipStream_t                                   stream,
+                    size_t                                        size)
+{
+    using custom_float2 = custom_type<float, float>;
+
+    std::vector<benchmark::internal::Benchmark*> bs = {
+        BENCHMARK_TYPE(int, rocprim::empty_type),
+        BENCHMARK_TYPE(float, rocprim::empty_type),
+        BENCHMARK_TYPE(int8_t, rocprim::empty_type),
+        BENCHMARK_TYPE(int, int),
+        BENCHMARK_TYPE(custom_float2, double),
+    };
+
+    benchmarks.insert(benchmarks.end(), bs.begin(), bs.end());
+}
+
+int main(int argc, char* argv[])
+{
+    cli::Parser parser(argc, argv);
+    parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
+    parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    parser.set_optional<std::string>("name_format",
+                                     "name_format",
+                                     "human",
+                                     "either: json,human,txt");
+    parser.run_and_exit_if_error();
+
+    // Parse argv
+    benchmark::Initialize(&argc, argv);
+    const size_t size   = parser.get<size_t>("size");
+    const int    trials = parser.get<int>("trials");
+    bench_naming::set_format(parser.get<std::string>("name_format"));
+
+    // HIP
+    hipStream_t stream = 0; // default
+
+    // Benchmark info
+    add_common_benchmark_info();
+    benchmark::AddCustomContext("size", std::to_string(size));
+
+    // Add benchmarks
+    std::vector<benchmark::internal::Benchmark*> benchmarks;
+    add_benchmarks(benchmarks, stream, size);
+
+    // Use manual timing
+    for(auto& b : benchmarks)
+    {
+        b->UseManualTime();
+        b->Unit(benchmark::kMillisecond);
+    }
+
+    // Force number of iterations
+    if(trials > 0)
+    {
+        for(auto& b : benchmarks)
+        {
+            b->Iterations(trials);
+        }
+    }
+
+    // Run benchmarks
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
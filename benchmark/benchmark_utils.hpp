@@ -26,11 +26,14 @@
 // rocPRIM
 #include <rocprim/block/block_scan.hpp>
 #include <rocprim/device/config_types.hpp>
+#include <rocprim/device/detail/device_config_helper.hpp>
+#include <rocprim/device/device_trace.hpp>
 #include <rocprim/types.hpp>
 
 #include <algorithm>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <random>
@@ -752,6 +755,11 @@ inline const char* Traits<HIP_vector_type<float, 2>>::name()
     return "float2";
 }
 template<>
+inline const char* Traits<HIP_vector_type<float, 3>>::name()
+{
+    return "float3";
+}
+template<>
 inline const char* Traits<HIP_vector_type<double, 2>>::name()
 {
     return "double2";
@@ -867,6 +875,245 @@ inline const char* get_block_scan_method_name(rocprim::block_scan_algorithm alg)
     return "unknown_algorithm";
 }
 
+inline const char* get_device_scan_algorithm_name(rocprim::device_scan_algorithm alg)
+{
+    switch(alg)
+    {
+        case rocprim::device_scan_algorithm::lookback:
+            return "device_scan_algorithm::lookback";
+        case rocprim::device_scan_algorithm::lookback_tagged:
+            return "device_scan_algorithm::lookback_tagged";
+        case rocprim::device_scan_algorithm::reduce_then_scan:
+            return "device_scan_algorithm::reduce_then_scan";
+            // Not using `default: ...` because it kills effectiveness of -Wswitch
+    }
+    return "unknown_algorithm";
+}
+
+inline const char* get_grid_launch_mode_name(rocprim::grid_launch_mode mode)
+{
+    switch(mode)
+    {
+        case rocprim::grid_launch_mode::one_block_per_tile:
+            return "grid_launch_mode::one_block_per_tile";
+        case rocprim::grid_launch_mode::persistent:
+            return "grid_launch_mode::persistent";
+            // Not using `default: ...` because it kills effectiveness of -Wswitch
+    }
+    return "unknown_mode";
+}
+
+// Set by --instrument, benchmarks of look-back algorithms then report their look-back counters
+// and histogram benchmarks the counters of their atomic updates
+inline bool& instrumentation_enabled()
+{
+    static bool enabled = false;
+    return enabled;
+}
+
+// Runs the algorithm called by function (which returns hipError_t) once more with look-back
+// counters, and adds their sums and their maxima per tile to the counters of state. The timed
+// runs are not affected. Requires rocPRIM compiled with ROCPRIM_INSTRUMENT=1.
+template<class Function>
+inline void
+    add_lookback_counters(benchmark::State& state, const hipStream_t stream, Function function)
+{
+    // Tiles beyond the buffer share counters
+    constexpr size_t            counters_size = 1 << 16;
+    rocprim::lookback_counters* d_counters;
+    HIP_CHECK(hipMalloc(&d_counters, counters_size * sizeof(*d_counters)));
+    HIP_CHECK(hipMemsetAsync(d_counters, 0, counters_size * sizeof(*d_counters), stream));
+    {
+        rocprim::instrument_scope scope(d_counters, counters_size);
+        HIP_CHECK(function());
+    }
+    std::vector<rocprim::lookback_counters> counters(counters_size);
+    HIP_CHECK(hipMemcpyAsync(counters.data(),
+                             d_counters,
+                             counters_size * sizeof(*d_counters),
+                             hipMemcpyDeviceToHost,
+                             stream));
+    HIP_CHECK(hipStreamSynchronize(stream));
+    HIP_CHECK(hipFree(d_counters));
+
+    const auto add_counter = [&](const char* name, unsigned int rocprim::lookback_counters::*member)
+    {
+        double       sum     = 0;
+        unsigned int maximum = 0;
+        for(const rocprim::lookback_counters& tile_counters : counters)
+        {
+            sum += tile_counters.*member;
+            maximum = std::max(maximum, tile_counters.*member);
+        }
+        state.counters[name]                       = sum;
+        state.counters[std::string("max_") + name] = maximum;
+    };
+    add_counter("lookback_iterations", &rocprim::lookback_counters::lookback_iterations);
+    add_counter("spin_loops", &rocprim::lookback_counters::spin_loops);
+    add_counter("sleeps", &rocprim::lookback_counters::sleeps);
+    add_counter("prefix_reloads", &rocprim::lookback_counters::prefix_reloads);
+}
+
+// Runs the histogram called by function (which returns hipError_t) once more with histogram
+// counters, and adds their sums and their maxima per block to the counters of state. The timed
+// runs are not affected. Requires rocPRIM compiled with ROCPRIM_INSTRUMENT=1.
+template<class Function>
+inline void
+    add_histogram_counters(benchmark::State& state, const hipStream_t stream, Function function)
+{
+    // Blocks beyond the buffer share counters
+    constexpr size_t             counters_size = 1 << 16;
+    rocprim::histogram_counters* d_counters;
+    HIP_CHECK(hipMalloc(&d_counters, counters_size * sizeof(*d_counters)));
+    HIP_CHECK(hipMemsetAsync(d_counters, 0, counters_size * sizeof(*d_counters), stream));
+    {
+        rocprim::instrument_scope scope(d_counters, counters_size);
+        HIP_CHECK(function());
+    }
+    std::vector<rocprim::histogram_counters> counters(counters_size);
+    HIP_CHECK(hipMemcpyAsync(counters.data(),
+                             d_counters,
+                             counters_size * sizeof(*d_counters),
+                             hipMemcpyDeviceToHost,
+                             stream));
+    HIP_CHECK(hipStreamSynchronize(stream));
+    HIP_CHECK(hipFree(d_counters));
+
+    const auto add_counter
+        = [&](const char* name, unsigned int rocprim::histogram_counters::*member)
+    {
+        double       sum     = 0;
+        unsigned int maximum = 0;
+        for(const rocprim::histogram_counters& block_counters : counters)
+        {
+            sum += block_counters.*member;
+            maximum = std::max(maximum, block_counters.*member);
+        }
+        state.counters[name]                       = sum;
+        state.counters[std::string("max_") + name] = maximum;
+    };
+    add_counter("shared_atomics", &rocprim::histogram_counters::shared_atomics);
+    add_counter("shared_conflicts", &rocprim::histogram_counters::shared_conflicts);
+    add_counter("global_atomics", &rocprim::histogram_counters::global_atomics);
+    add_counter("global_conflicts", &rocprim::histogram_counters::global_conflicts);
+}
+
+// Minimal numbers of bytes the algorithms have to move from and to device memory. Divided by
+// the time they give the bandwidth of an ideal memory bound implementation (the roofline).
+
+// A copy reads and writes every item
+inline double copy_ideal_bytes(const size_t size, const size_t item_bytes)
+{
+    return 2.0 * size * item_bytes;
+}
+
+// A reduction reads every input and writes a single output
+inline double
+    reduce_ideal_bytes(const size_t size, const size_t input_bytes, const size_t output_bytes)
+{
+    return static_cast<double>(size) * input_bytes + output_bytes;
+}
+
+// A scan reads every input and writes every output
+inline double
+    scan_ideal_bytes(const size_t size, const size_t input_bytes, const size_t output_bytes)
+{
+    return static_cast<double>(size) * (input_bytes + output_bytes);
+}
+
+// Onesweep reads the keys once to compute the histograms of all digit places, then each of the
+// passes reads and scatters the keys and the values
+inline double radix_sort_onesweep_ideal_bytes(const size_t       size,
+                                              const size_t       key_bytes,
+                                              const size_t       value_bytes,
+                                              const unsigned int passes)
+{
+    return static_cast<double>(size) * key_bytes
+           + 2.0 * passes * size * (key_bytes + value_bytes);
+}
+
+// Peak bandwidth of the device memory in bytes per second, 0 if unknown
+inline double& peak_bandwidth()
+{
+    static double bandwidth = 0;
+    return bandwidth;
+}
+
+// Measures the bandwidth of device-to-device copies like the copy benchmark of
+// benchmark_device_memory: batches of copies of 128 MiB, the fastest batch counts. Both the
+// reads and the writes of the copies are counted.
+inline double measure_peak_bandwidth(const hipStream_t stream)
+{
+    constexpr size_t       bytes      = size_t(128) << 20;
+    constexpr unsigned int batch_size = 10;
+    constexpr unsigned int batches    = 5;
+
+    void* d_input;
+    void* d_output;
+    HIP_CHECK(hipMalloc(&d_input, bytes));
+    HIP_CHECK(hipMalloc(&d_output, bytes));
+
+    // Warm-up
+    for(unsigned int i = 0; i < batch_size; i++)
+    {
+        HIP_CHECK(hipMemcpyAsync(d_output, d_input, bytes, hipMemcpyDeviceToDevice, stream));
+    }
+    HIP_CHECK(hipStreamSynchronize(stream));
+
+    hipEvent_t start, stop;
+    HIP_CHECK(hipEventCreate(&start));
+    HIP_CHECK(hipEventCreate(&stop));
+
+    float min_elapsed_mseconds = std::numeric_limits<float>::max();
+    for(unsigned int batch = 0; batch < batches; batch++)
+    {
+        HIP_CHECK(hipEventRecord(start, stream));
+        for(unsigned int i = 0; i < batch_size; i++)
+        {
+            HIP_CHECK(hipMemcpyAsync(d_output, d_input, bytes, hipMemcpyDeviceToDevice, stream));
+        }
+        HIP_CHECK(hipEventRecord(stop, stream));
+        HIP_CHECK(hipEventSynchronize(stop));
+
+        float elapsed_mseconds;
+        HIP_CHECK(hipEventElapsedTime(&elapsed_mseconds, start, stop));
+        min_elapsed_mseconds = std::min(min_elapsed_mseconds, elapsed_mseconds);
+    }
+
+    HIP_CHECK(hipEventDestroy(start));
+    HIP_CHECK(hipEventDestroy(stop));
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_output));
+
+    return batch_size * copy_ideal_bytes(bytes, 1) / (min_elapsed_mseconds / 1000);
+}
+
+// Sets the peak bandwidth to gbps (set by --peak_bandwidth), or measures it if gbps is 0, and
+// adds it to the context of the benchmarks
+inline void set_peak_bandwidth(const double gbps, const hipStream_t stream)
+{
+    peak_bandwidth() = gbps > 0 ? gbps * 1e9 : measure_peak_bandwidth(stream);
+    benchmark::AddCustomContext("peak_bandwidth_gbps", std::to_string(peak_bandwidth() / 1e9));
+    benchmark::AddCustomContext("peak_bandwidth_source", gbps > 0 ? "user" : "measured");
+}
+
+// Adds the bandwidth of an ideal implementation that moves ideal_bytes every iteration
+// (ideal_bandwidth) and its percentage of the peak bandwidth (peak_bandwidth_pct) to the
+// counters of state. Both are rates, Google Benchmark divides them by the (manual) time.
+// Bandwidths are in decimal bytes per second, like peak_bandwidth_gbps in the context.
+inline void add_bandwidth_counters(benchmark::State& state, const double ideal_bytes)
+{
+    state.counters["ideal_bytes"] = ideal_bytes;
+    state.counters["ideal_bandwidth"]
+        = benchmark::Counter(ideal_bytes, benchmark::Counter::kIsIterationInvariantRate);
+    if(peak_bandwidth() > 0)
+    {
+        state.counters["peak_bandwidth_pct"]
+            = benchmark::Counter(ideal_bytes * 100 / peak_bandwidth(),
+                                 benchmark::Counter::kIsIterationInvariantRate);
+    }
+}
+
 template<std::size_t Size, std::size_t Alignment>
 struct alignas(Alignment) custom_aligned_type
 {
@@ -247,6 +247,50 @@ public:
         base_type::composite(input, hist);
     }
 
+    /// \brief Update an existing block-wide weighted histogram. Each thread adds the weights of
+    /// an array of input elements to their bins.
+    ///
+    /// * The weights are added with atomic operations for all algorithms, \p storage is not used.
+    /// * Supported counter types are \p int, \p unsigned \p int, \p unsigned \p long,
+    /// \p unsigned \p long \p long, \p float and \p double.
+    ///
+    /// \tparam Weight - [inferred] type of the weights, convertible to \p Counter.
+    /// \tparam Counter - [inferred] counter type of histogram.
+    ///
+    /// \param [in] input - reference to an array containing thread input values. The function expects each value to satisfy 0 <= input[i] < BINS.
+    /// \param [in] weights - reference to an array containing the weights of the thread input values.
+    /// \param [out] hist - histogram bin weights.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    template<class Weight, class Counter>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void composite(T (&input)[ItemsPerThread],
+                   Weight (&weights)[ItemsPerThread],
+                   Counter hist[Bins],
+                   storage_type& storage)
+    {
+        (void)storage;
+        composite(input, weights, hist);
+    }
+
+    /// \overload
+    /// \brief Update an existing block-wide weighted histogram. Each thread adds the weights of
+    /// an array of input elements to their bins.
+    ///
+    /// \tparam Weight - [inferred] type of the weights, convertible to \p Counter.
+    /// \tparam Counter - [inferred] counter type of histogram.
+    ///
+    /// \param [in] input - reference to an array containing thread input values. The function expects each value to satisfy 0 <= input[i] < BINS.
+    /// \param [in] weights - reference to an array containing the weights of the thread input values.
+    /// \param [out] hist - histogram bin weights.
+    template<class Weight, class Counter>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void composite(T (&input)[ItemsPerThread],
+                   Weight (&weights)[ItemsPerThread],
+                   Counter hist[Bins])
+    {
+        detail::block_histogram_weighted_composite<ItemsPerThread, Bins>(input, weights, hist);
+    }
+
     /// \brief Construct a new block-wide histogram. Each thread contributes an array of
     /// input elements.
     ///
@@ -318,6 +362,49 @@ public:
         ::rocprim::syncthreads();
         composite(input, hist);
     }
+
+    /// \brief Construct a new block-wide weighted histogram. Each thread contributes the weights
+    /// of an array of input elements.
+    ///
+    /// \tparam Weight - [inferred] type of the weights, convertible to \p Counter.
+    /// \tparam Counter - [inferred] counter type of histogram.
+    ///
+    /// \param [in] input - reference to an array containing thread input values. The function expects each value to satisfy 0 <= input[i] < BINS.
+    /// \param [in] weights - reference to an array containing the weights of the thread input values.
+    /// \param [out] hist - histogram bin weights.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    template<class Weight, class Counter>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void histogram(T (&input)[ItemsPerThread],
+                   Weight (&weights)[ItemsPerThread],
+                   Counter hist[Bins],
+                   storage_type& storage)
+    {
+        init_histogram(hist);
+        ::rocprim::syncthreads();
+        composite(input, weights, hist, storage);
+    }
+
+    /// \overload
+    /// \brief Construct a new block-wide weighted histogram. Each thread contributes the weights
+    /// of an array of input elements.
+    ///
+    /// \tparam Weight - [inferred] type of the weights, convertible to \p Counter.
+    /// \tparam Counter - [inferred] counter type of histogram.
+    ///
+    /// \param [in] input - reference to an array containing thread input values. The function expects each value to satisfy 0 <= input[i] < BINS.
+    /// \param [in] weights - reference to an array containing the weights of the thread input values.
+    /// \param [out] hist - histogram bin weights.
+    template<class Weight, class Counter>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void histogram(T (&input)[ItemsPerThread],
+                   Weight (&weights)[ItemsPerThread],
+                   Counter hist[Bins])
+    {
+        init_histogram(hist);
+        ::rocprim::syncthreads();
+        composite(input, weights, hist);
+    }
 };
 
 END_ROCPRIM_NAMESPACE
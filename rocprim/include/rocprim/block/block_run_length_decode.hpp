@@ -49,8 +49,7 @@ BEGIN_ROCPRIM_NAMESPACE
  * retrieving a "window" from the run-length decoded array. The window's offset can be specified and BLOCK_THREADS *
  * DECODED_ITEMS_PER_THREAD (i.e., referred to as window_size) decoded items from the specified window will be returned.
  *
- * \note: Trailing runs of length 0 are supported (i.e., they may only appear at the end of the run_lengths array).
- * A run of length zero may not be followed by a run length that is not zero.
+ * \note: Runs of length 0 are supported, they do not produce any decoded items.
  *
  * \par
  * \code
@@ -334,6 +333,13 @@ public:
             // If we are in a new run...
             if(thread_decoded_offset == current_run_end)
             {
+                // Skip the runs of length 0
+                while(current_run + 1 < static_cast<RunOffsetT>(BLOCK_RUNS)
+                      && temp_storage.runs.run_offsets[current_run + 1] <= thread_decoded_offset)
+                {
+                    ++current_run;
+                }
+
                 // The value of the new run
                 val = temp_storage.runs.run_values[current_run];
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -34,6 +34,38 @@ BEGIN_ROCPRIM_NAMESPACE
 namespace detail
 {
 
+template<class Counter>
+struct is_atomic_histogram_counter
+    : std::integral_constant<bool,
+                             std::is_same<Counter, unsigned int>::value
+                                 || std::is_same<Counter, int>::value
+                                 || std::is_same<Counter, float>::value
+                                 || std::is_same<Counter, double>::value
+                                 || std::is_same<Counter, unsigned long>::value
+                                 || std::is_same<Counter, unsigned long long>::value>
+{};
+
+// Adds the weights of the items of a thread to their bins. It is used by all algorithms, the
+// weights of peer lanes can not be combined with a bit count.
+template<unsigned int ItemsPerThread, unsigned int Bins, class T, class Weight, class Counter>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void block_histogram_weighted_composite(T (&input)[ItemsPerThread],
+                                        Weight (&weights)[ItemsPerThread],
+                                        Counter hist[Bins])
+{
+    static_assert(
+        is_atomic_histogram_counter<Counter>::value,
+        "Counter must be type that is supported by atomics (float, double, int, unsigned int, unsigned long, unsigned long long)"
+    );
+    ROCPRIM_UNROLL
+    for(unsigned int i = 0; i < ItemsPerThread; ++i)
+    {
+        const unsigned int bin = static_cast<unsigned int>(input[i]);
+        detail::atomic_add(&hist[bin], static_cast<Counter>(weights[i]));
+    }
+    ::rocprim::syncthreads();
+}
+
 template<
     class T,
     unsigned int BlockSizeX,
@@ -59,9 +91,8 @@ public:
                    Counter hist[Bins])
     {
         static_assert(
-            std::is_same<Counter, unsigned int>::value || std::is_same<Counter, int>::value ||
-            std::is_same<Counter, float>::value || std::is_same<Counter, unsigned long long>::value,
-            "Counter must be type that is supported by atomics (float, int, unsigned int, unsigned long long)"
+            is_atomic_histogram_counter<Counter>::value,
+            "Counter must be type that is supported by atomics (float, double, int, unsigned int, unsigned long, unsigned long long)"
         );
         ROCPRIM_UNROLL
         for(unsigned int i = 0; i < ItemsPerThread; ++i)
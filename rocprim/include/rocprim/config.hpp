@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -98,6 +98,25 @@
     #define ROCPRIM_THREAD_STORE_USE_CACHE_MODIFIERS 1
 #endif
 
+// Compiles the runtime tuning of the default configs on architectures without tuned configs,
+// see device/detail/runtime_tuning.hpp. It is also enabled by ROCPRIM_RUNTIME_TUNING_CACHE
+// at runtime.
+#ifndef ROCPRIM_RUNTIME_TUNING
+    #define ROCPRIM_RUNTIME_TUNING 0
+#endif
+
+// Emits a ROCTX range for every call of a traced device-level algorithm, see
+// device/device_trace.hpp. The application has to link roctx64.
+#ifndef ROCPRIM_USE_ROCTX
+    #define ROCPRIM_USE_ROCTX 0
+#endif
+
+// Counts the look-back iterations, spin-wait loops, sleeps and atomic retries of the decoupled
+// look-back of every tile, see instrument_scope in device/device_trace.hpp.
+#ifndef ROCPRIM_INSTRUMENT
+    #define ROCPRIM_INSTRUMENT 0
+#endif
+
 
 // Defines targeted AMD architecture. Supported values:
 // * 803 (gfx803)
@@ -0,0 +1,223 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DETAIL_PLAN_LAUNCH_LOG_HPP_
+#define ROCPRIM_DETAIL_PLAN_LAUNCH_LOG_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "../config.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+namespace detail
+{
+
+// The host-side values that the algorithms resolve before their launches: the config candidate
+// of the runtime tuning, the layout of the temporary storage and the sizes of the persistent
+// grids. An execution plan records them in its first successful execution, the later executions
+// read them back in the same order instead of resolving them again.
+class plan_launch_log
+{
+public:
+    // Appends the value resolved at site
+    void append(const void* const site,
+                const size_t      key,
+                const void* const value,
+                const size_t      bytes)
+    {
+        entries_.push_back(entry{site, key, data_.size(), bytes});
+        const unsigned char* const first = static_cast<const unsigned char*>(value);
+        data_.insert(data_.end(), first, first + bytes);
+    }
+
+    // Reads back the value of entry index, false if it was not resolved at site
+    bool read(const size_t      index,
+              const void* const site,
+              const size_t      key,
+              void* const       value,
+              const size_t      bytes) const
+    {
+        if(index >= entries_.size())
+        {
+            return false;
+        }
+        const entry& recorded = entries_[index];
+        if(recorded.site != site || recorded.key != key || recorded.bytes != bytes)
+        {
+            return false;
+        }
+        std::memcpy(value, data_.data() + recorded.offset, bytes);
+        return true;
+    }
+
+    void clear()
+    {
+        entries_.clear();
+        data_.clear();
+    }
+
+    // Set when the log holds every value of a successful execution, it is not changed anymore
+    std::atomic<bool> recorded{false};
+    // Held while an execution records the log
+    std::mutex record_mutex;
+
+private:
+    struct entry
+    {
+        const void* site;
+        size_t      key;
+        size_t      offset;
+        size_t      bytes;
+    };
+
+    std::vector<entry>         entries_;
+    std::vector<unsigned char> data_;
+};
+
+// An execution of a plan on the calling thread
+struct plan_launch_cursor
+{
+    plan_launch_log* log;
+    // Index of the next value
+    size_t index;
+    // Whether the values are read back, otherwise they are recorded
+    bool replay;
+    // Cleared if the execution resolved a value that may change or took another path than the
+    // recorded one, the following values are resolved without the log
+    bool valid;
+};
+
+inline plan_launch_cursor*& current_plan_launch()
+{
+    static thread_local plan_launch_cursor* cursor = nullptr;
+    return cursor;
+}
+
+// While alive, the algorithms called by this thread record the values they resolve to log, or
+// read them back if log is recorded. Only one execution records a log at a time.
+class plan_launch_scope
+{
+public:
+    explicit plan_launch_scope(plan_launch_log& log)
+        : previous_cursor_(current_plan_launch())
+        , cursor_{&log, 0, log.recorded.load(std::memory_order_acquire), true}
+    {
+        if(!cursor_.replay)
+        {
+            lock_ = std::unique_lock<std::mutex>(log.record_mutex);
+            // Another execution may have recorded the log in the meantime
+            cursor_.replay = log.recorded.load(std::memory_order_relaxed);
+            if(!cursor_.replay)
+            {
+                log.clear();
+            }
+        }
+        current_plan_launch() = &cursor_;
+    }
+
+    ~plan_launch_scope()
+    {
+        current_plan_launch() = previous_cursor_;
+    }
+
+    plan_launch_scope(const plan_launch_scope&)            = delete;
+    plan_launch_scope& operator=(const plan_launch_scope&) = delete;
+
+    // Called after a successful execution, keeps the recorded values if they can be read back
+    void commit()
+    {
+        if(!cursor_.replay && cursor_.valid)
+        {
+            cursor_.log->recorded.store(true, std::memory_order_release);
+        }
+    }
+
+private:
+    plan_launch_cursor*          previous_cursor_;
+    plan_launch_cursor           cursor_;
+    std::unique_lock<std::mutex> lock_;
+};
+
+// The address of plan_site<Tag>::id identifies the values resolved by the same code
+template<class Tag>
+struct plan_site
+{
+    static const char id;
+};
+
+template<class Tag>
+const char plan_site<Tag>::id = 0;
+
+// Calls resolve(value) unless the plan executing on the calling thread resolved the value in a
+// previous execution. The site and the key of the value detect executions that take another
+// path than the recorded one.
+template<class T, class Function>
+hipError_t
+    plan_resolve(const void* const site, const size_t key, T& value, Function&& resolve)
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable values are recorded");
+
+    plan_launch_cursor* const cursor = current_plan_launch();
+    if(cursor == nullptr || !cursor->valid)
+    {
+        return resolve(value);
+    }
+    if(cursor->replay)
+    {
+        if(cursor->log->read(cursor->index, site, key, &value, sizeof(T)))
+        {
+            cursor->index++;
+            return hipSuccess;
+        }
+        cursor->valid = false;
+        return resolve(value);
+    }
+
+    const hipError_t result = resolve(value);
+    if(result != hipSuccess)
+    {
+        cursor->valid = false;
+        return result;
+    }
+    cursor->log->append(site, key, &value, sizeof(T));
+    cursor->index++;
+    return hipSuccess;
+}
+
+// Called by the resolve function of plan_resolve if the value may change in later executions.
+// The plan does not keep the values of the execution.
+inline void plan_resolve_unstable()
+{
+    if(plan_launch_cursor* const cursor = current_plan_launch())
+    {
+        cursor->valid = false;
+    }
+}
+
+} // namespace detail
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DETAIL_PLAN_LAUNCH_LOG_HPP_
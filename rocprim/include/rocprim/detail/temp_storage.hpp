@@ -22,9 +22,11 @@
 #define ROCPRIM_DETAIL_TEMP_STORAGE_HPP_
 
 #include <cstddef>
+#include <type_traits>
 
 #include "../config.hpp"
 #include "../types.hpp"
+#include "plan_launch_log.hpp"
 #include "various.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -77,8 +79,28 @@ struct simple_partition
     {
         *this->dest = this->storage_layout.size == 0 ? nullptr : static_cast<T*>(storage);
     }
+
+    /// \brief The number of destination pointers of this partition.
+    static constexpr size_t destination_count = 1;
+
+    /// \brief Calls `function(dest)` for the destination pointer of this partition.
+    template<class Function>
+    void for_each_destination(Function&& function) const
+    {
+        function(this->dest);
+    }
 };
 
+/// \brief The total number of destination pointers of the partitions `Ts`.
+template<typename... Ts>
+struct destination_count_of : std::integral_constant<size_t, 0>
+{};
+
+template<typename T, typename... Ts>
+struct destination_count_of<T, Ts...>
+    : std::integral_constant<size_t, T::destination_count + destination_count_of<Ts...>::value>
+{};
+
 /// \brief Construct a simple `simple_partition` with a particular layout.
 /// \tparam T              - The base type to allocate temporary memory for
 /// \param  dest           - Pointer to where to store the final allocated pointer
@@ -169,6 +191,18 @@ struct linear_partition
                               offset += sub_layout.size;
                           });
     }
+
+    /// \brief The number of destination pointers of the sub-partitions.
+    static constexpr size_t destination_count = destination_count_of<Ts...>::value;
+
+    /// \brief Calls `function(dest)` for the destination pointers of the sub-partitions, in order.
+    template<class Function>
+    void for_each_destination(Function&& function) const
+    {
+        for_each_in_tuple(this->sub_partitions,
+                          [&](const auto& sub_partition)
+                          { sub_partition.for_each_destination(function); });
+    }
 };
 
 /// \brief Construct a `linear_partition` from sub-partitions.
@@ -223,6 +257,18 @@ struct union_partition
         for_each_in_tuple(this->sub_partitions,
                           [&](auto& sub_partition) { sub_partition.set_storage(storage); });
     }
+
+    /// \brief The number of destination pointers of the sub-partitions.
+    static constexpr size_t destination_count = destination_count_of<Ts...>::value;
+
+    /// \brief Calls `function(dest)` for the destination pointers of the sub-partitions, in order.
+    template<class Function>
+    void for_each_destination(Function&& function) const
+    {
+        for_each_in_tuple(this->sub_partitions,
+                          [&](const auto& sub_partition)
+                          { sub_partition.for_each_destination(function); });
+    }
 };
 
 /// \brief Construct a `union_partition` from sub-partitions.
@@ -251,12 +297,17 @@ union_partition<Ts...> make_union_partition(Ts... ts)
 /// memory, its alignment is not factored into the total required memory, and its destination pointer will be set to
 /// `nullptr`.
 ///
+/// While an execution plan executes, the required size and the offsets of the destination pointers are computed once
+/// and read back in the later executions, see `plan_resolve`.
+///
 /// \tparam TempStoragePartition - The root partition to allocate temporary memory for. It should have the following
 ///   member functions:
 ///   `layout get_layout()` - Compute the required storage layout for the partition.
 ///   `void set_storage(void* const storage)` - Update the internal destination pointer or the destination pointers of
 ///     sub-partitions with the given pointer. `storage` has at least the required size and alignment as described by
 ///     the result of `get_layout()`.
+///   `void for_each_destination(Function&& function)` - Call `function` with every destination pointer, in order.
+///   `destination_count` - The number of destination pointers.
 /// \param temporary_storage     - The base pointer to the allocated temporary memory. May be `nullptr`.
 /// \param storage_size [in,out] - The size of `temporary_storage`.
 /// \param partition    [in,out] - The root partition to allocate temporary memory to.
@@ -264,21 +315,61 @@ template<typename TempStoragePartition>
 hipError_t
     partition(void* const temporary_storage, size_t& storage_size, TempStoragePartition partition)
 {
-    const auto layout = partition.get_layout();
-    // Make sure the user wont try to allocate 0 bytes of memory.
-    const size_t required_size = std::max(layout.size, minimum_allocation_size);
-
     if(temporary_storage == nullptr)
     {
-        storage_size = required_size;
+        // Make sure the user wont try to allocate 0 bytes of memory.
+        storage_size = std::max(partition.get_layout().size, minimum_allocation_size);
         return hipSuccess;
     }
-    else if(storage_size < required_size)
+
+    // The offsets of the destination pointers from temporary_storage, no_offset for nullptr
+    constexpr size_t no_offset = static_cast<size_t>(-1);
+    struct resolved_partition
+    {
+        size_t required_size;
+        size_t offsets[TempStoragePartition::destination_count + 1];
+    } resolved;
+
+    const hipError_t result = plan_resolve(
+        &plan_site<TempStoragePartition>::id,
+        0,
+        resolved,
+        [&](resolved_partition& value)
+        {
+            value.required_size = std::max(partition.get_layout().size, minimum_allocation_size);
+            partition.set_storage(temporary_storage);
+
+            size_t index = 0;
+            partition.for_each_destination(
+                [&](auto** dest)
+                {
+                    value.offsets[index++]
+                        = *dest == nullptr ? no_offset
+                                           : static_cast<size_t>(
+                                               reinterpret_cast<const char*>(*dest)
+                                               - static_cast<const char*>(temporary_storage));
+                });
+            return hipSuccess;
+        });
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    if(storage_size < resolved.required_size)
     {
         return hipErrorInvalidValue;
     }
 
-    partition.set_storage(temporary_storage);
+    size_t index = 0;
+    partition.for_each_destination(
+        [&](auto** dest)
+        {
+            using pointer_type  = typename std::remove_reference<decltype(*dest)>::type;
+            const size_t offset = resolved.offsets[index++];
+            *dest               = offset == no_offset ? nullptr
+                                                      : reinterpret_cast<pointer_type>(
+                                              static_cast<char*>(temporary_storage) + offset);
+        });
 
     return hipSuccess;
 }
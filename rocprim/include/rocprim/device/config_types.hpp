@@ -92,6 +92,20 @@ struct kernel_config : detail::kernel_config_params
     static constexpr unsigned int size_limit = SizeLimit;
 };
 
+/// \brief Number of blocks launched by the kernels of device-level primitives that support it.
+enum class grid_launch_mode
+{
+    /// \brief Every block processes a single tile of items, the grid has as many blocks as there
+    /// are tiles.
+    one_block_per_tile,
+    /// \brief The grid has as many blocks as can be resident on the device at the same time,
+    /// every block processes tiles until all tiles are processed. Reduces the scheduling overhead
+    /// of very large inputs.
+    persistent,
+    /// \brief Default grid launch mode.
+    default_mode = one_block_per_tile,
+};
+
 namespace detail
 {
 
@@ -200,7 +214,9 @@ constexpr bool prefix_equals(const char* lhs, const char* rhs, std::size_t n)
     return i == n && *lhs == '\0';
 }
 
-constexpr target_arch get_target_arch_from_name(const char* const arch_name, const std::size_t n)
+// Returns the architecture that has tuned configs with this name, or unknown if there is none
+constexpr target_arch get_tuned_target_arch_from_name(const char* const arch_name,
+                                                      const std::size_t n)
 {
     constexpr const char* target_names[]
         = {"gfx803", "gfx900", "gfx906", "gfx908", "gfx90a", "gfx1030", "gfx1102"};
@@ -228,6 +244,185 @@ constexpr target_arch get_target_arch_from_name(const char* const arch_name, con
     return target_arch::unknown;
 }
 
+/// \brief Generation of an AMD GPU architecture. Generations of the same line (GCN and CDNA,
+/// RDNA) are consecutive, so the difference of two values is their distance.
+enum class arch_generation : unsigned int
+{
+    gcn3    = 0,
+    gcn5    = 1,
+    cdna1   = 2,
+    cdna2   = 3,
+    cdna3   = 4,
+    cdna4   = 5,
+    rdna1   = 10,
+    rdna2   = 11,
+    rdna3   = 12,
+    rdna3_5 = 13,
+    rdna4   = 14,
+};
+
+/// \brief Typical number of compute units of the devices of an architecture.
+enum class cu_count_class : unsigned int
+{
+    low  = 0, ///< less than 16 compute units
+    mid  = 1, ///< 16 to 63 compute units
+    high = 2, ///< 64 or more compute units
+};
+
+/// \brief The properties of an architecture that matter for selecting configs.
+struct arch_family
+{
+    arch_generation generation; ///< generation of the architecture
+    unsigned int    wave_size; ///< number of threads in a wavefront
+    unsigned int    lds_size; ///< LDS available to a block, in KiB
+    cu_count_class  cu_count; ///< typical number of compute units
+};
+
+/// \brief Distance between two architecture families, used to select the tuned architecture
+/// whose configs are used for an architecture without tuned configs. A different wave size
+/// outweighs everything else, then the generation, the LDS size and the compute unit count
+/// are compared.
+constexpr unsigned int arch_family_distance(const arch_family lhs, const arch_family rhs)
+{
+    const unsigned int lhs_generation = static_cast<unsigned int>(lhs.generation);
+    const unsigned int rhs_generation = static_cast<unsigned int>(rhs.generation);
+    const unsigned int lhs_cu_count   = static_cast<unsigned int>(lhs.cu_count);
+    const unsigned int rhs_cu_count   = static_cast<unsigned int>(rhs.cu_count);
+    return (lhs.wave_size != rhs.wave_size ? 1000u : 0u)
+           + 10u
+                 * (lhs_generation > rhs_generation ? lhs_generation - rhs_generation
+                                                    : rhs_generation - lhs_generation)
+           + (lhs.lds_size != rhs.lds_size ? 5u : 0u)
+           + (lhs_cu_count > rhs_cu_count ? lhs_cu_count - rhs_cu_count
+                                          : rhs_cu_count - lhs_cu_count);
+}
+
+/**
+ * \brief Get the family of an architecture by its name.
+ *
+ * \param arch_name the name of the architecture, without target features
+ * \param n length of `arch_name`
+ * \param family the family of the architecture if it is known
+ * \return true if the architecture is known
+ */
+constexpr bool get_arch_family_from_name(const char* const arch_name,
+                                         const std::size_t n,
+                                         arch_family&      family)
+{
+    // clang-format off
+    constexpr const char* arch_names[] = {
+        "gfx803",
+        "gfx900", "gfx902", "gfx904", "gfx906", "gfx909", "gfx90c",
+        "gfx908",
+        "gfx90a",
+        "gfx940", "gfx941", "gfx942",
+        "gfx950",
+        "gfx1010", "gfx1011", "gfx1012", "gfx1013",
+        "gfx1030", "gfx1031", "gfx1032", "gfx1033", "gfx1034", "gfx1035", "gfx1036",
+        "gfx1100", "gfx1101", "gfx1102", "gfx1103",
+        "gfx1150", "gfx1151",
+        "gfx1200", "gfx1201",
+    };
+    constexpr arch_family arch_families[] = {
+        {arch_generation::gcn3,    64, 64,  cu_count_class::mid},  // gfx803
+        {arch_generation::gcn5,    64, 64,  cu_count_class::high}, // gfx900
+        {arch_generation::gcn5,    64, 64,  cu_count_class::low},  // gfx902
+        {arch_generation::gcn5,    64, 64,  cu_count_class::mid},  // gfx904
+        {arch_generation::gcn5,    64, 64,  cu_count_class::mid},  // gfx906
+        {arch_generation::gcn5,    64, 64,  cu_count_class::low},  // gfx909
+        {arch_generation::gcn5,    64, 64,  cu_count_class::low},  // gfx90c
+        {arch_generation::cdna1,   64, 64,  cu_count_class::high}, // gfx908
+        {arch_generation::cdna2,   64, 64,  cu_count_class::high}, // gfx90a
+        {arch_generation::cdna3,   64, 64,  cu_count_class::high}, // gfx940
+        {arch_generation::cdna3,   64, 64,  cu_count_class::high}, // gfx941
+        {arch_generation::cdna3,   64, 64,  cu_count_class::high}, // gfx942
+        {arch_generation::cdna4,   64, 160, cu_count_class::high}, // gfx950
+        {arch_generation::rdna1,   32, 64,  cu_count_class::mid},  // gfx1010
+        {arch_generation::rdna1,   32, 64,  cu_count_class::mid},  // gfx1011
+        {arch_generation::rdna1,   32, 64,  cu_count_class::mid},  // gfx1012
+        {arch_generation::rdna1,   32, 64,  cu_count_class::low},  // gfx1013
+        {arch_generation::rdna2,   32, 64,  cu_count_class::high}, // gfx1030
+        {arch_generation::rdna2,   32, 64,  cu_count_class::mid},  // gfx1031
+        {arch_generation::rdna2,   32, 64,  cu_count_class::mid},  // gfx1032
+        {arch_generation::rdna2,   32, 64,  cu_count_class::low},  // gfx1033
+        {arch_generation::rdna2,   32, 64,  cu_count_class::mid},  // gfx1034
+        {arch_generation::rdna2,   32, 64,  cu_count_class::low},  // gfx1035
+        {arch_generation::rdna2,   32, 64,  cu_count_class::low},  // gfx1036
+        {arch_generation::rdna3,   32, 64,  cu_count_class::high}, // gfx1100
+        {arch_generation::rdna3,   32, 64,  cu_count_class::mid},  // gfx1101
+        {arch_generation::rdna3,   32, 64,  cu_count_class::mid},  // gfx1102
+        {arch_generation::rdna3,   32, 64,  cu_count_class::low},  // gfx1103
+        {arch_generation::rdna3_5, 32, 64,  cu_count_class::low},  // gfx1150
+        {arch_generation::rdna3_5, 32, 64,  cu_count_class::mid},  // gfx1151
+        {arch_generation::rdna4,   32, 64,  cu_count_class::mid},  // gfx1200
+        {arch_generation::rdna4,   32, 64,  cu_count_class::high}, // gfx1201
+    };
+    // clang-format on
+    static_assert(sizeof(arch_names) / sizeof(arch_names[0])
+                      == sizeof(arch_families) / sizeof(arch_families[0]),
+                  "arch_names and arch_families should have the same number of elements");
+    constexpr auto num_architectures = sizeof(arch_names) / sizeof(arch_names[0]);
+
+    for(unsigned int i = 0; i < num_architectures; ++i)
+    {
+        if(prefix_equals(arch_names[i], arch_name, n))
+        {
+            family = arch_families[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * \brief Get the tuned architecture that is closest to an architecture.
+ *
+ * \param arch_name the name of the architecture, without target features
+ * \param n length of `arch_name`
+ * \return the tuned architecture of the same name if there is one, otherwise the tuned
+ * architecture with the closest family, or `unknown` if the family of the architecture is not
+ * known.
+ */
+constexpr target_arch get_target_arch_from_name(const char* const arch_name, const std::size_t n)
+{
+    const target_arch tuned_arch = get_tuned_target_arch_from_name(arch_name, n);
+    if(tuned_arch != target_arch::unknown)
+    {
+        return tuned_arch;
+    }
+
+    arch_family family{};
+    if(!get_arch_family_from_name(arch_name, n, family))
+    {
+        return target_arch::unknown;
+    }
+
+    constexpr const char* tuned_names[]
+        = {"gfx803", "gfx900", "gfx906", "gfx908", "gfx90a", "gfx1030", "gfx1102"};
+    constexpr auto num_tuned = sizeof(tuned_names) / sizeof(tuned_names[0]);
+
+    target_arch  closest_arch     = target_arch::unknown;
+    unsigned int closest_distance = 0;
+    for(unsigned int i = 0; i < num_tuned; ++i)
+    {
+        std::size_t tuned_name_length = 0;
+        while(tuned_names[i][tuned_name_length] != '\0')
+        {
+            ++tuned_name_length;
+        }
+
+        arch_family tuned_family{};
+        get_arch_family_from_name(tuned_names[i], tuned_name_length, tuned_family);
+        const unsigned int distance = arch_family_distance(family, tuned_family);
+        if(closest_arch == target_arch::unknown || distance < closest_distance)
+        {
+            closest_arch     = get_tuned_target_arch_from_name(tuned_names[i], tuned_name_length);
+            closest_distance = distance;
+        }
+    }
+    return closest_arch;
+}
+
 /**
  * \brief Get the current architecture in device compilation.
  * 
@@ -280,6 +475,47 @@ constexpr auto device_params()
     return Config::template architecture_config<device_target_arch()>::params;
 }
 
+/// \brief Properties of a device that an execution plan resolves once, when it is made.
+struct plan_device_info
+{
+    int          device_id;
+    target_arch  arch;
+    unsigned int warp_size;
+    int          multiprocessor_count;
+    bool         use_sleep_scan_state;
+};
+
+/// \brief Device properties of the plan executing on the calling thread, \p nullptr if none.
+inline const plan_device_info*& current_plan_device_info()
+{
+    static thread_local const plan_device_info* info = nullptr;
+    return info;
+}
+
+/// \brief While alive, the device queries of the algorithms called by this thread return
+/// the properties in \p info instead of calling the HIP runtime. Plans are bound to a single
+/// stream, so the queries of every algorithm they call refer to the same device.
+class plan_device_scope
+{
+public:
+    explicit plan_device_scope(const plan_device_info& info)
+        : previous_info_(current_plan_device_info())
+    {
+        current_plan_device_info() = &info;
+    }
+
+    ~plan_device_scope()
+    {
+        current_plan_device_info() = previous_info_;
+    }
+
+    plan_device_scope(const plan_device_scope&)            = delete;
+    plan_device_scope& operator=(const plan_device_scope&) = delete;
+
+private:
+    const plan_device_info* previous_info_;
+};
+
 inline target_arch parse_gcn_arch(const char* arch_name)
 {
     static constexpr auto length = sizeof(hipDeviceProp_t::gcnArchName);
@@ -324,6 +560,12 @@ inline hipError_t get_device_arch(int device_id, target_arch& arch)
 
 inline hipError_t get_device_from_stream(const hipStream_t stream, int& device_id)
 {
+    if(const plan_device_info* info = current_plan_device_info())
+    {
+        device_id = info->device_id;
+        return hipSuccess;
+    }
+
     static constexpr hipStream_t default_stream = 0;
     if(stream == default_stream || stream == hipStreamPerThread)
     {
@@ -349,6 +591,12 @@ inline hipError_t get_device_from_stream(const hipStream_t stream, int& device_i
 
 inline hipError_t host_target_arch(const hipStream_t stream, target_arch& arch)
 {
+    if(const plan_device_info* info = current_plan_device_info())
+    {
+        arch = info->arch;
+        return hipSuccess;
+    }
+
     int              device_id;
     const hipError_t result = get_device_from_stream(stream, device_id);
     if(result != hipSuccess)
@@ -359,6 +607,124 @@ inline hipError_t host_target_arch(const hipStream_t stream, target_arch& arch)
     return get_device_arch(device_id, arch);
 }
 
+/// \brief Input size ranges for which the autotuner may provide separate default configs.
+enum class size_bucket : unsigned int
+{
+    small  = 0, ///< Inputs of less than 2^16 items
+    medium = 1, ///< Inputs of less than 2^22 items
+    large  = 2 ///< All other inputs, they use the regular default config
+};
+
+constexpr size_bucket get_size_bucket(const size_t size)
+{
+    return size < (size_t{1} << 16)   ? size_bucket::small
+           : size < (size_t{1} << 22) ? size_bucket::medium
+                                      : size_bucket::large;
+}
+
+/// \brief Stands in for `default_config` when the default config tuned for the input sizes of
+/// \p Bucket should be used. The wrapped configs of the size-bucketed algorithms select the
+/// matching `default_*_bucket_config`.
+template<size_bucket Bucket>
+struct default_bucket_config
+{
+    // Like default_config it acts as the sub-algorithm configs of merge_sort_config
+    using block_sort_config  = default_bucket_config;
+    using block_merge_config = default_bucket_config;
+};
+
+/// \brief Config that uses the config of \p Config for \p Arch on every architecture. The runtime
+/// tuning tries these as candidates on architectures without tuned configs.
+template<class Config, target_arch Arch>
+struct fixed_arch_config
+{};
+
+// Helper for the specializations of the wrapped configs for fixed_arch_config
+template<class WrappedConfig, target_arch Arch>
+struct wrapped_fixed_arch_config
+{
+    template<target_arch>
+    struct architecture_config : WrappedConfig::template architecture_config<Arch>
+    {};
+};
+
+// The default config of large inputs is the regular default config, so user configs and
+// algorithms without tuned buckets only ever instantiate a single config.
+template<class Config, class Function>
+auto dispatch_size_bucket(const size_t, Function&& function, std::false_type)
+    -> decltype(function(type_identity<Config>{}))
+{
+    return function(type_identity<Config>{});
+}
+
+template<class Config, class Function>
+auto dispatch_size_bucket(const size_t size, Function&& function, std::true_type)
+    -> decltype(function(type_identity<Config>{}))
+{
+    switch(get_size_bucket(size))
+    {
+        case size_bucket::small:
+            return function(type_identity<default_bucket_config<size_bucket::small>>{});
+        case size_bucket::medium:
+            return function(type_identity<default_bucket_config<size_bucket::medium>>{});
+        case size_bucket::large: break;
+    }
+    return function(type_identity<Config>{});
+}
+
+/// \brief Calls \p function with the `type_identity` of the config to use for \p size items.
+///
+/// If \p Config is `default_config` and the autotuner provided configs for the size buckets of
+/// the algorithm (\p Bucketed), the config is selected by the size of the input. Otherwise
+/// \p Config is used as is.
+template<class Config, bool Bucketed, class Function>
+auto dispatch_size_bucket(const size_t size, Function&& function)
+    -> decltype(function(type_identity<Config>{}))
+{
+    constexpr bool use_buckets = Bucketed && std::is_same<Config, default_config>::value;
+    return dispatch_size_bucket<Config>(size,
+                                        std::forward<Function>(function),
+                                        std::integral_constant<bool, use_buckets>{});
+}
+
+/// \brief Whether the params that `dispatch_target_arch<Config>` may select have \p value as
+/// their \p member, on any architecture.
+///
+/// Algorithms use it to instantiate the kernels of a variant (e.g. the algorithm or the launch
+/// mode of their config) only for the configs that select it.
+template<class Config, class Params, class Member>
+constexpr bool any_target_arch_params(Member Params::*member, const Member value)
+{
+    // clang-format off
+    return Config::template architecture_config<target_arch::unknown>::params.*member == value
+        || Config::template architecture_config<target_arch::gfx803>::params.*member == value
+        || Config::template architecture_config<target_arch::gfx900>::params.*member == value
+        || Config::template architecture_config<target_arch::gfx906>::params.*member == value
+        || Config::template architecture_config<target_arch::gfx908>::params.*member == value
+        || Config::template architecture_config<target_arch::gfx90a>::params.*member == value
+        || Config::template architecture_config<target_arch::gfx1030>::params.*member == value
+        || Config::template architecture_config<target_arch::gfx1102>::params.*member == value;
+    // clang-format on
+}
+
+/// \brief Calls `if_true(type_identity<T>{})` if \p Condition is `std::true_type`, otherwise
+/// `if_false(type_identity<T>{})`.
+///
+/// Only the called function is instantiated, so kernels can be named in a branch of a
+/// compile-time condition without being instantiated when the condition is false. The functions
+/// must be generic lambdas whose kernels depend on the type in their argument.
+template<class T, class IfTrue, class IfFalse>
+hipError_t static_branch(std::true_type, IfTrue&& if_true, IfFalse&&)
+{
+    return if_true(type_identity<T>{});
+}
+
+template<class T, class IfTrue, class IfFalse>
+hipError_t static_branch(std::false_type, IfTrue&&, IfFalse&& if_false)
+{
+    return if_false(type_identity<T>{});
+}
+
 } // end namespace detail
 
 /// \brief Returns a number of threads in a hardware warp for the actual device.
@@ -390,6 +756,12 @@ ROCPRIM_HOST inline hipError_t host_warp_size(const int device_id, unsigned int&
 /// It is constant for a device.
 ROCPRIM_HOST inline hipError_t host_warp_size(const hipStream_t stream, unsigned int& warp_size)
 {
+    if(const detail::plan_device_info* info = detail::current_plan_device_info())
+    {
+        warp_size = info->warp_size;
+        return hipSuccess;
+    }
+
     int        hip_device;
     hipError_t success = detail::get_device_from_stream(stream, hip_device);
     if(success == hipSuccess)
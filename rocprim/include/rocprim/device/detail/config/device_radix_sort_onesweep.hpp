@@ -1,4 +1,4 @@
-// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2022-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -3148,6 +3148,17 @@ struct default_radix_sort_onesweep_config<
                                  block_radix_rank_algorithm::match>
 {};
 
+template<unsigned int arch,
+         size_bucket bucket,
+         class key_type,
+         class value_type = rocprim::empty_type,
+         class enable     = void>
+struct default_radix_sort_onesweep_bucket_config : default_radix_sort_onesweep_config<arch, key_type, value_type>
+{};
+
+struct default_radix_sort_onesweep_config_size_bucketed : std::false_type
+{};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
@@ -518,6 +518,13 @@ struct default_reduce_config<static_cast<unsigned int>(target_arch::gfx90a),
     : reduce_config<256, 16, ::rocprim::block_reduce_algorithm::using_warp_reduce>
 {};
 
+template<unsigned int arch, size_bucket bucket, class key_type, class enable = void>
+struct default_reduce_bucket_config : default_reduce_config<arch, key_type>
+{};
+
+struct default_reduce_config_size_bucketed : std::false_type
+{};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
@@ -618,6 +618,13 @@ struct default_scan_config<static_cast<unsigned int>(target_arch::gfx90a),
                   block_scan_algorithm::using_warp_scan>
 {};
 
+template<unsigned int arch, size_bucket bucket, class value_type, class enable = void>
+struct default_scan_bucket_config : default_scan_config<arch, value_type>
+{};
+
+struct default_scan_config_size_bucketed : std::false_type
+{};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
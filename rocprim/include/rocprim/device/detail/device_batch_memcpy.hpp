@@ -32,9 +32,14 @@
 #include "rocprim/device/config_types.hpp"
 #include "rocprim/device/detail/device_scan_common.hpp"
 #include "rocprim/device/detail/lookback_scan_state.hpp"
+#include "rocprim/device/detail/persistent_grid.hpp"
 #include "rocprim/device/device_memcpy_config.hpp"
 #include "rocprim/device/device_scan.hpp"
 
+#include "rocprim/iterator/constant_iterator.hpp"
+#include "rocprim/iterator/counting_iterator.hpp"
+#include "rocprim/iterator/transform_iterator.hpp"
+
 #include "rocprim/block/block_exchange.hpp"
 #include "rocprim/block/block_load.hpp"
 #include "rocprim/block/block_load_func.hpp"
@@ -57,6 +62,9 @@
 
 #include <hip/hip_runtime.h>
 
+#include <chrono>
+#include <iostream>
+
 #include <stdint.h>
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -105,32 +113,115 @@ public:
     }
 };
 
+/// \brief Source of a batched memset, every byte of the buffer is \p value.
+struct memset_source
+{
+    uint8_t value;
+};
+
+/// \brief Source or destination of a batched 2D copy or memset. The bytes of the buffer are
+/// numbered row by row, byte \p i is in row <tt>i / width</tt> and column <tt>i % width</tt>.
+struct pitched_buffer
+{
+    uint8_t* ptr;
+    size_t   pitch;
+    size_t   width;
+
+    ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE uint8_t* row(size_t row_index) const
+    {
+        return ptr + row_index * pitch;
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE uint8_t* item(size_t offset) const
+    {
+        return row(offset / width) + offset % width;
+    }
+};
+
+/// \brief Whether the buffers are plain (contiguous) ranges of bytes or items.
+template<class T>
+struct is_linear_buffer : std::true_type
+{};
+
+template<>
+struct is_linear_buffer<memset_source> : std::false_type
+{};
+
+template<>
+struct is_linear_buffer<pitched_buffer> : std::false_type
+{};
+
+template<bool IsMemCpy, class InputBufferItType>
+struct alias_type
+{
+    using type = unsigned char;
+};
+
+template<class InputBufferItType>
+struct alias_type<false, InputBufferItType>
+{
+    using type = typename std::iterator_traits<
+        typename std::iterator_traits<InputBufferItType>::value_type>::value_type;
+};
+
 template<bool IsMemCpy,
          class Alias,
          class InputIt,
          class Offset,
-         typename std::enable_if<IsMemCpy, int>::type = 0>
+         typename std::enable_if<IsMemCpy && is_linear_buffer<InputIt>::value, int>::type = 0>
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static Alias read_item(InputIt buffer_src, Offset offset)
 {
     return rocprim::thread_load<rocprim::cache_load_modifier::load_cs>(
         reinterpret_cast<Alias*>(buffer_src) + offset);
 }
 
+template<bool IsMemCpy,
+         class Alias,
+         class Offset,
+         typename std::enable_if<IsMemCpy, int>::type = 0>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static Alias read_item(memset_source buffer_src,
+                                                           Offset /*offset*/)
+{
+    return buffer_src.value;
+}
+
+template<bool IsMemCpy,
+         class Alias,
+         class Offset,
+         typename std::enable_if<IsMemCpy, int>::type = 0>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static Alias read_item(pitched_buffer buffer_src,
+                                                           Offset         offset)
+{
+    return rocprim::thread_load<rocprim::cache_load_modifier::load_cs>(
+        buffer_src.item(offset));
+}
+
 template<bool IsMemCpy,
          class Alias,
          class InputIt,
          class Offset,
-         typename std::enable_if<!IsMemCpy, int>::type = 0>
+         typename std::enable_if<!IsMemCpy && std::is_pointer<InputIt>::value, int>::type = 0>
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static Alias read_item(InputIt buffer_src, Offset offset)
 {
     return rocprim::thread_load<rocprim::cache_load_modifier::load_cs>(buffer_src + offset);
 }
 
+// Sources of batch_copy may be any random access iterator, e.g. constant_iterator for fills.
 template<bool IsMemCpy,
          class Alias,
          class InputIt,
          class Offset,
-         typename std::enable_if<IsMemCpy, int>::type = 0>
+         typename std::enable_if<!IsMemCpy && !std::is_pointer<InputIt>::value, int>::type = 0>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static Alias read_item(InputIt buffer_src, Offset offset)
+{
+    return *(buffer_src + offset);
+}
+
+template<bool IsMemCpy,
+         class Alias,
+         class InputIt,
+         class Offset,
+         typename std::enable_if<IsMemCpy && is_linear_buffer<InputIt>::value, int>::type = 0>
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static void
     write_item(InputIt buffer_dst, Offset offset, Alias value)
 {
@@ -139,6 +230,16 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static void
         value);
 }
 
+template<bool IsMemCpy,
+         class Alias,
+         class Offset,
+         typename std::enable_if<IsMemCpy, int>::type = 0>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static void
+    write_item(pitched_buffer buffer_dst, Offset offset, Alias value)
+{
+    rocprim::thread_store<rocprim::cache_store_modifier::store_cs>(buffer_dst.item(offset), value);
+}
+
 template<bool IsMemCpy,
          class Alias,
          class InputIt,
@@ -298,17 +399,129 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static void vectorized_copy_bytes(const void
     }
 }
 
+template<class Offset>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static void vectorized_fill_bytes(uint8_t value,
+                                                                      void*   output_buffer,
+                                                                      Offset  num_bytes,
+                                                                      Offset  offset = 0)
+{
+    using vector_type = uint4;
+
+    constexpr auto warp_size = rocprim::device_warp_size();
+    const auto     rank      = rocprim::detail::block_thread_id<0>() % warp_size;
+
+    uint8_t* dst = reinterpret_cast<uint8_t*>(output_buffer) + offset;
+
+    auto* aligned_begin = detail::cast_align_up<vector_type*>(dst);
+    auto* aligned_end   = detail::cast_align_down<vector_type*>(dst + num_bytes);
+
+    // If no aligned range, fill byte-by-byte and early exit
+    if(aligned_end <= aligned_begin)
+    {
+        for(Offset i = rank; i < num_bytes; i += warp_size)
+        {
+            dst[i] = value;
+        }
+        return;
+    }
+
+    // Fill the non-aligned head
+    for(uint8_t* out_ptr = dst + rank; out_ptr < reinterpret_cast<uint8_t*>(aligned_begin);
+        out_ptr += warp_size)
+    {
+        *out_ptr = value;
+    }
+
+    const uint32_t    word = 0x01010101u * value;
+    const vector_type data = vector_type{word, word, word, word};
+    for(vector_type* out_ptr = aligned_begin + rank; out_ptr < aligned_end; out_ptr += warp_size)
+    {
+        *out_ptr = data;
+    }
+
+    // Fill the non-aligned tail
+    for(uint8_t* out_ptr = reinterpret_cast<uint8_t*>(aligned_end) + rank; out_ptr < dst + num_bytes;
+        out_ptr += warp_size)
+    {
+        *out_ptr = value;
+    }
+}
+
 template<bool IsMemCpy,
          class InputIt,
          class OutputIt,
          class Offset,
-         typename std::enable_if<IsMemCpy, int>::type = 0>
+         typename std::enable_if<IsMemCpy && is_linear_buffer<InputIt>::value
+                                     && is_linear_buffer<OutputIt>::value,
+                                 int>::type
+         = 0>
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static void
     copy_items(InputIt input_buffer, OutputIt output_buffer, Offset num_items, Offset offset = 0)
 {
     vectorized_copy_bytes<Offset>(input_buffer, output_buffer, num_items, offset);
 }
 
+template<bool IsMemCpy,
+         class OutputIt,
+         class Offset,
+         typename std::enable_if<IsMemCpy && is_linear_buffer<OutputIt>::value, int>::type = 0>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static void copy_items(memset_source input_buffer,
+                                                           OutputIt      output_buffer,
+                                                           Offset        num_items,
+                                                           Offset        offset = 0)
+{
+    vectorized_fill_bytes<Offset>(input_buffer.value, output_buffer, num_items, offset);
+}
+
+// Bytes [offset, offset + num_items) of a pitched buffer are processed as one segment per row.
+template<bool IsMemCpy,
+         class Offset,
+         typename std::enable_if<IsMemCpy, int>::type = 0>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static void copy_items(memset_source  input_buffer,
+                                                           pitched_buffer output_buffer,
+                                                           Offset         num_items,
+                                                           Offset         offset = 0)
+{
+    const Offset width  = static_cast<Offset>(output_buffer.width);
+    Offset       row    = offset / width;
+    Offset       column = offset % width;
+    while(num_items > 0)
+    {
+        const Offset row_items = rocprim::min(static_cast<Offset>(width - column), num_items);
+        vectorized_fill_bytes<Offset>(input_buffer.value,
+                                      output_buffer.row(row),
+                                      row_items,
+                                      column);
+        num_items -= row_items;
+        column = 0;
+        ++row;
+    }
+}
+
+template<bool IsMemCpy,
+         class Offset,
+         typename std::enable_if<IsMemCpy, int>::type = 0>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static void copy_items(pitched_buffer input_buffer,
+                                                           pitched_buffer output_buffer,
+                                                           Offset         num_items,
+                                                           Offset         offset = 0)
+{
+    const Offset width  = static_cast<Offset>(output_buffer.width);
+    Offset       row    = offset / width;
+    Offset       column = offset % width;
+    while(num_items > 0)
+    {
+        const Offset row_items = rocprim::min(static_cast<Offset>(width - column), num_items);
+        vectorized_copy_bytes<Offset>(input_buffer.row(row),
+                                      output_buffer.row(row),
+                                      row_items,
+                                      column);
+        num_items -= row_items;
+        column = 0;
+        ++row;
+    }
+}
+
 template<bool IsMemCpy,
          class InputIt,
          class OutputIt,
@@ -326,6 +539,54 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE static void
     }
 }
 
+// The following functors describe the buffers of fills, memsets and 2D copies, so that they
+// can be passed to the batch_memcpy engine through transform iterators.
+
+template<class T>
+struct make_fill_source
+{
+    ROCPRIM_HOST_DEVICE ROCPRIM_INLINE rocprim::constant_iterator<T> operator()(T value) const
+    {
+        return rocprim::constant_iterator<T>(value);
+    }
+};
+
+struct make_memset_source
+{
+    template<class Value>
+    ROCPRIM_HOST_DEVICE ROCPRIM_INLINE memset_source operator()(Value value) const
+    {
+        return memset_source{static_cast<uint8_t>(value)};
+    }
+};
+
+template<class PointerIt, class PitchIt, class WidthIt>
+struct make_pitched_buffer
+{
+    PointerIt pointers;
+    PitchIt   pitches;
+    WidthIt   widths;
+
+    ROCPRIM_HOST_DEVICE ROCPRIM_INLINE pitched_buffer operator()(uint32_t index) const
+    {
+        return pitched_buffer{reinterpret_cast<uint8_t*>(pointers[index]),
+                              static_cast<size_t>(pitches[index]),
+                              static_cast<size_t>(widths[index])};
+    }
+};
+
+template<class WidthIt, class HeightIt>
+struct pitched_buffer_size
+{
+    WidthIt  widths;
+    HeightIt heights;
+
+    ROCPRIM_HOST_DEVICE ROCPRIM_INLINE size_t operator()(uint32_t index) const
+    {
+        return static_cast<size_t>(widths[index]) * static_cast<size_t>(heights[index]);
+    }
+};
+
 } // namespace batch_memcpy
 
 template<class Config,
@@ -339,13 +600,7 @@ struct batch_memcpy_impl
     using output_buffer_type = typename std::iterator_traits<OutputBufferItType>::value_type;
     using buffer_size_type   = typename std::iterator_traits<BufferSizeItType>::value_type;
 
-    using input_type = typename std::iterator_traits<input_buffer_type>::value_type;
-
-    using Alias =
-        typename std::conditional<IsMemCpy,
-                                  unsigned char,
-                                  typename std::iterator_traits<typename std::iterator_traits<
-                                      InputBufferItType>::value_type>::value_type>::type;
+    using Alias = typename batch_memcpy::alias_type<IsMemCpy, InputBufferItType>::type;
 
     // top level policy
     static constexpr uint32_t block_size            = Config::non_blev_block_size;
@@ -382,12 +637,14 @@ struct batch_memcpy_impl
         BufferSizeItType   sizes;
     };
 
+    // Filled by the non-blev kernel, so stored in temporary storage even when the buffers
+    // are given by fancy iterators.
     struct copyable_blev_buffers
     {
-        InputBufferItType  srcs;
-        OutputBufferItType dsts;
-        BufferSizeItType   sizes;
-        tile_offset_type*  offsets;
+        input_buffer_type*  srcs;
+        output_buffer_type* dsts;
+        buffer_size_type*   sizes;
+        tile_offset_type*   offsets;
     };
 
 private:
@@ -1012,6 +1269,23 @@ public:
     }
 };
 
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
+    {                                                                                            \
+        auto _error = hipGetLastError();                                                         \
+        if(_error != hipSuccess)                                                                 \
+            return _error;                                                                       \
+        if(debug_synchronous)                                                                    \
+        {                                                                                        \
+            std::cout << name << "(" << size << ")";                                             \
+            auto __error = hipStreamSynchronize(stream);                                         \
+            if(__error != hipSuccess)                                                            \
+                return __error;                                                                  \
+            auto _end = std::chrono::high_resolution_clock::now();                               \
+            auto _d   = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n';                              \
+        }                                                                                        \
+    }
+
 template<class Config_,
          class InputBufferItType,
          class OutputBufferItType,
@@ -1110,48 +1384,19 @@ ROCPRIM_INLINE static hipError_t batch_memcpy_func(void*              temporary_
         return hipSuccess;
     }
 
-    // Compute launch parameters.
-
-    int device_id = hipGetStreamDeviceId(stream);
-
-    // Get the number of multiprocessors
-    int multiprocessor_count{};
-    error = hipDeviceGetAttribute(&multiprocessor_count,
-                                  hipDeviceAttributeMultiprocessorCount,
-                                  device_id);
-    if(error != hipSuccess)
+    // Nothing to copy, the kernels cannot be launched with an empty grid.
+    if(num_copies == 0)
     {
-        return error;
-    }
-
-    // `hipOccupancyMaxActiveBlocksPerMultiprocessor` uses the default device.
-    // We need to perserve the current default device id while we change it temporarily
-    // to get the max occupancy on this stream.
-    int previous_device;
-    error = hipGetDevice(&previous_device);
-    if(error != hipSuccess)
-    {
-        return error;
-    }
-
-    error = hipSetDevice(device_id);
-    if(error != hipSuccess)
-    {
-        return error;
+        return hipSuccess;
     }
 
-    int blev_occupancy{};
-    error = hipOccupancyMaxActiveBlocksPerMultiprocessor(&blev_occupancy,
-                                                         batch_memcpy_impl_type::blev_memcpy_kernel,
-                                                         blev_block_size,
-                                                         0 /* dynSharedMemPerBlk */);
-    if(error != hipSuccess)
-    {
-        return error;
-    }
+    // Compute launch parameters.
 
-    // Restore the default device id to initial state
-    error = hipSetDevice(previous_device);
+    unsigned int batch_memcpy_blev_grid_size;
+    error = get_persistent_grid_size(batch_memcpy_impl_type::blev_memcpy_kernel,
+                                     blev_block_size,
+                                     stream,
+                                     batch_memcpy_blev_grid_size);
     if(error != hipSuccess)
     {
         return error;
@@ -1161,9 +1406,6 @@ ROCPRIM_INLINE static hipError_t batch_memcpy_func(void*              temporary_
     const BlockOffsetType     init_kernel_grid_size
         = rocprim::detail::ceiling_div(num_blocks, init_kernel_threads);
 
-    auto batch_memcpy_blev_grid_size
-        = multiprocessor_count * blev_occupancy * 1 /* subscription factor */;
-
     BlockOffsetType batch_memcpy_grid_size = num_blocks;
 
     // Prepare init_scan_states_kernel.
@@ -1187,23 +1429,28 @@ ROCPRIM_INLINE static hipError_t batch_memcpy_func(void*              temporary_
         return error;
     }
 
+    // The kernels only communicate through device memory: the number of blev buffers and their
+    // tile offsets are read by the persistent blev kernel from the scan states. The host never
+    // waits for the device, so the operation is stream-ordered and can be captured in a graph.
+    std::chrono::high_resolution_clock::time_point start;
+
     // Launch init_scan_states_kernel.
+    if(debug_synchronous)
+    {
+        start = std::chrono::high_resolution_clock::now();
+    }
     batch_memcpy_impl_type::
         init_tile_state_kernel<<<init_kernel_grid_size, init_kernel_threads, 0, stream>>>(
             scan_state_buffer,
             scan_state_block,
             num_blocks);
-    error = hipGetLastError();
-    if(error != hipSuccess)
-    {
-        return error;
-    }
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_tile_state_kernel", num_blocks, start);
+
+    // Launch batch_memcpy_non_blev_kernel.
     if(debug_synchronous)
     {
-        hipStreamSynchronize(stream);
+        start = std::chrono::high_resolution_clock::now();
     }
-
-    // Launch batch_memcpy_non_blev_kernel.
     batch_memcpy_impl_type::
         non_blev_memcpy_kernel<<<batch_memcpy_grid_size, non_blev_block_size, 0, stream>>>(
             buffers,
@@ -1211,35 +1458,25 @@ ROCPRIM_INLINE static hipError_t batch_memcpy_func(void*              temporary_
             blev_buffers,
             scan_state_buffer,
             scan_state_block);
-    error = hipGetLastError();
-    if(error != hipSuccess)
-    {
-        return error;
-    }
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("non_blev_memcpy_kernel", num_copies, start);
+
+    // Launch batch_memcpy_blev_kernel.
     if(debug_synchronous)
     {
-        hipStreamSynchronize(stream);
+        start = std::chrono::high_resolution_clock::now();
     }
-
-    // Launch batch_memcpy_blev_kernel.
     batch_memcpy_impl_type::
         blev_memcpy_kernel<<<batch_memcpy_blev_grid_size, blev_block_size, 0, stream>>>(
             blev_buffers,
             scan_state_buffer,
             batch_memcpy_grid_size - 1);
-    error = hipGetLastError();
-    if(error != hipSuccess)
-    {
-        return error;
-    }
-    if(debug_synchronous)
-    {
-        hipStreamSynchronize(stream);
-    }
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("blev_memcpy_kernel", num_copies, start);
 
     return hipSuccess;
 }
 
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
 } // namespace detail
 
 END_ROCPRIM_NAMESPACE
@@ -21,6 +21,7 @@
 #ifndef ROCPRIM_DEVICE_DETAIL_CONFIG_HELPER_HPP_
 #define ROCPRIM_DEVICE_DETAIL_CONFIG_HELPER_HPP_
 
+#include <climits>
 #include <type_traits>
 
 #include "../../config.hpp"
@@ -225,6 +226,7 @@ struct reduce_config_params
 {
     kernel_config_params   reduce_config;
     block_reduce_algorithm block_reduce_method;
+    grid_launch_mode       launch_mode = grid_launch_mode::default_mode;
 };
 
 } // namespace detail
@@ -235,11 +237,13 @@ struct reduce_config_params
 /// \tparam ItemsPerThread - number of items processed by each thread.
 /// \tparam BlockReduceMethod - algorithm for block reduce.
 /// \tparam SizeLimit - limit on the number of items reduced by a single launch
+/// \tparam GridLaunchMode - number of blocks of the reduce kernel.
 template<unsigned int                      BlockSize      = 256,
          unsigned int                      ItemsPerThread = 8,
          ::rocprim::block_reduce_algorithm BlockReduceMethod
          = ::rocprim::block_reduce_algorithm::default_algorithm,
-         unsigned int SizeLimit = ROCPRIM_GRID_SIZE_LIMIT>
+         unsigned int                SizeLimit      = ROCPRIM_GRID_SIZE_LIMIT,
+         ::rocprim::grid_launch_mode GridLaunchMode = ::rocprim::grid_launch_mode::default_mode>
 struct reduce_config : rocprim::detail::reduce_config_params
 {
     /// \brief Identifies the algorithm associated to the config.
@@ -247,7 +251,7 @@ struct reduce_config : rocprim::detail::reduce_config_params
     constexpr reduce_config()
         : rocprim::detail::reduce_config_params{
             {BlockSize, ItemsPerThread, SizeLimit},
-            BlockReduceMethod
+            BlockReduceMethod, GridLaunchMode
     } {};
 };
 
@@ -268,6 +272,29 @@ struct default_reduce_config_base
 struct scan_config_tag
 {};
 
+} // namespace detail
+
+/// \brief Available algorithms for device-level scan primitives.
+enum class device_scan_algorithm
+{
+    /// \brief Single pass scan, where each block waits for the prefix of its predecessors
+    /// using decoupled look-back.
+    lookback,
+    /// \brief Decoupled look-back, where every 32-bit word of a block prefix is stored together
+    /// with its status. Prefixes larger than 4 bytes are published and read without memory
+    /// fences, at the cost of twice the look-back storage. Same as \p lookback for smaller values.
+    lookback_tagged,
+    /// \brief Three kernel scan: per-block reductions, a single block scan of the
+    /// reductions and a final block-local scan seeded with the scanned reductions.
+    /// Does not rely on inter-block communication while a kernel is running.
+    reduce_then_scan,
+    /// \brief Default device scan algorithm.
+    default_algorithm = lookback,
+};
+
+namespace detail
+{
+
 /// \brief Provides the kernel parameters for exclusive_scan and inclusive_scan based
 ///        on autotuned configurations or user-provided configurations.
 struct scan_config_params
@@ -276,6 +303,8 @@ struct scan_config_params
     ::rocprim::block_load_method    block_load_method{};
     ::rocprim::block_store_method   block_store_method{};
     ::rocprim::block_scan_algorithm block_scan_method{};
+    ::rocprim::device_scan_algorithm scan_algorithm = ::rocprim::device_scan_algorithm::default_algorithm;
+    ::rocprim::grid_launch_mode      launch_mode    = ::rocprim::grid_launch_mode::default_mode;
 };
 
 } // namespace detail
@@ -288,12 +317,17 @@ struct scan_config_params
 /// \tparam StoreLoadMethod - method for storing values.
 /// \tparam BlockScanMethod - algorithm for block scan.
 /// \tparam SizeLimit - limit on the number of items for a single scan kernel launch.
-template<unsigned int                    BlockSize,
-         unsigned int                    ItemsPerThread,
-         ::rocprim::block_load_method    BlockLoadMethod,
-         ::rocprim::block_store_method   BlockStoreMethod,
-         ::rocprim::block_scan_algorithm BlockScanMethod,
-         unsigned int                    SizeLimit = ROCPRIM_GRID_SIZE_LIMIT>
+/// \tparam ScanAlgorithm - algorithm for the device-wide scan.
+/// \tparam GridLaunchMode - number of blocks of the look-back scan kernel.
+template<unsigned int                     BlockSize,
+         unsigned int                     ItemsPerThread,
+         ::rocprim::block_load_method     BlockLoadMethod,
+         ::rocprim::block_store_method    BlockStoreMethod,
+         ::rocprim::block_scan_algorithm  BlockScanMethod,
+         unsigned int                     SizeLimit = ROCPRIM_GRID_SIZE_LIMIT,
+         ::rocprim::device_scan_algorithm ScanAlgorithm
+         = ::rocprim::device_scan_algorithm::default_algorithm,
+         ::rocprim::grid_launch_mode GridLaunchMode = ::rocprim::grid_launch_mode::default_mode>
 struct scan_config : ::rocprim::detail::scan_config_params
 {
     /// \brief Identifies the algorithm associated to the config.
@@ -315,13 +349,19 @@ struct scan_config : ::rocprim::detail::scan_config_params
     static constexpr ::rocprim::block_scan_algorithm block_scan_method = BlockScanMethod;
     /// \brief Limit on the number of items for a single scan kernel launch.
     static constexpr unsigned int size_limit = SizeLimit;
+    /// \brief Algorithm for the device-wide scan.
+    static constexpr ::rocprim::device_scan_algorithm scan_algorithm = ScanAlgorithm;
+    /// \brief Number of blocks of the look-back scan kernel.
+    static constexpr ::rocprim::grid_launch_mode launch_mode = GridLaunchMode;
 
     constexpr scan_config()
         : ::rocprim::detail::scan_config_params{
             {BlockSize, ItemsPerThread, SizeLimit},
             BlockLoadMethod,
             BlockStoreMethod,
-            BlockScanMethod
+            BlockScanMethod,
+            ScanAlgorithm,
+            GridLaunchMode
     } {};
 #endif
 };
@@ -746,6 +786,8 @@ struct histogram_config_params
     unsigned int max_grid_size          = 0;
     unsigned int shared_impl_max_bins   = 0;
     unsigned int shared_impl_histograms = 0;
+    unsigned int sort_impl_min_samples  = 0;
+    unsigned int shared_impl_max_passes = 0;
 };
 
 } // namespace detail
@@ -759,10 +801,23 @@ struct histogram_config_params
 /// when exceeded the global memory implementation is used (samples -> global memory bins).
 /// \tparam SharedImplHistograms - number of histograms in the shared memory to reduce bank conflicts
 /// for atomic operations with narrow sample distributions. Sweetspot for 9xx and 10xx is 3.
+/// \tparam SortImplMinSamples - minimum number of samples of all active channels for the sort-based
+/// implementation (samples -> bins sorted with radix sort -> run length encoded bins -> global
+/// memory bins), which replaces the global memory implementation if there are also at least as
+/// many samples as bins. It avoids the contention of global atomics on large skewed histograms,
+/// but its temporary storage grows with the number of samples (two arrays of unsigned int keys and
+/// the storage of radix sort). Disabled by default (\p UINT_MAX), e.g. \p (1u << 20) enables it.
+/// \tparam SharedImplMaxPasses - maximum number of passes of the shared memory implementation for
+/// histograms whose bins do not fit into shared memory at once. Every pass counts a range of
+/// \p SharedImplMaxBins / \p ActiveChannels bins of every channel and reads all samples. It is
+/// used instead of the global memory and the sort-based implementations if there are at least as
+/// many samples as bins, and needs no temporary storage. \p 1 disables it.
 template<class HistogramConfig,
          unsigned int MaxGridSize          = 1024,
          unsigned int SharedImplMaxBins    = 2048,
-         unsigned int SharedImplHistograms = 3>
+         unsigned int SharedImplHistograms = 3,
+         unsigned int SortImplMinSamples   = UINT_MAX,
+         unsigned int SharedImplMaxPasses  = 4>
 struct histogram_config : detail::histogram_config_params
 {
     /// \brief Identifies the algorithm associated to the config.
@@ -773,10 +828,16 @@ struct histogram_config : detail::histogram_config_params
     static constexpr unsigned int max_grid_size          = MaxGridSize;
     static constexpr unsigned int shared_impl_max_bins   = SharedImplMaxBins;
     static constexpr unsigned int shared_impl_histograms = SharedImplHistograms;
+    static constexpr unsigned int sort_impl_min_samples  = SortImplMinSamples;
+    static constexpr unsigned int shared_impl_max_passes = SharedImplMaxPasses;
 
     constexpr histogram_config()
-        : detail::histogram_config_params{
-            HistogramConfig{}, MaxGridSize, SharedImplMaxBins, SharedImplHistograms} {};
+        : detail::histogram_config_params{HistogramConfig{},
+                                          MaxGridSize,
+                                          SharedImplMaxBins,
+                                          SharedImplHistograms,
+                                          SortImplMinSamples,
+                                          SharedImplMaxPasses} {};
 #endif
 };
 
@@ -851,6 +912,273 @@ struct default_adjacent_difference_config_base
         ::rocprim::block_store_method::block_store_transpose>;
 };
 
+struct load_balanced_expand_config_tag
+{};
+
+struct load_balanced_expand_config_params
+{
+    kernel_config_params kernel_config;
+};
+
+} // namespace detail
+
+/// \brief Configuration of device-level load balanced expand.
+///
+/// \tparam BlockSize - number of threads in a block.
+/// \tparam ItemsPerThread - number of steps of the merge path (inputs and outputs) processed by
+/// each thread.
+template<unsigned int BlockSize, unsigned int ItemsPerThread>
+struct load_balanced_expand_config : public detail::load_balanced_expand_config_params
+{
+    /// \brief Identifies the algorithm associated to the config.
+    using tag = detail::load_balanced_expand_config_tag;
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    static constexpr unsigned int block_size       = BlockSize;
+    static constexpr unsigned int items_per_thread = ItemsPerThread;
+
+    constexpr load_balanced_expand_config()
+        : detail::load_balanced_expand_config_params{
+            {BlockSize, ItemsPerThread, ROCPRIM_GRID_SIZE_LIMIT}
+    }
+    {}
+#endif
+};
+
+namespace detail
+{
+
+template<class Offset>
+struct default_load_balanced_expand_config_base
+{
+    static constexpr unsigned int item_scale
+        = ::rocprim::detail::ceiling_div<unsigned int>(sizeof(Offset), sizeof(int));
+
+    using type = load_balanced_expand_config<256, ::rocprim::max(1u, 8u / item_scale)>;
+};
+
+struct run_length_decode_config_tag
+{};
+
+struct run_length_decode_config_params
+{
+    kernel_config_params kernel_config;
+};
+
+} // namespace detail
+
+/// \brief Configuration of device-level run length decode.
+///
+/// \tparam BlockSize - number of threads in a block.
+/// \tparam ItemsPerThread - number of steps of the merge path (runs and decoded items) processed
+/// by each thread.
+template<unsigned int BlockSize, unsigned int ItemsPerThread>
+struct run_length_decode_config : public detail::run_length_decode_config_params
+{
+    /// \brief Identifies the algorithm associated to the config.
+    using tag = detail::run_length_decode_config_tag;
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    static constexpr unsigned int block_size       = BlockSize;
+    static constexpr unsigned int items_per_thread = ItemsPerThread;
+
+    constexpr run_length_decode_config()
+        : detail::run_length_decode_config_params{
+            {BlockSize, ItemsPerThread, ROCPRIM_GRID_SIZE_LIMIT}
+    }
+    {}
+#endif
+};
+
+namespace detail
+{
+
+template<class Value>
+struct default_run_length_decode_config_base
+{
+    static constexpr unsigned int item_scale
+        = ::rocprim::detail::ceiling_div<unsigned int>(sizeof(Value), sizeof(int));
+
+    using type = run_length_decode_config<256, ::rocprim::max(1u, 8u / item_scale)>;
+};
+
+struct gather_config_tag
+{};
+struct scatter_config_tag
+{};
+
+struct gather_scatter_config_params
+{
+    kernel_config_params kernel_config;
+    bool                 detect_runs;
+};
+
+} // namespace detail
+
+/// \brief Configuration of device-level gather.
+///
+/// \tparam BlockSize - number of threads in a block.
+/// \tparam ItemsPerThread - number of items processed by each thread.
+/// \tparam DetectRuns - if \p true, threads whose indices are consecutive read their values
+/// as one contiguous range, with vector loads if possible. Useful if the indices are (nearly)
+/// sorted, otherwise it only adds the cost of the detection.
+/// \tparam SizeLimit - limit on the number of items for a single gather kernel launch.
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         bool         DetectRuns = true,
+         unsigned int SizeLimit  = ROCPRIM_GRID_SIZE_LIMIT>
+struct gather_config : public detail::gather_scatter_config_params
+{
+    /// \brief Identifies the algorithm associated to the config.
+    using tag = detail::gather_config_tag;
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    static constexpr unsigned int block_size       = BlockSize;
+    static constexpr unsigned int items_per_thread = ItemsPerThread;
+    static constexpr bool         detect_runs      = DetectRuns;
+    static constexpr unsigned int size_limit       = SizeLimit;
+
+    constexpr gather_config()
+        : detail::gather_scatter_config_params{
+            {BlockSize, ItemsPerThread, SizeLimit},
+            DetectRuns
+    }
+    {}
+#endif
+};
+
+/// \brief Configuration of device-level scatter and scatter_if.
+///
+/// \tparam BlockSize - number of threads in a block.
+/// \tparam ItemsPerThread - number of items processed by each thread.
+/// \tparam DetectRuns - if \p true, threads whose indices are consecutive write their values
+/// as one contiguous range, with vector stores if possible. Useful if the indices are (nearly)
+/// sorted, otherwise it only adds the cost of the detection.
+/// \tparam SizeLimit - limit on the number of items for a single scatter kernel launch.
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         bool         DetectRuns = true,
+         unsigned int SizeLimit  = ROCPRIM_GRID_SIZE_LIMIT>
+struct scatter_config : public detail::gather_scatter_config_params
+{
+    /// \brief Identifies the algorithm associated to the config.
+    using tag = detail::scatter_config_tag;
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    static constexpr unsigned int block_size       = BlockSize;
+    static constexpr unsigned int items_per_thread = ItemsPerThread;
+    static constexpr bool         detect_runs      = DetectRuns;
+    static constexpr unsigned int size_limit       = SizeLimit;
+
+    constexpr scatter_config()
+        : detail::gather_scatter_config_params{
+            {BlockSize, ItemsPerThread, SizeLimit},
+            DetectRuns
+    }
+    {}
+#endif
+};
+
+namespace detail
+{
+
+template<class Value>
+struct default_gather_config_base
+{
+    static constexpr unsigned int item_scale
+        = ::rocprim::detail::ceiling_div<unsigned int>(sizeof(Value), sizeof(int));
+
+    using type = gather_config<256, ::rocprim::max(1u, 16u / item_scale)>;
+};
+
+template<class Value>
+struct default_scatter_config_base
+{
+    static constexpr unsigned int item_scale
+        = ::rocprim::detail::ceiling_div<unsigned int>(sizeof(Value), sizeof(int));
+
+    using type = scatter_config<256, ::rocprim::max(1u, 16u / item_scale)>;
+};
+
+struct segmented_merge_sort_config_tag
+{};
+
+struct segmented_merge_sort_config_params
+{
+    kernel_config_params kernel_config;
+    unsigned int         logical_warp_size_small;
+    unsigned int         items_per_thread_small;
+    unsigned int         block_size_small;
+    unsigned int         partitioning_threshold;
+    unsigned int         large_segment_threshold;
+};
+
+} // namespace detail
+
+/// \brief Configuration of device-level segmented merge sort.
+///
+/// Segments of at most <tt>LogicalWarpSizeSmall * ItemsPerThreadSmall</tt> items are sorted by
+/// a logical warp each, longer segments are sorted by a block each: segments of at most
+/// <tt>BlockSize * ItemsPerThread</tt> items with a single block sort, larger ones by merging
+/// sorted tiles of that size. Segments of more than \p LargeSegmentThreshold items are sorted
+/// one after the other by the device-wide merge sort, which merges with all blocks of the device.
+///
+/// \tparam BlockSize - number of threads in a block sorting a medium or large segment.
+/// \tparam ItemsPerThread - number of items processed by each thread of those blocks.
+/// \tparam LogicalWarpSizeSmall - number of threads in a logical warp sorting a small segment.
+/// \tparam ItemsPerThreadSmall - number of items processed by each thread of those warps.
+/// \tparam BlockSizeSmall - number of threads in a block of the small segments kernel.
+/// \tparam PartitioningThreshold - the segments are only partitioned into small and larger
+/// segments if there are at least this many segments, otherwise all segments are sorted
+/// by blocks.
+/// \tparam LargeSegmentThreshold - segments of more than this many items are sorted by the
+/// device-wide merge sort. The segments are partitioned whenever the input is larger than this,
+/// regardless of \p PartitioningThreshold.
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         unsigned int LogicalWarpSizeSmall  = 32,
+         unsigned int ItemsPerThreadSmall   = 4,
+         unsigned int BlockSizeSmall        = 256,
+         unsigned int PartitioningThreshold = 3000,
+         unsigned int LargeSegmentThreshold = (1u << 18)>
+struct segmented_merge_sort_config : public detail::segmented_merge_sort_config_params
+{
+    /// \brief Identifies the algorithm associated to the config.
+    using tag = detail::segmented_merge_sort_config_tag;
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    static constexpr unsigned int block_size              = BlockSize;
+    static constexpr unsigned int items_per_thread        = ItemsPerThread;
+    static constexpr unsigned int logical_warp_size_small = LogicalWarpSizeSmall;
+    static constexpr unsigned int items_per_thread_small  = ItemsPerThreadSmall;
+    static constexpr unsigned int block_size_small        = BlockSizeSmall;
+    static constexpr unsigned int partitioning_threshold  = PartitioningThreshold;
+    static constexpr unsigned int large_segment_threshold = LargeSegmentThreshold;
+
+    constexpr segmented_merge_sort_config()
+        : detail::segmented_merge_sort_config_params{
+            {BlockSize, ItemsPerThread, ROCPRIM_GRID_SIZE_LIMIT},
+            LogicalWarpSizeSmall,
+            ItemsPerThreadSmall,
+            BlockSizeSmall,
+            PartitioningThreshold,
+            LargeSegmentThreshold
+    }
+    {}
+#endif
+};
+
+namespace detail
+{
+
+template<class Key, class Value>
+struct default_segmented_merge_sort_config_base
+{
+    static constexpr unsigned int item_scale = ::rocprim::detail::ceiling_div<unsigned int>(
+        ::rocprim::max(sizeof(Key), sizeof(Value)), sizeof(int));
+
+    using type = segmented_merge_sort_config<256,
+                                             ::rocprim::max(1u, 8u / item_scale),
+                                             32,
+                                             ::rocprim::max(1u, 8u / item_scale),
+                                             256>;
+};
+
 } // namespace detail
 
 END_ROCPRIM_NAMESPACE
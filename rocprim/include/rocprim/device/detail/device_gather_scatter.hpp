@@ -0,0 +1,456 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_GATHER_SCATTER_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_GATHER_SCATTER_HPP_
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+
+#include "../../intrinsics.hpp"
+#include "../../types.hpp"
+
+#include "../../block/block_load.hpp"
+#include "../../block/block_load_func.hpp"
+#include "../../block/block_store.hpp"
+#include "../../block/block_store_func.hpp"
+
+#include "../device_gather_scatter_config.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Gather and scatter process the indices either in a striped arrangement (every item is moved
+// on its own, consecutive indices are still coalesced across the lanes of a wavefront), or in a
+// blocked arrangement when run detection is enabled. In the latter case a thread whose indices
+// are consecutive (a run) moves its values as one contiguous range, with vector loads or stores
+// when the values are accessed through a suitably aligned pointer.
+
+// Vector loads and stores are only possible through pointers
+template<class Iterator, unsigned int ItemsPerThread>
+struct is_vectorizable_pointer : std::false_type
+{};
+
+template<class T, unsigned int ItemsPerThread>
+struct is_vectorizable_pointer<T*, ItemsPerThread> : is_vectorizable<T, ItemsPerThread>
+{};
+
+// Returns true if the indices of the thread are consecutive
+template<class Index, unsigned int ItemsPerThread>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+bool is_index_run(const Index (&indices)[ItemsPerThread])
+{
+    bool is_run = true;
+    ROCPRIM_UNROLL
+    for(unsigned int i = 1; i < ItemsPerThread; i++)
+    {
+        is_run &= indices[i] == indices[0] + static_cast<Index>(i);
+    }
+    return is_run;
+}
+
+template<unsigned int ItemsPerThread, class T>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+bool is_vector_aligned(T* ptr)
+{
+    using vector_type = typename match_vector_type<T, ItemsPerThread>::type;
+    return reinterpret_cast<uintptr_t>(ptr) % alignof(vector_type) == 0;
+}
+
+// Reads the values of a run, returns false if they must be read one by one instead.
+template<class InputIterator, class T, unsigned int ItemsPerThread>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+auto gather_run(InputIterator run, T (&values)[ItemsPerThread]) ->
+    typename std::enable_if<is_vectorizable_pointer<InputIterator, ItemsPerThread>::value,
+                            bool>::type
+{
+    if(!is_vector_aligned<ItemsPerThread>(run))
+    {
+        return false;
+    }
+    block_load_direct_blocked_vectorized(0, run, values);
+    return true;
+}
+
+template<class InputIterator, class T, unsigned int ItemsPerThread>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+auto gather_run(InputIterator run, T (&values)[ItemsPerThread]) ->
+    typename std::enable_if<!is_vectorizable_pointer<InputIterator, ItemsPerThread>::value,
+                            bool>::type
+{
+    block_load_direct_blocked(0, run, values);
+    return true;
+}
+
+// Writes the values of a run, returns false if they must be written one by one instead.
+template<class OutputIterator, class T, unsigned int ItemsPerThread>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+auto scatter_run(OutputIterator run, T (&values)[ItemsPerThread]) ->
+    typename std::enable_if<is_vectorizable_pointer<OutputIterator, ItemsPerThread>::value,
+                            bool>::type
+{
+    if(!is_vector_aligned<ItemsPerThread>(run))
+    {
+        return false;
+    }
+    block_store_direct_blocked_vectorized(0, run, values);
+    return true;
+}
+
+template<class OutputIterator, class T, unsigned int ItemsPerThread>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+auto scatter_run(OutputIterator run, T (&values)[ItemsPerThread]) ->
+    typename std::enable_if<!is_vectorizable_pointer<OutputIterator, ItemsPerThread>::value,
+                            bool>::type
+{
+    block_store_direct_blocked(0, run, values);
+    return true;
+}
+
+// Gather of a tile with run detection
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         class InputIterator,
+         class IndexIterator,
+         class OutputIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void gather_tile(InputIterator      input,
+                 IndexIterator      indices,
+                 OutputIterator     output,
+                 const unsigned int valid_in_block,
+                 std::true_type /*detect_runs*/)
+{
+    using index_type = typename std::iterator_traits<IndexIterator>::value_type;
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    using block_load_type
+        = block_load<index_type, BlockSize, ItemsPerThread, block_load_method::block_load_transpose>;
+    using block_store_type = block_store<value_type,
+                                         BlockSize,
+                                         ItemsPerThread,
+                                         block_store_method::block_store_transpose>;
+
+    ROCPRIM_SHARED_MEMORY union
+    {
+        typename block_load_type::storage_type  load;
+        typename block_store_type::storage_type store;
+    } storage;
+
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+    const unsigned int     flat_id         = ::rocprim::detail::block_thread_id<0>();
+    const bool             is_full_block   = valid_in_block == items_per_block;
+
+    index_type thread_indices[ItemsPerThread];
+    value_type values[ItemsPerThread];
+
+    if(is_full_block)
+    {
+        block_load_type().load(indices, thread_indices, storage.load);
+    }
+    else
+    {
+        block_load_type().load(indices, thread_indices, valid_in_block, storage.load);
+    }
+
+    const unsigned int thread_offset = flat_id * ItemsPerThread;
+    const unsigned int valid
+        = thread_offset < valid_in_block
+              ? ::rocprim::min(ItemsPerThread, valid_in_block - thread_offset)
+              : 0u;
+
+    if(!(valid == ItemsPerThread && is_index_run(thread_indices)
+         && gather_run(input + thread_indices[0], values)))
+    {
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            if(i < valid)
+            {
+                values[i] = input[thread_indices[i]];
+            }
+        }
+    }
+    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+    if(is_full_block)
+    {
+        block_store_type().store(output, values, storage.store);
+    }
+    else
+    {
+        block_store_type().store(output, values, valid_in_block, storage.store);
+    }
+}
+
+// Gather of a tile without run detection
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         class InputIterator,
+         class IndexIterator,
+         class OutputIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void gather_tile(InputIterator      input,
+                 IndexIterator      indices,
+                 OutputIterator     output,
+                 const unsigned int valid_in_block,
+                 std::false_type /*detect_runs*/)
+{
+    using index_type = typename std::iterator_traits<IndexIterator>::value_type;
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+    const unsigned int     flat_id         = ::rocprim::detail::block_thread_id<0>();
+
+    index_type thread_indices[ItemsPerThread];
+    value_type values[ItemsPerThread];
+
+    if(valid_in_block == items_per_block)
+    {
+        block_load_direct_striped<BlockSize>(flat_id, indices, thread_indices);
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            values[i] = input[thread_indices[i]];
+        }
+
+        block_store_direct_striped<BlockSize>(flat_id, output, values);
+    }
+    else
+    {
+        block_load_direct_striped<BlockSize>(flat_id, indices, thread_indices, valid_in_block);
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            if(BlockSize * i + flat_id < valid_in_block)
+            {
+                values[i] = input[thread_indices[i]];
+            }
+        }
+
+        block_store_direct_striped<BlockSize>(flat_id, output, values, valid_in_block);
+    }
+}
+
+template<class Config, class InputIterator, class IndexIterator, class OutputIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void gather_kernel_impl(InputIterator  input,
+                        IndexIterator  indices,
+                        OutputIterator output,
+                        const size_t   size)
+{
+    static constexpr gather_scatter_config_params params = device_params<Config>();
+
+    constexpr unsigned int block_size       = params.kernel_config.block_size;
+    constexpr unsigned int items_per_thread = params.kernel_config.items_per_thread;
+    constexpr unsigned int items_per_block  = block_size * items_per_thread;
+
+    const unsigned int block_offset = ::rocprim::detail::block_id<0>() * items_per_block;
+    const unsigned int valid_in_block = static_cast<unsigned int>(
+        ::rocprim::min<size_t>(size - block_offset, items_per_block));
+
+    gather_tile<block_size, items_per_thread>(input,
+                                              indices + block_offset,
+                                              output + block_offset,
+                                              valid_in_block,
+                                              bool_constant<params.detect_runs>{});
+}
+
+// Scatter of a tile with run detection. A run is only written as a whole if all its flags are set.
+template<bool         WithFlags,
+         unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         class InputIterator,
+         class IndexIterator,
+         class FlagIterator,
+         class OutputIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void scatter_tile(InputIterator      input,
+                  IndexIterator      indices,
+                  FlagIterator       flags,
+                  OutputIterator     output,
+                  const unsigned int valid_in_block,
+                  std::true_type /*detect_runs*/)
+{
+    using index_type = typename std::iterator_traits<IndexIterator>::value_type;
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    using block_load_value_type
+        = block_load<value_type, BlockSize, ItemsPerThread, block_load_method::block_load_transpose>;
+    using block_load_index_type
+        = block_load<index_type, BlockSize, ItemsPerThread, block_load_method::block_load_transpose>;
+    using block_load_flag_type
+        = block_load<bool, BlockSize, ItemsPerThread, block_load_method::block_load_transpose>;
+
+    ROCPRIM_SHARED_MEMORY union
+    {
+        typename block_load_value_type::storage_type load_value;
+        typename block_load_index_type::storage_type load_index;
+        typename block_load_flag_type::storage_type  load_flag;
+    } storage;
+
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+    const unsigned int     flat_id         = ::rocprim::detail::block_thread_id<0>();
+    const bool             is_full_block   = valid_in_block == items_per_block;
+
+    value_type values[ItemsPerThread];
+    index_type thread_indices[ItemsPerThread];
+    bool       thread_flags[ItemsPerThread];
+
+    if(is_full_block)
+    {
+        block_load_value_type().load(input, values, storage.load_value);
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
+        block_load_index_type().load(indices, thread_indices, storage.load_index);
+        if(WithFlags)
+        {
+            ::rocprim::syncthreads(); // sync threads to reuse shared memory
+            block_load_flag_type().load(flags, thread_flags, storage.load_flag);
+        }
+    }
+    else
+    {
+        block_load_value_type().load(input, values, valid_in_block, storage.load_value);
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
+        block_load_index_type().load(indices, thread_indices, valid_in_block, storage.load_index);
+        if(WithFlags)
+        {
+            ::rocprim::syncthreads(); // sync threads to reuse shared memory
+            block_load_flag_type().load(flags,
+                                        thread_flags,
+                                        valid_in_block,
+                                        storage.load_flag);
+        }
+    }
+
+    const unsigned int thread_offset = flat_id * ItemsPerThread;
+    const unsigned int valid
+        = thread_offset < valid_in_block
+              ? ::rocprim::min(ItemsPerThread, valid_in_block - thread_offset)
+              : 0u;
+
+    bool is_run = valid == ItemsPerThread && is_index_run(thread_indices);
+    if(WithFlags)
+    {
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            is_run &= thread_flags[i];
+        }
+    }
+
+    if(!(is_run && scatter_run(output + thread_indices[0], values)))
+    {
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            if(i < valid && (!WithFlags || thread_flags[i]))
+            {
+                output[thread_indices[i]] = values[i];
+            }
+        }
+    }
+}
+
+// Scatter of a tile without run detection
+template<bool         WithFlags,
+         unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         class InputIterator,
+         class IndexIterator,
+         class FlagIterator,
+         class OutputIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void scatter_tile(InputIterator      input,
+                  IndexIterator      indices,
+                  FlagIterator       flags,
+                  OutputIterator     output,
+                  const unsigned int valid_in_block,
+                  std::false_type /*detect_runs*/)
+{
+    using index_type = typename std::iterator_traits<IndexIterator>::value_type;
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+
+    value_type values[ItemsPerThread];
+    index_type thread_indices[ItemsPerThread];
+    bool       thread_flags[ItemsPerThread];
+
+    block_load_direct_striped<BlockSize>(flat_id, input, values, valid_in_block);
+    block_load_direct_striped<BlockSize>(flat_id, indices, thread_indices, valid_in_block);
+    if(WithFlags)
+    {
+        block_load_direct_striped<BlockSize>(flat_id, flags, thread_flags, valid_in_block);
+    }
+
+    ROCPRIM_UNROLL
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        if(BlockSize * i + flat_id < valid_in_block && (!WithFlags || thread_flags[i]))
+        {
+            output[thread_indices[i]] = values[i];
+        }
+    }
+}
+
+template<bool WithFlags,
+         class Config,
+         class InputIterator,
+         class IndexIterator,
+         class FlagIterator,
+         class OutputIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void scatter_kernel_impl(InputIterator  input,
+                         IndexIterator  indices,
+                         FlagIterator   flags,
+                         OutputIterator output,
+                         const size_t   size)
+{
+    static constexpr gather_scatter_config_params params = device_params<Config>();
+
+    constexpr unsigned int block_size       = params.kernel_config.block_size;
+    constexpr unsigned int items_per_thread = params.kernel_config.items_per_thread;
+    constexpr unsigned int items_per_block  = block_size * items_per_thread;
+
+    const unsigned int block_offset = ::rocprim::detail::block_id<0>() * items_per_block;
+    const unsigned int valid_in_block = static_cast<unsigned int>(
+        ::rocprim::min<size_t>(size - block_offset, items_per_block));
+
+    scatter_tile<WithFlags, block_size, items_per_thread>(input + block_offset,
+                                                          indices + block_offset,
+                                                          flags + block_offset,
+                                                          output,
+                                                          valid_in_block,
+                                                          bool_constant<params.detect_runs>{});
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_GATHER_SCATTER_HPP_
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -22,7 +22,9 @@
 #define ROCPRIM_DEVICE_DETAIL_DEVICE_HISTOGRAM_HPP_
 
 #include <cmath>
+#include <cstdint>
 #include <iterator>
+#include <limits>
 #include <type_traits>
 
 #include "../../config.hpp"
@@ -32,6 +34,9 @@
 #include "../../type_traits.hpp"
 
 #include "../../block/block_load.hpp"
+#include "../../block/block_reduce.hpp"
+
+#include "../device_trace.hpp"
 
 #include "uint_fast_div.hpp"
 
@@ -305,6 +310,193 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void
     }
 }
 
+// Loads a full tile of samples. The samples of weighted histograms are loaded in blocked
+// arrangement, like their weights.
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         unsigned int Channels,
+         class Sample,
+         class SampleIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE void
+    load_samples_tile(unsigned int   flat_id,
+                      SampleIterator samples,
+                      sample_vector<Sample, Channels> (&values)[ItemsPerThread],
+                      std::false_type /*weighted*/)
+{
+    load_samples<BlockSize>(flat_id, samples, values);
+}
+
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         unsigned int Channels,
+         class Sample,
+         class SampleIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE void
+    load_samples_tile(unsigned int   flat_id,
+                      SampleIterator samples,
+                      sample_vector<Sample, Channels> (&values)[ItemsPerThread],
+                      std::true_type /*weighted*/)
+{
+    load_samples<BlockSize>(flat_id, samples, values, BlockSize * ItemsPerThread);
+}
+
+// Weights of unweighted histograms: every sample adds 1 to its bin
+struct histogram_unweighted
+{
+    ROCPRIM_HOST_DEVICE histogram_unweighted operator+(size_t) const
+    {
+        return *this;
+    }
+};
+
+template<class WeightIterator>
+struct is_histogram_weighted : std::true_type
+{};
+
+template<>
+struct is_histogram_weighted<histogram_unweighted> : std::false_type
+{};
+
+// Type of the privatized shared memory histograms, they are flushed to the global histograms
+// once per block. Counts are accumulated as integers (also for floating point counters, so they
+// stay exact), weights as double or 64-bit integers.
+template<class Counter, bool Weighted>
+using histogram_accumulator_t = typename std::conditional<
+    Weighted,
+    typename std::conditional<std::is_floating_point<Counter>::value, double, unsigned long long>::
+        type,
+    typename std::conditional<(sizeof(Counter) > sizeof(unsigned int)),
+                              unsigned long long,
+                              unsigned int>::type>::type;
+
+// Weights of the samples of a thread, in blocked arrangement
+template<class WeightIterator, unsigned int ItemsPerThread>
+struct histogram_thread_weights
+{
+    using weight_type = typename std::iterator_traits<WeightIterator>::value_type;
+
+    weight_type values[ItemsPerThread];
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void
+        load(unsigned int flat_id, WeightIterator weights, unsigned int valid_count)
+    {
+        block_load_direct_blocked(flat_id, weights, values, valid_count);
+    }
+
+    template<class T>
+    ROCPRIM_DEVICE ROCPRIM_INLINE T get(unsigned int i) const
+    {
+        return static_cast<T>(values[i]);
+    }
+};
+
+template<unsigned int ItemsPerThread>
+struct histogram_thread_weights<histogram_unweighted, ItemsPerThread>
+{
+    ROCPRIM_DEVICE ROCPRIM_INLINE void load(unsigned int, histogram_unweighted, unsigned int) {}
+
+    template<class T>
+    ROCPRIM_DEVICE ROCPRIM_INLINE T get(unsigned int) const
+    {
+        return T(1);
+    }
+};
+
+// Counts the atomic updates of bins of the calling thread. The counts are only kept if
+// ROCPRIM_INSTRUMENT is enabled, otherwise all member functions are empty. The functions must be
+// called by all lanes that execute the atomic add, before it.
+struct histogram_probe
+{
+#if ROCPRIM_INSTRUMENT
+    ROCPRIM_DEVICE ROCPRIM_INLINE void shared_atomic(const void* address)
+    {
+        counts.shared_atomics++;
+        counts.shared_conflicts += same_address_lanes(address);
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void global_atomic(const void* address)
+    {
+        counts.global_atomics++;
+        counts.global_conflicts += same_address_lanes(address);
+    }
+
+    histogram_counters counts{};
+
+private:
+    // Number of the other active lanes of the warp that update the same address
+    ROCPRIM_DEVICE ROCPRIM_INLINE static unsigned int same_address_lanes(const void* address)
+    {
+        const uintptr_t key            = reinterpret_cast<uintptr_t>(address);
+        lane_mask_type  same_key_lanes = ::rocprim::ballot(1);
+        for(unsigned int b = 0; b < std::numeric_limits<uintptr_t>::digits; b++)
+        {
+            const int            bit_set      = (key >> b) & 1u;
+            const lane_mask_type bit_set_mask = ::rocprim::ballot(bit_set);
+            same_key_lanes &= bit_set ? bit_set_mask : ~bit_set_mask;
+        }
+        return ::rocprim::bit_count(same_key_lanes) - 1;
+    }
+#else
+    ROCPRIM_DEVICE ROCPRIM_INLINE void shared_atomic(const void* /*address*/) {}
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void global_atomic(const void* /*address*/) {}
+#endif
+};
+
+// Counters of the instrument_scope that was active when the histogram was launched. Empty if
+// ROCPRIM_INSTRUMENT is disabled.
+struct histogram_instrumentation
+{
+#if ROCPRIM_INSTRUMENT
+    ROCPRIM_HOST histogram_instrumentation()
+    {
+        const instrument_buffer& buffer = current_instrument_buffer();
+        counters_                       = buffer.bin_counters;
+        size_                           = static_cast<unsigned int>(
+            ::rocprim::min<size_t>(buffer.bin_size, std::numeric_limits<unsigned int>::max()));
+    }
+
+    // Adds the counts of the calling thread to the counters of its block
+    ROCPRIM_DEVICE ROCPRIM_INLINE void record(const histogram_probe& probe) const
+    {
+        if(counters_ == nullptr)
+        {
+            return;
+        }
+        const unsigned int block_id
+            = (::rocprim::detail::block_id<2>() * ::rocprim::detail::grid_size<1>()
+               + ::rocprim::detail::block_id<1>())
+                  * ::rocprim::detail::grid_size<0>()
+              + ::rocprim::detail::block_id<0>();
+        histogram_counters& counters = counters_[block_id % size_];
+        if(probe.counts.shared_atomics != 0)
+        {
+            ::rocprim::detail::atomic_add(&counters.shared_atomics, probe.counts.shared_atomics);
+        }
+        if(probe.counts.shared_conflicts != 0)
+        {
+            ::rocprim::detail::atomic_add(&counters.shared_conflicts,
+                                          probe.counts.shared_conflicts);
+        }
+        if(probe.counts.global_atomics != 0)
+        {
+            ::rocprim::detail::atomic_add(&counters.global_atomics, probe.counts.global_atomics);
+        }
+        if(probe.counts.global_conflicts != 0)
+        {
+            ::rocprim::detail::atomic_add(&counters.global_conflicts,
+                                          probe.counts.global_conflicts);
+        }
+    }
+
+private:
+    histogram_counters* counters_;
+    unsigned int        size_;
+#else
+    ROCPRIM_DEVICE ROCPRIM_INLINE void record(const histogram_probe& /*probe*/) const {}
+#endif
+};
+
 template<unsigned int BlockSize, unsigned int ActiveChannels, class Counter>
 ROCPRIM_DEVICE ROCPRIM_INLINE void init_histogram(fixed_array<Counter*, ActiveChannels> histogram,
                                                   fixed_array<unsigned int, ActiveChannels> bins)
@@ -327,22 +519,28 @@ template<unsigned int BlockSize,
          unsigned int Channels,
          unsigned int ActiveChannels,
          class SampleIterator,
+         class WeightIterator,
          class Counter,
-         class SampleToBinOp>
+         class SampleToBinOp,
+         class Accumulator>
 ROCPRIM_DEVICE ROCPRIM_INLINE void
     histogram_shared(SampleIterator                             samples,
+                     WeightIterator                             weights,
                      unsigned int                               columns,
                      unsigned int                               rows,
                      unsigned int                               row_stride,
                      unsigned int                               rows_per_block,
                      unsigned int                               shared_histograms,
+                     unsigned int                               bins_per_pass,
                      fixed_array<Counter*, ActiveChannels>      histogram,
                      fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op,
                      fixed_array<unsigned int, ActiveChannels>  bins,
-                     unsigned int*                              block_histogram_start)
+                     Accumulator*                               block_histogram_start,
+                     const histogram_instrumentation&           instrumentation)
 {
     using sample_type        = typename std::iterator_traits<SampleIterator>::value_type;
     using sample_vector_type = sample_vector<sample_type, Channels>;
+    using weighted           = is_histogram_weighted<WeightIterator>;
 
     constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
 
@@ -351,18 +549,29 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void
     const unsigned int block_id1  = ::rocprim::detail::block_id<1>();
     const unsigned int grid_size0 = ::rocprim::detail::grid_size<0>();
 
-    // starts of the first histogram for each channel
-    unsigned int* block_histogram[ActiveChannels];
-    unsigned int  total_bins = 0;
+    // Histograms with more bins than fit into shared memory are computed in passes, the blocks
+    // of pass block_id<2>() only count the bins [pass_begin, pass_begin + bins_per_pass) of
+    // every channel
+    const unsigned int pass_begin = ::rocprim::detail::block_id<2>() * bins_per_pass;
+
+    // starts of the first histogram for each channel and the number of bins of the pass
+    Accumulator* block_histogram[ActiveChannels];
+    unsigned int pass_bins[ActiveChannels];
+    unsigned int total_bins = 0;
     for(unsigned int channel = 0; channel < ActiveChannels; channel++)
     {
         block_histogram[channel] = block_histogram_start + total_bins;
-        total_bins += bins[channel];
+        pass_bins[channel]
+            = pass_begin < bins[channel] ? ::rocprim::min(bins[channel] - pass_begin, bins_per_pass)
+                                         : 0;
+        total_bins += pass_bins[channel];
     }
 
     // partial histogram to work with
     const unsigned int thread_shift = (flat_id % shared_histograms) * total_bins;
 
+    histogram_probe probe;
+
     // fill all histograms with 0
     for(unsigned int i = flat_id; i < total_bins * shared_histograms; i += BlockSize)
     {
@@ -375,26 +584,34 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void
     for(unsigned int row = start_row; row < end_row; row++)
     {
         SampleIterator row_samples = samples + row * row_stride;
+        WeightIterator row_weights = weights + static_cast<size_t>(row) * columns;
 
         unsigned int block_offset = block_id0 * items_per_block;
         while(block_offset < columns)
         {
-            sample_vector_type values[ItemsPerThread];
+            sample_vector_type                                     values[ItemsPerThread];
+            histogram_thread_weights<WeightIterator, ItemsPerThread> thread_weights;
 
             if(block_offset + items_per_block <= columns)
             {
-                load_samples<BlockSize>(flat_id, row_samples + Channels * block_offset, values);
+                load_samples_tile<BlockSize>(flat_id,
+                                             row_samples + Channels * block_offset,
+                                             values,
+                                             weighted{});
+                thread_weights.load(flat_id, row_weights + block_offset, items_per_block);
 
                 for(unsigned int i = 0; i < ItemsPerThread; i++)
                 {
                     for(unsigned int channel = 0; channel < ActiveChannels; channel++)
                     {
                         unsigned int bin;
-                        if(sample_to_bin_op[channel](values[i].values[channel], bin))
+                        if(sample_to_bin_op[channel](values[i].values[channel], bin)
+                           && (bin -= pass_begin) < pass_bins[channel])
                         {
+                            probe.shared_atomic(block_histogram[channel] + bin + thread_shift);
                             ::rocprim::detail::atomic_add(block_histogram[channel] + bin
                                                               + thread_shift,
-                                                          1);
+                                                          thread_weights.template get<Accumulator>(i));
                         }
                     }
                 }
@@ -406,6 +623,7 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void
                                         row_samples + Channels * block_offset,
                                         values,
                                         valid_count);
+                thread_weights.load(flat_id, row_weights + block_offset, valid_count);
 
                 for(unsigned int i = 0; i < ItemsPerThread; i++)
                 {
@@ -414,11 +632,14 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void
                         for(unsigned int channel = 0; channel < ActiveChannels; channel++)
                         {
                             unsigned int bin;
-                            if(sample_to_bin_op[channel](values[i].values[channel], bin))
+                            if(sample_to_bin_op[channel](values[i].values[channel], bin)
+                               && (bin -= pass_begin) < pass_bins[channel])
                             {
-                                ::rocprim::detail::atomic_add(block_histogram[channel] + bin
-                                                                  + thread_shift,
-                                                              1);
+                                probe.shared_atomic(block_histogram[channel] + bin
+                                                    + thread_shift);
+                                ::rocprim::detail::atomic_add(
+                                    block_histogram[channel] + bin + thread_shift,
+                                    thread_weights.template get<Accumulator>(i));
                             }
                         }
                     }
@@ -432,19 +653,22 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void
 
     for(unsigned int channel = 0; channel < ActiveChannels; channel++)
     {
-        for(unsigned int bin = flat_id; bin < bins[channel]; bin += BlockSize)
+        for(unsigned int bin = flat_id; bin < pass_bins[channel]; bin += BlockSize)
         {
-            unsigned int total = 0;
+            Accumulator total = 0;
             for(unsigned int i = 0; i < shared_histograms; i++)
             {
                 total += block_histogram[channel][bin + i * total_bins];
             }
-            if(total > 0)
+            if(total != Accumulator(0))
             {
-                ::rocprim::detail::atomic_add(&histogram[channel][bin], total);
+                probe.global_atomic(&histogram[channel][pass_begin + bin]);
+                ::rocprim::detail::atomic_add(&histogram[channel][pass_begin + bin],
+                                              static_cast<Counter>(total));
             }
         }
     }
+    instrumentation.record(probe);
 }
 
 template<unsigned int BlockSize,
@@ -452,18 +676,22 @@ template<unsigned int BlockSize,
          unsigned int Channels,
          unsigned int ActiveChannels,
          class SampleIterator,
+         class WeightIterator,
          class Counter,
          class SampleToBinOp>
 ROCPRIM_DEVICE ROCPRIM_INLINE void
     histogram_global(SampleIterator                             samples,
+                     WeightIterator                             weights,
                      unsigned int                               columns,
                      unsigned int                               row_stride,
                      fixed_array<Counter*, ActiveChannels>      histogram,
                      fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op,
-                     fixed_array<unsigned int, ActiveChannels>  bins_bits)
+                     fixed_array<unsigned int, ActiveChannels>  bins_bits,
+                     const histogram_instrumentation&           instrumentation)
 {
     using sample_type        = typename std::iterator_traits<SampleIterator>::value_type;
     using sample_vector_type = sample_vector<sample_type, Channels>;
+    using weighted           = is_histogram_weighted<WeightIterator>;
 
     constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
 
@@ -473,13 +701,14 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void
     const unsigned int block_offset = block_id0 * items_per_block;
 
     samples += block_id1 * row_stride + Channels * block_offset;
+    weights = weights + (static_cast<size_t>(block_id1) * columns + block_offset);
 
     sample_vector_type values[ItemsPerThread];
     unsigned int       valid_count;
     if(block_offset + items_per_block <= columns)
     {
         valid_count = items_per_block;
-        load_samples<BlockSize>(flat_id, samples, values);
+        load_samples_tile<BlockSize>(flat_id, samples, values, weighted{});
     }
     else
     {
@@ -487,12 +716,27 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void
         load_samples<BlockSize>(flat_id, samples, values, valid_count);
     }
 
+    histogram_thread_weights<WeightIterator, ItemsPerThread> thread_weights;
+    thread_weights.load(flat_id, weights, valid_count);
+
+    histogram_probe probe;
     for(unsigned int i = 0; i < ItemsPerThread; i++)
     {
         for(unsigned int channel = 0; channel < ActiveChannels; channel++)
         {
             unsigned int bin;
-            if(sample_to_bin_op[channel](values[i].values[channel], bin))
+            if(weighted::value)
+            {
+                // Weights of different lanes can not be aggregated with a bit count
+                if(flat_id * ItemsPerThread + i < valid_count
+                   && sample_to_bin_op[channel](values[i].values[channel], bin))
+                {
+                    probe.global_atomic(&histogram[channel][bin]);
+                    ::rocprim::detail::atomic_add(&histogram[channel][bin],
+                                                  thread_weights.template get<Counter>(i));
+                }
+            }
+            else if(sample_to_bin_op[channel](values[i].values[channel], bin))
             {
                 const unsigned int pos                 = flat_id * ItemsPerThread + i;
                 lane_mask_type     same_bin_lanes_mask = ::rocprim::ballot(pos < valid_count);
@@ -506,12 +750,375 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void
                 {
                     // Write the number of lanes having this bin,
                     // if the current lane is the first (and maybe only) lane with this bin.
-                    ::rocprim::detail::atomic_add(&histogram[channel][bin],
-                                                  ::rocprim::bit_count(same_bin_lanes_mask));
+                    probe.global_atomic(&histogram[channel][bin]);
+                    ::rocprim::detail::atomic_add(
+                        &histogram[channel][bin],
+                        static_cast<Counter>(::rocprim::bit_count(same_bin_lanes_mask)));
                 }
             }
         }
     }
+    instrumentation.record(probe);
+}
+
+// The sort-based implementation concatenates the bins of all active channels into one key space
+// [0, total_bins) and uses total_bins as the key of samples that are outside of the histogram.
+// The keys are sorted and run length encoded, the runs are the bin counts.
+
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         unsigned int Channels,
+         unsigned int ActiveChannels,
+         class SampleIterator,
+         class SampleToBinOp>
+ROCPRIM_DEVICE ROCPRIM_INLINE void
+    histogram_sort_keys(SampleIterator                             samples,
+                        unsigned int                               columns,
+                        unsigned int                               row_stride,
+                        fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op,
+                        fixed_array<unsigned int, ActiveChannels>  bins,
+                        unsigned int*                              keys)
+{
+    using sample_type        = typename std::iterator_traits<SampleIterator>::value_type;
+    using sample_vector_type = sample_vector<sample_type, Channels>;
+
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    const unsigned int flat_id      = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_id0    = ::rocprim::detail::block_id<0>();
+    const unsigned int block_id1    = ::rocprim::detail::block_id<1>();
+    const unsigned int block_offset = block_id0 * items_per_block;
+
+    samples += block_id1 * row_stride + Channels * block_offset;
+    keys += (static_cast<size_t>(block_id1) * columns + block_offset) * ActiveChannels;
+
+    unsigned int channel_offsets[ActiveChannels];
+    unsigned int total_bins = 0;
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+    {
+        channel_offsets[channel] = total_bins;
+        total_bins += bins[channel];
+    }
+
+    sample_vector_type values[ItemsPerThread];
+    unsigned int       valid_count;
+    if(block_offset + items_per_block <= columns)
+    {
+        valid_count = items_per_block;
+        load_samples<BlockSize>(flat_id, samples, values);
+    }
+    else
+    {
+        valid_count = columns - block_offset;
+        load_samples<BlockSize>(flat_id, samples, values, valid_count);
+    }
+
+    // The keys of a full tile may not be in the order of the samples (vectorized loads are
+    // striped), which does not matter as they are sorted.
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        const unsigned int pos = flat_id * ItemsPerThread + i;
+        if(pos < valid_count)
+        {
+            for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+            {
+                unsigned int bin;
+                keys[pos * ActiveChannels + channel]
+                    = sample_to_bin_op[channel](values[i].values[channel], bin)
+                          ? channel_offsets[channel] + bin
+                          : total_bins;
+            }
+        }
+    }
+}
+
+template<unsigned int BlockSize, unsigned int ActiveChannels, class Counter>
+ROCPRIM_DEVICE ROCPRIM_INLINE void
+    histogram_sort_scatter(const unsigned int*                       unique_bins,
+                           const unsigned int*                       counts,
+                           const unsigned int*                       runs_count,
+                           fixed_array<Counter*, ActiveChannels>     histogram,
+                           fixed_array<unsigned int, ActiveChannels> bins)
+{
+    const unsigned int index = ::rocprim::detail::block_id<0>() * BlockSize
+                               + ::rocprim::detail::block_thread_id<0>();
+    if(index >= *runs_count)
+    {
+        return;
+    }
+
+    // Every bin has at most one run, so the counts can be stored without atomics
+    unsigned int bin = unique_bins[index];
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+    {
+        if(bin < bins[channel])
+        {
+            histogram[channel][bin] = static_cast<Counter>(counts[index]);
+            return;
+        }
+        bin -= bins[channel];
+    }
+}
+
+// Joint (multi-dimensional) histograms: the bin of a pixel combines the bins of its first
+// Dimensions channels, the last dimension is contiguous in the histogram.
+//
+// Every block privatizes a sub-cube of the joint bins in shared memory: the whole histogram if it
+// fits, otherwise the bounding box of the bins of its tile (spatially coherent inputs, like
+// images, usually have small boxes). Tiles whose box does not fit update the histogram directly.
+
+// Inclusive bounding box of joint bins, an empty box has lo > hi
+template<unsigned int Dimensions>
+struct histogram_nd_box
+{
+    unsigned int lo[Dimensions];
+    unsigned int hi[Dimensions];
+};
+
+template<unsigned int Dimensions>
+struct histogram_nd_box_union
+{
+    ROCPRIM_DEVICE ROCPRIM_INLINE histogram_nd_box<Dimensions>
+        operator()(const histogram_nd_box<Dimensions>& a,
+                   const histogram_nd_box<Dimensions>& b) const
+    {
+        histogram_nd_box<Dimensions> result;
+        for(unsigned int dim = 0; dim < Dimensions; dim++)
+        {
+            result.lo[dim] = ::rocprim::min(a.lo[dim], b.lo[dim]);
+            result.hi[dim] = ::rocprim::max(a.hi[dim], b.hi[dim]);
+        }
+        return result;
+    }
+};
+
+// Computes the bins of every dimension of the pixels of a tile. Returns false for pixels outside
+// of the tile or the histogram.
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         unsigned int Channels,
+         unsigned int Dimensions,
+         class SampleIterator,
+         class SampleToBinOp>
+ROCPRIM_DEVICE ROCPRIM_INLINE void
+    histogram_nd_tile_bins(unsigned int                           flat_id,
+                           SampleIterator                         samples,
+                           unsigned int                           valid_count,
+                           fixed_array<SampleToBinOp, Dimensions> sample_to_bin_op,
+                           unsigned int (&item_bins)[ItemsPerThread][Dimensions],
+                           bool (&valid)[ItemsPerThread])
+{
+    using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
+
+    sample_vector<sample_type, Channels> values[ItemsPerThread];
+    if(valid_count == BlockSize * ItemsPerThread)
+    {
+        load_samples<BlockSize>(flat_id, samples, values);
+    }
+    else
+    {
+        load_samples<BlockSize>(flat_id, samples, values, valid_count);
+    }
+
+    // The order of pixels of a full tile may differ from the blocked arrangement, which does not
+    // matter for counting.
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        valid[i] = flat_id * ItemsPerThread + i < valid_count;
+        for(unsigned int dim = 0; dim < Dimensions; dim++)
+        {
+            valid[i] = valid[i] && sample_to_bin_op[dim](values[i].values[dim], item_bins[i][dim]);
+        }
+    }
+}
+
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         unsigned int Channels,
+         unsigned int Dimensions,
+         class SampleIterator,
+         class Counter,
+         class SampleToBinOp>
+ROCPRIM_DEVICE ROCPRIM_INLINE void
+    histogram_nd(SampleIterator                         samples,
+                 unsigned int                           size,
+                 Counter*                               histogram,
+                 fixed_array<SampleToBinOp, Dimensions> sample_to_bin_op,
+                 fixed_array<unsigned int, Dimensions>  bins,
+                 unsigned int                           shared_bins,
+                 bool                                   privatize_all,
+                 unsigned int*                          block_histogram,
+                 const histogram_instrumentation&       instrumentation)
+{
+    using box_type          = histogram_nd_box<Dimensions>;
+    using block_reduce_type = ::rocprim::block_reduce<box_type, BlockSize>;
+
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        typename block_reduce_type::storage_type reduce;
+        box_type                                 box;
+    } storage;
+
+    const unsigned int flat_id   = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_id  = ::rocprim::detail::block_id<0>();
+    const unsigned int grid_size = ::rocprim::detail::grid_size<0>();
+
+    unsigned int item_bins[ItemsPerThread][Dimensions];
+    bool         valid[ItemsPerThread];
+
+    histogram_probe probe;
+
+    box_type box;
+    if(privatize_all)
+    {
+        for(unsigned int dim = 0; dim < Dimensions; dim++)
+        {
+            box.lo[dim] = 0;
+            box.hi[dim] = bins[dim] - 1;
+        }
+    }
+    else
+    {
+        // Only one tile per block, its bins are kept in registers
+        const unsigned int block_offset = block_id * items_per_block;
+        histogram_nd_tile_bins<BlockSize, ItemsPerThread, Channels>(
+            flat_id,
+            samples + Channels * block_offset,
+            ::rocprim::min(items_per_block, size - block_offset),
+            sample_to_bin_op,
+            item_bins,
+            valid);
+
+        box_type thread_box;
+        for(unsigned int dim = 0; dim < Dimensions; dim++)
+        {
+            thread_box.lo[dim] = static_cast<unsigned int>(-1);
+            thread_box.hi[dim] = 0;
+            for(unsigned int i = 0; i < ItemsPerThread; i++)
+            {
+                if(valid[i])
+                {
+                    thread_box.lo[dim] = ::rocprim::min(thread_box.lo[dim], item_bins[i][dim]);
+                    thread_box.hi[dim] = ::rocprim::max(thread_box.hi[dim], item_bins[i][dim]);
+                }
+            }
+        }
+        block_reduce_type().reduce(thread_box,
+                                   box,
+                                   storage.reduce,
+                                   histogram_nd_box_union<Dimensions>());
+        if(flat_id == 0)
+        {
+            storage.box = box;
+        }
+        ::rocprim::syncthreads();
+        box = storage.box;
+
+        if(box.lo[0] > box.hi[0])
+        {
+            // No pixel of the tile is in the histogram
+            return;
+        }
+    }
+
+    // Extents and strides of the privatized sub-cube and strides of the histogram
+    unsigned int extent[Dimensions];
+    unsigned int local_stride[Dimensions];
+    size_t       global_stride[Dimensions];
+    size_t       volume = 1;
+    size_t       stride = 1;
+    for(unsigned int dim = Dimensions; dim-- > 0;)
+    {
+        extent[dim]        = box.hi[dim] - box.lo[dim] + 1;
+        local_stride[dim]  = static_cast<unsigned int>(volume);
+        global_stride[dim] = stride;
+        volume *= extent[dim];
+        stride *= bins[dim];
+    }
+
+    if(volume > shared_bins)
+    {
+        // The box is too large for shared memory
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            if(valid[i])
+            {
+                size_t bin = 0;
+                for(unsigned int dim = 0; dim < Dimensions; dim++)
+                {
+                    bin += item_bins[i][dim] * global_stride[dim];
+                }
+                probe.global_atomic(&histogram[bin]);
+                ::rocprim::detail::atomic_add(&histogram[bin], Counter(1));
+            }
+        }
+        instrumentation.record(probe);
+        return;
+    }
+
+    for(unsigned int i = flat_id; i < volume; i += BlockSize)
+    {
+        block_histogram[i] = 0;
+    }
+    ::rocprim::syncthreads();
+
+    auto add_tile = [&]()
+    {
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            if(valid[i])
+            {
+                unsigned int bin = 0;
+                for(unsigned int dim = 0; dim < Dimensions; dim++)
+                {
+                    bin += (item_bins[i][dim] - box.lo[dim]) * local_stride[dim];
+                }
+                probe.shared_atomic(&block_histogram[bin]);
+                ::rocprim::detail::atomic_add(&block_histogram[bin], 1u);
+            }
+        }
+    };
+
+    if(privatize_all)
+    {
+        for(unsigned int block_offset = block_id * items_per_block; block_offset < size;
+            block_offset += grid_size * items_per_block)
+        {
+            histogram_nd_tile_bins<BlockSize, ItemsPerThread, Channels>(
+                flat_id,
+                samples + Channels * block_offset,
+                ::rocprim::min(items_per_block, size - block_offset),
+                sample_to_bin_op,
+                item_bins,
+                valid);
+            add_tile();
+        }
+    }
+    else
+    {
+        add_tile();
+    }
+    ::rocprim::syncthreads();
+
+    for(unsigned int i = flat_id; i < volume; i += BlockSize)
+    {
+        const unsigned int count = block_histogram[i];
+        if(count > 0)
+        {
+            size_t       bin       = 0;
+            unsigned int remainder = i;
+            for(unsigned int dim = Dimensions; dim-- > 0;)
+            {
+                bin += (box.lo[dim] + remainder % extent[dim]) * global_stride[dim];
+                remainder /= extent[dim];
+            }
+            probe.global_atomic(&histogram[bin]);
+            ::rocprim::detail::atomic_add(&histogram[bin], static_cast<Counter>(count));
+        }
+    }
+    instrumentation.record(probe);
 }
 
 } // namespace detail
@@ -0,0 +1,167 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_LOAD_BALANCED_EXPAND_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_LOAD_BALANCED_EXPAND_HPP_
+
+#include <iterator>
+
+#include "../../config.hpp"
+#include "../../detail/merge_path.hpp"
+#include "../../detail/various.hpp"
+#include "../../intrinsics.hpp"
+#include "../../iterator/counting_iterator.hpp"
+
+#include "../device_load_balanced_expand_config.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Load balanced expand (load balanced search).
+//
+// `ends` is the inclusive scan of the counts of the inputs, so input i is expanded into the
+// outputs [ends[i - 1], ends[i]). The outputs are found by merging the sequence of output
+// indices [0, total) with `ends`: an output index k is placed before an end e if k < e, so every
+// output index follows the ends of all the inputs before its own input. The merge path of
+// total + size steps is cut into tiles of equal length, so the work of a block does not depend
+// on the distribution of the counts.
+//
+// The total is only known on the device, so the kernel is launched with a persistent grid and
+// every block processes tiles in a grid-stride loop.
+
+// Compares an end with an output index, for merge_path the outputs are the first sequence.
+template<class OffsetType>
+struct load_balanced_expand_compare
+{
+    ROCPRIM_DEVICE ROCPRIM_INLINE bool operator()(const OffsetType& end, const size_t& output) const
+    {
+        return static_cast<size_t>(end) <= output;
+    }
+};
+
+template<class Config, class InputIterator, class OffsetType, class EmitFunction>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
+    load_balanced_expand_kernel_impl(InputIterator     input,
+                                     const OffsetType* ends,
+                                     const size_t      size,
+                                     EmitFunction      emit_op)
+{
+    static constexpr load_balanced_expand_config_params params = device_params<Config>();
+
+    constexpr unsigned int block_size       = params.kernel_config.block_size;
+    constexpr unsigned int items_per_thread = params.kernel_config.items_per_thread;
+    constexpr unsigned int items_per_tile   = block_size * items_per_thread;
+
+    struct storage_type
+    {
+        size_t output_begin;
+        size_t output_end;
+        // starts[j] is the first output of input input_begin + j
+        OffsetType starts[items_per_tile + 1];
+    };
+    ROCPRIM_SHARED_MEMORY storage_type storage;
+
+    const unsigned int flat_thread_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int flat_block_id  = ::rocprim::detail::block_id<0>();
+    const unsigned int grid_size      = ::rocprim::detail::grid_size<0>();
+
+    const size_t total       = static_cast<size_t>(ends[size - 1]);
+    const size_t path_size   = total + size;
+    const size_t tile_count  = ::rocprim::detail::ceiling_div(path_size, items_per_tile);
+    const auto   outputs     = ::rocprim::counting_iterator<size_t>(0);
+    const auto   compare     = load_balanced_expand_compare<OffsetType>{};
+
+    for(size_t tile = flat_block_id; tile < tile_count; tile += grid_size)
+    {
+        const size_t diag_begin = tile * items_per_tile;
+        const size_t diag_end   = ::rocprim::min(diag_begin + items_per_tile, path_size);
+
+        // Partition the merge path between the blocks
+        if(flat_thread_id == 0)
+        {
+            storage.output_begin = merge_path(outputs, ends, total, size, diag_begin, compare);
+        }
+        if(flat_thread_id == block_size - 1)
+        {
+            storage.output_end = merge_path(outputs, ends, total, size, diag_end, compare);
+        }
+        ::rocprim::syncthreads();
+
+        const size_t       output_begin = storage.output_begin;
+        const size_t       input_begin  = diag_begin - output_begin;
+        const unsigned int output_count = static_cast<unsigned int>(storage.output_end - output_begin);
+        const unsigned int input_count
+            = static_cast<unsigned int>(diag_end - storage.output_end - input_begin);
+        const unsigned int tile_size = output_count + input_count;
+
+        for(unsigned int j = flat_thread_id; j <= input_count; j += block_size)
+        {
+            const size_t input_index = input_begin + j;
+            storage.starts[j]        = input_index == 0 ? OffsetType(0) : ends[input_index - 1];
+        }
+        ::rocprim::syncthreads();
+
+        // Partition the merge path of the tile between the threads, the ends of the inputs
+        // of the tile are starts[1, input_count]
+        const unsigned int diag = ::rocprim::min(flat_thread_id * items_per_thread, tile_size);
+        unsigned int       x    = merge_path(outputs + output_begin,
+                                    storage.starts + 1,
+                                    output_count,
+                                    input_count,
+                                    diag,
+                                    compare);
+        unsigned int       y    = diag - x;
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            if(diag + i >= tile_size)
+            {
+                break;
+            }
+            const size_t output_index = output_begin + x;
+            const bool   take_output
+                = y >= input_count
+                  || (x < output_count && output_index < static_cast<size_t>(storage.starts[y + 1]));
+            if(take_output)
+            {
+                const size_t input_index = input_begin + y;
+                emit_op(input[input_index],
+                        input_index,
+                        static_cast<OffsetType>(output_index - storage.starts[y]),
+                        static_cast<OffsetType>(output_index));
+                x++;
+            }
+            else
+            {
+                y++;
+            }
+        }
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
+    }
+}
+
+} // end of namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_LOAD_BALANCED_EXPAND_HPP_
@@ -859,6 +859,7 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
                           InequalityOp            inequality_op,
                           OffsetLookbackScanState offset_scan_state,
                           const unsigned int      number_of_blocks,
+                          const unsigned int      flat_block_id,
                           UnaryPredicates... predicates)
 {
     constexpr auto block_size = Config::block_size;
@@ -919,7 +920,6 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
     load_selected_count(prev_selected_count, prev_selected_count_values);
 
     const auto         flat_block_thread_id = ::rocprim::detail::block_thread_id<0>();
-    const auto         flat_block_id        = ::rocprim::detail::block_id<0>();
     const auto         block_offset         = flat_block_id * items_per_block;
     const unsigned int valid_in_global_last_block
         = total_size - prev_processed - items_per_block * (number_of_blocks - 1);
@@ -0,0 +1,219 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_QUANTILES_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_QUANTILES_HPP_
+
+#include <iterator>
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+#include "../../intrinsics.hpp"
+
+#include "../../block/block_scan.hpp"
+#include "../../thread/radix_key_codec.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Quantiles are selected by radix select: every pass histograms the next digit of the encoded
+// keys (radix_key_codec) whose higher digits match the prefix selected for a query so far, then
+// the digit containing the rank of the query is appended to its prefix. The first (coarse) pass
+// histograms the highest digit of all keys, the next (refine) passes only the keys in the buckets
+// of the queries.
+//
+// The queries are sorted by rank (a stable radix sort of the ranks), so their prefixes are sorted
+// too: the keys of a bucket are counted in the histogram slot of the first query with that prefix
+// (the lower bound).
+
+constexpr unsigned int quantiles_block_size        = 256;
+constexpr unsigned int quantiles_coarse_digit_bits = 16;
+constexpr unsigned int quantiles_refine_digit_bits = 8;
+
+// The refine passes have (1 << quantiles_refine_digit_bits) histogram bins per query, their
+// number must fit in an unsigned int
+constexpr unsigned int quantiles_max_count = (1u << (32 - quantiles_refine_digit_bits)) - 1;
+
+// Returns index of the first element in values that is not less than value, or count if no such
+// element is found.
+template<class T>
+ROCPRIM_DEVICE ROCPRIM_INLINE unsigned int
+    quantiles_lower_bound(const T* values, unsigned int count, T value)
+{
+    unsigned int current = 0;
+    while(count > 0)
+    {
+        const unsigned int step = count / 2;
+        const unsigned int next = current + step;
+        if(values[next] < value)
+        {
+            current = next + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    return current;
+}
+
+// Rank of the quantile q in [0, 1] of size keys (the lower of the two nearest ranks)
+template<class Quantile>
+ROCPRIM_DEVICE ROCPRIM_INLINE unsigned int quantile_rank(Quantile q, unsigned int size)
+{
+    const double rank = static_cast<double>(q) * (size - 1);
+    if(!(rank > 0.0))
+    {
+        return 0;
+    }
+    return rank >= size - 1 ? size - 1 : static_cast<unsigned int>(rank);
+}
+
+// Maps a key to its digit in the histogram slot of its bucket, or to out_of_range if the key is
+// not in the bucket of any query
+template<class Key, class BitKey>
+struct quantiles_digit_op
+{
+    const BitKey* prefixes;
+    unsigned int  count;
+    unsigned int  shift;
+    unsigned int  digit_bits;
+    unsigned int  out_of_range;
+
+    ROCPRIM_HOST_DEVICE unsigned int operator()(const Key& key) const
+    {
+        const BitKey       bit_key    = ::rocprim::radix_key_codec<Key>::encode(key);
+        const unsigned int high_shift = shift + digit_bits;
+        const BitKey       high       = high_shift >= sizeof(BitKey) * 8
+                                            ? BitKey(0)
+                                            : static_cast<BitKey>(bit_key >> high_shift);
+
+        const unsigned int slot = quantiles_lower_bound(prefixes, count, high);
+        if(slot == count || prefixes[slot] != high)
+        {
+            return out_of_range;
+        }
+        const unsigned int digit
+            = static_cast<unsigned int>(bit_key >> shift) & ((1u << digit_bits) - 1);
+        return (slot << digit_bits) + digit;
+    }
+};
+
+// Stores the index and the rank of every query, they are sorted by rank afterwards
+template<class QuantilesIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE void quantiles_init(QuantilesIterator quantiles,
+                                                  unsigned int      count,
+                                                  unsigned int      size,
+                                                  unsigned int*     query_indices,
+                                                  unsigned int*     ranks)
+{
+    const unsigned int index = ::rocprim::detail::block_id<0>() * quantiles_block_size
+                               + ::rocprim::detail::block_thread_id<0>();
+    if(index >= count)
+    {
+        return;
+    }
+
+    query_indices[index] = index;
+    ranks[index]         = quantile_rank(quantiles[index], size);
+}
+
+// One block per query: scans the histogram slot of its bucket and appends the digit containing
+// the rank of the query to its prefix.
+template<unsigned int BlockSize, class BitKey>
+ROCPRIM_DEVICE ROCPRIM_INLINE void quantiles_select(const unsigned int* histogram,
+                                                    unsigned int        digit_bits,
+                                                    unsigned int        count,
+                                                    unsigned int*       ranks,
+                                                    const BitKey*       prefixes_input,
+                                                    BitKey*             prefixes_output)
+{
+    using block_scan_type = ::rocprim::block_scan<unsigned int, BlockSize>;
+
+    ROCPRIM_SHARED_MEMORY typename block_scan_type::storage_type storage;
+
+    const unsigned int flat_id  = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int position = ::rocprim::detail::block_id<0>();
+
+    const BitKey       prefix = prefixes_input[position];
+    const unsigned int slot   = quantiles_lower_bound(prefixes_input, count, prefix);
+    const unsigned int rank   = ranks[position];
+    const unsigned int digits = 1u << digit_bits;
+
+    histogram += static_cast<size_t>(slot) << digit_bits;
+
+    unsigned int carry = 0;
+    for(unsigned int offset = 0; offset < digits; offset += BlockSize)
+    {
+        const unsigned int digit = offset + flat_id;
+        const unsigned int value = digit < digits ? histogram[digit] : 0;
+
+        unsigned int inclusive;
+        unsigned int reduction;
+        block_scan_type().inclusive_scan(value, inclusive, reduction, storage);
+        inclusive += carry;
+
+        // Exactly one digit contains the rank
+        const unsigned int exclusive = inclusive - value;
+        if(exclusive <= rank && rank < inclusive)
+        {
+            ranks[position]           = rank - exclusive;
+            prefixes_output[position] = static_cast<BitKey>((prefix << digit_bits) | digit);
+        }
+
+        carry += reduction;
+        if(carry > rank)
+        {
+            break;
+        }
+        ::rocprim::syncthreads();
+    }
+}
+
+template<class Key, class BitKey, class KeysOutputIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE void quantiles_output(const unsigned int* query_indices,
+                                                    const BitKey*       prefixes,
+                                                    unsigned int        count,
+                                                    unsigned int        shift,
+                                                    KeysOutputIterator  keys_output)
+{
+    const unsigned int position = ::rocprim::detail::block_id<0>() * quantiles_block_size
+                                  + ::rocprim::detail::block_thread_id<0>();
+    if(position >= count)
+    {
+        return;
+    }
+
+    // The remaining low bits of an approximate quantile are 0: it is the smallest key of its bucket
+    const BitKey bit_key = shift >= sizeof(BitKey) * 8
+                               ? BitKey(0)
+                               : static_cast<BitKey>(prefixes[position] << shift);
+    keys_output[query_indices[position]] = ::rocprim::radix_key_codec<Key>::decode(bit_key);
+}
+
+} // namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_QUANTILES_HPP_
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -163,6 +163,97 @@ void block_reduce_kernel_impl(InputIterator input,
             );
     }
 }
+
+// Reduces the tiles flat_block_id, flat_block_id + grid size, ... of a persistent grid. The tiles
+// of a block are fixed, so the result does not depend on the scheduling of the blocks.
+// The grid must not have more blocks than tiles.
+template<class Config,
+         class ResultType,
+         class InputIterator,
+         class OutputIterator,
+         class BinaryFunction>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
+void persistent_block_reduce_kernel_impl(InputIterator  input,
+                                         const size_t   input_size,
+                                         OutputIterator output,
+                                         BinaryFunction reduce_op)
+{
+    static constexpr reduce_config_params params = device_params<Config>();
+
+    constexpr unsigned int block_size       = params.reduce_config.block_size;
+    constexpr unsigned int items_per_thread = params.reduce_config.items_per_thread;
+    constexpr unsigned int items_per_block  = block_size * items_per_thread;
+
+    using result_type = ResultType;
+
+    using block_reduce_type
+        = ::rocprim::block_reduce<result_type, block_size, params.block_reduce_method>;
+
+    const unsigned int flat_id              = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int flat_block_id        = ::rocprim::detail::block_id<0>();
+    const unsigned int grid_size            = ::rocprim::detail::grid_size<0>();
+    const size_t       number_of_full_tiles = input_size / items_per_block;
+    const size_t number_of_tiles = ::rocprim::detail::ceiling_div(input_size, items_per_block);
+
+    result_type values[items_per_thread];
+    result_type thread_value;
+    // Number of threads that have a value
+    unsigned int valid_threads = 0;
+
+    size_t tile_id = flat_block_id;
+    for(; tile_id < number_of_full_tiles; tile_id += grid_size)
+    {
+        block_load_direct_striped<block_size>(flat_id, input + tile_id * items_per_block, values);
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            thread_value = i == 0 && valid_threads == 0 ? values[0]
+                                                        : reduce_op(thread_value, values[i]);
+        }
+        valid_threads = block_size;
+    }
+
+    // The last incomplete tile
+    if(tile_id < number_of_tiles)
+    {
+        const size_t       block_offset        = tile_id * items_per_block;
+        const unsigned int valid_in_last_block = input_size - block_offset;
+        block_load_direct_striped<block_size>(flat_id,
+                                              input + block_offset,
+                                              values,
+                                              valid_in_last_block);
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            if(flat_id + i * block_size < valid_in_last_block)
+            {
+                thread_value = i == 0 && valid_threads == 0 ? values[0]
+                                                            : reduce_op(thread_value, values[i]);
+            }
+        }
+        if(valid_threads == 0)
+        {
+            valid_threads = std::min(valid_in_last_block, block_size);
+        }
+    }
+
+    if(valid_threads == block_size)
+    {
+        block_reduce_type().reduce(thread_value, thread_value, reduce_op);
+    }
+    else
+    {
+        block_reduce_type().reduce(thread_value, thread_value, valid_threads, reduce_op);
+    }
+
+    if(flat_id == 0)
+    {
+        output[flat_block_id] = thread_value;
+    }
+}
+
 } // end of detail namespace
 
 END_ROCPRIM_NAMESPACE
@@ -0,0 +1,214 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_RUN_LENGTH_DECODE_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_RUN_LENGTH_DECODE_HPP_
+
+#include <iterator>
+
+#include "../../config.hpp"
+#include "../../detail/merge_path.hpp"
+#include "../../detail/various.hpp"
+#include "../../intrinsics.hpp"
+#include "../../iterator/counting_iterator.hpp"
+
+#include "../../block/block_run_length_decode.hpp"
+#include "../../block/block_store.hpp"
+
+#include "../device_run_length_decode_config.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Device-wide run length decode.
+//
+// `ends` is the inclusive scan of the run lengths, so run i is decoded into the outputs
+// [ends[i - 1], ends[i]). As in load balanced expand, the merge path of the output indices and
+// `ends` is cut into tiles of equal length, so a tile holds at most items_per_tile outputs and
+// runs, whatever the lengths of the runs are (including runs of length 0). Every tile is
+// decoded with block_run_length_decode and stored with a block store.
+//
+// The number of outputs is only known on the device, so the kernel is launched with
+// a persistent grid and every block processes tiles in a grid-stride loop.
+
+// Compares an end with an output index, for merge_path the outputs are the first sequence.
+template<class OffsetType>
+struct run_length_decode_compare
+{
+    ROCPRIM_DEVICE ROCPRIM_INLINE bool operator()(const OffsetType& end, const size_t& output) const
+    {
+        return static_cast<size_t>(end) <= output;
+    }
+};
+
+template<bool WithRelativeOffsets,
+         class Config,
+         class ValuesInputIterator,
+         class OffsetType,
+         class OutputIterator,
+         class RelativeOffsetsOutputIterator>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
+    run_length_decode_kernel_impl(ValuesInputIterator           values,
+                                  const OffsetType*             ends,
+                                  const size_t                  num_runs,
+                                  OutputIterator                output,
+                                  RelativeOffsetsOutputIterator relative_offsets)
+{
+    static constexpr run_length_decode_config_params params = device_params<Config>();
+
+    constexpr unsigned int block_size       = params.kernel_config.block_size;
+    constexpr unsigned int items_per_thread = params.kernel_config.items_per_thread;
+    constexpr unsigned int items_per_tile   = block_size * items_per_thread;
+    // A tile with at least one output touches at most items_per_tile runs, the additional
+    // runs are padding, so the block decoder never reads past its runs.
+    constexpr unsigned int runs_per_thread = items_per_thread + 1;
+
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    using block_decode_type
+        = ::rocprim::block_run_length_decode<value_type, block_size, runs_per_thread, items_per_thread>;
+    using block_store_values_type = ::rocprim::
+        block_store<value_type, block_size, items_per_thread, block_store_method::block_store_transpose>;
+    using block_store_offsets_type = ::rocprim::
+        block_store<OffsetType, block_size, items_per_thread, block_store_method::block_store_transpose>;
+
+    struct storage_type
+    {
+        size_t output_begin;
+        size_t output_end;
+        // Start of the run of the first output of the tile
+        size_t first_run_start;
+        union
+        {
+            typename block_decode_type::storage_type        decode;
+            typename block_store_values_type::storage_type  store_values;
+            typename block_store_offsets_type::storage_type store_offsets;
+        } blocks;
+    };
+    ROCPRIM_SHARED_MEMORY storage_type storage;
+
+    const unsigned int flat_thread_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int flat_block_id  = ::rocprim::detail::block_id<0>();
+    const unsigned int grid_size      = ::rocprim::detail::grid_size<0>();
+
+    const size_t total      = static_cast<size_t>(ends[num_runs - 1]);
+    const size_t path_size  = total + num_runs;
+    const size_t tile_count = ::rocprim::detail::ceiling_div(path_size, items_per_tile);
+    const auto   outputs    = ::rocprim::counting_iterator<size_t>(0);
+    const auto   compare    = run_length_decode_compare<OffsetType>{};
+
+    for(size_t tile = flat_block_id; tile < tile_count; tile += grid_size)
+    {
+        const size_t diag_begin = tile * items_per_tile;
+        const size_t diag_end   = ::rocprim::min(diag_begin + items_per_tile, path_size);
+
+        // Partition the merge path between the blocks
+        if(flat_thread_id == 0)
+        {
+            storage.output_begin = merge_path(outputs, ends, total, num_runs, diag_begin, compare);
+        }
+        if(flat_thread_id == block_size - 1)
+        {
+            storage.output_end = merge_path(outputs, ends, total, num_runs, diag_end, compare);
+        }
+        ::rocprim::syncthreads();
+
+        const size_t       output_begin = storage.output_begin;
+        const size_t       run_begin    = diag_begin - output_begin;
+        const unsigned int output_count = static_cast<unsigned int>(storage.output_end - output_begin);
+
+        // The runs whose end is in the tile and the run of the last output
+        const unsigned int run_count = static_cast<unsigned int>(
+            ::rocprim::min(diag_end - storage.output_end - run_begin + 1, num_runs - run_begin));
+
+        // A tile may only contain the ends of runs of length 0
+        if(output_count > 0)
+        {
+            value_type   run_values[runs_per_thread];
+            unsigned int run_offsets[runs_per_thread];
+
+            ROCPRIM_UNROLL
+            for(unsigned int i = 0; i < runs_per_thread; i++)
+            {
+                const unsigned int j = flat_thread_id * runs_per_thread + i;
+                if(j < run_count)
+                {
+                    const size_t run   = run_begin + j;
+                    const size_t start = run == 0 ? 0 : static_cast<size_t>(ends[run - 1]);
+                    run_values[i]      = values[run];
+                    // The runs that start before the tile start with its first output
+                    run_offsets[i]
+                        = static_cast<unsigned int>(::rocprim::max(start, output_begin) - output_begin);
+                    if(WithRelativeOffsets && start <= output_begin
+                       && output_begin < static_cast<size_t>(ends[run]))
+                    {
+                        storage.first_run_start = start;
+                    }
+                }
+                else
+                {
+                    run_offsets[i] = output_count;
+                }
+            }
+
+            value_type   decoded_items[items_per_thread];
+            unsigned int decoded_offsets[items_per_thread];
+
+            block_decode_type block_decode(storage.blocks.decode, run_values, run_offsets);
+            block_decode.run_length_decode(decoded_items, decoded_offsets);
+            ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+            block_store_values_type().store(output + output_begin,
+                                            decoded_items,
+                                            output_count,
+                                            storage.blocks.store_values);
+
+            if(WithRelativeOffsets)
+            {
+                // The offsets of the run that started before the tile are corrected
+                const size_t first_run_offset = output_begin - storage.first_run_start;
+
+                OffsetType item_offsets[items_per_thread];
+                ROCPRIM_UNROLL
+                for(unsigned int i = 0; i < items_per_thread; i++)
+                {
+                    const unsigned int item = flat_thread_id * items_per_thread + i;
+                    item_offsets[i]         = static_cast<OffsetType>(
+                        decoded_offsets[i] + (decoded_offsets[i] == item ? first_run_offset : 0));
+                }
+                ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+                block_store_offsets_type().store(relative_offsets + output_begin,
+                                                 item_offsets,
+                                                 output_count,
+                                                 storage.blocks.store_offsets);
+            }
+        }
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
+    }
+}
+
+} // end of namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_RUN_LENGTH_DECODE_HPP_
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -103,6 +103,7 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
                               BinaryFunction     scan_op,
                               LookbackScanState  scan_state,
                               const unsigned int number_of_blocks,
+                              const unsigned int flat_block_id,
                               AccType*           previous_last_element = nullptr,
                               AccType*           new_last_element      = nullptr,
                               bool               override_first_value  = false,
@@ -133,7 +134,6 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
     } storage;
 
     const auto         flat_block_thread_id = ::rocprim::detail::block_thread_id<0>();
-    const auto         flat_block_id        = ::rocprim::detail::block_id<0>();
     const unsigned int block_offset         = flat_block_id * items_per_block;
     const auto         valid_in_last_block  = size - items_per_block * (number_of_blocks - 1);
 
@@ -155,15 +155,31 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
     }
     ::rocprim::syncthreads(); // sync threads to reuse shared memory
 
+    // The last input value is needed to compute the inclusive total of an exclusive scan.
+    const bool saves_last_value
+        = save_last_value && flat_block_id == (number_of_blocks - 1)
+          && flat_block_thread_id == (valid_in_last_block - 1) / items_per_thread;
+    const unsigned int last_item = (valid_in_last_block - 1) % items_per_thread;
+    AccType            last_input;
+    if(Exclusive && saves_last_value)
+    {
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            if(i == last_item)
+            {
+                last_input = values[i];
+            }
+        }
+    }
+
     if(flat_block_id == 0)
     {
-        // override_first_value only true when the first chunk already processed
-        // and input iterator starts from an offset.
+        // override_first_value only true when a previous chunk was already processed,
+        // previous_last_element holds its inclusive total.
         if(override_first_value)
         {
             if(Exclusive)
-                initial_value
-                    = scan_op(previous_last_element[0], static_cast<AccType>(*(input - 1)));
+                initial_value = previous_last_element[0];
             else if(flat_block_thread_id == 0)
                 values[0] = scan_op(previous_last_element[0], values[0]);
         }
@@ -196,15 +212,14 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
     {
         block_store_type().store(output + block_offset, values, valid_in_last_block, storage.store);
 
-        if(save_last_value
-           && (::rocprim::detail::block_thread_id<0>()
-               == (valid_in_last_block - 1) / items_per_thread))
+        // Save the inclusive total of this chunk
+        if(saves_last_value)
         {
             for(unsigned int i = 0; i < items_per_thread; i++)
             {
-                if(i == (valid_in_last_block - 1) % items_per_thread)
+                if(i == last_item)
                 {
-                    new_last_element[0] = values[i];
+                    new_last_element[0] = Exclusive ? scan_op(values[i], last_input) : values[i];
                 }
             }
         }
@@ -263,7 +263,13 @@ namespace detail
         const size_t                                  size,
         const size_t                                  starting_block,
         const size_t                                  number_of_blocks,
-        const rocprim::tuple<ResultType, bool>* const previous_last_value)
+        const rocprim::tuple<ResultType, bool>* const previous_last_value,
+        const ResultType* const                       carry_value_in  = nullptr,
+        const typename std::iterator_traits<KeyInputIterator>::value_type* const pending_key_in
+        = nullptr,
+        ResultType* const                                           carry_value_out = nullptr,
+        typename std::iterator_traits<KeyInputIterator>::value_type* const pending_key_out
+        = nullptr)
     {
         using result_type = ResultType;
         static_assert(std::is_same<rocprim::tuple<ResultType, bool>,
@@ -336,6 +342,17 @@ namespace detail
                     wrapped_values[0] = wrapped_op(*previous_last_value, wrapped_values[0]);
                 }
             }
+            // carry_value_in is the value of the segment of pending_key_in left by a previous
+            // call, it is only continued if the first key belongs to the same segment
+            else if(carry_value_in != nullptr && compare(keys[0], *pending_key_in))
+            {
+                if(Exclusive) {
+                    rocprim::get<0>(wrapped_initial_value) = *carry_value_in;
+                } else if (flat_thread_id == 0) {
+                    wrapped_values[0]
+                        = wrapped_op(rocprim::make_tuple(*carry_value_in, false), wrapped_values[0]);
+                }
+            }
 
             wrapped_type reduction;
             lookback_block_scan<Exclusive, block_scan_type>(wrapped_values,
@@ -364,6 +381,33 @@ namespace detail
                 wrapped_op);
         }
 
+        // Save the value of the last segment and its key for the next call
+        if(carry_value_out != nullptr && starting_block + flat_block_id == number_of_blocks - 1)
+        {
+            constexpr unsigned int items_per_block = block_size * items_per_thread;
+            const unsigned int     valid_in_last_block
+                = static_cast<unsigned int>(size - items_per_block * (number_of_blocks - 1));
+            const unsigned int last_item = (valid_in_last_block - 1) % items_per_thread;
+            if(flat_thread_id == (valid_in_last_block - 1) / items_per_thread)
+            {
+                const unsigned int last_index
+                    = flat_block_id * items_per_block + valid_in_last_block - 1;
+                for(unsigned int i = 0; i < items_per_thread; i++)
+                {
+                    if(i == last_item)
+                    {
+                        const result_type last_value = rocprim::get<0>(wrapped_values[i]);
+                        // The exclusive scan did not add the last value yet
+                        *carry_value_out
+                            = Exclusive
+                                  ? scan_op(last_value, static_cast<result_type>(values[last_index]))
+                                  : last_value;
+                        *pending_key_out = keys[last_index];
+                    }
+                }
+            }
+        }
+
         // Store output
         // synchronization is inside the function after unwrapping
         store_unwrap {}.store(output,
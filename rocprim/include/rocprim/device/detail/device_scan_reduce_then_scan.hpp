@@ -0,0 +1,309 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_SCAN_REDUCE_THEN_SCAN_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_SCAN_REDUCE_THEN_SCAN_HPP_
+
+#include <type_traits>
+
+#include "../../detail/various.hpp"
+#include "../../functional.hpp"
+#include "../../intrinsics.hpp"
+#include "../../types.hpp"
+
+#include "../../block/block_load.hpp"
+#include "../../block/block_scan.hpp"
+#include "../../block/block_store.hpp"
+
+#include "../../device/device_scan_config.hpp"
+
+#include "device_scan_common.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Reduce-then-scan device scan.
+//
+// The input is scanned with three kernels per launch:
+// 1. reduce_then_scan_reduce_kernel computes the reduction of every full tile except the last
+//    one and stores the reduction of tile b in block_prefixes[b + 1].
+// 2. reduce_then_scan_spine_kernel (a single block) scans block_prefixes[1, number_of_blocks)
+//    in place and stores the start prefix (if there is one) in block_prefixes[0]. After this
+//    block_prefixes[b] holds the exclusive prefix of tile b.
+// 3. reduce_then_scan_downsweep_kernel scans every tile seeded with its prefix.
+//
+// Contrary to the look-back scan no block ever waits for another block, at the cost of reading
+// the input twice. `carry` holds the inclusive total of the previously processed launches, when
+// the input is processed with multiple launches.
+
+template<class Config,
+         class InputIterator,
+         class BinaryFunction,
+         class AccType>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
+    reduce_then_scan_reduce_kernel_impl(InputIterator  input,
+                                        BinaryFunction scan_op,
+                                        AccType*       block_prefixes)
+{
+    static constexpr scan_config_params params = device_params<Config>();
+
+    constexpr unsigned int block_size       = params.kernel_config.block_size;
+    constexpr unsigned int items_per_thread = params.kernel_config.items_per_thread;
+    constexpr unsigned int items_per_block  = block_size * items_per_thread;
+
+    using block_load_type
+        = ::rocprim::block_load<AccType, block_size, items_per_thread, params.block_load_method>;
+    using block_scan_type = ::rocprim::block_scan<AccType, block_size, params.block_scan_method>;
+
+    ROCPRIM_SHARED_MEMORY union
+    {
+        typename block_load_type::storage_type load;
+        typename block_scan_type::storage_type scan;
+    } storage;
+
+    const auto         flat_block_thread_id = ::rocprim::detail::block_thread_id<0>();
+    const auto         flat_block_id        = ::rocprim::detail::block_id<0>();
+    const unsigned int block_offset         = flat_block_id * items_per_block;
+
+    // Only full tiles are reduced, the reduction of the last tile is never needed.
+    AccType values[items_per_thread];
+    block_load_type().load(input + block_offset, values, storage.load);
+    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+    // The thread reduction is done in order and the block reduction is obtained from a block
+    // scan, so the scan operator does not need to be commutative.
+    AccType thread_reduction = values[0];
+    ROCPRIM_UNROLL
+    for(unsigned int i = 1; i < items_per_thread; i++)
+    {
+        thread_reduction = scan_op(thread_reduction, values[i]);
+    }
+
+    AccType block_reduction;
+    block_scan_type().inclusive_scan(thread_reduction,
+                                     thread_reduction,
+                                     block_reduction,
+                                     storage.scan,
+                                     scan_op);
+
+    if(flat_block_thread_id == 0)
+    {
+        block_prefixes[flat_block_id + 1] = block_reduction;
+    }
+}
+
+template<bool Exclusive, class Config, class BinaryFunction, class AccType>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
+    reduce_then_scan_spine_kernel_impl(AccType*           block_prefixes,
+                                       const unsigned int number_of_blocks,
+                                       AccType            initial_value,
+                                       BinaryFunction     scan_op,
+                                       const AccType*     carry,
+                                       const bool         use_carry)
+{
+    static constexpr scan_config_params params = device_params<Config>();
+
+    constexpr unsigned int block_size       = params.kernel_config.block_size;
+    constexpr unsigned int items_per_thread = params.kernel_config.items_per_thread;
+    constexpr unsigned int items_per_block  = block_size * items_per_thread;
+
+    using block_load_type
+        = ::rocprim::block_load<AccType, block_size, items_per_thread, params.block_load_method>;
+    using block_store_type
+        = ::rocprim::block_store<AccType, block_size, items_per_thread, params.block_store_method>;
+    using block_scan_type = ::rocprim::block_scan<AccType, block_size, params.block_scan_method>;
+
+    ROCPRIM_SHARED_MEMORY union
+    {
+        typename block_load_type::storage_type  load;
+        typename block_store_type::storage_type store;
+        typename block_scan_type::storage_type  scan;
+    } storage;
+
+    // The prefix of the first tile: the total of the previous launches, or the initial value
+    // of an exclusive scan. An inclusive scan of the first launch has no prefix.
+    bool    has_prefix = use_carry || Exclusive;
+    AccType prefix     = use_carry ? carry[0] : initial_value;
+    if(has_prefix && ::rocprim::detail::block_thread_id<0>() == 0)
+    {
+        block_prefixes[0] = prefix;
+    }
+
+    for(unsigned int offset = 1; offset < number_of_blocks; offset += items_per_block)
+    {
+        const unsigned int valid = ::rocprim::min(items_per_block, number_of_blocks - offset);
+
+        AccType values[items_per_thread];
+        block_load_type().load(block_prefixes + offset, values, valid, storage.load);
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+        // Items past `valid` are not initialized, but they only affect the results
+        // of items that are not stored and the reduction of the last tile.
+        AccType reduction;
+        block_scan_type().inclusive_scan(values, values, reduction, storage.scan, scan_op);
+        if(has_prefix)
+        {
+            ROCPRIM_UNROLL
+            for(unsigned int i = 0; i < items_per_thread; i++)
+            {
+                values[i] = scan_op(prefix, values[i]);
+            }
+            prefix = scan_op(prefix, reduction);
+        }
+        else
+        {
+            prefix     = reduction;
+            has_prefix = true;
+        }
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+        block_store_type().store(block_prefixes + offset, values, valid, storage.store);
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
+    }
+}
+
+template<bool Exclusive,
+         class Config,
+         class InputIterator,
+         class OutputIterator,
+         class BinaryFunction,
+         class AccType>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
+    reduce_then_scan_downsweep_kernel_impl(InputIterator      input,
+                                           OutputIterator     output,
+                                           const size_t       size,
+                                           AccType            initial_value,
+                                           BinaryFunction     scan_op,
+                                           const AccType*     block_prefixes,
+                                           const unsigned int number_of_blocks,
+                                           const bool         use_carry,
+                                           AccType*           carry,
+                                           const bool         save_carry)
+{
+    static constexpr scan_config_params params = device_params<Config>();
+
+    constexpr unsigned int block_size       = params.kernel_config.block_size;
+    constexpr unsigned int items_per_thread = params.kernel_config.items_per_thread;
+    constexpr unsigned int items_per_block  = block_size * items_per_thread;
+
+    using block_load_type
+        = ::rocprim::block_load<AccType, block_size, items_per_thread, params.block_load_method>;
+    using block_store_type
+        = ::rocprim::block_store<AccType, block_size, items_per_thread, params.block_store_method>;
+    using block_scan_type = ::rocprim::block_scan<AccType, block_size, params.block_scan_method>;
+
+    ROCPRIM_SHARED_MEMORY union
+    {
+        typename block_load_type::storage_type  load;
+        typename block_store_type::storage_type store;
+        typename block_scan_type::storage_type  scan;
+    } storage;
+
+    const auto         flat_block_thread_id = ::rocprim::detail::block_thread_id<0>();
+    const auto         flat_block_id        = ::rocprim::detail::block_id<0>();
+    const unsigned int block_offset         = flat_block_id * items_per_block;
+    const auto         valid_in_last_block  = size - items_per_block * (number_of_blocks - 1);
+    const bool         is_last_block        = flat_block_id == (number_of_blocks - 1);
+
+    // For input values
+    AccType values[items_per_thread];
+
+    // load input values into values
+    if(is_last_block)
+    {
+        block_load_type().load(input + block_offset,
+                               values,
+                               valid_in_last_block,
+                               *(input + block_offset),
+                               storage.load);
+    }
+    else
+    {
+        block_load_type().load(input + block_offset, values, storage.load);
+    }
+    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+    // The last input value is needed to compute the inclusive total of an exclusive scan.
+    const bool saves_carry
+        = save_carry && is_last_block
+          && flat_block_thread_id == (valid_in_last_block - 1) / items_per_thread;
+    const unsigned int last_item = (valid_in_last_block - 1) % items_per_thread;
+    AccType            last_input;
+    if(Exclusive && saves_carry)
+    {
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            if(i == last_item)
+            {
+                last_input = values[i];
+            }
+        }
+    }
+
+    if(flat_block_id > 0 || use_carry || Exclusive)
+    {
+        const AccType block_prefix = block_prefixes[flat_block_id];
+        auto          prefix_op    = [block_prefix](const AccType& /*reduction*/)
+        { return block_prefix; };
+        lookback_block_scan<Exclusive, block_scan_type>(values, // input/output
+                                                        storage.scan,
+                                                        prefix_op,
+                                                        scan_op);
+    }
+    else
+    {
+        AccType reduction;
+        lookback_block_scan<Exclusive, block_scan_type>(values, // input/output
+                                                        initial_value,
+                                                        reduction,
+                                                        storage.scan,
+                                                        scan_op);
+    }
+    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+    // Save values into output array
+    if(is_last_block)
+    {
+        block_store_type().store(output + block_offset, values, valid_in_last_block, storage.store);
+
+        if(saves_carry)
+        {
+            for(unsigned int i = 0; i < items_per_thread; i++)
+            {
+                if(i == last_item)
+                {
+                    carry[0] = Exclusive ? scan_op(values[i], last_input) : values[i];
+                }
+            }
+        }
+    }
+    else
+    {
+        block_store_type().store(output + block_offset, values, storage.store);
+    }
+}
+
+} // end of namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_SCAN_REDUCE_THEN_SCAN_HPP_
@@ -0,0 +1,570 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_SEGMENTED_MERGE_SORT_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_SEGMENTED_MERGE_SORT_HPP_
+
+#include <iterator>
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../detail/merge_path.hpp"
+#include "../../detail/various.hpp"
+
+#include "../../functional.hpp"
+#include "../../intrinsics.hpp"
+#include "../../types.hpp"
+#include "../../types/tuple.hpp"
+
+#include "../../warp/warp_load.hpp"
+#include "../../warp/warp_sort.hpp"
+#include "../../warp/warp_store.hpp"
+
+#include "../device_segmented_merge_sort_config.hpp"
+#include "device_merge_sort.hpp"
+#include "device_merge_sort_mergepath.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// The offsets of a large segment, read back by the host to sort it with the device-wide merge sort
+struct segmented_merge_sort_range
+{
+    unsigned int begin_offset;
+    unsigned int end_offset;
+};
+
+// Sorts a segment of at most LogicalWarpSize * ItemsPerThread items with a logical warp.
+template<unsigned int LogicalWarpSize, unsigned int ItemsPerThread, class Key, class Value>
+class segmented_merge_sort_warp_helper
+{
+    using key_type   = Key;
+    using value_type = Value;
+
+    // The position of an item in the segment makes the sort stable and keeps the
+    // out-of-bounds items after the valid ones, without a padding key.
+    using stable_key_type = ::rocprim::tuple<key_type, unsigned int>;
+
+    using keys_load_type   = ::rocprim::warp_load<key_type,
+                                                ItemsPerThread,
+                                                LogicalWarpSize,
+                                                ::rocprim::warp_load_method::warp_load_striped>;
+    using values_load_type = ::rocprim::warp_load<value_type,
+                                                  ItemsPerThread,
+                                                  LogicalWarpSize,
+                                                  ::rocprim::warp_load_method::warp_load_striped>;
+    using keys_store_type   = ::rocprim::warp_store<key_type, ItemsPerThread, LogicalWarpSize>;
+    using values_store_type = ::rocprim::warp_store<value_type, ItemsPerThread, LogicalWarpSize>;
+    using sort_type         = ::rocprim::warp_sort<stable_key_type, LogicalWarpSize, value_type>;
+
+    static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    template<class BinaryFunction>
+    struct stable_compare
+    {
+        BinaryFunction compare_function;
+        unsigned int   num_items;
+
+        ROCPRIM_DEVICE ROCPRIM_INLINE bool operator()(const stable_key_type& a,
+                                                      const stable_key_type& b) const
+        {
+            const unsigned int a_position = ::rocprim::get<1>(a);
+            const unsigned int b_position = ::rocprim::get<1>(b);
+            if(a_position >= num_items || b_position >= num_items)
+            {
+                return a_position < b_position;
+            }
+            return compare_function(::rocprim::get<0>(a), ::rocprim::get<0>(b))
+                   || (!compare_function(::rocprim::get<0>(b), ::rocprim::get<0>(a))
+                       && a_position < b_position);
+        }
+    };
+
+public:
+    static constexpr unsigned int items_per_warp = LogicalWarpSize * ItemsPerThread;
+
+    union storage_type
+    {
+        typename keys_load_type::storage_type    keys_load;
+        typename values_load_type::storage_type  values_load;
+        typename keys_store_type::storage_type   keys_store;
+        typename values_store_type::storage_type values_store;
+        typename sort_type::storage_type         sort;
+    };
+
+    template<class KeysInputIterator,
+             class KeysOutputIterator,
+             class ValuesInputIterator,
+             class ValuesOutputIterator,
+             class BinaryFunction>
+    ROCPRIM_DEVICE ROCPRIM_INLINE void sort(KeysInputIterator    keys_input,
+                                            KeysOutputIterator   keys_output,
+                                            ValuesInputIterator  values_input,
+                                            ValuesOutputIterator values_output,
+                                            const unsigned int   begin_offset,
+                                            const unsigned int   end_offset,
+                                            BinaryFunction       compare_function,
+                                            storage_type&        storage)
+    {
+        const unsigned int num_items = end_offset - begin_offset;
+        const unsigned int lane      = ::rocprim::detail::logical_lane_id<LogicalWarpSize>();
+
+        key_type   keys[ItemsPerThread];
+        value_type values[ItemsPerThread];
+        keys_load_type().load(keys_input + begin_offset, keys, num_items, storage.keys_load);
+        if ROCPRIM_IF_CONSTEXPR(with_values)
+        {
+            ::rocprim::wave_barrier();
+            values_load_type().load(values_input + begin_offset,
+                                    values,
+                                    num_items,
+                                    storage.values_load);
+        }
+
+        // The keys are loaded warp-striped
+        stable_key_type stable_keys[ItemsPerThread];
+        ROCPRIM_UNROLL
+        for(unsigned int item = 0; item < ItemsPerThread; item++)
+        {
+            stable_keys[item] = stable_key_type(keys[item], item * LogicalWarpSize + lane);
+        }
+
+        const stable_compare<BinaryFunction> comparator{compare_function, num_items};
+        ::rocprim::wave_barrier();
+        if ROCPRIM_IF_CONSTEXPR(with_values)
+        {
+            sort_type().sort(stable_keys, values, storage.sort, comparator);
+        }
+        else
+        {
+            sort_type().sort(stable_keys, storage.sort, comparator);
+        }
+
+        ROCPRIM_UNROLL
+        for(unsigned int item = 0; item < ItemsPerThread; item++)
+        {
+            keys[item] = ::rocprim::get<0>(stable_keys[item]);
+        }
+
+        ::rocprim::wave_barrier();
+        keys_store_type().store(keys_output + begin_offset, keys, num_items, storage.keys_store);
+        if ROCPRIM_IF_CONSTEXPR(with_values)
+        {
+            ::rocprim::wave_barrier();
+            values_store_type().store(values_output + begin_offset,
+                                      values,
+                                      num_items,
+                                      storage.values_store);
+        }
+    }
+};
+
+// Sorts a segment with a block: a segment of at most BlockSize * ItemsPerThread items with
+// a single stable block sort, a longer one by sorting its tiles and merging pairs of sorted
+// runs of doubling length with merge path, alternating between the output and temporary buffers.
+template<unsigned int BlockSize, unsigned int ItemsPerThread, class Key, class Value>
+class segmented_merge_sort_block_helper
+{
+    using key_type   = Key;
+    using value_type = Value;
+
+    static constexpr unsigned int items_per_tile = BlockSize * ItemsPerThread;
+    static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    using block_sort_type  = block_sort_impl<key_type, value_type, BlockSize, ItemsPerThread>;
+    using block_store_type
+        = block_store_impl<with_values, BlockSize, ItemsPerThread, key_type, value_type>;
+
+    // serial_merge reads one item past the end of its range
+    using keys_storage_   = key_type[items_per_tile + 1];
+    using values_storage_ = value_type[items_per_tile + 1];
+
+    struct merge_storage_type
+    {
+        unsigned int partitions[2];
+        union
+        {
+            typename block_store_type::storage_type store;
+            detail::raw_storage<keys_storage_>      keys;
+            detail::raw_storage<values_storage_>    values;
+        };
+    };
+
+    // Merges the sorted runs of sorted_size items of [0, size) from the input into the output.
+    template<class KeysInputIterator,
+             class KeysOutputIterator,
+             class ValuesInputIterator,
+             class ValuesOutputIterator,
+             class BinaryFunction>
+    ROCPRIM_DEVICE ROCPRIM_INLINE void merge_runs(KeysInputIterator    keys_input,
+                                                  KeysOutputIterator   keys_output,
+                                                  ValuesInputIterator  values_input,
+                                                  ValuesOutputIterator values_output,
+                                                  const unsigned int   size,
+                                                  const unsigned int   sorted_size,
+                                                  BinaryFunction       compare_function,
+                                                  merge_storage_type&  storage)
+    {
+        const unsigned int flat_id       = ::rocprim::detail::block_thread_id<0>();
+        auto&              keys_shared   = storage.keys.get();
+        auto&              values_shared = storage.values.get();
+
+        for(unsigned int tile_offset = 0; tile_offset < size; tile_offset += items_per_tile)
+        {
+            // The pair of runs that contains the tile
+            const unsigned int group_begin = tile_offset - tile_offset % (2 * sorted_size);
+            const unsigned int keys1_begin = group_begin;
+            const unsigned int keys1_end   = ::rocprim::min(size, group_begin + sorted_size);
+            const unsigned int keys2_begin = keys1_end;
+            const unsigned int keys2_end   = ::rocprim::min(size, keys1_end + sorted_size);
+            const unsigned int count1      = keys1_end - keys1_begin;
+            const unsigned int count2      = keys2_end - keys2_begin;
+
+            const unsigned int diag_begin = tile_offset - group_begin;
+            const unsigned int diag_end   = ::rocprim::min(diag_begin + items_per_tile,
+                                                         count1 + count2);
+            if(flat_id == 0)
+            {
+                storage.partitions[0] = merge_path(keys_input + keys1_begin,
+                                                   keys_input + keys2_begin,
+                                                   count1,
+                                                   count2,
+                                                   diag_begin,
+                                                   compare_function);
+                storage.partitions[1] = merge_path(keys_input + keys1_begin,
+                                                   keys_input + keys2_begin,
+                                                   count1,
+                                                   count2,
+                                                   diag_end,
+                                                   compare_function);
+            }
+            ::rocprim::syncthreads();
+            const unsigned int partition_begin = storage.partitions[0];
+            const unsigned int partition_end   = storage.partitions[1];
+
+            const unsigned int tile_keys1_begin = keys1_begin + partition_begin;
+            const unsigned int tile_keys2_begin = keys2_begin + diag_begin - partition_begin;
+            const unsigned int num_keys1        = partition_end - partition_begin;
+            const unsigned int num_keys2 = (diag_end - partition_end) - (diag_begin - partition_begin);
+            const unsigned int num_keys  = num_keys1 + num_keys2;
+            const bool         is_incomplete_tile = num_keys < items_per_tile;
+
+            key_type keys[ItemsPerThread];
+            gmem_to_reg<ItemsPerThread>(keys,
+                                        keys_input + tile_keys1_begin,
+                                        keys_input + tile_keys2_begin,
+                                        num_keys1,
+                                        num_keys2,
+                                        is_incomplete_tile);
+            reg_to_shared<BlockSize, ItemsPerThread>(keys_shared, keys);
+
+            value_type values[ItemsPerThread];
+            if ROCPRIM_IF_CONSTEXPR(with_values)
+            {
+                gmem_to_reg<ItemsPerThread>(values,
+                                            values_input + tile_keys1_begin,
+                                            values_input + tile_keys2_begin,
+                                            num_keys1,
+                                            num_keys2,
+                                            is_incomplete_tile);
+            }
+            ::rocprim::syncthreads();
+
+            const unsigned int diag_local       = ::rocprim::min(num_keys, ItemsPerThread * flat_id);
+            const unsigned int keys1_begin_local = merge_path(keys_shared,
+                                                              &keys_shared[num_keys1],
+                                                              num_keys1,
+                                                              num_keys2,
+                                                              diag_local,
+                                                              compare_function);
+            const range_t range_local = {keys1_begin_local,
+                                         num_keys1,
+                                         num_keys1 + diag_local - keys1_begin_local,
+                                         num_keys};
+
+            unsigned int indices[ItemsPerThread];
+            serial_merge(keys_shared, keys, indices, range_local, compare_function);
+
+            if ROCPRIM_IF_CONSTEXPR(with_values)
+            {
+                reg_to_shared<BlockSize, ItemsPerThread>(values_shared, values);
+                ::rocprim::syncthreads();
+
+                ROCPRIM_UNROLL
+                for(unsigned int item = 0; item < ItemsPerThread; ++item)
+                {
+                    values[item] = values_shared[indices[item]];
+                }
+                ::rocprim::syncthreads();
+            }
+
+            block_store_type().store(tile_offset,
+                                     num_keys,
+                                     is_incomplete_tile,
+                                     keys_output,
+                                     values_output,
+                                     keys,
+                                     values,
+                                     storage.store);
+            ::rocprim::syncthreads();
+        }
+    }
+
+public:
+    union storage_type
+    {
+        typename block_sort_type::storage_type sort;
+        merge_storage_type                     merge;
+    };
+
+    template<class KeysInputIterator,
+             class KeysOutputIterator,
+             class ValuesInputIterator,
+             class ValuesOutputIterator,
+             class BinaryFunction>
+    ROCPRIM_DEVICE ROCPRIM_INLINE void sort(KeysInputIterator    keys_input,
+                                            key_type*            keys_tmp,
+                                            KeysOutputIterator   keys_output,
+                                            ValuesInputIterator  values_input,
+                                            value_type*          values_tmp,
+                                            ValuesOutputIterator values_output,
+                                            const unsigned int   begin_offset,
+                                            const unsigned int   end_offset,
+                                            BinaryFunction       compare_function,
+                                            storage_type&        storage)
+    {
+        const unsigned int size = end_offset - begin_offset;
+
+        keys_input += begin_offset;
+        keys_tmp += begin_offset;
+        keys_output += begin_offset;
+        if ROCPRIM_IF_CONSTEXPR(with_values)
+        {
+            values_input += begin_offset;
+            values_tmp += begin_offset;
+            values_output += begin_offset;
+        }
+
+        if(size <= items_per_tile)
+        {
+            block_sort_type().sort(size,
+                                   size < items_per_tile,
+                                   keys_input,
+                                   keys_output,
+                                   values_input,
+                                   values_output,
+                                   compare_function,
+                                   storage.sort);
+            return;
+        }
+
+        // Every merge pass swaps the buffers, the tiles are sorted into the buffer
+        // that makes the last pass write the output.
+        unsigned int passes = 0;
+        for(unsigned int sorted_size = items_per_tile; sorted_size < size; sorted_size *= 2)
+        {
+            passes++;
+        }
+        bool to_output = passes % 2 == 0;
+
+        for(unsigned int tile_offset = 0; tile_offset < size; tile_offset += items_per_tile)
+        {
+            const unsigned int valid = ::rocprim::min(items_per_tile, size - tile_offset);
+            if(to_output)
+            {
+                block_sort_type().sort(valid,
+                                       valid < items_per_tile,
+                                       keys_input + tile_offset,
+                                       keys_output + tile_offset,
+                                       values_input + tile_offset,
+                                       values_output + tile_offset,
+                                       compare_function,
+                                       storage.sort);
+            }
+            else
+            {
+                block_sort_type().sort(valid,
+                                       valid < items_per_tile,
+                                       keys_input + tile_offset,
+                                       keys_tmp + tile_offset,
+                                       values_input + tile_offset,
+                                       values_tmp + tile_offset,
+                                       compare_function,
+                                       storage.sort);
+            }
+            ::rocprim::syncthreads();
+        }
+
+        for(unsigned int sorted_size = items_per_tile; sorted_size < size; sorted_size *= 2)
+        {
+            if(to_output)
+            {
+                merge_runs(keys_output,
+                           keys_tmp,
+                           values_output,
+                           values_tmp,
+                           size,
+                           sorted_size,
+                           compare_function,
+                           storage.merge);
+            }
+            else
+            {
+                merge_runs(keys_tmp,
+                           keys_output,
+                           values_tmp,
+                           values_output,
+                           size,
+                           sorted_size,
+                           compare_function,
+                           storage.merge);
+            }
+            to_output = !to_output;
+        }
+    }
+};
+
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void segmented_merge_sort_block(
+    KeysInputIterator                                               keys_input,
+    typename std::iterator_traits<KeysInputIterator>::value_type*   keys_tmp,
+    KeysOutputIterator                                              keys_output,
+    ValuesInputIterator                                             values_input,
+    typename std::iterator_traits<ValuesInputIterator>::value_type* values_tmp,
+    ValuesOutputIterator                                            values_output,
+    SegmentIndexIterator                                            segment_indices,
+    OffsetIterator                                                  begin_offsets,
+    OffsetIterator                                                  end_offsets,
+    BinaryFunction                                                  compare_function)
+{
+    static constexpr segmented_merge_sort_config_params params = device_params<Config>();
+
+    using key_type   = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    using block_helper_type
+        = segmented_merge_sort_block_helper<params.kernel_config.block_size,
+                                            params.kernel_config.items_per_thread,
+                                            key_type,
+                                            value_type>;
+
+    ROCPRIM_SHARED_MEMORY typename block_helper_type::storage_type storage;
+
+    const unsigned int segment_id   = segment_indices[::rocprim::detail::block_id<0>()];
+    const unsigned int begin_offset = begin_offsets[segment_id];
+    const unsigned int end_offset   = end_offsets[segment_id];
+
+    // Empty segment
+    if(end_offset <= begin_offset)
+    {
+        return;
+    }
+
+    block_helper_type().sort(keys_input,
+                             keys_tmp,
+                             keys_output,
+                             values_input,
+                             values_tmp,
+                             values_output,
+                             begin_offset,
+                             end_offset,
+                             compare_function,
+                             storage);
+}
+
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
+    segmented_merge_sort_small(KeysInputIterator    keys_input,
+                               KeysOutputIterator   keys_output,
+                               ValuesInputIterator  values_input,
+                               ValuesOutputIterator values_output,
+                               const unsigned int   num_segments,
+                               SegmentIndexIterator segment_indices,
+                               OffsetIterator       begin_offsets,
+                               OffsetIterator       end_offsets,
+                               BinaryFunction       compare_function)
+{
+    static constexpr segmented_merge_sort_config_params params = device_params<Config>();
+
+    static constexpr unsigned int block_size        = params.block_size_small;
+    static constexpr unsigned int logical_warp_size = params.logical_warp_size_small;
+    static_assert(block_size % logical_warp_size == 0,
+                  "logical_warp_size must be a divisor of block_size");
+    static constexpr unsigned int warps_per_block = block_size / logical_warp_size;
+
+    using key_type   = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    using warp_helper_type = segmented_merge_sort_warp_helper<logical_warp_size,
+                                                              params.items_per_thread_small,
+                                                              key_type,
+                                                              value_type>;
+
+    ROCPRIM_SHARED_MEMORY typename warp_helper_type::storage_type storage;
+
+    const unsigned int block_id        = ::rocprim::detail::block_id<0>();
+    const unsigned int logical_warp_id = ::rocprim::detail::logical_warp_id<logical_warp_size>();
+    const unsigned int segment_index   = block_id * warps_per_block + logical_warp_id;
+    if(segment_index >= num_segments)
+    {
+        return;
+    }
+
+    const unsigned int segment_id   = segment_indices[segment_index];
+    const unsigned int begin_offset = begin_offsets[segment_id];
+    const unsigned int end_offset   = end_offsets[segment_id];
+
+    // Empty segment
+    if(end_offset <= begin_offset)
+    {
+        return;
+    }
+
+    warp_helper_type().sort(keys_input,
+                            keys_output,
+                            values_input,
+                            values_output,
+                            begin_offset,
+                            end_offset,
+                            compare_function,
+                            storage);
+}
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_SEGMENTED_MERGE_SORT_HPP_
@@ -545,23 +545,10 @@ class segmented_warp_sort_helper<
     using values_store_type     = ::rocprim::warp_store<value_type, items_per_thread, logical_warp_size>;
     template<bool UseRadixMask>
     using radix_comparator_type = ::rocprim::detail::radix_merge_compare<Descending, UseRadixMask, key_type>;
-    using stable_key_type       = ::rocprim::tuple<key_type, unsigned int>;
-    using sort_type             = ::rocprim::warp_sort<stable_key_type, logical_warp_size, value_type>;
+    using sort_type             = ::rocprim::warp_sort<key_type, logical_warp_size, value_type>;
 
     static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
 
-    template<class ComparatorT>
-    ROCPRIM_DEVICE ROCPRIM_INLINE
-    decltype(auto) make_stable_comparator(ComparatorT comparator)
-    {
-        return [comparator](const stable_key_type& a, const stable_key_type& b) -> bool
-        {
-            const bool ab = comparator(rocprim::get<0>(a), rocprim::get<0>(b));
-            const bool ba = comparator(rocprim::get<0>(b), rocprim::get<0>(a));
-            return ab || (!ba && (rocprim::get<1>(a) < rocprim::get<1>(b)));
-        };
-    }
-
 public:
     static constexpr unsigned int items_per_warp = items_per_thread * logical_warp_size;
 
@@ -575,8 +562,9 @@ public:
     };
 
 private:
+    // The keys are loaded warp-striped, which is the input order of the stable warp sort
     template<class K = Key>
-    ROCPRIM_DEVICE auto invoke_warp_sort(stable_key_type (&stable_keys)[items_per_thread],
+    ROCPRIM_DEVICE auto invoke_warp_sort(key_type (&keys)[items_per_thread],
                                          value_type (&values)[items_per_thread],
                                          storage_type& storage,
                                          unsigned int  begin_bit,
@@ -585,14 +573,11 @@ private:
     {
         (void)begin_bit;
         (void)end_bit;
-        sort_type().sort(stable_keys,
-                         values,
-                         storage.sort,
-                         make_stable_comparator(radix_comparator_type<false>{}));
+        sort_type().stable_sort(keys, values, storage.sort, radix_comparator_type<false>{});
     }
 
     template<class K = Key>
-    ROCPRIM_DEVICE auto invoke_warp_sort(stable_key_type (&stable_keys)[items_per_thread],
+    ROCPRIM_DEVICE auto invoke_warp_sort(key_type (&keys)[items_per_thread],
                                          value_type (&values)[items_per_thread],
                                          storage_type& storage,
                                          unsigned int  begin_bit,
@@ -601,15 +586,12 @@ private:
     {
         if(begin_bit == 0 && end_bit == 8 * sizeof(key_type))
         {
-            sort_type().sort(stable_keys,
-                             values,
-                             storage.sort,
-                             make_stable_comparator(radix_comparator_type<false>{}));
+            sort_type().stable_sort(keys, values, storage.sort, radix_comparator_type<false>{});
         }
         else
         {
             radix_comparator_type<true> comparator(begin_bit, end_bit - begin_bit);
-            sort_type().sort(stable_keys, values, storage.sort, make_stable_comparator(comparator));
+            sort_type().stable_sort(keys, values, storage.sort, comparator);
         }
     }
 
@@ -635,18 +617,9 @@ public:
         const key_type out_of_bounds = key_codec::decode(bit_key_type(-1));
 
         key_type keys[items_per_thread];
-        stable_key_type stable_keys[items_per_thread];
         value_type values[items_per_thread];
         keys_load_type().load(keys_input + begin_offset, keys, num_items, out_of_bounds, storage.keys_load);
 
-        ROCPRIM_UNROLL
-        for(unsigned int i = 0; i < items_per_thread; i++)
-        {
-            ::rocprim::get<0>(stable_keys[i]) = keys[i];
-            ::rocprim::get<1>(stable_keys[i]) =
-                ::rocprim::detail::logical_lane_id<logical_warp_size>() + logical_warp_size * i;
-        }
-
         if(with_values)
         {
             ::rocprim::wave_barrier();
@@ -654,13 +627,7 @@ public:
         }
 
         ::rocprim::wave_barrier();
-        invoke_warp_sort(stable_keys, values, storage, begin_bit, end_bit);
-
-        ROCPRIM_UNROLL
-        for(unsigned int i = 0; i < items_per_thread; i++)
-        {
-            keys[i] = ::rocprim::get<0>(stable_keys[i]);
-        }
+        invoke_warp_sort(keys, values, storage, begin_bit, end_bit);
         ::rocprim::wave_barrier();
         keys_store_type().store(keys_output + begin_offset, keys, num_items, storage.keys_store);
 
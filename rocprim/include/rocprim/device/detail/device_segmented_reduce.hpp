@@ -25,13 +25,16 @@
 #include <iterator>
 
 #include "../../config.hpp"
+#include "../../detail/merge_path.hpp"
 #include "../../detail/various.hpp"
 
 #include "../../intrinsics.hpp"
+#include "../../iterator/counting_iterator.hpp"
 #include "../../types.hpp"
 
 #include "../../block/block_load_func.hpp"
 #include "../../block/block_reduce.hpp"
+#include "../../block/block_scan.hpp"
 #include "../config_types.hpp"
 #include "../device_reduce_config.hpp"
 
@@ -160,6 +163,341 @@ void segmented_reduce(InputIterator input,
     }
 }
 
+
+// Merge-path segmented reduction of a CSR offsets array (segmented_reduce_csr).
+//
+// Based on: Merrill, D. and Garland, M. Merge-based Parallel Sparse Matrix-Vector
+// Multiplication. SC16.
+//
+// The row ends offsets[1, segments] are merged with the indices of the values
+// [offsets[0], offsets[segments]): a value index n is placed before a row end e if n < e.
+// The merge path of segments + nnz steps is split evenly between the blocks of a persistent
+// grid, every block processes its part in tiles and every thread of a tile processes
+// items_per_thread steps, so the work does not depend on the lengths of the rows.
+//
+// A row is reduced in order, starting with the initial value when its first step is taken.
+// The partial results of the threads are combined with a segmented block scan. Every row that
+// ends in a block and started in the same block is stored directly. The row that is open when
+// a block starts (if it started in a previous block) is the head of the block: its partial
+// result is stored in the block state together with the partial result of the row that is
+// still open when the block ends (the carry). A fixup kernel scans the carries of the blocks
+// and completes the heads.
+
+// Partial reduction of a row. `row_start` is set if a row started in the reduced range, in
+// that case `value` only covers the last row.
+template<class T>
+struct segmented_reduce_csr_partial
+{
+    T    value;
+    bool valid;
+    bool row_start;
+};
+
+// Segmented scan operator of partial reductions, it does not require a commutative reduce_op.
+template<class T, class BinaryFunction>
+struct segmented_reduce_csr_partial_op
+{
+    using partial_type = segmented_reduce_csr_partial<T>;
+
+    ROCPRIM_HOST_DEVICE inline segmented_reduce_csr_partial_op() = default;
+
+    ROCPRIM_HOST_DEVICE inline segmented_reduce_csr_partial_op(BinaryFunction reduce_op)
+        : reduce_op_(reduce_op)
+    {}
+
+    ROCPRIM_HOST_DEVICE inline partial_type operator()(const partial_type& a, const partial_type& b)
+    {
+        if(b.row_start || !a.valid)
+        {
+            return partial_type{b.value, b.valid, a.row_start || b.row_start};
+        }
+        if(!b.valid)
+        {
+            return a;
+        }
+        return partial_type{reduce_op_(a.value, b.value), true, a.row_start};
+    }
+
+private:
+    BinaryFunction reduce_op_;
+};
+
+template<class T>
+struct segmented_reduce_csr_block_state
+{
+    // Row open at the end of the block, carry.row_start is set if it does not continue
+    // the carry of the previous block
+    segmented_reduce_csr_partial<T> carry;
+    // Partial result of the row that started in a previous block and ends in this block
+    T      head;
+    size_t head_row;
+    bool   head_valid;
+    bool   has_head;
+};
+
+// Compares a row end with a value index, for merge_path the values are the first sequence.
+template<class OffsetType>
+struct segmented_reduce_csr_compare
+{
+    ROCPRIM_DEVICE ROCPRIM_INLINE bool operator()(const OffsetType& end, const size_t& index) const
+    {
+        return static_cast<size_t>(end) <= index;
+    }
+};
+
+template<class Config,
+         class InputIterator,
+         class OutputIterator,
+         class OffsetIterator,
+         class ResultType,
+         class BinaryFunction>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
+    segmented_reduce_csr_kernel_impl(InputIterator                                 input,
+                                     OutputIterator                                output,
+                                     const unsigned int                            segments,
+                                     OffsetIterator                                offsets,
+                                     BinaryFunction                                reduce_op,
+                                     ResultType                                    initial_value,
+                                     segmented_reduce_csr_block_state<ResultType>* block_states)
+{
+    static constexpr reduce_config_params params = device_params<Config>();
+
+    constexpr unsigned int block_size       = params.reduce_config.block_size;
+    constexpr unsigned int items_per_thread = params.reduce_config.items_per_thread;
+    constexpr unsigned int items_per_tile   = block_size * items_per_thread;
+
+    using offset_type     = typename std::iterator_traits<OffsetIterator>::value_type;
+    using partial_type    = segmented_reduce_csr_partial<ResultType>;
+    using partial_op_type = segmented_reduce_csr_partial_op<ResultType, BinaryFunction>;
+    using block_scan_type = ::rocprim::block_scan<partial_type, block_size>;
+
+    struct storage_type
+    {
+        size_t                                 block_index_begin;
+        size_t                                 index_begin;
+        size_t                                 index_end;
+        raw_storage<partial_type>              carry;
+        offset_type                            ends[items_per_tile];
+        typename block_scan_type::storage_type scan;
+    };
+    ROCPRIM_SHARED_MEMORY storage_type storage;
+
+    const unsigned int flat_thread_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int flat_block_id  = ::rocprim::detail::block_id<0>();
+    const unsigned int grid_size      = ::rocprim::detail::grid_size<0>();
+
+    const size_t    base      = static_cast<size_t>(offsets[0]);
+    const size_t    nnz       = static_cast<size_t>(offsets[segments]) - base;
+    const size_t    path_size = nnz + segments;
+    const auto      indices   = ::rocprim::counting_iterator<size_t>(base);
+    const auto      ends      = offsets + 1;
+    const auto      compare   = segmented_reduce_csr_compare<offset_type>{};
+    partial_op_type partial_op(reduce_op);
+
+    const size_t block_path_size = ::rocprim::detail::ceiling_div(path_size, grid_size);
+    const size_t block_begin     = ::rocprim::min(flat_block_id * block_path_size, path_size);
+    const size_t block_end       = ::rocprim::min(block_begin + block_path_size, path_size);
+
+    if(flat_thread_id == 0)
+    {
+        const size_t index_begin
+            = merge_path(indices, ends, nnz, size_t(segments), block_begin, compare);
+        storage.block_index_begin = index_begin;
+
+        // The block starts a new row if it does not start with values of its first row
+        const size_t row_begin = block_begin - index_begin;
+        const bool   row_start = base + index_begin == static_cast<size_t>(offsets[row_begin]);
+        storage.carry.get()    = partial_type{initial_value, row_start, row_start};
+    }
+    ::rocprim::syncthreads();
+
+    const size_t block_row_begin = block_begin - storage.block_index_begin;
+    const bool   block_row_start = storage.carry.get().row_start;
+
+    for(size_t diag_begin = block_begin; diag_begin < block_end; diag_begin += items_per_tile)
+    {
+        const size_t diag_end = ::rocprim::min(diag_begin + items_per_tile, block_end);
+
+        // Partition the merge path between the tiles
+        if(flat_thread_id == 0)
+        {
+            storage.index_begin
+                = merge_path(indices, ends, nnz, size_t(segments), diag_begin, compare);
+        }
+        if(flat_thread_id == block_size - 1)
+        {
+            storage.index_end = merge_path(indices, ends, nnz, size_t(segments), diag_end, compare);
+        }
+        ::rocprim::syncthreads();
+
+        const size_t       index_begin = storage.index_begin;
+        const size_t       row_begin   = diag_begin - index_begin;
+        const unsigned int index_count = static_cast<unsigned int>(storage.index_end - index_begin);
+        const unsigned int row_count
+            = static_cast<unsigned int>(diag_end - storage.index_end - row_begin);
+        const unsigned int tile_size = index_count + row_count;
+
+        for(unsigned int j = flat_thread_id; j < row_count; j += block_size)
+        {
+            storage.ends[j] = ends[row_begin + j];
+        }
+        ::rocprim::syncthreads();
+
+        // Partition the merge path of the tile between the threads
+        const unsigned int diag = ::rocprim::min(flat_thread_id * items_per_thread, tile_size);
+        unsigned int       x    = merge_path(indices + index_begin,
+                                    storage.ends,
+                                    index_count,
+                                    row_count,
+                                    diag,
+                                    compare);
+        unsigned int       y    = diag - x;
+
+        const size_t first_row = row_begin + y;
+        partial_type thread_partial;
+        thread_partial.valid     = false;
+        thread_partial.row_start = false;
+        // Partial result of the first row of the thread if it ends in the thread
+        ResultType head;
+        bool       head_valid = false;
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            if(diag + i >= tile_size)
+            {
+                break;
+            }
+            const size_t index = base + index_begin + x;
+            const bool   take_value
+                = y >= row_count
+                  || (x < index_count && index < static_cast<size_t>(storage.ends[y]));
+            if(take_value)
+            {
+                const ResultType value = static_cast<ResultType>(input[index]);
+                thread_partial.value
+                    = thread_partial.valid ? reduce_op(thread_partial.value, value) : value;
+                thread_partial.valid = true;
+                x++;
+            }
+            else
+            {
+                if(!thread_partial.row_start)
+                {
+                    head       = thread_partial.value;
+                    head_valid = thread_partial.valid;
+                }
+                else
+                {
+                    // The row started in this thread
+                    output[row_begin + y] = thread_partial.value;
+                }
+                thread_partial = partial_type{initial_value, true, true};
+                y++;
+            }
+        }
+
+        // The partial result of the tile and the previous tiles of the block before the thread
+        partial_type       prefix;
+        const partial_type carry = storage.carry.get();
+        block_scan_type().exclusive_scan(thread_partial, prefix, carry, storage.scan, partial_op);
+
+        if(thread_partial.row_start)
+        {
+            const partial_type row = partial_op(prefix, partial_type{head, head_valid, false});
+            if(first_row == block_row_begin && !block_row_start)
+            {
+                block_states[flat_block_id].head       = row.value;
+                block_states[flat_block_id].head_valid = row.valid;
+            }
+            else
+            {
+                output[first_row] = row.value;
+            }
+        }
+        if(flat_thread_id == block_size - 1)
+        {
+            storage.carry.get() = partial_op(prefix, thread_partial);
+        }
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
+    }
+
+    if(flat_thread_id == 0)
+    {
+        // A row ended in the block if a row started after the start of the block
+        partial_type carry = storage.carry.get();
+        const bool   row_end = carry.row_start && !block_row_start;
+        block_states[flat_block_id].carry    = carry;
+        block_states[flat_block_id].head_row = block_row_begin;
+        block_states[flat_block_id].has_head = row_end;
+    }
+}
+
+template<class Config, class OutputIterator, class ResultType, class BinaryFunction>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void segmented_reduce_csr_fixup_kernel_impl(
+    OutputIterator                                      output,
+    const segmented_reduce_csr_block_state<ResultType>* block_states,
+    const unsigned int                                  block_count,
+    BinaryFunction                                      reduce_op)
+{
+    static constexpr reduce_config_params params = device_params<Config>();
+
+    constexpr unsigned int block_size = params.reduce_config.block_size;
+
+    using partial_type    = segmented_reduce_csr_partial<ResultType>;
+    using partial_op_type = segmented_reduce_csr_partial_op<ResultType, BinaryFunction>;
+    using block_scan_type = ::rocprim::block_scan<partial_type, block_size>;
+
+    struct storage_type
+    {
+        raw_storage<partial_type>              prefix;
+        typename block_scan_type::storage_type scan;
+    };
+    ROCPRIM_SHARED_MEMORY storage_type storage;
+
+    const unsigned int flat_thread_id = ::rocprim::detail::block_thread_id<0>();
+    partial_op_type    partial_op(reduce_op);
+
+    if(flat_thread_id == 0)
+    {
+        storage.prefix.get().valid     = false;
+        storage.prefix.get().row_start = false;
+    }
+    ::rocprim::syncthreads();
+
+    // The carries of the blocks are scanned in order, the exclusive prefix of a block is
+    // the partial result of the row open at its start.
+    for(unsigned int offset = 0; offset < block_count; offset += block_size)
+    {
+        const unsigned int block = offset + flat_thread_id;
+
+        partial_type carry;
+        carry.valid     = false;
+        carry.row_start = false;
+        if(block < block_count)
+        {
+            carry = block_states[block].carry;
+        }
+
+        partial_type       prefix;
+        const partial_type previous = storage.prefix.get();
+        block_scan_type().exclusive_scan(carry, prefix, previous, storage.scan, partial_op);
+
+        if(block < block_count && block_states[block].has_head)
+        {
+            // The row started in a previous block, so the prefix is valid
+            const segmented_reduce_csr_block_state<ResultType>& state = block_states[block];
+            output[state.head_row]
+                = state.head_valid ? reduce_op(prefix.value, state.head) : prefix.value;
+        }
+        if(flat_thread_id == block_size - 1)
+        {
+            storage.prefix.get() = partial_op(prefix, carry);
+        }
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
+    }
+}
+
 } // end of detail namespace
 
 END_ROCPRIM_NAMESPACE
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -21,6 +21,7 @@
 #ifndef ROCPRIM_DEVICE_DETAIL_LOOKBACK_SCAN_STATE_HPP_
 #define ROCPRIM_DEVICE_DETAIL_LOOKBACK_SCAN_STATE_HPP_
 
+#include <limits>
 #include <type_traits>
 
 #include "../../functional.hpp"
@@ -36,6 +37,7 @@
 #include "../../detail/various.hpp"
 
 #include "../config_types.hpp"
+#include "../device_trace.hpp"
 #include "rocprim/config.hpp"
 
 // This version is specific for devices with slow __threadfence ("agent" fence which does
@@ -78,6 +80,96 @@ enum prefix_flag
     PREFIX_COMPLETE = 2
 };
 
+// Counts the look-back events of the calling thread. The counts are only kept if
+// ROCPRIM_INSTRUMENT is enabled, otherwise all member functions are empty.
+struct lookback_probe
+{
+#if ROCPRIM_INSTRUMENT
+    ROCPRIM_DEVICE ROCPRIM_INLINE void lookback_iteration()
+    {
+        counts.lookback_iterations++;
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void spin_loop()
+    {
+        counts.spin_loops++;
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void sleep(const unsigned int sleeps)
+    {
+        counts.sleeps += sleeps;
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void prefix_reload()
+    {
+        counts.prefix_reloads++;
+    }
+
+    lookback_counters counts{};
+#else
+    ROCPRIM_DEVICE ROCPRIM_INLINE void lookback_iteration() {}
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void spin_loop() {}
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void sleep(const unsigned int /*sleeps*/) {}
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void prefix_reload() {}
+#endif
+};
+
+// Base of the look-back scan states, keeps the counters of the instrument_scope that was
+// active when the state was created. Empty if ROCPRIM_INSTRUMENT is disabled.
+struct lookback_instrumentation
+{
+#if ROCPRIM_INSTRUMENT
+    ROCPRIM_HOST void init_instrumentation()
+    {
+        const instrument_buffer& buffer = current_instrument_buffer();
+        instrument_counters_            = buffer.counters;
+        instrument_size_                = static_cast<unsigned int>(
+            ::rocprim::min<size_t>(buffer.size, std::numeric_limits<unsigned int>::max()));
+    }
+
+    // Adds the counts of the calling thread to the counters of the tile
+    ROCPRIM_DEVICE ROCPRIM_INLINE void record_lookback(const unsigned int    tile_id,
+                                                       const lookback_probe& probe) const
+    {
+        if(instrument_counters_ == nullptr)
+        {
+            return;
+        }
+        lookback_counters& counters = instrument_counters_[tile_id % instrument_size_];
+        if(probe.counts.lookback_iterations != 0)
+        {
+            ::rocprim::detail::atomic_add(&counters.lookback_iterations,
+                                          probe.counts.lookback_iterations);
+        }
+        if(probe.counts.spin_loops != 0)
+        {
+            ::rocprim::detail::atomic_add(&counters.spin_loops, probe.counts.spin_loops);
+        }
+        if(probe.counts.sleeps != 0)
+        {
+            ::rocprim::detail::atomic_add(&counters.sleeps, probe.counts.sleeps);
+        }
+        if(probe.counts.prefix_reloads != 0)
+        {
+            ::rocprim::detail::atomic_add(&counters.prefix_reloads, probe.counts.prefix_reloads);
+        }
+    }
+
+private:
+    lookback_counters* instrument_counters_;
+    unsigned int       instrument_size_;
+#else
+    ROCPRIM_HOST void init_instrumentation() {}
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void record_lookback(const unsigned int /*tile_id*/,
+                                                       const lookback_probe& /*probe*/) const
+    {}
+#endif
+};
+
 // lookback_scan_state object keeps track of prefixes status for
 // a look-back prefix scan. Initially every prefix can be either
 // invalid (padding values) or empty. One thread in a block should
@@ -87,7 +179,7 @@ struct lookback_scan_state;
 
 // Packed flag and prefix value are loaded/stored in one atomic operation.
 template<class T, bool UseSleep>
-struct lookback_scan_state<T, UseSleep, true>
+struct lookback_scan_state<T, UseSleep, true> : lookback_instrumentation
 {
 private:
     using flag_type_ = char;
@@ -123,6 +215,7 @@ public:
     {
         (void)number_of_blocks;
         state.prefixes = reinterpret_cast<prefix_underlying_type*>(temp_storage);
+        state.init_instrumentation();
         return hipSuccess;
     }
 
@@ -225,6 +318,13 @@ public:
     // block_id must be > 0
     ROCPRIM_DEVICE ROCPRIM_INLINE
     void get(const unsigned int block_id, flag_type& flag, T& value)
+    {
+        lookback_probe probe;
+        get(block_id, flag, value, probe);
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void get(const unsigned int block_id, flag_type& flag, T& value, lookback_probe& probe)
     {
         constexpr unsigned int padding = ::rocprim::device_warp_size();
 
@@ -241,8 +341,10 @@ public:
 #endif
         while(prefix.flag == PREFIX_EMPTY)
         {
+            probe.spin_loop();
             if (UseSleep)
             {
+                probe.sleep(times_through);
                 for (unsigned int j = 0; j < times_through; j++)
 #ifndef __HIP_CPU_RT__
                     __builtin_amdgcn_s_sleep(1);
@@ -305,7 +407,7 @@ private:
 // Flag, partial and final prefixes are stored in separate arrays.
 // Consistency ensured by memory fences between flag and prefixes load/store operations.
 template<class T, bool UseSleep>
-struct lookback_scan_state<T, UseSleep, false>
+struct lookback_scan_state<T, UseSleep, false> : lookback_instrumentation
 {
 
 public:
@@ -332,6 +434,7 @@ public:
         ptr += ::rocprim::detail::align_size(n * sizeof(value_underlying_type));
 
         state.prefixes_complete_values = ptr;
+        state.init_instrumentation();
         return error;
     }
 
@@ -416,6 +519,13 @@ public:
 
     // block_id must be > 0
     ROCPRIM_DEVICE ROCPRIM_INLINE void get(const unsigned int block_id, flag_type& flag, T& value)
+    {
+        lookback_probe probe;
+        get(block_id, flag, value, probe);
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void
+        get(const unsigned int block_id, flag_type& flag, T& value, lookback_probe& probe)
     {
         constexpr unsigned int padding = ::rocprim::device_warp_size();
 
@@ -425,8 +535,10 @@ public:
         flag = ::rocprim::detail::atomic_load(&prefixes_flags[padding + block_id]);
         while(flag == PREFIX_EMPTY)
         {
+            probe.spin_loop();
             if (UseSleep)
             {
+                probe.sleep(times_through);
                 for (unsigned int j = 0; j < times_through; j++)
 #ifndef __HIP_CPU_RT__
                     __builtin_amdgcn_s_sleep(1);
@@ -524,6 +636,218 @@ private:
     void* prefixes_complete_values;
 };
 
+// Every 32-bit word of a prefix value is stored together with the flag in one 64-bit word.
+// A prefix is consistent when all of its words carry the same flag, so no fences are needed
+// between storing the value and the flag. Partial and complete prefixes share the storage:
+// a reader that observes words of both states (while the complete prefix is being written)
+// simply loads the prefix again.
+template<class T, bool UseSleep = false>
+struct lookback_scan_state_tagged : lookback_instrumentation
+{
+private:
+    using tagged_word_type = unsigned long long;
+
+    struct value_words_type
+    {
+        static constexpr unsigned int words_no = ceiling_div(sizeof(T), sizeof(unsigned int));
+
+        unsigned int words[words_no];
+    };
+
+    static constexpr unsigned int words_no = value_words_type::words_no;
+
+public:
+    using flag_type  = unsigned int;
+    using value_type = T;
+
+    // temp_storage must point to allocation of get_storage_size(number_of_blocks) bytes
+    ROCPRIM_HOST static inline hipError_t create(lookback_scan_state_tagged& state,
+                                                 void*                       temp_storage,
+                                                 const unsigned int          number_of_blocks,
+                                                 const hipStream_t /*stream*/)
+    {
+        (void)number_of_blocks;
+        state.prefixes = reinterpret_cast<tagged_word_type*>(temp_storage);
+        state.init_instrumentation();
+        return hipSuccess;
+    }
+
+    ROCPRIM_HOST static inline hipError_t get_storage_size(const unsigned int number_of_blocks,
+                                                           const hipStream_t  stream,
+                                                           size_t&            storage_size)
+    {
+        unsigned int warp_size;
+        hipError_t   error = ::rocprim::host_warp_size(stream, warp_size);
+
+        storage_size = sizeof(tagged_word_type) * words_no * (warp_size + number_of_blocks);
+
+        return error;
+    }
+
+    ROCPRIM_HOST static inline hipError_t
+        get_temp_storage_layout(const unsigned int            number_of_blocks,
+                                const hipStream_t             stream,
+                                detail::temp_storage::layout& layout)
+    {
+        size_t     storage_size = 0;
+        hipError_t error        = get_storage_size(number_of_blocks, stream, storage_size);
+        layout = detail::temp_storage::layout{storage_size, alignof(tagged_word_type)};
+        return error;
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void initialize_prefix(const unsigned int block_id,
+                                                         const unsigned int number_of_blocks)
+    {
+        constexpr unsigned int padding = ::rocprim::device_warp_size();
+        if(block_id < number_of_blocks)
+        {
+            for(unsigned int i = 0; i < words_no; ++i)
+            {
+                prefixes[(padding + block_id) * words_no + i] = make_word(PREFIX_EMPTY, 0);
+            }
+        }
+        if(block_id < padding)
+        {
+            for(unsigned int i = 0; i < words_no; ++i)
+            {
+                prefixes[block_id * words_no + i] = make_word(PREFIX_INVALID, 0);
+            }
+        }
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void set_partial(const unsigned int block_id, const T value)
+    {
+        this->set(block_id, PREFIX_PARTIAL, value);
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void set_complete(const unsigned int block_id, const T value)
+    {
+        this->set(block_id, PREFIX_COMPLETE, value);
+    }
+
+    // block_id must be > 0
+    ROCPRIM_DEVICE ROCPRIM_INLINE void get(const unsigned int block_id, flag_type& flag, T& value)
+    {
+        lookback_probe probe;
+        get(block_id, flag, value, probe);
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void
+        get(const unsigned int block_id, flag_type& flag, T& value, lookback_probe& probe)
+    {
+        constexpr unsigned int padding = ::rocprim::device_warp_size();
+
+        const unsigned int SLEEP_MAX     = 32;
+        unsigned int       times_through = 1;
+
+        const tagged_word_type* prefix = &prefixes[(padding + block_id) * words_no];
+
+        value_words_type v;
+        while(!try_load(prefix, flag, v))
+        {
+            // An available prefix is only loaded again if its words were inconsistent
+            if(flag == PREFIX_EMPTY)
+            {
+                probe.spin_loop();
+            }
+            else
+            {
+                probe.prefix_reload();
+            }
+            if(UseSleep)
+            {
+                probe.sleep(times_through);
+                for(unsigned int j = 0; j < times_through; j++)
+#ifndef __HIP_CPU_RT__
+                    __builtin_amdgcn_s_sleep(1);
+#else
+                    std::this_thread::sleep_for(std::chrono::microseconds{1});
+#endif
+                if(times_through < SLEEP_MAX)
+                    times_through++;
+            }
+        }
+#ifndef __HIP_CPU_RT__
+        __builtin_memcpy(&value, &v, sizeof(T));
+#else
+        std::memcpy(&value, &v, sizeof(T));
+#endif
+    }
+
+    /// \brief Gets the prefix value for a block. Should only be called after all
+    /// blocks/prefixes are completed.
+    ROCPRIM_DEVICE ROCPRIM_INLINE T get_complete_value(const unsigned int block_id)
+    {
+        constexpr unsigned int padding = ::rocprim::device_warp_size();
+
+        flag_type        flag;
+        value_words_type v;
+        const bool       consistent
+            = try_load(&prefixes[(padding + block_id) * words_no], flag, v);
+        assert(consistent && flag == PREFIX_COMPLETE);
+        (void)consistent;
+
+        T value;
+#ifndef __HIP_CPU_RT__
+        __builtin_memcpy(&value, &v, sizeof(T));
+#else
+        std::memcpy(&value, &v, sizeof(T));
+#endif
+        return value;
+    }
+
+private:
+    ROCPRIM_DEVICE ROCPRIM_INLINE static tagged_word_type make_word(const flag_type    flag,
+                                                                   const unsigned int word)
+    {
+        return (static_cast<tagged_word_type>(word) << 32) | flag;
+    }
+
+    // Returns false if the prefix is empty or its words were written with different flags
+    ROCPRIM_DEVICE ROCPRIM_INLINE static bool
+        try_load(const tagged_word_type* prefix, flag_type& flag, value_words_type& v)
+    {
+        tagged_word_type w = ::rocprim::detail::atomic_load(&prefix[0]);
+        flag               = static_cast<flag_type>(w);
+        if(flag == PREFIX_EMPTY)
+        {
+            return false;
+        }
+        v.words[0] = static_cast<unsigned int>(w >> 32);
+
+        bool consistent = true;
+        ROCPRIM_UNROLL
+        for(unsigned int i = 1; i < words_no; ++i)
+        {
+            w          = ::rocprim::detail::atomic_load(&prefix[i]);
+            consistent = consistent && static_cast<flag_type>(w) == flag;
+            v.words[i] = static_cast<unsigned int>(w >> 32);
+        }
+        return consistent;
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE void
+        set(const unsigned int block_id, const flag_type flag, const T value)
+    {
+        constexpr unsigned int padding = ::rocprim::device_warp_size();
+
+        value_words_type v{};
+#ifndef __HIP_CPU_RT__
+        __builtin_memcpy(&v, &value, sizeof(T));
+#else
+        std::memcpy(&v, &value, sizeof(T));
+#endif
+        tagged_word_type* prefix = &prefixes[(padding + block_id) * words_no];
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < words_no; ++i)
+        {
+            ::rocprim::detail::atomic_store(&prefix[i], make_word(flag, v.words[i]));
+        }
+    }
+
+    tagged_word_type* prefixes;
+};
+
 template<class T, class BinaryFunction, class LookbackScanState>
 class lookback_scan_prefix_op
 {
@@ -562,8 +886,13 @@ public:
             T, ::rocprim::device_warp_size(), false
         >;
 
+        // A window is counted once per warp, every lane polls one of its tiles
+        if(::rocprim::lane_id() == 0)
+        {
+            probe_.lookback_iteration();
+        }
         T block_prefix;
-        scan_state_.get(block_id, flag, block_prefix);
+        scan_state_.get(block_id, flag, block_prefix, probe_);
 
         auto headflag_scan_op = headflag_scan_op_type(scan_op_);
         warp_reduce_prefix_type()
@@ -608,6 +937,7 @@ public:
 
         // Get prefix
         auto prefix = get_prefix();
+        scan_state_.record_lookback(block_id_, probe_);
 
         // Set complete prefix for next block
         if(::rocprim::lane_id() == 0)
@@ -621,17 +951,13 @@ protected:
     unsigned int       block_id_;
     BinaryFunction     scan_op_;
     LookbackScanState& scan_state_;
+    lookback_probe     probe_;
 };
 
-inline hipError_t is_sleep_scan_state_used(bool& use_sleep)
+inline hipError_t is_sleep_scan_state_used(const int deviceId, bool& use_sleep)
 {
     hipDeviceProp_t prop;
-    int             deviceId;
-    if(const hipError_t error = hipGetDevice(&deviceId))
-    {
-        return error;
-    }
-    else if(const hipError_t error = hipGetDeviceProperties(&prop, deviceId))
+    if(const hipError_t error = hipGetDeviceProperties(&prop, deviceId))
     {
         return error;
     }
@@ -644,6 +970,23 @@ inline hipError_t is_sleep_scan_state_used(bool& use_sleep)
     return hipSuccess;
 }
 
+inline hipError_t is_sleep_scan_state_used(bool& use_sleep)
+{
+    // Execution plans query the device properties once
+    if(const plan_device_info* info = current_plan_device_info())
+    {
+        use_sleep = info->use_sleep_scan_state;
+        return hipSuccess;
+    }
+
+    int deviceId;
+    if(const hipError_t error = hipGetDevice(&deviceId))
+    {
+        return error;
+    }
+    return is_sleep_scan_state_used(deviceId, use_sleep);
+}
+
 template<typename T>
 class offset_lookback_scan_factory
 {
@@ -0,0 +1,184 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_PERSISTENT_GRID_HPP_
+#define ROCPRIM_DEVICE_DETAIL_PERSISTENT_GRID_HPP_
+
+#include "../../config.hpp"
+#include "../../detail/plan_launch_log.hpp"
+#include "../../detail/various.hpp"
+#include "../../intrinsics.hpp"
+#include "../config_types.hpp"
+
+#include "ordered_block_id.hpp"
+
+#include <algorithm>
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Launch helpers of kernels that run a persistent grid: as many blocks as can be resident on
+// the device at the same time, which process the tiles of the input in a loop instead of one
+// block per tile. Kernels whose blocks wait for the results of previous tiles (e.g. look-back)
+// must get their tiles from an ordered_block_id, so every tile they wait for is already
+// processed by a resident block.
+
+// Queries the number of blocks of kernel that can be resident on the device of stream
+template<class Kernel>
+inline hipError_t query_persistent_grid_size(Kernel             kernel,
+                                             const unsigned int block_size,
+                                             const hipStream_t  stream,
+                                             unsigned int&      grid_size)
+{
+    int        device_id;
+    hipError_t result = get_device_from_stream(stream, device_id);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    int multiprocessor_count;
+    if(const plan_device_info* info = current_plan_device_info())
+    {
+        multiprocessor_count = info->multiprocessor_count;
+    }
+    else
+    {
+        result = hipDeviceGetAttribute(&multiprocessor_count,
+                                       hipDeviceAttributeMultiprocessorCount,
+                                       device_id);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+    }
+
+    // `hipOccupancyMaxActiveBlocksPerMultiprocessor` uses the default device.
+    int previous_device;
+    result = hipGetDevice(&previous_device);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    result = hipSetDevice(device_id);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    int occupancy;
+    result = hipOccupancyMaxActiveBlocksPerMultiprocessor(&occupancy,
+                                                          kernel,
+                                                          block_size,
+                                                          0 /* dynSharedMemPerBlk */);
+    // The previous device is restored even if the occupancy query failed, the first error is
+    // returned
+    const hipError_t restore_result = hipSetDevice(previous_device);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    if(restore_result != hipSuccess)
+    {
+        return restore_result;
+    }
+
+    grid_size = static_cast<unsigned int>(multiprocessor_count * ::rocprim::max(occupancy, 1));
+    return hipSuccess;
+}
+
+/// \brief Get the number of blocks of a kernel that can be resident on the device of a stream
+/// at the same time.
+///
+/// \param kernel the kernel to be launched
+/// \param block_size number of threads in a block of the launch
+/// \param stream the stream of the launch
+/// \param grid_size the number of blocks, at least one block per compute unit
+///
+/// While an execution plan executes, the grid size is only queried the first time.
+template<class Kernel>
+inline hipError_t get_persistent_grid_size(Kernel             kernel,
+                                           const unsigned int block_size,
+                                           const hipStream_t  stream,
+                                           unsigned int&      grid_size)
+{
+    return plan_resolve(reinterpret_cast<const void*>(kernel),
+                        block_size,
+                        grid_size,
+                        [&](unsigned int& resolved_grid_size)
+                        {
+                            return query_persistent_grid_size(kernel,
+                                                              block_size,
+                                                              stream,
+                                                              resolved_grid_size);
+                        });
+}
+
+/// \brief Get the number of blocks of a persistent grid of a kernel that processes
+/// `number_of_tiles` tiles, at most one block per tile.
+///
+/// Only call it for configs that launch a persistent grid (see `static_branch`): naming the
+/// persistent kernel instantiates it.
+template<class Kernel>
+inline hipError_t get_persistent_grid_size(Kernel             kernel,
+                                           const unsigned int block_size,
+                                           const unsigned int number_of_tiles,
+                                           const hipStream_t  stream,
+                                           unsigned int&      grid_size)
+{
+    const hipError_t result = get_persistent_grid_size(kernel, block_size, stream, grid_size);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    grid_size = std::min(grid_size, number_of_tiles);
+    return hipSuccess;
+}
+
+/// \brief Calls `function(tile_id)` for the tiles handed out to the calling block by
+/// `ordered_tile_id`, in increasing order, until there are no tiles left.
+///
+/// `ordered_tile_id` must be reset before the launch. The threads of the block are synchronized
+/// after every tile, so `function` can reuse its shared memory.
+template<class Function>
+ROCPRIM_DEVICE ROCPRIM_INLINE void
+    for_each_ordered_tile(ordered_block_id<unsigned int> ordered_tile_id,
+                          const unsigned int             number_of_tiles,
+                          Function&&                     function)
+{
+    ROCPRIM_SHARED_MEMORY typename ordered_block_id<unsigned int>::storage_type storage;
+
+    const unsigned int flat_thread_id = ::rocprim::detail::block_thread_id<0>();
+    for(unsigned int tile_id = ordered_tile_id.get(flat_thread_id, storage);
+        tile_id < number_of_tiles;
+        tile_id = ordered_tile_id.get(flat_thread_id, storage))
+    {
+        function(tile_id);
+        // Every thread has read tile_id and finished the tile
+        ::rocprim::syncthreads();
+    }
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_PERSISTENT_GRID_HPP_
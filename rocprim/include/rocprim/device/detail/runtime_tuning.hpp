@@ -0,0 +1,561 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_RUNTIME_TUNING_HPP_
+#define ROCPRIM_DEVICE_DETAIL_RUNTIME_TUNING_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "../../config.hpp"
+#include "../../detail/plan_launch_log.hpp"
+#include "../../detail/various.hpp"
+#include "../../type_traits.hpp"
+
+#include "../config_types.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Runtime tuning of the default configs.
+//
+// Devices whose architecture is not in target_arch use the default configs of the tuned
+// architecture of the closest family, or of target_arch::unknown. If rocPRIM is compiled with
+// ROCPRIM_RUNTIME_TUNING=1 and the environment variable ROCPRIM_RUNTIME_TUNING_CACHE is set to the
+// path of a cache file, the algorithms that support it also try the default configs of some known
+// architectures (the candidates) on such devices. Every (gcnArchName, algorithm, type, size bucket) is tuned separately: each of its
+// calls runs the candidate with the fewest samples and is timed with HIP events. When every
+// candidate has runtime_tuning_samples samples, the candidate with the lowest time per item is
+// used for all later calls and it is appended to the cache file, so later processes do not tune
+// it again.
+//
+// While a key is tuned, the temporary storage size is the maximum of all candidates. A timed call
+// synchronizes its stream to read the time, so it blocks the host until the algorithm is done.
+// Calls on a capturing stream are not timed, they use the default config until the key is tuned.
+
+constexpr unsigned int runtime_tuning_samples = 3;
+
+constexpr unsigned int runtime_tuning_candidate_count = 4;
+
+// The first candidate is the config that is used without runtime tuning
+inline const char* runtime_tuning_candidate_name(const unsigned int candidate)
+{
+    constexpr const char* names[runtime_tuning_candidate_count]
+        = {"default", "gfx90a", "gfx1030", "gfx1102"};
+    return candidate < runtime_tuning_candidate_count ? names[candidate] : "";
+}
+
+// Returns runtime_tuning_candidate_count if there is no candidate with that name
+inline unsigned int runtime_tuning_candidate_from_name(const std::string& name)
+{
+    for(unsigned int candidate = 0; candidate < runtime_tuning_candidate_count; ++candidate)
+    {
+        if(name == runtime_tuning_candidate_name(candidate))
+        {
+            return candidate;
+        }
+    }
+    return runtime_tuning_candidate_count;
+}
+
+template<class Config, class Function>
+auto dispatch_runtime_tuning_candidate(const unsigned int candidate, Function&& function)
+    -> decltype(function(type_identity<Config>{}))
+{
+    switch(candidate)
+    {
+        case 1: return function(type_identity<fixed_arch_config<Config, target_arch::gfx90a>>{});
+        case 2: return function(type_identity<fixed_arch_config<Config, target_arch::gfx1030>>{});
+        case 3: return function(type_identity<fixed_arch_config<Config, target_arch::gfx1102>>{});
+    }
+    return function(type_identity<Config>{});
+}
+
+inline const char* size_bucket_name(const size_bucket bucket)
+{
+    switch(bucket)
+    {
+        case size_bucket::small: return "small";
+        case size_bucket::medium: return "medium";
+        case size_bucket::large: break;
+    }
+    return "large";
+}
+
+// Name of T in the keys. It only depends on the kind and the size of T, unlike typeid(T).name()
+// which differs between compilers, so a cache file can be shared by different builds.
+template<class T>
+std::string runtime_tuning_type_name()
+{
+    using type = typename std::remove_cv<T>::type;
+    std::string name
+        = std::is_same<type, ::rocprim::bfloat16>::value ? "bfloat"
+          : ::rocprim::is_floating_point<type>::value    ? "float"
+          : ::rocprim::is_integral<type>::value
+              ? (::rocprim::is_unsigned<type>::value ? "uint" : "int")
+              : "bytes";
+    name.append(std::to_string(sizeof(type) * 8));
+    if(name.compare(0, 5, "bytes") == 0)
+    {
+        name.append("a").append(std::to_string(alignof(type)));
+    }
+    return name;
+}
+
+// Only the name up to the first ':' (the target features) is used
+inline std::string make_runtime_tuning_key(const char*       arch_name,
+                                           const char*       algorithm,
+                                           const char*       type,
+                                           const size_bucket bucket)
+{
+    const char* arch_end = arch_name;
+    while(*arch_end != '\0' && *arch_end != ':')
+    {
+        ++arch_end;
+    }
+    std::string key(arch_name, arch_end);
+    key.append(" ").append(algorithm);
+    key.append(" ").append(type);
+    key.append(" ").append(size_bucket_name(bucket));
+    return key;
+}
+
+// Candidate selection of a single key
+class runtime_tuning_state
+{
+public:
+    bool is_tuned() const
+    {
+        return selected_ < runtime_tuning_candidate_count;
+    }
+
+    // The selected candidate if the key is tuned, otherwise the candidate to time next
+    unsigned int candidate() const
+    {
+        if(is_tuned())
+        {
+            return selected_;
+        }
+        return static_cast<unsigned int>(
+            std::min_element(samples_, samples_ + runtime_tuning_candidate_count) - samples_);
+    }
+
+    // Adds a timing of candidate, returns true if this sample completed the tuning
+    bool add_sample(const unsigned int candidate, const double time_per_item)
+    {
+        if(is_tuned() || candidate >= runtime_tuning_candidate_count)
+        {
+            return false;
+        }
+        best_[candidate] = samples_[candidate] == 0 ? time_per_item
+                                                    : std::min(best_[candidate], time_per_item);
+        ++samples_[candidate];
+        for(unsigned int i = 0; i < runtime_tuning_candidate_count; ++i)
+        {
+            if(samples_[i] < runtime_tuning_samples)
+            {
+                return false;
+            }
+        }
+        selected_ = static_cast<unsigned int>(
+            std::min_element(best_, best_ + runtime_tuning_candidate_count) - best_);
+        return true;
+    }
+
+    void select(const unsigned int candidate)
+    {
+        selected_ = candidate;
+    }
+
+private:
+    unsigned int samples_[runtime_tuning_candidate_count] = {};
+    double       best_[runtime_tuning_candidate_count]    = {};
+    unsigned int selected_                                = runtime_tuning_candidate_count;
+};
+
+// Each line of a cache file is "<gcnArchName> <algorithm> <type> <size bucket> <candidate>".
+// Later lines override earlier ones, lines with unknown candidates are ignored.
+inline void read_runtime_tuning_cache(std::istream&                               input,
+                                      std::map<std::string, runtime_tuning_state>& states)
+{
+    std::string line;
+    while(std::getline(input, line))
+    {
+        std::istringstream line_stream(line);
+        std::string        arch_name, algorithm, type, bucket, candidate_name;
+        if(!(line_stream >> arch_name >> algorithm >> type >> bucket >> candidate_name))
+        {
+            continue;
+        }
+        const unsigned int candidate = runtime_tuning_candidate_from_name(candidate_name);
+        if(candidate < runtime_tuning_candidate_count)
+        {
+            states[arch_name + " " + algorithm + " " + type + " " + bucket].select(candidate);
+        }
+    }
+}
+
+inline void write_runtime_tuning_cache_entry(std::ostream&      output,
+                                             const std::string& key,
+                                             const unsigned int candidate)
+{
+    output << key << ' ' << runtime_tuning_candidate_name(candidate) << '\n';
+}
+
+// The tuning states of all keys, backed by a cache file
+class runtime_tuner
+{
+public:
+    // An empty path disables the runtime tuning
+    explicit runtime_tuner(std::string cache_path) : cache_path_(std::move(cache_path))
+    {
+        if(enabled())
+        {
+            std::ifstream input(cache_path_);
+            read_runtime_tuning_cache(input, states_);
+        }
+    }
+
+    // The tuner of the process, configured by ROCPRIM_RUNTIME_TUNING_CACHE
+    static runtime_tuner& instance()
+    {
+        static runtime_tuner tuner(
+            [] {
+                const char* path = std::getenv("ROCPRIM_RUNTIME_TUNING_CACHE");
+                return std::string(path != nullptr ? path : "");
+            }());
+        return tuner;
+    }
+
+    bool enabled() const
+    {
+        return !cache_path_.empty();
+    }
+
+    // The candidate to use for the next call of key, is_tuned is set to true if the candidate
+    // is final
+    unsigned int candidate(const std::string& key, bool& is_tuned)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const runtime_tuning_state& state = states_[key];
+        is_tuned                          = state.is_tuned();
+        return state.candidate();
+    }
+
+    // Adds a timing of a candidate of key, the selected candidate is persisted when the tuning of
+    // key completes
+    void add_sample(const std::string& key,
+                    const unsigned int candidate,
+                    const double       time_per_item)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        runtime_tuning_state& state = states_[key];
+        if(state.add_sample(candidate, time_per_item))
+        {
+            persist(key, state.candidate());
+        }
+    }
+
+private:
+    // Appends the entry of key to the cache file. Other processes may update the file at the same
+    // time, so the entries are written to a temporary file that replaces the cache file at once.
+    // An entry of a process that replaced the file in the meantime may get lost, that key is then
+    // tuned again by a later process.
+    void persist(const std::string& key, const unsigned int candidate)
+    {
+        std::stringstream entries;
+        {
+            std::ifstream input(cache_path_);
+            if(input && input.peek() != std::ifstream::traits_type::eof())
+            {
+                entries << input.rdbuf();
+            }
+        }
+        write_runtime_tuning_cache_entry(entries, key, candidate);
+
+        const std::size_t unique
+            = std::hash<std::thread::id>{}(std::this_thread::get_id())
+              ^ static_cast<std::size_t>(
+                  std::chrono::steady_clock::now().time_since_epoch().count())
+              ^ reinterpret_cast<std::uintptr_t>(this);
+        const std::string temporary_path = cache_path_ + ".tmp" + std::to_string(unique);
+        {
+            std::ofstream output(temporary_path);
+            output << entries.rdbuf();
+            if(!output.flush())
+            {
+                output.close();
+                std::remove(temporary_path.c_str());
+                return;
+            }
+        }
+#ifdef _WIN32
+        // Renaming does not replace an existing file on Windows
+        std::remove(cache_path_.c_str());
+#endif
+        if(std::rename(temporary_path.c_str(), cache_path_.c_str()) != 0)
+        {
+            std::remove(temporary_path.c_str());
+        }
+    }
+
+    std::string                                 cache_path_;
+    std::mutex                                  mutex_;
+    std::map<std::string, runtime_tuning_state> states_;
+};
+
+// Cached gcnArchName of a device, only used by the runtime tuning
+inline hipError_t get_device_arch_name(const int device_id, std::string& arch_name)
+{
+    static std::mutex                 mutex;
+    static std::map<int, std::string> arch_names;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto                        it = arch_names.find(device_id);
+    if(it == arch_names.end())
+    {
+        hipDeviceProp_t  device_props;
+        const hipError_t result = hipGetDeviceProperties(&device_props, device_id);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        it = arch_names.emplace(device_id, device_props.gcnArchName).first;
+    }
+    arch_name = it->second;
+    return hipSuccess;
+}
+
+template<class Config>
+struct is_default_config : std::is_same<Config, default_config>
+{};
+
+template<size_bucket Bucket>
+struct is_default_config<default_bucket_config<Bucket>> : std::true_type
+{};
+
+template<class Config, class T, class Function>
+hipError_t dispatch_runtime_tuning(const char*,
+                                   void*,
+                                   size_t&,
+                                   const size_t,
+                                   const hipStream_t,
+                                   Function&& function,
+                                   std::false_type)
+{
+    return function(type_identity<Config>{});
+}
+
+template<class Config, class T, class Function>
+hipError_t dispatch_runtime_tuning(const char* const algorithm,
+                                   void* const       temporary_storage,
+                                   size_t&           storage_size,
+                                   const size_t      size,
+                                   const hipStream_t stream,
+                                   Function&&        function,
+                                   std::true_type)
+{
+    runtime_tuner& tuner = runtime_tuner::instance();
+    if(!tuner.enabled() || size == 0)
+    {
+        return function(type_identity<Config>{});
+    }
+
+    // The config of a call that is not timed for the tuning. Execution plans resolve it once,
+    // unless the tuning of the key is not done yet.
+    struct resolved_tuning
+    {
+        bool         use_config;
+        bool         is_tuned;
+        unsigned int candidate;
+    } resolved;
+    std::string key;
+
+    hipError_t result = plan_resolve(
+        algorithm,
+        static_cast<size_t>(get_size_bucket(size)),
+        resolved,
+        [&](resolved_tuning& value)
+        {
+            value.use_config = false;
+            value.is_tuned   = false;
+            value.candidate  = 0;
+
+            int        device_id;
+            hipError_t error = get_device_from_stream(stream, device_id);
+            if(error != hipSuccess)
+            {
+                return error;
+            }
+            std::string arch_name;
+            error = get_device_arch_name(device_id, arch_name);
+            if(error != hipSuccess)
+            {
+                return error;
+            }
+            // Architectures with tuned configs are not tuned at runtime
+            const std::string base_arch_name = arch_name.substr(0, arch_name.find(':'));
+            if(get_tuned_target_arch_from_name(base_arch_name.c_str(), base_arch_name.size())
+               != target_arch::unknown)
+            {
+                value.use_config = true;
+                return hipSuccess;
+            }
+
+            key = make_runtime_tuning_key(arch_name.c_str(),
+                                          algorithm,
+                                          runtime_tuning_type_name<T>().c_str(),
+                                          get_size_bucket(size));
+
+            value.candidate = tuner.candidate(key, value.is_tuned);
+            if(!value.is_tuned)
+            {
+                plan_resolve_unstable();
+            }
+            return hipSuccess;
+        });
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    if(resolved.use_config)
+    {
+        return function(type_identity<Config>{});
+    }
+    const unsigned int candidate = resolved.candidate;
+    if(resolved.is_tuned)
+    {
+        return dispatch_runtime_tuning_candidate<Config>(candidate, function);
+    }
+
+    if(temporary_storage == nullptr)
+    {
+        // The following calls may use any candidate until the tuning is done
+        size_t max_storage_size = 0;
+        for(unsigned int i = 0; i < runtime_tuning_candidate_count; ++i)
+        {
+            result = dispatch_runtime_tuning_candidate<Config>(i, function);
+            if(result != hipSuccess)
+            {
+                return result;
+            }
+            max_storage_size = std::max(max_storage_size, storage_size);
+        }
+        storage_size = max_storage_size;
+        return hipSuccess;
+    }
+
+    // Timing needs a synchronization, which is not allowed while the stream is captured
+    hipStreamCaptureStatus capture_status;
+    result = hipStreamIsCapturing(stream, &capture_status);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    if(capture_status != hipStreamCaptureStatusNone)
+    {
+        return function(type_identity<Config>{});
+    }
+
+    hipEvent_t start;
+    hipEvent_t stop;
+    result = hipEventCreate(&start);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    result = hipEventCreate(&stop);
+    if(result == hipSuccess)
+    {
+        result = hipEventRecord(start, stream);
+        if(result == hipSuccess)
+        {
+            result = dispatch_runtime_tuning_candidate<Config>(candidate, function);
+        }
+        if(result == hipSuccess)
+        {
+            result = hipEventRecord(stop, stream);
+        }
+        if(result == hipSuccess)
+        {
+            result = hipEventSynchronize(stop);
+        }
+        float elapsed_ms;
+        if(result == hipSuccess)
+        {
+            result = hipEventElapsedTime(&elapsed_ms, start, stop);
+        }
+        if(result == hipSuccess)
+        {
+            tuner.add_sample(key, candidate, static_cast<double>(elapsed_ms) / size);
+        }
+        static_cast<void>(hipEventDestroy(stop));
+    }
+    static_cast<void>(hipEventDestroy(start));
+    return result;
+}
+
+/// \brief Calls \p function with the `type_identity` of the config to use for \p size items
+/// of type \p T, with runtime tuning if it is compiled and enabled. \p function must return the
+/// `hipError_t` of the algorithm and, if \p temporary_storage is `nullptr`, set \p storage_size.
+///
+/// Only default configs are tuned, the candidates are not instantiated for other configs.
+/// A call that is timed for the tuning synchronizes \p stream, calls on a capturing stream are
+/// not timed.
+template<class Config, class T, class Function>
+hipError_t dispatch_runtime_tuning(const char* const algorithm,
+                                   void* const       temporary_storage,
+                                   size_t&           storage_size,
+                                   const size_t      size,
+                                   const hipStream_t stream,
+                                   Function&&        function)
+{
+    constexpr bool tuned = ROCPRIM_RUNTIME_TUNING && is_default_config<Config>::value;
+    return dispatch_runtime_tuning<Config, T>(algorithm,
+                                              temporary_storage,
+                                              storage_size,
+                                              size,
+                                              stream,
+                                              std::forward<Function>(function),
+                                              std::integral_constant<bool, tuned>{});
+}
+
+} // namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_RUNTIME_TUNING_HPP_
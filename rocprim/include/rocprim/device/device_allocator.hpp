@@ -0,0 +1,424 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_ALLOCATOR_HPP_
+#define ROCPRIM_DEVICE_DEVICE_ALLOCATOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../config.hpp"
+
+#include "config_types.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+/// \brief Allocates temporary storage stream-ordered from a HIP memory pool.
+///
+/// Allocations are made with \p hipMallocFromPoolAsync and freed with \p hipFreeAsync, so
+/// neither of them synchronizes the device. If the pool is \p nullptr, the default memory pool
+/// of the device of the stream is used (\p hipMallocAsync).
+///
+/// Like every allocator accepted by \p with_temporary_storage, it provides
+/// <tt>hipError_t allocate(void** ptr, size_t bytes, hipStream_t stream)</tt> and
+/// <tt>hipError_t deallocate(void* ptr, hipStream_t stream)</tt>.
+class mem_pool_allocator
+{
+public:
+    /// \brief Creates an allocator of \p pool, it does not take ownership of the pool.
+    explicit mem_pool_allocator(const hipMemPool_t pool = nullptr) noexcept : pool_(pool) {}
+
+    /// \brief Allocates \p bytes bytes, ordered after the work already submitted to \p stream.
+    hipError_t allocate(void** ptr, const size_t bytes, const hipStream_t stream)
+    {
+        if(pool_ == nullptr)
+        {
+            return hipMallocAsync(ptr, bytes, stream);
+        }
+        return hipMallocFromPoolAsync(ptr, bytes, pool_, stream);
+    }
+
+    /// \brief Frees \p ptr once the work already submitted to \p stream is finished.
+    hipError_t deallocate(void* ptr, const hipStream_t stream)
+    {
+        return hipFreeAsync(ptr, stream);
+    }
+
+private:
+    hipMemPool_t pool_;
+};
+
+/// \brief Backend of \p caching_device_allocator that allocates device memory with \p hipMalloc.
+///
+/// A backend provides the device of a stream and the uncached allocations of a device. Other
+/// backends (e.g. a mock to test the caching on the host) provide the same member functions.
+struct hip_device_allocator_backend
+{
+    /// \brief Gets the device of \p stream.
+    hipError_t get_device(const hipStream_t stream, int& device)
+    {
+        return detail::get_device_from_stream(stream, device);
+    }
+
+    /// \brief Allocates \p bytes bytes on \p device.
+    hipError_t allocate(const int device, void** ptr, const size_t bytes)
+    {
+        int        previous_device;
+        hipError_t result = hipGetDevice(&previous_device);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        if(previous_device == device)
+        {
+            return hipMalloc(ptr, bytes);
+        }
+
+        result = hipSetDevice(device);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        result                         = hipMalloc(ptr, bytes);
+        const hipError_t device_result = hipSetDevice(previous_device);
+        return result != hipSuccess ? result : device_result;
+    }
+
+    /// \brief Frees \p ptr, which was allocated on \p device.
+    hipError_t deallocate(const int device, void* ptr)
+    {
+        static_cast<void>(device);
+        return hipFree(ptr);
+    }
+};
+
+/// \brief Allocator that caches freed blocks of device memory for later allocations.
+///
+/// Allocations are rounded up to size bins: bin \p i holds blocks of
+/// <tt>bin_growth^i</tt> bytes. A freed block is kept in the free list of its bin, of its device
+/// and of the stream it was allocated for. A later allocation for the same device, stream and
+/// bin reuses it without a call to the backend: the work on a stream runs in order, so the new
+/// user of the block runs after its previous user has finished. Blocks are never shared between
+/// streams.
+///
+/// Allocations larger than the largest bin are not cached, they are allocated and freed by the
+/// backend directly. Freed blocks that would grow the cache over \p max_cached_bytes are freed
+/// as well. Freeing with \p hipFree synchronizes the device, so \p mem_pool_allocator should be
+/// preferred on platforms with memory pools.
+///
+/// All member functions are thread-safe.
+///
+/// \tparam Backend - provides the uncached allocations, see \p hip_device_allocator_backend.
+template<class Backend = hip_device_allocator_backend>
+class caching_device_allocator
+{
+public:
+    /// \brief Creates an empty cache.
+    ///
+    /// \param bin_growth - ratio of the sizes of consecutive bins, at least 2.
+    /// \param min_bin - the smallest bin, smaller allocations use it.
+    /// \param max_bin - the largest bin, larger allocations are not cached.
+    /// \param max_cached_bytes - limit on the total size of the cached blocks of a device.
+    /// \param backend - the backend of the uncached allocations.
+    explicit caching_device_allocator(const unsigned int bin_growth       = 8,
+                                      const unsigned int min_bin          = 3,
+                                      const unsigned int max_bin          = 7,
+                                      const size_t       max_cached_bytes = size_t{6} << 20,
+                                      Backend            backend          = Backend())
+        : backend_(std::move(backend))
+        , bin_growth_(std::max(bin_growth, 2u))
+        , min_bin_(min_bin)
+        , max_bin_(std::max(min_bin, max_bin))
+        , max_cached_bytes_(max_cached_bytes)
+    {}
+
+    caching_device_allocator(const caching_device_allocator&)            = delete;
+    caching_device_allocator& operator=(const caching_device_allocator&) = delete;
+
+    /// \brief Frees the cached blocks. Blocks that are still allocated are not freed.
+    ~caching_device_allocator()
+    {
+        static_cast<void>(release_cached());
+    }
+
+    /// \brief Allocates at least \p bytes bytes for the work on \p stream.
+    hipError_t allocate(void** ptr, const size_t bytes, const hipStream_t stream)
+    {
+        int        device;
+        hipError_t result = backend_.get_device(stream, device);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+
+        unsigned int bin;
+        size_t       bin_bytes;
+        const bool   cached = get_bin(bytes, bin, bin_bytes);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(cached)
+        {
+            auto free_list = free_lists_.find(make_key(device, stream, bin));
+            if(free_list != free_lists_.end() && !free_list->second.empty())
+            {
+                *ptr = free_list->second.back();
+                free_list->second.pop_back();
+                cached_bytes_[device] -= bin_bytes;
+                live_blocks_.emplace(*ptr, block{device, stream, bin, bin_bytes});
+                return hipSuccess;
+            }
+        }
+
+        result = backend_.allocate(device, ptr, bin_bytes);
+        if(result != hipSuccess)
+        {
+            // Free the cached blocks of the device and retry once
+            result = release_cached(device);
+            if(result != hipSuccess)
+            {
+                return result;
+            }
+            result = backend_.allocate(device, ptr, bin_bytes);
+            if(result != hipSuccess)
+            {
+                return result;
+            }
+        }
+        live_blocks_.emplace(*ptr, block{device, stream, cached ? bin : uncached_bin, bin_bytes});
+        return hipSuccess;
+    }
+
+    /// \brief Returns \p ptr to the cache. \p stream must be the stream of the allocation.
+    hipError_t deallocate(void* ptr, const hipStream_t stream)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const auto live_block = live_blocks_.find(ptr);
+        if(live_block == live_blocks_.end() || live_block->second.stream != stream)
+        {
+            return hipErrorInvalidValue;
+        }
+        const block freed = live_block->second;
+        live_blocks_.erase(live_block);
+
+        if(freed.bin == uncached_bin
+           || cached_bytes_[freed.device] + freed.bytes > max_cached_bytes_)
+        {
+            return backend_.deallocate(freed.device, ptr);
+        }
+        free_lists_[make_key(freed.device, freed.stream, freed.bin)].push_back(ptr);
+        cached_bytes_[freed.device] += freed.bytes;
+        return hipSuccess;
+    }
+
+    /// \brief Frees all cached blocks with the backend.
+    hipError_t release_cached()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        hipError_t result = hipSuccess;
+        for(auto& free_list : free_lists_)
+        {
+            const int device = std::get<0>(free_list.first);
+            for(void* ptr : free_list.second)
+            {
+                const hipError_t free_result = backend_.deallocate(device, ptr);
+                result = result != hipSuccess ? result : free_result;
+            }
+        }
+        free_lists_.clear();
+        cached_bytes_.clear();
+        return result;
+    }
+
+    /// \brief Total size of the cached (allocated but unused) blocks of \p device.
+    size_t cached_bytes(const int device) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const auto bytes = cached_bytes_.find(device);
+        return bytes != cached_bytes_.end() ? bytes->second : 0;
+    }
+
+    /// \brief Number of blocks that are allocated and not yet deallocated.
+    size_t live_blocks() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return live_blocks_.size();
+    }
+
+    /// \brief The backend of the uncached allocations.
+    Backend& backend() noexcept
+    {
+        return backend_;
+    }
+
+private:
+    static constexpr unsigned int uncached_bin = static_cast<unsigned int>(-1);
+
+    struct block
+    {
+        int          device;
+        hipStream_t  stream;
+        unsigned int bin;
+        size_t       bytes;
+    };
+
+    using free_list_key = std::tuple<int, std::uintptr_t, unsigned int>;
+
+    static free_list_key
+        make_key(const int device, const hipStream_t stream, const unsigned int bin)
+    {
+        return free_list_key(device, reinterpret_cast<std::uintptr_t>(stream), bin);
+    }
+
+    // Returns false if the allocation is too large to be cached, it is not rounded up then
+    bool get_bin(const size_t bytes, unsigned int& bin, size_t& bin_bytes) const
+    {
+        bin       = 0;
+        bin_bytes = 1;
+        while(bin < min_bin_ || bin_bytes < bytes)
+        {
+            if(bin == max_bin_)
+            {
+                bin_bytes = bytes;
+                return false;
+            }
+            bin_bytes *= bin_growth_;
+            ++bin;
+        }
+        return true;
+    }
+
+    // Frees the cached blocks of a device, mutex_ must be locked
+    hipError_t release_cached(const int device)
+    {
+        hipError_t result = hipSuccess;
+        for(auto& free_list : free_lists_)
+        {
+            if(std::get<0>(free_list.first) != device)
+            {
+                continue;
+            }
+            for(void* ptr : free_list.second)
+            {
+                const hipError_t free_result = backend_.deallocate(device, ptr);
+                result = result != hipSuccess ? result : free_result;
+            }
+            free_list.second.clear();
+        }
+        cached_bytes_[device] = 0;
+        return result;
+    }
+
+    Backend            backend_;
+    const unsigned int bin_growth_;
+    const unsigned int min_bin_;
+    const unsigned int max_bin_;
+    const size_t       max_cached_bytes_;
+
+    mutable std::mutex                          mutex_;
+    std::map<free_list_key, std::vector<void*>> free_lists_;
+    std::unordered_map<void*, block>            live_blocks_;
+    std::map<int, size_t>                       cached_bytes_;
+};
+
+/// \brief Runs a device-level algorithm with temporary storage from \p allocator.
+///
+/// \p function is called twice, the same way as the device-level algorithms are called:
+/// <tt>function(nullptr, storage_size)</tt> to get the size of the temporary storage, then
+/// <tt>function(temporary_storage, storage_size)</tt> to run the algorithm. The storage is
+/// allocated for \p stream before the second call and deallocated after it, both in stream order
+/// if the allocator is stream-ordered.
+///
+/// \param allocator - the allocator, e.g. \p mem_pool_allocator or \p caching_device_allocator.
+/// \param stream - the stream of the algorithm.
+/// \param function - calls the algorithm with the given temporary storage.
+/// \returns the first error of the calls and the allocation, \p hipSuccess (\p 0) if none.
+///
+/// \par Example
+/// \parblock
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// rocprim::caching_device_allocator<> allocator;
+/// rocprim::with_temporary_storage(
+///     allocator,
+///     stream,
+///     [&](void* temporary_storage, size_t& storage_size)
+///     {
+///         return rocprim::radix_sort_keys(temporary_storage, storage_size,
+///                                         input, output, input_size,
+///                                         0, 32, stream);
+///     });
+/// \endcode
+/// \endparblock
+template<class Allocator, class Function>
+hipError_t
+    with_temporary_storage(Allocator& allocator, const hipStream_t stream, Function&& function)
+{
+    size_t     storage_size = 0;
+    hipError_t result       = function(nullptr, storage_size);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    // A null pointer would only query the size again
+    void* temporary_storage = nullptr;
+    result = allocator.allocate(&temporary_storage, std::max<size_t>(storage_size, 1), stream);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    result = function(temporary_storage, storage_size);
+
+    const hipError_t free_result = allocator.deallocate(temporary_storage, stream);
+    return result != hipSuccess ? result : free_result;
+}
+
+/// \brief Runs a device-level algorithm with temporary storage allocated stream-ordered from
+/// \p pool, see \p mem_pool_allocator. If \p pool is \p nullptr, the default memory pool of the
+/// device is used.
+template<class Function>
+hipError_t
+    with_temporary_storage(const hipMemPool_t pool, const hipStream_t stream, Function&& function)
+{
+    mem_pool_allocator allocator(pool);
+    return with_temporary_storage(allocator, stream, std::forward<Function>(function));
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_ALLOCATOR_HPP_
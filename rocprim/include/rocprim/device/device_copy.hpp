@@ -26,6 +26,8 @@
 
 #include "config_types.hpp"
 
+#include "../iterator/transform_iterator.hpp"
+
 #include "detail/device_batch_memcpy.hpp"
 #include "device_copy_config.hpp"
 #include "rocprim/device/detail/device_config_helper.hpp"
@@ -145,6 +147,70 @@ ROCPRIM_INLINE static hipError_t batch_copy(void*              temporary_storage
             debug_synchronous);
 }
 
+/// \brief Set `sizes[i]` items starting at `destinations[i]` to `values[i]` for all `i` in the
+/// range [0, `num_buffers`).
+///
+/// \tparam Config [optional] configuration of  the primitive. It has to be \p batch_copy_config .
+/// \tparam OutputBufferItType type of iterator to destination pointers.
+/// \tparam ValueItType type of iterator to values, they are converted to the item type of the
+/// destinations.
+/// \tparam BufferSizeItType type of iterator to sizes.
+///
+/// \param [in] temporary_storage pointer to device-accessible temporary storage.
+/// When a null pointer is passed, the required allocation size in bytes is written to
+/// `storage_size` and the function returns without performing the fill.
+/// \param [in, out] storage_size reference to the size in bytes of `temporary_storage`.
+/// \param [in] destinations iterator of destination pointers.
+/// \param [in] values iterator of the value of each buffer.
+/// \param [in] sizes iterator of buffer sizes in items.
+/// \param [in] num_buffers number of buffers to fill.
+/// \param [in] stream [optional] HIP stream object to enqueue the fill on. Default is `hipStreamDefault`.
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. The default value is `false`.
+///
+/// Performs multiple device fills as a single batched operation. Roughly equivalent to
+/// \code{.cpp}
+/// for (auto i = 0; i < num_buffers; ++i) {
+///     auto* dst = destinations[i];
+///     for (auto j = 0; j < sizes[i]; ++j)
+///     {
+///         dst[j] = values[i];
+///     }
+/// }
+/// \endcode
+/// except executed on the device in parallel. The buffers are balanced over threads, warps and
+/// blocks by size in the same way as in \p batch_copy. Overlapping destinations are not allowed,
+/// and will result in undefined behaviour.
+template<class Config_ = default_config,
+         class OutputBufferItType,
+         class ValueItType,
+         class BufferSizeItType>
+ROCPRIM_INLINE static hipError_t batch_fill(void*              temporary_storage,
+                                            size_t&            storage_size,
+                                            OutputBufferItType destinations,
+                                            ValueItType        values,
+                                            BufferSizeItType   sizes,
+                                            uint32_t           num_buffers,
+                                            hipStream_t        stream            = hipStreamDefault,
+                                            bool               debug_synchronous = false)
+{
+    using value_type = typename std::iterator_traits<
+        typename std::iterator_traits<OutputBufferItType>::value_type>::value_type;
+
+    const auto sources
+        = make_transform_iterator(values, detail::batch_memcpy::make_fill_source<value_type>{});
+    return detail::
+        batch_memcpy_func<Config_, decltype(sources), OutputBufferItType, BufferSizeItType, false>(
+            temporary_storage,
+            storage_size,
+            sources,
+            destinations,
+            sizes,
+            num_buffers,
+            stream,
+            debug_synchronous);
+}
+
 END_ROCPRIM_NAMESPACE
 
 #endif
@@ -0,0 +1,422 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_GATHER_SCATTER_HPP_
+#define ROCPRIM_DEVICE_DEVICE_GATHER_SCATTER_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../iterator/constant_iterator.hpp"
+
+#include "detail/device_gather_scatter.hpp"
+#include "device_gather_scatter_config.hpp"
+
+/// \addtogroup devicemodule
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+template<class Config, class InputIterator, class IndexIterator, class OutputIterator>
+ROCPRIM_KERNEL
+    __launch_bounds__(device_params<Config>().kernel_config.block_size) void gather_kernel(
+        InputIterator input, IndexIterator indices, OutputIterator output, const size_t size)
+{
+    gather_kernel_impl<Config>(input, indices, output, size);
+}
+
+template<bool WithFlags,
+         class Config,
+         class InputIterator,
+         class IndexIterator,
+         class FlagIterator,
+         class OutputIterator>
+ROCPRIM_KERNEL
+    __launch_bounds__(device_params<Config>().kernel_config.block_size) void scatter_kernel(
+        InputIterator  input,
+        IndexIterator  indices,
+        FlagIterator   flags,
+        OutputIterator output,
+        const size_t   size)
+{
+    scatter_kernel_impl<WithFlags, Config>(input, indices, flags, output, size);
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
+    { \
+        auto _error = hipGetLastError(); \
+        if(_error != hipSuccess) return _error; \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            _error = hipStreamSynchronize(stream); \
+            if(_error != hipSuccess) return _error; \
+            auto _end = std::chrono::high_resolution_clock::now(); \
+            auto _d = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+template<class Config, class InputIterator, class IndexIterator, class OutputIterator>
+inline hipError_t gather_impl(InputIterator     input,
+                              IndexIterator     indices,
+                              OutputIterator    output,
+                              const size_t      size,
+                              const hipStream_t stream,
+                              bool              debug_synchronous)
+{
+    if(size == size_t(0))
+        return hipSuccess;
+
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    using config = wrapped_gather_config<Config, value_type>;
+
+    target_arch target_arch;
+    hipError_t  result = host_target_arch(stream, target_arch);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    const gather_scatter_config_params params = dispatch_target_arch<config>(target_arch);
+
+    const unsigned int block_size       = params.kernel_config.block_size;
+    const unsigned int items_per_thread = params.kernel_config.items_per_thread;
+    const auto         items_per_block  = block_size * items_per_thread;
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+
+    const auto size_limit             = params.kernel_config.size_limit;
+    const auto number_of_blocks_limit = ::rocprim::max<size_t>(size_limit / items_per_block, 1);
+    const auto aligned_size_limit     = number_of_blocks_limit * items_per_block;
+
+    // Launch number_of_blocks_limit blocks while there is still at least as many blocks left as the limit
+    const auto number_of_launch = (size + aligned_size_limit - 1) / aligned_size_limit;
+    for(size_t i = 0, offset = 0; i < number_of_launch; ++i, offset += aligned_size_limit)
+    {
+        const auto current_size   = std::min(size - offset, aligned_size_limit);
+        const auto current_blocks = (current_size + items_per_block - 1) / items_per_block;
+
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(gather_kernel<config>),
+                           dim3(current_blocks),
+                           dim3(block_size),
+                           0,
+                           stream,
+                           input,
+                           indices + offset,
+                           output + offset,
+                           current_size);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("gather_kernel", current_size, start);
+    }
+
+    return hipSuccess;
+}
+
+template<bool WithFlags,
+         class Config,
+         class InputIterator,
+         class IndexIterator,
+         class FlagIterator,
+         class OutputIterator>
+inline hipError_t scatter_impl(InputIterator     input,
+                               IndexIterator     indices,
+                               FlagIterator      flags,
+                               OutputIterator    output,
+                               const size_t      size,
+                               const hipStream_t stream,
+                               bool              debug_synchronous)
+{
+    if(size == size_t(0))
+        return hipSuccess;
+
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    using config = wrapped_scatter_config<Config, value_type>;
+
+    target_arch target_arch;
+    hipError_t  result = host_target_arch(stream, target_arch);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    const gather_scatter_config_params params = dispatch_target_arch<config>(target_arch);
+
+    const unsigned int block_size       = params.kernel_config.block_size;
+    const unsigned int items_per_thread = params.kernel_config.items_per_thread;
+    const auto         items_per_block  = block_size * items_per_thread;
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+
+    const auto size_limit             = params.kernel_config.size_limit;
+    const auto number_of_blocks_limit = ::rocprim::max<size_t>(size_limit / items_per_block, 1);
+    const auto aligned_size_limit     = number_of_blocks_limit * items_per_block;
+
+    // Launch number_of_blocks_limit blocks while there is still at least as many blocks left as the limit
+    const auto number_of_launch = (size + aligned_size_limit - 1) / aligned_size_limit;
+    for(size_t i = 0, offset = 0; i < number_of_launch; ++i, offset += aligned_size_limit)
+    {
+        const auto current_size   = std::min(size - offset, aligned_size_limit);
+        const auto current_blocks = (current_size + items_per_block - 1) / items_per_block;
+
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(scatter_kernel<WithFlags, config>),
+                           dim3(current_blocks),
+                           dim3(block_size),
+                           0,
+                           stream,
+                           input + offset,
+                           indices + offset,
+                           flags + offset,
+                           output,
+                           current_size);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("scatter_kernel", current_size, start);
+    }
+
+    return hipSuccess;
+}
+
+} // end of detail namespace
+
+/// \brief Parallel gather primitive for device level.
+///
+/// gather function copies the values of \p input selected by \p indices to \p output:
+/// <tt>output[i] = input[indices[i]]</tt>.
+///
+/// \par Overview
+/// * Ranges specified by \p indices and \p output must have at least \p size elements.
+/// * The indices must be valid positions in the range specified by \p input.
+/// * With run detection enabled in the config (the default), a thread that reads consecutive
+/// indices copies its values as one contiguous range, using vector loads when \p input is
+/// a pointer aligned for them. This speeds up (nearly) sorted indices. Run detection can be
+/// disabled with \p gather_config if the indices are known to be random.
+///
+/// \tparam Config - [optional] configuration of the primitive. It has to be \p gather_config.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam IndexIterator - random-access iterator type of the index range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// Its value type must be an integral type.
+/// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] input - iterator to the first element in the range to gather from.
+/// \param [in] indices - iterator to the first element in the range of indices.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [in] size - number of elements in the index range.
+/// \param [in] stream - [optional] HIP stream object. The default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. The default value is \p false.
+///
+/// \par Example
+/// \parblock
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t size;      // e.g., 6
+/// float* input;     // e.g., [0.5, 1.5, 2.5, 3.5]
+/// int*   indices;   // e.g., [3, 0, 1, 2, 2, 0]
+/// float* output;    // empty array of 6 elements
+///
+/// // perform gather
+/// rocprim::gather(input, indices, output, size);
+/// // output: [3.5, 0.5, 1.5, 2.5, 2.5, 0.5]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputIterator,
+         class IndexIterator,
+         class OutputIterator>
+inline hipError_t gather(InputIterator     input,
+                         IndexIterator     indices,
+                         OutputIterator    output,
+                         const size_t      size,
+                         const hipStream_t stream            = 0,
+                         bool              debug_synchronous = false)
+{
+    return detail::gather_impl<Config>(input,
+                                       indices,
+                                       output,
+                                       size,
+                                       stream,
+                                       debug_synchronous);
+}
+
+/// \brief Parallel scatter primitive for device level.
+///
+/// scatter function copies the values of \p input to the positions of \p output selected by
+/// \p indices: <tt>output[indices[i]] = input[i]</tt>.
+///
+/// \par Overview
+/// * Ranges specified by \p input and \p indices must have at least \p size elements.
+/// * The indices must be valid positions in the range specified by \p output. If an index
+/// appears more than once, it is unspecified which of its values is written.
+/// * With run detection enabled in the config (the default), a thread that writes to
+/// consecutive indices stores its values as one contiguous range, using vector stores when
+/// \p output is a pointer aligned for them. This speeds up (nearly) sorted indices. Run
+/// detection can be disabled with \p scatter_config if the indices are known to be random.
+///
+/// \tparam Config - [optional] configuration of the primitive. It has to be \p scatter_config.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam IndexIterator - random-access iterator type of the index range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// Its value type must be an integral type.
+/// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] input - iterator to the first element in the range to scatter.
+/// \param [in] indices - iterator to the first element in the range of indices.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [in] size - number of elements in the input range.
+/// \param [in] stream - [optional] HIP stream object. The default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. The default value is \p false.
+///
+/// \par Example
+/// \parblock
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t size;      // e.g., 4
+/// float* input;     // e.g., [0.5, 1.5, 2.5, 3.5]
+/// int*   indices;   // e.g., [3, 0, 1, 2]
+/// float* output;    // empty array of 4 elements
+///
+/// // perform scatter
+/// rocprim::scatter(input, indices, output, size);
+/// // output: [1.5, 2.5, 3.5, 0.5]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputIterator,
+         class IndexIterator,
+         class OutputIterator>
+inline hipError_t scatter(InputIterator     input,
+                          IndexIterator     indices,
+                          OutputIterator    output,
+                          const size_t      size,
+                          const hipStream_t stream            = 0,
+                          bool              debug_synchronous = false)
+{
+    return detail::scatter_impl<false, Config>(input,
+                                               indices,
+                                               ::rocprim::constant_iterator<bool>(true),
+                                               output,
+                                               size,
+                                               stream,
+                                               debug_synchronous);
+}
+
+/// \brief Parallel conditional scatter primitive for device level.
+///
+/// scatter_if function copies the values of \p input whose flag is set to the positions of
+/// \p output selected by \p indices: <tt>if(flags[i]) output[indices[i]] = input[i]</tt>.
+/// The positions of \p output that are not selected by any set flag are not modified.
+///
+/// \par Overview
+/// * Ranges specified by \p input, \p indices and \p flags must have at least \p size elements.
+/// * The indices whose flag is set must be valid positions in the range specified by \p output.
+/// If such an index appears more than once, it is unspecified which of its values is written.
+/// * Run detection works as in \p scatter, a run is only stored as a whole if all its flags
+/// are set.
+///
+/// \tparam Config - [optional] configuration of the primitive. It has to be \p scatter_config.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam IndexIterator - random-access iterator type of the index range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// Its value type must be an integral type.
+/// \tparam FlagIterator - random-access iterator type of the flag range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// Its value type must be convertible to \p bool.
+/// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] input - iterator to the first element in the range to scatter.
+/// \param [in] indices - iterator to the first element in the range of indices.
+/// \param [in] flags - iterator to the first element in the range of flags.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [in] size - number of elements in the input range.
+/// \param [in] stream - [optional] HIP stream object. The default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. The default value is \p false.
+///
+/// \par Example
+/// \parblock
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t size;      // e.g., 4
+/// float* input;     // e.g., [0.5, 1.5, 2.5, 3.5]
+/// int*   indices;   // e.g., [3, 0, 1, 2]
+/// char*  flags;     // e.g., [1, 0, 1, 0]
+/// float* output;    // e.g., [9.0, 9.0, 9.0, 9.0]
+///
+/// // perform scatter
+/// rocprim::scatter_if(input, indices, flags, output, size);
+/// // output: [9.0, 2.5, 9.0, 0.5]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputIterator,
+         class IndexIterator,
+         class FlagIterator,
+         class OutputIterator>
+inline hipError_t scatter_if(InputIterator     input,
+                             IndexIterator     indices,
+                             FlagIterator      flags,
+                             OutputIterator    output,
+                             const size_t      size,
+                             const hipStream_t stream            = 0,
+                             bool              debug_synchronous = false)
+{
+    return detail::scatter_impl<true, Config>(input,
+                                              indices,
+                                              flags,
+                                              output,
+                                              size,
+                                              stream,
+                                              debug_synchronous);
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group devicemodule
+
+#endif // ROCPRIM_DEVICE_DEVICE_GATHER_SCATTER_HPP_
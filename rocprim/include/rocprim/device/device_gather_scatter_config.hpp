@@ -0,0 +1,123 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_GATHER_SCATTER_CONFIG_HPP_
+#define ROCPRIM_DEVICE_DEVICE_GATHER_SCATTER_CONFIG_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+#include "detail/config/device_gather.hpp"
+#include "detail/config/device_scatter.hpp"
+#include "detail/device_config_helper.hpp"
+
+/// \addtogroup primitivesmodule_deviceconfigs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Specialization for user provided configuration
+template<typename GatherConfig, typename>
+struct wrapped_gather_config
+{
+    static_assert(std::is_same<typename GatherConfig::tag, gather_config_tag>::value,
+                  "Config must be a specialization of struct template gather_config");
+
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        static constexpr gather_scatter_config_params params = GatherConfig{};
+    };
+};
+
+// Specialization for selecting the default configuration
+template<typename Value>
+struct wrapped_gather_config<default_config, Value>
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        static constexpr gather_scatter_config_params params
+            = default_gather_config<static_cast<unsigned int>(Arch), Value>{};
+    };
+};
+
+// Specialization for user provided configuration
+template<typename ScatterConfig, typename>
+struct wrapped_scatter_config
+{
+    static_assert(std::is_same<typename ScatterConfig::tag, scatter_config_tag>::value,
+                  "Config must be a specialization of struct template scatter_config");
+
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        static constexpr gather_scatter_config_params params = ScatterConfig{};
+    };
+};
+
+// Specialization for selecting the default configuration
+template<typename Value>
+struct wrapped_scatter_config<default_config, Value>
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        static constexpr gather_scatter_config_params params
+            = default_scatter_config<static_cast<unsigned int>(Arch), Value>{};
+    };
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template<typename GatherConfig, typename Value>
+template<target_arch Arch>
+constexpr gather_scatter_config_params
+    wrapped_gather_config<GatherConfig, Value>::architecture_config<Arch>::params;
+
+template<typename Value>
+template<target_arch Arch>
+constexpr gather_scatter_config_params
+    wrapped_gather_config<default_config, Value>::architecture_config<Arch>::params;
+
+template<typename ScatterConfig, typename Value>
+template<target_arch Arch>
+constexpr gather_scatter_config_params
+    wrapped_scatter_config<ScatterConfig, Value>::architecture_config<Arch>::params;
+
+template<typename Value>
+template<target_arch Arch>
+constexpr gather_scatter_config_params
+    wrapped_scatter_config<default_config, Value>::architecture_config<Arch>::params;
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+} // namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group primitivesmodule_deviceconfigs
+
+#endif // ROCPRIM_DEVICE_DEVICE_GATHER_SCATTER_CONFIG_HPP_
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -24,14 +24,20 @@
 #include <cmath>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <type_traits>
 
 #include "../config.hpp"
 #include "../detail/various.hpp"
 #include "../functional.hpp"
 
+#include "../detail/temp_storage.hpp"
+
 #include "detail/device_histogram.hpp"
 #include "device_histogram_config.hpp"
+#include "device_radix_sort.hpp"
+#include "device_run_length_encode.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -57,58 +63,73 @@ template<class Config,
          unsigned int Channels,
          unsigned int ActiveChannels,
          class SampleIterator,
+         class WeightIterator,
          class Counter,
          class SampleToBinOp>
 ROCPRIM_KERNEL __launch_bounds__(
     device_params<Config>()
         .histogram_config
         .block_size) void histogram_shared_kernel(SampleIterator samples,
+                                                  WeightIterator weights,
                                                   unsigned int   columns,
                                                   unsigned int   rows,
                                                   unsigned int   row_stride,
                                                   unsigned int   rows_per_block,
                                                   unsigned int   shared_histograms,
+                                                  unsigned int   bins_per_pass,
                                                   fixed_array<Counter*, ActiveChannels> histogram,
                                                   fixed_array<SampleToBinOp, ActiveChannels>
                                                       sample_to_bin_op,
-                                                  fixed_array<unsigned int, ActiveChannels> bins)
+                                                  fixed_array<unsigned int, ActiveChannels> bins,
+                                                  histogram_instrumentation instrumentation)
 {
     static constexpr histogram_config_params params = device_params<Config>();
 
-    HIP_DYNAMIC_SHARED(unsigned int, block_histogram);
+    using accumulator_type
+        = histogram_accumulator_t<Counter, is_histogram_weighted<WeightIterator>::value>;
+
+    // Declared with the widest accumulator type for its alignment
+    HIP_DYNAMIC_SHARED(unsigned long long, block_histogram_storage);
+    accumulator_type* block_histogram = reinterpret_cast<accumulator_type*>(block_histogram_storage);
 
     histogram_shared<params.histogram_config.block_size,
                      params.histogram_config.items_per_thread,
                      Channels,
                      ActiveChannels>(samples,
+                                     weights,
                                      columns,
                                      rows,
                                      row_stride,
                                      rows_per_block,
                                      shared_histograms,
+                                     bins_per_pass,
                                      histogram,
                                      sample_to_bin_op,
                                      bins,
-                                     block_histogram);
+                                     block_histogram,
+                                     instrumentation);
 }
 
 template<class Config,
          unsigned int Channels,
          unsigned int ActiveChannels,
          class SampleIterator,
+         class WeightIterator,
          class Counter,
          class SampleToBinOp>
 ROCPRIM_KERNEL __launch_bounds__(
     device_params<Config>()
         .histogram_config
         .block_size) void histogram_global_kernel(SampleIterator                        samples,
+                                                  WeightIterator                        weights,
                                                   unsigned int                          columns,
                                                   unsigned int                          row_stride,
                                                   fixed_array<Counter*, ActiveChannels> histogram,
                                                   fixed_array<SampleToBinOp, ActiveChannels>
                                                       sample_to_bin_op,
                                                   fixed_array<unsigned int, ActiveChannels>
-                                                      bins_bits)
+                                                      bins_bits,
+                                                  histogram_instrumentation instrumentation)
 {
     static constexpr histogram_config_params params = device_params<Config>();
 
@@ -116,11 +137,100 @@ ROCPRIM_KERNEL __launch_bounds__(
                      params.histogram_config.items_per_thread,
                      Channels,
                      ActiveChannels>(samples,
+                                     weights,
                                      columns,
                                      row_stride,
                                      histogram,
                                      sample_to_bin_op,
-                                     bins_bits);
+                                     bins_bits,
+                                     instrumentation);
+}
+
+template<class Config,
+         unsigned int Channels,
+         unsigned int ActiveChannels,
+         class SampleIterator,
+         class SampleToBinOp>
+ROCPRIM_KERNEL __launch_bounds__(
+    device_params<Config>()
+        .histogram_config
+        .block_size) void histogram_sort_keys_kernel(SampleIterator samples,
+                                                     unsigned int   columns,
+                                                     unsigned int   row_stride,
+                                                     fixed_array<SampleToBinOp, ActiveChannels>
+                                                         sample_to_bin_op,
+                                                     fixed_array<unsigned int, ActiveChannels> bins,
+                                                     unsigned int*                             keys)
+{
+    static constexpr histogram_config_params params = device_params<Config>();
+
+    histogram_sort_keys<params.histogram_config.block_size,
+                        params.histogram_config.items_per_thread,
+                        Channels,
+                        ActiveChannels>(samples,
+                                        columns,
+                                        row_stride,
+                                        sample_to_bin_op,
+                                        bins,
+                                        keys);
+}
+
+template<class Config, unsigned int ActiveChannels, class Counter>
+ROCPRIM_KERNEL __launch_bounds__(
+    device_params<Config>()
+        .histogram_config
+        .block_size) void histogram_sort_scatter_kernel(const unsigned int* unique_bins,
+                                                        const unsigned int* counts,
+                                                        const unsigned int* runs_count,
+                                                        fixed_array<Counter*, ActiveChannels>
+                                                            histogram,
+                                                        fixed_array<unsigned int, ActiveChannels>
+                                                            bins)
+{
+    static constexpr histogram_config_params params = device_params<Config>();
+
+    histogram_sort_scatter<params.histogram_config.block_size, ActiveChannels>(unique_bins,
+                                                                               counts,
+                                                                               runs_count,
+                                                                               histogram,
+                                                                               bins);
+}
+
+template<class Config,
+         unsigned int Channels,
+         unsigned int Dimensions,
+         class SampleIterator,
+         class Counter,
+         class SampleToBinOp>
+ROCPRIM_KERNEL __launch_bounds__(
+    device_params<Config>()
+        .histogram_config
+        .block_size) void histogram_nd_kernel(SampleIterator samples,
+                                              unsigned int   size,
+                                              Counter*       histogram,
+                                              fixed_array<SampleToBinOp, Dimensions>
+                                                  sample_to_bin_op,
+                                              fixed_array<unsigned int, Dimensions> bins,
+                                              unsigned int                          shared_bins,
+                                              bool                                  privatize_all,
+                                              histogram_instrumentation instrumentation)
+{
+    static constexpr histogram_config_params params = device_params<Config>();
+
+    HIP_DYNAMIC_SHARED(unsigned long long, block_histogram_storage);
+
+    histogram_nd<params.histogram_config.block_size,
+                 params.histogram_config.items_per_thread,
+                 Channels,
+                 Dimensions>(samples,
+                             size,
+                             histogram,
+                             sample_to_bin_op,
+                             bins,
+                             shared_bins,
+                             privatize_all,
+                             reinterpret_cast<unsigned int*>(block_histogram_storage),
+                             instrumentation);
 }
 
 #define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
@@ -145,7 +255,8 @@ template<unsigned int Channels,
          class Config,
          class SampleIterator,
          class Counter,
-         class SampleToBinOp>
+         class SampleToBinOp,
+         class WeightIterator = histogram_unweighted>
 inline hipError_t histogram_impl(void*          temporary_storage,
                                  size_t&        storage_size,
                                  SampleIterator samples,
@@ -156,9 +267,12 @@ inline hipError_t histogram_impl(void*          temporary_storage,
                                  unsigned int   levels[ActiveChannels],
                                  SampleToBinOp  sample_to_bin_op[ActiveChannels],
                                  hipStream_t    stream,
-                                 bool           debug_synchronous)
+                                 bool           debug_synchronous,
+                                 WeightIterator weights = WeightIterator())
 {
     using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
+    using accumulator_type
+        = histogram_accumulator_t<Counter, is_histogram_weighted<WeightIterator>::value>;
 
     using config = wrapped_histogram_config<Config, sample_type, Channels, ActiveChannels>;
 
@@ -184,19 +298,112 @@ inline hipError_t histogram_impl(void*          temporary_storage,
     const unsigned int blocks_x   = ::rocprim::detail::ceiling_div(columns, items_per_block);
     const unsigned int row_stride = row_stride_bytes / sizeof(sample_type);
 
-    if(temporary_storage == nullptr)
+    unsigned int bins[ActiveChannels];
+    unsigned int bins_bits[ActiveChannels];
+    unsigned int total_bins = 0;
+    unsigned int max_bins   = 0;
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
     {
-        // Make sure user won't try to allocate 0 bytes memory, because
-        // hipMalloc will return nullptr.
-        storage_size = 4;
-        return hipSuccess;
+        bins[channel] = levels[channel] - 1;
+        bins_bits[channel]
+            = static_cast<unsigned int>(std::log2(detail::next_power_of_two(bins[channel])));
+        total_bins += bins[channel];
+        max_bins = std::max(max_bins, bins[channel]);
+    }
+
+    // Too many bins for shared memory: the atomics of the global memory implementation are
+    // slow if there are many samples. If the bins fit into shared memory in a few passes, every
+    // pass counts a range of the bins of every channel in shared memory, the samples are read
+    // once per pass. This needs no temporary storage.
+    const size_t       num_keys      = size_t(columns) * rows * ActiveChannels;
+    const unsigned int bins_per_pass = total_bins <= shared_impl_max_bins
+                                           ? max_bins
+                                           : shared_impl_max_bins / ActiveChannels;
+    const unsigned int bin_passes = bins_per_pass == 0
+                                        ? std::numeric_limits<unsigned int>::max()
+                                        : ::rocprim::detail::ceiling_div(max_bins, bins_per_pass);
+    const bool         use_shared_impl
+        = bin_passes == 1
+          || (bin_passes <= params.shared_impl_max_passes && num_keys >= total_bins);
+
+    // Otherwise sort the bins of the samples instead and count them with run length encode.
+    // run_length_encode supports up to UINT_MAX items. Weights are not supported by the
+    // sort-based implementation.
+    const bool use_sort_impl
+        = !use_shared_impl && !is_histogram_weighted<WeightIterator>::value
+          && num_keys >= params.sort_impl_min_samples && num_keys >= total_bins
+          && num_keys <= std::numeric_limits<unsigned int>::max();
+
+    // Keys of the samples: total_bins is used for samples outside of the histogram
+    const unsigned int sort_end_bit
+        = static_cast<unsigned int>(std::log2(detail::next_power_of_two(total_bins + 1)));
+    // Every bin and the out of range key form at most one run
+    const size_t max_runs = std::min(num_keys, size_t(total_bins) + 1);
+
+    size_t sort_storage_size = 0;
+    size_t rle_storage_size  = 0;
+    if(use_sort_impl)
+    {
+        result = ::rocprim::radix_sort_keys(nullptr,
+                                            sort_storage_size,
+                                            static_cast<unsigned int*>(nullptr),
+                                            static_cast<unsigned int*>(nullptr),
+                                            num_keys,
+                                            0,
+                                            sort_end_bit,
+                                            stream);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        result = ::rocprim::run_length_encode(nullptr,
+                                              rle_storage_size,
+                                              static_cast<unsigned int*>(nullptr),
+                                              static_cast<unsigned int>(num_keys),
+                                              static_cast<unsigned int*>(nullptr),
+                                              static_cast<unsigned int*>(nullptr),
+                                              static_cast<unsigned int*>(nullptr),
+                                              stream);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
     }
 
+    unsigned int* keys        = nullptr;
+    unsigned int* sorted_keys = nullptr;
+    unsigned int* unique_bins = nullptr;
+    unsigned int* run_counts  = nullptr;
+    unsigned int* runs_count  = nullptr;
+    void*         sort_storage;
+    void*         rle_storage;
+
+    result = detail::temp_storage::partition(
+        temporary_storage,
+        storage_size,
+        detail::temp_storage::make_linear_partition(
+            detail::temp_storage::ptr_aligned_array(&keys, use_sort_impl ? num_keys : 0),
+            detail::temp_storage::ptr_aligned_array(&sorted_keys, use_sort_impl ? num_keys : 0),
+            detail::temp_storage::ptr_aligned_array(&unique_bins, use_sort_impl ? max_runs : 0),
+            detail::temp_storage::ptr_aligned_array(&run_counts, use_sort_impl ? max_runs : 0),
+            detail::temp_storage::ptr_aligned_array(&runs_count, use_sort_impl ? 1 : 0),
+            detail::temp_storage::make_union_partition(
+                detail::temp_storage::make_partition(&sort_storage, sort_storage_size),
+                detail::temp_storage::make_partition(&rle_storage, rle_storage_size))));
+    if(result != hipSuccess || temporary_storage == nullptr)
+    {
+        return result;
+    }
+
+    trace_algorithm trace("histogram", storage_size, stream);
+
     if(debug_synchronous)
     {
         std::cout << "columns " << columns << '\n';
         std::cout << "rows " << rows << '\n';
         std::cout << "blocks_x " << blocks_x << '\n';
+        std::cout << "bin_passes " << (use_shared_impl ? bin_passes : 0) << '\n';
+        std::cout << "use_sort_impl " << use_sort_impl << '\n';
         hipError_t error = hipStreamSynchronize(stream);
         if(error != hipSuccess)
         {
@@ -204,19 +411,6 @@ inline hipError_t histogram_impl(void*          temporary_storage,
         }
     }
 
-    unsigned int bins[ActiveChannels];
-    unsigned int bins_bits[ActiveChannels];
-    unsigned int total_bins = 0;
-    unsigned int max_bins   = 0;
-    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
-    {
-        bins[channel] = levels[channel] - 1;
-        bins_bits[channel]
-            = static_cast<unsigned int>(std::log2(detail::next_power_of_two(bins[channel])));
-        total_bins += bins[channel];
-        max_bins = std::max(max_bins, bins[channel]);
-    }
-
     std::chrono::high_resolution_clock::time_point start;
 
     if(debug_synchronous)
@@ -231,13 +425,95 @@ inline hipError_t histogram_impl(void*          temporary_storage,
                        fixed_array<Counter*, ActiveChannels>(histogram),
                        fixed_array<unsigned int, ActiveChannels>(bins));
     ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_histogram", max_bins, start);
+    trace_kernel("init_histogram",
+                 max_bins,
+                 ::rocprim::detail::ceiling_div(max_bins, block_size),
+                 block_size,
+                 0);
 
     if(columns == 0 || rows == 0)
     {
         return hipSuccess;
     }
 
-    if(total_bins <= shared_impl_max_bins)
+    if(use_sort_impl)
+    {
+        if(debug_synchronous)
+        {
+            start = std::chrono::high_resolution_clock::now();
+        }
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(histogram_sort_keys_kernel<config, Channels, ActiveChannels>),
+            dim3(blocks_x, rows),
+            dim3(block_size, 1),
+            0,
+            stream,
+            samples,
+            columns,
+            row_stride,
+            fixed_array<SampleToBinOp, ActiveChannels>(sample_to_bin_op),
+            fixed_array<unsigned int, ActiveChannels>(bins),
+            keys);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_sort_keys", num_keys, start);
+        trace_kernel("histogram_sort_keys",
+                     num_keys,
+                     blocks_x * rows,
+                     block_size,
+                     items_per_thread);
+
+        result = ::rocprim::radix_sort_keys(sort_storage,
+                                            sort_storage_size,
+                                            keys,
+                                            sorted_keys,
+                                            num_keys,
+                                            0,
+                                            sort_end_bit,
+                                            stream,
+                                            debug_synchronous);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+
+        result = ::rocprim::run_length_encode(rle_storage,
+                                              rle_storage_size,
+                                              sorted_keys,
+                                              static_cast<unsigned int>(num_keys),
+                                              unique_bins,
+                                              run_counts,
+                                              runs_count,
+                                              stream,
+                                              debug_synchronous);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        // The sort and the run length encode are traced as algorithms of their own
+        restart_trace_timer();
+
+        if(debug_synchronous)
+        {
+            start = std::chrono::high_resolution_clock::now();
+        }
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(histogram_sort_scatter_kernel<config, ActiveChannels>),
+            dim3(::rocprim::detail::ceiling_div(max_runs, block_size)),
+            dim3(block_size),
+            0,
+            stream,
+            unique_bins,
+            run_counts,
+            runs_count,
+            fixed_array<Counter*, ActiveChannels>(histogram),
+            fixed_array<unsigned int, ActiveChannels>(bins));
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_sort_scatter", max_runs, start);
+        trace_kernel("histogram_sort_scatter",
+                     max_runs,
+                     ::rocprim::detail::ceiling_div(max_runs, block_size),
+                     block_size,
+                     0);
+    }
+    else if(use_shared_impl)
     {
         if(debug_synchronous)
         {
@@ -247,10 +523,17 @@ inline hipError_t histogram_impl(void*          temporary_storage,
                                                               Channels,
                                                               ActiveChannels,
                                                               SampleIterator,
+                                                              WeightIterator,
                                                               Counter,
                                                               SampleToBinOp>);
 
-        const size_t block_histogram_bytes = total_bins * sizeof(unsigned int);
+        // The first pass has the most bins
+        unsigned int pass_bins = 0;
+        for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+        {
+            pass_bins += std::min(bins[channel], bins_per_pass);
+        }
+        const size_t block_histogram_bytes = pass_bins * sizeof(accumulator_type);
 
         // Use up to shared_impl_histograms histograms in shared memory to reduce atomic conflicts
         // for the case of samples concentrated in one bin
@@ -289,12 +572,15 @@ inline hipError_t histogram_impl(void*          temporary_storage,
         {
             return error;
         }
-        const unsigned int chosen_grid_size
-            = std::min(static_cast<unsigned int>(min_grid_size), params.max_grid_size);
+        // The passes run concurrently, their blocks share the grid
+        const unsigned int chosen_grid_size = std::max(
+            std::min(static_cast<unsigned int>(min_grid_size), params.max_grid_size) / bin_passes,
+            1u);
 
         dim3 grid_size;
         grid_size.x = std::min(chosen_grid_size, blocks_x);
         grid_size.y = std::min(rows, ::rocprim::detail::ceiling_div(chosen_grid_size, grid_size.x));
+        grid_size.z = bin_passes;
         const unsigned int rows_per_block = ::rocprim::detail::ceiling_div(rows, grid_size.y);
         hipLaunchKernelGGL(kernel,
                            grid_size,
@@ -302,17 +588,26 @@ inline hipError_t histogram_impl(void*          temporary_storage,
                            chosen_shared_histograms * block_histogram_bytes,
                            stream,
                            samples,
+                           weights,
                            columns,
                            rows,
                            row_stride,
                            rows_per_block,
                            chosen_shared_histograms,
+                           bins_per_pass,
                            fixed_array<Counter*, ActiveChannels>(histogram),
                            fixed_array<SampleToBinOp, ActiveChannels>(sample_to_bin_op),
-                           fixed_array<unsigned int, ActiveChannels>(bins));
+                           fixed_array<unsigned int, ActiveChannels>(bins),
+                           histogram_instrumentation());
         ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_shared",
-                                                    grid_size.x * grid_size.y * block_size,
+                                                    grid_size.x * grid_size.y * grid_size.z
+                                                        * block_size,
                                                     start);
+        trace_kernel("histogram_shared",
+                     size_t(columns) * rows,
+                     grid_size.x * grid_size.y * grid_size.z,
+                     block_size,
+                     items_per_thread);
     }
     else
     {
@@ -327,14 +622,21 @@ inline hipError_t histogram_impl(void*          temporary_storage,
             0,
             stream,
             samples,
+            weights,
             columns,
             row_stride,
             fixed_array<Counter*, ActiveChannels>(histogram),
             fixed_array<SampleToBinOp, ActiveChannels>(sample_to_bin_op),
-            fixed_array<unsigned int, ActiveChannels>(bins_bits));
+            fixed_array<unsigned int, ActiveChannels>(bins_bits),
+            histogram_instrumentation());
         ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_global",
                                                     blocks_x * block_size * rows,
                                                     start);
+        trace_kernel("histogram_global",
+                     size_t(columns) * rows,
+                     blocks_x * rows,
+                     block_size,
+                     items_per_thread);
     }
 
     return hipSuccess;
@@ -345,7 +647,8 @@ template<unsigned int Channels,
          class Config,
          class SampleIterator,
          class Counter,
-         class Level>
+         class Level,
+         class WeightIterator = histogram_unweighted>
 inline hipError_t histogram_even_impl(void*          temporary_storage,
                                       size_t&        storage_size,
                                       SampleIterator samples,
@@ -357,7 +660,8 @@ inline hipError_t histogram_even_impl(void*          temporary_storage,
                                       Level          lower_level[ActiveChannels],
                                       Level          upper_level[ActiveChannels],
                                       hipStream_t    stream,
-                                      bool           debug_synchronous)
+                                      bool           debug_synchronous,
+                                      WeightIterator weights = WeightIterator())
 {
     for(unsigned int channel = 0; channel < ActiveChannels; channel++)
     {
@@ -386,7 +690,8 @@ inline hipError_t histogram_even_impl(void*          temporary_storage,
                                                             levels,
                                                             sample_to_bin_op,
                                                             stream,
-                                                            debug_synchronous);
+                                                            debug_synchronous,
+                                                            weights);
 }
 
 template<unsigned int Channels,
@@ -394,7 +699,8 @@ template<unsigned int Channels,
          class Config,
          class SampleIterator,
          class Counter,
-         class Level>
+         class Level,
+         class WeightIterator = histogram_unweighted>
 inline hipError_t histogram_range_impl(void*          temporary_storage,
                                        size_t&        storage_size,
                                        SampleIterator samples,
@@ -405,7 +711,8 @@ inline hipError_t histogram_range_impl(void*          temporary_storage,
                                        unsigned int   levels[ActiveChannels],
                                        Level*         level_values[ActiveChannels],
                                        hipStream_t    stream,
-                                       bool           debug_synchronous)
+                                       bool           debug_synchronous,
+                                       WeightIterator weights = WeightIterator())
 {
     for(unsigned int channel = 0; channel < ActiveChannels; channel++)
     {
@@ -433,7 +740,130 @@ inline hipError_t histogram_range_impl(void*          temporary_storage,
                                                             levels,
                                                             sample_to_bin_op,
                                                             stream,
-                                                            debug_synchronous);
+                                                            debug_synchronous,
+                                                            weights);
+}
+
+template<unsigned int Channels,
+         unsigned int Dimensions,
+         class Config,
+         class SampleIterator,
+         class Counter,
+         class Level>
+inline hipError_t histogram_nd_even_impl(void*          temporary_storage,
+                                         size_t&        storage_size,
+                                         SampleIterator samples,
+                                         unsigned int   size,
+                                         Counter*       histogram,
+                                         unsigned int   levels[Dimensions],
+                                         Level          lower_level[Dimensions],
+                                         Level          upper_level[Dimensions],
+                                         hipStream_t    stream,
+                                         bool           debug_synchronous)
+{
+    static_assert(Dimensions >= 1 && Dimensions <= Channels,
+                  "Dimensions must be in range [1, Channels]");
+
+    using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
+
+    using config = wrapped_histogram_config<Config, sample_type, Channels, Dimensions>;
+
+    detail::target_arch target_arch;
+    hipError_t          result = host_target_arch(stream, target_arch);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    const histogram_config_params params = dispatch_target_arch<config>(target_arch);
+
+    const unsigned int block_size      = params.histogram_config.block_size;
+    const unsigned int items_per_block = block_size * params.histogram_config.items_per_thread;
+
+    unsigned int              bins[Dimensions];
+    sample_to_bin_even<Level> sample_to_bin_op[Dimensions];
+    size_t                    total_bins = 1;
+    for(unsigned int dim = 0; dim < Dimensions; dim++)
+    {
+        if(levels[dim] < 2)
+        {
+            // Histogram must have at least 1 bin in every dimension
+            return hipErrorInvalidValue;
+        }
+        bins[dim] = levels[dim] - 1;
+        sample_to_bin_op[dim]
+            = sample_to_bin_even<Level>(bins[dim], lower_level[dim], upper_level[dim]);
+        total_bins *= bins[dim];
+    }
+
+    if(temporary_storage == nullptr)
+    {
+        // Make sure user won't try to allocate 0 bytes memory, because
+        // hipMalloc will return nullptr.
+        storage_size = 4;
+        return hipSuccess;
+    }
+
+    // Small joint histograms are privatized completely, larger ones per tile of pixels
+    // (bounding box of the tile's bins, up to shared_impl_max_bins)
+    const bool         privatize_all = total_bins <= params.shared_impl_max_bins;
+    const unsigned int shared_bins
+        = privatize_all ? static_cast<unsigned int>(total_bins) : params.shared_impl_max_bins;
+    const unsigned int number_of_tiles = ::rocprim::detail::ceiling_div(size, items_per_block);
+    const unsigned int grid_size
+        = privatize_all ? std::min(number_of_tiles, params.max_grid_size) : number_of_tiles;
+
+    if(debug_synchronous)
+    {
+        std::cout << "size " << size << '\n';
+        std::cout << "total_bins " << total_bins << '\n';
+        std::cout << "privatize_all " << privatize_all << '\n';
+        std::cout << "grid_size " << grid_size << '\n';
+        hipError_t error = hipStreamSynchronize(stream);
+        if(error != hipSuccess)
+        {
+            return error;
+        }
+    }
+
+    result = hipMemsetAsync(histogram, 0, total_bins * sizeof(Counter), stream);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    if(size == 0)
+    {
+        return hipSuccess;
+    }
+
+    trace_algorithm trace("histogram_nd_even", storage_size, stream);
+
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+    {
+        start = std::chrono::high_resolution_clock::now();
+    }
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(histogram_nd_kernel<config, Channels, Dimensions>),
+                       dim3(grid_size),
+                       dim3(block_size),
+                       shared_bins * sizeof(unsigned int),
+                       stream,
+                       samples,
+                       size,
+                       histogram,
+                       fixed_array<sample_to_bin_even<Level>, Dimensions>(sample_to_bin_op),
+                       fixed_array<unsigned int, Dimensions>(bins),
+                       shared_bins,
+                       privatize_all,
+                       histogram_instrumentation());
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_nd", size, start);
+    trace_kernel("histogram_nd",
+                 size,
+                 grid_size,
+                 block_size,
+                 params.histogram_config.items_per_thread);
+
+    return hipSuccess;
 }
 
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
@@ -446,6 +876,12 @@ inline hipError_t histogram_range_impl(void*          temporary_storage,
 /// * The number of histogram bins is (\p levels - 1).
 /// * Bins are evenly-segmented and include the same width of sample values:
 /// (\p upper_level - \p lower_level) / (\p levels - 1).
+/// * Bins that do not fit into shared memory are counted in shared memory in up to
+/// \p SharedImplMaxPasses passes over the samples (see \p histogram_config), without temporary
+/// storage.
+/// * The sort-based implementation is only used if it is enabled with the \p SortImplMinSamples
+/// parameter of \p histogram_config. It then needs about <tt>2 * size * sizeof(unsigned int)</tt>
+/// bytes of temporary storage in addition to the storage of \p radix_sort_keys.
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 ///
@@ -874,11 +1310,127 @@ inline hipError_t multi_histogram_even(void*          temporary_storage,
                                                                          debug_synchronous);
 }
 
+/// \brief Computes a joint (multi-dimensional) histogram from a sequence of multi-channel samples
+/// using equal-width bins in every dimension.
+///
+/// \par
+/// * The input is a sequence of <em>pixel</em> structures, where each pixel comprises
+/// a record of \p Channels consecutive data samples (e.g., \p Channels = 4 for <em>RGBA</em> samples).
+/// * The first \p Dimensions channels of a pixel select one bin of the joint histogram
+/// (e.g., \p Dimensions = 2 for (x, y) heatmaps or \p Dimensions = 3 for <em>RGB</em> color cubes).
+/// Pixels with a sample outside of the range of its dimension are not counted.
+/// * For dimension<sub><em>i</em></sub> the number of bins is (\p levels[i] - 1) and bins are
+/// evenly-segmented: (\p upper_level[i] - \p lower_level[i]) / (\p levels[i] - 1).
+/// * The histogram has the product of the bins of all dimensions as size and is stored in row-major
+/// order: the bin of the last dimension is contiguous.
+/// * Joint histograms that fit into shared memory (\p shared_impl_max_bins of \p histogram_config)
+/// are privatized per block. Larger ones are privatized per tile of pixels, only the bounding box of
+/// the bins of the tile is kept in shared memory, if it fits.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+///
+/// \tparam Channels - number of channels interleaved in the input samples.
+/// \tparam Dimensions - number of channels being used as dimensions of the histogram.
+/// \tparam Config - [optional] configuration of the primitive. It has to be \p histogram_config or a class derived from it.
+/// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam Counter - integer type for histogram bin counters.
+/// \tparam Level - type of histogram boundaries (levels)
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the reduction operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] samples - iterator to the first element in the range of input samples.
+/// \param [in] size - number of pixels in the samples range.
+/// \param [out] histogram - pointer to the first element in the joint histogram range.
+/// \param [in] levels - number of boundaries (levels) for histogram bins in each dimension.
+/// \param [in] lower_level - lower sample value bound (inclusive) for the first histogram bin in each dimension.
+/// \param [in] upper_level - upper sample value bound (exclusive) for the last histogram bin in each dimension.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful histogram operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a 2x3 heatmap is computed on an array of (x, y) float samples.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// unsigned int size;        // e.g., 5
+/// float * samples;          // e.g., [(0.5, 0.5), (1.5, 2.5), (1.2, 2.9), (0.1, 1.7), (5.0, 0.0)]
+/// int * histogram;          // empty array of at least 6 elements
+/// unsigned int levels[2];   // e.g., [3, 4] (for 2 x 3 bins)
+/// float lower_level[2];     // e.g., [0.0, 0.0]
+/// float upper_level[2];     // e.g., [2.0, 3.0]
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::histogram_nd_even<2, 2>(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     samples, size,
+///     histogram, levels, lower_level, upper_level
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // compute histogram
+/// rocprim::histogram_nd_even<2, 2>(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     samples, size,
+///     histogram, levels, lower_level, upper_level
+/// );
+/// // histogram: [1, 1, 0,
+/// //             0, 0, 2]
+/// \endcode
+/// \endparblock
+template<unsigned int Channels,
+         unsigned int Dimensions,
+         class Config = default_config,
+         class SampleIterator,
+         class Counter,
+         class Level>
+inline hipError_t histogram_nd_even(void*          temporary_storage,
+                                    size_t&        storage_size,
+                                    SampleIterator samples,
+                                    unsigned int   size,
+                                    Counter*       histogram,
+                                    unsigned int   levels[Dimensions],
+                                    Level          lower_level[Dimensions],
+                                    Level          upper_level[Dimensions],
+                                    hipStream_t    stream            = 0,
+                                    bool           debug_synchronous = false)
+{
+    return detail::histogram_nd_even_impl<Channels, Dimensions, Config>(temporary_storage,
+                                                                        storage_size,
+                                                                        samples,
+                                                                        size,
+                                                                        histogram,
+                                                                        levels,
+                                                                        lower_level,
+                                                                        upper_level,
+                                                                        stream,
+                                                                        debug_synchronous);
+}
+
 /// \brief Computes a histogram from a sequence of samples using the specified bin boundary levels.
 ///
 /// \par
 /// * The number of histogram bins is (\p levels - 1).
 /// * The range for bin<sub><em>j</em></sub> is [<tt>level_values[j]</tt>, <tt>level_values[j+1]</tt>).
+/// * Bins that do not fit into shared memory are counted in shared memory in up to
+/// \p SharedImplMaxPasses passes over the samples (see \p histogram_config), without temporary
+/// storage.
+/// * The sort-based implementation is only used if it is enabled with the \p SortImplMinSamples
+/// parameter of \p histogram_config. It then needs about <tt>2 * size * sizeof(unsigned int)</tt>
+/// bytes of temporary storage in addition to the storage of \p radix_sort_keys.
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 ///
@@ -1285,6 +1837,190 @@ inline hipError_t multi_histogram_range(void*          temporary_storage,
                                                                           debug_synchronous);
 }
 
+/// \brief Computes a weighted histogram from a sequence of samples using equal-width bins.
+///
+/// \par
+/// * Every sample adds its weight (converted to \p Counter) to its bin, instead of 1.
+/// * The number of histogram bins is (\p levels - 1).
+/// * Bins are evenly-segmented and include the same width of sample values:
+/// (\p upper_level - \p lower_level) / (\p levels - 1).
+/// * Bins that fit into shared memory are accumulated per block in \p double (floating point
+/// \p Counter) or 64-bit integers (integral \p Counter) and added to \p histogram once per block.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+///
+/// \tparam Config - [optional] configuration of the primitive. It has to be \p histogram_config or a class derived from it.
+/// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam WeightIterator - random-access iterator type of the weights range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam Counter - type for histogram bin counters, one of \p int, \p unsigned \p int,
+/// \p unsigned \p long \p long (\p uint64_t), \p float or \p double.
+/// \tparam Level - type of histogram boundaries (levels)
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the reduction operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] samples - iterator to the first element in the range of input samples.
+/// \param [in] weights - iterator to the first element in the range of weights, one per sample.
+/// \param [in] size - number of elements in the samples range.
+/// \param [out] histogram - pointer to the first element in the histogram range.
+/// \param [in] levels - number of boundaries (levels) for histogram bins.
+/// \param [in] lower_level - lower sample value bound (inclusive) for the first histogram bin.
+/// \param [in] upper_level - upper sample value bound (exclusive) for the last histogram bin.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful histogram operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level weighted histogram of 5 bins is computed on an array of float samples.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// unsigned int size;        // e.g., 8
+/// float * samples;          // e.g., [-10.0, 0.3, 9.5, 8.1, 1.5, 1.9, 100.0, 5.1]
+/// float * weights;          // e.g., [1.0, 0.5, 2.0, 0.25, 1.0, 1.0, 3.0, 4.0]
+/// float * histogram;        // empty array of at least 5 elements
+/// unsigned int levels;      // e.g., 6 (for 5 bins)
+/// float lower_level;        // e.g., 0.0
+/// float upper_level;        // e.g., 10.0
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::weighted_histogram_even(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     samples, weights, size,
+///     histogram, levels, lower_level, upper_level
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // compute histogram
+/// rocprim::weighted_histogram_even(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     samples, weights, size,
+///     histogram, levels, lower_level, upper_level
+/// );
+/// // histogram: [2.5, 0.0, 4.0, 0.0, 2.25]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class SampleIterator,
+         class WeightIterator,
+         class Counter,
+         class Level>
+inline hipError_t weighted_histogram_even(void*          temporary_storage,
+                                          size_t&        storage_size,
+                                          SampleIterator samples,
+                                          WeightIterator weights,
+                                          unsigned int   size,
+                                          Counter*       histogram,
+                                          unsigned int   levels,
+                                          Level          lower_level,
+                                          Level          upper_level,
+                                          hipStream_t    stream            = 0,
+                                          bool           debug_synchronous = false)
+{
+    Counter*     histogram_single[1]   = {histogram};
+    unsigned int levels_single[1]      = {levels};
+    Level        lower_level_single[1] = {lower_level};
+    Level        upper_level_single[1] = {upper_level};
+
+    return detail::histogram_even_impl<1, 1, Config>(temporary_storage,
+                                                     storage_size,
+                                                     samples,
+                                                     size,
+                                                     1,
+                                                     0,
+                                                     histogram_single,
+                                                     levels_single,
+                                                     lower_level_single,
+                                                     upper_level_single,
+                                                     stream,
+                                                     debug_synchronous,
+                                                     weights);
+}
+
+/// \brief Computes a weighted histogram from a sequence of samples using the specified bin
+/// boundary levels.
+///
+/// \par
+/// * Every sample adds its weight (converted to \p Counter) to its bin, instead of 1.
+/// * The number of histogram bins is (\p levels - 1).
+/// * The range for bin<sub><em>j</em></sub> is [<tt>level_values[j]</tt>, <tt>level_values[j+1]</tt>).
+/// * Bins that fit into shared memory are accumulated per block in \p double (floating point
+/// \p Counter) or 64-bit integers (integral \p Counter) and added to \p histogram once per block.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+///
+/// \tparam Config - [optional] configuration of the primitive. It has to be \p histogram_config or a class derived from it.
+/// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam WeightIterator - random-access iterator type of the weights range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam Counter - type for histogram bin counters, one of \p int, \p unsigned \p int,
+/// \p unsigned \p long \p long (\p uint64_t), \p float or \p double.
+/// \tparam Level - type of histogram boundaries (levels)
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the reduction operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] samples - iterator to the first element in the range of input samples.
+/// \param [in] weights - iterator to the first element in the range of weights, one per sample.
+/// \param [in] size - number of elements in the samples range.
+/// \param [out] histogram - pointer to the first element in the histogram range.
+/// \param [in] levels - number of boundaries (levels) for histogram bins.
+/// \param [in] level_values - pointer to the array of bin boundaries.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful histogram operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<class Config = default_config,
+         class SampleIterator,
+         class WeightIterator,
+         class Counter,
+         class Level>
+inline hipError_t weighted_histogram_range(void*          temporary_storage,
+                                           size_t&        storage_size,
+                                           SampleIterator samples,
+                                           WeightIterator weights,
+                                           unsigned int   size,
+                                           Counter*       histogram,
+                                           unsigned int   levels,
+                                           Level*         level_values,
+                                           hipStream_t    stream            = 0,
+                                           bool           debug_synchronous = false)
+{
+    Counter*     histogram_single[1]    = {histogram};
+    unsigned int levels_single[1]       = {levels};
+    Level*       level_values_single[1] = {level_values};
+
+    return detail::histogram_range_impl<1, 1, Config>(temporary_storage,
+                                                      storage_size,
+                                                      samples,
+                                                      size,
+                                                      1,
+                                                      0,
+                                                      histogram_single,
+                                                      levels_single,
+                                                      level_values_single,
+                                                      stream,
+                                                      debug_synchronous,
+                                                      weights);
+}
+
 /// @}
 // end of group devicemodule
 
@@ -0,0 +1,303 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_LOAD_BALANCED_EXPAND_HPP_
+#define ROCPRIM_DEVICE_DEVICE_LOAD_BALANCED_EXPAND_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/temp_storage.hpp"
+#include "../detail/various.hpp"
+#include "../functional.hpp"
+#include "../iterator/transform_iterator.hpp"
+#include "../type_traits.hpp"
+
+#include "detail/device_load_balanced_expand.hpp"
+#include "detail/persistent_grid.hpp"
+#include "device_load_balanced_expand_config.hpp"
+#include "device_scan.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+namespace detail
+{
+
+template<class Config, class InputIterator, class OffsetType, class EmitFunction>
+ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().kernel_config.block_size) void
+    load_balanced_expand_kernel(InputIterator     input,
+                                const OffsetType* ends,
+                                const size_t      size,
+                                EmitFunction      emit_op)
+{
+    load_balanced_expand_kernel_impl<Config>(input, ends, size, emit_op);
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
+    {                                                                                            \
+        auto _error = hipGetLastError();                                                         \
+        if(_error != hipSuccess)                                                                 \
+            return _error;                                                                       \
+        if(debug_synchronous)                                                                    \
+        {                                                                                        \
+            std::cout << name << "(" << size << ")";                                             \
+            auto __error = hipStreamSynchronize(stream);                                         \
+            if(__error != hipSuccess)                                                            \
+                return __error;                                                                  \
+            auto _end = std::chrono::high_resolution_clock::now();                               \
+            auto _d   = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n';                              \
+        }                                                                                        \
+    }
+
+template<class Config, class InputIterator, class CountFunction, class EmitFunction>
+inline hipError_t load_balanced_expand_impl(void*             temporary_storage,
+                                            size_t&           storage_size,
+                                            InputIterator     input,
+                                            const size_t      size,
+                                            CountFunction     count_op,
+                                            EmitFunction      emit_op,
+                                            const hipStream_t stream,
+                                            bool              debug_synchronous)
+{
+    using input_type  = typename std::iterator_traits<InputIterator>::value_type;
+    using offset_type = ::rocprim::invoke_result_t<CountFunction, input_type>;
+    static_assert(std::is_integral<offset_type>::value,
+                  "The result of CountFunction must be an integral type");
+
+    using config = wrapped_load_balanced_expand_config<Config, offset_type>;
+
+    detail::target_arch target_arch;
+    hipError_t          result = host_target_arch(stream, target_arch);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    const load_balanced_expand_config_params params = dispatch_target_arch<config>(target_arch);
+
+    const unsigned int block_size = params.kernel_config.block_size;
+
+    // The counts are computed while they are scanned, they are never stored
+    const auto counts = ::rocprim::make_transform_iterator(input, count_op);
+
+    offset_type* ends         = nullptr;
+    void*        scan_storage = nullptr;
+    size_t       scan_storage_size;
+    result = ::rocprim::inclusive_scan(nullptr,
+                                       scan_storage_size,
+                                       counts,
+                                       ends,
+                                       size,
+                                       ::rocprim::plus<offset_type>(),
+                                       stream,
+                                       debug_synchronous);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    result = detail::temp_storage::partition(
+        temporary_storage,
+        storage_size,
+        detail::temp_storage::make_linear_partition(
+            detail::temp_storage::ptr_aligned_array(&ends, size),
+            detail::temp_storage::make_partition(&scan_storage, scan_storage_size)));
+    if(result != hipSuccess || temporary_storage == nullptr)
+    {
+        return result;
+    }
+
+    if(size == 0u)
+    {
+        return hipSuccess;
+    }
+
+    result = ::rocprim::inclusive_scan(scan_storage,
+                                       scan_storage_size,
+                                       counts,
+                                       ends,
+                                       size,
+                                       ::rocprim::plus<offset_type>(),
+                                       stream,
+                                       debug_synchronous);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    // The number of outputs is only known on the device, launch enough blocks to fill it
+    unsigned int grid_size;
+    result = get_persistent_grid_size(
+        load_balanced_expand_kernel<config, InputIterator, offset_type, EmitFunction>,
+        block_size,
+        stream,
+        grid_size);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    if(debug_synchronous)
+    {
+        std::cout << "size " << size << '\n';
+        std::cout << "block_size " << block_size << '\n';
+        std::cout << "items_per_thread " << params.kernel_config.items_per_thread << '\n';
+        std::cout << "grid_size " << grid_size << '\n';
+    }
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+    {
+        start = std::chrono::high_resolution_clock::now();
+    }
+    load_balanced_expand_kernel<config>
+        <<<dim3(grid_size), dim3(block_size), 0, stream>>>(input, ends, size, emit_op);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("load_balanced_expand_kernel", size, start);
+
+    return hipSuccess;
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // end of detail namespace
+
+/// \brief Parallel load balanced expand primitive for device level.
+///
+/// load_balanced_expand expands every input value into a variable number of outputs:
+/// input \p i produces <tt>count_op(input[i])</tt> outputs, numbered consecutively in
+/// the order of the inputs. \p emit_op is called once for every output.
+/// This is the fusion of computing the counts, an exclusive scan of the counts and the
+/// expansion (also known as load balanced search): the counts are scanned as they are
+/// computed and the outputs are distributed evenly among the threads with merge path,
+/// regardless of how the counts are distributed.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Range specified by \p input must have at least \p size elements.
+/// * The total number of outputs must fit in the result type of \p count_op.
+/// * \p emit_op is called in no particular order. Its signature should be equivalent to:
+/// <tt>void f(const T &value, size_t input_index, C rank, C output_index);</tt>, where
+/// \p T is the value type of \p InputIterator and \p C is the result type of \p count_op.
+/// \p value is <tt>input[input_index]</tt>, \p rank is the index of the output among the
+/// outputs of this input (in <tt>[0, count_op(value))</tt>) and \p output_index is the index
+/// of the output among all the outputs.
+///
+/// \tparam Config - [optional] configuration of the primitive, has to be
+/// \p load_balanced_expand_config or \p default_config.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam CountFunction - type of unary function used to compute the number of outputs of an
+/// input. Its result type must be integral.
+/// \tparam EmitFunction - type of function called for every output.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to expand.
+/// \param [in] size - number of element in the input range.
+/// \param [in] count_op - unary function object returning the number of outputs of a value.
+/// The signature of the function should be equivalent to the following:
+/// <tt>C f(const T &a);</tt>.
+/// \param [in] emit_op - function object called for every output.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful expansion; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example the vertices of a frontier are expanded into their neighbours in a
+/// graph stored in CSR format.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t frontier_size;       // e.g., 3
+/// unsigned int * frontier;    // e.g., [0, 2, 3]
+/// unsigned int * row_offsets; // e.g., [0, 2, 2, 3, 6]
+/// unsigned int * columns;     // e.g., [1, 2, 0, 0, 1, 2]
+/// unsigned int * neighbours;  // empty array of 6 elements
+///
+/// auto count_op = [row_offsets] __device__ (unsigned int v)
+/// { return row_offsets[v + 1] - row_offsets[v]; };
+/// auto emit_op = [row_offsets, columns, neighbours] __device__
+///     (unsigned int v, size_t, unsigned int rank, unsigned int output_index)
+/// { neighbours[output_index] = columns[row_offsets[v] + rank]; };
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::load_balanced_expand(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     frontier, frontier_size, count_op, emit_op
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform expansion
+/// rocprim::load_balanced_expand(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     frontier, frontier_size, count_op, emit_op
+/// );
+/// // neighbours: [1, 2, 0, 0, 1, 2]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputIterator,
+         class CountFunction,
+         class EmitFunction>
+inline hipError_t load_balanced_expand(void*             temporary_storage,
+                                       size_t&           storage_size,
+                                       InputIterator     input,
+                                       const size_t      size,
+                                       CountFunction     count_op,
+                                       EmitFunction      emit_op,
+                                       const hipStream_t stream            = 0,
+                                       bool              debug_synchronous = false)
+{
+    return detail::load_balanced_expand_impl<Config>(temporary_storage,
+                                                     storage_size,
+                                                     input,
+                                                     size,
+                                                     count_op,
+                                                     emit_op,
+                                                     stream,
+                                                     debug_synchronous);
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_LOAD_BALANCED_EXPAND_HPP_
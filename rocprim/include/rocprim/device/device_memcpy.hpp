@@ -26,6 +26,9 @@
 
 #include "config_types.hpp"
 
+#include "../iterator/counting_iterator.hpp"
+#include "../iterator/transform_iterator.hpp"
+
 #include "detail/device_batch_memcpy.hpp"
 #include "device_memcpy_config.hpp"
 #include "rocprim/device/detail/device_config_helper.hpp"
@@ -142,6 +145,227 @@ ROCPRIM_INLINE static hipError_t batch_memcpy(void*              temporary_stora
             debug_synchronous);
 }
 
+/// \brief Set `sizes[i]` bytes starting at `destinations[i]` to `values[i]` for all `i` in the
+/// range [0, `num_buffers`).
+///
+/// \tparam Config [optional] configuration of  the primitive. It has to be \p batch_memcpy_config .
+/// \tparam OutputBufferItType type of iterator to destination pointers.
+/// \tparam ValueItType type of iterator to byte values, they are converted to `unsigned char`.
+/// \tparam BufferSizeItType type of iterator to sizes.
+///
+/// \param [in] temporary_storage pointer to device-accessible temporary storage.
+/// When a null pointer is passed, the required allocation size in bytes is written to
+/// `storage_size` and the function returns without performing the memset.
+/// \param [in, out] storage_size reference to the size in bytes of `temporary_storage`.
+/// \param [in] destinations iterator of destination pointers.
+/// \param [in] values iterator of the byte value of each buffer.
+/// \param [in] sizes iterator of buffer sizes in bytes.
+/// \param [in] num_buffers number of buffers to set.
+/// \param [in] stream [optional] HIP stream object to enqueue the memset on. Default is `hipStreamDefault`.
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. The default value is `false`.
+///
+/// Performs multiple device memsets as a single batched operation. Roughly equivalent to
+/// \code{.cpp}
+/// for (auto i = 0; i < num_buffers; ++i) {
+///     hipMemsetAsync(destinations[i], values[i], sizes[i], stream);
+/// }
+/// \endcode
+/// except executed on the device in parallel. The buffers are balanced over threads, warps and
+/// blocks by size in the same way as in \p batch_memcpy. Overlapping destinations are not allowed,
+/// and will result in undefined behaviour.
+template<class Config_ = default_config,
+         class OutputBufferItType,
+         class ValueItType,
+         class BufferSizeItType>
+ROCPRIM_INLINE static hipError_t batch_memset(void*              temporary_storage,
+                                              size_t&            storage_size,
+                                              OutputBufferItType destinations,
+                                              ValueItType        values,
+                                              BufferSizeItType   sizes,
+                                              uint32_t           num_buffers,
+                                              hipStream_t        stream = hipStreamDefault,
+                                              bool               debug_synchronous = false)
+{
+    const auto sources
+        = make_transform_iterator(values, detail::batch_memcpy::make_memset_source{});
+    return detail::
+        batch_memcpy_func<Config_, decltype(sources), OutputBufferItType, BufferSizeItType, true>(
+            temporary_storage,
+            storage_size,
+            sources,
+            destinations,
+            sizes,
+            num_buffers,
+            stream,
+            debug_synchronous);
+}
+
+/// \brief Copy `heights[i]` rows of `widths[i]` bytes from `sources[i]` to `destinations[i]`
+/// for all `i` in the range [0, `num_copies`), where the rows of each source and destination are
+/// `source_pitches[i]` and `destination_pitches[i]` bytes apart.
+///
+/// \tparam Config [optional] configuration of  the primitive. It has to be \p batch_memcpy_config .
+/// \tparam InputBufferItType type of iterator to source pointers.
+/// \tparam InputPitchItType type of iterator to source pitches.
+/// \tparam OutputBufferItType type of iterator to destination pointers.
+/// \tparam OutputPitchItType type of iterator to destination pitches.
+/// \tparam WidthItType type of iterator to widths.
+/// \tparam HeightItType type of iterator to heights.
+///
+/// \param [in] temporary_storage pointer to device-accessible temporary storage.
+/// When a null pointer is passed, the required allocation size in bytes is written to
+/// `storage_size` and the function returns without performing the copy.
+/// \param [in, out] storage_size reference to the size in bytes of `temporary_storage`.
+/// \param [in] sources iterator of source pointers.
+/// \param [in] source_pitches iterator of the distances in bytes between the source rows.
+/// \param [in] destinations iterator of destination pointers.
+/// \param [in] destination_pitches iterator of the distances in bytes between the destination rows.
+/// \param [in] widths iterator of the widths in bytes of the copied regions.
+/// \param [in] heights iterator of the number of rows of the copied regions.
+/// \param [in] num_copies number of regions to copy.
+/// \param [in] stream [optional] HIP stream object to enqueue the copy on. Default is `hipStreamDefault`.
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. The default value is `false`.
+///
+/// Performs multiple 2D device to device memory copies, for example the extraction of tiles
+/// from images, as a single batched operation. Roughly equivalent to
+/// \code{.cpp}
+/// for (auto i = 0; i < num_copies; ++i) {
+///     hipMemcpy2DAsync(destinations[i], destination_pitches[i],
+///                      sources[i], source_pitches[i],
+///                      widths[i], heights[i],
+///                      hipMemcpyDeviceToDevice, stream);
+/// }
+/// \endcode
+/// except executed on the device in parallel. Each region is balanced over threads, warps and
+/// blocks by its size `widths[i] * heights[i]` in the same way as in \p batch_memcpy.
+/// Source regions are allowed to overlap, however, destinations overlapping with either other
+/// destinations or with sources is not allowed, and will result in undefined behaviour.
+template<class Config_ = default_config,
+         class InputBufferItType,
+         class InputPitchItType,
+         class OutputBufferItType,
+         class OutputPitchItType,
+         class WidthItType,
+         class HeightItType>
+ROCPRIM_INLINE static hipError_t batch_memcpy_2d(void*              temporary_storage,
+                                                 size_t&            storage_size,
+                                                 InputBufferItType  sources,
+                                                 InputPitchItType   source_pitches,
+                                                 OutputBufferItType destinations,
+                                                 OutputPitchItType  destination_pitches,
+                                                 WidthItType        widths,
+                                                 HeightItType       heights,
+                                                 uint32_t           num_copies,
+                                                 hipStream_t        stream = hipStreamDefault,
+                                                 bool               debug_synchronous = false)
+{
+    const auto pitched_sources = make_transform_iterator(
+        counting_iterator<uint32_t>(0),
+        detail::batch_memcpy::make_pitched_buffer<InputBufferItType, InputPitchItType, WidthItType>{
+            sources,
+            source_pitches,
+            widths});
+    const auto pitched_destinations = make_transform_iterator(
+        counting_iterator<uint32_t>(0),
+        detail::batch_memcpy::
+            make_pitched_buffer<OutputBufferItType, OutputPitchItType, WidthItType>{
+                destinations,
+                destination_pitches,
+                widths});
+    const auto sizes = make_transform_iterator(
+        counting_iterator<uint32_t>(0),
+        detail::batch_memcpy::pitched_buffer_size<WidthItType, HeightItType>{widths, heights});
+    return detail::batch_memcpy_func<Config_,
+                                     decltype(pitched_sources),
+                                     decltype(pitched_destinations),
+                                     decltype(sizes),
+                                     true>(temporary_storage,
+                                           storage_size,
+                                           pitched_sources,
+                                           pitched_destinations,
+                                           sizes,
+                                           num_copies,
+                                           stream,
+                                           debug_synchronous);
+}
+
+/// \brief Set `heights[i]` rows of `widths[i]` bytes starting at `destinations[i]` to `values[i]`
+/// for all `i` in the range [0, `num_buffers`), where the rows of each destination are `pitches[i]`
+/// bytes apart.
+///
+/// \tparam Config [optional] configuration of  the primitive. It has to be \p batch_memcpy_config .
+/// \tparam OutputBufferItType type of iterator to destination pointers.
+/// \tparam PitchItType type of iterator to pitches.
+/// \tparam ValueItType type of iterator to byte values, they are converted to `unsigned char`.
+/// \tparam WidthItType type of iterator to widths.
+/// \tparam HeightItType type of iterator to heights.
+///
+/// \param [in] temporary_storage pointer to device-accessible temporary storage.
+/// When a null pointer is passed, the required allocation size in bytes is written to
+/// `storage_size` and the function returns without performing the memset.
+/// \param [in, out] storage_size reference to the size in bytes of `temporary_storage`.
+/// \param [in] destinations iterator of destination pointers.
+/// \param [in] pitches iterator of the distances in bytes between the destination rows.
+/// \param [in] values iterator of the byte value of each region.
+/// \param [in] widths iterator of the widths in bytes of the regions.
+/// \param [in] heights iterator of the number of rows of the regions.
+/// \param [in] num_buffers number of regions to set.
+/// \param [in] stream [optional] HIP stream object to enqueue the memset on. Default is `hipStreamDefault`.
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. The default value is `false`.
+///
+/// Batched version of `hipMemset2DAsync`, roughly equivalent to
+/// \code{.cpp}
+/// for (auto i = 0; i < num_buffers; ++i) {
+///     hipMemset2DAsync(destinations[i], pitches[i], values[i], widths[i], heights[i], stream);
+/// }
+/// \endcode
+/// except executed on the device in parallel. Overlapping destinations are not allowed,
+/// and will result in undefined behaviour.
+template<class Config_ = default_config,
+         class OutputBufferItType,
+         class PitchItType,
+         class ValueItType,
+         class WidthItType,
+         class HeightItType>
+ROCPRIM_INLINE static hipError_t batch_memset_2d(void*              temporary_storage,
+                                                 size_t&            storage_size,
+                                                 OutputBufferItType destinations,
+                                                 PitchItType        pitches,
+                                                 ValueItType        values,
+                                                 WidthItType        widths,
+                                                 HeightItType       heights,
+                                                 uint32_t           num_buffers,
+                                                 hipStream_t        stream = hipStreamDefault,
+                                                 bool               debug_synchronous = false)
+{
+    const auto sources
+        = make_transform_iterator(values, detail::batch_memcpy::make_memset_source{});
+    const auto pitched_destinations = make_transform_iterator(
+        counting_iterator<uint32_t>(0),
+        detail::batch_memcpy::make_pitched_buffer<OutputBufferItType, PitchItType, WidthItType>{
+            destinations,
+            pitches,
+            widths});
+    const auto sizes = make_transform_iterator(
+        counting_iterator<uint32_t>(0),
+        detail::batch_memcpy::pitched_buffer_size<WidthItType, HeightItType>{widths, heights});
+    return detail::batch_memcpy_func<Config_,
+                                     decltype(sources),
+                                     decltype(pitched_destinations),
+                                     decltype(sizes),
+                                     true>(temporary_storage,
+                                           storage_size,
+                                           sources,
+                                           pitched_destinations,
+                                           sizes,
+                                           num_buffers,
+                                           stream,
+                                           debug_synchronous);
+}
+
 END_ROCPRIM_NAMESPACE
 
 #endif
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -543,7 +543,7 @@ template<class Config,
          class ValuesInputIterator,
          class ValuesOutputIterator,
          class BinaryFunction>
-inline hipError_t merge_sort_impl(
+inline hipError_t merge_sort_impl_with_config(
     void*                                                           temporary_storage,
     size_t&                                                         storage_size,
     KeysInputIterator                                               keys_input,
@@ -554,8 +554,8 @@ inline hipError_t merge_sort_impl(
     BinaryFunction                                                  compare_function,
     const hipStream_t                                               stream,
     bool                                                            debug_synchronous,
-    typename std::iterator_traits<KeysInputIterator>::value_type*   keys_buffer   = nullptr,
-    typename std::iterator_traits<ValuesInputIterator>::value_type* values_buffer = nullptr)
+    typename std::iterator_traits<KeysInputIterator>::value_type*   keys_buffer,
+    typename std::iterator_traits<ValuesInputIterator>::value_type* values_buffer)
 {
     using key_type   = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
@@ -629,6 +629,50 @@ inline hipError_t merge_sort_impl(
     return hipSuccess;
 }
 
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class BinaryFunction>
+inline hipError_t merge_sort_impl(
+    void*                                                           temporary_storage,
+    size_t&                                                         storage_size,
+    KeysInputIterator                                               keys_input,
+    KeysOutputIterator                                              keys_output,
+    ValuesInputIterator                                             values_input,
+    ValuesOutputIterator                                            values_output,
+    const unsigned int                                              size,
+    BinaryFunction                                                  compare_function,
+    const hipStream_t                                               stream,
+    bool                                                            debug_synchronous,
+    typename std::iterator_traits<KeysInputIterator>::value_type*   keys_buffer   = nullptr,
+    typename std::iterator_traits<ValuesInputIterator>::value_type* values_buffer = nullptr)
+{
+    // The default config may be tuned for the size of the input. A sub-algorithm without tuned
+    // buckets falls back to its regular default config.
+    constexpr bool bucketed = default_merge_sort_block_sort_config_size_bucketed::value
+                              || default_merge_sort_block_merge_config_size_bucketed::value;
+    return dispatch_size_bucket<Config, bucketed>(
+        size,
+        [&](auto config_identity)
+        {
+            using config = typename decltype(config_identity)::type;
+            return merge_sort_impl_with_config<config>(temporary_storage,
+                                                       storage_size,
+                                                       keys_input,
+                                                       keys_output,
+                                                       values_input,
+                                                       values_output,
+                                                       size,
+                                                       compare_function,
+                                                       stream,
+                                                       debug_synchronous,
+                                                       keys_buffer,
+                                                       values_buffer);
+        });
+}
+
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
 #undef ROCPRIM_DETAIL_HIP_SYNC
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2022-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -108,6 +108,21 @@ struct wrapped_merge_sort_block_merge_config<default_config, Key, Value>
     };
 };
 
+// Default config tuned for the input sizes of a size bucket, see dispatch_size_bucket
+template<size_bucket Bucket, typename Key, typename Value>
+struct wrapped_merge_sort_block_merge_config<default_bucket_config<Bucket>, Key, Value>
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        static constexpr merge_sort_block_merge_config_params params
+            = default_merge_sort_block_merge_bucket_config<static_cast<unsigned int>(Arch),
+                                                           Bucket,
+                                                           Key,
+                                                           Value>();
+    };
+};
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 template<typename MergeSortBlockMergeConfig, typename Key, typename Value>
 template<target_arch Arch>
@@ -120,6 +135,12 @@ template<target_arch Arch>
 constexpr merge_sort_block_merge_config_params
     wrapped_merge_sort_block_merge_config<default_config, Key, Value>::architecture_config<
         Arch>::params;
+
+template<size_bucket Bucket, typename Key, typename Value>
+template<target_arch Arch>
+constexpr merge_sort_block_merge_config_params
+    wrapped_merge_sort_block_merge_config<default_bucket_config<Bucket>, Key, Value>::
+        architecture_config<Arch>::params;
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 // Sub-algorithm block_sort:
@@ -144,6 +165,21 @@ struct wrapped_merge_sort_block_sort_config<default_config, Key, Value>
     };
 };
 
+// Default config tuned for the input sizes of a size bucket, see dispatch_size_bucket
+template<size_bucket Bucket, typename Key, typename Value>
+struct wrapped_merge_sort_block_sort_config<default_bucket_config<Bucket>, Key, Value>
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        static constexpr merge_sort_block_sort_config_params params
+            = default_merge_sort_block_sort_bucket_config<static_cast<unsigned int>(Arch),
+                                                          Bucket,
+                                                          Key,
+                                                          Value>();
+    };
+};
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 template<typename MergeSortBlockSortConfig, typename Key, typename Value>
 template<target_arch Arch>
@@ -156,6 +192,12 @@ template<target_arch Arch>
 constexpr merge_sort_block_sort_config_params
     wrapped_merge_sort_block_sort_config<default_config, Key, Value>::architecture_config<
         Arch>::params;
+
+template<size_bucket Bucket, typename Key, typename Value>
+template<target_arch Arch>
+constexpr merge_sort_block_sort_config_params
+    wrapped_merge_sort_block_sort_config<default_bucket_config<Bucket>, Key, Value>::
+        architecture_config<Arch>::params;
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 } // namespace detail
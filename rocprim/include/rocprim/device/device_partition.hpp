@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -36,7 +36,9 @@
 
 #include "detail/device_partition.hpp"
 #include "detail/device_scan_common.hpp"
+#include "detail/persistent_grid.hpp"
 #include "device_select_config.hpp"
+#include "device_trace.hpp"
 #include "device_transform.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -85,9 +87,60 @@ ROCPRIM_KERNEL __launch_bounds__(Config::block_size) void partition_kernel(
                                                               inequality_op,
                                                               offset_scan_state,
                                                               number_of_blocks,
+                                                              ::rocprim::detail::block_id<0>(),
                                                               predicates...);
 }
 
+// Partition with a persistent grid, tiles are processed in the order of ordered_tile_id
+template<select_method SelectMethod,
+         bool          OnlySelected,
+         class Config,
+         class KeyIterator,
+         class ValueIterator,
+         class FlagIterator,
+         class OutputKeyIterator,
+         class OutputValueIterator,
+         class InequalityOp,
+         class OffsetLookbackScanState,
+         class... UnaryPredicates>
+ROCPRIM_KERNEL __launch_bounds__(Config::block_size) void persistent_partition_kernel(
+    KeyIterator                    keys_input,
+    ValueIterator                  values_input,
+    FlagIterator                   flags,
+    OutputKeyIterator              keys_output,
+    OutputValueIterator            values_output,
+    size_t*                        selected_count,
+    size_t*                        prev_selected_count,
+    size_t                         prev_processed,
+    const size_t                   total_size,
+    InequalityOp                   inequality_op,
+    OffsetLookbackScanState        offset_scan_state,
+    const unsigned int             number_of_blocks,
+    ordered_block_id<unsigned int> ordered_tile_id,
+    UnaryPredicates... predicates)
+{
+    for_each_ordered_tile(
+        ordered_tile_id,
+        number_of_blocks,
+        [&](const unsigned int tile_id)
+        {
+            partition_kernel_impl<SelectMethod, OnlySelected, Config>(keys_input,
+                                                                      values_input,
+                                                                      flags,
+                                                                      keys_output,
+                                                                      values_output,
+                                                                      selected_count,
+                                                                      prev_selected_count,
+                                                                      prev_processed,
+                                                                      total_size,
+                                                                      inequality_op,
+                                                                      offset_scan_state,
+                                                                      number_of_blocks,
+                                                                      tile_id,
+                                                                      predicates...);
+        });
+}
+
 #define ROCPRIM_DETAIL_HIP_SYNC(name, size, start) \
     if(debug_synchronous) \
     { \
@@ -176,10 +229,17 @@ hipError_t partition_impl(void * temporary_storage,
     const unsigned int number_of_blocks
         = static_cast<unsigned int>(::rocprim::detail::ceiling_div(limited_size, items_per_block));
 
+    // Tiles of a persistent grid are handed out in order, a tile only waits for the look-back
+    // of tiles that are already processed
+    constexpr bool persistent = config::launch_mode == ::rocprim::grid_launch_mode::persistent;
+    // The persistent kernels are only instantiated for configs that launch them
+    using persistent_launch = std::integral_constant<bool, persistent>;
+
     // Calculate required temporary storage
-    void*                           offset_scan_state_storage;
-    size_t*                         selected_count;
-    size_t*                         prev_selected_count;
+    void*                                    offset_scan_state_storage;
+    size_t*                                  selected_count;
+    size_t*                                  prev_selected_count;
+    ordered_block_id<unsigned int>::id_type* ordered_tile_id_storage;
 
     detail::temp_storage::layout layout{};
     const hipError_t             layout_result
@@ -199,12 +259,21 @@ hipError_t partition_impl(void * temporary_storage,
             // simultaneously.
             // They have the same base type, so there is no padding between the types.
             detail::temp_storage::ptr_aligned_array(&selected_count, selected_count_size),
-            detail::temp_storage::ptr_aligned_array(&prev_selected_count, selected_count_size)));
+            detail::temp_storage::ptr_aligned_array(&prev_selected_count, selected_count_size),
+            detail::temp_storage::ptr_aligned_array(&ordered_tile_id_storage, persistent ? 1 : 0)));
     if(partition_result != hipSuccess || temporary_storage == nullptr)
     {
         return partition_result;
     }
 
+    // select and unique are implemented as partitions as well
+    const char* algorithm_name = "partition";
+    if(OnlySelected)
+    {
+        algorithm_name = SelectMethod == select_method::unique ? "unique" : "select";
+    }
+    trace_algorithm trace(algorithm_name, storage_size, stream);
+
     // Start point for time measurements
     std::chrono::high_resolution_clock::time_point start;
 
@@ -234,19 +303,14 @@ hipError_t partition_impl(void * temporary_storage,
                            stream);
     if (error != hipSuccess) return error;
 
-    hipDeviceProp_t prop;
-    int deviceId;
-    static_cast<void>(hipGetDevice(&deviceId));
-    static_cast<void>(hipGetDeviceProperties(&prop, deviceId));
-
-#if HIP_VERSION >= 307
-    int asicRevision = prop.asicRevision;
-#else
-    int asicRevision = 0;
-#endif
+    bool use_sleep;
+    error = is_sleep_scan_state_used(use_sleep);
+    if(error != hipSuccess) return error;
 
     const size_t number_of_launches = ::rocprim::detail::ceiling_div(size, aligned_size_limit);
 
+    const auto ordered_tile_id = ordered_block_id<unsigned int>::create(ordered_tile_id_storage);
+
     if(debug_synchronous)
     {
         std::cout << "use_limited_size " << use_limited_size << '\n';
@@ -276,79 +340,154 @@ hipError_t partition_impl(void * temporary_storage,
             start = std::chrono::high_resolution_clock::now();
         }
 
-        if(std::string(prop.gcnArchName).find("908") != std::string::npos && asicRevision < 2)
+        // The persistent partition kernel also needs its ordered tile id to be reset
+        const auto init_scan_state = [&](auto lookback_scan_state)
         {
-            hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(init_lookback_scan_state_kernel<offset_scan_state_with_sleep_type>),
-                dim3(grid_size),
-                dim3(block_size),
-                0,
-                stream,
-                offset_scan_state_with_sleep,
-                current_number_of_blocks);
+            using state_type = decltype(lookback_scan_state);
+            return static_branch<state_type>(
+                persistent_launch{},
+                [&](auto state_identity)
+                {
+                    using launch_state_type = typename decltype(state_identity)::type;
+                    hipLaunchKernelGGL(
+                        HIP_KERNEL_NAME(init_lookback_scan_state_kernel<launch_state_type>),
+                        dim3(grid_size),
+                        dim3(block_size),
+                        0,
+                        stream,
+                        lookback_scan_state,
+                        current_number_of_blocks,
+                        ordered_tile_id);
+                    return hipSuccess;
+                },
+                [&](auto)
+                {
+                    hipLaunchKernelGGL(HIP_KERNEL_NAME(init_lookback_scan_state_kernel<state_type>),
+                                       dim3(grid_size),
+                                       dim3(block_size),
+                                       0,
+                                       stream,
+                                       lookback_scan_state,
+                                       current_number_of_blocks);
+                    return hipSuccess;
+                });
+        };
+
+        if(use_sleep)
+        {
+            init_scan_state(offset_scan_state_with_sleep);
         } else
         {
-            hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(init_lookback_scan_state_kernel<offset_scan_state_type>),
-                dim3(grid_size),
-                dim3(block_size),
-                0,
-                stream,
-                offset_scan_state,
-                current_number_of_blocks);
+            init_scan_state(offset_scan_state);
         }
 
         ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_offset_scan_state_kernel", current_number_of_blocks, start)
+        trace_kernel("init_offset_scan_state_kernel",
+                     current_number_of_blocks,
+                     grid_size,
+                     block_size,
+                     0);
+
+        // Both scan states use the same resources, the occupancy of one kernel is enough
+        error = static_branch<config>(
+            persistent_launch{},
+            [&](auto config_identity)
+            {
+                using launch_config = typename decltype(config_identity)::type;
+                return get_persistent_grid_size(persistent_partition_kernel<SelectMethod,
+                                                                            OnlySelected,
+                                                                            launch_config,
+                                                                            KeyIterator,
+                                                                            ValueIterator,
+                                                                            FlagIterator,
+                                                                            OutputKeyIterator,
+                                                                            OutputValueIterator,
+                                                                            InequalityOp,
+                                                                            offset_scan_state_type,
+                                                                            UnaryPredicates...>,
+                                                block_size,
+                                                current_number_of_blocks,
+                                                stream,
+                                                grid_size);
+            },
+            [&](auto)
+            {
+                grid_size = current_number_of_blocks;
+                return hipSuccess;
+            });
+        if(error != hipSuccess) return error;
 
-        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-
-        grid_size = current_number_of_blocks;
+        if(debug_synchronous)
+        {
+            std::cout << "grid_size " << grid_size << '\n';
+            start = std::chrono::high_resolution_clock::now();
+        }
 
-        if(std::string(prop.gcnArchName).find("908") != std::string::npos && asicRevision < 2)
+        const auto launch_partition_kernel = [&](auto lookback_scan_state)
+        {
+            return static_branch<config>(
+                persistent_launch{},
+                [&](auto config_identity)
+                {
+                    using launch_config = typename decltype(config_identity)::type;
+                    hipLaunchKernelGGL(
+                        HIP_KERNEL_NAME(
+                            persistent_partition_kernel<SelectMethod, OnlySelected, launch_config>),
+                        dim3(grid_size),
+                        dim3(block_size),
+                        0,
+                        stream,
+                        keys_input + prev_processed,
+                        values_input + prev_processed,
+                        flags + prev_processed,
+                        keys_output,
+                        values_output,
+                        selected_count,
+                        prev_selected_count,
+                        prev_processed,
+                        size,
+                        inequality_op,
+                        lookback_scan_state,
+                        current_number_of_blocks,
+                        ordered_tile_id,
+                        predicates...);
+                    return hipSuccess;
+                },
+                [&](auto)
+                {
+                    hipLaunchKernelGGL(
+                        HIP_KERNEL_NAME(partition_kernel<SelectMethod, OnlySelected, config>),
+                        dim3(grid_size),
+                        dim3(block_size),
+                        0,
+                        stream,
+                        keys_input + prev_processed,
+                        values_input + prev_processed,
+                        flags + prev_processed,
+                        keys_output,
+                        values_output,
+                        selected_count,
+                        prev_selected_count,
+                        prev_processed,
+                        size,
+                        inequality_op,
+                        lookback_scan_state,
+                        current_number_of_blocks,
+                        predicates...);
+                    return hipSuccess;
+                });
+        };
+
+        if(use_sleep)
         {
-            hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(partition_kernel<SelectMethod, OnlySelected, config>),
-                dim3(grid_size),
-                dim3(block_size),
-                0,
-                stream,
-                keys_input + prev_processed,
-                values_input + prev_processed,
-                flags + prev_processed,
-                keys_output,
-                values_output,
-                selected_count,
-                prev_selected_count,
-                prev_processed,
-                size,
-                inequality_op,
-                offset_scan_state_with_sleep,
-                current_number_of_blocks,
-                predicates...);
+            launch_partition_kernel(offset_scan_state_with_sleep);
         } else
         {
-            hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(partition_kernel<SelectMethod, OnlySelected, config>),
-                dim3(grid_size),
-                dim3(block_size),
-                0,
-                stream,
-                keys_input + prev_processed,
-                values_input + prev_processed,
-                flags + prev_processed,
-                keys_output,
-                values_output,
-                selected_count,
-                prev_selected_count,
-                prev_processed,
-                size,
-                inequality_op,
-                offset_scan_state,
-                current_number_of_blocks,
-                predicates...);
+            launch_partition_kernel(offset_scan_state);
         }
 
         ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("partition_kernel", size, start)
+        trace_kernel("partition_kernel", current_size, grid_size, block_size, items_per_thread);
 
         std::swap(selected_count, prev_selected_count);
     }
@@ -0,0 +1,896 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_PLAN_HPP_
+#define ROCPRIM_DEVICE_DEVICE_PLAN_HPP_
+
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/plan_launch_log.hpp"
+#include "../functional.hpp"
+#include "../types.hpp"
+
+#include "config_types.hpp"
+#include "detail/lookback_scan_state.hpp"
+#include "device_merge_sort.hpp"
+#include "device_radix_sort.hpp"
+#include "device_reduce.hpp"
+#include "device_scan.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+namespace detail
+{
+
+// Common part of the execution plans: the device of the stream and the size of the temporary
+// storage are resolved once, when the plan is made. While a plan executes, the algorithms read
+// the device properties from the plan instead of querying the HIP runtime. The first successful
+// execution records the config candidate of the runtime tuning, the offsets of the temporary
+// storage partitions and the persistent grid sizes to the launch log of the plan, the later
+// executions launch with them instead of resolving them again (see plan_resolve).
+class execution_plan
+{
+public:
+    /// \brief Size in bytes of the temporary storage that must be passed to \p execute.
+    size_t temporary_storage_bytes() const noexcept
+    {
+        return storage_size_;
+    }
+
+    /// \brief The stream that the plan launches its kernels to.
+    hipStream_t stream() const noexcept
+    {
+        return stream_;
+    }
+
+protected:
+    hipError_t init_device(const hipStream_t stream, const bool debug_synchronous)
+    {
+        stream_            = stream;
+        debug_synchronous_ = debug_synchronous;
+        valid_             = false;
+        launch_log_        = std::make_shared<plan_launch_log>();
+
+        hipError_t result = get_device_from_stream(stream, device_info_.device_id);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+
+        hipDeviceProp_t device_props;
+        result = hipGetDeviceProperties(&device_props, device_info_.device_id);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        device_info_.arch                 = parse_gcn_arch(device_props.gcnArchName);
+        device_info_.warp_size            = device_props.warpSize;
+        device_info_.multiprocessor_count = device_props.multiProcessorCount;
+
+        return is_sleep_scan_state_used(device_info_.device_id, device_info_.use_sleep_scan_state);
+    }
+
+    // Calls function(nullptr, storage_size) to get the size of the temporary storage
+    template<class Function>
+    hipError_t init_storage_size(Function&& function)
+    {
+        const plan_device_scope scope(device_info_);
+
+        const hipError_t result = function(nullptr, storage_size_);
+        valid_                  = result == hipSuccess;
+        return result;
+    }
+
+    // Calls function(temporary_storage, storage_size) to run the algorithm
+    template<class Function>
+    hipError_t run(void* temporary_storage, Function&& function) const
+    {
+        // A null pointer would only query the size of the temporary storage
+        if(!valid_ || temporary_storage == nullptr)
+        {
+            return hipErrorInvalidValue;
+        }
+        const plan_device_scope scope(device_info_);
+        plan_launch_scope       launch_scope(*launch_log_);
+
+        size_t           storage_size = storage_size_;
+        const hipError_t result       = function(temporary_storage, storage_size);
+        if(result == hipSuccess)
+        {
+            launch_scope.commit();
+        }
+        return result;
+    }
+
+    hipStream_t                      stream_            = 0;
+    bool                             debug_synchronous_ = false;
+    bool                             valid_             = false;
+    size_t                           storage_size_      = 0;
+    plan_device_info                 device_info_{};
+    std::shared_ptr<plan_launch_log> launch_log_;
+};
+
+} // end namespace detail
+
+/// \brief Execution plan of \p radix_sort_keys, \p radix_sort_keys_desc, \p radix_sort_pairs
+/// and \p radix_sort_pairs_desc for a fixed problem shape.
+///
+/// The plan is made once by \p make_radix_sort_plan, which resolves the device of the stream
+/// and the size of the temporary storage. Every \p execute then sorts with a single call and
+/// without querying the device from the HIP runtime again. The first successful \p execute also
+/// resolves the config chosen by the runtime tuning (once the tuning is done), the layout of the
+/// temporary storage and the sizes of the persistent grids; the later ones launch with them.
+/// If an \p execute takes another path (e.g. other iterator types change a persistent kernel),
+/// the rest of it resolves them as a direct call does. A plan is bound to its stream.
+///
+/// \tparam Key - key type.
+/// \tparam Value - value type, \p empty_type to sort keys only.
+/// \tparam Descending - if \p true, sorts in descending order.
+/// \tparam Config - [optional] configuration of the primitive, see \p radix_sort_keys.
+/// \tparam Size - integral type of the problem size.
+///
+/// \par Example
+/// \parblock
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// size_t input_size; // e.g., 1 << 20
+/// float* input;
+/// float* output;
+///
+/// rocprim::radix_sort_plan<float> plan;
+/// rocprim::make_radix_sort_plan(plan, input_size);
+///
+/// void* temporary_storage_ptr;
+/// hipMalloc(&temporary_storage_ptr, plan.temporary_storage_bytes());
+///
+/// // Can be called any number of times
+/// plan.execute(temporary_storage_ptr, input, output);
+/// \endcode
+/// \endparblock
+template<class Key,
+         class Value     = empty_type,
+         bool Descending = false,
+         class Config    = default_config,
+         class Size      = size_t>
+class radix_sort_plan : public detail::execution_plan
+{
+    static_assert(std::is_integral<Size>::value, "Size must be an integral type.");
+
+public:
+    /// \brief Key type.
+    using key_type = Key;
+    /// \brief Value type.
+    using value_type = Value;
+    /// \brief Integral type of the problem size.
+    using size_type = Size;
+
+    /// \brief Sorts the keys with the plan.
+    ///
+    /// \param [in] temporary_storage - device-accessible temporary storage of at least
+    /// \p temporary_storage_bytes() bytes.
+    /// \param [in] keys_input - iterator to the first key to sort.
+    /// \param [out] keys_output - iterator to the first sorted key.
+    /// \returns \p hipSuccess (\p 0) after a successful launch, \p hipErrorInvalidValue if the
+    /// plan was not made successfully or \p temporary_storage is \p nullptr, otherwise a HIP
+    /// runtime error of type \p hipError_t.
+    template<class KeysInputIterator, class KeysOutputIterator>
+    hipError_t execute(void*              temporary_storage,
+                       KeysInputIterator  keys_input,
+                       KeysOutputIterator keys_output) const
+    {
+        static_assert(std::is_same<Value, empty_type>::value,
+                      "The plan sorts pairs, values must be passed to execute");
+        static_assert(
+            std::is_same<Key, typename std::iterator_traits<KeysInputIterator>::value_type>::value,
+            "The value_type of KeysInputIterator must be the key type of the plan");
+
+        empty_type* values = nullptr;
+        return run(temporary_storage,
+                   [&](void* storage, size_t& storage_size)
+                   {
+                       bool ignored;
+                       return detail::radix_sort_impl<Config, Descending>(storage,
+                                                                          storage_size,
+                                                                          keys_input,
+                                                                          nullptr,
+                                                                          keys_output,
+                                                                          values,
+                                                                          nullptr,
+                                                                          values,
+                                                                          size_,
+                                                                          ignored,
+                                                                          identity_decomposer{},
+                                                                          begin_bit_,
+                                                                          end_bit_,
+                                                                          stream_,
+                                                                          debug_synchronous_);
+                   });
+    }
+
+    /// \brief Sorts the (key, value) pairs with the plan.
+    ///
+    /// \param [in] temporary_storage - device-accessible temporary storage of at least
+    /// \p temporary_storage_bytes() bytes.
+    /// \param [in] keys_input - iterator to the first key to sort.
+    /// \param [out] keys_output - iterator to the first sorted key.
+    /// \param [in] values_input - iterator to the first value to sort.
+    /// \param [out] values_output - iterator to the first sorted value.
+    /// \returns \p hipSuccess (\p 0) after a successful launch, \p hipErrorInvalidValue if the
+    /// plan was not made successfully or \p temporary_storage is \p nullptr, otherwise a HIP
+    /// runtime error of type \p hipError_t.
+    template<class KeysInputIterator,
+             class KeysOutputIterator,
+             class ValuesInputIterator,
+             class ValuesOutputIterator>
+    hipError_t execute(void*                temporary_storage,
+                       KeysInputIterator    keys_input,
+                       KeysOutputIterator   keys_output,
+                       ValuesInputIterator  values_input,
+                       ValuesOutputIterator values_output) const
+    {
+        static_assert(
+            std::is_same<Key, typename std::iterator_traits<KeysInputIterator>::value_type>::value,
+            "The value_type of KeysInputIterator must be the key type of the plan");
+        static_assert(
+            std::is_same<Value,
+                         typename std::iterator_traits<ValuesInputIterator>::value_type>::value,
+            "The value_type of ValuesInputIterator must be the value type of the plan");
+
+        return run(temporary_storage,
+                   [&](void* storage, size_t& storage_size)
+                   {
+                       bool ignored;
+                       return detail::radix_sort_impl<Config, Descending>(storage,
+                                                                          storage_size,
+                                                                          keys_input,
+                                                                          nullptr,
+                                                                          keys_output,
+                                                                          values_input,
+                                                                          nullptr,
+                                                                          values_output,
+                                                                          size_,
+                                                                          ignored,
+                                                                          identity_decomposer{},
+                                                                          begin_bit_,
+                                                                          end_bit_,
+                                                                          stream_,
+                                                                          debug_synchronous_);
+                   });
+    }
+
+    /// \brief Number of items sorted by the plan.
+    Size size() const noexcept
+    {
+        return size_;
+    }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    // Called by make_radix_sort_plan
+    hipError_t init(const Size         size,
+                    const unsigned int begin_bit,
+                    const unsigned int end_bit,
+                    const hipStream_t  stream,
+                    const bool         debug_synchronous)
+    {
+        size_      = size;
+        begin_bit_ = begin_bit;
+        end_bit_   = end_bit;
+
+        const hipError_t result = init_device(stream, debug_synchronous);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        return init_storage_size(
+            [&](void* storage, size_t& storage_size)
+            {
+                Key*   keys   = nullptr;
+                Value* values = nullptr;
+                bool   ignored;
+                return detail::radix_sort_impl<Config, Descending>(storage,
+                                                                   storage_size,
+                                                                   keys,
+                                                                   nullptr,
+                                                                   keys,
+                                                                   values,
+                                                                   nullptr,
+                                                                   values,
+                                                                   size_,
+                                                                   ignored,
+                                                                   identity_decomposer{},
+                                                                   begin_bit_,
+                                                                   end_bit_,
+                                                                   stream_,
+                                                                   debug_synchronous_);
+            });
+    }
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+private:
+    Size         size_      = 0;
+    unsigned int begin_bit_ = 0;
+    unsigned int end_bit_   = 8 * sizeof(Key);
+};
+
+/// \brief Makes an execution plan of a device-level radix sort.
+///
+/// \param [out] plan - the plan to make, its template parameters select the key and value
+/// types, the order and the config of the sort.
+/// \param [in] size - number of items to sort.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in key
+/// comparison, see \p radix_sort_keys.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in key
+/// comparison, see \p radix_sort_keys.
+/// \param [in] stream - [optional] HIP stream object of every execution of the plan.
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+/// \returns \p hipSuccess (\p 0) if the plan was made; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<class Key, class Value, bool Descending, class Config, class Size>
+hipError_t make_radix_sort_plan(
+    radix_sort_plan<Key, Value, Descending, Config, Size>&                         plan,
+    const typename radix_sort_plan<Key, Value, Descending, Config, Size>::size_type size,
+    const unsigned int begin_bit         = 0,
+    const unsigned int end_bit           = 8 * sizeof(Key),
+    const hipStream_t  stream            = 0,
+    const bool         debug_synchronous = false)
+{
+    return plan.init(size, begin_bit, end_bit, stream, debug_synchronous);
+}
+
+/// \brief Execution plan of \p merge_sort for a fixed problem shape.
+///
+/// Like \p radix_sort_plan, the device of the stream and the size of the temporary storage are
+/// resolved once by \p make_merge_sort_plan.
+///
+/// \tparam Key - key type.
+/// \tparam Value - value type, \p empty_type to sort keys only.
+/// \tparam BinaryFunction - type of the comparison function.
+/// \tparam Config - [optional] configuration of the primitive, see \p merge_sort.
+template<class Key,
+         class Value          = empty_type,
+         class BinaryFunction = ::rocprim::less<Key>,
+         class Config         = default_config>
+class merge_sort_plan : public detail::execution_plan
+{
+public:
+    /// \brief Key type.
+    using key_type = Key;
+    /// \brief Value type.
+    using value_type = Value;
+
+    /// \brief Sorts the keys with the plan.
+    ///
+    /// \param [in] temporary_storage - device-accessible temporary storage of at least
+    /// \p temporary_storage_bytes() bytes.
+    /// \param [in] keys_input - iterator to the first key to sort.
+    /// \param [out] keys_output - iterator to the first sorted key.
+    /// \returns \p hipSuccess (\p 0) after a successful launch, \p hipErrorInvalidValue if the
+    /// plan was not made successfully or \p temporary_storage is \p nullptr, otherwise a HIP
+    /// runtime error of type \p hipError_t.
+    template<class KeysInputIterator, class KeysOutputIterator>
+    hipError_t execute(void*              temporary_storage,
+                       KeysInputIterator  keys_input,
+                       KeysOutputIterator keys_output) const
+    {
+        static_assert(std::is_same<Value, empty_type>::value,
+                      "The plan sorts pairs, values must be passed to execute");
+        static_assert(
+            std::is_same<Key, typename std::iterator_traits<KeysInputIterator>::value_type>::value,
+            "The value_type of KeysInputIterator must be the key type of the plan");
+
+        empty_type* values = nullptr;
+        return run(temporary_storage,
+                   [&](void* storage, size_t& storage_size)
+                   {
+                       return detail::merge_sort_impl<Config>(storage,
+                                                              storage_size,
+                                                              keys_input,
+                                                              keys_output,
+                                                              values,
+                                                              values,
+                                                              size_,
+                                                              compare_function_,
+                                                              stream_,
+                                                              debug_synchronous_);
+                   });
+    }
+
+    /// \brief Sorts the (key, value) pairs with the plan.
+    ///
+    /// \param [in] temporary_storage - device-accessible temporary storage of at least
+    /// \p temporary_storage_bytes() bytes.
+    /// \param [in] keys_input - iterator to the first key to sort.
+    /// \param [out] keys_output - iterator to the first sorted key.
+    /// \param [in] values_input - iterator to the first value to sort.
+    /// \param [out] values_output - iterator to the first sorted value.
+    /// \returns \p hipSuccess (\p 0) after a successful launch, \p hipErrorInvalidValue if the
+    /// plan was not made successfully or \p temporary_storage is \p nullptr, otherwise a HIP
+    /// runtime error of type \p hipError_t.
+    template<class KeysInputIterator,
+             class KeysOutputIterator,
+             class ValuesInputIterator,
+             class ValuesOutputIterator>
+    hipError_t execute(void*                temporary_storage,
+                       KeysInputIterator    keys_input,
+                       KeysOutputIterator   keys_output,
+                       ValuesInputIterator  values_input,
+                       ValuesOutputIterator values_output) const
+    {
+        static_assert(
+            std::is_same<Key, typename std::iterator_traits<KeysInputIterator>::value_type>::value,
+            "The value_type of KeysInputIterator must be the key type of the plan");
+        static_assert(
+            std::is_same<Value,
+                         typename std::iterator_traits<ValuesInputIterator>::value_type>::value,
+            "The value_type of ValuesInputIterator must be the value type of the plan");
+
+        return run(temporary_storage,
+                   [&](void* storage, size_t& storage_size)
+                   {
+                       return detail::merge_sort_impl<Config>(storage,
+                                                              storage_size,
+                                                              keys_input,
+                                                              keys_output,
+                                                              values_input,
+                                                              values_output,
+                                                              size_,
+                                                              compare_function_,
+                                                              stream_,
+                                                              debug_synchronous_);
+                   });
+    }
+
+    /// \brief Number of items sorted by the plan.
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    // Called by make_merge_sort_plan
+    hipError_t init(const size_t         size,
+                    const BinaryFunction compare_function,
+                    const hipStream_t    stream,
+                    const bool           debug_synchronous)
+    {
+        size_             = size;
+        compare_function_ = compare_function;
+
+        const hipError_t result = init_device(stream, debug_synchronous);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        return init_storage_size(
+            [&](void* storage, size_t& storage_size)
+            {
+                Key*   keys   = nullptr;
+                Value* values = nullptr;
+                return detail::merge_sort_impl<Config>(storage,
+                                                       storage_size,
+                                                       keys,
+                                                       keys,
+                                                       values,
+                                                       values,
+                                                       size_,
+                                                       compare_function_,
+                                                       stream_,
+                                                       debug_synchronous_);
+            });
+    }
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+private:
+    size_t         size_ = 0;
+    BinaryFunction compare_function_{};
+};
+
+/// \brief Makes an execution plan of a device-level merge sort.
+///
+/// \param [out] plan - the plan to make, its template parameters select the key and value
+/// types, the comparison function and the config of the sort.
+/// \param [in] size - number of items to sort.
+/// \param [in] compare_function - [optional] comparison function, default is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object of every execution of the plan.
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+/// \returns \p hipSuccess (\p 0) if the plan was made; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<class Key, class Value, class BinaryFunction, class Config>
+hipError_t make_merge_sort_plan(merge_sort_plan<Key, Value, BinaryFunction, Config>& plan,
+                                const size_t                                         size,
+                                const BinaryFunction compare_function  = BinaryFunction(),
+                                const hipStream_t    stream            = 0,
+                                const bool           debug_synchronous = false)
+{
+    return plan.init(size, compare_function, stream, debug_synchronous);
+}
+
+/// \brief Execution plan of \p reduce for a fixed problem shape.
+///
+/// Like \p radix_sort_plan, the device of the stream and the size of the temporary storage are
+/// resolved once by \p make_reduce_plan.
+///
+/// \tparam T - value type of the input.
+/// \tparam BinaryFunction - type of the reduction operator.
+/// \tparam Config - [optional] configuration of the primitive, see \p reduce.
+template<class T, class BinaryFunction = ::rocprim::plus<T>, class Config = default_config>
+class reduce_plan : public detail::execution_plan
+{
+public:
+    /// \brief Value type of the input.
+    using input_type = T;
+
+    /// \brief Reduces the input with the plan, the same as \p reduce without initial value.
+    ///
+    /// \param [in] temporary_storage - device-accessible temporary storage of at least
+    /// \p temporary_storage_bytes() bytes.
+    /// \param [in] input - iterator to the first value to reduce.
+    /// \param [out] output - iterator to the result.
+    /// \returns \p hipSuccess (\p 0) after a successful launch, \p hipErrorInvalidValue if the
+    /// plan was not made successfully or \p temporary_storage is \p nullptr, otherwise a HIP
+    /// runtime error of type \p hipError_t.
+    template<class InputIterator, class OutputIterator>
+    hipError_t
+        execute(void* temporary_storage, InputIterator input, OutputIterator output) const
+    {
+        static_assert(
+            std::is_same<T, typename std::iterator_traits<InputIterator>::value_type>::value,
+            "The value_type of InputIterator must be the input type of the plan");
+
+        return run(temporary_storage,
+                   [&](void* storage, size_t& storage_size)
+                   {
+                       return detail::reduce_impl<false, Config>(storage,
+                                                                 storage_size,
+                                                                 input,
+                                                                 output,
+                                                                 T(),
+                                                                 size_,
+                                                                 reduce_op_,
+                                                                 stream_,
+                                                                 debug_synchronous_);
+                   });
+    }
+
+    /// \brief Reduces the input with the plan, the same as \p reduce with initial value.
+    ///
+    /// \param [in] temporary_storage - device-accessible temporary storage of at least
+    /// \p temporary_storage_bytes() bytes.
+    /// \param [in] input - iterator to the first value to reduce.
+    /// \param [out] output - iterator to the result.
+    /// \param [in] initial_value - initial value of the reduction.
+    /// \returns \p hipSuccess (\p 0) after a successful launch, \p hipErrorInvalidValue if the
+    /// plan was not made successfully or \p temporary_storage is \p nullptr, otherwise a HIP
+    /// runtime error of type \p hipError_t.
+    template<class InputIterator, class OutputIterator, class InitValueType>
+    hipError_t execute(void*               temporary_storage,
+                       InputIterator       input,
+                       OutputIterator      output,
+                       const InitValueType initial_value) const
+    {
+        static_assert(
+            std::is_same<T, typename std::iterator_traits<InputIterator>::value_type>::value,
+            "The value_type of InputIterator must be the input type of the plan");
+
+        return run(temporary_storage,
+                   [&](void* storage, size_t& storage_size)
+                   {
+                       return detail::reduce_impl<true, Config>(storage,
+                                                                storage_size,
+                                                                input,
+                                                                output,
+                                                                initial_value,
+                                                                size_,
+                                                                reduce_op_,
+                                                                stream_,
+                                                                debug_synchronous_);
+                   });
+    }
+
+    /// \brief Number of items reduced by the plan.
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    // Called by make_reduce_plan
+    hipError_t init(const size_t         size,
+                    const BinaryFunction reduce_op,
+                    const hipStream_t    stream,
+                    const bool           debug_synchronous)
+    {
+        size_      = size;
+        reduce_op_ = reduce_op;
+
+        const hipError_t result = init_device(stream, debug_synchronous);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        // The temporary storage does not depend on the initial value
+        return init_storage_size(
+            [&](void* storage, size_t& storage_size)
+            {
+                using result_type =
+                    typename ::rocprim::invoke_result_binary_op<T, BinaryFunction>::type;
+                T*           input  = nullptr;
+                result_type* output = nullptr;
+                return detail::reduce_impl<false, Config>(storage,
+                                                          storage_size,
+                                                          input,
+                                                          output,
+                                                          T(),
+                                                          size_,
+                                                          reduce_op_,
+                                                          stream_,
+                                                          debug_synchronous_);
+            });
+    }
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+private:
+    size_t         size_ = 0;
+    BinaryFunction reduce_op_{};
+};
+
+/// \brief Makes an execution plan of a device-level reduction.
+///
+/// \param [out] plan - the plan to make, its template parameters select the input type, the
+/// reduction operator and the config of the reduction.
+/// \param [in] size - number of items to reduce.
+/// \param [in] reduce_op - [optional] reduction operator, default is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object of every execution of the plan.
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+/// \returns \p hipSuccess (\p 0) if the plan was made; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<class T, class BinaryFunction, class Config>
+hipError_t make_reduce_plan(reduce_plan<T, BinaryFunction, Config>& plan,
+                            const size_t                            size,
+                            const BinaryFunction                    reduce_op = BinaryFunction(),
+                            const hipStream_t                       stream    = 0,
+                            const bool debug_synchronous                      = false)
+{
+    return plan.init(size, reduce_op, stream, debug_synchronous);
+}
+
+namespace detail
+{
+
+// Common part of inclusive_scan_plan and exclusive_scan_plan
+template<bool Exclusive, class T, class BinaryFunction, class Config, class AccType>
+class scan_plan : public execution_plan
+{
+public:
+    /// \brief Value type of the input.
+    using input_type = T;
+    /// \brief Accumulator type of the scan.
+    using accumulator_type = AccType;
+
+    /// \brief Number of items scanned by the plan.
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    // Called by make_inclusive_scan_plan and make_exclusive_scan_plan
+    hipError_t init(const size_t         size,
+                    const BinaryFunction scan_op,
+                    const hipStream_t    stream,
+                    const bool           debug_synchronous)
+    {
+        size_    = size;
+        scan_op_ = scan_op;
+
+        const hipError_t result = init_device(stream, debug_synchronous);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        return init_storage_size(
+            [&](void* storage, size_t& storage_size)
+            {
+                T*       input  = nullptr;
+                AccType* output = nullptr;
+                return scan_impl<Exclusive, Config, T*, AccType*, AccType, BinaryFunction, AccType>(
+                    storage,
+                    storage_size,
+                    input,
+                    output,
+                    AccType{},
+                    size_,
+                    scan_op_,
+                    stream_,
+                    debug_synchronous_);
+            });
+    }
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+protected:
+    template<class InputIterator, class OutputIterator>
+    hipError_t execute_scan(void*          temporary_storage,
+                            InputIterator  input,
+                            OutputIterator output,
+                            const AccType  initial_value) const
+    {
+        static_assert(
+            std::is_same<T, typename std::iterator_traits<InputIterator>::value_type>::value,
+            "The value_type of InputIterator must be the input type of the plan");
+
+        return run(
+            temporary_storage,
+            [&](void* storage, size_t& storage_size)
+            {
+                return scan_impl<Exclusive,
+                                 Config,
+                                 InputIterator,
+                                 OutputIterator,
+                                 AccType,
+                                 BinaryFunction,
+                                 AccType>(storage,
+                                          storage_size,
+                                          input,
+                                          output,
+                                          initial_value,
+                                          size_,
+                                          scan_op_,
+                                          stream_,
+                                          debug_synchronous_);
+            });
+    }
+
+private:
+    size_t         size_ = 0;
+    BinaryFunction scan_op_{};
+};
+
+} // end namespace detail
+
+/// \brief Execution plan of \p inclusive_scan for a fixed problem shape.
+///
+/// Like \p radix_sort_plan, the device of the stream and the size of the temporary storage are
+/// resolved once by \p make_inclusive_scan_plan.
+///
+/// \tparam T - value type of the input.
+/// \tparam BinaryFunction - type of the scan operator.
+/// \tparam Config - [optional] configuration of the primitive, see \p inclusive_scan.
+/// \tparam AccType - [optional] accumulator type of the scan, default is \p T.
+template<class T,
+         class BinaryFunction = ::rocprim::plus<T>,
+         class Config         = default_config,
+         class AccType        = T>
+class inclusive_scan_plan : public detail::scan_plan<false, T, BinaryFunction, Config, AccType>
+{
+public:
+    /// \brief Scans the input with the plan.
+    ///
+    /// \param [in] temporary_storage - device-accessible temporary storage of at least
+    /// \p temporary_storage_bytes() bytes.
+    /// \param [in] input - iterator to the first value to scan.
+    /// \param [out] output - iterator to the first scanned value.
+    /// \returns \p hipSuccess (\p 0) after a successful launch, \p hipErrorInvalidValue if the
+    /// plan was not made successfully or \p temporary_storage is \p nullptr, otherwise a HIP
+    /// runtime error of type \p hipError_t.
+    template<class InputIterator, class OutputIterator>
+    hipError_t
+        execute(void* temporary_storage, InputIterator input, OutputIterator output) const
+    {
+        // The initial value is not used by inclusive scans
+        return this->execute_scan(temporary_storage, input, output, AccType{});
+    }
+};
+
+/// \brief Execution plan of \p exclusive_scan for a fixed problem shape.
+///
+/// Like \p radix_sort_plan, the device of the stream and the size of the temporary storage are
+/// resolved once by \p make_exclusive_scan_plan.
+///
+/// \tparam T - value type of the input.
+/// \tparam BinaryFunction - type of the scan operator.
+/// \tparam Config - [optional] configuration of the primitive, see \p exclusive_scan.
+/// \tparam AccType - [optional] accumulator type of the scan, default is \p T.
+template<class T,
+         class BinaryFunction = ::rocprim::plus<T>,
+         class Config         = default_config,
+         class AccType        = T>
+class exclusive_scan_plan : public detail::scan_plan<true, T, BinaryFunction, Config, AccType>
+{
+public:
+    /// \brief Scans the input with the plan.
+    ///
+    /// \param [in] temporary_storage - device-accessible temporary storage of at least
+    /// \p temporary_storage_bytes() bytes.
+    /// \param [in] input - iterator to the first value to scan.
+    /// \param [out] output - iterator to the first scanned value.
+    /// \param [in] initial_value - initial value of the scan, it can differ between executions.
+    /// \returns \p hipSuccess (\p 0) after a successful launch, \p hipErrorInvalidValue if the
+    /// plan was not made successfully or \p temporary_storage is \p nullptr, otherwise a HIP
+    /// runtime error of type \p hipError_t.
+    template<class InputIterator, class OutputIterator>
+    hipError_t execute(void*          temporary_storage,
+                       InputIterator  input,
+                       OutputIterator output,
+                       const AccType  initial_value) const
+    {
+        return this->execute_scan(temporary_storage, input, output, initial_value);
+    }
+};
+
+/// \brief Makes an execution plan of a device-level inclusive scan.
+///
+/// \param [out] plan - the plan to make, its template parameters select the input type, the
+/// scan operator, the config and the accumulator type of the scan.
+/// \param [in] size - number of items to scan.
+/// \param [in] scan_op - [optional] scan operator, default is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object of every execution of the plan.
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+/// \returns \p hipSuccess (\p 0) if the plan was made; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<class T, class BinaryFunction, class Config, class AccType>
+hipError_t
+    make_inclusive_scan_plan(inclusive_scan_plan<T, BinaryFunction, Config, AccType>& plan,
+                             const size_t                                             size,
+                             const BinaryFunction scan_op           = BinaryFunction(),
+                             const hipStream_t    stream            = 0,
+                             const bool           debug_synchronous = false)
+{
+    return plan.init(size, scan_op, stream, debug_synchronous);
+}
+
+/// \brief Makes an execution plan of a device-level exclusive scan.
+///
+/// \param [out] plan - the plan to make, its template parameters select the input type, the
+/// scan operator, the config and the accumulator type of the scan.
+/// \param [in] size - number of items to scan.
+/// \param [in] scan_op - [optional] scan operator, default is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object of every execution of the plan.
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+/// \returns \p hipSuccess (\p 0) if the plan was made; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<class T, class BinaryFunction, class Config, class AccType>
+hipError_t
+    make_exclusive_scan_plan(exclusive_scan_plan<T, BinaryFunction, Config, AccType>& plan,
+                             const size_t                                             size,
+                             const BinaryFunction scan_op           = BinaryFunction(),
+                             const hipStream_t    stream            = 0,
+                             const bool           debug_synchronous = false)
+{
+    return plan.init(size, scan_op, stream, debug_synchronous);
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_PLAN_HPP_
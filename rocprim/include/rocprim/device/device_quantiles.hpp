@@ -0,0 +1,465 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_QUANTILES_HPP_
+#define ROCPRIM_DEVICE_DEVICE_QUANTILES_HPP_
+
+#include <chrono>
+#include <climits>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/temp_storage.hpp"
+#include "../detail/various.hpp"
+#include "../iterator/transform_iterator.hpp"
+#include "../thread/radix_key_codec.hpp"
+
+#include "config_types.hpp"
+#include "detail/device_config_helper.hpp"
+#include "detail/device_quantiles.hpp"
+#include "device_histogram.hpp"
+#include "device_radix_sort.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+/// \brief Selects how \p quantiles computes the requested quantiles.
+enum class quantiles_mode
+{
+    /// The quantiles are exact: they are keys of the input.
+    exact,
+    /// The quantiles are computed with a single histogram pass over the input. An approximate
+    /// quantile is the smallest value whose radix-encoded 16 most significant bits are the same
+    /// as the ones of the exact quantile, so it is never larger than the exact quantile.
+    approximate
+};
+
+namespace detail
+{
+
+template<class QuantilesIterator>
+ROCPRIM_KERNEL __launch_bounds__(quantiles_block_size) void
+    quantiles_init_kernel(QuantilesIterator quantiles,
+                          unsigned int      count,
+                          unsigned int      size,
+                          unsigned int*     query_indices,
+                          unsigned int*     ranks)
+{
+    quantiles_init(quantiles, count, size, query_indices, ranks);
+}
+
+template<class BitKey>
+ROCPRIM_KERNEL __launch_bounds__(quantiles_block_size) void
+    quantiles_select_kernel(const unsigned int* histogram,
+                            unsigned int        digit_bits,
+                            unsigned int        count,
+                            unsigned int*       ranks,
+                            const BitKey*       prefixes_input,
+                            BitKey*             prefixes_output)
+{
+    quantiles_select<quantiles_block_size>(histogram,
+                                           digit_bits,
+                                           count,
+                                           ranks,
+                                           prefixes_input,
+                                           prefixes_output);
+}
+
+template<class Key, class BitKey, class KeysOutputIterator>
+ROCPRIM_KERNEL __launch_bounds__(quantiles_block_size) void
+    quantiles_output_kernel(const unsigned int* query_indices,
+                            const BitKey*       prefixes,
+                            unsigned int        count,
+                            unsigned int        shift,
+                            KeysOutputIterator  keys_output)
+{
+    quantiles_output<Key>(query_indices, prefixes, count, shift, keys_output);
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
+    {                                                                                            \
+        auto _error = hipGetLastError();                                                         \
+        if(_error != hipSuccess)                                                                 \
+            return _error;                                                                       \
+        if(debug_synchronous)                                                                    \
+        {                                                                                        \
+            std::cout << name << "(" << size << ")";                                             \
+            auto __error = hipStreamSynchronize(stream);                                         \
+            if(__error != hipSuccess)                                                            \
+                return __error;                                                                  \
+            auto _end = std::chrono::high_resolution_clock::now();                               \
+            auto _d   = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n';                              \
+        }                                                                                        \
+    }
+
+// The histogram passes only have a single channel of unsigned int digits. The sort-based
+// histogram is disabled by default: the digits of a pass are never more than the keys.
+template<class Config>
+using quantiles_histogram_config_t = typename std::
+    conditional<std::is_same<Config, default_config>::value,
+                histogram_config<kernel_config<256, 8>, 1024, 2048, 3, UINT_MAX>,
+                Config>::type;
+
+template<class Config,
+         class KeysInputIterator,
+         class QuantilesIterator,
+         class KeysOutputIterator>
+inline hipError_t quantiles_impl(void*              temporary_storage,
+                                 size_t&            storage_size,
+                                 KeysInputIterator  keys_input,
+                                 unsigned int       size,
+                                 QuantilesIterator  quantiles,
+                                 unsigned int       quantiles_count,
+                                 KeysOutputIterator keys_output,
+                                 quantiles_mode     mode,
+                                 hipStream_t        stream,
+                                 bool               debug_synchronous)
+{
+    using key_type     = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using codec_type   = ::rocprim::radix_key_codec<key_type>;
+    using bit_key_type = typename codec_type::bit_key_type;
+    using digit_op     = quantiles_digit_op<key_type, bit_key_type>;
+    using config       = quantiles_histogram_config_t<Config>;
+
+    constexpr unsigned int key_bits    = sizeof(bit_key_type) * 8;
+    constexpr unsigned int coarse_bits = ::rocprim::min(quantiles_coarse_digit_bits, key_bits);
+    constexpr unsigned int refine_bits = quantiles_refine_digit_bits;
+
+    if(quantiles_count > quantiles_max_count)
+    {
+        return hipErrorInvalidValue;
+    }
+
+    // The coarse pass has a single histogram slot (all prefixes are empty), the refine passes
+    // have a slot per query
+    const unsigned int coarse_bins = 1u << coarse_bits;
+    const unsigned int refine_bins = quantiles_count << refine_bits;
+    const unsigned int max_bins    = ::rocprim::max(coarse_bins, refine_bins);
+
+    // All passes and the sort of the queries use the same storage, take the largest requirement
+    size_t algorithm_storage_size = 0;
+    for(unsigned int bins : {coarse_bins, refine_bins})
+    {
+        size_t     pass_storage_size;
+        hipError_t result = ::rocprim::histogram_even<config>(
+            nullptr,
+            pass_storage_size,
+            make_transform_iterator(keys_input, digit_op{}),
+            size,
+            static_cast<unsigned int*>(nullptr),
+            bins + 1,
+            0u,
+            bins,
+            stream,
+            debug_synchronous);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        algorithm_storage_size = ::rocprim::max(algorithm_storage_size, pass_storage_size);
+    }
+
+    // The ranks are less than size, only their significant bits are sorted
+    unsigned int rank_bits = 1;
+    while(rank_bits < 32 && ((size - 1) >> rank_bits) != 0)
+    {
+        ++rank_bits;
+    }
+
+    size_t     sort_storage_size;
+    hipError_t result
+        = ::rocprim::radix_sort_pairs(nullptr,
+                                      sort_storage_size,
+                                      static_cast<unsigned int*>(nullptr),
+                                      static_cast<unsigned int*>(nullptr),
+                                      static_cast<unsigned int*>(nullptr),
+                                      static_cast<unsigned int*>(nullptr),
+                                      quantiles_count,
+                                      0,
+                                      rank_bits,
+                                      stream,
+                                      debug_synchronous);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    algorithm_storage_size = ::rocprim::max(algorithm_storage_size, sort_storage_size);
+
+    unsigned int* unsorted_query_indices = nullptr;
+    unsigned int* unsorted_ranks         = nullptr;
+    unsigned int* query_indices          = nullptr;
+    unsigned int* ranks                  = nullptr;
+    bit_key_type* prefixes[2]            = {nullptr, nullptr};
+    unsigned int* histogram              = nullptr;
+    void*         algorithm_storage      = nullptr;
+
+    result = detail::temp_storage::partition(
+        temporary_storage,
+        storage_size,
+        detail::temp_storage::make_linear_partition(
+            detail::temp_storage::ptr_aligned_array(&unsorted_query_indices, quantiles_count),
+            detail::temp_storage::ptr_aligned_array(&unsorted_ranks, quantiles_count),
+            detail::temp_storage::ptr_aligned_array(&query_indices, quantiles_count),
+            detail::temp_storage::ptr_aligned_array(&ranks, quantiles_count),
+            detail::temp_storage::ptr_aligned_array(&prefixes[0], quantiles_count),
+            detail::temp_storage::ptr_aligned_array(&prefixes[1], quantiles_count),
+            detail::temp_storage::ptr_aligned_array(&histogram, max_bins),
+            detail::temp_storage::make_partition(&algorithm_storage, algorithm_storage_size)));
+    if(result != hipSuccess || temporary_storage == nullptr)
+    {
+        return result;
+    }
+
+    if(size == 0u || quantiles_count == 0u)
+    {
+        return hipSuccess;
+    }
+
+    const unsigned int queries_grid_size = ceiling_div(quantiles_count, quantiles_block_size);
+
+    if(debug_synchronous)
+    {
+        std::cout << "size " << size << '\n';
+        std::cout << "quantiles_count " << quantiles_count << '\n';
+    }
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+    {
+        start = std::chrono::high_resolution_clock::now();
+    }
+    quantiles_init_kernel<<<dim3(queries_grid_size), dim3(quantiles_block_size), 0, stream>>>(
+        quantiles,
+        quantiles_count,
+        size,
+        unsorted_query_indices,
+        unsorted_ranks);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("quantiles_init_kernel", quantiles_count, start);
+
+    // The sort is stable, queries of the same rank stay in the order of their indices
+    result = ::rocprim::radix_sort_pairs(algorithm_storage,
+                                         algorithm_storage_size,
+                                         unsorted_ranks,
+                                         ranks,
+                                         unsorted_query_indices,
+                                         query_indices,
+                                         quantiles_count,
+                                         0,
+                                         rank_bits,
+                                         stream,
+                                         debug_synchronous);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    // All prefixes are empty before the coarse pass
+    result = hipMemsetAsync(prefixes[0], 0, quantiles_count * sizeof(bit_key_type), stream);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    // Radix select from the most significant digit. The approximate mode stops after the
+    // coarse pass.
+    unsigned int shift       = key_bits;
+    unsigned int digit_bits  = coarse_bits;
+    unsigned int bins        = coarse_bins;
+    unsigned int current     = 0;
+    const bool   approximate = mode == quantiles_mode::approximate;
+    do
+    {
+        shift -= digit_bits;
+
+        const digit_op op{prefixes[current], quantiles_count, shift, digit_bits, bins};
+        result = ::rocprim::histogram_even<config>(algorithm_storage,
+                                                   algorithm_storage_size,
+                                                   make_transform_iterator(keys_input, op),
+                                                   size,
+                                                   histogram,
+                                                   bins + 1,
+                                                   0u,
+                                                   bins,
+                                                   stream,
+                                                   debug_synchronous);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+
+        if(debug_synchronous)
+        {
+            start = std::chrono::high_resolution_clock::now();
+        }
+        quantiles_select_kernel<<<dim3(quantiles_count), dim3(quantiles_block_size), 0, stream>>>(
+            histogram,
+            digit_bits,
+            quantiles_count,
+            ranks,
+            prefixes[current],
+            prefixes[current ^ 1]);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("quantiles_select_kernel",
+                                                    quantiles_count,
+                                                    start);
+
+        current ^= 1;
+        digit_bits = ::rocprim::min(refine_bits, shift);
+        bins       = quantiles_count << digit_bits;
+    }
+    while(shift > 0 && !approximate);
+
+    if(debug_synchronous)
+    {
+        start = std::chrono::high_resolution_clock::now();
+    }
+    quantiles_output_kernel<key_type>
+        <<<dim3(queries_grid_size), dim3(quantiles_block_size), 0, stream>>>(query_indices,
+                                                                             prefixes[current],
+                                                                             quantiles_count,
+                                                                             shift,
+                                                                             keys_output);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("quantiles_output_kernel", quantiles_count, start);
+
+    return hipSuccess;
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // namespace detail
+
+/// \brief Computes quantiles of a sequence of keys.
+///
+/// \par
+/// * The quantile \p q of \p size keys is the key of rank <tt>floor(q * (size - 1))</tt> in the
+/// sorted keys, where \p q is clamped to [0, 1].
+/// * Up to <tt>2^24 - 1</tt> quantiles can be requested with a single call, they are computed
+/// together. The queries are sorted by rank with \p radix_sort_pairs.
+/// * The keys are not sorted: the quantiles are found with radix select. Every pass computes a
+/// histogram (\p histogram_even) of a digit of the radix-encoded keys (see \p radix_key_codec):
+/// first a coarse pass of the 16 most significant bits of all keys, then refine passes of 8 bits
+/// of the keys in the buckets containing the requested ranks.
+/// * In \p quantiles_mode::approximate mode only the coarse pass is performed. The result is then
+/// the smallest value of the bucket containing the exact quantile: it is not larger than the
+/// exact quantile and it has the same 16 most significant bits.
+/// * Keys are compared like by \p radix_sort_keys, e.g. -0.0 is less than +0.0.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+///
+/// \tparam Config - [optional] configuration of the histogram passes. It has to be
+/// \p histogram_config or a class derived from it.
+/// \tparam KeysInputIterator - random-access iterator type of the input keys. It can be
+/// a simple pointer type. The key type must be supported by \p radix_key_codec.
+/// \tparam QuantilesIterator - random-access iterator type of the requested quantiles,
+/// the value type must be convertible to \p double. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. It can be
+/// a simple pointer type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - iterator to the first element in the range of keys.
+/// \param [in] size - number of keys.
+/// \param [in] quantiles - iterator to the first requested quantile, in device memory.
+/// \param [in] quantiles_count - number of requested quantiles.
+/// \param [out] keys_output - iterator to the first element in the range of quantiles, the
+/// quantile of <tt>quantiles[i]</tt> is stored to <tt>keys_output[i]</tt>.
+/// \param [in] mode - [optional] exact or approximate quantiles. Default is
+/// \p quantiles_mode::exact.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful operation; \p hipErrorInvalidValue if
+/// \p quantiles_count is larger than <tt>2^24 - 1</tt>; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example the median and the quartiles of an array of floats are computed.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// unsigned int size;   // e.g., 9
+/// float * keys;        // e.g., [8.0, 1.0, 7.0, 2.0, 6.0, 3.0, 5.0, 4.0, 0.0]
+/// double * quantiles;  // e.g., [0.5, 0.25, 0.75]
+/// float * output;      // empty array of 3 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::quantiles(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     keys, size, quantiles, 3, output
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // compute quantiles
+/// rocprim::quantiles(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     keys, size, quantiles, 3, output
+/// );
+/// // output: [4.0, 2.0, 6.0]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class KeysInputIterator,
+         class QuantilesIterator,
+         class KeysOutputIterator>
+inline hipError_t quantiles(void*              temporary_storage,
+                            size_t&            storage_size,
+                            KeysInputIterator  keys_input,
+                            unsigned int       size,
+                            QuantilesIterator  quantiles,
+                            unsigned int       quantiles_count,
+                            KeysOutputIterator keys_output,
+                            quantiles_mode     mode              = quantiles_mode::exact,
+                            hipStream_t        stream            = 0,
+                            bool               debug_synchronous = false)
+{
+    return detail::quantiles_impl<Config>(temporary_storage,
+                                          storage_size,
+                                          keys_input,
+                                          size,
+                                          quantiles,
+                                          quantiles_count,
+                                          keys_output,
+                                          mode,
+                                          stream,
+                                          debug_synchronous);
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_QUANTILES_HPP_
@@ -37,6 +37,7 @@
 #include "../type_traits.hpp"
 #include "detail/config/device_radix_sort_onesweep.hpp"
 #include "detail/device_radix_sort.hpp"
+#include "device_trace.hpp"
 #include "device_transform.hpp"
 #include "specialization/device_radix_block_sort.hpp"
 #include "specialization/device_radix_merge_sort.hpp"
@@ -200,6 +201,11 @@ hipError_t radix_sort_onesweep_global_offsets(KeysInputIterator keys_input,
                        begin_bit,
                        end_bit);
     ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("compute_global_digit_histograms", size, start);
+    trace_kernel("compute_global_digit_histograms",
+                 size,
+                 blocks,
+                 params.histogram.block_size,
+                 params.histogram.items_per_thread);
 
     // Scan each histogram separately to get the final offsets.
     if(debug_synchronous)
@@ -215,6 +221,11 @@ hipError_t radix_sort_onesweep_global_offsets(KeysInputIterator keys_input,
                        global_digit_offsets);
 
     ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("scan_global_digit_histograms", bins, start);
+    trace_kernel("scan_global_digit_histograms",
+                 bins,
+                 digit_places,
+                 params.histogram.block_size,
+                 0);
     return hipSuccess;
 }
 
@@ -432,6 +443,11 @@ hipError_t radix_sort_onesweep_iteration(
         }
 
         ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("onesweep_iteration", size, start);
+        trace_kernel("onesweep_iteration",
+                     current_batch_size,
+                     blocks,
+                     params.sort.block_size,
+                     params.sort.items_per_thread);
 
         std::swap(global_digit_offsets_in, global_digit_offsets_out);
     }
@@ -521,6 +537,8 @@ hipError_t radix_sort_onesweep_impl(
     if(size == 0)
         return hipSuccess;
 
+    trace_algorithm trace("radix_sort", storage_size, stream);
+
     if(debug_synchronous)
     {
         std::cout << "radix_size " << radix_size_per_place << '\n';
@@ -587,6 +605,7 @@ hipError_t radix_sort_onesweep_impl(
                 if(error != hipSuccess)
                     return error;
             }
+            restart_trace_timer();
 
             from_input = false;
         }
@@ -707,6 +726,7 @@ hipError_t
             return hipSuccess;
         }
         is_result_in_output = true;
+        trace_algorithm trace("radix_sort", storage_size, stream);
         // block_sort_config is never default_config
         return radix_sort_block_sort<block_sort_config, Descending>(keys_input,
                                                                     keys_output,
@@ -744,23 +764,31 @@ hipError_t
     }
     else
     {
-        // note: Config::onesweep_config may be default_config
+        // note: Config::onesweep_config may be default_config, which may be tuned for the
+        // size of the input
         using onesweep_config = typename Config::onesweep_config;
-        return radix_sort_onesweep_impl<onesweep_config, Descending>(temporary_storage,
-                                                                     storage_size,
-                                                                     keys_input,
-                                                                     keys_tmp,
-                                                                     keys_output,
-                                                                     values_input,
-                                                                     values_tmp,
-                                                                     values_output,
-                                                                     size,
-                                                                     is_result_in_output,
-                                                                     decomposer,
-                                                                     begin_bit,
-                                                                     end_bit,
-                                                                     stream,
-                                                                     debug_synchronous);
+        return dispatch_size_bucket<onesweep_config,
+                                    default_radix_sort_onesweep_config_size_bucketed::value>(
+            size,
+            [&](auto config_identity)
+            {
+                using config = typename decltype(config_identity)::type;
+                return radix_sort_onesweep_impl<config, Descending>(temporary_storage,
+                                                                    storage_size,
+                                                                    keys_input,
+                                                                    keys_tmp,
+                                                                    keys_output,
+                                                                    values_input,
+                                                                    values_tmp,
+                                                                    values_output,
+                                                                    size,
+                                                                    is_result_in_output,
+                                                                    decomposer,
+                                                                    begin_bit,
+                                                                    end_bit,
+                                                                    stream,
+                                                                    debug_synchronous);
+            });
     }
 }
 
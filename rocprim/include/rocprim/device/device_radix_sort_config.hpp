@@ -1,4 +1,4 @@
-// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2022-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -87,6 +87,21 @@ struct wrapped_radix_sort_onesweep_config<default_config, Key, Value>
     };
 };
 
+// Default config tuned for the input sizes of a size bucket, see dispatch_size_bucket
+template<size_bucket Bucket, typename Key, typename Value>
+struct wrapped_radix_sort_onesweep_config<default_bucket_config<Bucket>, Key, Value>
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        static constexpr radix_sort_onesweep_config_params params
+            = default_radix_sort_onesweep_bucket_config<static_cast<unsigned int>(Arch),
+                                                        Bucket,
+                                                        Key,
+                                                        Value>();
+    };
+};
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 template<typename RadixSortOnesweepConfig, typename Key, typename Value>
 template<target_arch Arch>
@@ -99,6 +114,12 @@ template<target_arch Arch>
 constexpr radix_sort_onesweep_config_params
     wrapped_radix_sort_onesweep_config<default_config, Key, Value>::architecture_config<
         Arch>::params;
+
+template<size_bucket Bucket, typename Key, typename Value>
+template<target_arch Arch>
+constexpr radix_sort_onesweep_config_params
+    wrapped_radix_sort_onesweep_config<default_bucket_config<Bucket>, Key, Value>::
+        architecture_config<Arch>::params;
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 // Sub-algorithm block_sort:
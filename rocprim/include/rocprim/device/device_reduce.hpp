@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <type_traits>
 
 #include "config_types.hpp"
@@ -34,7 +35,10 @@
 
 #include "detail/device_config_helper.hpp"
 #include "detail/device_reduce.hpp"
+#include "detail/persistent_grid.hpp"
+#include "detail/runtime_tuning.hpp"
 #include "device_reduce_config.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -64,6 +68,20 @@ ROCPRIM_KERNEL
     );
 }
 
+template<class Config,
+         class ResultType,
+         class InputIterator,
+         class OutputIterator,
+         class BinaryFunction>
+ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().reduce_config.block_size) void
+    persistent_block_reduce_kernel(InputIterator  input,
+                                   const size_t   size,
+                                   OutputIterator output,
+                                   BinaryFunction reduce_op)
+{
+    persistent_block_reduce_kernel_impl<Config, ResultType>(input, size, output, reduce_op);
+}
+
 #define ROCPRIM_DETAIL_HIP_SYNC(name, size, start) \
     if(debug_synchronous) \
     { \
@@ -99,16 +117,15 @@ template<
     class InitValueType,
     class BinaryFunction
 >
-inline
-hipError_t reduce_impl(void * temporary_storage,
-                       size_t& storage_size,
-                       InputIterator input,
-                       OutputIterator output,
-                       const InitValueType initial_value,
-                       const size_t size,
-                       BinaryFunction reduce_op,
-                       const hipStream_t stream,
-                       bool debug_synchronous)
+inline hipError_t reduce_impl_with_config(void*               temporary_storage,
+                                          size_t&             storage_size,
+                                          InputIterator       input,
+                                          OutputIterator      output,
+                                          const InitValueType initial_value,
+                                          const size_t        size,
+                                          BinaryFunction      reduce_op,
+                                          const hipStream_t   stream,
+                                          bool                debug_synchronous)
 {
     using input_type = typename std::iterator_traits<InputIterator>::value_type;
     using result_type =
@@ -139,15 +156,15 @@ hipError_t reduce_impl(void * temporary_storage,
     if(number_of_blocks > 1)
     {
         const hipError_t nested_result
-            = reduce_impl<WithInitialValue, Config>(nullptr,
-                                                    nested_temp_storage_size,
-                                                    block_prefixes, // input
-                                                    output, // output
-                                                    initial_value,
-                                                    number_of_blocks, // input size
-                                                    reduce_op,
-                                                    stream,
-                                                    debug_synchronous);
+            = reduce_impl_with_config<WithInitialValue, Config>(nullptr,
+                                                                nested_temp_storage_size,
+                                                                block_prefixes, // input
+                                                                output, // output
+                                                                initial_value,
+                                                                number_of_blocks, // input size
+                                                                reduce_op,
+                                                                stream,
+                                                                debug_synchronous);
         if(nested_result != hipSuccess)
         {
             return nested_result;
@@ -167,6 +184,8 @@ hipError_t reduce_impl(void * temporary_storage,
         return partition_result;
     }
 
+    trace_algorithm trace("reduce", storage_size, stream);
+
     // Start point for time measurements
     std::chrono::high_resolution_clock::time_point start;
 
@@ -181,7 +200,76 @@ hipError_t reduce_impl(void * temporary_storage,
         std::cout << "items_per_block " << items_per_block << '\n';
     }
 
-    if(number_of_blocks > 1)
+    // The persistent kernel is only instantiated for configs that launch it on some architecture
+    using persistent_launch
+        = std::integral_constant<bool,
+                                 any_target_arch_params<config>(
+                                     &reduce_config_params::launch_mode,
+                                     ::rocprim::grid_launch_mode::persistent)>;
+    const bool persistent = persistent_launch::value
+                            && params.launch_mode == ::rocprim::grid_launch_mode::persistent;
+
+    if(number_of_blocks > 1 && persistent)
+    {
+        // A single launch of a persistent grid, every block reduces a part of the tiles. The
+        // temporary storage is computed for one block per tile, which is enough for fewer blocks.
+        return static_branch<config>(
+            persistent_launch{},
+            [&](auto config_identity)
+            {
+                using launch_config = typename decltype(config_identity)::type;
+                unsigned int grid_size;
+                hipError_t   error = get_persistent_grid_size(
+                    persistent_block_reduce_kernel<launch_config,
+                                                   result_type,
+                                                   InputIterator,
+                                                   result_type*,
+                                                   BinaryFunction>,
+                    block_size,
+                    static_cast<unsigned int>(
+                        std::min<size_t>(number_of_blocks, std::numeric_limits<unsigned int>::max())),
+                    stream,
+                    grid_size);
+                if(error != hipSuccess)
+                {
+                    return error;
+                }
+                if(debug_synchronous)
+                {
+                    std::cout << "grid_size " << grid_size << '\n';
+                    start = std::chrono::high_resolution_clock::now();
+                }
+                persistent_block_reduce_kernel<launch_config, result_type>
+                    <<<dim3(grid_size), dim3(block_size), 0, stream>>>(input,
+                                                                       size,
+                                                                       block_prefixes,
+                                                                       reduce_op);
+                ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("persistent_block_reduce_kernel",
+                                                            size,
+                                                            start);
+                trace_kernel("persistent_block_reduce_kernel",
+                             size,
+                             grid_size,
+                             block_size,
+                             items_per_thread);
+
+                if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+                error = reduce_impl_with_config<WithInitialValue, Config>(nested_temp_storage,
+                                                                          nested_temp_storage_size,
+                                                                          block_prefixes, // input
+                                                                          output, // output
+                                                                          initial_value,
+                                                                          grid_size, // input size
+                                                                          reduce_op,
+                                                                          stream,
+                                                                          debug_synchronous);
+                if(error != hipSuccess) return error;
+                ROCPRIM_DETAIL_HIP_SYNC("nested_device_reduce", grid_size, start);
+                return hipSuccess;
+            },
+            [](auto) { return hipSuccess; });
+    }
+    else if(number_of_blocks > 1)
     {
         const auto    aligned_size_limit = number_of_blocks_limit * items_per_block;
 
@@ -204,18 +292,24 @@ hipError_t reduce_impl(void * temporary_storage,
                 initial_value,
                 reduce_op);
             ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("block_reduce_kernel", current_size, start);
+            trace_kernel("block_reduce_kernel",
+                         current_size,
+                         current_blocks,
+                         block_size,
+                         items_per_thread);
         }
 
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-        auto error = reduce_impl<WithInitialValue, Config>(nested_temp_storage,
-                                                           nested_temp_storage_size,
-                                                           block_prefixes, // input
-                                                           output, // output
-                                                           initial_value,
-                                                           number_of_blocks, // input size
-                                                           reduce_op,
-                                                           stream,
-                                                           debug_synchronous);
+        auto error = reduce_impl_with_config<WithInitialValue, Config>(
+            nested_temp_storage,
+            nested_temp_storage_size,
+            block_prefixes, // input
+            output, // output
+            initial_value,
+            number_of_blocks, // input size
+            reduce_op,
+            stream,
+            debug_synchronous);
         if(error != hipSuccess) return error;
         ROCPRIM_DETAIL_HIP_SYNC("nested_device_reduce", number_of_blocks, start);
     }
@@ -228,11 +322,61 @@ hipError_t reduce_impl(void * temporary_storage,
             input, size, output, initial_value, reduce_op
         );
         ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("block_reduce_kernel", size, start);
+        trace_kernel("block_reduce_kernel", size, 1, block_size, items_per_thread);
     }
 
     return hipSuccess;
 }
 
+template<bool WithInitialValue, // true when inital_value should be used in reduction
+         class Config,
+         class InputIterator,
+         class OutputIterator,
+         class InitValueType,
+         class BinaryFunction>
+inline hipError_t reduce_impl(void*               temporary_storage,
+                              size_t&             storage_size,
+                              InputIterator       input,
+                              OutputIterator      output,
+                              const InitValueType initial_value,
+                              const size_t        size,
+                              BinaryFunction      reduce_op,
+                              const hipStream_t   stream,
+                              bool                debug_synchronous)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    using result_type =
+        typename ::rocprim::invoke_result_binary_op<input_type, BinaryFunction>::type;
+
+    // The default config may be tuned for the size of the input. The nested reductions of the
+    // block results keep the config of the whole reduction.
+    return dispatch_size_bucket<Config, default_reduce_config_size_bucketed::value>(
+        size,
+        [&](auto bucket_config_identity)
+        {
+            using bucket_config = typename decltype(bucket_config_identity)::type;
+            return dispatch_runtime_tuning<bucket_config, result_type>(
+                "reduce",
+                temporary_storage,
+                storage_size,
+                size,
+                stream,
+                [&](auto config_identity)
+                {
+                    using config = typename decltype(config_identity)::type;
+                    return reduce_impl_with_config<WithInitialValue, config>(temporary_storage,
+                                                                             storage_size,
+                                                                             input,
+                                                                             output,
+                                                                             initial_value,
+                                                                             size,
+                                                                             reduce_op,
+                                                                             stream,
+                                                                             debug_synchronous);
+                });
+        });
+}
+
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
 #undef ROCPRIM_DETAIL_HIP_SYNC
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2018-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -57,6 +57,24 @@ struct wrapped_reduce_config<default_config, Value>
     };
 };
 
+// Default config tuned for the input sizes of a size bucket, see dispatch_size_bucket
+template<size_bucket Bucket, typename Value>
+struct wrapped_reduce_config<default_bucket_config<Bucket>, Value>
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        static constexpr reduce_config_params params
+            = default_reduce_bucket_config<static_cast<unsigned int>(Arch), Bucket, Value>();
+    };
+};
+
+// Config of another architecture, see detail/runtime_tuning.hpp
+template<typename Config, target_arch Arch, typename Value>
+struct wrapped_reduce_config<fixed_arch_config<Config, Arch>, Value>
+    : wrapped_fixed_arch_config<wrapped_reduce_config<Config, Value>, Arch>
+{};
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 template<typename ReduceConfig, typename Value>
 template<target_arch Arch>
@@ -67,6 +85,11 @@ template<typename Value>
 template<target_arch Arch>
 constexpr reduce_config_params
     wrapped_reduce_config<default_config, Value>::architecture_config<Arch>::params;
+
+template<size_bucket Bucket, typename Value>
+template<target_arch Arch>
+constexpr reduce_config_params
+    wrapped_reduce_config<default_bucket_config<Bucket>, Value>::architecture_config<Arch>::params;
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 } // namespace detail
@@ -0,0 +1,372 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+#ifndef ROCPRIM_DEVICE_DEVICE_RUN_LENGTH_DECODE_HPP_
+#define ROCPRIM_DEVICE_DEVICE_RUN_LENGTH_DECODE_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/temp_storage.hpp"
+#include "../detail/various.hpp"
+#include "../functional.hpp"
+#include "../iterator/discard_iterator.hpp"
+
+#include "detail/device_run_length_decode.hpp"
+#include "detail/persistent_grid.hpp"
+#include "device_run_length_decode_config.hpp"
+#include "device_scan.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+namespace detail
+{
+
+template<bool WithRelativeOffsets,
+         class Config,
+         class ValuesInputIterator,
+         class OffsetType,
+         class OutputIterator,
+         class RelativeOffsetsOutputIterator>
+ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().kernel_config.block_size) void
+    run_length_decode_kernel(ValuesInputIterator           values,
+                             const OffsetType*             ends,
+                             const size_t                  num_runs,
+                             OutputIterator                output,
+                             RelativeOffsetsOutputIterator relative_offsets)
+{
+    run_length_decode_kernel_impl<WithRelativeOffsets, Config>(values,
+                                                               ends,
+                                                               num_runs,
+                                                               output,
+                                                               relative_offsets);
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
+    {                                                                                            \
+        auto _error = hipGetLastError();                                                         \
+        if(_error != hipSuccess)                                                                 \
+            return _error;                                                                       \
+        if(debug_synchronous)                                                                    \
+        {                                                                                        \
+            std::cout << name << "(" << size << ")";                                             \
+            auto __error = hipStreamSynchronize(stream);                                         \
+            if(__error != hipSuccess)                                                            \
+                return __error;                                                                  \
+            auto _end = std::chrono::high_resolution_clock::now();                               \
+            auto _d   = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n';                              \
+        }                                                                                        \
+    }
+
+// The type of the offsets of the decoded items: the run length type, widened to at least
+// unsigned int.
+template<class RunLength>
+using run_length_decode_offset_t = typename std::make_unsigned<
+    typename std::conditional<(sizeof(RunLength) < sizeof(unsigned int)),
+                              unsigned int,
+                              RunLength>::type>::type;
+
+template<bool WithRelativeOffsets,
+         class Config,
+         class ValuesInputIterator,
+         class RunLengthsInputIterator,
+         class OutputIterator,
+         class RelativeOffsetsOutputIterator>
+inline hipError_t run_length_decode_impl(void*                         temporary_storage,
+                                         size_t&                       storage_size,
+                                         ValuesInputIterator           values,
+                                         RunLengthsInputIterator       run_lengths,
+                                         const size_t                  num_runs,
+                                         OutputIterator                output,
+                                         RelativeOffsetsOutputIterator relative_offsets,
+                                         const hipStream_t             stream,
+                                         bool                          debug_synchronous)
+{
+    using value_type  = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    using length_type = typename std::iterator_traits<RunLengthsInputIterator>::value_type;
+    static_assert(std::is_integral<length_type>::value,
+                  "The value type of RunLengthsInputIterator must be an integral type");
+    using offset_type = run_length_decode_offset_t<length_type>;
+
+    using config = wrapped_run_length_decode_config<Config, value_type>;
+
+    detail::target_arch target_arch;
+    hipError_t          result = host_target_arch(stream, target_arch);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    const run_length_decode_config_params params = dispatch_target_arch<config>(target_arch);
+
+    const unsigned int block_size = params.kernel_config.block_size;
+
+    offset_type* ends         = nullptr;
+    void*        scan_storage = nullptr;
+    size_t       scan_storage_size;
+    result = ::rocprim::inclusive_scan(nullptr,
+                                       scan_storage_size,
+                                       run_lengths,
+                                       ends,
+                                       num_runs,
+                                       ::rocprim::plus<offset_type>(),
+                                       stream,
+                                       debug_synchronous);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    result = detail::temp_storage::partition(
+        temporary_storage,
+        storage_size,
+        detail::temp_storage::make_linear_partition(
+            detail::temp_storage::ptr_aligned_array(&ends, num_runs),
+            detail::temp_storage::make_partition(&scan_storage, scan_storage_size)));
+    if(result != hipSuccess || temporary_storage == nullptr)
+    {
+        return result;
+    }
+
+    if(num_runs == 0u)
+    {
+        return hipSuccess;
+    }
+
+    // The end offsets of the runs in the output
+    result = ::rocprim::inclusive_scan(scan_storage,
+                                       scan_storage_size,
+                                       run_lengths,
+                                       ends,
+                                       num_runs,
+                                       ::rocprim::plus<offset_type>(),
+                                       stream,
+                                       debug_synchronous);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    // The number of outputs is only known on the device, launch enough blocks to fill it
+    unsigned int grid_size;
+    result = get_persistent_grid_size(run_length_decode_kernel<WithRelativeOffsets,
+                                                               config,
+                                                               ValuesInputIterator,
+                                                               offset_type,
+                                                               OutputIterator,
+                                                               RelativeOffsetsOutputIterator>,
+                                      block_size,
+                                      stream,
+                                      grid_size);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    if(debug_synchronous)
+    {
+        std::cout << "num_runs " << num_runs << '\n';
+        std::cout << "block_size " << block_size << '\n';
+        std::cout << "items_per_thread " << params.kernel_config.items_per_thread << '\n';
+        std::cout << "grid_size " << grid_size << '\n';
+    }
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+    {
+        start = std::chrono::high_resolution_clock::now();
+    }
+    run_length_decode_kernel<WithRelativeOffsets, config>
+        <<<dim3(grid_size), dim3(block_size), 0, stream>>>(values,
+                                                           ends,
+                                                           num_runs,
+                                                           output,
+                                                           relative_offsets);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("run_length_decode_kernel", num_runs, start);
+
+    return hipSuccess;
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // end of detail namespace
+
+/// \brief Parallel run-length decoding for device level.
+///
+/// run_length_decode function performs a device-wide run-length decoding: every value
+/// <tt>values[i]</tt> is repeated <tt>run_lengths[i]</tt> times in \p output. It is the
+/// inverse of \p run_length_encode.
+///
+/// The end offsets of the runs are computed with an inclusive scan of the run lengths, then the
+/// output is split into tiles with a merge-path search over these offsets, so
+/// every block decodes the same number of runs and items whatever the lengths of the runs are.
+/// The tiles are decoded with \p block_run_length_decode.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p values and \p run_lengths must have at least \p num_runs elements.
+/// * Range specified by \p output must have at least as many elements as the sum of
+/// the run lengths. It must fit in the type of the run lengths (or <tt>unsigned int</tt> if it is
+/// smaller).
+/// * Run lengths must not be negative. Runs of length 0 are allowed anywhere.
+///
+/// \tparam Config - [optional] configuration of the primitive, has to be
+/// \p run_length_decode_config or \p default_config.
+/// \tparam ValuesInputIterator - random-access iterator type of the run values. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam RunLengthsInputIterator - random-access iterator type of the run lengths. Must meet
+/// the requirements of a C++ InputIterator concept. It can be a simple pointer type. Its value
+/// type must be integral.
+/// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] values - iterator to the first value of the runs.
+/// \param [in] run_lengths - iterator to the first length of the runs.
+/// \param [in] num_runs - number of runs.
+/// \param [out] output - iterator to the first element in the decoded range.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful decoding; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level run-length decoding is performed on an array of
+/// integer values.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t num_runs;            // e.g., 4
+/// int * values;               // e.g., [1, 2, 3, 4]
+/// unsigned int * run_lengths; // e.g., [2, 0, 3, 1]
+/// int * output;               // empty array of 6 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::run_length_decode(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     values, run_lengths, num_runs, output
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform decoding
+/// rocprim::run_length_decode(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     values, run_lengths, num_runs, output
+/// );
+/// // output: [1, 1, 3, 3, 3, 4]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class ValuesInputIterator,
+         class RunLengthsInputIterator,
+         class OutputIterator>
+inline hipError_t run_length_decode(void*                   temporary_storage,
+                                    size_t&                 storage_size,
+                                    ValuesInputIterator     values,
+                                    RunLengthsInputIterator run_lengths,
+                                    const size_t            num_runs,
+                                    OutputIterator          output,
+                                    const hipStream_t       stream            = 0,
+                                    bool                    debug_synchronous = false)
+{
+    return detail::run_length_decode_impl<false, Config>(temporary_storage,
+                                                         storage_size,
+                                                         values,
+                                                         run_lengths,
+                                                         num_runs,
+                                                         output,
+                                                         ::rocprim::make_discard_iterator(),
+                                                         stream,
+                                                         debug_synchronous);
+}
+
+/// \brief Parallel run-length decoding with relative offsets for device level.
+///
+/// Same as the \p run_length_decode above, but it also writes the offset of every decoded item
+/// in its run to \p relative_offsets, e.g. the runs <tt>[3, 1, 4]</tt> with lengths
+/// <tt>[2, 1, 3]</tt> are decoded to <tt>[3, 3, 1, 4, 4, 4]</tt> with the relative offsets
+/// <tt>[0, 1, 0, 0, 1, 2]</tt>.
+///
+/// \par Overview
+/// * Range specified by \p relative_offsets must have as many elements as \p output.
+///
+/// \tparam RelativeOffsetsOutputIterator - random-access iterator type of the relative offsets.
+/// Must meet the requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [out] relative_offsets - iterator to the first relative offset of the decoded items.
+///
+/// \returns \p hipSuccess (\p 0) after successful decoding; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<class Config = default_config,
+         class ValuesInputIterator,
+         class RunLengthsInputIterator,
+         class OutputIterator,
+         class RelativeOffsetsOutputIterator,
+         typename std::enable_if<!std::is_integral<RelativeOffsetsOutputIterator>::value
+                                     && !std::is_convertible<RelativeOffsetsOutputIterator,
+                                                             hipStream_t>::value,
+                                 int>::type
+         = 0>
+inline hipError_t run_length_decode(void*                         temporary_storage,
+                                    size_t&                       storage_size,
+                                    ValuesInputIterator           values,
+                                    RunLengthsInputIterator       run_lengths,
+                                    const size_t                  num_runs,
+                                    OutputIterator                output,
+                                    RelativeOffsetsOutputIterator relative_offsets,
+                                    const hipStream_t             stream            = 0,
+                                    bool                          debug_synchronous = false)
+{
+    return detail::run_length_decode_impl<true, Config>(temporary_storage,
+                                                        storage_size,
+                                                        values,
+                                                        run_lengths,
+                                                        num_runs,
+                                                        output,
+                                                        relative_offsets,
+                                                        stream,
+                                                        debug_synchronous);
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_RUN_LENGTH_DECODE_HPP_
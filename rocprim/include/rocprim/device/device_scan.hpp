@@ -34,7 +34,12 @@
 #include "detail/config/device_scan.hpp"
 #include "detail/device_scan.hpp"
 #include "detail/device_scan_common.hpp"
+#include "detail/device_scan_reduce_then_scan.hpp"
+#include "detail/persistent_grid.hpp"
+#include "detail/runtime_tuning.hpp"
 #include "device_scan_config.hpp"
+#include "device_scan_state.hpp"
+#include "device_trace.hpp"
 #include "device_transform.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -146,12 +151,117 @@ ROCPRIM_KERNEL
         scan_op,
         lookback_scan_state,
         number_of_blocks,
+        ::rocprim::detail::block_id<0>(),
         previous_last_element,
         new_last_element,
         override_first_value,
         save_last_value);
 }
 
+// Look-back scan with a persistent grid, tiles are processed in the order of ordered_tile_id
+template<bool Exclusive,
+         class Config,
+         class InputIterator,
+         class OutputIterator,
+         class BinaryFunction,
+         class InitValueType,
+         class AccType,
+         class LookBackScanState>
+ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().kernel_config.block_size) void
+    persistent_lookback_scan_kernel(InputIterator                  input,
+                                    OutputIterator                 output,
+                                    const size_t                   size,
+                                    const InitValueType            initial_value,
+                                    BinaryFunction                 scan_op,
+                                    LookBackScanState              lookback_scan_state,
+                                    const unsigned int             number_of_blocks,
+                                    ordered_block_id<unsigned int> ordered_tile_id,
+                                    AccType*                       previous_last_element,
+                                    AccType*                       new_last_element,
+                                    bool                           override_first_value,
+                                    bool                           save_last_value)
+{
+    const AccType value = static_cast<AccType>(get_input_value(initial_value));
+    for_each_ordered_tile(ordered_tile_id,
+                          number_of_blocks,
+                          [&](const unsigned int tile_id)
+                          {
+                              lookback_scan_kernel_impl<Exclusive, Config>(input,
+                                                                           output,
+                                                                           size,
+                                                                           value,
+                                                                           scan_op,
+                                                                           lookback_scan_state,
+                                                                           number_of_blocks,
+                                                                           tile_id,
+                                                                           previous_last_element,
+                                                                           new_last_element,
+                                                                           override_first_value,
+                                                                           save_last_value);
+                          });
+}
+
+// Reduce-then-scan kernels
+
+template<class Config, class InputIterator, class BinaryFunction, class AccType>
+ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().kernel_config.block_size) void
+    reduce_then_scan_reduce_kernel(InputIterator  input,
+                                   BinaryFunction scan_op,
+                                   AccType*       block_prefixes)
+{
+    reduce_then_scan_reduce_kernel_impl<Config>(input, scan_op, block_prefixes);
+}
+
+template<bool Exclusive, class Config, class BinaryFunction, class InitValueType, class AccType>
+ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().kernel_config.block_size) void
+    reduce_then_scan_spine_kernel(AccType*            block_prefixes,
+                                  const unsigned int  number_of_blocks,
+                                  const InitValueType initial_value,
+                                  BinaryFunction      scan_op,
+                                  const AccType*      carry,
+                                  const bool          use_carry)
+{
+    reduce_then_scan_spine_kernel_impl<Exclusive, Config>(
+        block_prefixes,
+        number_of_blocks,
+        static_cast<AccType>(get_input_value(initial_value)),
+        scan_op,
+        carry,
+        use_carry);
+}
+
+template<bool Exclusive,
+         class Config,
+         class InputIterator,
+         class OutputIterator,
+         class BinaryFunction,
+         class InitValueType,
+         class AccType>
+ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().kernel_config.block_size) void
+    reduce_then_scan_downsweep_kernel(InputIterator       input,
+                                      OutputIterator      output,
+                                      const size_t        size,
+                                      const InitValueType initial_value,
+                                      BinaryFunction      scan_op,
+                                      const AccType*      block_prefixes,
+                                      const unsigned int  number_of_blocks,
+                                      const bool          use_carry,
+                                      AccType*            carry,
+                                      const bool          save_carry)
+{
+    reduce_then_scan_downsweep_kernel_impl<Exclusive, Config>(
+        input,
+        output,
+        size,
+        static_cast<AccType>(get_input_value(initial_value)),
+        scan_op,
+        block_prefixes,
+        number_of_blocks,
+        use_carry,
+        carry,
+        save_carry);
+}
+
 #define ROCPRIM_DETAIL_HIP_SYNC(name, size, start) \
     if(debug_synchronous) \
     { \
@@ -185,28 +295,165 @@ template<bool Exclusive,
          class InitValueType,
          class BinaryFunction,
          class AccType>
-inline auto scan_impl(void*               temporary_storage,
-                      size_t&             storage_size,
-                      InputIterator       input,
-                      OutputIterator      output,
-                      const InitValueType initial_value,
-                      const size_t        size,
-                      BinaryFunction      scan_op,
-                      const hipStream_t   stream,
-                      bool                debug_synchronous)
+inline hipError_t reduce_then_scan_impl(void*                    temporary_storage,
+                                        size_t&                  storage_size,
+                                        InputIterator            input,
+                                        OutputIterator           output,
+                                        const InitValueType      initial_value,
+                                        const size_t             size,
+                                        BinaryFunction           scan_op,
+                                        const scan_config_params params,
+                                        const hipStream_t        stream,
+                                        bool                     debug_synchronous,
+                                        const AccType*           carry_in  = nullptr,
+                                        AccType*                 carry_out = nullptr)
 {
-    using config = wrapped_scan_config<Config, AccType>;
+    const unsigned int block_size       = params.kernel_config.block_size;
+    const unsigned int items_per_thread = params.kernel_config.items_per_thread;
+    const auto         items_per_block  = block_size * items_per_thread;
 
-    detail::target_arch target_arch;
-    hipError_t          result = host_target_arch(stream, target_arch);
-    if(result != hipSuccess)
+    const size_t size_limit = params.kernel_config.size_limit;
+    const size_t aligned_size_limit
+        = ::rocprim::max<size_t>(size_limit - size_limit % items_per_block, items_per_block);
+    const size_t limited_size     = std::min<size_t>(size, aligned_size_limit);
+    const bool   use_limited_size = limited_size == aligned_size_limit;
+
+    const unsigned int number_of_blocks = (limited_size + items_per_block - 1) / items_per_block;
+
+    // block_prefixes[b] is the exclusive prefix of block b after the spine kernel,
+    // carry is the inclusive total of all previous launches.
+    AccType* block_prefixes;
+    AccType* carry;
+
+    const hipError_t partition_result = detail::temp_storage::partition(
+        temporary_storage,
+        storage_size,
+        detail::temp_storage::make_linear_partition(
+            detail::temp_storage::ptr_aligned_array(&block_prefixes, number_of_blocks),
+            detail::temp_storage::ptr_aligned_array(&carry, use_limited_size ? 1 : 0)));
+    if(partition_result != hipSuccess || temporary_storage == nullptr)
     {
-        return result;
+        return partition_result;
     }
-    const scan_config_params params = dispatch_target_arch<config>(target_arch);
 
-    using scan_state_type            = detail::lookback_scan_state<AccType>;
-    using scan_state_with_sleep_type = detail::lookback_scan_state<AccType, true>;
+    if(number_of_blocks == 0u)
+        return hipSuccess;
+
+    trace_algorithm trace(Exclusive ? "exclusive_scan" : "inclusive_scan", storage_size, stream);
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+
+    const size_t number_of_launch = (size + limited_size - 1) / limited_size;
+    for(size_t i = 0, offset = 0; i < number_of_launch; i++, offset += limited_size)
+    {
+        const size_t       current_size = std::min<size_t>(size - offset, limited_size);
+        const unsigned int current_blocks
+            = (current_size + items_per_block - 1) / items_per_block;
+        const bool is_last_launch = i + 1 == number_of_launch;
+        // The first launch continues from carry_in, the last one stores its total to carry_out
+        const bool     use_carry = i != size_t(0) || carry_in != nullptr;
+        const AccType* in_carry  = i == size_t(0) ? carry_in : carry;
+        const bool     save_carry = !is_last_launch || carry_out != nullptr;
+        AccType*       out_carry  = is_last_launch ? carry_out : carry;
+
+        if(debug_synchronous)
+        {
+            std::cout << "use_limited_size " << use_limited_size << '\n';
+            std::cout << "aligned_size_limit " << aligned_size_limit << '\n';
+            std::cout << "number_of_launch " << number_of_launch << '\n';
+            std::cout << "index " << i << '\n';
+            std::cout << "size " << current_size << '\n';
+            std::cout << "block_size " << block_size << '\n';
+            std::cout << "number of blocks " << current_blocks << '\n';
+            std::cout << "items_per_block " << items_per_block << '\n';
+        }
+
+        if(current_blocks > 1)
+        {
+            if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+            reduce_then_scan_reduce_kernel<Config>
+                <<<dim3(current_blocks - 1), dim3(block_size), 0, stream>>>(input + offset,
+                                                                            scan_op,
+                                                                            block_prefixes);
+            ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("reduce_then_scan_reduce_kernel",
+                                                        current_size,
+                                                        start)
+            trace_kernel("reduce_then_scan_reduce_kernel",
+                         current_size,
+                         current_blocks - 1,
+                         block_size,
+                         items_per_thread);
+        }
+
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        reduce_then_scan_spine_kernel<Exclusive, Config, BinaryFunction, InitValueType, AccType>
+            <<<dim3(1), dim3(block_size), 0, stream>>>(block_prefixes,
+                                                       current_blocks,
+                                                       initial_value,
+                                                       scan_op,
+                                                       in_carry,
+                                                       use_carry);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("reduce_then_scan_spine_kernel",
+                                                    current_blocks,
+                                                    start)
+        trace_kernel("reduce_then_scan_spine_kernel", current_blocks, 1, block_size, 0);
+
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        reduce_then_scan_downsweep_kernel<Exclusive,
+                                          Config,
+                                          InputIterator,
+                                          OutputIterator,
+                                          BinaryFunction,
+                                          InitValueType,
+                                          AccType>
+            <<<dim3(current_blocks), dim3(block_size), 0, stream>>>(input + offset,
+                                                                    output + offset,
+                                                                    current_size,
+                                                                    initial_value,
+                                                                    scan_op,
+                                                                    block_prefixes,
+                                                                    current_blocks,
+                                                                    use_carry,
+                                                                    out_carry,
+                                                                    save_carry);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("reduce_then_scan_downsweep_kernel",
+                                                    current_size,
+                                                    start)
+        trace_kernel("reduce_then_scan_downsweep_kernel",
+                     current_size,
+                     current_blocks,
+                     block_size,
+                     items_per_thread);
+    }
+    return hipSuccess;
+}
+
+template<bool Exclusive,
+         class Config,
+         class ScanState,
+         class ScanStateWithSleep,
+         class InputIterator,
+         class OutputIterator,
+         class InitValueType,
+         class BinaryFunction,
+         class AccType>
+inline hipError_t lookback_scan_impl(void*                    temporary_storage,
+                                     size_t&                  storage_size,
+                                     InputIterator            input,
+                                     OutputIterator           output,
+                                     const InitValueType      initial_value,
+                                     const size_t             size,
+                                     BinaryFunction           scan_op,
+                                     const scan_config_params params,
+                                     const hipStream_t        stream,
+                                     bool                     debug_synchronous,
+                                     AccType*                 carry_in  = nullptr,
+                                     AccType*                 carry_out = nullptr)
+{
+    using config                     = Config;
+    using scan_state_type            = ScanState;
+    using scan_state_with_sleep_type = ScanStateWithSleep;
 
     const unsigned int block_size       = params.kernel_config.block_size;
     const unsigned int items_per_thread = params.kernel_config.items_per_thread;
@@ -220,10 +467,23 @@ inline auto scan_impl(void*               temporary_storage,
 
     unsigned int number_of_blocks = (limited_size + items_per_block - 1)/items_per_block;
 
+    // Tiles of a persistent grid are handed out in order, a tile only waits for the look-back
+    // of tiles that are already processed
+    // The persistent kernels are only instantiated for configs that launch them on some
+    // architecture
+    using persistent_launch
+        = std::integral_constant<bool,
+                                 any_target_arch_params<config>(
+                                     &scan_config_params::launch_mode,
+                                     ::rocprim::grid_launch_mode::persistent)>;
+    const bool persistent = persistent_launch::value
+                            && params.launch_mode == ::rocprim::grid_launch_mode::persistent;
+
     // Pointer to array with block_prefixes
-    void*    scan_state_storage;
-    AccType* previous_last_element;
-    AccType* new_last_element;
+    void*                                    scan_state_storage;
+    AccType*                                 previous_last_element;
+    AccType*                                 new_last_element;
+    ordered_block_id<unsigned int>::id_type* ordered_tile_id_storage;
 
     detail::temp_storage::layout layout{};
     hipError_t                   layout_result
@@ -241,7 +501,8 @@ inline auto scan_impl(void*               temporary_storage,
             detail::temp_storage::make_partition(&scan_state_storage, layout),
             detail::temp_storage::ptr_aligned_array(&previous_last_element,
                                                     use_limited_size ? 1 : 0),
-            detail::temp_storage::ptr_aligned_array(&new_last_element, use_limited_size ? 1 : 0)));
+            detail::temp_storage::ptr_aligned_array(&new_last_element, use_limited_size ? 1 : 0),
+            detail::temp_storage::ptr_aligned_array(&ordered_tile_id_storage, persistent ? 1 : 0)));
     if(partition_result != hipSuccess || temporary_storage == nullptr)
     {
         return partition_result;
@@ -253,7 +514,10 @@ inline auto scan_impl(void*               temporary_storage,
     if( number_of_blocks == 0u )
         return hipSuccess;
 
-    if(number_of_blocks > 1 || use_limited_size)
+    trace_algorithm trace(Exclusive ? "exclusive_scan" : "inclusive_scan", storage_size, stream);
+
+    const bool use_carry = carry_in != nullptr || carry_out != nullptr;
+    if(number_of_blocks > 1 || use_limited_size || use_carry)
     {
         // Create and initialize lookback_scan_state obj
         scan_state_type scan_state{};
@@ -269,18 +533,46 @@ inline auto scan_impl(void*               temporary_storage,
             return result;
         }
 
-        hipDeviceProp_t prop;
-        int deviceId;
-        static_cast<void>(hipGetDevice(&deviceId));
-        static_cast<void>(hipGetDeviceProperties(&prop, deviceId));
+        bool use_sleep;
+        result = is_sleep_scan_state_used(use_sleep);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
 
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
 
-#if HIP_VERSION >= 307
-        int asicRevision = prop.asicRevision;
-#else
-        int asicRevision = 0;
-#endif
+        const auto ordered_tile_id
+            = ordered_block_id<unsigned int>::create(ordered_tile_id_storage);
+
+        // The persistent scan kernel also needs its ordered tile id to be reset
+        const auto init_scan_state = [&](auto lookback_scan_state, const unsigned int grid_size)
+        {
+            using state_type        = decltype(lookback_scan_state);
+            const auto init_regular = [&](auto)
+            {
+                init_lookback_scan_state_kernel<state_type>
+                    <<<dim3(grid_size), dim3(block_size), 0, stream>>>(lookback_scan_state,
+                                                                       number_of_blocks);
+                return hipSuccess;
+            };
+            return static_branch<state_type>(
+                persistent_launch{},
+                [&](auto state_identity)
+                {
+                    using launch_state_type = typename decltype(state_identity)::type;
+                    if(!persistent)
+                    {
+                        return init_regular(state_identity);
+                    }
+                    init_lookback_scan_state_kernel<launch_state_type>
+                        <<<dim3(grid_size), dim3(block_size), 0, stream>>>(lookback_scan_state,
+                                                                           number_of_blocks,
+                                                                           ordered_tile_id);
+                    return hipSuccess;
+                },
+                init_regular);
+        };
 
         size_t number_of_launch = (size + limited_size - 1)/limited_size;
         for (size_t i = 0, offset = 0; i < number_of_launch; i++, offset+=limited_size )
@@ -289,6 +581,13 @@ inline auto scan_impl(void*               temporary_storage,
             number_of_blocks = (current_size + items_per_block - 1)/items_per_block;
             auto grid_size = (number_of_blocks + block_size - 1)/block_size;
 
+            // The first launch continues from carry_in, the last one stores its total to carry_out
+            const bool is_last_launch       = i + 1 == number_of_launch;
+            AccType*   in_last_element      = i == size_t(0) ? carry_in : previous_last_element;
+            AccType*   out_last_element     = is_last_launch ? carry_out : new_last_element;
+            const bool override_first_value = in_last_element != nullptr;
+            const bool save_last_value      = out_last_element != nullptr;
+
             if(debug_synchronous)
             {
                 std::cout << "use_limited_size " << use_limited_size << '\n';
@@ -301,42 +600,115 @@ inline auto scan_impl(void*               temporary_storage,
                 std::cout << "items_per_block " << items_per_block << '\n';
             }
 
-            if(std::string(prop.gcnArchName).find("908") != std::string::npos && asicRevision < 2)
+            if(use_sleep)
             {
-                init_lookback_scan_state_kernel<scan_state_with_sleep_type>
-                    <<<dim3(grid_size), dim3(block_size), 0, stream>>>(scan_state_with_sleep,
-                                                                       number_of_blocks);
+                init_scan_state(scan_state_with_sleep, grid_size);
             } else
             {
-                init_lookback_scan_state_kernel<scan_state_type>
-                    <<<dim3(grid_size), dim3(block_size), 0, stream>>>(scan_state,
-                                                                       number_of_blocks);
+                init_scan_state(scan_state, grid_size);
             }
             ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_lookback_scan_state_kernel", number_of_blocks, start)
+            trace_kernel("init_lookback_scan_state_kernel",
+                         number_of_blocks,
+                         grid_size,
+                         block_size,
+                         0);
 
-            if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+            // Both scan states use the same resources, the occupancy of one kernel is enough
             grid_size = number_of_blocks;
-            if(std::string(prop.gcnArchName).find("908") != std::string::npos && asicRevision < 2)
+            if(persistent)
+            {
+                result = static_branch<config>(
+                    persistent_launch{},
+                    [&](auto config_identity)
+                    {
+                        using launch_config = typename decltype(config_identity)::type;
+                        return get_persistent_grid_size(
+                            persistent_lookback_scan_kernel<Exclusive,
+                                                            launch_config,
+                                                            InputIterator,
+                                                            OutputIterator,
+                                                            BinaryFunction,
+                                                            InitValueType,
+                                                            AccType,
+                                                            scan_state_type>,
+                            block_size,
+                            number_of_blocks,
+                            stream,
+                            grid_size);
+                    },
+                    [](auto) { return hipSuccess; });
+                if(result != hipSuccess)
+                {
+                    return result;
+                }
+            }
+
+            const auto launch_scan_kernel = [&](auto lookback_scan_state)
             {
-                lookback_scan_kernel<Exclusive, // flag for exclusive scan operation
-                                     config,
-                                     InputIterator,
-                                     OutputIterator,
-                                     BinaryFunction,
-                                     InitValueType,
-                                     AccType,
-                                     scan_state_with_sleep_type>
-                    <<<dim3(grid_size), dim3(block_size), 0, stream>>>(input + offset,
-                                                                       output + offset,
-                                                                       current_size,
-                                                                       initial_value,
-                                                                       scan_op,
-                                                                       scan_state_with_sleep,
-                                                                       number_of_blocks,
-                                                                       previous_last_element,
-                                                                       new_last_element,
-                                                                       i != size_t(0),
-                                                                       number_of_launch > 1);
+                using state_type          = decltype(lookback_scan_state);
+                const auto launch_regular = [&](auto)
+                {
+                    lookback_scan_kernel<Exclusive, // flag for exclusive scan operation
+                                         config,
+                                         InputIterator,
+                                         OutputIterator,
+                                         BinaryFunction,
+                                         InitValueType,
+                                         AccType,
+                                         state_type>
+                        <<<dim3(grid_size), dim3(block_size), 0, stream>>>(input + offset,
+                                                                           output + offset,
+                                                                           current_size,
+                                                                           initial_value,
+                                                                           scan_op,
+                                                                           lookback_scan_state,
+                                                                           number_of_blocks,
+                                                                           in_last_element,
+                                                                           out_last_element,
+                                                                           override_first_value,
+                                                                           save_last_value);
+                    return hipSuccess;
+                };
+                return static_branch<config>(
+                    persistent_launch{},
+                    [&](auto config_identity)
+                    {
+                        using launch_config = typename decltype(config_identity)::type;
+                        if(!persistent)
+                        {
+                            return launch_regular(config_identity);
+                        }
+                        persistent_lookback_scan_kernel<Exclusive,
+                                                        launch_config,
+                                                        InputIterator,
+                                                        OutputIterator,
+                                                        BinaryFunction,
+                                                        InitValueType,
+                                                        AccType,
+                                                        state_type>
+                            <<<dim3(grid_size), dim3(block_size), 0, stream>>>(
+                                input + offset,
+                                output + offset,
+                                current_size,
+                                initial_value,
+                                scan_op,
+                                lookback_scan_state,
+                                number_of_blocks,
+                                ordered_tile_id,
+                                in_last_element,
+                                out_last_element,
+                                override_first_value,
+                                save_last_value);
+                        return hipSuccess;
+                    },
+                    launch_regular);
+            };
+
+            if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+            if(use_sleep)
+            {
+                launch_scan_kernel(scan_state_with_sleep);
             }
             else
             {
@@ -348,32 +720,19 @@ inline auto scan_impl(void*               temporary_storage,
                     std::cout << "block_size " << block_size << '\n';
                     std::cout << "number of blocks " << number_of_blocks << '\n';
                     std::cout << "items_per_block " << items_per_block << '\n';
+                    std::cout << "grid_size " << grid_size << '\n';
                 }
-
-                lookback_scan_kernel<Exclusive, // flag for exclusive scan operation
-                                     config,
-                                     InputIterator,
-                                     OutputIterator,
-                                     BinaryFunction,
-                                     InitValueType,
-                                     AccType,
-                                     scan_state_type>
-                    <<<dim3(grid_size), dim3(block_size), 0, stream>>>(input + offset,
-                                                                       output + offset,
-                                                                       current_size,
-                                                                       initial_value,
-                                                                       scan_op,
-                                                                       scan_state,
-                                                                       number_of_blocks,
-                                                                       previous_last_element,
-                                                                       new_last_element,
-                                                                       i != size_t(0),
-                                                                       number_of_launch > 1);
+                launch_scan_kernel(scan_state);
             }
             ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("lookback_scan_kernel", current_size, start)
+            trace_kernel("lookback_scan_kernel",
+                         current_size,
+                         grid_size,
+                         block_size,
+                         items_per_thread);
 
             // Swap the last_elements
-            if(number_of_launch > 1)
+            if(!is_last_launch)
             {
                 hipError_t error = ::rocprim::transform(new_last_element,
                                                         previous_last_element,
@@ -382,6 +741,7 @@ inline auto scan_impl(void*               temporary_storage,
                                                         stream,
                                                         debug_synchronous);
                 if(error != hipSuccess) return error;
+                restart_trace_timer();
             }
         }
     }
@@ -405,10 +765,206 @@ inline auto scan_impl(void*               temporary_storage,
                            AccType>
             <<<dim3(1), dim3(block_size), 0, stream>>>(input, size, initial_value, output, scan_op);
         ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("single_scan_kernel", size, start);
+        trace_kernel("single_scan_kernel", size, 1, block_size, items_per_thread);
     }
     return hipSuccess;
 }
 
+template<bool Exclusive,
+         class Config,
+         class InputIterator,
+         class OutputIterator,
+         class InitValueType,
+         class BinaryFunction,
+         class AccType>
+inline auto scan_impl_with_config(void*               temporary_storage,
+                                  size_t&             storage_size,
+                                  InputIterator       input,
+                                  OutputIterator      output,
+                                  const InitValueType initial_value,
+                                  const size_t        size,
+                                  BinaryFunction      scan_op,
+                                  const hipStream_t   stream,
+                                  bool                debug_synchronous,
+                                  AccType*            carry_in,
+                                  AccType*            carry_out)
+{
+    using config = wrapped_scan_config<Config, AccType>;
+
+    detail::target_arch target_arch;
+    hipError_t          result = host_target_arch(stream, target_arch);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    const scan_config_params params = dispatch_target_arch<config>(target_arch);
+
+    // Only the algorithms that the config selects on some architecture are instantiated
+    using use_reduce_then_scan
+        = std::integral_constant<bool,
+                                 any_target_arch_params<config>(
+                                     &scan_config_params::scan_algorithm,
+                                     ::rocprim::device_scan_algorithm::reduce_then_scan)>;
+    // Values of at most 4 bytes are always packed together with their flag
+    constexpr bool tagged = sizeof(AccType) > 4
+                            && any_target_arch_params<config>(
+                                &scan_config_params::scan_algorithm,
+                                ::rocprim::device_scan_algorithm::lookback_tagged);
+    using use_lookback_tagged = std::integral_constant<bool, tagged>;
+    using use_lookback        = std::integral_constant<
+        bool,
+        any_target_arch_params<config>(&scan_config_params::scan_algorithm,
+                                       ::rocprim::device_scan_algorithm::lookback)
+            || (sizeof(AccType) <= 4
+                && any_target_arch_params<config>(
+                    &scan_config_params::scan_algorithm,
+                    ::rocprim::device_scan_algorithm::lookback_tagged))>;
+
+    if(params.scan_algorithm == ::rocprim::device_scan_algorithm::reduce_then_scan)
+    {
+        return static_branch<config>(
+            use_reduce_then_scan{},
+            [&](auto config_identity)
+            {
+                using scan_config = typename decltype(config_identity)::type;
+                return reduce_then_scan_impl<Exclusive,
+                                             scan_config,
+                                             InputIterator,
+                                             OutputIterator,
+                                             InitValueType,
+                                             BinaryFunction,
+                                             AccType>(temporary_storage,
+                                                      storage_size,
+                                                      input,
+                                                      output,
+                                                      initial_value,
+                                                      size,
+                                                      scan_op,
+                                                      params,
+                                                      stream,
+                                                      debug_synchronous,
+                                                      carry_in,
+                                                      carry_out);
+            },
+            [](auto) { return hipErrorInvalidValue; });
+    }
+
+    if(params.scan_algorithm == ::rocprim::device_scan_algorithm::lookback_tagged
+       && sizeof(AccType) > 4)
+    {
+        return static_branch<config>(
+            use_lookback_tagged{},
+            [&](auto config_identity)
+            {
+                using scan_config = typename decltype(config_identity)::type;
+                return lookback_scan_impl<Exclusive,
+                                          scan_config,
+                                          detail::lookback_scan_state_tagged<AccType>,
+                                          detail::lookback_scan_state_tagged<AccType, true>,
+                                          InputIterator,
+                                          OutputIterator,
+                                          InitValueType,
+                                          BinaryFunction,
+                                          AccType>(temporary_storage,
+                                                   storage_size,
+                                                   input,
+                                                   output,
+                                                   initial_value,
+                                                   size,
+                                                   scan_op,
+                                                   params,
+                                                   stream,
+                                                   debug_synchronous,
+                                                   carry_in,
+                                                   carry_out);
+            },
+            [](auto) { return hipErrorInvalidValue; });
+    }
+
+    return static_branch<config>(
+        use_lookback{},
+        [&](auto config_identity)
+        {
+            using scan_config = typename decltype(config_identity)::type;
+            return lookback_scan_impl<Exclusive,
+                                      scan_config,
+                                      detail::lookback_scan_state<AccType>,
+                                      detail::lookback_scan_state<AccType, true>,
+                                      InputIterator,
+                                      OutputIterator,
+                                      InitValueType,
+                                      BinaryFunction,
+                                      AccType>(temporary_storage,
+                                               storage_size,
+                                               input,
+                                               output,
+                                               initial_value,
+                                               size,
+                                               scan_op,
+                                               params,
+                                               stream,
+                                               debug_synchronous,
+                                               carry_in,
+                                               carry_out);
+        },
+        [](auto) { return hipErrorInvalidValue; });
+}
+
+template<bool Exclusive,
+         class Config,
+         class InputIterator,
+         class OutputIterator,
+         class InitValueType,
+         class BinaryFunction,
+         class AccType>
+inline auto scan_impl(void*               temporary_storage,
+                      size_t&             storage_size,
+                      InputIterator       input,
+                      OutputIterator      output,
+                      const InitValueType initial_value,
+                      const size_t        size,
+                      BinaryFunction      scan_op,
+                      const hipStream_t   stream,
+                      bool                debug_synchronous,
+                      AccType*            carry_in  = nullptr,
+                      AccType*            carry_out = nullptr)
+{
+    // The default config may be tuned for the size of the input
+    return dispatch_size_bucket<Config, default_scan_config_size_bucketed::value>(
+        size,
+        [&](auto bucket_config_identity)
+        {
+            using bucket_config = typename decltype(bucket_config_identity)::type;
+            return dispatch_runtime_tuning<bucket_config, AccType>(
+                Exclusive ? "exclusive_scan" : "inclusive_scan",
+                temporary_storage,
+                storage_size,
+                size,
+                stream,
+                [&](auto config_identity)
+                {
+                    using config = typename decltype(config_identity)::type;
+                    return scan_impl_with_config<Exclusive,
+                                                 config,
+                                                 InputIterator,
+                                                 OutputIterator,
+                                                 InitValueType,
+                                                 BinaryFunction,
+                                                 AccType>(temporary_storage,
+                                                          storage_size,
+                                                          input,
+                                                          output,
+                                                          initial_value,
+                                                          size,
+                                                          scan_op,
+                                                          stream,
+                                                          debug_synchronous,
+                                                          carry_in,
+                                                          carry_out);
+                });
+        });
+}
+
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
 #undef ROCPRIM_DETAIL_HIP_SYNC
 
@@ -555,6 +1111,121 @@ inline hipError_t inclusive_scan(void*             temporary_storage,
             debug_synchronous);
 }
 
+/// \brief Parallel inclusive scan primitive for device level, continuing a previous scan.
+///
+/// Performs the same operation as \p inclusive_scan, but the input is treated as the
+/// continuation of the inputs of the previous calls that used \p state: if \p state has a
+/// carry, it is combined with the first element, and the inclusive total of all the
+/// inputs is stored in \p state for the next call. This allows scanning data that is
+/// produced in chunks, without reading the running total back to the host.
+///
+/// \par Overview
+/// * The size of \p temporary_storage does not depend on \p state.
+/// * Calls using the same \p state must be ordered, for example by launching them to the same
+/// stream. A call with \p size equal to \p 0 leaves \p state unchanged.
+///
+/// \tparam Config - [optional] configuration of the primitive, has to be \p scan_config or a class derived from it.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam AccType - accumulator type used to propagate the scanned values, it is the
+/// value type of \p state.
+/// \tparam BinaryFunction - type of binary function used for scan. Default type
+/// is \p rocprim::plus<AccType>.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the scan operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to scan.
+/// \param [out] output - iterator to the first element in the output range. It can be
+/// same as \p input.
+/// \param [in] size - number of element in the input range.
+/// \param [in,out] state - carry of the previous scans, updated with the total of this one.
+/// \param [in] scan_op - binary operation function object that will be used for scan.
+/// Default is BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful scan; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// int * chunk0;         // e.g., [1, 2, 3, 4]
+/// int * chunk1;         // e.g., [5, 6, 7, 8]
+/// int * output;         // empty array of 8 elements
+///
+/// void * state_storage;
+/// hipMalloc(&state_storage, rocprim::scan_state<int>::storage_size);
+/// rocprim::scan_state<int> state(state_storage);
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::inclusive_scan(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     chunk0, output, 4, state
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // scan the chunks
+/// rocprim::inclusive_scan(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     chunk0, output, 4, state
+/// );
+/// rocprim::inclusive_scan(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     chunk1, output + 4, 4, state
+/// );
+/// // output: [1, 3, 6, 10, 15, 21, 28, 36]
+/// // *state.carry(): 36
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputIterator,
+         class OutputIterator,
+         class AccType,
+         class BinaryFunction = ::rocprim::plus<AccType>>
+inline hipError_t inclusive_scan(void*                temporary_storage,
+                                 size_t&              storage_size,
+                                 InputIterator        input,
+                                 OutputIterator       output,
+                                 const size_t         size,
+                                 scan_state<AccType>& state,
+                                 BinaryFunction       scan_op           = BinaryFunction(),
+                                 const hipStream_t    stream            = 0,
+                                 bool                 debug_synchronous = false)
+{
+    // AccType{} is a dummy initial value (not used)
+    const hipError_t result = detail::
+        scan_impl<false, Config, InputIterator, OutputIterator, AccType, BinaryFunction, AccType>(
+            temporary_storage,
+            storage_size,
+            input,
+            output,
+            AccType{},
+            size,
+            scan_op,
+            stream,
+            debug_synchronous,
+            state.carry_in(),
+            state.carry_out());
+    if(result == hipSuccess && temporary_storage != nullptr && size > 0)
+    {
+        state.advance();
+    }
+    return result;
+}
+
 /// \brief Parallel exclusive scan primitive for device level.
 ///
 /// exclusive_scan function performs a device-wide exclusive prefix scan operation
@@ -678,6 +1349,89 @@ inline hipError_t exclusive_scan(void*               temporary_storage,
                                       debug_synchronous);
 }
 
+/// \brief Parallel exclusive scan primitive for device level, continuing a previous scan.
+///
+/// Performs the same operation as \p exclusive_scan, but the input is treated as the
+/// continuation of the inputs of the previous calls that used \p state: if \p state has a
+/// carry, it is used instead of \p initial_value, and the inclusive total of all the inputs
+/// is stored in \p state for the next call.
+///
+/// \par Overview
+/// * The size of \p temporary_storage does not depend on \p state.
+/// * Calls using the same \p state must be ordered, for example by launching them to the same
+/// stream. A call with \p size equal to \p 0 leaves \p state unchanged.
+///
+/// \tparam Config - [optional] configuration of the primitive, has to be \p scan_config or a class derived from it.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam InitValueType - type of the initial value.
+/// \tparam AccType - accumulator type used to propagate the scanned values, it is the
+/// value type of \p state.
+/// \tparam BinaryFunction - type of binary function used for scan. Default type
+/// is \p rocprim::plus<AccType>.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the scan operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to scan.
+/// \param [out] output - iterator to the first element in the output range. It can be
+/// same as \p input.
+/// \param [in] initial_value - initial value to start the scan, only used if \p state
+/// has no carry.
+/// \param [in] size - number of element in the input range.
+/// \param [in,out] state - carry of the previous scans, updated with the total of this one.
+/// \param [in] scan_op - binary operation function object that will be used for scan.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. The default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. The default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful scan; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<class Config = default_config,
+         class InputIterator,
+         class OutputIterator,
+         class InitValueType,
+         class AccType,
+         class BinaryFunction = ::rocprim::plus<AccType>>
+inline hipError_t exclusive_scan(void*                temporary_storage,
+                                 size_t&              storage_size,
+                                 InputIterator        input,
+                                 OutputIterator       output,
+                                 const InitValueType  initial_value,
+                                 const size_t         size,
+                                 scan_state<AccType>& state,
+                                 BinaryFunction       scan_op           = BinaryFunction(),
+                                 const hipStream_t    stream            = 0,
+                                 bool                 debug_synchronous = false)
+{
+    const hipError_t result = detail::scan_impl<true,
+                                                Config,
+                                                InputIterator,
+                                                OutputIterator,
+                                                InitValueType,
+                                                BinaryFunction,
+                                                AccType>(temporary_storage,
+                                                         storage_size,
+                                                         input,
+                                                         output,
+                                                         initial_value,
+                                                         size,
+                                                         scan_op,
+                                                         stream,
+                                                         debug_synchronous,
+                                                         state.carry_in(),
+                                                         state.carry_out());
+    if(result == hipSuccess && temporary_storage != nullptr && size > 0)
+    {
+        state.advance();
+    }
+    return result;
+}
+
 /// @}
 // end of group devicemodule
 
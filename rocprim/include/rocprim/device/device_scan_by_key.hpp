@@ -33,6 +33,7 @@
 #include "detail/device_scan_by_key.hpp"
 #include "detail/lookback_scan_state.hpp"
 #include "device_scan_by_key_config.hpp"
+#include "device_scan_state.hpp"
 
 #include <hip/hip_runtime.h>
 
@@ -66,7 +67,13 @@ void __global__ __launch_bounds__(device_params<Config>().kernel_config.block_si
                               const size_t                                 size,
                               const size_t                                 starting_block,
                               const size_t                                 number_of_blocks,
-                              const ::rocprim::tuple<AccType, bool>* const previous_last_value)
+                              const ::rocprim::tuple<AccType, bool>* const previous_last_value,
+                              const AccType* const                         carry_value_in,
+                              const typename std::iterator_traits<KeyInputIterator>::value_type*
+                                  const      pending_key_in,
+                              AccType* const carry_value_out,
+                              typename std::iterator_traits<KeyInputIterator>::value_type* const
+                                  pending_key_out)
 {
     device_scan_by_key_kernel_impl<Exclusive, Config>(
         keys,
@@ -79,7 +86,11 @@ void __global__ __launch_bounds__(device_params<Config>().kernel_config.block_si
         size,
         starting_block,
         number_of_blocks,
-        previous_last_value);
+        previous_last_value,
+        carry_value_in,
+        pending_key_in,
+        carry_value_out,
+        pending_key_out);
 }
 
 #define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
@@ -119,7 +130,13 @@ inline hipError_t scan_by_key_impl(void* const           temporary_storage,
                                    const BinaryFunction  scan_op,
                                    const CompareFunction compare,
                                    const hipStream_t     stream,
-                                   const bool            debug_synchronous)
+                                   const bool            debug_synchronous,
+                                   const AccType*        carry_value_in = nullptr,
+                                   const typename std::iterator_traits<KeysInputIterator>::value_type*
+                                            pending_key_in  = nullptr,
+                                   AccType* carry_value_out = nullptr,
+                                   typename std::iterator_traits<KeysInputIterator>::value_type*
+                                       pending_key_out = nullptr)
 {
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
 
@@ -242,6 +259,14 @@ inline hipError_t scan_by_key_impl(void* const           temporary_storage,
         const unsigned int scan_blocks    = ceiling_div(current_size, items_per_block);
         const unsigned int init_grid_size = ceiling_div(scan_blocks, block_size);
 
+        // The first launch continues from the carry of a previous call,
+        // the last one saves the carry for the next call
+        const bool      is_last_launch = i + 1 == number_of_launch;
+        const AccType*  in_value       = i == 0 ? carry_value_in : nullptr;
+        const key_type* in_key         = i == 0 ? pending_key_in : nullptr;
+        AccType*        out_value      = is_last_launch ? carry_value_out : nullptr;
+        key_type*       out_key        = is_last_launch ? pending_key_out : nullptr;
+
         // Start point for time measurements
         std::chrono::high_resolution_clock::time_point start;
         if(debug_synchronous)
@@ -292,7 +317,11 @@ inline hipError_t scan_by_key_impl(void* const           temporary_storage,
                                    size,
                                    i * number_of_blocks,
                                    total_number_of_blocks,
-                                   i > 0 ? as_const_ptr(previous_last_value) : nullptr);
+                                   i > 0 ? as_const_ptr(previous_last_value) : nullptr,
+                                   in_value,
+                                   in_key,
+                                   out_value,
+                                   out_key);
             });
         ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("device_scan_by_key_kernel",
                                                     current_size,
@@ -444,6 +473,106 @@ inline hipError_t inclusive_scan_by_key(void* const                temporary_sto
                                              debug_synchronous);
 }
 
+/// \brief Parallel inclusive scan-by-key primitive for device level, continuing a previous
+/// scan-by-key.
+///
+/// Performs the same operation as \p inclusive_scan_by_key, but the input is treated as the
+/// continuation of the inputs of the previous calls that used \p state: if the first key
+/// compares equal to the pending key of \p state, the segment of the previous calls is
+/// continued. The value and the key of the last segment are stored in \p state for the next
+/// call, so segments may span any number of calls.
+///
+/// \par Overview
+/// * The size of \p temporary_storage does not depend on \p state.
+/// * Calls using the same \p state must be ordered, for example by launching them to the same
+/// stream. A call with \p size equal to \p 0 leaves \p state unchanged.
+///
+/// \tparam Config - [optional] configuration of the primitive, has to be \p scan_by_key_config or a class derived from it.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. It can be
+/// a simple pointer type.
+/// \tparam ValuesInputIterator - random-access iterator type of the input range. It can be
+/// a simple pointer type.
+/// \tparam ValuesOutputIterator - random-access iterator type of the output range. It can be
+/// a simple pointer type.
+/// \tparam AccType - accumulator type used to propagate the scanned values, it is the
+/// value type of \p state.
+/// \tparam BinaryFunction - type of binary function used for scan. Default type
+/// is \p rocprim::plus<AccType>.
+/// \tparam KeyCompareFunction - type of binary function used to determine keys equality. Default type
+/// is \p rocprim::equal_to<T>, where \p T is a \p value_type of \p KeysInputIterator.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the scan operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - iterator to the first element in the range of keys.
+/// \param [in] values_input - iterator to the first element in the range of values to scan.
+/// \param [out] values_output - iterator to the first element in the output value range.
+/// \param [in] size - number of element in the input range.
+/// \param [in,out] state - carry of the previous scans, updated with the last segment of
+/// this one.
+/// \param [in] scan_op - binary operation function object that will be used for scanning
+/// input values. Default is BinaryFunction().
+/// \param [in] key_compare_op - binary operation function object that will be used to determine
+/// keys equality. Default is KeyCompareFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful scan; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<typename Config = default_config,
+         typename KeysInputIterator,
+         typename ValuesInputIterator,
+         typename ValuesOutputIterator,
+         typename AccType,
+         typename BinaryFunction = ::rocprim::plus<AccType>,
+         typename KeyCompareFunction
+         = ::rocprim::equal_to<typename std::iterator_traits<KeysInputIterator>::value_type>>
+inline hipError_t inclusive_scan_by_key(
+    void* const                temporary_storage,
+    size_t&                    storage_size,
+    const KeysInputIterator    keys_input,
+    const ValuesInputIterator  values_input,
+    const ValuesOutputIterator values_output,
+    const size_t               size,
+    scan_by_key_state<typename std::iterator_traits<KeysInputIterator>::value_type, AccType>& state,
+    const BinaryFunction     scan_op           = BinaryFunction(),
+    const KeyCompareFunction key_compare_op    = KeyCompareFunction(),
+    const hipStream_t        stream            = 0,
+    const bool               debug_synchronous = false)
+{
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    const hipError_t result = detail::scan_by_key_impl<false,
+                                                       Config,
+                                                       KeysInputIterator,
+                                                       ValuesInputIterator,
+                                                       ValuesOutputIterator,
+                                                       value_type,
+                                                       BinaryFunction,
+                                                       KeyCompareFunction,
+                                                       AccType>(temporary_storage,
+                                                                storage_size,
+                                                                keys_input,
+                                                                values_input,
+                                                                values_output,
+                                                                value_type(),
+                                                                size,
+                                                                scan_op,
+                                                                key_compare_op,
+                                                                stream,
+                                                                debug_synchronous,
+                                                                state.carry_in(),
+                                                                state.pending_key_in(),
+                                                                state.carry_out(),
+                                                                state.pending_key_out());
+    if(result == hipSuccess && temporary_storage != nullptr && size > 0)
+    {
+        state.advance();
+    }
+    return result;
+}
+
 /// \brief Parallel exclusive scan-by-key primitive for device level.
 ///
 /// inclusive_scan_by_key function performs a device-wide exclusive prefix scan-by-key
@@ -586,6 +715,109 @@ inline hipError_t exclusive_scan_by_key(void* const                temporary_sto
                                              debug_synchronous);
 }
 
+/// \brief Parallel exclusive scan-by-key primitive for device level, continuing a previous
+/// scan-by-key.
+///
+/// Performs the same operation as \p exclusive_scan_by_key, but the input is treated as the
+/// continuation of the inputs of the previous calls that used \p state: if the first key
+/// compares equal to the pending key of \p state, the segment of the previous calls is
+/// continued instead of starting from \p initial_value. The value and the key of the last
+/// segment are stored in \p state for the next call.
+///
+/// \par Overview
+/// * The size of \p temporary_storage does not depend on \p state.
+/// * Calls using the same \p state must be ordered, for example by launching them to the same
+/// stream. A call with \p size equal to \p 0 leaves \p state unchanged.
+///
+/// \tparam Config - [optional] configuration of the primitive, has to be \p scan_by_key_config or a class derived from it.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. It can be
+/// a simple pointer type.
+/// \tparam ValuesInputIterator - random-access iterator type of the input range. It can be
+/// a simple pointer type.
+/// \tparam ValuesOutputIterator - random-access iterator type of the output range. It can be
+/// a simple pointer type.
+/// \tparam InitialValueType - type of the initial value.
+/// \tparam AccType - accumulator type used to propagate the scanned values, it is the
+/// value type of \p state.
+/// \tparam BinaryFunction - type of binary function used for scan. Default type
+/// is \p rocprim::plus<AccType>.
+/// \tparam KeyCompareFunction - type of binary function used to determine keys equality. Default type
+/// is \p rocprim::equal_to<T>, where \p T is a \p value_type of \p KeysInputIterator.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the scan operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - iterator to the first element in the range of keys.
+/// \param [in] values_input - iterator to the first element in the range of values to scan.
+/// \param [out] values_output - iterator to the first element in the output value range.
+/// \param [in] initial_value - initial value to start every segment.
+/// \param [in] size - number of element in the input range.
+/// \param [in,out] state - carry of the previous scans, updated with the last segment of
+/// this one.
+/// \param [in] scan_op - binary operation function object that will be used for scanning
+/// input values. Default is BinaryFunction().
+/// \param [in] key_compare_op - binary operation function object that will be used to determine
+/// keys equality. Default is KeyCompareFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful scan; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<typename Config = default_config,
+         typename KeysInputIterator,
+         typename ValuesInputIterator,
+         typename ValuesOutputIterator,
+         typename InitialValueType,
+         typename AccType,
+         typename BinaryFunction = ::rocprim::plus<AccType>,
+         typename KeyCompareFunction
+         = ::rocprim::equal_to<typename std::iterator_traits<KeysInputIterator>::value_type>>
+inline hipError_t exclusive_scan_by_key(
+    void* const                temporary_storage,
+    size_t&                    storage_size,
+    const KeysInputIterator    keys_input,
+    const ValuesInputIterator  values_input,
+    const ValuesOutputIterator values_output,
+    const InitialValueType     initial_value,
+    const size_t               size,
+    scan_by_key_state<typename std::iterator_traits<KeysInputIterator>::value_type, AccType>& state,
+    const BinaryFunction     scan_op           = BinaryFunction(),
+    const KeyCompareFunction key_compare_op    = KeyCompareFunction(),
+    const hipStream_t        stream            = 0,
+    const bool               debug_synchronous = false)
+{
+    const hipError_t result = detail::scan_by_key_impl<true,
+                                                       Config,
+                                                       KeysInputIterator,
+                                                       ValuesInputIterator,
+                                                       ValuesOutputIterator,
+                                                       InitialValueType,
+                                                       BinaryFunction,
+                                                       KeyCompareFunction,
+                                                       AccType>(temporary_storage,
+                                                                storage_size,
+                                                                keys_input,
+                                                                values_input,
+                                                                values_output,
+                                                                initial_value,
+                                                                size,
+                                                                scan_op,
+                                                                key_compare_op,
+                                                                stream,
+                                                                debug_synchronous,
+                                                                state.carry_in(),
+                                                                state.pending_key_in(),
+                                                                state.carry_out(),
+                                                                state.pending_key_out());
+    if(result == hipSuccess && temporary_storage != nullptr && size > 0)
+    {
+        state.advance();
+    }
+    return result;
+}
+
 /// @}
 // end of group devicemodule
 
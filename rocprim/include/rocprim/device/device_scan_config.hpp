@@ -1,4 +1,4 @@
-// Copyright (c) 2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2023-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -55,6 +55,24 @@ struct wrapped_scan_config<default_config, Value>
     };
 };
 
+// Default config tuned for the input sizes of a size bucket, see dispatch_size_bucket
+template<size_bucket Bucket, typename Value>
+struct wrapped_scan_config<default_bucket_config<Bucket>, Value>
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        static constexpr scan_config_params params
+            = default_scan_bucket_config<static_cast<unsigned int>(Arch), Bucket, Value>{};
+    };
+};
+
+// Config of another architecture, see detail/runtime_tuning.hpp
+template<typename Config, target_arch Arch, typename Value>
+struct wrapped_scan_config<fixed_arch_config<Config, Arch>, Value>
+    : wrapped_fixed_arch_config<wrapped_scan_config<Config, Value>, Arch>
+{};
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 template<typename ScanConfig, typename Value>
 template<target_arch Arch>
@@ -65,6 +83,11 @@ template<typename Value>
 template<target_arch Arch>
 constexpr scan_config_params
     wrapped_scan_config<default_config, Value>::architecture_config<Arch>::params;
+
+template<size_bucket Bucket, typename Value>
+template<target_arch Arch>
+constexpr scan_config_params
+    wrapped_scan_config<default_bucket_config<Bucket>, Value>::architecture_config<Arch>::params;
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 } // namespace detail
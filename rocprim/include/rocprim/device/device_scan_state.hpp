@@ -0,0 +1,217 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SCAN_STATE_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SCAN_STATE_HPP_
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include <cstddef>
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+/// \brief Carry of a device-level scan across multiple calls.
+///
+/// Passing the same \p scan_state to consecutive calls of \p inclusive_scan or
+/// \p exclusive_scan scans the concatenation of their inputs, for example data that arrives
+/// in chunks. Every call continues from the inclusive total of the previous calls and stores
+/// the new total. The carry stays in device memory, it is never read back to the host.
+///
+/// The carry is double-buffered: a call reads it from one buffer and writes the new carry
+/// to the other one, so the calls must be ordered (e.g. launched to the same stream).
+/// Calls with an empty input leave the state unchanged.
+///
+/// \tparam T - accumulator type of the scans.
+template<class T>
+class scan_state
+{
+public:
+    /// \brief Accumulator type of the scans.
+    using value_type = T;
+
+    /// \brief Size in bytes of the device memory required by a \p scan_state.
+    static constexpr size_t storage_size = 2 * sizeof(T);
+
+    /// \brief Creates a state without carry.
+    ///
+    /// \param storage - device memory of at least \p storage_size bytes, aligned for \p T.
+    /// It must stay allocated while the state is used.
+    ROCPRIM_HOST explicit scan_state(void* storage) noexcept
+        : carries_(static_cast<T*>(storage)), current_(0), has_carry_(false)
+    {}
+
+    /// \brief Discards the carry, the next scan starts a new sequence.
+    ROCPRIM_HOST void reset() noexcept
+    {
+        has_carry_ = false;
+    }
+
+    /// \brief Returns \p true if a previous scan left a carry.
+    ROCPRIM_HOST bool has_carry() const noexcept
+    {
+        return has_carry_;
+    }
+
+    /// \brief Device pointer to the inclusive total of all scans since the last reset.
+    /// Only valid if \p has_carry() is \p true.
+    ROCPRIM_HOST T* carry() const noexcept
+    {
+        return carries_ + current_;
+    }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    // Device pointer of the carry read by the next scan, nullptr if there is none
+    ROCPRIM_HOST T* carry_in() const noexcept
+    {
+        return has_carry_ ? carry() : nullptr;
+    }
+
+    // Device pointer of the carry written by the next scan
+    ROCPRIM_HOST T* carry_out() const noexcept
+    {
+        return carries_ + (current_ ^ 1u);
+    }
+
+    // Called after a scan wrote carry_out()
+    ROCPRIM_HOST void advance() noexcept
+    {
+        current_ ^= 1u;
+        has_carry_ = true;
+    }
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+private:
+    T*           carries_;
+    unsigned int current_;
+    bool         has_carry_;
+};
+
+/// \brief Carry of a device-level scan-by-key across multiple calls.
+///
+/// Same as \p scan_state, but for \p inclusive_scan_by_key and \p exclusive_scan_by_key:
+/// besides the scanned value of the last segment it keeps the last key of the previous calls
+/// (the pending key). The next call continues the segment only if its first key compares
+/// equal to the pending key.
+///
+/// \tparam Key - key type of the scans.
+/// \tparam T - accumulator type of the scans.
+template<class Key, class T>
+class scan_by_key_state
+{
+public:
+    /// \brief Key type of the scans.
+    using key_type = Key;
+    /// \brief Accumulator type of the scans.
+    using value_type = T;
+
+private:
+    // The two keys are stored after the two values
+    static constexpr size_t keys_offset
+        = ::rocprim::detail::ceiling_div(2 * sizeof(T), alignof(Key)) * alignof(Key);
+
+public:
+    /// \brief Size in bytes of the device memory required by a \p scan_by_key_state.
+    static constexpr size_t storage_size = keys_offset + 2 * sizeof(Key);
+
+    /// \brief Creates a state without carry.
+    ///
+    /// \param storage - device memory of at least \p storage_size bytes, aligned for both
+    /// \p Key and \p T. It must stay allocated while the state is used.
+    ROCPRIM_HOST explicit scan_by_key_state(void* storage) noexcept
+        : values_(static_cast<T*>(storage))
+        , keys_(reinterpret_cast<Key*>(static_cast<char*>(storage) + keys_offset))
+        , current_(0)
+        , has_carry_(false)
+    {}
+
+    /// \brief Discards the carry, the next scan starts a new sequence.
+    ROCPRIM_HOST void reset() noexcept
+    {
+        has_carry_ = false;
+    }
+
+    /// \brief Returns \p true if a previous scan left a carry.
+    ROCPRIM_HOST bool has_carry() const noexcept
+    {
+        return has_carry_;
+    }
+
+    /// \brief Device pointer to the scanned value of the last segment of all scans since
+    /// the last reset. Only valid if \p has_carry() is \p true.
+    ROCPRIM_HOST T* carry() const noexcept
+    {
+        return values_ + current_;
+    }
+
+    /// \brief Device pointer to the last key of all scans since the last reset.
+    /// Only valid if \p has_carry() is \p true.
+    ROCPRIM_HOST Key* pending_key() const noexcept
+    {
+        return keys_ + current_;
+    }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    // Device pointers of the carry read by the next scan, nullptr if there is none
+    ROCPRIM_HOST T* carry_in() const noexcept
+    {
+        return has_carry_ ? carry() : nullptr;
+    }
+
+    ROCPRIM_HOST Key* pending_key_in() const noexcept
+    {
+        return has_carry_ ? pending_key() : nullptr;
+    }
+
+    // Device pointers of the carry written by the next scan
+    ROCPRIM_HOST T* carry_out() const noexcept
+    {
+        return values_ + (current_ ^ 1u);
+    }
+
+    ROCPRIM_HOST Key* pending_key_out() const noexcept
+    {
+        return keys_ + (current_ ^ 1u);
+    }
+
+    // Called after a scan wrote carry_out() and pending_key_out()
+    ROCPRIM_HOST void advance() noexcept
+    {
+        current_ ^= 1u;
+        has_carry_ = true;
+    }
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+private:
+    T*           values_;
+    Key*         keys_;
+    unsigned int current_;
+    bool         has_carry_;
+};
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_SCAN_STATE_HPP_
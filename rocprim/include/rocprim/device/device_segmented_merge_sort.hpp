@@ -0,0 +1,755 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SEGMENTED_MERGE_SORT_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SEGMENTED_MERGE_SORT_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "../config.hpp"
+#include "../detail/temp_storage.hpp"
+#include "../detail/various.hpp"
+#include "config_types.hpp"
+
+#include "../functional.hpp"
+#include "../types.hpp"
+
+#include "../iterator/counting_iterator.hpp"
+#include "../iterator/reverse_iterator.hpp"
+#include "detail/device_segmented_merge_sort.hpp"
+#include "device_merge_sort.hpp"
+#include "device_partition.hpp"
+#include "device_segmented_merge_sort_config.hpp"
+#include "device_transform.hpp"
+
+/// \addtogroup devicemodule
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+ROCPRIM_KERNEL
+    __launch_bounds__(device_params<Config>().kernel_config.block_size) void segmented_merge_sort_block_kernel(
+        KeysInputIterator                                               keys_input,
+        typename std::iterator_traits<KeysInputIterator>::value_type*   keys_tmp,
+        KeysOutputIterator                                              keys_output,
+        ValuesInputIterator                                             values_input,
+        typename std::iterator_traits<ValuesInputIterator>::value_type* values_tmp,
+        ValuesOutputIterator                                            values_output,
+        SegmentIndexIterator                                            segment_indices,
+        OffsetIterator                                                  begin_offsets,
+        OffsetIterator                                                  end_offsets,
+        BinaryFunction                                                  compare_function)
+{
+    segmented_merge_sort_block<Config>(keys_input,
+                                       keys_tmp,
+                                       keys_output,
+                                       values_input,
+                                       values_tmp,
+                                       values_output,
+                                       segment_indices,
+                                       begin_offsets,
+                                       end_offsets,
+                                       compare_function);
+}
+
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+ROCPRIM_KERNEL
+    __launch_bounds__(device_params<Config>().block_size_small) void segmented_merge_sort_small_kernel(
+        KeysInputIterator    keys_input,
+        KeysOutputIterator   keys_output,
+        ValuesInputIterator  values_input,
+        ValuesOutputIterator values_output,
+        const unsigned int   num_segments,
+        SegmentIndexIterator segment_indices,
+        OffsetIterator       begin_offsets,
+        OffsetIterator       end_offsets,
+        BinaryFunction       compare_function)
+{
+    segmented_merge_sort_small<Config>(keys_input,
+                                       keys_output,
+                                       values_input,
+                                       values_output,
+                                       num_segments,
+                                       segment_indices,
+                                       begin_offsets,
+                                       end_offsets,
+                                       compare_function);
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
+    { \
+        auto _error = hipGetLastError(); \
+        if(_error != hipSuccess) return _error; \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto __error = hipStreamSynchronize(stream); \
+            if(__error != hipSuccess) return __error; \
+            auto _end = std::chrono::high_resolution_clock::now(); \
+            auto _d = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+inline hipError_t segmented_merge_sort_impl(void*                temporary_storage,
+                                            size_t&              storage_size,
+                                            KeysInputIterator    keys_input,
+                                            KeysOutputIterator   keys_output,
+                                            ValuesInputIterator  values_input,
+                                            ValuesOutputIterator values_output,
+                                            const unsigned int   size,
+                                            const unsigned int   segments,
+                                            OffsetIterator       begin_offsets,
+                                            OffsetIterator       end_offsets,
+                                            BinaryFunction       compare_function,
+                                            const hipStream_t    stream,
+                                            const bool           debug_synchronous)
+{
+    using key_type               = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type             = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    using segment_index_type     = unsigned int;
+    using segment_index_iterator = counting_iterator<segment_index_type>;
+
+    static_assert(
+        std::is_same<key_type, typename std::iterator_traits<KeysOutputIterator>::value_type>::value,
+        "KeysInputIterator and KeysOutputIterator must have the same value_type");
+    static_assert(
+        std::is_same<value_type,
+                     typename std::iterator_traits<ValuesOutputIterator>::value_type>::value,
+        "ValuesInputIterator and ValuesOutputIterator must have the same value_type");
+
+    using config = wrapped_segmented_merge_sort_config<Config, key_type, value_type>;
+
+    target_arch target_arch;
+    hipError_t  result = host_target_arch(stream, target_arch);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    const segmented_merge_sort_config_params params = dispatch_target_arch<config>(target_arch);
+
+    static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+    const unsigned int    max_small_segment_length
+        = params.logical_warp_size_small * params.items_per_thread_small;
+    const unsigned int small_segments_per_block
+        = params.block_size_small / params.logical_warp_size_small;
+    const unsigned int large_segment_threshold = params.large_segment_threshold;
+    // Only an input larger than the threshold can have large segments, they do not overlap so
+    // there are at most size / (large_segment_threshold + 1) of them.
+    const bool         may_have_large_segments = size > large_segment_threshold;
+    const unsigned int max_large_segments
+        = may_have_large_segments ? std::min(segments, size / (large_segment_threshold + 1)) : 0;
+    const bool do_partitioning
+        = segments >= params.partitioning_threshold || may_have_large_segments;
+
+    const auto large_segment_selector = [=](const unsigned int segment_index) mutable -> bool
+    {
+        const unsigned int segment_length
+            = end_offsets[segment_index] - begin_offsets[segment_index];
+        return segment_length > large_segment_threshold;
+    };
+    const auto small_segment_selector = [=](const unsigned int segment_index) mutable -> bool
+    {
+        const unsigned int segment_length
+            = end_offsets[segment_index] - begin_offsets[segment_index];
+        return segment_length <= max_small_segment_length;
+    };
+
+    // partition_three_way() writes the large segments to their own buffer, the small segments
+    // to the beginning of segment_indices and the other segments in reverse order to its end.
+    segment_index_type*         segment_indices{};
+    segment_index_type*         large_segment_indices{};
+    segmented_merge_sort_range* large_segment_ranges{};
+    segment_index_type*         segment_counts_output{};
+    key_type*                   keys_tmp{};
+    value_type*                 values_tmp{};
+    size_t                      partition_storage_size{};
+    void*                       partition_temporary_storage{};
+    size_t                      large_sort_storage_size{};
+    void*                       large_sort_temporary_storage{};
+
+    result = ::rocprim::partition_three_way(nullptr,
+                                            partition_storage_size,
+                                            segment_index_iterator{},
+                                            large_segment_indices,
+                                            segment_indices,
+                                            ::rocprim::make_reverse_iterator(segment_indices),
+                                            segment_counts_output,
+                                            segments,
+                                            large_segment_selector,
+                                            small_segment_selector,
+                                            stream,
+                                            debug_synchronous);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    if(may_have_large_segments)
+    {
+        // Every large segment is at most size long. The config is not bucketed by size, so the
+        // storage is large enough for all of them.
+        result = merge_sort_impl_with_config<default_config>(nullptr,
+                                                             large_sort_storage_size,
+                                                             keys_input,
+                                                             keys_output,
+                                                             values_input,
+                                                             values_output,
+                                                             size,
+                                                             compare_function,
+                                                             stream,
+                                                             debug_synchronous,
+                                                             nullptr,
+                                                             nullptr);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+    }
+
+    result = temp_storage::partition(
+        temporary_storage,
+        storage_size,
+        temp_storage::make_linear_partition(
+            temp_storage::ptr_aligned_array(&segment_indices, do_partitioning ? segments : 0),
+            temp_storage::ptr_aligned_array(&large_segment_indices, max_large_segments),
+            temp_storage::ptr_aligned_array(&large_segment_ranges, max_large_segments),
+            temp_storage::ptr_aligned_array(&segment_counts_output, 2),
+            temp_storage::make_union_partition(
+                // Partition temporary storage only needed by partitioning.
+                temp_storage::make_partition(&partition_temporary_storage,
+                                             do_partitioning ? partition_storage_size : 0),
+                // Keys/values temporary storage only needed by sorting with blocks.
+                temp_storage::make_linear_partition(
+                    temp_storage::ptr_aligned_array(&keys_tmp, size),
+                    temp_storage::ptr_aligned_array(&values_tmp, with_values ? size : 0)),
+                // Merge sort temporary storage only needed by the large segments, which are
+                // sorted after the other ones.
+                temp_storage::make_partition(&large_sort_temporary_storage,
+                                             large_sort_storage_size))));
+    if(result != hipSuccess || temporary_storage == nullptr)
+    {
+        return result;
+    }
+
+    if(segments == 0u)
+    {
+        return hipSuccess;
+    }
+    if(debug_synchronous)
+    {
+        std::cout << "segments " << segments << '\n';
+        std::cout << "storage_size " << storage_size << '\n';
+        std::cout << "do_partitioning " << do_partitioning << '\n';
+        std::cout << "params.kernel_config.block_size: " << params.kernel_config.block_size << '\n';
+        std::cout << "params.kernel_config.items_per_thread: "
+                  << params.kernel_config.items_per_thread << '\n';
+        result = hipStreamSynchronize(stream);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(!do_partitioning)
+    {
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(segmented_merge_sort_block_kernel<config>),
+                           dim3(segments),
+                           dim3(params.kernel_config.block_size),
+                           0,
+                           stream,
+                           keys_input,
+                           keys_tmp,
+                           keys_output,
+                           values_input,
+                           values_tmp,
+                           values_output,
+                           segment_index_iterator{},
+                           begin_offsets,
+                           end_offsets,
+                           compare_function);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_merge_sort_block_kernel",
+                                                    segments,
+                                                    start)
+        return hipSuccess;
+    }
+
+    result = ::rocprim::partition_three_way(partition_temporary_storage,
+                                            partition_storage_size,
+                                            segment_index_iterator{},
+                                            large_segment_indices,
+                                            segment_indices,
+                                            ::rocprim::make_reverse_iterator(segment_indices
+                                                                             + segments),
+                                            segment_counts_output,
+                                            segments,
+                                            large_segment_selector,
+                                            small_segment_selector,
+                                            stream,
+                                            debug_synchronous);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    segment_index_type segment_counts[2];
+    result = detail::memcpy_and_sync(segment_counts,
+                                     segment_counts_output,
+                                     sizeof(segment_counts),
+                                     hipMemcpyDeviceToHost,
+                                     stream);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    const segment_index_type large_segment_count  = segment_counts[0];
+    const segment_index_type small_segment_count  = segment_counts[1];
+    const segment_index_type medium_segment_count
+        = segments - large_segment_count - small_segment_count;
+    if(debug_synchronous)
+    {
+        std::cout << "small_segment_count " << small_segment_count << '\n';
+        std::cout << "medium_segment_count " << medium_segment_count << '\n';
+        std::cout << "large_segment_count " << large_segment_count << '\n';
+    }
+
+    if(medium_segment_count > 0)
+    {
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(segmented_merge_sort_block_kernel<config>),
+                           dim3(medium_segment_count),
+                           dim3(params.kernel_config.block_size),
+                           0,
+                           stream,
+                           keys_input,
+                           keys_tmp,
+                           keys_output,
+                           values_input,
+                           values_tmp,
+                           values_output,
+                           segment_indices + (segments - medium_segment_count),
+                           begin_offsets,
+                           end_offsets,
+                           compare_function);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_merge_sort_block_kernel",
+                                                    medium_segment_count,
+                                                    start)
+    }
+    if(small_segment_count > 0)
+    {
+        const auto small_segment_grid_size
+            = ::rocprim::detail::ceiling_div(small_segment_count, small_segments_per_block);
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(segmented_merge_sort_small_kernel<config>),
+                           dim3(small_segment_grid_size),
+                           dim3(params.block_size_small),
+                           0,
+                           stream,
+                           keys_input,
+                           keys_output,
+                           values_input,
+                           values_output,
+                           small_segment_count,
+                           segment_indices,
+                           begin_offsets,
+                           end_offsets,
+                           compare_function);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_merge_sort_small_kernel",
+                                                    small_segment_count,
+                                                    start)
+    }
+    if(large_segment_count == 0)
+    {
+        return hipSuccess;
+    }
+
+    // A block would merge a large segment alone, the device-wide merge sort merges it with all
+    // blocks. The offsets of the large segments are read back to launch it for each of them.
+    result = ::rocprim::transform(
+        large_segment_indices,
+        large_segment_ranges,
+        large_segment_count,
+        [=](const unsigned int segment_index) mutable -> segmented_merge_sort_range
+        {
+            return segmented_merge_sort_range{
+                static_cast<unsigned int>(begin_offsets[segment_index]),
+                static_cast<unsigned int>(end_offsets[segment_index])};
+        },
+        stream,
+        debug_synchronous);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    std::vector<segmented_merge_sort_range> large_segments(large_segment_count);
+    result = detail::memcpy_and_sync(large_segments.data(),
+                                     large_segment_ranges,
+                                     large_segment_count * sizeof(segmented_merge_sort_range),
+                                     hipMemcpyDeviceToHost,
+                                     stream);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    for(const segmented_merge_sort_range& segment : large_segments)
+    {
+        const unsigned int begin_offset = segment.begin_offset;
+        size_t             segment_storage_size = large_sort_storage_size;
+        result = merge_sort_impl_with_config<default_config>(
+            large_sort_temporary_storage,
+            segment_storage_size,
+            keys_input + begin_offset,
+            keys_output + begin_offset,
+            with_values ? values_input + begin_offset : values_input,
+            with_values ? values_output + begin_offset : values_output,
+            segment.end_offset - begin_offset,
+            compare_function,
+            stream,
+            debug_synchronous,
+            nullptr,
+            nullptr);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+    }
+
+    return hipSuccess;
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // end namespace detail
+
+/// \brief Parallel stable segmented merge sort primitive for device level.
+///
+/// \p segmented_merge_sort_keys function performs a device-wide stable merge sort across
+/// multiple, non-overlapping sequences of keys, ordered by a comparison function.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the sorting function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Contrary to \p segmented_radix_sort_keys, any key type ordered by \p compare_function
+/// is supported, and equivalent keys keep their relative order.
+/// * Ranges specified by \p keys_input and \p keys_output must have at least \p size elements.
+/// \p keys_output must also be readable, it is used as a buffer while merging.
+/// * Ranges specified by \p begin_offsets and \p end_offsets must have
+/// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
+/// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
+/// <tt>offsets + 1</tt> for \p end_offsets.
+/// * If there are at least \p partitioning_threshold segments, short segments are sorted by
+/// a logical warp each and the other ones by a block each. Segments longer than a block tile
+/// are sorted by merging their sorted tiles within the block.
+/// * Segments longer than \p large_segment_threshold are sorted one after the other by the
+/// device-wide merge sort, whose merges use all blocks of the device. If \p size is larger than
+/// \p large_segment_threshold, the segments are always partitioned and their offsets are read
+/// back by the host, so the call synchronizes with \p stream.
+///
+/// \tparam Config - [optional] configuration of the primitive. It has to be
+/// \p segmented_merge_sort_config or a class derived from it.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept and also be readable, the partially sorted keys
+/// are read back from it as inputs of the merges. It can be a simple pointer type.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for sort. Default type
+/// is \p rocprim::less<T>, where \p T is a \p value_type of \p KeysInputIterator.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the sort operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to sort.
+/// \param [out] keys_output - pointer to the first element in the output range.
+/// \param [in] size - number of element in the input range.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] begin_offsets - iterator to the first element in the range of beginning offsets.
+/// \param [in] end_offsets - iterator to the first element in the range of ending offsets.
+/// \param [in] compare_function - binary operation function object that will be used for
+/// comparison. The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful sort; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level descending segmented merge sort is performed on an array of
+/// \p float values.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;      // e.g., 8
+/// float * input;          // e.g., [0.6, 0.3, 0.65, 0.4, 0.2, 0.08, 1, 0.7]
+/// float * output;         // empty array of 8 elements
+/// unsigned int segments;  // e.g., 3
+/// int * offsets;          // e.g. [0, 2, 3, 8]
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::segmented_merge_sort_keys(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size,
+///     segments, offsets, offsets + 1, rocprim::greater<float>()
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform sort
+/// rocprim::segmented_merge_sort_keys(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size,
+///     segments, offsets, offsets + 1, rocprim::greater<float>()
+/// );
+/// // keys_output: [0.6, 0.3, 0.65, 1, 0.7, 0.4, 0.2, 0.08]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class OffsetIterator,
+         class BinaryFunction
+         = ::rocprim::less<typename std::iterator_traits<KeysInputIterator>::value_type>>
+inline hipError_t segmented_merge_sort_keys(void*              temporary_storage,
+                                            size_t&            storage_size,
+                                            KeysInputIterator  keys_input,
+                                            KeysOutputIterator keys_output,
+                                            unsigned int       size,
+                                            unsigned int       segments,
+                                            OffsetIterator     begin_offsets,
+                                            OffsetIterator     end_offsets,
+                                            BinaryFunction     compare_function = BinaryFunction(),
+                                            hipStream_t        stream           = 0,
+                                            bool               debug_synchronous = false)
+{
+    empty_type* values = nullptr;
+    return detail::segmented_merge_sort_impl<Config>(temporary_storage,
+                                                     storage_size,
+                                                     keys_input,
+                                                     keys_output,
+                                                     values,
+                                                     values,
+                                                     size,
+                                                     segments,
+                                                     begin_offsets,
+                                                     end_offsets,
+                                                     compare_function,
+                                                     stream,
+                                                     debug_synchronous);
+}
+
+/// \brief Parallel stable segmented merge sort-by-key primitive for device level.
+///
+/// \p segmented_merge_sort_pairs function performs a device-wide stable merge sort across
+/// multiple, non-overlapping sequences of (key, value) pairs, ordered by a comparison
+/// function on the keys.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the sorting function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Contrary to \p segmented_radix_sort_pairs, any key type ordered by \p compare_function
+/// is supported, and pairs with equivalent keys keep their relative order.
+/// * Ranges specified by \p keys_input, \p keys_output, \p values_input and \p values_output must
+/// have at least \p size elements. \p keys_output and \p values_output must also be readable,
+/// they are used as buffers while merging.
+/// * Ranges specified by \p begin_offsets and \p end_offsets must have
+/// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
+/// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
+/// <tt>offsets + 1</tt> for \p end_offsets.
+/// * If there are at least \p partitioning_threshold segments, short segments are sorted by
+/// a logical warp each and the other ones by a block each. Segments longer than a block tile
+/// are sorted by merging their sorted tiles within the block.
+/// * Segments longer than \p large_segment_threshold are sorted one after the other by the
+/// device-wide merge sort, whose merges use all blocks of the device. If \p size is larger than
+/// \p large_segment_threshold, the segments are always partitioned and their offsets are read
+/// back by the host, so the call synchronizes with \p stream.
+///
+/// \tparam Config - [optional] configuration of the primitive. It has to be
+/// \p segmented_merge_sort_config or a class derived from it.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept and also be readable, the partially sorted keys
+/// are read back from it as inputs of the merges. It can be a simple pointer type.
+/// \tparam ValuesInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept and also be readable, the partially sorted values
+/// are read back from it as inputs of the merges. It can be a simple pointer type.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for sort. Default type
+/// is \p rocprim::less<T>, where \p T is a \p value_type of \p KeysInputIterator.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the sort operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to sort.
+/// \param [out] keys_output - pointer to the first element in the output range.
+/// \param [in] values_input - pointer to the first element in the range to sort.
+/// \param [out] values_output - pointer to the first element in the output range.
+/// \param [in] size - number of element in the input range.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] begin_offsets - iterator to the first element in the range of beginning offsets.
+/// \param [in] end_offsets - iterator to the first element in the range of ending offsets.
+/// \param [in] compare_function - binary operation function object that will be used for
+/// comparison. The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful sort; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level ascending segmented merge sort is performed where input keys
+/// are represented by an array of integers and input values by an array of <tt>double</tt>s.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;          // e.g., 8
+/// int * keys_input;           // e.g., [ 6, 3,  5, 4,  1,  8,  1, 7]
+/// double * values_input;      // e.g., [-5, 2, -4, 3, -1, -8, -2, 7]
+/// int * keys_output;          // empty array of 8 elements
+/// double * values_output;     // empty array of 8 elements
+/// unsigned int segments;      // e.g., 3
+/// int * offsets;              // e.g. [0, 2, 3, 8]
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::segmented_merge_sort_pairs(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     keys_input, keys_output, values_input, values_output,
+///     input_size, segments, offsets, offsets + 1
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform sort
+/// rocprim::segmented_merge_sort_pairs(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     keys_input, keys_output, values_input, values_output,
+///     input_size, segments, offsets, offsets + 1
+/// );
+/// // keys_output:   [3,  6,  5,  1,  1, 4, 7,  8]
+/// // values_output: [2, -5, -4, -1, -2, 3, 7, -8]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class OffsetIterator,
+         class BinaryFunction
+         = ::rocprim::less<typename std::iterator_traits<KeysInputIterator>::value_type>>
+inline hipError_t segmented_merge_sort_pairs(void*                temporary_storage,
+                                             size_t&              storage_size,
+                                             KeysInputIterator    keys_input,
+                                             KeysOutputIterator   keys_output,
+                                             ValuesInputIterator  values_input,
+                                             ValuesOutputIterator values_output,
+                                             unsigned int         size,
+                                             unsigned int         segments,
+                                             OffsetIterator       begin_offsets,
+                                             OffsetIterator       end_offsets,
+                                             BinaryFunction compare_function = BinaryFunction(),
+                                             hipStream_t    stream           = 0,
+                                             bool           debug_synchronous = false)
+{
+    return detail::segmented_merge_sort_impl<Config>(temporary_storage,
+                                                     storage_size,
+                                                     keys_input,
+                                                     keys_output,
+                                                     values_input,
+                                                     values_output,
+                                                     size,
+                                                     segments,
+                                                     begin_offsets,
+                                                     end_offsets,
+                                                     compare_function,
+                                                     stream,
+                                                     debug_synchronous);
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_SEGMENTED_MERGE_SORT_HPP_
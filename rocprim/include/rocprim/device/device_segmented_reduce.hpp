@@ -21,16 +21,19 @@
 #ifndef ROCPRIM_DEVICE_DEVICE_SEGMENTED_REDUCE_HPP_
 #define ROCPRIM_DEVICE_DEVICE_SEGMENTED_REDUCE_HPP_
 
+#include <chrono>
 #include <iostream>
 #include <iterator>
 #include <type_traits>
 
 #include "../config.hpp"
+#include "../detail/temp_storage.hpp"
 #include "../detail/various.hpp"
 #include "../functional.hpp"
 
 #include "detail/config/device_reduce.hpp"
 #include "detail/device_segmented_reduce.hpp"
+#include "detail/persistent_grid.hpp"
 #include "rocprim/type_traits.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -63,6 +66,41 @@ ROCPRIM_KERNEL __launch_bounds__(
     );
 }
 
+template<class Config,
+         class InputIterator,
+         class OutputIterator,
+         class OffsetIterator,
+         class ResultType,
+         class BinaryFunction>
+ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().reduce_config.block_size) void
+    segmented_reduce_csr_kernel(InputIterator                                 input,
+                                OutputIterator                                output,
+                                const unsigned int                            segments,
+                                OffsetIterator                                offsets,
+                                BinaryFunction                                reduce_op,
+                                ResultType                                    initial_value,
+                                segmented_reduce_csr_block_state<ResultType>* block_states)
+{
+    segmented_reduce_csr_kernel_impl<Config>(input,
+                                             output,
+                                             segments,
+                                             offsets,
+                                             reduce_op,
+                                             initial_value,
+                                             block_states);
+}
+
+template<class Config, class OutputIterator, class ResultType, class BinaryFunction>
+ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().reduce_config.block_size) void
+    segmented_reduce_csr_fixup_kernel(
+        OutputIterator                                      output,
+        const segmented_reduce_csr_block_state<ResultType>* block_states,
+        const unsigned int                                  block_count,
+        BinaryFunction                                      reduce_op)
+{
+    segmented_reduce_csr_fixup_kernel_impl<Config>(output, block_states, block_count, reduce_op);
+}
+
 #define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
     { \
         auto _error = hipGetLastError(); \
@@ -141,6 +179,105 @@ hipError_t segmented_reduce_impl(void * temporary_storage,
     return hipSuccess;
 }
 
+template<class Config,
+         class InputIterator,
+         class OutputIterator,
+         class OffsetIterator,
+         class InitValueType,
+         class BinaryFunction>
+inline hipError_t segmented_reduce_csr_impl(void*          temporary_storage,
+                                            size_t&        storage_size,
+                                            InputIterator  input,
+                                            OutputIterator output,
+                                            unsigned int   segments,
+                                            OffsetIterator offsets,
+                                            BinaryFunction reduce_op,
+                                            InitValueType  initial_value,
+                                            hipStream_t    stream,
+                                            bool           debug_synchronous)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    using result_type =
+        typename ::rocprim::invoke_result_binary_op<input_type, BinaryFunction>::type;
+    using block_state_type = segmented_reduce_csr_block_state<result_type>;
+
+    using config = wrapped_reduce_config<Config, result_type>;
+
+    detail::target_arch target_arch;
+    hipError_t          result = host_target_arch(stream, target_arch);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    const reduce_config_params params = dispatch_target_arch<config>(target_arch);
+
+    const unsigned int block_size = params.reduce_config.block_size;
+
+    // The number of values is only known on the device, launch enough blocks to fill it.
+    // Every block processes an equal part of the merge path.
+    unsigned int grid_size;
+    result = get_persistent_grid_size(segmented_reduce_csr_kernel<config,
+                                                                  InputIterator,
+                                                                  OutputIterator,
+                                                                  OffsetIterator,
+                                                                  result_type,
+                                                                  BinaryFunction>,
+                                      block_size,
+                                      stream,
+                                      grid_size);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    block_state_type* block_states = nullptr;
+
+    result = detail::temp_storage::partition(
+        temporary_storage,
+        storage_size,
+        detail::temp_storage::make_linear_partition(
+            detail::temp_storage::ptr_aligned_array(&block_states, grid_size)));
+    if(result != hipSuccess || temporary_storage == nullptr)
+    {
+        return result;
+    }
+
+    if(segments == 0u)
+    {
+        return hipSuccess;
+    }
+
+    if(debug_synchronous)
+    {
+        std::cout << "segments " << segments << '\n';
+        std::cout << "block_size " << block_size << '\n';
+        std::cout << "items_per_thread " << params.reduce_config.items_per_thread << '\n';
+        std::cout << "grid_size " << grid_size << '\n';
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    segmented_reduce_csr_kernel<config>
+        <<<dim3(grid_size), dim3(block_size), 0, stream>>>(input,
+                                                           output,
+                                                           segments,
+                                                           offsets,
+                                                           reduce_op,
+                                                           static_cast<result_type>(initial_value),
+                                                           block_states);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_reduce_csr_kernel", segments, start);
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    segmented_reduce_csr_fixup_kernel<config>
+        <<<dim3(1), dim3(block_size), 0, stream>>>(output, block_states, grid_size, reduce_op);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_reduce_csr_fixup_kernel",
+                                                grid_size,
+                                                start);
+
+    return hipSuccess;
+}
+
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
 
 } // end of detail namespace
@@ -268,6 +405,120 @@ hipError_t segmented_reduce(void * temporary_storage,
     );
 }
 
+/// \brief Parallel segmented reduction primitive for device level, balanced by merge path.
+///
+/// segmented_reduce_csr function performs a device-wide reduction operation across multiple
+/// sequences described by a single array of offsets (as the row offsets of a CSR sparse matrix)
+/// using binary \p reduce_op operator. Contrary to \p segmented_reduce, which processes every
+/// segment with one block, the segments and the values are distributed evenly among the
+/// threads with merge path, so the performance does not depend on the lengths of the segments.
+/// It is the preferred algorithm for many short segments or when the lengths vary a lot.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Range specified by \p offsets must have <tt>segments + 1</tt> elements, segment \p i is
+/// <tt>[offsets[i], offsets[i + 1])</tt>. The offsets must be non-decreasing.
+/// * Ranges specified by \p input must have at least <tt>offsets[segments]</tt> elements,
+/// \p output must have \p segments elements.
+/// * The values of a segment are reduced in order, starting with \p initial_value, so
+/// \p reduce_op only needs to be associative. Empty segments are set to \p initial_value.
+///
+/// \tparam Config - [optional] configuration of the primitive. It has to be \p reduce_config or a class derived from it.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for reduction. Default type
+/// is \p rocprim::plus<T>, where \p T is a \p value_type of \p InputIterator.
+/// \tparam InitValueType - type of the initial value.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the reduction operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to reduce.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] offsets - iterator to the first element in the range of offsets.
+/// \param [in] reduce_op - binary operation function object that will be used for reduction.
+/// The signature of the function should be equivalent to the following:
+/// <tt>T f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] initial_value - initial value to start the reduction.
+/// \param [in] stream - [optional] HIP stream object. The default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. The default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful reduction; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example the rows of a sparse matrix in CSR format are summed.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// unsigned int segments;   // e.g., 4
+/// float * values;          // e.g., [1, 2, 3, 4, 5, 6]
+/// float * output;          // empty array of 4 elements
+/// int * row_offsets;       // e.g. [0, 2, 2, 3, 6]
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::segmented_reduce_csr(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     values, output, segments, row_offsets,
+///     rocprim::plus<float>(), 0.0f
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform segmented reduction
+/// rocprim::segmented_reduce_csr(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     values, output, segments, row_offsets,
+///     rocprim::plus<float>(), 0.0f
+/// );
+/// // output: [3, 0, 3, 15]
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class BinaryFunction = ::rocprim::plus<typename std::iterator_traits<InputIterator>::value_type>,
+    class InitValueType = typename std::iterator_traits<InputIterator>::value_type
+>
+inline
+hipError_t segmented_reduce_csr(void * temporary_storage,
+                                size_t& storage_size,
+                                InputIterator input,
+                                OutputIterator output,
+                                unsigned int segments,
+                                OffsetIterator offsets,
+                                BinaryFunction reduce_op = BinaryFunction(),
+                                InitValueType initial_value = InitValueType(),
+                                hipStream_t stream = 0,
+                                bool debug_synchronous = false)
+{
+    return detail::segmented_reduce_csr_impl<Config>(
+        temporary_storage, storage_size,
+        input, output,
+        segments, offsets,
+        reduce_op, initial_value,
+        stream, debug_synchronous
+    );
+}
+
 /// @}
 // end of group devicemodule
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2018-2022 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -46,6 +46,7 @@ BEGIN_ROCPRIM_NAMESPACE
 /// \tparam FlagBlockLoadMethod - method for loading flag values.
 /// \tparam BlockScanMethod - algorithm for block scan.
 /// \tparam SizeLimit - limit on the number of items for a single select kernel launch.
+/// \tparam GridLaunchMode - number of blocks of the select kernel.
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
@@ -53,7 +54,8 @@ template<
     ::rocprim::block_load_method ValueBlockLoadMethod,
     ::rocprim::block_load_method FlagBlockLoadMethod,
     ::rocprim::block_scan_algorithm BlockScanMethod,
-    unsigned int SizeLimit = ROCPRIM_GRID_SIZE_LIMIT
+    unsigned int SizeLimit = ROCPRIM_GRID_SIZE_LIMIT,
+    ::rocprim::grid_launch_mode GridLaunchMode = ::rocprim::grid_launch_mode::default_mode
 >
 struct select_config
 {
@@ -71,6 +73,8 @@ struct select_config
     static constexpr block_scan_algorithm block_scan_method = BlockScanMethod;
     /// \brief Limit on the number of items for a single select kernel launch.
     static constexpr unsigned int size_limit = SizeLimit;
+    /// \brief Number of blocks of the select kernel.
+    static constexpr grid_launch_mode launch_mode = GridLaunchMode;
 };
 
 namespace detail
@@ -0,0 +1,552 @@
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_TRACE_HPP_
+#define ROCPRIM_DEVICE_DEVICE_TRACE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "../config.hpp"
+
+#if ROCPRIM_USE_ROCTX
+    #include <roctracer/roctx.h>
+#endif
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+/// \brief Counters of the decoupled look-back of a tile, see \p instrument_scope.
+struct lookback_counters
+{
+    /// \brief Windows of preceding tiles (one tile per lane of a warp) read until a complete
+    /// prefix was found.
+    unsigned int lookback_iterations;
+    /// \brief Polls of prefixes of preceding tiles that were not available yet.
+    unsigned int spin_loops;
+    /// \brief \p s_sleep instructions executed while polling, only devices that use the
+    /// sleeping scan state (gfx908 before revision 2) sleep.
+    unsigned int sleeps;
+    /// \brief Loads of available prefixes that were repeated because the words of a multi-word
+    /// prefix were written by different states.
+    unsigned int prefix_reloads;
+};
+
+/// \brief Counters of the atomic updates of the bins of a block of a histogram, see
+/// \p instrument_scope.
+///
+/// A conflict is an atomic add of a lane to the same address as another lane of its warp in the
+/// same instruction, the hardware serializes them.
+struct histogram_counters
+{
+    /// \brief Atomic adds to the privatized histograms in shared memory.
+    unsigned int shared_atomics;
+    /// \brief Conflicting atomic adds to the histograms in shared memory.
+    unsigned int shared_conflicts;
+    /// \brief Atomic adds to the histograms in global memory.
+    unsigned int global_atomics;
+    /// \brief Conflicting atomic adds to the histograms in global memory.
+    unsigned int global_conflicts;
+};
+
+/// \brief Description of a kernel launched by a device-level algorithm, see
+/// \p set_trace_callback.
+struct trace_event
+{
+    /// \brief Name of the device-level algorithm, e.g. <tt>"inclusive_scan"</tt>.
+    const char* algorithm;
+    /// \brief Name of the kernel, the same as printed with \p debug_synchronous.
+    const char* kernel;
+    /// \brief Number of items processed by the kernel.
+    size_t size;
+    /// \brief Number of blocks of the launch.
+    unsigned int grid_size;
+    /// \brief Number of threads per block of the launch.
+    unsigned int block_size;
+    /// \brief Items per thread of the config of the kernel, 0 if the kernel does not process
+    /// tiles of items (e.g. the initialization of a look-back scan state).
+    unsigned int items_per_thread;
+    /// \brief Size in bytes of the temporary storage of the algorithm call.
+    size_t temporary_storage_bytes;
+    /// \brief Stream of the launch.
+    hipStream_t stream;
+    /// \brief Execution time of the kernel in milliseconds, measured between two HIP events.
+    /// Negative if the time is not measured.
+    float elapsed_ms;
+    /// \brief Device buffer of the \p instrument_scope of the call, the look-back kernels of the
+    /// call add their counters to it. \p nullptr if there is none or if the look-back is not
+    /// instrumented (<tt>ROCPRIM_INSTRUMENT=0</tt>).
+    lookback_counters* counters;
+    /// \brief Device buffer of histogram counters of the \p instrument_scope of the call, the
+    /// histogram kernels of the call add their counters to it. \p nullptr if there is none or
+    /// if the histograms are not instrumented.
+    histogram_counters* bin_counters;
+};
+
+/// \brief Callback receiving the kernel launches of the device-level algorithms.
+///
+/// \p user_data is the pointer passed when the callback was set. The callback may call
+/// rocPRIM algorithms, but their launches are not traced.
+using trace_callback = void (*)(const trace_event& event, void* user_data);
+
+namespace detail
+{
+
+struct instrument_buffer
+{
+    lookback_counters*  counters;
+    size_t              size;
+    histogram_counters* bin_counters;
+    size_t              bin_size;
+};
+
+// Buffers of the instrument_scopes of the calling thread
+inline instrument_buffer& current_instrument_buffer()
+{
+    static thread_local instrument_buffer buffer{nullptr, 0, nullptr, 0};
+    return buffer;
+}
+
+struct trace_settings
+{
+    trace_callback callback;
+    void*          user_data;
+    bool           measure_time;
+};
+
+inline std::mutex& trace_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline trace_settings& global_trace_settings()
+{
+    static trace_settings settings{nullptr, nullptr, false};
+    return settings;
+}
+
+// Whether global_trace_settings has a callback, so that calls without tracing do not lock
+// trace_mutex
+inline std::atomic<bool>& global_trace_enabled()
+{
+    static std::atomic<bool> enabled{false};
+    return enabled;
+}
+
+// Settings of the trace_scope of the calling thread, nullptr if there is none
+inline const trace_settings*& thread_trace_settings()
+{
+    static thread_local const trace_settings* settings = nullptr;
+    return settings;
+}
+
+inline trace_settings current_trace_settings()
+{
+    if(const trace_settings* settings = thread_trace_settings())
+    {
+        return *settings;
+    }
+    if(!global_trace_enabled().load(std::memory_order_acquire))
+    {
+        return trace_settings{nullptr, nullptr, false};
+    }
+    std::lock_guard<std::mutex> lock(trace_mutex());
+    return global_trace_settings();
+}
+
+class trace_algorithm;
+
+// Innermost traced algorithm of the calling thread, nullptr if there is none
+inline trace_algorithm*& current_trace_algorithm()
+{
+    static thread_local trace_algorithm* algorithm = nullptr;
+    return algorithm;
+}
+
+// The algorithms called by the callback are not traced
+inline void call_trace_callback(const trace_settings& settings, const trace_event& event)
+{
+    trace_algorithm* const      previous_algorithm = current_trace_algorithm();
+    const trace_settings* const previous_settings  = thread_trace_settings();
+    const trace_settings        disabled{nullptr, nullptr, false};
+    current_trace_algorithm() = nullptr;
+    thread_trace_settings()   = &disabled;
+
+    settings.callback(event, settings.user_data);
+
+    thread_trace_settings()   = previous_settings;
+    current_trace_algorithm() = previous_algorithm;
+}
+
+// A timed kernel, its callback is delivered once its stop event has completed
+struct pending_trace_event
+{
+    trace_event    event;
+    trace_settings settings;
+    hipEvent_t     start;
+    hipEvent_t     stop;
+};
+
+inline std::vector<pending_trace_event>& pending_trace_events()
+{
+    static std::vector<pending_trace_event> events;
+    return events;
+}
+
+// Delivers the callbacks of the timed kernels that have finished. Only waits for the kernels
+// if wait is true, otherwise the events are queried.
+inline hipError_t deliver_trace_events(const bool wait)
+{
+    std::vector<pending_trace_event> events;
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex());
+        if(pending_trace_events().empty())
+        {
+            return hipSuccess;
+        }
+        events.swap(pending_trace_events());
+    }
+
+    hipError_t                       result = hipSuccess;
+    std::vector<pending_trace_event> not_ready;
+    std::vector<pending_trace_event> ready;
+    for(pending_trace_event& pending : events)
+    {
+        const hipError_t status
+            = wait ? hipEventSynchronize(pending.stop) : hipEventQuery(pending.stop);
+        if(status == hipErrorNotReady)
+        {
+            not_ready.push_back(pending);
+            continue;
+        }
+        if(status != hipSuccess
+           || hipEventElapsedTime(&pending.event.elapsed_ms, pending.start, pending.stop)
+                  != hipSuccess)
+        {
+            result                   = result != hipSuccess ? result : status;
+            pending.event.elapsed_ms = -1.0f;
+        }
+        static_cast<void>(hipEventDestroy(pending.start));
+        static_cast<void>(hipEventDestroy(pending.stop));
+        ready.push_back(pending);
+    }
+
+    if(!not_ready.empty())
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex());
+        auto&                       pending = pending_trace_events();
+        pending.insert(pending.begin(), not_ready.begin(), not_ready.end());
+    }
+
+    for(const pending_trace_event& pending : ready)
+    {
+        call_trace_callback(pending.settings, pending.event);
+    }
+    return result;
+}
+
+// Traces the kernels of a device-level algorithm call while alive. It is created once the
+// temporary storage is known, the kernels report themselves with trace_kernel. Tracing never
+// synchronizes the stream: with time measurement, the callback of a kernel is delayed until
+// its stop event has completed.
+class trace_algorithm
+{
+public:
+    trace_algorithm(const char*       algorithm,
+                    const size_t      temporary_storage_bytes,
+                    const hipStream_t stream)
+        : settings_(current_trace_settings())
+        , algorithm_(algorithm)
+        , temporary_storage_bytes_(temporary_storage_bytes)
+        , stream_(stream)
+        , counters_(ROCPRIM_INSTRUMENT ? current_instrument_buffer().counters : nullptr)
+        , bin_counters_(ROCPRIM_INSTRUMENT ? current_instrument_buffer().bin_counters : nullptr)
+        , start_(nullptr)
+        , previous_(current_trace_algorithm())
+    {
+#if ROCPRIM_USE_ROCTX
+        roctxRangePushA(algorithm);
+#endif
+        if(settings_.callback == nullptr)
+        {
+            return;
+        }
+        current_trace_algorithm() = this;
+        if(settings_.measure_time)
+        {
+            start_ = record_event();
+        }
+    }
+
+    ~trace_algorithm()
+    {
+        if(settings_.callback != nullptr)
+        {
+            current_trace_algorithm() = previous_;
+            if(start_ != nullptr)
+            {
+                static_cast<void>(hipEventDestroy(start_));
+            }
+            static_cast<void>(deliver_trace_events(false));
+        }
+#if ROCPRIM_USE_ROCTX
+        roctxRangePop();
+#endif
+    }
+
+    trace_algorithm(const trace_algorithm&)            = delete;
+    trace_algorithm& operator=(const trace_algorithm&) = delete;
+
+    void kernel(const char*        kernel,
+                const size_t       size,
+                const unsigned int grid_size,
+                const unsigned int block_size,
+                const unsigned int items_per_thread)
+    {
+        trace_event event{algorithm_,
+                          kernel,
+                          size,
+                          grid_size,
+                          block_size,
+                          items_per_thread,
+                          temporary_storage_bytes_,
+                          stream_,
+                          -1.0f,
+                          counters_,
+                          bin_counters_};
+
+        // The kernel ran between the previous event of the stream and this one
+        const hipEvent_t stop = start_ != nullptr ? record_event() : nullptr;
+        if(stop == nullptr)
+        {
+            if(start_ != nullptr)
+            {
+                static_cast<void>(hipEventRecord(start_, stream_));
+            }
+            call_trace_callback(settings_, event);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(trace_mutex());
+            pending_trace_events().push_back(pending_trace_event{event, settings_, start_, stop});
+        }
+        start_ = record_event();
+        static_cast<void>(deliver_trace_events(false));
+    }
+
+    // Excludes the work enqueued since the last traced kernel from the time of the next one
+    void restart_timer()
+    {
+        if(start_ != nullptr)
+        {
+            static_cast<void>(hipEventRecord(start_, stream_));
+        }
+    }
+
+private:
+    hipEvent_t record_event() const
+    {
+        hipEvent_t event;
+        if(hipEventCreate(&event) != hipSuccess)
+        {
+            return nullptr;
+        }
+        if(hipEventRecord(event, stream_) != hipSuccess)
+        {
+            static_cast<void>(hipEventDestroy(event));
+            return nullptr;
+        }
+        return event;
+    }
+
+    trace_settings      settings_;
+    const char*         algorithm_;
+    size_t              temporary_storage_bytes_;
+    hipStream_t         stream_;
+    lookback_counters*  counters_;
+    histogram_counters* bin_counters_;
+    hipEvent_t          start_;
+    trace_algorithm*    previous_;
+};
+
+// Reports a kernel launch to the innermost traced algorithm of the calling thread
+inline void trace_kernel(const char*        kernel,
+                         const size_t       size,
+                         const unsigned int grid_size,
+                         const unsigned int block_size,
+                         const unsigned int items_per_thread)
+{
+    if(trace_algorithm* algorithm = current_trace_algorithm())
+    {
+        algorithm->kernel(kernel, size, grid_size, block_size, items_per_thread);
+    }
+}
+
+// Called after untraced work of a traced algorithm (e.g. a nested algorithm call), so that it
+// is not included in the time of the next traced kernel
+inline void restart_trace_timer()
+{
+    if(trace_algorithm* algorithm = current_trace_algorithm())
+    {
+        algorithm->restart_timer();
+    }
+}
+
+} // end namespace detail
+
+/// \brief Sets the callback receiving the kernel launches of the device-level algorithms of
+/// all threads, \p nullptr disables tracing.
+///
+/// Unlike \p debug_synchronous, tracing never synchronizes the stream and never prints. Every
+/// kernel launch of a traced algorithm is reported with the name of the algorithm and of the
+/// kernel, its launch configuration and the size of the temporary storage of the call, see
+/// \p trace_event. The traced algorithms are \p reduce, \p inclusive_scan, \p exclusive_scan,
+/// the onesweep and block sort paths of \p radix_sort_keys and \p radix_sort_pairs,
+/// \p partition, \p select, and the histograms (\p histogram_even, \p histogram_range, their
+/// multi-channel and weighted variants, and \p histogram_nd_even).
+///
+/// If \p measure_time is \p true, a HIP event is recorded after every kernel, and the time
+/// between consecutive events is reported in \p trace_event::elapsed_ms. The callback of a
+/// timed kernel is delayed until the kernel has finished: it is called from a later traced
+/// launch or from \p flush_trace, which waits for all timed kernels.
+///
+/// If rocPRIM is compiled with <tt>ROCPRIM_USE_ROCTX=1</tt>, every call of a traced algorithm
+/// is also a ROCTX range, so that rocprof traces show the boundaries of the algorithms.
+///
+/// \param [in] callback - the callback, \p nullptr to disable tracing.
+/// \param [in] user_data - pointer passed to every call of \p callback.
+/// \param [in] measure_time - measure the execution time of the kernels.
+inline void set_trace_callback(const trace_callback callback,
+                               void* const          user_data    = nullptr,
+                               const bool           measure_time = false)
+{
+    std::lock_guard<std::mutex> lock(detail::trace_mutex());
+    detail::global_trace_settings() = detail::trace_settings{callback, user_data, measure_time};
+    detail::global_trace_enabled().store(callback != nullptr, std::memory_order_release);
+}
+
+/// \brief Waits for the timed kernels and calls the callbacks still delayed, see
+/// \p set_trace_callback.
+///
+/// \returns the first error of the events, \p hipSuccess if there is none.
+inline hipError_t flush_trace()
+{
+    return detail::deliver_trace_events(true);
+}
+
+/// \brief While alive, the algorithms called by the creating thread report their kernel
+/// launches to \p callback instead of the callback of \p set_trace_callback, e.g. to trace
+/// a single call. A \p nullptr callback disables tracing of the thread.
+class trace_scope
+{
+public:
+    /// \brief Sets \p callback for the calling thread, see \p set_trace_callback.
+    explicit trace_scope(const trace_callback callback,
+                         void* const          user_data    = nullptr,
+                         const bool           measure_time = false)
+        : settings_{callback, user_data, measure_time}
+        , previous_settings_(detail::thread_trace_settings())
+    {
+        detail::thread_trace_settings() = &settings_;
+    }
+
+    /// \brief Restores the callback of the thread.
+    ~trace_scope()
+    {
+        detail::thread_trace_settings() = previous_settings_;
+    }
+
+    trace_scope(const trace_scope&)            = delete;
+    trace_scope& operator=(const trace_scope&) = delete;
+
+private:
+    detail::trace_settings        settings_;
+    const detail::trace_settings* previous_settings_;
+};
+
+/// \brief While alive, the decoupled look-back scans created by the calling thread add the
+/// counters of every tile to \p counters, tile \p i to <tt>counters[i % size]</tt>.
+///
+/// The counts are only compiled in with <tt>ROCPRIM_INSTRUMENT=1</tt>, otherwise the look-back
+/// has no overhead and \p counters is left unchanged. The counters are only added to, the
+/// buffer has to be zeroed by the caller. Instrumented algorithms are the ones with a
+/// decoupled look-back: \p inclusive_scan, \p exclusive_scan, \p inclusive_scan_by_key,
+/// \p exclusive_scan_by_key, \p reduce_by_key, \p partition, \p select, \p unique and
+/// \p batch_memcpy. The buffer is also reported to the tracing callback, see
+/// \p trace_event::counters.
+///
+/// Created with a buffer of \p histogram_counters, the histogram kernels instead add the
+/// counters of the atomic updates of every block to it, block \p i (in row-major order of the
+/// grid) to <tt>counters[i % size]</tt>, see \p trace_event::bin_counters. Instrumented are the
+/// shared and global memory implementations of all histograms.
+class instrument_scope
+{
+public:
+    /// \brief Sets the counters of the calling thread.
+    ///
+    /// \param [in] counters - device buffer of at least \p size counters.
+    /// \param [in] size - number of counters, tiles beyond it share the counters.
+    instrument_scope(lookback_counters* const counters, const size_t size)
+        : previous_buffer_(detail::current_instrument_buffer())
+    {
+        detail::instrument_buffer& buffer = detail::current_instrument_buffer();
+        buffer.counters                   = size != 0 ? counters : nullptr;
+        buffer.size                       = size;
+    }
+
+    /// \brief Sets the histogram counters of the calling thread, the look-back counters of an
+    /// enclosing scope stay active.
+    ///
+    /// \param [in] counters - device buffer of at least \p size counters.
+    /// \param [in] size - number of counters, blocks beyond it share the counters.
+    instrument_scope(histogram_counters* const counters, const size_t size)
+        : previous_buffer_(detail::current_instrument_buffer())
+    {
+        detail::instrument_buffer& buffer = detail::current_instrument_buffer();
+        buffer.bin_counters               = size != 0 ? counters : nullptr;
+        buffer.bin_size                   = size;
+    }
+
+    /// \brief Restores the counters of the thread.
+    ~instrument_scope()
+    {
+        detail::current_instrument_buffer() = previous_buffer_;
+    }
+
+    instrument_scope(const instrument_scope&)            = delete;
+    instrument_scope& operator=(const instrument_scope&) = delete;
+
+private:
+    detail::instrument_buffer previous_buffer_;
+};
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_TRACE_HPP_
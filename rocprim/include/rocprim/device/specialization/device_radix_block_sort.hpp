@@ -23,6 +23,7 @@
 
 #include "../detail/device_radix_sort.hpp"
 #include "../device_radix_sort_config.hpp"
+#include "../device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -139,6 +140,11 @@ inline hipError_t radix_sort_block_sort(KeysInputIterator    keys_input,
                                                                               bit,
                                                                               current_radix_bits);
     ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("radix_sort_block_sort_kernel", size, start)
+    trace_kernel("radix_sort_block_sort_kernel",
+                 size,
+                 sort_number_of_blocks,
+                 params.block_size,
+                 params.items_per_thread);
     return hipSuccess;
 }
 
@@ -53,23 +53,32 @@
 #include "block/block_store.hpp"
 
 #include "device/device_adjacent_difference.hpp"
+#include "device/device_allocator.hpp"
 #include "device/device_binary_search.hpp"
 #include "device/device_copy.hpp"
+#include "device/device_gather_scatter.hpp"
 #include "device/device_histogram.hpp"
+#include "device/device_load_balanced_expand.hpp"
 #include "device/device_memcpy.hpp"
 #include "device/device_merge.hpp"
 #include "device/device_merge_sort.hpp"
 #include "device/device_partition.hpp"
+#include "device/device_plan.hpp"
+#include "device/device_quantiles.hpp"
 #include "device/device_radix_sort.hpp"
 #include "device/device_reduce.hpp"
 #include "device/device_reduce_by_key.hpp"
+#include "device/device_run_length_decode.hpp"
 #include "device/device_run_length_encode.hpp"
 #include "device/device_scan.hpp"
 #include "device/device_scan_by_key.hpp"
+#include "device/device_scan_state.hpp"
+#include "device/device_segmented_merge_sort.hpp"
 #include "device/device_segmented_radix_sort.hpp"
 #include "device/device_segmented_reduce.hpp"
 #include "device/device_segmented_scan.hpp"
 #include "device/device_select.hpp"
+#include "device/device_trace.hpp"
 #include "device/device_transform.hpp"
 
 /// \brief The top level rocPRIM namespace.
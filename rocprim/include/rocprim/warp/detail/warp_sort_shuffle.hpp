@@ -28,6 +28,7 @@
 
 #include "../../functional.hpp"
 #include "../../intrinsics.hpp"
+#include "../../types.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -184,6 +185,7 @@ private:
             // and is flipped if dir is true
             const bool local_dir = ((base & group_size) > 0) != dir;
 
+            ROCPRIM_UNROLL
             for(unsigned i = 0; i < offset; ++i)
             {
                 thread_swap(kv..., base + i, base + i + offset, local_dir, compare_function);
@@ -306,6 +308,44 @@ private:
         thread_merge<1, ItemsPerThread>(false, compare_function, kv...);
     }
 
+    // Large values are gathered with ItemsPerThread shuffles per item after sorting indices.
+    // Moving them through the network instead takes a shuffle per item and cross-lane stage.
+    template<unsigned int ItemsPerThread>
+    using gather_values = std::integral_constant<
+        bool,
+        (ItemsPerThread <= Log2<WarpSize>::VALUE * (Log2<WarpSize>::VALUE + 1) / 2)>;
+
+    // The position of an item in the input of a stable sort (warp-striped order) is used
+    // to break ties between equivalent keys.
+    using stable_key_type = ::rocprim::tuple<Key, unsigned int>;
+
+    template<unsigned int ItemsPerThread>
+    ROCPRIM_DEVICE ROCPRIM_INLINE void
+        make_stable_keys(const Key (&thread_keys)[ItemsPerThread],
+                         stable_key_type (&stable_keys)[ItemsPerThread])
+    {
+        const unsigned int lane = detail::logical_lane_id<WarpSize>();
+        ROCPRIM_UNROLL
+        for(unsigned int item = 0; item < ItemsPerThread; item++)
+        {
+            stable_keys[item] = stable_key_type(thread_keys[item], item * WarpSize + lane);
+        }
+    }
+
+    template<class BinaryFunction>
+    struct stable_compare
+    {
+        BinaryFunction compare_function;
+
+        ROCPRIM_DEVICE ROCPRIM_INLINE bool operator()(const stable_key_type& a,
+                                                      const stable_key_type& b) const
+        {
+            const bool ab = compare_function(::rocprim::get<0>(a), ::rocprim::get<0>(b));
+            const bool ba = compare_function(::rocprim::get<0>(b), ::rocprim::get<0>(a));
+            return ab || (!ba && ::rocprim::get<1>(a) < ::rocprim::get<1>(b));
+        }
+    };
+
 public:
     static_assert(detail::is_power_of_two(WarpSize), "WarpSize must be power of 2");
 
@@ -380,7 +420,21 @@ public:
     }
 
     template<unsigned int ItemsPerThread, class BinaryFunction, class V = Value>
-    ROCPRIM_DEVICE ROCPRIM_INLINE typename std::enable_if<!(sizeof(V) <= sizeof(int))>::type
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+        typename std::enable_if<!(sizeof(V) <= sizeof(int))
+                                && !gather_values<ItemsPerThread>::value>::type
+        sort(Key (&thread_keys)[ItemsPerThread],
+             Value (&thread_values)[ItemsPerThread],
+             BinaryFunction compare_function)
+    {
+        // Gathering the values would take more shuffles than moving them through the network.
+        bitonic_sort<ItemsPerThread>(compare_function, thread_keys, thread_values);
+    }
+
+    template<unsigned int ItemsPerThread, class BinaryFunction, class V = Value>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+        typename std::enable_if<!(sizeof(V) <= sizeof(int))
+                                && gather_values<ItemsPerThread>::value>::type
         sort(Key (&thread_keys)[ItemsPerThread],
              Value (&thread_values)[ItemsPerThread],
              BinaryFunction compare_function)
@@ -424,6 +478,44 @@ public:
         (void)storage;
         sort(thread_keys, thread_values, compare_function);
     }
+
+    template<unsigned int ItemsPerThread, class BinaryFunction>
+    ROCPRIM_DEVICE ROCPRIM_INLINE void stable_sort(Key (&thread_keys)[ItemsPerThread],
+                                                   BinaryFunction compare_function)
+    {
+        stable_key_type stable_keys[ItemsPerThread];
+        make_stable_keys(thread_keys, stable_keys);
+
+        warp_sort_shuffle<stable_key_type, WarpSize, empty_type>().sort(
+            stable_keys,
+            stable_compare<BinaryFunction>{compare_function});
+
+        ROCPRIM_UNROLL
+        for(unsigned int item = 0; item < ItemsPerThread; item++)
+        {
+            thread_keys[item] = ::rocprim::get<0>(stable_keys[item]);
+        }
+    }
+
+    template<unsigned int ItemsPerThread, class BinaryFunction>
+    ROCPRIM_DEVICE ROCPRIM_INLINE void stable_sort(Key (&thread_keys)[ItemsPerThread],
+                                                   Value (&thread_values)[ItemsPerThread],
+                                                   BinaryFunction compare_function)
+    {
+        stable_key_type stable_keys[ItemsPerThread];
+        make_stable_keys(thread_keys, stable_keys);
+
+        warp_sort_shuffle<stable_key_type, WarpSize, Value>().sort(
+            stable_keys,
+            thread_values,
+            stable_compare<BinaryFunction>{compare_function});
+
+        ROCPRIM_UNROLL
+        for(unsigned int item = 0; item < ItemsPerThread; item++)
+        {
+            thread_keys[item] = ::rocprim::get<0>(stable_keys[item]);
+        }
+    }
 };
 
 } // end namespace detail
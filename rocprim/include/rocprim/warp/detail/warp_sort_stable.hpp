@@ -59,30 +59,91 @@ private:
     using storage_type_
         = std::conditional_t<with_values, storage_type_keys_values, storage_type_keys>;
 
-    /// Sort the keys and values of each thread separately.
-    template<bool is_incomplete, typename CompareFunction>
-    ROCPRIM_DEVICE ROCPRIM_INLINE void thread_sort(Key (&thread_keys)[ItemsPerThread],
-                                                   CompareFunction    compare_function,
-                                                   const unsigned int input_size = items_per_block)
+    ROCPRIM_DEVICE ROCPRIM_INLINE static void swap_items(unsigned int, unsigned int) {}
+
+    template<typename T, typename... Arrays>
+    ROCPRIM_DEVICE ROCPRIM_INLINE static void
+        swap_items(unsigned int i, unsigned int j, T (&items)[ItemsPerThread], Arrays&... arrays)
     {
-        const auto thread_offset     = rocprim::flat_block_thread_id() * ItemsPerThread;
-        const auto thread_input_size = thread_offset > input_size ? 0 : input_size - thread_offset;
+        ::rocprim::swap(items[i], items[j]);
+        swap_items(i, j, arrays...);
+    }
+
+    /// Sort the items of a thread with a fully unrolled bitonic network, padded to the next
+    /// power of two. Every exchange moves the smaller item to the lower index, so the padding
+    /// never takes part. Equal keys are ordered by their original position, which makes the
+    /// sort stable. The items past \p thread_input_size are ordered after all others.
+    template<bool is_incomplete, typename CompareFunction, typename... Values>
+    ROCPRIM_DEVICE ROCPRIM_INLINE void thread_sort_network(Key (&thread_keys)[ItemsPerThread],
+                                                           CompareFunction    compare_function,
+                                                           const unsigned int thread_input_size,
+                                                           Values&... thread_values)
+    {
+        constexpr unsigned int network_size = next_power_of_two(ItemsPerThread);
 
+        unsigned int positions[ItemsPerThread];
         ROCPRIM_UNROLL
         for(auto i = 0u; i < ItemsPerThread; ++i)
         {
+            positions[i] = i;
+        }
+
+        const auto exchange = [&](const unsigned int i, const unsigned int j)
+        {
+            const bool i_valid = !is_incomplete || positions[i] < thread_input_size;
+            const bool j_valid = !is_incomplete || positions[j] < thread_input_size;
+
+            const bool j_first
+                = j_valid ? !i_valid || compare_function(thread_keys[j], thread_keys[i])
+                                || (!compare_function(thread_keys[i], thread_keys[j])
+                                    && positions[j] < positions[i])
+                          : !i_valid && positions[j] < positions[i];
+            if(j_first)
+            {
+                swap_items(i, j, thread_keys, positions, thread_values...);
+            }
+        };
+
+        ROCPRIM_UNROLL
+        for(auto k = 2u; k <= network_size; k *= 2u)
+        {
+            ROCPRIM_UNROLL
+            for(auto i = 0u; i < network_size; ++i)
+            {
+                const auto j = i ^ (k - 1u);
+                if(i < j && j < ItemsPerThread)
+                {
+                    exchange(i, j);
+                }
+            }
             ROCPRIM_UNROLL
-            for(auto j = i & 1u; j < ItemsPerThread - 1u; j += 2u)
+            for(auto m = k / 4u; m > 0u; m /= 2u)
             {
-                if(j + 1 < thread_input_size
-                   && compare_function(thread_keys[j + 1], thread_keys[j]))
+                ROCPRIM_UNROLL
+                for(auto i = 0u; i < network_size; ++i)
                 {
-                    ::rocprim::swap(thread_keys[j + 1], thread_keys[j]);
+                    const auto j = i ^ m;
+                    if(i < j && j < ItemsPerThread)
+                    {
+                        exchange(i, j);
+                    }
                 }
             }
         }
     }
 
+    /// Sort the keys and values of each thread separately.
+    template<bool is_incomplete, typename CompareFunction>
+    ROCPRIM_DEVICE ROCPRIM_INLINE void thread_sort(Key (&thread_keys)[ItemsPerThread],
+                                                   CompareFunction    compare_function,
+                                                   const unsigned int input_size = items_per_block)
+    {
+        const auto thread_offset     = rocprim::flat_block_thread_id() * ItemsPerThread;
+        const auto thread_input_size = thread_offset > input_size ? 0 : input_size - thread_offset;
+
+        thread_sort_network<is_incomplete>(thread_keys, compare_function, thread_input_size);
+    }
+
     /// Sort the keys and values of each thread separately.
     template<bool is_incomplete, typename CompareFunction>
     ROCPRIM_DEVICE ROCPRIM_INLINE void thread_sort(Key (&thread_keys)[ItemsPerThread],
@@ -93,20 +154,10 @@ private:
         const auto thread_offset     = rocprim::flat_block_thread_id() * ItemsPerThread;
         const auto thread_input_size = thread_offset > input_size ? 0 : input_size - thread_offset;
 
-        ROCPRIM_UNROLL
-        for(auto i = 0u; i < ItemsPerThread; ++i)
-        {
-            ROCPRIM_UNROLL
-            for(auto j = i & 1u; j < ItemsPerThread - 1u; j += 2u)
-            {
-                if(j + 1 < thread_input_size
-                   && compare_function(thread_keys[j + 1], thread_keys[j]))
-                {
-                    ::rocprim::swap(thread_keys[j + 1], thread_keys[j]);
-                    ::rocprim::swap(thread_values[j + 1], thread_values[j]);
-                }
-            }
-        }
+        thread_sort_network<is_incomplete>(thread_keys,
+                                           compare_function,
+                                           thread_input_size,
+                                           thread_values);
     }
 
     template<bool is_incomplete, class BinaryFunction>
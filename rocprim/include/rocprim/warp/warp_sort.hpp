@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2021 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -39,6 +39,7 @@ BEGIN_ROCPRIM_NAMESPACE
 /// \brief The warp_sort class provides warp-wide methods for computing a parallel
 /// sort of items across thread warps. This class currently implements parallel
 /// bitonic sort, and only accepts warp sizes that are powers of two.
+/// \p stable_sort keeps the input order of equivalent keys.
 ///
 /// \tparam Key Data type for parameter Key
 /// \tparam WarpSize [optional] The number of threads in a warp
@@ -513,6 +514,153 @@ public:
         ROCPRIM_PRINT_ERROR_ONCE("Specified warp size exceeds current hardware supported warp size. Aborting warp sort.");
         return;
     }
+
+    /// \brief Stable warp sort for any data type.
+    ///
+    /// Equivalent keys keep their order in the input, where the items are ordered warp-striped:
+    /// item \p i of logical lane \p l is at position <tt>i * WarpSize + l</tt> (as loaded by
+    /// \p warp_load_striped). The output is blocked, like for \p sort.
+    ///
+    /// \tparam ItemsPerThread - number of items per thread, must be a power of two.
+    /// The sorting networks are fully unrolled and kept in registers, up to 32 items
+    /// per thread are supported.
+    /// \tparam BinaryFunction - type of binary function used for sort. Default type
+    /// is rocprim::less<T>.
+    ///
+    /// \param thread_keys - input/output keys to pass to other threads
+    /// \param compare_function - binary operation function object that will be used for sort.
+    /// The signature of the function should be equivalent to the following:
+    /// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+    /// <tt>const &</tt>, but function object must not modify the objects passed to it.
+    template<
+        unsigned int ItemsPerThread,
+        class BinaryFunction = ::rocprim::less<Key>,
+        unsigned int FunctionWarpSize = WarpSize
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    auto stable_sort(Key (&thread_keys)[ItemsPerThread],
+                     BinaryFunction compare_function = BinaryFunction())
+        -> typename std::enable_if<(FunctionWarpSize <= __AMDGCN_WAVEFRONT_SIZE), void>::type
+    {
+        base_type::stable_sort(thread_keys, compare_function);
+    }
+
+    /// \brief Stable warp sort for any data type.
+    /// Invalid Warp Size
+    template<
+        unsigned int ItemsPerThread,
+        class BinaryFunction = ::rocprim::less<Key>,
+        unsigned int FunctionWarpSize = WarpSize
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    auto stable_sort(Key (&thread_keys)[ItemsPerThread],
+                     BinaryFunction compare_function = BinaryFunction())
+        -> typename std::enable_if<(FunctionWarpSize > __AMDGCN_WAVEFRONT_SIZE), void>::type
+    {
+        (void) thread_keys;      // disables unused parameter warning
+        (void) compare_function; // disables unused parameter warning
+        ROCPRIM_PRINT_ERROR_ONCE("Specified warp size exceeds current hardware supported warp size. Aborting warp sort.");
+        return;
+    }
+
+    /// \brief Stable warp sort for any data type using temporary storage.
+    ///
+    /// \param thread_keys - input/output keys to pass to other threads
+    /// \param storage - temporary storage for inputs
+    /// \param compare_function - binary operation function object that will be used for sort.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<
+        unsigned int ItemsPerThread,
+        class BinaryFunction = ::rocprim::less<Key>,
+        unsigned int FunctionWarpSize = WarpSize
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    auto stable_sort(Key (&thread_keys)[ItemsPerThread],
+                     storage_type& storage,
+                     BinaryFunction compare_function = BinaryFunction())
+        -> void
+    {
+        (void) storage;
+        stable_sort<ItemsPerThread, BinaryFunction, FunctionWarpSize>(thread_keys,
+                                                                      compare_function);
+    }
+
+    /// \brief Stable warp sort by key for any data type.
+    ///
+    /// Equivalent keys keep their order in the input, which is warp-striped (see the overload
+    /// without values). Values larger than 4 bytes are either moved through the sorting network
+    /// or gathered by their position after sorting, whichever takes fewer shuffles.
+    ///
+    /// \param thread_keys - input/output keys to pass to other threads
+    /// \param thread_values - input/outputs values to pass to other threads
+    /// \param compare_function - binary operation function object that will be used for sort.
+    /// The signature of the function should be equivalent to the following:
+    /// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+    /// <tt>const &</tt>, but function object must not modify the objects passed to it.
+    template<
+        unsigned int ItemsPerThread,
+        class BinaryFunction = ::rocprim::less<Key>,
+        unsigned int FunctionWarpSize = WarpSize
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    auto stable_sort(Key (&thread_keys)[ItemsPerThread],
+                     Value (&thread_values)[ItemsPerThread],
+                     BinaryFunction compare_function = BinaryFunction())
+        -> typename std::enable_if<(FunctionWarpSize <= __AMDGCN_WAVEFRONT_SIZE), void>::type
+    {
+        base_type::stable_sort(thread_keys, thread_values, compare_function);
+    }
+
+    /// \brief Stable warp sort by key for any data type.
+    /// Invalid Warp Size
+    template<
+        unsigned int ItemsPerThread,
+        class BinaryFunction = ::rocprim::less<Key>,
+        unsigned int FunctionWarpSize = WarpSize
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    auto stable_sort(Key (&thread_keys)[ItemsPerThread],
+                     Value (&thread_values)[ItemsPerThread],
+                     BinaryFunction compare_function = BinaryFunction())
+        -> typename std::enable_if<(FunctionWarpSize > __AMDGCN_WAVEFRONT_SIZE), void>::type
+    {
+        (void) thread_keys;      // disables unused parameter warning
+        (void) thread_values;    // disables unused parameter warning
+        (void) compare_function; // disables unused parameter warning
+        ROCPRIM_PRINT_ERROR_ONCE("Specified warp size exceeds current hardware supported warp size. Aborting warp sort.");
+        return;
+    }
+
+    /// \brief Stable warp sort by key for any data type using temporary storage.
+    ///
+    /// \param thread_keys - input/output keys to pass to other threads
+    /// \param thread_values - input/output values to pass to other threads
+    /// \param storage - temporary storage for inputs
+    /// \param compare_function - binary operation function object that will be used for sort.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<
+        unsigned int ItemsPerThread,
+        class BinaryFunction = ::rocprim::less<Key>,
+        unsigned int FunctionWarpSize = WarpSize
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    auto stable_sort(Key (&thread_keys)[ItemsPerThread],
+                     Value (&thread_values)[ItemsPerThread],
+                     storage_type& storage,
+                     BinaryFunction compare_function = BinaryFunction())
+        -> void
+    {
+        (void) storage;
+        stable_sort<ItemsPerThread, BinaryFunction, FunctionWarpSize>(thread_keys,
+                                                                      thread_values,
+                                                                      compare_function);
+    }
 };
 
 END_ROCPRIM_NAMESPACE
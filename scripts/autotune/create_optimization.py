@@ -1,6 +1,6 @@
 #!/usr/bin/env python3
 
-# Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+# Copyright (c) 2022-2024 Advanced Micro Devices, Inc. All rights reserved.
 #
 # Permission is hereby granted, free of charge, to any person obtaining a copy
 # of this software and associated documentation files (the "Software"), to deal
@@ -42,9 +42,87 @@ from typing import Dict, List, Callable
 from jinja2 import Environment, PackageLoader, select_autoescape
 
 TARGET_ARCHITECTURES = ['gfx803', 'gfx900', 'gfx906', 'gfx908', 'gfx90a', 'gfx1030', 'gfx1102']
+# Families of the known architectures (get_arch_family_from_name in config_types.hpp), as
+# (generation, wave size, LDS size in KiB, compute unit count class). Results of architectures that
+# are not in TARGET_ARCHITECTURES are used for the tuned architecture of the closest family.
+ARCHITECTURE_FAMILIES = {
+    'gfx803': ('gcn3', 64, 64, 'mid'),
+    'gfx900': ('gcn5', 64, 64, 'high'),
+    'gfx902': ('gcn5', 64, 64, 'low'),
+    'gfx904': ('gcn5', 64, 64, 'mid'),
+    'gfx906': ('gcn5', 64, 64, 'mid'),
+    'gfx909': ('gcn5', 64, 64, 'low'),
+    'gfx90c': ('gcn5', 64, 64, 'low'),
+    'gfx908': ('cdna1', 64, 64, 'high'),
+    'gfx90a': ('cdna2', 64, 64, 'high'),
+    'gfx940': ('cdna3', 64, 64, 'high'),
+    'gfx941': ('cdna3', 64, 64, 'high'),
+    'gfx942': ('cdna3', 64, 64, 'high'),
+    'gfx950': ('cdna4', 64, 160, 'high'),
+    'gfx1010': ('rdna1', 32, 64, 'mid'),
+    'gfx1011': ('rdna1', 32, 64, 'mid'),
+    'gfx1012': ('rdna1', 32, 64, 'mid'),
+    'gfx1013': ('rdna1', 32, 64, 'low'),
+    'gfx1030': ('rdna2', 32, 64, 'high'),
+    'gfx1031': ('rdna2', 32, 64, 'mid'),
+    'gfx1032': ('rdna2', 32, 64, 'mid'),
+    'gfx1033': ('rdna2', 32, 64, 'low'),
+    'gfx1034': ('rdna2', 32, 64, 'mid'),
+    'gfx1035': ('rdna2', 32, 64, 'low'),
+    'gfx1036': ('rdna2', 32, 64, 'low'),
+    'gfx1100': ('rdna3', 32, 64, 'high'),
+    'gfx1101': ('rdna3', 32, 64, 'mid'),
+    'gfx1102': ('rdna3', 32, 64, 'mid'),
+    'gfx1103': ('rdna3', 32, 64, 'low'),
+    'gfx1150': ('rdna3_5', 32, 64, 'low'),
+    'gfx1151': ('rdna3_5', 32, 64, 'mid'),
+    'gfx1200': ('rdna4', 32, 64, 'mid'),
+    'gfx1201': ('rdna4', 32, 64, 'high'),
+}
+# Values of arch_generation and cu_count_class in config_types.hpp
+ARCHITECTURE_GENERATIONS = {'gcn3': 0, 'gcn5': 1, 'cdna1': 2, 'cdna2': 3, 'cdna3': 4, 'cdna4': 5,
+                            'rdna1': 10, 'rdna2': 11, 'rdna3': 12, 'rdna3_5': 13, 'rdna4': 14}
+CU_COUNT_CLASSES = {'low': 0, 'mid': 1, 'high': 2}
+
+def get_architecture_family_distance(lhs: str, rhs: str) -> int:
+    """
+    Returns the distance of the families of two architectures, as arch_family_distance in config_types.hpp.
+    """
+    lhs_generation, lhs_wave_size, lhs_lds_size, lhs_cu_count = ARCHITECTURE_FAMILIES[lhs]
+    rhs_generation, rhs_wave_size, rhs_lds_size, rhs_cu_count = ARCHITECTURE_FAMILIES[rhs]
+    return ((1000 if lhs_wave_size != rhs_wave_size else 0)
+            + 10 * abs(ARCHITECTURE_GENERATIONS[lhs_generation] - ARCHITECTURE_GENERATIONS[rhs_generation])
+            + (5 if lhs_lds_size != rhs_lds_size else 0)
+            + abs(CU_COUNT_CLASSES[lhs_cu_count] - CU_COUNT_CLASSES[rhs_cu_count]))
+
+def get_nearest_target_architecture(arch_name: str) -> str:
+    """
+    Returns the tuned architecture whose configs are used for an architecture, as
+    get_target_arch_from_name in config_types.hpp. Ties are broken by the order of TARGET_ARCHITECTURES.
+    """
+    if arch_name in TARGET_ARCHITECTURES:
+        return arch_name
+    return min(TARGET_ARCHITECTURES, key=lambda target: get_architecture_family_distance(arch_name, target))
+
+# Prefix of the measurements of architectures in ARCHITECTURE_FAMILIES but not in TARGET_ARCHITECTURES
+UNTUNED_ARCH_PREFIX = 'untuned::'
 # C++ typename used for optional types
 EMPTY_TYPENAME = "empty_type"
 
+# Input size buckets of the size-bucketed configs (size_bucket in config_types.hpp), as
+# (C++ name, exclusive upper bound of the input size). Larger inputs use the regular config.
+SIZE_BUCKETS = [('size_bucket::small', 1 << 16), ('size_bucket::medium', 1 << 22)]
+LARGE_SIZE_BUCKET = 'size_bucket::large'
+
+def get_size_bucket(size: int) -> str:
+    """
+    Returns the name of the size bucket of an input size, as in get_size_bucket in config_types.hpp.
+    """
+    for bucket, size_limit in SIZE_BUCKETS:
+        if size < size_limit:
+            return bucket
+    return LARGE_SIZE_BUCKET
+
 env = Environment(
     loader=PackageLoader("create_optimization"),
     lstrip_blocks=True,
@@ -301,8 +379,13 @@ class Algorithm:
     Aggregates the data for an algorithm, including the generation of the configuration file.
     """
 
+    # Whether the algorithm supports configs for the size buckets of the input (see SIZE_BUCKETS)
+    size_bucketed = False
+
     def __init__(self, fallback_entries, config_get_best = default_config_get_best):
         self.architectures: Dict[str, BenchmarksOfArchitecture] = {}
+        # Measurements of the small size buckets, by bucket and architecture
+        self.bucket_architectures: Dict[str, Dict[str, BenchmarksOfArchitecture]] = defaultdict(dict)
         self.fallback_entries = fallback_entries
         self.config_get_best = config_get_best
 
@@ -310,26 +393,63 @@ class Algorithm:
         """
         Adds a single benchmark execution for a given architecture
         """
-        if architecture not in self.architectures:
-            self.architectures[architecture] = BenchmarksOfArchitecture(architecture, self.config_selection_params,
-                                                                        self.fallback_entries, self.config_get_best,
-                                                                        self.algorithm_name)
-        self.architectures[architecture].add_measurement(single_benchmark_data)
+        bucket = single_benchmark_data.get('size_bucket', LARGE_SIZE_BUCKET)
+        if self.size_bucketed and bucket != LARGE_SIZE_BUCKET:
+            architectures = self.bucket_architectures[bucket]
+        else:
+            architectures = self.architectures
+        if architecture not in architectures:
+            architectures[architecture] = BenchmarksOfArchitecture(architecture, self.config_selection_params,
+                                                                   self.fallback_entries, self.config_get_best,
+                                                                   self.algorithm_name)
+        architectures[architecture].add_measurement(single_benchmark_data)
+
+    @staticmethod
+    def __add_derived_architectures(architectures: Dict[str, BenchmarksOfArchitecture]):
+        """
+        Uses the measurements of gfx908 for the unknown architecture and, if it was not measured, for gfx90a.
+        The measurements of architectures without target_arch are used for the tuned architecture
+        of the closest family if that was not measured.
+        """
+        if 'target_arch::gfx908' in architectures:
+            architectures['target_arch::unknown'] = copy.deepcopy(architectures['target_arch::gfx908'])
+            architectures['target_arch::unknown'].arch_name = 'target_arch::unknown'
+            if 'target_arch::gfx90a' not in architectures:
+                architectures['target_arch::gfx90a'] = copy.deepcopy(architectures['target_arch::gfx908'])
+                architectures['target_arch::gfx90a'].arch_name = 'target_arch::gfx90a'
+
+        for architecture in sorted(key for key in architectures if key.startswith(UNTUNED_ARCH_PREFIX)):
+            benchmarks = architectures.pop(architecture)
+            arch_name = architecture[len(UNTUNED_ARCH_PREFIX):]
+            target = f'target_arch::{get_nearest_target_architecture(arch_name)}'
+            if target not in architectures:
+                print(f"INFO: using the results of {arch_name} for {target}")
+                benchmarks.arch_name = target
+                architectures[target] = benchmarks
 
     def create_config_file_content(self) -> str:
         """
         Generate the content of the configuration file, including license
         and header guards, based on general template file.
         """
-        if 'target_arch::gfx908' in self.architectures:
-            self.architectures['target_arch::unknown'] = copy.deepcopy(self.architectures['target_arch::gfx908'])
-            self.architectures['target_arch::unknown'].arch_name = 'target_arch::unknown'
-            if 'target_arch::gfx90a' not in self.architectures:
-                self.architectures['target_arch::gfx90a'] = copy.deepcopy(self.architectures['target_arch::gfx908'])
-                self.architectures['target_arch::gfx90a'].arch_name = 'target_arch::gfx90a'
+        # Architectures that were only measured with smaller inputs take their regular config
+        # from the largest bucket that was measured
+        for bucket, _ in reversed(SIZE_BUCKETS):
+            for architecture, benchmarks in self.bucket_architectures.get(bucket, {}).items():
+                if architecture not in self.architectures:
+                    self.architectures[architecture] = benchmarks
+
+        self.__add_derived_architectures(self.architectures)
+        bucket_architectures = []
+        for bucket, _ in SIZE_BUCKETS:
+            if bucket in self.bucket_architectures:
+                self.__add_derived_architectures(self.bucket_architectures[bucket])
+                bucket_architectures.append((bucket, self.bucket_architectures[bucket].values()))
 
         algorithm_template = env.get_template(self.cpp_configuration_template_name)
-        rendered_template = algorithm_template.render(all_architectures=self.architectures.values())
+        rendered_template = algorithm_template.render(all_architectures=self.architectures.values(),
+                                                      size_bucketed=self.size_bucketed,
+                                                      bucket_architectures=bucket_architectures)
 
         return rendered_template
 
@@ -356,6 +476,10 @@ If the type is optional, additional fallback configurations will be generated th
 selection type passed by the user is rocprim::empty_type. The config_selection_params should specify at least 
 one non-optional type. The optional type should not be the first type.
 
+Algorithms with size_bucketed = True also get configs for the small size buckets of SIZE_BUCKETS. The bucket of a
+benchmark run is taken from the 'size' in the context of its file, the regular config is based on the runs with
+large inputs.
+
 The 'name' fields should correspond to a named capturing group in the regex field of the benchmark,
 these names should be valid C++ identifiers. The matched values in the name field of
 the benchmark should also be valid C++ typenames. This is required as these names will be in the 
@@ -378,6 +502,7 @@ class AlgorithmDeviceMergeSortBlockSort(Algorithm):
     config_selection_params = [
         SelectionType(name='key_type', is_optional=False),
         SelectionType(name='value_type', is_optional=True)]
+    size_bucketed = True
     def __init__(self, fallback_entries):
         Algorithm.__init__(self, fallback_entries, block_sort_config_get_best)
 
@@ -387,6 +512,7 @@ class AlgorithmDeviceMergeSortBlockMerge(Algorithm):
     config_selection_params = [
         SelectionType(name='key_type', is_optional=False),
         SelectionType(name='value_type', is_optional=True)]
+    size_bucketed = True
     def __init__(self, fallback_entries):
         Algorithm.__init__(self, fallback_entries, merge_sort_block_merge_config_get_best)
 
@@ -406,6 +532,7 @@ class AlgorithmDeviceRadixSortOnesweep(Algorithm):
     config_selection_params = [
         SelectionType(name='key_type', is_optional=False),
         SelectionType(name='value_type', is_optional=True)]
+    size_bucketed = True
     def __init__(self, fallback_entries):
         Algorithm.__init__(self, fallback_entries)
 
@@ -413,6 +540,7 @@ class AlgorithmDeviceReduce(Algorithm):
     algorithm_name = 'device_reduce'
     config_selection_params = [SelectionType(name='key_type', is_optional=False)]
     cpp_configuration_template_name = "reduce_config_template"
+    size_bucketed = True
     def __init__(self, fallback_entries):
         Algorithm.__init__(self, fallback_entries)
 
@@ -420,6 +548,7 @@ class AlgorithmDeviceScan(Algorithm):
     algorithm_name = 'device_scan'
     cpp_configuration_template_name = "scan_config_template"
     config_selection_params = [SelectionType(name='value_type', is_optional=False)]
+    size_bucketed = True
     def __init__(self, fallback_entries):
         Algorithm.__init__(self, fallback_entries)
 
@@ -485,6 +614,22 @@ class AlgorithmDeviceSegmentedRadixSort(Algorithm):
     def __init__(self, fallback_entries):
         Algorithm.__init__(self, fallback_entries)
 
+class AlgorithmDeviceGather(Algorithm):
+    algorithm_name = 'device_gather'
+    cpp_configuration_template_name = 'gather_config_template'
+    config_selection_params = [
+            SelectionType(name='value_type', is_optional=False)]
+    def __init__(self, fallback_entries):
+        Algorithm.__init__(self, fallback_entries)
+
+class AlgorithmDeviceScatter(Algorithm):
+    algorithm_name = 'device_scatter'
+    cpp_configuration_template_name = 'scatter_config_template'
+    config_selection_params = [
+            SelectionType(name='value_type', is_optional=False)]
+    def __init__(self, fallback_entries):
+        Algorithm.__init__(self, fallback_entries)
+
 def filt_algo_regex(e, algorithm_name):
     if 'algo_regex' in e:
         return re.match(e['algo_regex'], algorithm_name) is not None
@@ -520,6 +665,10 @@ def create_algorithm(algorithm_name: str, fallback_entries):
         return AlgorithmDeviceAdjacentDifferenceInplace(fallback_entries)
     elif algorithm_name == 'device_segmented_radix_sort':
         return AlgorithmDeviceSegmentedRadixSort(fallback_entries)
+    elif algorithm_name == 'device_gather':
+        return AlgorithmDeviceGather(fallback_entries)
+    elif algorithm_name == 'device_scatter':
+        return AlgorithmDeviceScatter(fallback_entries)
     else:
         raise(NotSupportedError(f'Algorithm "{algorithm_name}" is not supported (yet)'))
 
@@ -559,6 +708,10 @@ class BenchmarkDataManager:
         name_from_context = benchmark_run['context']['hdp_gcn_arch_name'].split(":")[0]
         if name_from_context in TARGET_ARCHITECTURES:
             return f'target_arch::{name_from_context}'
+        elif name_from_context in ARCHITECTURE_FAMILIES:
+            # Its configs can only be generated for the closest tuned architecture, until it is added
+            # to target_arch and TARGET_ARCHITECTURES
+            return f'{UNTUNED_ARCH_PREFIX}{name_from_context}'
         else:
             raise RuntimeError(f"ERROR: unknown hdp_gcn_arch_name: {name_from_context}")
 
@@ -600,8 +753,12 @@ class BenchmarkDataManager:
         try:
             print(f'INFO: Processing "{benchmark_run_file_path}"')
             arch = self.__get_target_architecture_from_context(benchmark_run_data)
+            # Runs without a size in the context are considered to be tuned for large inputs
+            size = benchmark_run_data['context'].get('size')
+            size_bucket = get_size_bucket(int(size)) if size is not None else LARGE_SIZE_BUCKET
             for raw_single_benchmark in benchmark_run_data['benchmarks']:
                 single_benchmark = self.__get_single_benchmark(raw_single_benchmark)
+                single_benchmark['size_bucket'] = size_bucket
                 self.__add_benchmark_to_algorithm(single_benchmark, arch)
             print(f'INFO: Successfully processed file "{benchmark_run_file_path}"')
         except NotSupportedError as error:
@@ -0,0 +1,310 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+"""
+This Python script compares two runs of the rocPRIM benchmarks and reports the performance
+changes between them. The runs are the JSON outputs of the benchmark executables, e.g.
+
+    ./benchmark_device_scan --name_format json --benchmark_repetitions 10 \\
+        --benchmark_out baseline.json --benchmark_out_format json
+
+Benchmarks are matched by their bench_naming names. The change of a benchmark is the ratio of the
+medians of its repetitions, with a bootstrap confidence interval. A benchmark regressed if the
+whole confidence interval is worse than the threshold. The script only reads the saved files,
+it does not need a GPU.
+"""
+
+import argparse
+import csv
+import json
+import random
+import re
+import statistics
+import sys
+from dataclasses import dataclass
+from typing import Dict, List, Tuple
+
+# Benchmark times are compared in nanoseconds, and reported in the time unit of the baseline
+TIME_UNITS = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+# Metrics where a lower value is better, all others (bytes_per_second, items_per_second and the
+# user counters such as peak_bandwidth_pct) are better when higher
+TIME_METRICS = ['real_time', 'cpu_time']
+# Context entries that should be the same in both runs for the comparison to be meaningful
+COMPARED_CONTEXT = ['hdp_gcn_arch_name', 'size', 'peak_bandwidth_gbps']
+
+@dataclass
+class Comparison:
+    name: str
+    baseline: List[float]
+    contender: List[float]
+    change: float
+    change_low: float
+    change_high: float
+    status: str
+    # Time unit of the reported medians, empty if the metric is not a time
+    unit: str
+
+def get_benchmark_key(name: str) -> str:
+    """
+    Returns the part of a benchmark name that identifies the benchmark.
+
+    google benchmark may postfix the bench_naming name (e.g. "/manual_time"): only the '{...}'
+    substring is used. Names in the json name_format are normalized, so runs with a different
+    order of the fields still match.
+    """
+    match = re.match(r"{.*}", name)
+    if match is None:
+        return name.split('/')[0]
+    tokenized_name = match.group(0)
+    try:
+        return json.dumps(json.loads(tokenized_name), sort_keys=True, separators=(',', ':'))
+    except json.JSONDecodeError:
+        # The txt name_format is not JSON
+        return tokenized_name
+
+def load_run(path: str, metric: str) -> Tuple[Dict[str, str], Dict[str, List[float]],
+                                              Dict[str, str]]:
+    """
+    Returns the context, the samples and the time units of the benchmarks of a run, one sample
+    per repetition. Times are in nanoseconds, the units are the ones the benchmarks reported.
+
+    If the run only contains aggregates (--benchmark_report_aggregates_only), the median
+    aggregate is the only sample of a benchmark.
+    """
+    with open(path, "r") as file_handle:
+        run = json.load(file_handle)
+
+    repetitions: Dict[str, List[float]] = {}
+    medians: Dict[str, List[float]] = {}
+    units: Dict[str, str] = {}
+    for benchmark in run['benchmarks']:
+        if 'error_occurred' in benchmark and benchmark['error_occurred']:
+            print(f"WARNING: skipping failed benchmark \"{benchmark['name']}\" in \"{path}\"",
+                  file=sys.stderr)
+            continue
+        run_type = benchmark.get('run_type', 'iteration')
+        if run_type != 'iteration' and benchmark.get('aggregate_name') != 'median':
+            continue
+        if metric not in benchmark:
+            raise RuntimeError(f"ERROR: benchmark \"{benchmark['name']}\" in \"{path}\" has no "
+                               f"metric \"{metric}\"")
+        key = get_benchmark_key(benchmark.get('run_name', benchmark['name']))
+        value = float(benchmark[metric])
+        if metric in TIME_METRICS:
+            unit = benchmark.get('time_unit', 'ns')
+            value *= TIME_UNITS[unit]
+            units.setdefault(key, unit)
+
+        if run_type == 'iteration':
+            repetitions.setdefault(key, []).append(value)
+        else:
+            medians.setdefault(key, []).append(value)
+
+    for key, samples in medians.items():
+        repetitions.setdefault(key, samples)
+    return run.get('context', {}), repetitions, units
+
+def get_change_confidence_interval(baseline: List[float],
+                                   contender: List[float],
+                                   confidence: float,
+                                   resamples: int,
+                                   rng: random.Random) -> Tuple[float, float]:
+    """
+    Returns a bootstrap confidence interval of the relative change of the medians.
+
+    The repetitions of both runs are resampled with replacement, the interval contains the
+    central confidence fraction of the changes of the medians of the resamples.
+    """
+    if len(baseline) == 1 and len(contender) == 1:
+        change = contender[0] / baseline[0] - 1
+        return change, change
+
+    changes = []
+    for _ in range(resamples):
+        baseline_median = statistics.median(rng.choices(baseline, k=len(baseline)))
+        contender_median = statistics.median(rng.choices(contender, k=len(contender)))
+        changes.append(contender_median / baseline_median - 1)
+    changes.sort()
+    tail = (1 - confidence) / 2
+    low = changes[int(tail * (resamples - 1))]
+    high = changes[int(round((1 - tail) * (resamples - 1)))]
+    return low, high
+
+def compare(name: str,
+            baseline: List[float],
+            contender: List[float],
+            unit: str,
+            args: argparse.Namespace,
+            rng: random.Random) -> Comparison:
+    """
+    Compares the samples of a benchmark in both runs.
+
+    A change is only reported as a regression or an improvement if its whole confidence interval
+    is beyond the threshold. If only the median is beyond it the result is inconclusive, more
+    repetitions are needed.
+    """
+    change = statistics.median(contender) / statistics.median(baseline) - 1
+    low, high = get_change_confidence_interval(baseline, contender, args.confidence,
+                                               args.resamples, rng)
+
+    # Express the changes so that positive values are worse
+    lower_is_better = args.metric in TIME_METRICS
+    worse_low, worse_high = (low, high) if lower_is_better else (-high, -low)
+    worse_change = change if lower_is_better else -change
+
+    threshold = args.threshold / 100
+    if worse_low > threshold:
+        status = 'regression'
+    elif worse_high < -threshold:
+        status = 'improvement'
+    elif abs(worse_change) > threshold:
+        status = 'inconclusive'
+    else:
+        status = 'unchanged'
+    return Comparison(name, baseline, contender, change, low, high, status, unit)
+
+def check_contexts(baseline: Dict[str, str], contender: Dict[str, str]):
+    """
+    Warns about runs that were made on different devices or with different sizes.
+    """
+    for entry in COMPARED_CONTEXT:
+        if baseline.get(entry) != contender.get(entry):
+            print(f"WARNING: the runs have a different {entry}: \"{baseline.get(entry)}\" and "
+                  f"\"{contender.get(entry)}\"", file=sys.stderr)
+
+def format_percent(value: float) -> str:
+    return f"{value * 100:+.2f}%"
+
+def get_median(comparison: Comparison, samples: List[float]) -> float:
+    """
+    Returns the median of the samples in the reported unit of the comparison.
+    """
+    median = statistics.median(samples)
+    return median / TIME_UNITS[comparison.unit] if comparison.unit else median
+
+def format_median(comparison: Comparison, samples: List[float]) -> str:
+    value = f"{get_median(comparison, samples):.6g}"
+    return f"{value} {comparison.unit}" if comparison.unit else value
+
+def format_count(count: int, status: str) -> str:
+    # 'inconclusive' and 'unchanged' are adjectives, they have no plural
+    if count != 1 and status in ['regression', 'improvement']:
+        status += 's'
+    return f"{count} {status}"
+
+def write_markdown(output, comparisons: List[Comparison], unmatched: Dict[str, List[str]],
+                   args: argparse.Namespace):
+    output.write("# Benchmark comparison\n\n")
+    output.write(f"Baseline: `{args.baseline}`  \n")
+    output.write(f"Contender: `{args.contender}`  \n")
+    output.write(f"Metric: `{args.metric}`, threshold: {args.threshold}%, "
+                 f"confidence: {args.confidence * 100:g}%\n\n")
+
+    counts = {}
+    for comparison in comparisons:
+        counts[comparison.status] = counts.get(comparison.status, 0) + 1
+    output.write(", ".join(format_count(counts.get(status, 0), status) for status in
+                           ['regression', 'improvement', 'inconclusive', 'unchanged']))
+    output.write("\n\n")
+
+    output.write("| Benchmark | Baseline | Contender | Change | Confidence interval | Status |\n")
+    output.write("|---|---:|---:|---:|---|---|\n")
+    for comparison in comparisons:
+        output.write(f"| `{comparison.name}` "
+                     f"| {format_median(comparison, comparison.baseline)} "
+                     f"| {format_median(comparison, comparison.contender)} "
+                     f"| {format_percent(comparison.change)} "
+                     f"| [{format_percent(comparison.change_low)}, "
+                     f"{format_percent(comparison.change_high)}] "
+                     f"| {comparison.status} |\n")
+
+    for run, names in unmatched.items():
+        if names:
+            output.write(f"\nOnly in the {run} run:\n\n")
+            for name in names:
+                output.write(f"* `{name}`\n")
+
+def write_csv(output, comparisons: List[Comparison], unmatched: Dict[str, List[str]]):
+    writer = csv.writer(output)
+    writer.writerow(['name', 'baseline_median', 'contender_median', 'unit',
+                     'baseline_repetitions', 'contender_repetitions', 'change', 'change_low',
+                     'change_high', 'status'])
+    for comparison in comparisons:
+        writer.writerow([comparison.name,
+                         get_median(comparison, comparison.baseline),
+                         get_median(comparison, comparison.contender),
+                         comparison.unit,
+                         len(comparison.baseline),
+                         len(comparison.contender),
+                         comparison.change,
+                         comparison.change_low,
+                         comparison.change_high,
+                         comparison.status])
+    for run, names in unmatched.items():
+        for name in names:
+            writer.writerow([name, '', '', '', '', '', '', '', '', f'only_in_{run}'])
+
+def main():
+    parser = argparse.ArgumentParser(description="Tool for comparing two runs of the rocPRIM benchmarks and detecting performance regressions")
+    parser.add_argument("baseline", type=str, help="Benchmark results of the baseline, in the form <path_to_benchmark>.json")
+    parser.add_argument("contender", type=str, help="Benchmark results to compare with the baseline, in the form <path_to_benchmark>.json")
+    parser.add_argument("-m", "--metric", type=str, default="real_time", help="Compared value of the benchmarks: real_time (the manual time of the device benchmarks), cpu_time, bytes_per_second, items_per_second or a user counter")
+    parser.add_argument("-t", "--threshold", type=float, default=5.0, help="Changes in percent that are smaller than the threshold are ignored")
+    parser.add_argument("-c", "--confidence", type=float, default=0.95, help="Confidence level of the intervals of the changes")
+    parser.add_argument("-r", "--resamples", type=int, default=2000, help="Number of bootstrap resamples for the confidence intervals")
+    parser.add_argument("-s", "--seed", type=int, default=0, help="Seed of the bootstrap resampling, the reports are reproducible")
+    parser.add_argument("-f", "--format", choices=['markdown', 'csv'], default='markdown', help="Format of the report")
+    parser.add_argument("-o", "--output", type=str, help="Report file, the report is printed if not set")
+    parser.add_argument("--fail_on_regression", action='store_true', help="Exit with status 1 if a benchmark regressed")
+    args = parser.parse_args()
+
+    if not 0 < args.confidence < 1:
+        parser.error("--confidence must be between 0 and 1")
+
+    baseline_context, baseline_run, baseline_units = load_run(args.baseline, args.metric)
+    contender_context, contender_run, _ = load_run(args.contender, args.metric)
+    check_contexts(baseline_context, contender_context)
+
+    rng = random.Random(args.seed)
+    comparisons = [compare(name, baseline_run[name], contender_run[name],
+                           baseline_units.get(name, ''), args, rng)
+                   for name in baseline_run if name in contender_run]
+    unmatched = {'baseline': [name for name in baseline_run if name not in contender_run],
+                 'contender': [name for name in contender_run if name not in baseline_run]}
+    if not comparisons:
+        raise RuntimeError("ERROR: the runs have no benchmarks in common")
+
+    output = open(args.output, "w", newline='') if args.output else sys.stdout
+    try:
+        if args.format == 'csv':
+            write_csv(output, comparisons, unmatched)
+        else:
+            write_markdown(output, comparisons, unmatched, args)
+    finally:
+        if args.output:
+            output.close()
+
+    if args.fail_on_regression and any(c.status == 'regression' for c in comparisons):
+        sys.exit(1)
+
+if __name__ == '__main__':
+    main()
@@ -1,6 +1,6 @@
 // MIT License
 //
-// Copyright (c) 2017-2021 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -60,3 +60,18 @@ struct Floating;
 #define name_suffix Floating
 
 #include "test_block_histogram.hpp"
+
+TEST(RocprimBlockHistogramWeightedTests, Atomic)
+{
+    test_block_histogram_weighted<float, float, rocprim::block_histogram_algorithm::using_atomic>();
+    test_block_histogram_weighted<double, double, rocprim::block_histogram_algorithm::using_atomic>();
+    test_block_histogram_weighted<unsigned long long,
+                                  unsigned int,
+                                  rocprim::block_histogram_algorithm::using_atomic>();
+}
+
+TEST(RocprimBlockHistogramWeightedTests, Sort)
+{
+    test_block_histogram_weighted<double, float, rocprim::block_histogram_algorithm::using_sort>();
+    test_block_histogram_weighted<uint64_t, int, rocprim::block_histogram_algorithm::using_sort>();
+}
@@ -72,6 +72,115 @@ void histogram_kernel(T* device_output, BinType* device_output_bin)
     }
 }
 
+template<unsigned int                       BlockSize,
+         unsigned int                       ItemsPerThread,
+         unsigned int                       BinSize,
+         rocprim::block_histogram_algorithm Algorithm,
+         class T,
+         class Weight,
+         class Counter>
+__global__ __launch_bounds__(BlockSize) void weighted_histogram_kernel(const T*      device_input,
+                                                                       const Weight* device_weights,
+                                                                       Counter* device_output_bin)
+{
+    using block_histogram_type
+        = rocprim::block_histogram<T, BlockSize, ItemsPerThread, BinSize, Algorithm>;
+
+    const unsigned int index = ((blockIdx.x * BlockSize) + threadIdx.x) * ItemsPerThread;
+    __shared__ Counter hist[BinSize];
+    __shared__ typename block_histogram_type::storage_type storage;
+
+    T      input[ItemsPerThread];
+    Weight weights[ItemsPerThread];
+    for(unsigned int j = 0; j < ItemsPerThread; j++)
+    {
+        input[j]   = device_input[index + j];
+        weights[j] = device_weights[index + j];
+    }
+
+    block_histogram_type().histogram(input, weights, hist, storage);
+    rocprim::syncthreads();
+
+    for(unsigned int bin = threadIdx.x; bin < BinSize; bin += BlockSize)
+    {
+        device_output_bin[blockIdx.x * BinSize + bin] = hist[bin];
+    }
+}
+
+template<class Counter, class Weight, rocprim::block_histogram_algorithm Algorithm>
+void test_block_histogram_weighted()
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using T                                    = unsigned int;
+    static constexpr unsigned int block_size       = 256;
+    static constexpr unsigned int items_per_thread = 3;
+    static constexpr unsigned int bins             = 100;
+    static constexpr unsigned int grid_size        = 37;
+    const size_t                  size = size_t(block_size) * items_per_thread * grid_size;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        const std::vector<T> input = test_utils::get_random_data<T>(size, 0, bins - 1, seed_value);
+        // Small integral weights, so the sums are exact for floating point counters
+        const std::vector<int> int_weights
+            = test_utils::get_random_data<int>(size, 0, 10, seed_value + 1);
+        const std::vector<Weight> weights(int_weights.begin(), int_weights.end());
+
+        std::vector<Counter> expected(size_t(bins) * grid_size, 0);
+        for(size_t i = 0; i < size; i++)
+        {
+            const size_t block = i / (block_size * items_per_thread);
+            expected[block * bins + input[i]] += static_cast<Counter>(weights[i]);
+        }
+
+        T*       d_input;
+        Weight*  d_weights;
+        Counter* d_output;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(T)));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_weights, size * sizeof(Weight)));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, expected.size() * sizeof(Counter)));
+        HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+        HIP_CHECK(
+            hipMemcpy(d_weights, weights.data(), size * sizeof(Weight), hipMemcpyHostToDevice));
+
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(weighted_histogram_kernel<block_size,
+                                                      items_per_thread,
+                                                      bins,
+                                                      Algorithm,
+                                                      T,
+                                                      Weight,
+                                                      Counter>),
+            dim3(grid_size),
+            dim3(block_size),
+            0,
+            0,
+            d_input,
+            d_weights,
+            d_output);
+        HIP_CHECK(hipGetLastError());
+
+        std::vector<Counter> output(expected.size());
+        HIP_CHECK(hipMemcpy(output.data(),
+                            d_output,
+                            output.size() * sizeof(Counter),
+                            hipMemcpyDeviceToHost));
+
+        test_utils::assert_eq(output, expected);
+
+        HIP_CHECK(hipFree(d_input));
+        HIP_CHECK(hipFree(d_weights));
+        HIP_CHECK(hipFree(d_output));
+    }
+}
+
 // Test for histogram
 template<
     class T,
@@ -1,9 +1,12 @@
 #include "../common_test_header.hpp"
 
 #include <rocprim/device/config_types.hpp>
+#include <rocprim/device/device_reduce_config.hpp>
 
 #include <hip/hip_runtime.h>
 
+#include <string>
+
 using rocprim::detail::target_arch;
 
 __global__ void write_target_arch(target_arch* dest_arch)
@@ -79,6 +82,109 @@ TEST(RocprimConfigDispatchTests, ParseCommonArches)
     ASSERT_EQ(parse_gcn_arch("gfx90a:sramecc+:xnack-"), target_arch::gfx90a);
 }
 
+TEST(RocprimConfigDispatchTests, NearestFamilyArches)
+{
+    using rocprim::detail::get_target_arch_from_name;
+    using rocprim::detail::parse_gcn_arch;
+    using rocprim::detail::target_arch;
+
+    // Tuned architectures map to themselves
+    static_assert(get_target_arch_from_name("gfx803", 6) == target_arch::gfx803, "");
+    static_assert(get_target_arch_from_name("gfx900", 6) == target_arch::gfx900, "");
+    static_assert(get_target_arch_from_name("gfx906", 6) == target_arch::gfx906, "");
+    static_assert(get_target_arch_from_name("gfx908", 6) == target_arch::gfx908, "");
+    static_assert(get_target_arch_from_name("gfx90a", 6) == target_arch::gfx90a, "");
+    static_assert(get_target_arch_from_name("gfx1030", 7) == target_arch::gfx1030, "");
+    static_assert(get_target_arch_from_name("gfx1102", 7) == target_arch::gfx1102, "");
+
+    // Known architectures without tuned configs map to the closest family
+    static_assert(get_target_arch_from_name("gfx904", 6) == target_arch::gfx906, "");
+    static_assert(get_target_arch_from_name("gfx90c", 6) == target_arch::gfx906, "");
+    static_assert(get_target_arch_from_name("gfx940", 6) == target_arch::gfx90a, "");
+    static_assert(get_target_arch_from_name("gfx941", 6) == target_arch::gfx90a, "");
+    static_assert(get_target_arch_from_name("gfx942", 6) == target_arch::gfx90a, "");
+    static_assert(get_target_arch_from_name("gfx950", 6) == target_arch::gfx90a, "");
+    static_assert(get_target_arch_from_name("gfx1010", 7) == target_arch::gfx1030, "");
+    static_assert(get_target_arch_from_name("gfx1032", 7) == target_arch::gfx1030, "");
+    static_assert(get_target_arch_from_name("gfx1100", 7) == target_arch::gfx1102, "");
+    static_assert(get_target_arch_from_name("gfx1101", 7) == target_arch::gfx1102, "");
+    static_assert(get_target_arch_from_name("gfx1151", 7) == target_arch::gfx1102, "");
+    static_assert(get_target_arch_from_name("gfx1201", 7) == target_arch::gfx1102, "");
+
+    // Architectures with unknown families stay unknown
+    static_assert(get_target_arch_from_name("gfx000", 6) == target_arch::unknown, "");
+    static_assert(get_target_arch_from_name("gfx94", 5) == target_arch::unknown, "");
+    static_assert(get_target_arch_from_name("gfx9420", 7) == target_arch::unknown, "");
+
+    ASSERT_EQ(parse_gcn_arch("gfx942:sramecc+:xnack-"), target_arch::gfx90a);
+    ASSERT_EQ(parse_gcn_arch("gfx1100"), target_arch::gfx1102);
+}
+
+TEST(RocprimConfigDispatchTests, SizeBuckets)
+{
+    using rocprim::detail::get_size_bucket;
+    using rocprim::detail::size_bucket;
+
+    static_assert(get_size_bucket(0) == size_bucket::small, "");
+    ASSERT_EQ(get_size_bucket((1 << 16) - 1), size_bucket::small);
+    ASSERT_EQ(get_size_bucket(1 << 16), size_bucket::medium);
+    ASSERT_EQ(get_size_bucket((1 << 22) - 1), size_bucket::medium);
+    ASSERT_EQ(get_size_bucket(1 << 22), size_bucket::large);
+    ASSERT_EQ(get_size_bucket(size_t{1} << 40), size_bucket::large);
+}
+
+template<class Config>
+struct config_name;
+
+template<>
+struct config_name<rocprim::default_config>
+{
+    static constexpr const char* value = "default";
+};
+
+template<rocprim::detail::size_bucket Bucket>
+struct config_name<rocprim::detail::default_bucket_config<Bucket>>
+{
+    static constexpr const char* value
+        = Bucket == rocprim::detail::size_bucket::small ? "small" : "medium";
+};
+
+template<>
+struct config_name<rocprim::reduce_config<256, 4>>
+{
+    static constexpr const char* value = "custom";
+};
+
+template<class Config, bool Bucketed>
+std::string dispatched_config_name(const size_t size)
+{
+    return rocprim::detail::dispatch_size_bucket<Config, Bucketed>(
+        size,
+        [](auto config_identity)
+        {
+            using config = typename decltype(config_identity)::type;
+            return std::string(config_name<config>::value);
+        });
+}
+
+TEST(RocprimConfigDispatchTests, DispatchSizeBucket)
+{
+    using rocprim::default_config;
+    using custom_config = rocprim::reduce_config<256, 4>;
+
+    ASSERT_EQ((dispatched_config_name<default_config, true>(1000)), "small");
+    ASSERT_EQ((dispatched_config_name<default_config, true>(100000)), "medium");
+    ASSERT_EQ((dispatched_config_name<default_config, true>(10000000)), "default");
+
+    // Without tuned buckets the default config is used for every size
+    ASSERT_EQ((dispatched_config_name<default_config, false>(1000)), "default");
+    ASSERT_EQ((dispatched_config_name<default_config, false>(100000)), "default");
+
+    // User configs are never replaced
+    ASSERT_EQ((dispatched_config_name<custom_config, true>(1000)), "custom");
+    ASSERT_EQ((dispatched_config_name<custom_config, true>(10000000)), "custom");
+}
+
 #ifndef _WIN32
 TEST(RocprimConfigDispatchTests, DeviceIdFromStream)
 {
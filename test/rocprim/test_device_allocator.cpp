@@ -0,0 +1,347 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_allocator.hpp>
+#include <rocprim/device/device_reduce.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <vector>
+
+// Backend of caching_device_allocator that hands out fake addresses, so the caching can be
+// tested without a device. The stream (cast to an integer) selects the device.
+struct mock_allocator_backend
+{
+    struct stats_type
+    {
+        std::map<void*, size_t> live;
+        size_t                  allocations   = 0;
+        size_t                  deallocations = 0;
+        size_t                  fail_next     = 0;
+    };
+
+    stats_type* stats;
+
+    hipError_t get_device(const hipStream_t stream, int& device)
+    {
+        device = static_cast<int>(reinterpret_cast<std::uintptr_t>(stream) % 2);
+        return hipSuccess;
+    }
+
+    hipError_t allocate(const int /*device*/, void** ptr, const size_t bytes)
+    {
+        if(stats->fail_next > 0)
+        {
+            --stats->fail_next;
+            return hipErrorOutOfMemory;
+        }
+        // Unique, never dereferenced addresses
+        *ptr = reinterpret_cast<void*>((++stats->allocations) << 32);
+        stats->live.emplace(*ptr, bytes);
+        return hipSuccess;
+    }
+
+    hipError_t deallocate(const int /*device*/, void* ptr)
+    {
+        if(stats->live.erase(ptr) != 1)
+        {
+            return hipErrorInvalidValue;
+        }
+        ++stats->deallocations;
+        return hipSuccess;
+    }
+};
+
+using mock_caching_allocator = rocprim::caching_device_allocator<mock_allocator_backend>;
+
+hipStream_t mock_stream(const std::uintptr_t index)
+{
+    return reinterpret_cast<hipStream_t>(index);
+}
+
+TEST(RocprimCachingDeviceAllocatorTests, ReuseBin)
+{
+    mock_allocator_backend::stats_type stats;
+    mock_caching_allocator             allocator(8, 3, 7, size_t{6} << 20, {&stats});
+    const hipStream_t                  stream = mock_stream(2);
+
+    // 1000 bytes round up to the 4096 byte bin
+    void* first;
+    ASSERT_EQ(allocator.allocate(&first, 1000, stream), hipSuccess);
+    ASSERT_EQ(stats.allocations, 1u);
+    ASSERT_EQ(stats.live[first], 4096u);
+    ASSERT_EQ(allocator.live_blocks(), 1u);
+
+    ASSERT_EQ(allocator.deallocate(first, stream), hipSuccess);
+    ASSERT_EQ(stats.deallocations, 0u);
+    ASSERT_EQ(allocator.cached_bytes(0), 4096u);
+
+    // Any size of the same bin reuses the block
+    void* second;
+    ASSERT_EQ(allocator.allocate(&second, 4000, stream), hipSuccess);
+    ASSERT_EQ(second, first);
+    ASSERT_EQ(stats.allocations, 1u);
+    ASSERT_EQ(allocator.cached_bytes(0), 0u);
+
+    // Small allocations use the smallest bin
+    void* small;
+    ASSERT_EQ(allocator.allocate(&small, 0, stream), hipSuccess);
+    ASSERT_EQ(stats.live[small], 512u);
+
+    ASSERT_EQ(allocator.deallocate(second, stream), hipSuccess);
+    ASSERT_EQ(allocator.deallocate(small, stream), hipSuccess);
+    ASSERT_EQ(allocator.live_blocks(), 0u);
+    ASSERT_EQ(allocator.cached_bytes(0), 4096u + 512u);
+
+    ASSERT_EQ(allocator.release_cached(), hipSuccess);
+    ASSERT_EQ(stats.deallocations, 2u);
+    ASSERT_TRUE(stats.live.empty());
+}
+
+TEST(RocprimCachingDeviceAllocatorTests, SeparateStreamsAndDevices)
+{
+    mock_allocator_backend::stats_type stats;
+    mock_caching_allocator             allocator(8, 3, 7, size_t{6} << 20, {&stats});
+
+    // Streams 2 and 4 are on device 0, stream 3 is on device 1
+    void* ptr;
+    ASSERT_EQ(allocator.allocate(&ptr, 100, mock_stream(2)), hipSuccess);
+    ASSERT_EQ(allocator.deallocate(ptr, mock_stream(2)), hipSuccess);
+
+    void* other_stream;
+    ASSERT_EQ(allocator.allocate(&other_stream, 100, mock_stream(4)), hipSuccess);
+    ASSERT_NE(other_stream, ptr);
+    void* other_device;
+    ASSERT_EQ(allocator.allocate(&other_device, 100, mock_stream(3)), hipSuccess);
+    ASSERT_NE(other_device, ptr);
+    ASSERT_EQ(stats.allocations, 3u);
+
+    // Blocks must be freed for the stream of their allocation
+    ASSERT_EQ(allocator.deallocate(other_stream, mock_stream(2)), hipErrorInvalidValue);
+    ASSERT_EQ(allocator.deallocate(other_stream, mock_stream(4)), hipSuccess);
+    ASSERT_EQ(allocator.deallocate(other_device, mock_stream(3)), hipSuccess);
+    ASSERT_EQ(allocator.cached_bytes(0), 2u * 512u);
+    ASSERT_EQ(allocator.cached_bytes(1), 512u);
+
+    // Unknown and already freed pointers
+    ASSERT_EQ(allocator.deallocate(ptr, mock_stream(2)), hipErrorInvalidValue);
+    ASSERT_EQ(allocator.deallocate(nullptr, mock_stream(2)), hipErrorInvalidValue);
+}
+
+TEST(RocprimCachingDeviceAllocatorTests, CacheLimits)
+{
+    mock_allocator_backend::stats_type stats;
+    // Bins of 512, 4096 and 32768 bytes, at most 8192 cached bytes per device
+    mock_caching_allocator allocator(8, 3, 5, 8192, {&stats});
+    const hipStream_t      stream = mock_stream(2);
+
+    // Larger than the largest bin: allocated exactly, never cached
+    void* large;
+    ASSERT_EQ(allocator.allocate(&large, 40000, stream), hipSuccess);
+    ASSERT_EQ(stats.live[large], 40000u);
+    ASSERT_EQ(allocator.deallocate(large, stream), hipSuccess);
+    ASSERT_EQ(stats.deallocations, 1u);
+    ASSERT_EQ(allocator.cached_bytes(0), 0u);
+
+    // The third block would exceed the cache limit
+    std::vector<void*> blocks(3);
+    for(void*& block : blocks)
+    {
+        ASSERT_EQ(allocator.allocate(&block, 4096, stream), hipSuccess);
+    }
+    for(void* block : blocks)
+    {
+        ASSERT_EQ(allocator.deallocate(block, stream), hipSuccess);
+    }
+    ASSERT_EQ(allocator.cached_bytes(0), 8192u);
+    ASSERT_EQ(stats.deallocations, 2u);
+}
+
+TEST(RocprimCachingDeviceAllocatorTests, ReleaseCachedOnFailure)
+{
+    mock_allocator_backend::stats_type stats;
+    mock_caching_allocator             allocator(8, 3, 7, size_t{6} << 20, {&stats});
+    const hipStream_t                  stream = mock_stream(2);
+
+    void* cached;
+    ASSERT_EQ(allocator.allocate(&cached, 100, stream), hipSuccess);
+    ASSERT_EQ(allocator.deallocate(cached, stream), hipSuccess);
+
+    // A failed allocation frees the cached blocks of the device and is retried once
+    stats.fail_next = 1;
+    void* ptr;
+    ASSERT_EQ(allocator.allocate(&ptr, 10000, stream), hipSuccess);
+    ASSERT_EQ(allocator.cached_bytes(0), 0u);
+    ASSERT_EQ(stats.live.count(cached), 0);
+
+    stats.fail_next = 2;
+    void* failed;
+    ASSERT_EQ(allocator.allocate(&failed, 10000, stream), hipErrorOutOfMemory);
+    ASSERT_EQ(allocator.live_blocks(), 1u);
+
+    ASSERT_EQ(allocator.deallocate(ptr, stream), hipSuccess);
+}
+
+TEST(RocprimCachingDeviceAllocatorTests, WithTemporaryStorage)
+{
+    mock_allocator_backend::stats_type stats;
+    mock_caching_allocator             allocator(8, 3, 7, size_t{6} << 20, {&stats});
+    const hipStream_t                  stream = mock_stream(2);
+
+    // The storage is queried, allocated, used and returned to the cache
+    std::vector<void*> calls;
+    for(int i = 0; i < 2; i++)
+    {
+        ASSERT_EQ(rocprim::with_temporary_storage(allocator,
+                                                  stream,
+                                                  [&](void* storage, size_t& storage_size)
+                                                  {
+                                                      calls.push_back(storage);
+                                                      if(storage == nullptr)
+                                                      {
+                                                          storage_size = 3000;
+                                                      }
+                                                      return hipSuccess;
+                                                  }),
+                  hipSuccess);
+    }
+    ASSERT_EQ(calls.size(), 4u);
+    ASSERT_EQ(calls[0], nullptr);
+    ASSERT_NE(calls[1], nullptr);
+    ASSERT_EQ(calls[2], nullptr);
+    ASSERT_EQ(calls[3], calls[1]);
+    ASSERT_EQ(stats.allocations, 1u);
+    ASSERT_EQ(allocator.live_blocks(), 0u);
+
+    // Errors of the algorithm are returned, the storage is still deallocated
+    ASSERT_EQ(rocprim::with_temporary_storage(allocator,
+                                              stream,
+                                              [&](void* storage, size_t& storage_size)
+                                              {
+                                                  storage_size = 3000;
+                                                  return storage == nullptr ? hipSuccess
+                                                                            : hipErrorLaunchFailure;
+                                              }),
+              hipErrorLaunchFailure);
+    ASSERT_EQ(allocator.live_blocks(), 0u);
+}
+
+template<class Allocator>
+void test_reduce_with_allocator(Allocator& allocator, const hipStream_t stream)
+{
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(auto size : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            const std::vector<int> input
+                = test_utils::get_random_data<int>(size, 0, 100, seed_value);
+            const int expected = std::accumulate(input.begin(), input.end(), 0);
+
+            int* d_input;
+            int* d_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input,
+                                                         std::max<size_t>(size, 1) * sizeof(int)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, sizeof(int)));
+            HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(int), hipMemcpyHostToDevice));
+
+            HIP_CHECK(rocprim::with_temporary_storage(
+                allocator,
+                stream,
+                [&](void* temporary_storage, size_t& storage_size)
+                {
+                    return rocprim::reduce(temporary_storage,
+                                           storage_size,
+                                           d_input,
+                                           d_output,
+                                           0,
+                                           size,
+                                           rocprim::plus<int>(),
+                                           stream);
+                }));
+            HIP_CHECK(hipGetLastError());
+
+            int output;
+            HIP_CHECK(
+                hipMemcpyAsync(&output, d_output, sizeof(int), hipMemcpyDeviceToHost, stream));
+            HIP_CHECK(hipStreamSynchronize(stream));
+            ASSERT_EQ(output, expected);
+
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_output));
+        }
+    }
+}
+
+TEST(RocprimDeviceAllocatorTests, CachingDeviceAllocatorReduce)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    hipStream_t stream;
+    HIP_CHECK(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+
+    rocprim::caching_device_allocator<> allocator;
+    test_reduce_with_allocator(allocator, stream);
+    ASSERT_EQ(allocator.live_blocks(), 0u);
+    HIP_CHECK(allocator.release_cached());
+
+    HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST(RocprimDeviceAllocatorTests, MemPoolAllocatorReduce)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    int pools_supported = 0;
+    HIP_CHECK(
+        hipDeviceGetAttribute(&pools_supported, hipDeviceAttributeMemoryPoolsSupported, device_id));
+    if(!pools_supported)
+    {
+        GTEST_SKIP() << "Memory pools are not supported by the device";
+    }
+
+    hipStream_t stream;
+    HIP_CHECK(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+
+    hipMemPool_t pool;
+    HIP_CHECK(hipDeviceGetDefaultMemPool(&pool, device_id));
+    rocprim::mem_pool_allocator allocator(pool);
+    test_reduce_with_allocator(allocator, stream);
+
+    HIP_CHECK(hipStreamDestroy(stream));
+}
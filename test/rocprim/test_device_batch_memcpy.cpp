@@ -24,6 +24,7 @@
 #include "test_utils_assertions.hpp"
 #include "test_utils_custom_test_types.hpp"
 #include "test_utils_data_generation.hpp"
+#include "test_utils_hipgraphs.hpp"
 #include "test_utils_types.hpp"
 
 #include "rocprim/detail/various.hpp"
@@ -500,3 +501,497 @@ TYPED_TEST(DeviceBatchMemcpyTests, SizeAndTypeVariation)
     HIP_CHECK(hipFree(d_output));
     HIP_CHECK(hipFree(d_input));
 }
+
+// Buffer sizes in bytes covering all size classes of the default config.
+template<class SizeType>
+std::vector<SizeType> generate_size_class_sizes(size_t num_buffers, std::mt19937_64& rng)
+{
+    constexpr SizeType wlev_min_size = rocprim::batch_memcpy_config<>::wlev_size_threshold;
+    constexpr SizeType blev_min_size = rocprim::batch_memcpy_config<>::blev_size_threshold;
+
+    std::vector<SizeType> sizes(num_buffers);
+    auto                  iter = sizes.begin();
+    iter = test_utils::generate_random_data_n(iter, num_buffers / 2, 0, wlev_min_size - 1, rng);
+    iter = test_utils::generate_random_data_n(iter,
+                                              num_buffers / 4,
+                                              wlev_min_size,
+                                              blev_min_size - 1,
+                                              rng);
+    iter = test_utils::generate_random_data_n(iter,
+                                              num_buffers - num_buffers / 2 - num_buffers / 4,
+                                              blev_min_size,
+                                              16 * blev_min_size,
+                                              rng);
+    std::shuffle(sizes.begin(), sizes.end(), rng);
+    return sizes;
+}
+
+TEST(DeviceBatchMemcpyTests, BatchMemset)
+{
+    constexpr size_t num_buffers = 3000;
+
+    std::mt19937_64 rng{0};
+
+    const std::vector<uint32_t> h_sizes = generate_size_class_sizes<uint32_t>(num_buffers, rng);
+    const std::vector<uint8_t>  h_values
+        = test_utils::get_random_data<uint8_t>(num_buffers, 0, 255, rng());
+
+    // Unaligned offsets and gaps between the buffers that must stay untouched
+    std::vector<size_t> h_offsets(num_buffers);
+    size_t              total_size = 3;
+    for(size_t i = 0; i < num_buffers; ++i)
+    {
+        h_offsets[i] = total_size;
+        total_size += h_sizes[i] + i % 5;
+    }
+
+    uint8_t*  d_output;
+    void**    d_destinations;
+    uint8_t*  d_values;
+    uint32_t* d_sizes;
+    HIP_CHECK(hipMalloc(&d_output, total_size));
+    HIP_CHECK(hipMalloc(&d_destinations, num_buffers * sizeof(void*)));
+    HIP_CHECK(hipMalloc(&d_values, num_buffers * sizeof(uint8_t)));
+    HIP_CHECK(hipMalloc(&d_sizes, num_buffers * sizeof(uint32_t)));
+
+    std::vector<void*> h_destinations(num_buffers);
+    for(size_t i = 0; i < num_buffers; ++i)
+    {
+        h_destinations[i] = d_output + h_offsets[i];
+    }
+
+    HIP_CHECK(hipMemset(d_output, 0xA5, total_size));
+    HIP_CHECK(hipMemcpy(d_destinations,
+                        h_destinations.data(),
+                        num_buffers * sizeof(void*),
+                        hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_values, h_values.data(), num_buffers, hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_sizes,
+                        h_sizes.data(),
+                        num_buffers * sizeof(uint32_t),
+                        hipMemcpyHostToDevice));
+
+    size_t temp_storage_bytes = 0;
+    HIP_CHECK(rocprim::batch_memset(nullptr,
+                                    temp_storage_bytes,
+                                    d_destinations,
+                                    d_values,
+                                    d_sizes,
+                                    num_buffers));
+    void* d_temp_storage;
+    HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_bytes));
+    HIP_CHECK(rocprim::batch_memset(d_temp_storage,
+                                    temp_storage_bytes,
+                                    d_destinations,
+                                    d_values,
+                                    d_sizes,
+                                    num_buffers));
+
+    std::vector<uint8_t> expected(total_size, 0xA5);
+    for(size_t i = 0; i < num_buffers; ++i)
+    {
+        std::fill_n(expected.begin() + h_offsets[i], h_sizes[i], h_values[i]);
+    }
+
+    std::vector<uint8_t> h_output(total_size);
+    HIP_CHECK(hipMemcpy(h_output.data(), d_output, total_size, hipMemcpyDeviceToHost));
+    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(h_output, expected));
+
+    HIP_CHECK(hipFree(d_temp_storage));
+    HIP_CHECK(hipFree(d_sizes));
+    HIP_CHECK(hipFree(d_values));
+    HIP_CHECK(hipFree(d_destinations));
+    HIP_CHECK(hipFree(d_output));
+}
+
+TEST(DeviceBatchMemcpyTests, BatchFill)
+{
+    using value_type             = uint64_t;
+    constexpr size_t num_buffers = 3000;
+
+    std::mt19937_64 rng{0};
+
+    // Sizes in items instead of bytes
+    std::vector<uint32_t> h_sizes = generate_size_class_sizes<uint32_t>(num_buffers, rng);
+    for(auto& size : h_sizes)
+    {
+        size = rocprim::detail::ceiling_div(size, sizeof(value_type));
+    }
+    const std::vector<value_type> h_values
+        = test_utils::get_random_data<value_type>(num_buffers, 0, 1 << 30, rng());
+
+    std::vector<size_t> h_offsets(num_buffers);
+    size_t              total_size = 0;
+    for(size_t i = 0; i < num_buffers; ++i)
+    {
+        h_offsets[i] = total_size;
+        total_size += h_sizes[i] + i % 3;
+    }
+
+    value_type*  d_output;
+    value_type** d_destinations;
+    value_type*  d_values;
+    uint32_t*    d_sizes;
+    HIP_CHECK(hipMalloc(&d_output, total_size * sizeof(value_type)));
+    HIP_CHECK(hipMalloc(&d_destinations, num_buffers * sizeof(value_type*)));
+    HIP_CHECK(hipMalloc(&d_values, num_buffers * sizeof(value_type)));
+    HIP_CHECK(hipMalloc(&d_sizes, num_buffers * sizeof(uint32_t)));
+
+    std::vector<value_type*> h_destinations(num_buffers);
+    for(size_t i = 0; i < num_buffers; ++i)
+    {
+        h_destinations[i] = d_output + h_offsets[i];
+    }
+
+    HIP_CHECK(hipMemset(d_output, 0, total_size * sizeof(value_type)));
+    HIP_CHECK(hipMemcpy(d_destinations,
+                        h_destinations.data(),
+                        num_buffers * sizeof(value_type*),
+                        hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_values,
+                        h_values.data(),
+                        num_buffers * sizeof(value_type),
+                        hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_sizes,
+                        h_sizes.data(),
+                        num_buffers * sizeof(uint32_t),
+                        hipMemcpyHostToDevice));
+
+    size_t temp_storage_bytes = 0;
+    HIP_CHECK(rocprim::batch_fill(nullptr,
+                                  temp_storage_bytes,
+                                  d_destinations,
+                                  d_values,
+                                  d_sizes,
+                                  num_buffers));
+    void* d_temp_storage;
+    HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_bytes));
+    HIP_CHECK(rocprim::batch_fill(d_temp_storage,
+                                  temp_storage_bytes,
+                                  d_destinations,
+                                  d_values,
+                                  d_sizes,
+                                  num_buffers));
+
+    std::vector<value_type> expected(total_size, 0);
+    for(size_t i = 0; i < num_buffers; ++i)
+    {
+        std::fill_n(expected.begin() + h_offsets[i], h_sizes[i], h_values[i]);
+    }
+
+    std::vector<value_type> h_output(total_size);
+    HIP_CHECK(hipMemcpy(h_output.data(),
+                        d_output,
+                        total_size * sizeof(value_type),
+                        hipMemcpyDeviceToHost));
+    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(h_output, expected));
+
+    HIP_CHECK(hipFree(d_temp_storage));
+    HIP_CHECK(hipFree(d_sizes));
+    HIP_CHECK(hipFree(d_values));
+    HIP_CHECK(hipFree(d_destinations));
+    HIP_CHECK(hipFree(d_output));
+}
+
+// Extracts tiles of random sizes from an image into a pitched output with batch_memcpy_2d,
+// then overwrites the same tiles with batch_memset_2d.
+TEST(DeviceBatchMemcpyTests, BatchMemcpy2D)
+{
+    constexpr size_t num_tiles    = 2000;
+    constexpr size_t image_width  = 4099;
+    constexpr size_t image_height = 4096;
+
+    std::mt19937_64 rng{0};
+
+    std::vector<uint8_t> h_image
+        = test_utils::get_random_data<uint8_t>(image_width * image_height, 0, 255, rng());
+
+    // Tiles from one byte to whole rows and from one row to many rows
+    std::vector<size_t>   h_widths(num_tiles);
+    std::vector<uint32_t> h_heights(num_tiles);
+    std::vector<size_t>   h_src_offsets(num_tiles);
+    std::vector<size_t>   h_dst_offsets(num_tiles);
+    std::uniform_int_distribution<size_t> width_dist(0, 200);
+    std::uniform_int_distribution<size_t> height_dist(1, 40);
+    for(size_t i = 0; i < num_tiles; ++i)
+    {
+        h_widths[i]  = i % 100 == 0 ? image_width : width_dist(rng);
+        h_heights[i] = static_cast<uint32_t>(i % 7 == 0 ? 1 : height_dist(rng));
+        const size_t x = std::uniform_int_distribution<size_t>(0, image_width - h_widths[i])(rng);
+        const size_t y = std::uniform_int_distribution<size_t>(0, image_height - h_heights[i])(rng);
+        h_src_offsets[i] = y * image_width + x;
+    }
+
+    // Tiles are packed into the output with a pitch larger than their width
+    const size_t        output_pitch = image_width + 13;
+    std::vector<size_t> h_dst_pitches(num_tiles, output_pitch);
+    size_t              output_rows = 0;
+    for(size_t i = 0; i < num_tiles; ++i)
+    {
+        h_dst_offsets[i] = output_rows * output_pitch + i % 11;
+        output_rows += h_heights[i];
+    }
+    const size_t output_size = output_rows * output_pitch + 16;
+
+    uint8_t*  d_image;
+    uint8_t*  d_output;
+    void**    d_sources;
+    size_t*   d_src_pitches;
+    void**    d_destinations;
+    size_t*   d_dst_pitches;
+    size_t*   d_widths;
+    uint32_t* d_heights;
+    HIP_CHECK(hipMalloc(&d_image, h_image.size()));
+    HIP_CHECK(hipMalloc(&d_output, output_size));
+    HIP_CHECK(hipMalloc(&d_sources, num_tiles * sizeof(void*)));
+    HIP_CHECK(hipMalloc(&d_src_pitches, num_tiles * sizeof(size_t)));
+    HIP_CHECK(hipMalloc(&d_destinations, num_tiles * sizeof(void*)));
+    HIP_CHECK(hipMalloc(&d_dst_pitches, num_tiles * sizeof(size_t)));
+    HIP_CHECK(hipMalloc(&d_widths, num_tiles * sizeof(size_t)));
+    HIP_CHECK(hipMalloc(&d_heights, num_tiles * sizeof(uint32_t)));
+
+    std::vector<void*>  h_sources(num_tiles);
+    std::vector<void*>  h_destinations(num_tiles);
+    std::vector<size_t> h_src_pitches(num_tiles, image_width);
+    for(size_t i = 0; i < num_tiles; ++i)
+    {
+        h_sources[i]      = d_image + h_src_offsets[i];
+        h_destinations[i] = d_output + h_dst_offsets[i];
+    }
+
+    HIP_CHECK(hipMemcpy(d_image, h_image.data(), h_image.size(), hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemset(d_output, 0, output_size));
+    HIP_CHECK(hipMemcpy(d_sources,
+                        h_sources.data(),
+                        num_tiles * sizeof(void*),
+                        hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_src_pitches,
+                        h_src_pitches.data(),
+                        num_tiles * sizeof(size_t),
+                        hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_destinations,
+                        h_destinations.data(),
+                        num_tiles * sizeof(void*),
+                        hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_dst_pitches,
+                        h_dst_pitches.data(),
+                        num_tiles * sizeof(size_t),
+                        hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_widths,
+                        h_widths.data(),
+                        num_tiles * sizeof(size_t),
+                        hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_heights,
+                        h_heights.data(),
+                        num_tiles * sizeof(uint32_t),
+                        hipMemcpyHostToDevice));
+
+    size_t temp_storage_bytes = 0;
+    HIP_CHECK(rocprim::batch_memcpy_2d(nullptr,
+                                       temp_storage_bytes,
+                                       d_sources,
+                                       d_src_pitches,
+                                       d_destinations,
+                                       d_dst_pitches,
+                                       d_widths,
+                                       d_heights,
+                                       num_tiles));
+    void* d_temp_storage;
+    HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_bytes));
+    HIP_CHECK(rocprim::batch_memcpy_2d(d_temp_storage,
+                                       temp_storage_bytes,
+                                       d_sources,
+                                       d_src_pitches,
+                                       d_destinations,
+                                       d_dst_pitches,
+                                       d_widths,
+                                       d_heights,
+                                       num_tiles));
+
+    std::vector<uint8_t> expected(output_size, 0);
+    for(size_t i = 0; i < num_tiles; ++i)
+    {
+        for(size_t row = 0; row < h_heights[i]; ++row)
+        {
+            std::copy_n(h_image.begin() + h_src_offsets[i] + row * image_width,
+                        h_widths[i],
+                        expected.begin() + h_dst_offsets[i] + row * output_pitch);
+        }
+    }
+
+    std::vector<uint8_t> h_output(output_size);
+    HIP_CHECK(hipMemcpy(h_output.data(), d_output, output_size, hipMemcpyDeviceToHost));
+    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(h_output, expected));
+
+    // Clear the tiles of the output again, using the tile index as value
+    std::vector<uint8_t> h_values(num_tiles);
+    for(size_t i = 0; i < num_tiles; ++i)
+    {
+        h_values[i] = static_cast<uint8_t>(i);
+    }
+    uint8_t* d_values;
+    HIP_CHECK(hipMalloc(&d_values, num_tiles * sizeof(uint8_t)));
+    HIP_CHECK(hipMemcpy(d_values, h_values.data(), num_tiles, hipMemcpyHostToDevice));
+
+    size_t memset_temp_storage_bytes = 0;
+    HIP_CHECK(rocprim::batch_memset_2d(nullptr,
+                                       memset_temp_storage_bytes,
+                                       d_destinations,
+                                       d_dst_pitches,
+                                       d_values,
+                                       d_widths,
+                                       d_heights,
+                                       num_tiles));
+    ASSERT_LE(memset_temp_storage_bytes, temp_storage_bytes);
+    HIP_CHECK(rocprim::batch_memset_2d(d_temp_storage,
+                                       memset_temp_storage_bytes,
+                                       d_destinations,
+                                       d_dst_pitches,
+                                       d_values,
+                                       d_widths,
+                                       d_heights,
+                                       num_tiles));
+
+    for(size_t i = 0; i < num_tiles; ++i)
+    {
+        for(size_t row = 0; row < h_heights[i]; ++row)
+        {
+            std::fill_n(expected.begin() + h_dst_offsets[i] + row * output_pitch,
+                        h_widths[i],
+                        h_values[i]);
+        }
+    }
+
+    HIP_CHECK(hipMemcpy(h_output.data(), d_output, output_size, hipMemcpyDeviceToHost));
+    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(h_output, expected));
+
+    HIP_CHECK(hipFree(d_values));
+    HIP_CHECK(hipFree(d_temp_storage));
+    HIP_CHECK(hipFree(d_heights));
+    HIP_CHECK(hipFree(d_widths));
+    HIP_CHECK(hipFree(d_dst_pitches));
+    HIP_CHECK(hipFree(d_destinations));
+    HIP_CHECK(hipFree(d_src_pitches));
+    HIP_CHECK(hipFree(d_sources));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_image));
+}
+
+// batch_memcpy must not synchronize with the host, so it can be captured in a graph. The graph
+// is launched twice with different input data, the second launch must copy the new data.
+TEST(DeviceBatchMemcpyTests, GraphCapture)
+{
+    constexpr size_t num_buffers = 3000;
+
+    std::mt19937_64 rng{0};
+
+    const std::vector<uint32_t> h_sizes = generate_size_class_sizes<uint32_t>(num_buffers, rng);
+
+    std::vector<size_t> h_offsets(num_buffers);
+    size_t              total_size = 0;
+    for(size_t i = 0; i < num_buffers; ++i)
+    {
+        h_offsets[i] = total_size;
+        total_size += h_sizes[i];
+    }
+
+    uint8_t*  d_input;
+    uint8_t*  d_output;
+    void**    d_sources;
+    void**    d_destinations;
+    uint32_t* d_sizes;
+    HIP_CHECK(hipMalloc(&d_input, total_size));
+    HIP_CHECK(hipMalloc(&d_output, total_size));
+    HIP_CHECK(hipMalloc(&d_sources, num_buffers * sizeof(void*)));
+    HIP_CHECK(hipMalloc(&d_destinations, num_buffers * sizeof(void*)));
+    HIP_CHECK(hipMalloc(&d_sizes, num_buffers * sizeof(uint32_t)));
+
+    // The buffers are copied in reverse order, so that the output differs from the input
+    std::vector<void*> h_sources(num_buffers);
+    std::vector<void*> h_destinations(num_buffers);
+    for(size_t i = 0; i < num_buffers; ++i)
+    {
+        h_sources[i]      = d_input + h_offsets[i];
+        h_destinations[i] = d_output + (total_size - h_offsets[i] - h_sizes[i]);
+    }
+
+    HIP_CHECK(hipMemcpy(d_sources,
+                        h_sources.data(),
+                        num_buffers * sizeof(void*),
+                        hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_destinations,
+                        h_destinations.data(),
+                        num_buffers * sizeof(void*),
+                        hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_sizes,
+                        h_sizes.data(),
+                        num_buffers * sizeof(uint32_t),
+                        hipMemcpyHostToDevice));
+
+    size_t temp_storage_bytes = 0;
+    HIP_CHECK(rocprim::batch_memcpy(nullptr,
+                                    temp_storage_bytes,
+                                    d_sources,
+                                    d_destinations,
+                                    d_sizes,
+                                    num_buffers));
+    void* d_temp_storage;
+    HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_bytes));
+
+    // Default stream does not support hipGraph stream capture, so create one
+    hipStream_t stream;
+    HIP_CHECK(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+
+    hipGraph_t graph = test_utils::createGraphHelper(stream);
+    HIP_CHECK(rocprim::batch_memcpy(d_temp_storage,
+                                    temp_storage_bytes,
+                                    d_sources,
+                                    d_destinations,
+                                    d_sizes,
+                                    num_buffers,
+                                    stream));
+    hipGraphExec_t graph_instance = test_utils::endCaptureGraphHelper(graph, stream);
+
+    for(size_t launch = 0; launch < 2; ++launch)
+    {
+        SCOPED_TRACE(testing::Message() << "with launch = " << launch);
+
+        const std::vector<uint8_t> h_input
+            = test_utils::get_random_data<uint8_t>(total_size, 0, 255, rng());
+        HIP_CHECK(hipMemcpy(d_input, h_input.data(), total_size, hipMemcpyHostToDevice));
+
+        test_utils::launchGraphHelper(graph_instance, stream, true);
+
+        std::vector<uint8_t> expected(total_size);
+        for(size_t i = 0; i < num_buffers; ++i)
+        {
+            std::copy_n(h_input.begin() + h_offsets[i],
+                        h_sizes[i],
+                        expected.begin() + (total_size - h_offsets[i] - h_sizes[i]));
+        }
+
+        std::vector<uint8_t> h_output(total_size);
+        HIP_CHECK(hipMemcpy(h_output.data(), d_output, total_size, hipMemcpyDeviceToHost));
+        ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(h_output, expected));
+    }
+
+    // An empty batch launches nothing
+    HIP_CHECK(rocprim::batch_memcpy(d_temp_storage,
+                                    temp_storage_bytes,
+                                    d_sources,
+                                    d_destinations,
+                                    d_sizes,
+                                    0,
+                                    stream));
+    HIP_CHECK(hipStreamSynchronize(stream));
+
+    test_utils::cleanupGraphHelper(graph, graph_instance);
+    HIP_CHECK(hipStreamDestroy(stream));
+
+    HIP_CHECK(hipFree(d_temp_storage));
+    HIP_CHECK(hipFree(d_sizes));
+    HIP_CHECK(hipFree(d_destinations));
+    HIP_CHECK(hipFree(d_sources));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_input));
+}
@@ -0,0 +1,403 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "../common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_gather_scatter.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Params for tests
+template<class ValueType,
+         class IndexType     = unsigned int,
+         class GatherConfig  = rocprim::default_config,
+         class ScatterConfig = rocprim::default_config>
+struct DeviceGatherScatterParams
+{
+    using value_type     = ValueType;
+    using index_type     = IndexType;
+    using gather_config  = GatherConfig;
+    using scatter_config = ScatterConfig;
+};
+
+template<class Params>
+class RocprimDeviceGatherScatterTests : public ::testing::Test
+{
+public:
+    using value_type                        = typename Params::value_type;
+    using index_type                        = typename Params::index_type;
+    using gather_config                     = typename Params::gather_config;
+    using scatter_config                    = typename Params::scatter_config;
+    static constexpr bool debug_synchronous = false;
+};
+
+using custom_int2    = test_utils::custom_test_type<int>;
+using custom_double2 = test_utils::custom_test_type<double>;
+
+typedef ::testing::Types<
+    DeviceGatherScatterParams<int>,
+    DeviceGatherScatterParams<uint8_t, int>,
+    DeviceGatherScatterParams<short, size_t>,
+    DeviceGatherScatterParams<double, unsigned int>,
+    DeviceGatherScatterParams<rocprim::half, unsigned int>,
+    DeviceGatherScatterParams<custom_int2, int>,
+    DeviceGatherScatterParams<custom_double2, unsigned int>,
+    DeviceGatherScatterParams<int,
+                              unsigned int,
+                              rocprim::gather_config<64, 4, false>,
+                              rocprim::scatter_config<64, 4, false>>,
+    DeviceGatherScatterParams<float,
+                              int,
+                              rocprim::gather_config<128, 3>,
+                              rocprim::scatter_config<128, 3>>,
+    DeviceGatherScatterParams<long long,
+                              unsigned int,
+                              rocprim::gather_config<256, 2, true, 4096>,
+                              rocprim::scatter_config<256, 2, true, 4096>>>
+    RocprimDeviceGatherScatterTestsParams;
+
+TYPED_TEST_SUITE(RocprimDeviceGatherScatterTests, RocprimDeviceGatherScatterTestsParams);
+
+enum class index_locality
+{
+    sorted,
+    nearly_sorted,
+    random
+};
+
+// Permutation of [0, size) with the given locality. Nearly sorted indices are only shuffled
+// within small windows, so most threads still see some consecutive indices.
+template<class Index>
+std::vector<Index>
+    generate_permutation(const size_t size, const index_locality locality, const unsigned int seed)
+{
+    std::vector<Index> indices(size);
+    std::iota(indices.begin(), indices.end(), Index(0));
+
+    std::mt19937 rng(seed);
+    if(locality == index_locality::random)
+    {
+        std::shuffle(indices.begin(), indices.end(), rng);
+    }
+    else if(locality == index_locality::nearly_sorted)
+    {
+        constexpr size_t window = 32;
+        for(size_t i = 0; i < size; i += 2 * window)
+        {
+            std::shuffle(indices.begin() + i,
+                         indices.begin() + std::min(size, i + window),
+                         rng);
+        }
+    }
+    return indices;
+}
+
+TYPED_TEST(RocprimDeviceGatherScatterTests, Gather)
+{
+    using T      = typename TestFixture::value_type;
+    using I      = typename TestFixture::index_type;
+    using Config = typename TestFixture::gather_config;
+
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    const bool  debug_synchronous = TestFixture::debug_synchronous;
+    hipStream_t stream            = 0; // default
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(auto size : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            // The input is read at an offset too, so that runs are not aligned for vector loads
+            const std::vector<T> input
+                = test_utils::get_random_data<T>(size + 1, 0, 100, seed_value);
+
+            T* d_input;
+            I* d_indices;
+            T* d_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, (size + 1) * sizeof(T)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_indices,
+                                                         std::max<size_t>(size, 1) * sizeof(I)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output,
+                                                         std::max<size_t>(size, 1) * sizeof(T)));
+            HIP_CHECK(
+                hipMemcpy(d_input, input.data(), (size + 1) * sizeof(T), hipMemcpyHostToDevice));
+
+            for(auto locality :
+                {index_locality::sorted, index_locality::nearly_sorted, index_locality::random})
+            {
+                SCOPED_TRACE(testing::Message()
+                             << "with locality = " << static_cast<int>(locality));
+
+                const std::vector<I> indices
+                    = generate_permutation<I>(size, locality, seed_value);
+                HIP_CHECK(hipMemcpy(d_indices,
+                                    indices.data(),
+                                    size * sizeof(I),
+                                    hipMemcpyHostToDevice));
+
+                for(size_t input_offset : {0, 1})
+                {
+                    SCOPED_TRACE(testing::Message() << "with input_offset = " << input_offset);
+
+                    std::vector<T> expected(size);
+                    for(size_t i = 0; i < size; i++)
+                    {
+                        expected[i] = input[input_offset + indices[i]];
+                    }
+
+                    HIP_CHECK(rocprim::gather<Config>(d_input + input_offset,
+                                                      d_indices,
+                                                      d_output,
+                                                      size,
+                                                      stream,
+                                                      debug_synchronous));
+                    HIP_CHECK(hipGetLastError());
+                    HIP_CHECK(hipDeviceSynchronize());
+
+                    std::vector<T> output(size);
+                    HIP_CHECK(hipMemcpy(output.data(),
+                                        d_output,
+                                        size * sizeof(T),
+                                        hipMemcpyDeviceToHost));
+
+                    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+                }
+            }
+
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_indices));
+            HIP_CHECK(hipFree(d_output));
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceGatherScatterTests, GatherRepeatedIndices)
+{
+    using T      = typename TestFixture::value_type;
+    using I      = typename TestFixture::index_type;
+    using Config = typename TestFixture::gather_config;
+
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    const bool  debug_synchronous = TestFixture::debug_synchronous;
+    hipStream_t stream            = 0; // default
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(auto size : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+            if(size == 0)
+            {
+                continue;
+            }
+
+            // Gather from a smaller input, so that indices repeat
+            const size_t         input_size = std::max<size_t>(size / 7, 1);
+            const std::vector<T> input
+                = test_utils::get_random_data<T>(input_size, 0, 100, seed_value);
+            const std::vector<I> indices
+                = test_utils::get_random_data<I>(size, 0, static_cast<I>(input_size - 1), seed_value);
+
+            std::vector<T> expected(size);
+            for(size_t i = 0; i < size; i++)
+            {
+                expected[i] = input[indices[i]];
+            }
+
+            T* d_input;
+            I* d_indices;
+            T* d_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, input_size * sizeof(T)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_indices, size * sizeof(I)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, size * sizeof(T)));
+            HIP_CHECK(
+                hipMemcpy(d_input, input.data(), input_size * sizeof(T), hipMemcpyHostToDevice));
+            HIP_CHECK(
+                hipMemcpy(d_indices, indices.data(), size * sizeof(I), hipMemcpyHostToDevice));
+
+            HIP_CHECK(rocprim::gather<Config>(d_input,
+                                              d_indices,
+                                              d_output,
+                                              size,
+                                              stream,
+                                              debug_synchronous));
+            HIP_CHECK(hipGetLastError());
+            HIP_CHECK(hipDeviceSynchronize());
+
+            std::vector<T> output(size);
+            HIP_CHECK(hipMemcpy(output.data(), d_output, size * sizeof(T), hipMemcpyDeviceToHost));
+
+            ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_indices));
+            HIP_CHECK(hipFree(d_output));
+        }
+    }
+}
+
+template<class TestFixture, bool WithFlags>
+void testScatter()
+{
+    using T      = typename TestFixture::value_type;
+    using I      = typename TestFixture::index_type;
+    using Config = typename TestFixture::scatter_config;
+
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    const bool  debug_synchronous = TestFixture::debug_synchronous;
+    hipStream_t stream            = 0; // default
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(auto size : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            const std::vector<T> input = test_utils::get_random_data<T>(size, 0, 100, seed_value);
+            // Mostly set flags, so that some runs are stored as a whole
+            const std::vector<unsigned char> flags
+                = test_utils::get_random_data<unsigned char>(size, 0, 7, seed_value);
+            const T initial_value = T(101);
+
+            T*             d_input;
+            I*             d_indices;
+            unsigned char* d_flags;
+            T*             d_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input,
+                                                         std::max<size_t>(size, 1) * sizeof(T)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_indices,
+                                                         std::max<size_t>(size, 1) * sizeof(I)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_flags, std::max<size_t>(size, 1)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, (size + 1) * sizeof(T)));
+            HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_flags, flags.data(), size, hipMemcpyHostToDevice));
+
+            for(auto locality :
+                {index_locality::sorted, index_locality::nearly_sorted, index_locality::random})
+            {
+                SCOPED_TRACE(testing::Message()
+                             << "with locality = " << static_cast<int>(locality));
+
+                const std::vector<I> indices
+                    = generate_permutation<I>(size, locality, seed_value);
+                HIP_CHECK(hipMemcpy(d_indices,
+                                    indices.data(),
+                                    size * sizeof(I),
+                                    hipMemcpyHostToDevice));
+
+                // The output is written at an offset too, so that runs are not aligned for
+                // vector stores
+                for(size_t output_offset : {0, 1})
+                {
+                    SCOPED_TRACE(testing::Message() << "with output_offset = " << output_offset);
+
+                    std::vector<T> expected(size + 1, initial_value);
+                    for(size_t i = 0; i < size; i++)
+                    {
+                        if(!WithFlags || flags[i])
+                        {
+                            expected[output_offset + indices[i]] = input[i];
+                        }
+                    }
+
+                    std::vector<T> output(size + 1, initial_value);
+                    HIP_CHECK(hipMemcpy(d_output,
+                                        output.data(),
+                                        (size + 1) * sizeof(T),
+                                        hipMemcpyHostToDevice));
+
+                    if(WithFlags)
+                    {
+                        HIP_CHECK(rocprim::scatter_if<Config>(d_input,
+                                                              d_indices,
+                                                              d_flags,
+                                                              d_output + output_offset,
+                                                              size,
+                                                              stream,
+                                                              debug_synchronous));
+                    }
+                    else
+                    {
+                        HIP_CHECK(rocprim::scatter<Config>(d_input,
+                                                           d_indices,
+                                                           d_output + output_offset,
+                                                           size,
+                                                           stream,
+                                                           debug_synchronous));
+                    }
+                    HIP_CHECK(hipGetLastError());
+                    HIP_CHECK(hipDeviceSynchronize());
+
+                    HIP_CHECK(hipMemcpy(output.data(),
+                                        d_output,
+                                        (size + 1) * sizeof(T),
+                                        hipMemcpyDeviceToHost));
+
+                    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+                }
+            }
+
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_indices));
+            HIP_CHECK(hipFree(d_flags));
+            HIP_CHECK(hipFree(d_output));
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceGatherScatterTests, Scatter)
+{
+    testScatter<TestFixture, false>();
+}
+
+TYPED_TEST(RocprimDeviceGatherScatterTests, ScatterIf)
+{
+    testScatter<TestFixture, true>();
+}
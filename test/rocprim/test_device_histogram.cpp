@@ -127,6 +127,13 @@ public:
 };
 
 using custom_config1 = rocprim::histogram_config<rocprim::kernel_config<128, 5>>;
+// Uses the sort-based implementation for histograms that do not fit into shared memory
+using custom_config_sort
+    = rocprim::histogram_config<rocprim::kernel_config<256, 4>, 1024, 2048, 3, 0, 1>;
+// Counts histograms that do not fit into shared memory in many passes of the shared memory
+// implementation
+using custom_config_passes
+    = rocprim::histogram_config<rocprim::kernel_config<256, 4>, 1024, 512, 3, UINT_MAX, 16>;
 
 typedef ::testing::Types<params1<int, 10, 0, 10>,
                          params1<float, 10, 0, 10>,
@@ -142,7 +149,13 @@ typedef ::testing::Types<params1<int, 10, 0, 10>,
                          params1<double, 10, 0, 1000, double, int>,
                          params1<int, 123, 100, 5635, int>,
                          params1<double, 55, -123, +123, double, unsigned int, custom_config1>,
-                         params1<int, 10, 0, 10, int, int, rocprim::default_config, true>>
+                         params1<int, 10, 0, 10, int, int, rocprim::default_config, true>,
+                         params1<unsigned int, 12345, 10, 12355, short, int, custom_config_sort>,
+                         params1<unsigned short, 65536, 0, 65536, int, unsigned int, custom_config_sort>,
+                         params1<float, 5000, -100, 4900, float, int, custom_config_sort, true>,
+                         params1<unsigned short, 8000, 0, 8000, int>,
+                         params1<int, 5000, 0, 10000, int, int, custom_config_passes>,
+                         params1<float, 5000, -100, 4900, float, int, custom_config_passes, true>>
     Params1;
 
 TYPED_TEST_SUITE(RocprimDeviceHistogramEven, Params1);
@@ -392,7 +405,8 @@ typedef ::testing::Types<
 
     params2<float, 456, -100, 1, 123>,
     params2<double, 3, 10000, 1000, 1000, double, unsigned int>,
-    params2<int, 10, 0, 1, 10, int, int, rocprim::default_config, true>>
+    params2<int, 10, 0, 1, 10, int, int, rocprim::default_config, true>,
+    params2<unsigned int, 5000, 0, 1, 100, unsigned int, unsigned long long, custom_config_passes>>
     Params2;
 
 TYPED_TEST_SUITE(RocprimDeviceHistogramRange, Params2);
@@ -677,7 +691,10 @@ typedef ::testing::Types<
     params3<double, 4, 2, 10, 0, 1000, double, int>,
     params3<int, 3, 2, 123, 100, 5635, int>,
     params3<double, 4, 3, 55, -123, +123, double, unsigned long long, custom_config3>,
-    params3<int, 4, 3, 2000, 0, 2000, int, int, rocprim::default_config, true>>
+    params3<int, 4, 3, 2000, 0, 2000, int, int, rocprim::default_config, true>,
+    params3<int, 4, 3, 2000, 0, 2000, int, int, custom_config_sort>,
+    params3<unsigned short, 4, 2, 65536, 0, 65536, int, unsigned int, custom_config_sort>,
+    params3<int, 4, 3, 2000, 0, 2000, int, int, custom_config_passes>>
     Params3;
 
 TYPED_TEST_SUITE(RocprimDeviceHistogramMultiEven, Params3);
@@ -1244,3 +1261,368 @@ TYPED_TEST(RocprimDeviceHistogramMultiRange, MultiRange)
         HIP_CHECK(hipStreamDestroy(stream));
     }
 }
+
+template<class SampleType,
+         class WeightType,
+         class CounterType,
+         unsigned int Bins,
+         int          LowerLevel,
+         int          UpperLevel,
+         class Config = rocprim::default_config>
+struct params5
+{
+    using sample_type                         = SampleType;
+    using weight_type                         = WeightType;
+    using counter_type                        = CounterType;
+    static constexpr unsigned int bins        = Bins;
+    static constexpr int          lower_level = LowerLevel;
+    static constexpr int          upper_level = UpperLevel;
+    using config                              = Config;
+};
+
+template<class Params>
+class RocprimDeviceHistogramWeighted : public ::testing::Test
+{
+public:
+    using params = Params;
+};
+
+typedef ::testing::Types<params5<int, float, float, 10, 0, 10>,
+                         params5<float, double, double, 100, -50, 50>,
+                         params5<unsigned char, unsigned int, uint64_t, 256, 0, 256>,
+                         params5<int, int, int, 123, 100, 5635, custom_config1>,
+                         params5<unsigned short, float, double, 5000, 0, 5000>,
+                         params5<int, double, unsigned long long, 12345, 10, 12355>,
+                         params5<int, float, float, 3000, 0, 6000, custom_config_passes>>
+    Params5;
+
+TYPED_TEST_SUITE(RocprimDeviceHistogramWeighted, Params5);
+
+TYPED_TEST(RocprimDeviceHistogramWeighted, Weighted)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using sample_type             = typename TestFixture::params::sample_type;
+    using weight_type             = typename TestFixture::params::weight_type;
+    using counter_type            = typename TestFixture::params::counter_type;
+    using config                  = typename TestFixture::params::config;
+    constexpr unsigned int bins   = TestFixture::params::bins;
+    constexpr int lower_level     = TestFixture::params::lower_level;
+    constexpr int upper_level     = TestFixture::params::upper_level;
+    const int     scale           = (upper_level - lower_level) / bins;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    std::vector<int> levels(bins + 1);
+    for(unsigned int i = 0; i <= bins; i++)
+    {
+        levels[i] = lower_level + static_cast<int>(i) * scale;
+    }
+
+    for(size_t size : {0, 1, 53, 5096, 34567, (1 << 18) - 1220})
+    {
+        for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+        {
+            unsigned int seed_value
+                = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+            SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            std::vector<sample_type> input
+                = get_random_samples<sample_type>(size, lower_level, upper_level, seed_value);
+            // Small integral weights, so the sums are exact for floating point counters
+            const std::vector<int> int_weights
+                = test_utils::get_random_data<int>(size, 0, 10, seed_value + 1);
+            const std::vector<weight_type> weights(int_weights.begin(), int_weights.end());
+
+            // Calculate expected results on host
+            std::vector<counter_type> histogram_expected(bins, 0);
+            for(size_t i = 0; i < size; i++)
+            {
+                // Samples are converted to the level type (int) before binning
+                const int s = static_cast<int>(input[i]);
+                if(s >= lower_level && s < upper_level)
+                {
+                    histogram_expected[(s - lower_level) / scale]
+                        += static_cast<counter_type>(weights[i]);
+                }
+            }
+
+            sample_type*  d_input;
+            weight_type*  d_weights;
+            int*          d_levels;
+            counter_type* d_histogram;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input,
+                                                         std::max<size_t>(1, size)
+                                                             * sizeof(sample_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_weights,
+                                                         std::max<size_t>(1, size)
+                                                             * sizeof(weight_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_levels, (bins + 1) * sizeof(int)));
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_histogram, bins * sizeof(counter_type)));
+            HIP_CHECK(hipMemcpy(d_input,
+                                input.data(),
+                                size * sizeof(sample_type),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_weights,
+                                weights.data(),
+                                size * sizeof(weight_type),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_levels,
+                                levels.data(),
+                                (bins + 1) * sizeof(int),
+                                hipMemcpyHostToDevice));
+
+            for(bool range : {false, true})
+            {
+                SCOPED_TRACE(testing::Message() << "with range = " << range);
+
+                auto dispatch = [&](void* d_temporary_storage, size_t& temporary_storage_bytes)
+                {
+                    if(range)
+                    {
+                        return rocprim::weighted_histogram_range<config>(
+                            d_temporary_storage,
+                            temporary_storage_bytes,
+                            d_input,
+                            d_weights,
+                            static_cast<unsigned int>(size),
+                            d_histogram,
+                            bins + 1,
+                            d_levels,
+                            stream,
+                            debug_synchronous);
+                    }
+                    return rocprim::weighted_histogram_even<config>(
+                        d_temporary_storage,
+                        temporary_storage_bytes,
+                        d_input,
+                        d_weights,
+                        static_cast<unsigned int>(size),
+                        d_histogram,
+                        bins + 1,
+                        lower_level,
+                        upper_level,
+                        stream,
+                        debug_synchronous);
+                };
+
+                size_t temporary_storage_bytes = 0;
+                HIP_CHECK(dispatch(nullptr, temporary_storage_bytes));
+                ASSERT_GT(temporary_storage_bytes, 0U);
+
+                void* d_temporary_storage;
+                HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                             temporary_storage_bytes));
+                HIP_CHECK(dispatch(d_temporary_storage, temporary_storage_bytes));
+
+                std::vector<counter_type> histogram(bins);
+                HIP_CHECK(hipMemcpy(histogram.data(),
+                                    d_histogram,
+                                    bins * sizeof(counter_type),
+                                    hipMemcpyDeviceToHost));
+                HIP_CHECK(hipFree(d_temporary_storage));
+
+                for(size_t i = 0; i < bins; i++)
+                {
+                    ASSERT_EQ(histogram[i], histogram_expected[i]);
+                }
+            }
+
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_weights));
+            HIP_CHECK(hipFree(d_levels));
+            HIP_CHECK(hipFree(d_histogram));
+        }
+    }
+}
+
+template<class SampleType,
+         unsigned int Channels,
+         unsigned int Dimensions,
+         unsigned int Bins,
+         int          LowerLevel,
+         int          UpperLevel,
+         class CounterType = int,
+         class Config      = rocprim::default_config>
+struct params6
+{
+    using sample_type                         = SampleType;
+    static constexpr unsigned int channels    = Channels;
+    static constexpr unsigned int dimensions  = Dimensions;
+    static constexpr unsigned int bins        = Bins;
+    static constexpr int          lower_level = LowerLevel;
+    static constexpr int          upper_level = UpperLevel;
+    using counter_type                        = CounterType;
+    using config                              = Config;
+};
+
+template<class Params>
+class RocprimDeviceHistogramNdEven : public ::testing::Test
+{
+public:
+    using params = Params;
+};
+
+typedef ::testing::Types<params6<int, 2, 2, 10, 0, 10>,
+                         params6<float, 3, 2, 40, -20, 20, unsigned int>,
+                         params6<unsigned char, 4, 3, 16, 0, 256>,
+                         params6<unsigned char, 3, 3, 64, 0, 256, unsigned long long>,
+                         params6<int, 1, 1, 5000, 0, 5000, int, custom_config1>,
+                         params6<unsigned short, 2, 2, 200, 0, 1000>>
+    Params6;
+
+TYPED_TEST_SUITE(RocprimDeviceHistogramNdEven, Params6);
+
+TYPED_TEST(RocprimDeviceHistogramNdEven, NdEven)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using sample_type                   = typename TestFixture::params::sample_type;
+    using counter_type                  = typename TestFixture::params::counter_type;
+    using config                        = typename TestFixture::params::config;
+    constexpr unsigned int channels     = TestFixture::params::channels;
+    constexpr unsigned int dimensions   = TestFixture::params::dimensions;
+    constexpr unsigned int bins         = TestFixture::params::bins;
+    constexpr int          lower_level  = TestFixture::params::lower_level;
+    constexpr int          upper_level  = TestFixture::params::upper_level;
+    const int              scale        = (upper_level - lower_level) / bins;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    unsigned int levels[dimensions];
+    int          lower_levels[dimensions];
+    int          upper_levels[dimensions];
+    size_t       total_bins = 1;
+    for(unsigned int dim = 0; dim < dimensions; dim++)
+    {
+        levels[dim]       = bins + 1;
+        lower_levels[dim] = lower_level;
+        upper_levels[dim] = upper_level;
+        total_bins *= bins;
+    }
+
+    for(size_t size : {0, 1, 53, 5096, 34567, (1 << 18) - 1220})
+    {
+        for(bool coherent : {false, true})
+        {
+            for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+            {
+                unsigned int seed_value = seed_index < random_seeds_count
+                                              ? rand()
+                                              : seeds[seed_index - random_seeds_count];
+                SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+                SCOPED_TRACE(testing::Message() << "with size = " << size);
+                SCOPED_TRACE(testing::Message() << "with coherent = " << coherent);
+
+                std::vector<sample_type> input = get_random_samples<sample_type>(size * channels,
+                                                                                 lower_level,
+                                                                                 upper_level,
+                                                                                 seed_value);
+                if(coherent)
+                {
+                    // Pixels close to each other have close values, like in images, so the
+                    // bins of a tile are in a small box
+                    const std::vector<int> noise
+                        = test_utils::get_random_data<int>(size * channels, 0, 2 * scale, seed_value);
+                    for(size_t i = 0; i < size; i++)
+                    {
+                        for(unsigned int channel = 0; channel < channels; channel++)
+                        {
+                            const int value = lower_level
+                                              + static_cast<int>((i / 1000 + channel * 7)
+                                                                 % (upper_level - lower_level))
+                                              + noise[i * channels + channel];
+                            input[i * channels + channel] = static_cast<sample_type>(value);
+                        }
+                    }
+                }
+
+                // Calculate expected results on host
+                std::vector<counter_type> histogram_expected(total_bins, 0);
+                for(size_t i = 0; i < size; i++)
+                {
+                    size_t bin   = 0;
+                    bool   valid = true;
+                    for(unsigned int dim = 0; dim < dimensions; dim++)
+                    {
+                        // Samples are converted to the level type (int) before binning
+                        const int s = static_cast<int>(input[i * channels + dim]);
+                        valid       = valid && s >= lower_level && s < upper_level;
+                        bin         = bin * bins + (valid ? (s - lower_level) / scale : 0);
+                    }
+                    if(valid)
+                    {
+                        histogram_expected[bin]++;
+                    }
+                }
+
+                sample_type*  d_input;
+                counter_type* d_histogram;
+                HIP_CHECK(test_common_utils::hipMallocHelper(&d_input,
+                                                             std::max<size_t>(1, input.size())
+                                                                 * sizeof(sample_type)));
+                HIP_CHECK(test_common_utils::hipMallocHelper(&d_histogram,
+                                                             total_bins * sizeof(counter_type)));
+                HIP_CHECK(hipMemcpy(d_input,
+                                    input.data(),
+                                    input.size() * sizeof(sample_type),
+                                    hipMemcpyHostToDevice));
+
+                size_t temporary_storage_bytes = 0;
+                HIP_CHECK((rocprim::histogram_nd_even<channels, dimensions, config>(
+                    nullptr,
+                    temporary_storage_bytes,
+                    d_input,
+                    static_cast<unsigned int>(size),
+                    d_histogram,
+                    levels,
+                    lower_levels,
+                    upper_levels,
+                    stream,
+                    debug_synchronous)));
+                ASSERT_GT(temporary_storage_bytes, 0U);
+
+                void* d_temporary_storage;
+                HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                             temporary_storage_bytes));
+
+                HIP_CHECK((rocprim::histogram_nd_even<channels, dimensions, config>(
+                    d_temporary_storage,
+                    temporary_storage_bytes,
+                    d_input,
+                    static_cast<unsigned int>(size),
+                    d_histogram,
+                    levels,
+                    lower_levels,
+                    upper_levels,
+                    stream,
+                    debug_synchronous)));
+
+                std::vector<counter_type> histogram(total_bins);
+                HIP_CHECK(hipMemcpy(histogram.data(),
+                                    d_histogram,
+                                    total_bins * sizeof(counter_type),
+                                    hipMemcpyDeviceToHost));
+
+                HIP_CHECK(hipFree(d_temporary_storage));
+                HIP_CHECK(hipFree(d_input));
+                HIP_CHECK(hipFree(d_histogram));
+
+                for(size_t i = 0; i < total_bins; i++)
+                {
+                    ASSERT_EQ(histogram[i], histogram_expected[i]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,425 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// The counters are only compiled in with ROCPRIM_INSTRUMENT=1
+#define ROCPRIM_INSTRUMENT 1
+
+#include "../common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_histogram.hpp>
+#include <rocprim/device/device_scan.hpp>
+#include <rocprim/device/device_select.hpp>
+#include <rocprim/device/device_trace.hpp>
+#include <rocprim/functional.hpp>
+
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+
+void collect_trace_event(const rocprim::trace_event& event, void* user_data)
+{
+    static_cast<std::vector<rocprim::trace_event>*>(user_data)->push_back(event);
+}
+
+// Large enough for one counter per tile of the tested sizes
+constexpr size_t counters_size = size_t(1) << 16;
+
+template<rocprim::device_scan_algorithm ScanAlgorithm>
+void test_instrumented_scan()
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using T      = double;
+    using config = rocprim::scan_config<256,
+                                        4,
+                                        rocprim::block_load_method::block_load_transpose,
+                                        rocprim::block_store_method::block_store_transpose,
+                                        rocprim::block_scan_algorithm::using_warp_scan,
+                                        ROCPRIM_GRID_SIZE_LIMIT,
+                                        ScanAlgorithm>;
+    const bool        debug_synchronous = false;
+    const hipStream_t stream            = 0; // default
+    const size_t      size              = size_t(1) << 22;
+
+    std::vector<T> input(size, T(1));
+
+    T*                          d_input;
+    T*                          d_output;
+    rocprim::lookback_counters* d_counters;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(T)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, size * sizeof(T)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_counters,
+                                                 counters_size * sizeof(*d_counters)));
+    HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemset(d_counters, 0, counters_size * sizeof(*d_counters)));
+
+    std::vector<rocprim::trace_event> events;
+    {
+        rocprim::trace_scope      trace(collect_trace_event, &events);
+        rocprim::instrument_scope instrument(d_counters, counters_size);
+
+        size_t storage_size;
+        HIP_CHECK(rocprim::inclusive_scan<config>(nullptr,
+                                                  storage_size,
+                                                  d_input,
+                                                  d_output,
+                                                  size,
+                                                  rocprim::plus<T>(),
+                                                  stream,
+                                                  debug_synchronous));
+        void* d_temp_storage;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, storage_size));
+        HIP_CHECK(rocprim::inclusive_scan<config>(d_temp_storage,
+                                                  storage_size,
+                                                  d_input,
+                                                  d_output,
+                                                  size,
+                                                  rocprim::plus<T>(),
+                                                  stream,
+                                                  debug_synchronous));
+        HIP_CHECK(hipGetLastError());
+        HIP_CHECK(hipDeviceSynchronize());
+        HIP_CHECK(hipFree(d_temp_storage));
+    }
+
+    // The counters do not change the result
+    std::vector<T> output(size);
+    HIP_CHECK(hipMemcpy(output.data(), d_output, size * sizeof(T), hipMemcpyDeviceToHost));
+    for(size_t i = 0; i < size; ++i)
+    {
+        ASSERT_EQ(output[i], T(i + 1)) << "where index = " << i;
+    }
+
+    size_t tiles = 0;
+    for(const rocprim::trace_event& event : events)
+    {
+        ASSERT_EQ(event.counters, d_counters);
+        if(std::strcmp(event.kernel, "lookback_scan_kernel") == 0)
+        {
+            tiles = rocprim::detail::ceiling_div(event.size,
+                                                 size_t(event.block_size)
+                                                     * event.items_per_thread);
+        }
+    }
+    ASSERT_GT(tiles, 1u);
+    ASSERT_LE(tiles, counters_size);
+
+    std::vector<rocprim::lookback_counters> counters(counters_size);
+    HIP_CHECK(hipMemcpy(counters.data(),
+                        d_counters,
+                        counters_size * sizeof(counters[0]),
+                        hipMemcpyDeviceToHost));
+
+    // The first tile has no predecessors, all others look back at least once
+    ASSERT_EQ(counters[0].lookback_iterations, 0u);
+    ASSERT_EQ(counters[0].spin_loops, 0u);
+    for(size_t tile = 1; tile < tiles; ++tile)
+    {
+        ASSERT_GE(counters[tile].lookback_iterations, 1u) << "where tile = " << tile;
+    }
+    for(size_t tile = tiles; tile < counters_size; ++tile)
+    {
+        ASSERT_EQ(counters[tile].lookback_iterations, 0u) << "where tile = " << tile;
+    }
+
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_counters));
+}
+
+} // namespace
+
+TEST(RocprimDeviceInstrumentTests, InclusiveScanLookback)
+{
+    test_instrumented_scan<rocprim::device_scan_algorithm::lookback>();
+}
+
+TEST(RocprimDeviceInstrumentTests, InclusiveScanLookbackTagged)
+{
+    test_instrumented_scan<rocprim::device_scan_algorithm::lookback_tagged>();
+}
+
+TEST(RocprimDeviceInstrumentTests, Select)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using T                             = int;
+    const bool        debug_synchronous = false;
+    const hipStream_t stream            = 0; // default
+    const size_t      size              = size_t(1) << 22;
+
+    std::vector<T> input(size);
+    std::iota(input.begin(), input.end(), T(0));
+    std::vector<unsigned char> flags(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        flags[i] = i % 3 == 0;
+    }
+    const size_t expected_selected = (size + 2) / 3;
+
+    T*                          d_input;
+    unsigned char*              d_flags;
+    T*                          d_output;
+    unsigned int*               d_selected_count;
+    rocprim::lookback_counters* d_counters;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(T)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_flags, size * sizeof(unsigned char)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, size * sizeof(T)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_selected_count, sizeof(unsigned int)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_counters,
+                                                 counters_size * sizeof(*d_counters)));
+    HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+    HIP_CHECK(
+        hipMemcpy(d_flags, flags.data(), size * sizeof(unsigned char), hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemset(d_counters, 0, counters_size * sizeof(*d_counters)));
+
+    {
+        rocprim::instrument_scope instrument(d_counters, counters_size);
+
+        size_t storage_size;
+        HIP_CHECK(rocprim::select(nullptr,
+                                  storage_size,
+                                  d_input,
+                                  d_flags,
+                                  d_output,
+                                  d_selected_count,
+                                  size,
+                                  stream,
+                                  debug_synchronous));
+        void* d_temp_storage;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, storage_size));
+        HIP_CHECK(rocprim::select(d_temp_storage,
+                                  storage_size,
+                                  d_input,
+                                  d_flags,
+                                  d_output,
+                                  d_selected_count,
+                                  size,
+                                  stream,
+                                  debug_synchronous));
+        HIP_CHECK(hipGetLastError());
+        HIP_CHECK(hipDeviceSynchronize());
+        HIP_CHECK(hipFree(d_temp_storage));
+    }
+
+    unsigned int selected_count;
+    HIP_CHECK(hipMemcpy(&selected_count,
+                        d_selected_count,
+                        sizeof(unsigned int),
+                        hipMemcpyDeviceToHost));
+    ASSERT_EQ(selected_count, expected_selected);
+
+    std::vector<rocprim::lookback_counters> counters(counters_size);
+    HIP_CHECK(hipMemcpy(counters.data(),
+                        d_counters,
+                        counters_size * sizeof(counters[0]),
+                        hipMemcpyDeviceToHost));
+
+    // select runs a single look-back over many tiles
+    ASSERT_EQ(counters[0].lookback_iterations, 0u);
+    size_t lookback_iterations = 0;
+    for(const rocprim::lookback_counters& tile_counters : counters)
+    {
+        lookback_iterations += tile_counters.lookback_iterations;
+    }
+    ASSERT_GT(lookback_iterations, 0u);
+
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_flags));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_selected_count));
+    HIP_CHECK(hipFree(d_counters));
+}
+
+TEST(RocprimDeviceInstrumentTests, HistogramEven)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using T                             = int;
+    const bool        debug_synchronous = false;
+    const hipStream_t stream            = 0; // default
+    const size_t      size              = size_t(1) << 20;
+    const unsigned int bins             = 4;
+
+    // All samples fall into the first bin: every lane of a warp adds to the same bins
+    std::vector<T> input(size, T(0));
+
+    T*                           d_input;
+    unsigned int*                d_histogram;
+    rocprim::histogram_counters* d_counters;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(T)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_histogram, bins * sizeof(unsigned int)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_counters,
+                                                 counters_size * sizeof(*d_counters)));
+    HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemset(d_counters, 0, counters_size * sizeof(*d_counters)));
+
+    std::vector<rocprim::trace_event> events;
+    {
+        rocprim::trace_scope      trace(collect_trace_event, &events);
+        rocprim::instrument_scope instrument(d_counters, counters_size);
+
+        size_t storage_size;
+        HIP_CHECK(rocprim::histogram_even(nullptr,
+                                          storage_size,
+                                          d_input,
+                                          static_cast<unsigned int>(size),
+                                          d_histogram,
+                                          bins + 1,
+                                          T(0),
+                                          T(bins),
+                                          stream,
+                                          debug_synchronous));
+        void* d_temp_storage;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, storage_size));
+        HIP_CHECK(rocprim::histogram_even(d_temp_storage,
+                                          storage_size,
+                                          d_input,
+                                          static_cast<unsigned int>(size),
+                                          d_histogram,
+                                          bins + 1,
+                                          T(0),
+                                          T(bins),
+                                          stream,
+                                          debug_synchronous));
+        HIP_CHECK(hipGetLastError());
+        HIP_CHECK(hipDeviceSynchronize());
+        HIP_CHECK(hipFree(d_temp_storage));
+    }
+
+    // The counters do not change the result
+    std::vector<unsigned int> histogram(bins);
+    HIP_CHECK(hipMemcpy(histogram.data(),
+                        d_histogram,
+                        bins * sizeof(unsigned int),
+                        hipMemcpyDeviceToHost));
+    ASSERT_EQ(histogram[0], size);
+    for(unsigned int bin = 1; bin < bins; ++bin)
+    {
+        ASSERT_EQ(histogram[bin], 0u) << "where bin = " << bin;
+    }
+
+    size_t blocks = 0;
+    for(const rocprim::trace_event& event : events)
+    {
+        ASSERT_EQ(event.bin_counters, d_counters);
+        if(std::strcmp(event.kernel, "histogram_shared") == 0)
+        {
+            blocks = event.grid_size;
+        }
+    }
+    ASSERT_GT(blocks, 0u);
+    ASSERT_LE(blocks, counters_size);
+
+    std::vector<rocprim::histogram_counters> counters(counters_size);
+    HIP_CHECK(hipMemcpy(counters.data(),
+                        d_counters,
+                        counters_size * sizeof(counters[0]),
+                        hipMemcpyDeviceToHost));
+
+    // Every sample is added to a privatized histogram, which every block adds to the single
+    // non-empty bin of the histogram
+    size_t shared_atomics   = 0;
+    size_t shared_conflicts = 0;
+    size_t global_atomics   = 0;
+    for(const rocprim::histogram_counters& block_counters : counters)
+    {
+        shared_atomics += block_counters.shared_atomics;
+        shared_conflicts += block_counters.shared_conflicts;
+        global_atomics += block_counters.global_atomics;
+        ASSERT_EQ(block_counters.global_conflicts, 0u);
+    }
+    ASSERT_EQ(shared_atomics, size);
+    ASSERT_GT(shared_conflicts, 0u);
+    ASSERT_LT(shared_conflicts, size);
+    ASSERT_EQ(global_atomics, blocks);
+
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_histogram));
+    HIP_CHECK(hipFree(d_counters));
+}
+
+TEST(RocprimDeviceInstrumentTests, WithoutScope)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using T                             = int;
+    const bool        debug_synchronous = false;
+    const hipStream_t stream            = 0; // default
+    const size_t      size              = size_t(1) << 16;
+
+    T* d_input;
+    T* d_output;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(T)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, size * sizeof(T)));
+    HIP_CHECK(hipMemset(d_input, 0, size * sizeof(T)));
+
+    // Events of algorithms outside of an instrument_scope report no counters
+    std::vector<rocprim::trace_event> events;
+    rocprim::trace_scope              trace(collect_trace_event, &events);
+
+    size_t storage_size;
+    HIP_CHECK(rocprim::exclusive_scan(nullptr,
+                                      storage_size,
+                                      d_input,
+                                      d_output,
+                                      T(0),
+                                      size,
+                                      rocprim::plus<T>(),
+                                      stream,
+                                      debug_synchronous));
+    void* d_temp_storage;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, storage_size));
+    HIP_CHECK(rocprim::exclusive_scan(d_temp_storage,
+                                      storage_size,
+                                      d_input,
+                                      d_output,
+                                      T(0),
+                                      size,
+                                      rocprim::plus<T>(),
+                                      stream,
+                                      debug_synchronous));
+    HIP_CHECK(hipGetLastError());
+
+    ASSERT_FALSE(events.empty());
+    for(const rocprim::trace_event& event : events)
+    {
+        ASSERT_EQ(event.counters, nullptr);
+        ASSERT_EQ(event.bin_counters, nullptr);
+    }
+
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_temp_storage));
+}
@@ -0,0 +1,245 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_load_balanced_expand.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+// Params for tests
+template<class InputType,
+         class OffsetType = unsigned int,
+         class Config     = rocprim::default_config,
+         int MaxCount     = 16>
+struct DeviceLoadBalancedExpandParams
+{
+    using input_type               = InputType;
+    using offset_type              = OffsetType;
+    using config                   = Config;
+    static constexpr int max_count = MaxCount;
+};
+
+template<class Params>
+class RocprimDeviceLoadBalancedExpandTests : public ::testing::Test
+{
+public:
+    using input_type                        = typename Params::input_type;
+    using offset_type                       = typename Params::offset_type;
+    using config                            = typename Params::config;
+    static constexpr int  max_count         = Params::max_count;
+    static constexpr bool debug_synchronous = false;
+};
+
+typedef ::testing::Types<
+    DeviceLoadBalancedExpandParams<unsigned int>,
+    DeviceLoadBalancedExpandParams<int, int>,
+    DeviceLoadBalancedExpandParams<unsigned short, unsigned int, rocprim::default_config, 1>,
+    DeviceLoadBalancedExpandParams<unsigned char, size_t, rocprim::default_config, 100>,
+    DeviceLoadBalancedExpandParams<int, unsigned int, rocprim::load_balanced_expand_config<64, 1>>,
+    DeviceLoadBalancedExpandParams<int, unsigned int, rocprim::load_balanced_expand_config<128, 7>>,
+    DeviceLoadBalancedExpandParams<long long,
+                                   unsigned long long,
+                                   rocprim::load_balanced_expand_config<512, 4>,
+                                   3>>
+    RocprimDeviceLoadBalancedExpandTestsParams;
+
+TYPED_TEST_SUITE(RocprimDeviceLoadBalancedExpandTests, RocprimDeviceLoadBalancedExpandTestsParams);
+
+// The number of outputs of a value is the value itself
+template<class Offset>
+struct value_count_op
+{
+    template<class T>
+    __device__ __host__ inline Offset operator()(const T& value) const
+    {
+        return static_cast<Offset>(value);
+    }
+};
+
+template<class Offset>
+struct record_emit_op
+{
+    size_t* input_indices;
+    Offset* ranks;
+
+    template<class T>
+    __device__ inline void operator()(const T& value,
+                                      const size_t input_index,
+                                      const Offset rank,
+                                      const Offset output_index) const
+    {
+        // Every value is expanded into `value` outputs
+        input_indices[output_index] = rank < static_cast<Offset>(value) ? input_index : size_t(-1);
+        ranks[output_index]         = rank;
+    }
+};
+
+template<class TestFixture>
+void testLoadBalancedExpand(const std::vector<typename TestFixture::input_type>& input)
+{
+    using T      = typename TestFixture::input_type;
+    using O      = typename TestFixture::offset_type;
+    using Config = typename TestFixture::config;
+
+    const bool  debug_synchronous = TestFixture::debug_synchronous;
+    hipStream_t stream            = 0; // default
+    const size_t size             = input.size();
+
+    // Calculate expected results on host
+    std::vector<size_t> expected_input_indices;
+    std::vector<O>      expected_ranks;
+    for(size_t i = 0; i < size; i++)
+    {
+        for(O rank = 0; rank < static_cast<O>(input[i]); rank++)
+        {
+            expected_input_indices.push_back(i);
+            expected_ranks.push_back(rank);
+        }
+    }
+    const size_t output_size = expected_input_indices.size();
+
+    T*      d_input;
+    size_t* d_input_indices;
+    O*      d_ranks;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, std::max<size_t>(size, 1) * sizeof(T)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_input_indices,
+                                                 std::max<size_t>(output_size, 1) * sizeof(size_t)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_ranks,
+                                                 std::max<size_t>(output_size, 1) * sizeof(O)));
+    HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+
+    const value_count_op<O> count_op;
+    const record_emit_op<O> emit_op{d_input_indices, d_ranks};
+
+    // temp storage
+    size_t temp_storage_size_bytes;
+    void*  d_temp_storage = nullptr;
+    // Get size of d_temp_storage
+    HIP_CHECK(rocprim::load_balanced_expand<Config>(d_temp_storage,
+                                                    temp_storage_size_bytes,
+                                                    d_input,
+                                                    size,
+                                                    count_op,
+                                                    emit_op,
+                                                    stream,
+                                                    debug_synchronous));
+
+    // allocate temporary storage
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, temp_storage_size_bytes));
+
+    // Run
+    HIP_CHECK(rocprim::load_balanced_expand<Config>(d_temp_storage,
+                                                    temp_storage_size_bytes,
+                                                    d_input,
+                                                    size,
+                                                    count_op,
+                                                    emit_op,
+                                                    stream,
+                                                    debug_synchronous));
+    HIP_CHECK(hipGetLastError());
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Copy output to host
+    std::vector<size_t> input_indices(output_size);
+    std::vector<O>      ranks(output_size);
+    HIP_CHECK(hipMemcpy(input_indices.data(),
+                        d_input_indices,
+                        output_size * sizeof(size_t),
+                        hipMemcpyDeviceToHost));
+    HIP_CHECK(hipMemcpy(ranks.data(), d_ranks, output_size * sizeof(O), hipMemcpyDeviceToHost));
+
+    // Check if output values are as expected
+    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(input_indices, expected_input_indices));
+    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(ranks, expected_ranks));
+
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_input_indices));
+    HIP_CHECK(hipFree(d_ranks));
+    HIP_CHECK(hipFree(d_temp_storage));
+}
+
+TYPED_TEST(RocprimDeviceLoadBalancedExpandTests, Expand)
+{
+    using T = typename TestFixture::input_type;
+
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(auto size : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            // Counts include zeros, so some inputs do not produce any output
+            const std::vector<T> input
+                = test_utils::get_random_data<T>(size, 0, TestFixture::max_count, seed_value);
+            testLoadBalancedExpand<TestFixture>(input);
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceLoadBalancedExpandTests, ExpandSkewed)
+{
+    using T = typename TestFixture::input_type;
+
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(size_t size : {1, 10, 1000, 100000})
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            // Mostly empty inputs and a few inputs with the largest count,
+            // so that a single input spans multiple blocks
+            std::vector<T> input(size, T(0));
+            const std::vector<size_t> positions
+                = test_utils::get_random_data<size_t>(3, 0, size - 1, seed_value);
+            for(const size_t position : positions)
+            {
+                input[position] = static_cast<T>(
+                    std::min<long long>(std::numeric_limits<T>::max(), 5000));
+            }
+            testLoadBalancedExpand<TestFixture>(input);
+        }
+    }
+}
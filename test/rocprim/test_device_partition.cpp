@@ -37,7 +37,8 @@ template<
     class OutputType = InputType,
     class FlagType = unsigned int,
     bool UseIdentityIterator = false,
-    bool UseGraphs = false
+    bool UseGraphs = false,
+    class Config = rocprim::default_config
 >
 struct DevicePartitionParams
 {
@@ -46,8 +47,20 @@ struct DevicePartitionParams
     using flag_type = FlagType;
     static constexpr bool use_identity_iterator = UseIdentityIterator;
     static constexpr bool use_graphs = UseGraphs;
+    using config = Config;
 };
 
+// Partition launched as a persistent grid
+using persistent_partition_config
+    = rocprim::select_config<256,
+                             8,
+                             rocprim::block_load_method::block_load_transpose,
+                             rocprim::block_load_method::block_load_transpose,
+                             rocprim::block_load_method::block_load_transpose,
+                             rocprim::block_scan_algorithm::using_warp_scan,
+                             ROCPRIM_GRID_SIZE_LIMIT,
+                             rocprim::grid_launch_mode::persistent>;
+
 template<class Params>
 class RocprimDevicePartitionTests : public ::testing::Test
 {
@@ -58,6 +71,7 @@ public:
     const bool debug_synchronous = false;
     static constexpr bool use_identity_iterator = Params::use_identity_iterator;
     static constexpr bool use_graphs = Params::use_graphs;
+    using config = typename Params::config;
 };
 
 typedef ::testing::Types<DevicePartitionParams<int, int, unsigned char, true>,
@@ -70,7 +84,19 @@ typedef ::testing::Types<DevicePartitionParams<int, int, unsigned char, true>,
                          DevicePartitionParams<rocprim::half, rocprim::half>,
                          DevicePartitionParams<rocprim::bfloat16, rocprim::bfloat16>,
                          DevicePartitionParams<test_utils::custom_test_type<long long>>,
-                         DevicePartitionParams<int, int, unsigned int, false, true>>
+                         DevicePartitionParams<int, int, unsigned int, false, true>,
+                         DevicePartitionParams<int,
+                                               int,
+                                               unsigned char,
+                                               false,
+                                               false,
+                                               persistent_partition_config>,
+                         DevicePartitionParams<double,
+                                               double,
+                                               unsigned int,
+                                               true,
+                                               false,
+                                               persistent_partition_config>>
     RocprimDevicePartitionTestsParams;
 
 TYPED_TEST_SUITE(RocprimDevicePartitionTests, RocprimDevicePartitionTestsParams);
@@ -141,7 +167,7 @@ TYPED_TEST(RocprimDevicePartitionTests, Flagged)
             // temp storage
             size_t temp_storage_size_bytes;
             // Get size of d_temp_storage
-            HIP_CHECK(rocprim::partition(
+            HIP_CHECK(rocprim::partition<typename TestFixture::config>(
                 nullptr,
                 temp_storage_size_bytes,
                 d_input,
@@ -166,7 +192,7 @@ TYPED_TEST(RocprimDevicePartitionTests, Flagged)
             }
 
             // Run
-            HIP_CHECK(rocprim::partition(
+            HIP_CHECK(rocprim::partition<typename TestFixture::config>(
                 d_temp_storage,
                 temp_storage_size_bytes,
                 d_input,
@@ -394,7 +420,7 @@ TYPED_TEST(RocprimDevicePartitionTests, Predicate)
             // temp storage
             size_t temp_storage_size_bytes;
             // Get size of d_temp_storage
-            HIP_CHECK(rocprim::partition(
+            HIP_CHECK(rocprim::partition<typename TestFixture::config>(
                 nullptr,
                 temp_storage_size_bytes,
                 d_input,
@@ -419,7 +445,7 @@ TYPED_TEST(RocprimDevicePartitionTests, Predicate)
             }
 
             // Run
-            HIP_CHECK(rocprim::partition(
+            HIP_CHECK(rocprim::partition<typename TestFixture::config>(
                 d_temp_storage,
                 temp_storage_size_bytes,
                 d_input,
@@ -552,7 +578,7 @@ TYPED_TEST(RocprimDevicePartitionTests, PredicateTwoWay)
             // temp storage
             size_t temp_storage_size_bytes;
             // Get size of d_temp_storage
-            HIP_CHECK(rocprim::partition(
+            HIP_CHECK(rocprim::partition<typename TestFixture::config>(
                 nullptr,
                 temp_storage_size_bytes,
                 d_input,
@@ -577,7 +603,7 @@ TYPED_TEST(RocprimDevicePartitionTests, PredicateTwoWay)
             }
 
             // Run
-            HIP_CHECK(rocprim::partition_two_way(
+            HIP_CHECK(rocprim::partition_two_way<typename TestFixture::config>(
                 d_temp_storage,
                 temp_storage_size_bytes,
                 d_input,
@@ -741,7 +767,7 @@ TYPED_TEST(RocprimDevicePartitionTests, PredicateThreeWay)
                 // temp storage
                 size_t temp_storage_size_bytes;
                 // Get size of d_temp_storage
-                HIP_CHECK(rocprim::partition_three_way(
+                HIP_CHECK(rocprim::partition_three_way<typename TestFixture::config>(
                     nullptr,
                     temp_storage_size_bytes,
                     d_input,
@@ -770,7 +796,7 @@ TYPED_TEST(RocprimDevicePartitionTests, PredicateThreeWay)
                 }
 
                 // Run
-                HIP_CHECK(rocprim::partition_three_way(
+                HIP_CHECK(rocprim::partition_three_way<typename TestFixture::config>(
                     d_temp_storage,
                     temp_storage_size_bytes,
                     d_input,
@@ -0,0 +1,441 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_plan.hpp>
+#include <rocprim/functional.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+// Params for tests
+template<class KeyType, class ValueType = KeyType>
+struct DevicePlanParams
+{
+    using key_type   = KeyType;
+    using value_type = ValueType;
+};
+
+template<class Params>
+class RocprimDevicePlanTests : public ::testing::Test
+{
+public:
+    using key_type                          = typename Params::key_type;
+    using value_type                        = typename Params::value_type;
+    static constexpr bool debug_synchronous = false;
+};
+
+typedef ::testing::Types<DevicePlanParams<int>,
+                         DevicePlanParams<unsigned long long, int>,
+                         DevicePlanParams<short, double>>
+    RocprimDevicePlanTestsParams;
+
+TYPED_TEST_SUITE(RocprimDevicePlanTests, RocprimDevicePlanTestsParams);
+
+// Every plan is executed with this many different inputs
+constexpr unsigned int plan_executions = 3;
+
+TYPED_TEST(RocprimDevicePlanTests, RadixSortPairs)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type                = typename TestFixture::key_type;
+    using value_type              = typename TestFixture::value_type;
+    const bool  debug_synchronous = TestFixture::debug_synchronous;
+    hipStream_t stream            = 0; // default
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(auto size : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            rocprim::radix_sort_plan<key_type, value_type, true> plan;
+            HIP_CHECK(rocprim::make_radix_sort_plan(plan,
+                                                    size,
+                                                    0,
+                                                    8 * sizeof(key_type),
+                                                    stream,
+                                                    debug_synchronous));
+            ASSERT_EQ(plan.size(), size);
+
+            // The plan needs as much temporary storage as a direct call
+            size_t direct_storage_size;
+            HIP_CHECK(rocprim::radix_sort_pairs_desc(nullptr,
+                                                     direct_storage_size,
+                                                     static_cast<key_type*>(nullptr),
+                                                     static_cast<key_type*>(nullptr),
+                                                     static_cast<value_type*>(nullptr),
+                                                     static_cast<value_type*>(nullptr),
+                                                     size,
+                                                     0,
+                                                     8 * sizeof(key_type),
+                                                     stream));
+            ASSERT_EQ(plan.temporary_storage_bytes(), direct_storage_size);
+
+            key_type*   d_keys_input;
+            key_type*   d_keys_output;
+            value_type* d_values_input;
+            value_type* d_values_output;
+            void*       d_temp_storage;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_input,
+                                                         std::max<size_t>(size, 1)
+                                                             * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_output,
+                                                         std::max<size_t>(size, 1)
+                                                             * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_values_input,
+                                                         std::max<size_t>(size, 1)
+                                                             * sizeof(value_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_values_output,
+                                                         std::max<size_t>(size, 1)
+                                                             * sizeof(value_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage,
+                                                         plan.temporary_storage_bytes()));
+
+            for(unsigned int execution = 0; execution < plan_executions; execution++)
+            {
+                SCOPED_TRACE(testing::Message() << "with execution = " << execution);
+
+                const std::vector<key_type> keys
+                    = test_utils::get_random_data<key_type>(size, 0, 100, seed_value + execution);
+                std::vector<value_type> values(size);
+                std::iota(values.begin(), values.end(), value_type(0));
+                HIP_CHECK(hipMemcpy(d_keys_input,
+                                    keys.data(),
+                                    size * sizeof(key_type),
+                                    hipMemcpyHostToDevice));
+                HIP_CHECK(hipMemcpy(d_values_input,
+                                    values.data(),
+                                    size * sizeof(value_type),
+                                    hipMemcpyHostToDevice));
+
+                // Calculate expected results on host, the sort is stable
+                std::vector<std::pair<key_type, value_type>> expected(size);
+                for(size_t i = 0; i < size; i++)
+                {
+                    expected[i] = std::make_pair(keys[i], values[i]);
+                }
+                std::stable_sort(expected.begin(),
+                                 expected.end(),
+                                 [](const std::pair<key_type, value_type>& lhs,
+                                    const std::pair<key_type, value_type>& rhs)
+                                 { return lhs.first > rhs.first; });
+
+                HIP_CHECK(plan.execute(d_temp_storage,
+                                       d_keys_input,
+                                       d_keys_output,
+                                       d_values_input,
+                                       d_values_output));
+                HIP_CHECK(hipGetLastError());
+
+                std::vector<key_type>   keys_output(size);
+                std::vector<value_type> values_output(size);
+                HIP_CHECK(hipMemcpy(keys_output.data(),
+                                    d_keys_output,
+                                    size * sizeof(key_type),
+                                    hipMemcpyDeviceToHost));
+                HIP_CHECK(hipMemcpy(values_output.data(),
+                                    d_values_output,
+                                    size * sizeof(value_type),
+                                    hipMemcpyDeviceToHost));
+
+                for(size_t i = 0; i < size; i++)
+                {
+                    ASSERT_EQ(keys_output[i], expected[i].first) << "where index = " << i;
+                    ASSERT_EQ(values_output[i], expected[i].second) << "where index = " << i;
+                }
+            }
+
+            HIP_CHECK(hipFree(d_keys_input));
+            HIP_CHECK(hipFree(d_keys_output));
+            HIP_CHECK(hipFree(d_values_input));
+            HIP_CHECK(hipFree(d_values_output));
+            HIP_CHECK(hipFree(d_temp_storage));
+        }
+    }
+}
+
+TYPED_TEST(RocprimDevicePlanTests, MergeSortKeys)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type                = typename TestFixture::key_type;
+    const bool  debug_synchronous = TestFixture::debug_synchronous;
+    hipStream_t stream            = 0; // default
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(auto size : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            rocprim::merge_sort_plan<key_type> plan;
+            HIP_CHECK(rocprim::make_merge_sort_plan(plan,
+                                                    size,
+                                                    rocprim::less<key_type>(),
+                                                    stream,
+                                                    debug_synchronous));
+
+            key_type* d_input;
+            key_type* d_output;
+            void*     d_temp_storage;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input,
+                                                         std::max<size_t>(size, 1)
+                                                             * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output,
+                                                         std::max<size_t>(size, 1)
+                                                             * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage,
+                                                         plan.temporary_storage_bytes()));
+
+            for(unsigned int execution = 0; execution < plan_executions; execution++)
+            {
+                SCOPED_TRACE(testing::Message() << "with execution = " << execution);
+
+                const std::vector<key_type> input
+                    = test_utils::get_random_data<key_type>(size, 0, 100, seed_value + execution);
+                HIP_CHECK(hipMemcpy(d_input,
+                                    input.data(),
+                                    size * sizeof(key_type),
+                                    hipMemcpyHostToDevice));
+
+                std::vector<key_type> expected(input);
+                std::sort(expected.begin(), expected.end());
+
+                HIP_CHECK(plan.execute(d_temp_storage, d_input, d_output));
+                HIP_CHECK(hipGetLastError());
+
+                std::vector<key_type> output(size);
+                HIP_CHECK(hipMemcpy(output.data(),
+                                    d_output,
+                                    size * sizeof(key_type),
+                                    hipMemcpyDeviceToHost));
+
+                ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+            }
+
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_output));
+            HIP_CHECK(hipFree(d_temp_storage));
+        }
+    }
+}
+
+TYPED_TEST(RocprimDevicePlanTests, ReduceAndScan)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using T                       = typename TestFixture::key_type;
+    const bool  debug_synchronous = TestFixture::debug_synchronous;
+    hipStream_t stream            = 0; // default
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(auto size : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            // Maximum never overflows, unlike a sum of short values
+            using op_type = rocprim::maximum<T>;
+
+            rocprim::reduce_plan<T, op_type>         reduce_plan;
+            rocprim::inclusive_scan_plan<T, op_type> inclusive_plan;
+            rocprim::exclusive_scan_plan<T, op_type> exclusive_plan;
+            HIP_CHECK(
+                rocprim::make_reduce_plan(reduce_plan, size, op_type(), stream, debug_synchronous));
+            HIP_CHECK(rocprim::make_inclusive_scan_plan(inclusive_plan,
+                                                        size,
+                                                        op_type(),
+                                                        stream,
+                                                        debug_synchronous));
+            HIP_CHECK(rocprim::make_exclusive_scan_plan(exclusive_plan,
+                                                        size,
+                                                        op_type(),
+                                                        stream,
+                                                        debug_synchronous));
+
+            const size_t temp_storage_size_bytes
+                = std::max({reduce_plan.temporary_storage_bytes(),
+                            inclusive_plan.temporary_storage_bytes(),
+                            exclusive_plan.temporary_storage_bytes()});
+
+            T*    d_input;
+            T*    d_output;
+            void* d_temp_storage;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input,
+                                                         std::max<size_t>(size, 1) * sizeof(T)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output,
+                                                         std::max<size_t>(size, 1) * sizeof(T)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, temp_storage_size_bytes));
+
+            for(unsigned int execution = 0; execution < plan_executions; execution++)
+            {
+                SCOPED_TRACE(testing::Message() << "with execution = " << execution);
+
+                const std::vector<T> input
+                    = test_utils::get_random_data<T>(size, 1, 100, seed_value + execution);
+                HIP_CHECK(
+                    hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+
+                // The initial value differs between the executions
+                const T initial_value = static_cast<T>(execution * 50);
+
+                // Calculate expected results on host
+                std::vector<T> expected_inclusive(size);
+                std::vector<T> expected_exclusive(size);
+                T              inclusive_value = T(0);
+                T              exclusive_value = initial_value;
+                for(size_t i = 0; i < size; i++)
+                {
+                    inclusive_value       = i == 0 ? input[i] : std::max(inclusive_value, input[i]);
+                    expected_inclusive[i] = inclusive_value;
+                    expected_exclusive[i] = exclusive_value;
+                    exclusive_value       = std::max(exclusive_value, input[i]);
+                }
+
+                std::vector<T> output(size);
+
+                HIP_CHECK(reduce_plan.execute(d_temp_storage, d_input, d_output, initial_value));
+                HIP_CHECK(hipGetLastError());
+                HIP_CHECK(hipMemcpy(output.data(), d_output, sizeof(T), hipMemcpyDeviceToHost));
+                ASSERT_EQ(output[0], exclusive_value);
+
+                HIP_CHECK(inclusive_plan.execute(d_temp_storage, d_input, d_output));
+                HIP_CHECK(hipGetLastError());
+                HIP_CHECK(
+                    hipMemcpy(output.data(), d_output, size * sizeof(T), hipMemcpyDeviceToHost));
+                ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected_inclusive));
+
+                HIP_CHECK(exclusive_plan.execute(d_temp_storage, d_input, d_output, initial_value));
+                HIP_CHECK(hipGetLastError());
+                HIP_CHECK(
+                    hipMemcpy(output.data(), d_output, size * sizeof(T), hipMemcpyDeviceToHost));
+                ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected_exclusive));
+            }
+
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_output));
+            HIP_CHECK(hipFree(d_temp_storage));
+        }
+    }
+}
+
+// The later executions of a plan reuse the storage layout and the launches of the first one, they
+// must not depend on the temporary storage or the copy of the plan that is executed
+TEST(RocprimDevicePlanTests, ReplayedExecutions)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type    = unsigned int;
+    const size_t size = 1 << 20;
+
+    rocprim::radix_sort_plan<key_type> plan;
+    HIP_CHECK(rocprim::make_radix_sort_plan(plan, size));
+
+    key_type* d_input;
+    key_type* d_output;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(key_type)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, size * sizeof(key_type)));
+
+    for(unsigned int execution = 0; execution < plan_executions; execution++)
+    {
+        SCOPED_TRACE(testing::Message() << "with execution = " << execution);
+
+        const std::vector<key_type> input
+            = test_utils::get_random_data<key_type>(size, 0, 1 << 30, execution);
+        HIP_CHECK(
+            hipMemcpy(d_input, input.data(), size * sizeof(key_type), hipMemcpyHostToDevice));
+
+        std::vector<key_type> expected(input);
+        std::sort(expected.begin(), expected.end());
+
+        // A new temporary storage and a copy of the plan in every execution
+        void* d_temp_storage;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage,
+                                                     plan.temporary_storage_bytes()));
+        const rocprim::radix_sort_plan<key_type> executed_plan(plan);
+        HIP_CHECK(executed_plan.execute(d_temp_storage, d_input, d_output));
+        HIP_CHECK(hipGetLastError());
+
+        std::vector<key_type> output(size);
+        HIP_CHECK(
+            hipMemcpy(output.data(), d_output, size * sizeof(key_type), hipMemcpyDeviceToHost));
+        HIP_CHECK(hipFree(d_temp_storage));
+
+        ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+    }
+
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_output));
+}
+
+TEST(RocprimDevicePlanTests, InvalidExecution)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    int* d_data;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_data, 1024 * sizeof(int)));
+
+    rocprim::radix_sort_plan<int> plan;
+
+    // The plan was not made
+    void* d_temp_storage;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, 1024));
+    ASSERT_EQ(plan.execute(d_temp_storage, d_data, d_data), hipErrorInvalidValue);
+
+    // Executing a plan does not query the size of the temporary storage
+    HIP_CHECK(rocprim::make_radix_sort_plan(plan, 1024));
+    ASSERT_EQ(plan.execute(nullptr, d_data, d_data), hipErrorInvalidValue);
+
+    HIP_CHECK(hipFree(d_data));
+    HIP_CHECK(hipFree(d_temp_storage));
+}
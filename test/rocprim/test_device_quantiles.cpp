@@ -0,0 +1,241 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "../common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_quantiles.hpp>
+#include <rocprim/thread/radix_key_codec.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Params for tests
+template<class KeyType,
+         int MinKey   = -1000,
+         int MaxKey   = 1000,
+         class Config = rocprim::default_config>
+struct DeviceQuantilesParams
+{
+    using key_type               = KeyType;
+    using config                 = Config;
+    static constexpr int min_key = MinKey;
+    static constexpr int max_key = MaxKey;
+};
+
+template<class Params>
+class RocprimDeviceQuantilesTests : public ::testing::Test
+{
+public:
+    using key_type                          = typename Params::key_type;
+    using config                            = typename Params::config;
+    static constexpr int  min_key           = Params::min_key;
+    static constexpr int  max_key           = Params::max_key;
+    static constexpr bool debug_synchronous = false;
+};
+
+typedef ::testing::Types<
+    DeviceQuantilesParams<int>,
+    DeviceQuantilesParams<int, 0, 3>,
+    DeviceQuantilesParams<unsigned char, 0, 255>,
+    DeviceQuantilesParams<short>,
+    DeviceQuantilesParams<unsigned int, 0, 1000000>,
+    DeviceQuantilesParams<float>,
+    DeviceQuantilesParams<double, -1000000, 1000000>,
+    DeviceQuantilesParams<long long, -1000000, 1000000>,
+    DeviceQuantilesParams<int,
+                          -1000,
+                          1000,
+                          rocprim::histogram_config<rocprim::kernel_config<128, 4>, 64, 1024>>>
+    RocprimDeviceQuantilesTestsParams;
+
+TYPED_TEST_SUITE(RocprimDeviceQuantilesTests, RocprimDeviceQuantilesTestsParams);
+
+template<class TestFixture>
+void testQuantiles(const rocprim::quantiles_mode mode)
+{
+    using T      = typename TestFixture::key_type;
+    using Config = typename TestFixture::config;
+    using codec  = rocprim::radix_key_codec<T>;
+
+    const bool  debug_synchronous = TestFixture::debug_synchronous;
+    hipStream_t stream            = 0; // default
+
+    // Bits of the encoded keys that an approximate quantile has in common with the exact one
+    constexpr unsigned int key_bits         = sizeof(typename codec::bit_key_type) * 8;
+    constexpr unsigned int approximate_bits = key_bits < 16 ? key_bits : 16;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(auto size : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            const std::vector<T> keys = test_utils::get_random_data<T>(size,
+                                                                       TestFixture::min_key,
+                                                                       TestFixture::max_key,
+                                                                       seed_value);
+
+            // The extremes, the median, duplicates, quantiles outside [0, 1] (they are clamped)
+            // and random quantiles in no particular order
+            std::vector<double> quantiles = {0.5, 1.0, 0.0, 0.25, 0.25, 0.99, 0.01, -0.5, 1.5};
+            const std::vector<double> random_quantiles
+                = test_utils::get_random_data<double>(57, 0.0, 1.0, seed_value + 1);
+            quantiles.insert(quantiles.end(), random_quantiles.begin(), random_quantiles.end());
+            const unsigned int quantiles_count = quantiles.size();
+
+            // Calculate expected results on host
+            std::vector<T> sorted_keys(keys);
+            std::stable_sort(sorted_keys.begin(), sorted_keys.end());
+            std::vector<T> expected(quantiles_count);
+            if(size > 0)
+            {
+                for(unsigned int i = 0; i < quantiles_count; i++)
+                {
+                    const double q    = std::min(std::max(quantiles[i], 0.0), 1.0);
+                    const size_t rank = static_cast<size_t>(std::floor(q * (size - 1)));
+                    expected[i]       = sorted_keys[std::min(rank, size - 1)];
+                }
+            }
+
+            T*      d_keys;
+            double* d_quantiles;
+            T*      d_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys,
+                                                         std::max<size_t>(size, 1) * sizeof(T)));
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_quantiles, quantiles_count * sizeof(double)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, quantiles_count * sizeof(T)));
+            HIP_CHECK(hipMemcpy(d_keys, keys.data(), size * sizeof(T), hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_quantiles,
+                                quantiles.data(),
+                                quantiles_count * sizeof(double),
+                                hipMemcpyHostToDevice));
+
+            // temp storage
+            size_t temp_storage_size_bytes;
+            void*  d_temp_storage = nullptr;
+            // Get size of d_temp_storage
+            HIP_CHECK(rocprim::quantiles<Config>(d_temp_storage,
+                                                 temp_storage_size_bytes,
+                                                 d_keys,
+                                                 size,
+                                                 d_quantiles,
+                                                 quantiles_count,
+                                                 d_output,
+                                                 mode,
+                                                 stream,
+                                                 debug_synchronous));
+
+            // allocate temporary storage
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, temp_storage_size_bytes));
+
+            // Run
+            HIP_CHECK(rocprim::quantiles<Config>(d_temp_storage,
+                                                 temp_storage_size_bytes,
+                                                 d_keys,
+                                                 size,
+                                                 d_quantiles,
+                                                 quantiles_count,
+                                                 d_output,
+                                                 mode,
+                                                 stream,
+                                                 debug_synchronous));
+            HIP_CHECK(hipGetLastError());
+            HIP_CHECK(hipDeviceSynchronize());
+
+            if(size > 0)
+            {
+                std::vector<T> output(quantiles_count);
+                HIP_CHECK(hipMemcpy(output.data(),
+                                    d_output,
+                                    quantiles_count * sizeof(T),
+                                    hipMemcpyDeviceToHost));
+
+                if(mode == rocprim::quantiles_mode::exact)
+                {
+                    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+                }
+                else
+                {
+                    // The approximate quantile is the smallest key of the bucket of the exact one
+                    constexpr unsigned int shift = key_bits - approximate_bits;
+                    for(unsigned int i = 0; i < quantiles_count; i++)
+                    {
+                        SCOPED_TRACE(testing::Message() << "with quantile = " << quantiles[i]);
+                        const auto bucket = codec::encode(expected[i]) >> shift;
+                        ASSERT_EQ(codec::encode(output[i]) >> shift, bucket);
+                        ASSERT_EQ(codec::encode(output[i]), bucket << shift);
+                    }
+                }
+            }
+
+            HIP_CHECK(hipFree(d_keys));
+            HIP_CHECK(hipFree(d_quantiles));
+            HIP_CHECK(hipFree(d_output));
+            HIP_CHECK(hipFree(d_temp_storage));
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceQuantilesTests, Exact)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    testQuantiles<TestFixture>(rocprim::quantiles_mode::exact);
+}
+
+TYPED_TEST(RocprimDeviceQuantilesTests, Approximate)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    testQuantiles<TestFixture>(rocprim::quantiles_mode::approximate);
+}
+
+TEST(RocprimDeviceQuantilesLimitTests, TooManyQuantiles)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    // The refine passes would need more than 2^32 histogram bins
+    size_t temp_storage_size_bytes;
+    ASSERT_EQ(rocprim::quantiles(nullptr,
+                                 temp_storage_size_bytes,
+                                 static_cast<int*>(nullptr),
+                                 1000u,
+                                 static_cast<double*>(nullptr),
+                                 1u << 24,
+                                 static_cast<int*>(nullptr)),
+              hipErrorInvalidValue);
+}
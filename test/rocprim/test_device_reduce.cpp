@@ -32,6 +32,7 @@
 #include "test_utils_types.hpp"
 
 using bra = ::rocprim::block_reduce_algorithm;
+using glm = ::rocprim::grid_launch_mode;
 
 // Params for tests
 template<class InputType,
@@ -39,7 +40,8 @@ template<class InputType,
          bool   UseIdentityIterator = false,
          size_t SizeLimit           = ROCPRIM_GRID_SIZE_LIMIT,
          bra    Algo                = bra::default_algorithm,
-         bool   UseGraphs           = false>
+         bool   UseGraphs           = false,
+         glm    LaunchMode          = glm::default_mode>
 struct DeviceReduceParams
 {
     static constexpr bra algo = Algo;
@@ -49,6 +51,7 @@ struct DeviceReduceParams
     static constexpr bool use_identity_iterator = UseIdentityIterator;
     static constexpr size_t size_limit = SizeLimit;
     static constexpr bool use_graphs = UseGraphs;
+    static constexpr glm launch_mode = LaunchMode;
 };
 
 // clang-format off
@@ -58,10 +61,10 @@ struct DeviceReduceParams
     DeviceReduceParams<__VA_ARGS__, bra::raking_reduce_commutative_only>
 // clang-format on
 
-template<unsigned int SizeLimit, bra algo = bra::default_algorithm>
+template<unsigned int SizeLimit, glm LaunchMode = glm::default_mode>
 struct size_limit_config
 {
-    using type = rocprim::reduce_config<256, 16, algo, SizeLimit>;
+    using type = rocprim::reduce_config<256, 16, bra::default_algorithm, SizeLimit, LaunchMode>;
 };
 
 template <>
@@ -69,8 +72,8 @@ struct size_limit_config<ROCPRIM_GRID_SIZE_LIMIT> {
     using type = rocprim::default_config;
 };
 
-template <unsigned int SizeLimit>
-using size_limit_config_t = typename size_limit_config<SizeLimit>::type;
+template<unsigned int SizeLimit, glm LaunchMode = glm::default_mode>
+using size_limit_config_t = typename size_limit_config<SizeLimit, LaunchMode>::type;
 
 // ---------------------------------------------------------
 // Test for reduce ops taking single input value
@@ -86,6 +89,7 @@ public:
     static constexpr bool use_identity_iterator = Params::use_identity_iterator;
     static constexpr size_t size_limit = Params::size_limit;
     const bool use_graphs = Params::use_graphs;
+    static constexpr glm launch_mode = Params::launch_mode;
 };
 
 template<class Params>
@@ -108,7 +112,11 @@ typedef ::testing::Types<
     DeviceReduceParams<rocprim::bfloat16, rocprim::bfloat16>,
     DeviceReduceParams<test_utils::custom_test_type<float>, test_utils::custom_test_type<float>>,
     DeviceReduceParams<test_utils::custom_test_type<int>, test_utils::custom_test_type<float>>,
-    DeviceReduceParams<int, int, false, ROCPRIM_GRID_SIZE_LIMIT, bra::default_algorithm, true>>
+    DeviceReduceParams<int, int, false, ROCPRIM_GRID_SIZE_LIMIT, bra::default_algorithm, true>,
+    DeviceReduceParams<int, int, false, ROCPRIM_GRID_SIZE_LIMIT, bra::default_algorithm, false,
+                       glm::persistent>,
+    DeviceReduceParams<double, double, false, 4096, bra::default_algorithm, false,
+                       glm::persistent>>
     RocprimDeviceReduceTestsParams;
 
 typedef ::testing::Types<DeviceReduceParams<double, double>,
@@ -129,7 +137,7 @@ TYPED_TEST(RocprimDeviceReduceTests, ReduceEmptyInput)
     using T = typename TestFixture::input_type;
     using U = typename TestFixture::output_type;
     const bool debug_synchronous = TestFixture::debug_synchronous;
-    using Config = size_limit_config_t<TestFixture::size_limit>;
+    using Config = size_limit_config_t<TestFixture::size_limit, TestFixture::launch_mode>;
 
     hipStream_t stream = 0; // default stream
     if (TestFixture::use_graphs)
@@ -214,7 +222,7 @@ TYPED_TEST(RocprimDeviceReduceTests, ReduceSum)
 
     const bool debug_synchronous = TestFixture::debug_synchronous;
     static constexpr bool use_identity_iterator = TestFixture::use_identity_iterator;
-    using Config = size_limit_config_t<TestFixture::size_limit>;
+    using Config = size_limit_config_t<TestFixture::size_limit, TestFixture::launch_mode>;
 
     for (size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
     {
@@ -368,7 +376,7 @@ TYPED_TEST(RocprimDeviceReduceTests, ReduceArgMinimum)
     using key_value = rocprim::key_value_pair<int, T>;
     const bool debug_synchronous = TestFixture::debug_synchronous;
     static constexpr bool use_identity_iterator = TestFixture::use_identity_iterator;
-    using Config = size_limit_config_t<TestFixture::size_limit>;
+    using Config = size_limit_config_t<TestFixture::size_limit, TestFixture::launch_mode>;
 
     for (size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
     {
@@ -613,7 +621,7 @@ TYPED_TEST(RocprimDeviceReducePrecisionTests, ReduceSumInputEqualExponentFunctio
 
     const bool            debug_synchronous     = TestFixture::debug_synchronous;
     static constexpr bool use_identity_iterator = TestFixture::use_identity_iterator;
-    using Config                                = size_limit_config_t<TestFixture::size_limit>;
+    using Config                                = size_limit_config_t<TestFixture::size_limit, TestFixture::launch_mode>;
 
     for(auto size : test_utils::get_sizes(42))
     {
@@ -740,7 +748,7 @@ TYPED_TEST(RocprimDeviceReduceTests, ReduceMinimum)
     using binary_op_type = rocprim::minimum<U>;
 
     static constexpr bool use_identity_iterator = TestFixture::use_identity_iterator;
-    using Config = size_limit_config_t<TestFixture::size_limit>;
+    using Config = size_limit_config_t<TestFixture::size_limit, TestFixture::launch_mode>;
 
     for (size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
     {
@@ -0,0 +1,241 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "../common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_run_length_decode.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// Params for tests
+template<class ValueType,
+         class LengthType = unsigned int,
+         class Config     = rocprim::default_config,
+         int MaxLength    = 16>
+struct DeviceRunLengthDecodeParams
+{
+    using value_type                = ValueType;
+    using length_type               = LengthType;
+    using config                    = Config;
+    static constexpr int max_length = MaxLength;
+};
+
+template<class Params>
+class RocprimDeviceRunLengthDecodeTests : public ::testing::Test
+{
+public:
+    using value_type                        = typename Params::value_type;
+    using length_type                       = typename Params::length_type;
+    using config                            = typename Params::config;
+    static constexpr int  max_length        = Params::max_length;
+    static constexpr bool debug_synchronous = false;
+};
+
+typedef ::testing::Types<
+    DeviceRunLengthDecodeParams<int>,
+    DeviceRunLengthDecodeParams<unsigned char, int>,
+    DeviceRunLengthDecodeParams<float, unsigned char, rocprim::default_config, 1>,
+    DeviceRunLengthDecodeParams<double, unsigned short, rocprim::default_config, 100>,
+    DeviceRunLengthDecodeParams<test_utils::custom_test_type<int>, unsigned int>,
+    DeviceRunLengthDecodeParams<int, unsigned int, rocprim::run_length_decode_config<64, 1>>,
+    DeviceRunLengthDecodeParams<int, unsigned int, rocprim::run_length_decode_config<128, 7>>,
+    DeviceRunLengthDecodeParams<long long,
+                                unsigned long long,
+                                rocprim::run_length_decode_config<512, 4>,
+                                3>>
+    RocprimDeviceRunLengthDecodeTestsParams;
+
+TYPED_TEST_SUITE(RocprimDeviceRunLengthDecodeTests, RocprimDeviceRunLengthDecodeTestsParams);
+
+template<class TestFixture>
+void testRunLengthDecode(const std::vector<typename TestFixture::length_type>& run_lengths,
+                         const unsigned int                                    seed_value)
+{
+    using T      = typename TestFixture::value_type;
+    using L      = typename TestFixture::length_type;
+    using Config = typename TestFixture::config;
+
+    const bool   debug_synchronous = TestFixture::debug_synchronous;
+    hipStream_t  stream            = 0; // default
+    const size_t num_runs          = run_lengths.size();
+
+    const std::vector<T> values = test_utils::get_random_data<T>(num_runs, 0, 100, seed_value);
+
+    // Calculate expected results on host
+    std::vector<T> expected;
+    std::vector<L> expected_relative_offsets;
+    for(size_t i = 0; i < num_runs; i++)
+    {
+        for(L offset = 0; offset < run_lengths[i]; offset++)
+        {
+            expected.push_back(values[i]);
+            expected_relative_offsets.push_back(offset);
+        }
+    }
+    const size_t output_size = expected.size();
+
+    T* d_values;
+    L* d_run_lengths;
+    T* d_output;
+    L* d_relative_offsets;
+    HIP_CHECK(
+        test_common_utils::hipMallocHelper(&d_values, std::max<size_t>(num_runs, 1) * sizeof(T)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_run_lengths,
+                                                 std::max<size_t>(num_runs, 1) * sizeof(L)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_output,
+                                                 std::max<size_t>(output_size, 1) * sizeof(T)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_relative_offsets,
+                                                 std::max<size_t>(output_size, 1) * sizeof(L)));
+    HIP_CHECK(hipMemcpy(d_values, values.data(), num_runs * sizeof(T), hipMemcpyHostToDevice));
+    HIP_CHECK(hipMemcpy(d_run_lengths,
+                        run_lengths.data(),
+                        num_runs * sizeof(L),
+                        hipMemcpyHostToDevice));
+
+    // temp storage
+    size_t temp_storage_size_bytes;
+    void*  d_temp_storage = nullptr;
+    // Get size of d_temp_storage
+    HIP_CHECK(rocprim::run_length_decode<Config>(d_temp_storage,
+                                                 temp_storage_size_bytes,
+                                                 d_values,
+                                                 d_run_lengths,
+                                                 num_runs,
+                                                 d_output,
+                                                 d_relative_offsets,
+                                                 stream,
+                                                 debug_synchronous));
+
+    // allocate temporary storage
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, temp_storage_size_bytes));
+
+    // Run with relative offsets
+    HIP_CHECK(rocprim::run_length_decode<Config>(d_temp_storage,
+                                                 temp_storage_size_bytes,
+                                                 d_values,
+                                                 d_run_lengths,
+                                                 num_runs,
+                                                 d_output,
+                                                 d_relative_offsets,
+                                                 stream,
+                                                 debug_synchronous));
+    HIP_CHECK(hipGetLastError());
+    HIP_CHECK(hipDeviceSynchronize());
+
+    std::vector<T> output(output_size);
+    std::vector<L> relative_offsets(output_size);
+    HIP_CHECK(hipMemcpy(output.data(), d_output, output_size * sizeof(T), hipMemcpyDeviceToHost));
+    HIP_CHECK(hipMemcpy(relative_offsets.data(),
+                        d_relative_offsets,
+                        output_size * sizeof(L),
+                        hipMemcpyDeviceToHost));
+
+    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(relative_offsets, expected_relative_offsets));
+
+    // Run without relative offsets
+    HIP_CHECK(hipMemset(d_output, 0, output_size * sizeof(T)));
+    HIP_CHECK(rocprim::run_length_decode<Config>(d_temp_storage,
+                                                 temp_storage_size_bytes,
+                                                 d_values,
+                                                 d_run_lengths,
+                                                 num_runs,
+                                                 d_output,
+                                                 stream,
+                                                 debug_synchronous));
+    HIP_CHECK(hipGetLastError());
+    HIP_CHECK(hipDeviceSynchronize());
+
+    HIP_CHECK(hipMemcpy(output.data(), d_output, output_size * sizeof(T), hipMemcpyDeviceToHost));
+
+    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+
+    HIP_CHECK(hipFree(d_values));
+    HIP_CHECK(hipFree(d_run_lengths));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_relative_offsets));
+    HIP_CHECK(hipFree(d_temp_storage));
+}
+
+TYPED_TEST(RocprimDeviceRunLengthDecodeTests, Decode)
+{
+    using L = typename TestFixture::length_type;
+
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(auto num_runs : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with num_runs = " << num_runs);
+
+            // Lengths include zeros, so some runs do not produce any item
+            const std::vector<L> run_lengths
+                = test_utils::get_random_data<L>(num_runs, 0, TestFixture::max_length, seed_value);
+            testRunLengthDecode<TestFixture>(run_lengths, seed_value);
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceRunLengthDecodeTests, DecodeSkewed)
+{
+    using L = typename TestFixture::length_type;
+
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(size_t num_runs : {1, 10, 1000, 100000})
+        {
+            SCOPED_TRACE(testing::Message() << "with num_runs = " << num_runs);
+
+            // Mostly empty runs and a few long runs, so that a single run spans multiple blocks
+            // and a tile may only contain empty runs
+            std::vector<L>            run_lengths(num_runs, L(0));
+            const std::vector<size_t> positions
+                = test_utils::get_random_data<size_t>(3, 0, num_runs - 1, seed_value);
+            for(const size_t position : positions)
+            {
+                run_lengths[position]
+                    = static_cast<L>(std::min<long long>(std::numeric_limits<L>::max(), 5000));
+            }
+            testRunLengthDecode<TestFixture>(run_lengths, seed_value);
+        }
+    }
+}
@@ -63,6 +63,50 @@ struct size_limit_config_helper
                              SizeLimit>>;
 };
 
+// Scan-by-key has no device scan algorithm option, so it uses its default config
+template<rocprim::device_scan_algorithm ScanAlgorithm,
+         unsigned int                   SizeLimit = ROCPRIM_GRID_SIZE_LIMIT>
+struct scan_algorithm_config_helper
+{
+    template<bool ByKey>
+    using type = std::conditional_t<
+        ByKey,
+        ::rocprim::default_config,
+        rocprim::scan_config<256,
+                             16,
+                             rocprim::block_load_method::block_load_transpose,
+                             rocprim::block_store_method::block_store_transpose,
+                             rocprim::block_scan_algorithm::using_warp_scan,
+                             SizeLimit,
+                             ScanAlgorithm>>;
+};
+
+// Look-back scan launched as a persistent grid, scan-by-key uses its default config
+template<unsigned int SizeLimit = ROCPRIM_GRID_SIZE_LIMIT>
+struct persistent_config_helper
+{
+    template<bool ByKey>
+    using type = std::conditional_t<
+        ByKey,
+        ::rocprim::default_config,
+        rocprim::scan_config<256,
+                             16,
+                             rocprim::block_load_method::block_load_transpose,
+                             rocprim::block_store_method::block_store_transpose,
+                             rocprim::block_scan_algorithm::using_warp_scan,
+                             SizeLimit,
+                             rocprim::device_scan_algorithm::lookback,
+                             rocprim::grid_launch_mode::persistent>>;
+};
+
+template<unsigned int SizeLimit = ROCPRIM_GRID_SIZE_LIMIT>
+using reduce_then_scan_config_helper
+    = scan_algorithm_config_helper<rocprim::device_scan_algorithm::reduce_then_scan, SizeLimit>;
+
+template<unsigned int SizeLimit = ROCPRIM_GRID_SIZE_LIMIT>
+using lookback_tagged_config_helper
+    = scan_algorithm_config_helper<rocprim::device_scan_algorithm::lookback_tagged, SizeLimit>;
+
 // Params for tests
 template<class InputType,
          class OutputType = InputType,
@@ -133,8 +177,47 @@ typedef ::testing::Types<
     DeviceScanParams<test_utils::custom_test_type<int>>,
     DeviceScanParams<test_utils::custom_test_array_type<long long, 5>>,
     DeviceScanParams<test_utils::custom_test_array_type<int, 10>>,
+    // Reduce-then-scan
+    DeviceScanParams<int, int, rocprim::plus<int>, false, reduce_then_scan_config_helper<>>,
+    DeviceScanParams<int, int, rocprim::plus<int>, false, reduce_then_scan_config_helper<4096>>,
+    DeviceScanParams<float, float, rocprim::maximum<float>, false, reduce_then_scan_config_helper<>>,
+    DeviceScanParams<int, double, rocprim::plus<double>, true, reduce_then_scan_config_helper<>>,
+    DeviceScanParams<test_utils::custom_test_type<double>,
+                     test_utils::custom_test_type<double>,
+                     rocprim::plus<test_utils::custom_test_type<double>>,
+                     false,
+                     reduce_then_scan_config_helper<8192>>,
+    // Look-back with tagged prefixes
+    DeviceScanParams<int, int, rocprim::plus<int>, false, lookback_tagged_config_helper<>>,
+    DeviceScanParams<int, long long, rocprim::plus<long long>, false, lookback_tagged_config_helper<>>,
+    DeviceScanParams<double, double, rocprim::plus<double>, true, lookback_tagged_config_helper<8192>>,
+    DeviceScanParams<test_utils::custom_test_type<float>,
+                     test_utils::custom_test_type<float>,
+                     rocprim::plus<test_utils::custom_test_type<float>>,
+                     false,
+                     lookback_tagged_config_helper<>>,
+    DeviceScanParams<test_utils::custom_test_array_type<int, 3>,
+                     test_utils::custom_test_array_type<int, 3>,
+                     rocprim::plus<test_utils::custom_test_array_type<int, 3>>,
+                     false,
+                     lookback_tagged_config_helper<>>,
+    DeviceScanParams<test_utils::custom_test_type<double>,
+                     test_utils::custom_test_type<double>,
+                     rocprim::plus<test_utils::custom_test_type<double>>,
+                     false,
+                     lookback_tagged_config_helper<>>,
+    // Persistent grid
+    DeviceScanParams<int, int, rocprim::plus<int>, false, persistent_config_helper<>>,
+    DeviceScanParams<float, double, rocprim::plus<double>, true, persistent_config_helper<>>,
+    DeviceScanParams<int, long long, rocprim::plus<long long>, false, persistent_config_helper<4096>>,
+    DeviceScanParams<test_utils::custom_test_type<double>,
+                     test_utils::custom_test_type<double>,
+                     rocprim::plus<test_utils::custom_test_type<double>>,
+                     false,
+                     persistent_config_helper<>>,
     // With graphs
-    DeviceScanParams<int, int, rocprim::plus<int>, false, default_config_helper, true>>
+    DeviceScanParams<int, int, rocprim::plus<int>, false, default_config_helper, true>,
+    DeviceScanParams<int, int, rocprim::plus<int>, false, reduce_then_scan_config_helper<>, true>>
     RocprimDeviceScanTestsParams;
 
 // use float for accumulation of bfloat16 and half inputs if operator is plus
@@ -1743,3 +1826,360 @@ TYPED_TEST(RocprimDeviceScanFutureTests, ExclusiveScan)
         }
     }
 }
+
+// ---------------------------------------------------------
+// Test for scans continued with scan_state
+// ---------------------------------------------------------
+
+using RocprimDeviceScanStateTestsParams = ::testing::Types<
+    DeviceScanParams<int>,
+    DeviceScanParams<unsigned int, unsigned long long>,
+    DeviceScanParams<int, int, rocprim::maximum<int>>,
+    DeviceScanParams<int, int, rocprim::plus<int>, false, size_limit_config_helper<8192>>,
+    DeviceScanParams<long long, long long, rocprim::plus<long long>, false, size_limit_config_helper<8192>>,
+    DeviceScanParams<int, int, rocprim::plus<int>, false, reduce_then_scan_config_helper<8192>>,
+    DeviceScanParams<double, double, rocprim::plus<double>, false, lookback_tagged_config_helper<>>>;
+
+template<typename Params>
+class RocprimDeviceScanStateTests : public RocprimDeviceScanTests<Params>
+{};
+
+TYPED_TEST_SUITE(RocprimDeviceScanStateTests, RocprimDeviceScanStateTestsParams);
+
+// Splits [0, size) into chunks of random sizes, including empty ones
+inline std::vector<size_t> get_chunk_offsets(const size_t size, const unsigned int seed_value)
+{
+    std::vector<size_t> offsets{0};
+    const size_t        max_chunk_size = std::max<size_t>(size / 3, 1);
+    while(offsets.back() < size)
+    {
+        const size_t chunk_size
+            = test_utils::get_random_value<size_t>(0, max_chunk_size, seed_value + offsets.size());
+        offsets.push_back(std::min(size, offsets.back() + chunk_size));
+    }
+    return offsets;
+}
+
+// Calls the scan of the tested kind that continues from state
+template<bool Exclusive, bool ByKey>
+struct scan_state_runner;
+
+template<>
+struct scan_state_runner<false, false>
+{
+    template<class K, class T>
+    using state_type = rocprim::scan_state<T>;
+
+    template<class Config, class K, class InputIterator, class U, class T, class ScanOp>
+    static hipError_t run(void*                d_temp_storage,
+                          size_t&              temp_storage_size_bytes,
+                          const K*             /*d_keys*/,
+                          InputIterator        input,
+                          U*                   d_output,
+                          T                    /*initial_value*/,
+                          size_t               size,
+                          state_type<K, T>&    state,
+                          ScanOp               scan_op,
+                          rocprim::equal_to<K> /*keys_compare_op*/,
+                          hipStream_t          stream,
+                          bool                 debug_synchronous)
+    {
+        return rocprim::inclusive_scan<Config>(d_temp_storage,
+                                               temp_storage_size_bytes,
+                                               input,
+                                               d_output,
+                                               size,
+                                               state,
+                                               scan_op,
+                                               stream,
+                                               debug_synchronous);
+    }
+};
+
+template<>
+struct scan_state_runner<true, false>
+{
+    template<class K, class T>
+    using state_type = rocprim::scan_state<T>;
+
+    template<class Config, class K, class InputIterator, class U, class T, class ScanOp>
+    static hipError_t run(void*                d_temp_storage,
+                          size_t&              temp_storage_size_bytes,
+                          const K*             /*d_keys*/,
+                          InputIterator        input,
+                          U*                   d_output,
+                          T                    initial_value,
+                          size_t               size,
+                          state_type<K, T>&    state,
+                          ScanOp               scan_op,
+                          rocprim::equal_to<K> /*keys_compare_op*/,
+                          hipStream_t          stream,
+                          bool                 debug_synchronous)
+    {
+        return rocprim::exclusive_scan<Config>(d_temp_storage,
+                                               temp_storage_size_bytes,
+                                               input,
+                                               d_output,
+                                               initial_value,
+                                               size,
+                                               state,
+                                               scan_op,
+                                               stream,
+                                               debug_synchronous);
+    }
+};
+
+template<>
+struct scan_state_runner<false, true>
+{
+    template<class K, class T>
+    using state_type = rocprim::scan_by_key_state<K, T>;
+
+    template<class Config, class K, class InputIterator, class U, class T, class ScanOp>
+    static hipError_t run(void*                d_temp_storage,
+                          size_t&              temp_storage_size_bytes,
+                          const K*             d_keys,
+                          InputIterator        input,
+                          U*                   d_output,
+                          T                    /*initial_value*/,
+                          size_t               size,
+                          state_type<K, T>&    state,
+                          ScanOp               scan_op,
+                          rocprim::equal_to<K> keys_compare_op,
+                          hipStream_t          stream,
+                          bool                 debug_synchronous)
+    {
+        return rocprim::inclusive_scan_by_key<Config>(d_temp_storage,
+                                                      temp_storage_size_bytes,
+                                                      d_keys,
+                                                      input,
+                                                      d_output,
+                                                      size,
+                                                      state,
+                                                      scan_op,
+                                                      keys_compare_op,
+                                                      stream,
+                                                      debug_synchronous);
+    }
+};
+
+template<>
+struct scan_state_runner<true, true>
+{
+    template<class K, class T>
+    using state_type = rocprim::scan_by_key_state<K, T>;
+
+    template<class Config, class K, class InputIterator, class U, class T, class ScanOp>
+    static hipError_t run(void*                d_temp_storage,
+                          size_t&              temp_storage_size_bytes,
+                          const K*             d_keys,
+                          InputIterator        input,
+                          U*                   d_output,
+                          T                    initial_value,
+                          size_t               size,
+                          state_type<K, T>&    state,
+                          ScanOp               scan_op,
+                          rocprim::equal_to<K> keys_compare_op,
+                          hipStream_t          stream,
+                          bool                 debug_synchronous)
+    {
+        return rocprim::exclusive_scan_by_key<Config>(d_temp_storage,
+                                                      temp_storage_size_bytes,
+                                                      d_keys,
+                                                      input,
+                                                      d_output,
+                                                      initial_value,
+                                                      size,
+                                                      state,
+                                                      scan_op,
+                                                      keys_compare_op,
+                                                      stream,
+                                                      debug_synchronous);
+    }
+};
+
+template<bool Exclusive, bool ByKey, typename TestFixture>
+void testScanState()
+{
+    using T        = typename TestFixture::input_type;
+    using U        = typename TestFixture::output_type;
+    using K        = unsigned int;
+    using acc_type = U;
+
+    using scan_op_type = typename TestFixture::scan_op_type;
+    using Config       = typename TestFixture::config_helper::template type<ByKey>;
+    using runner       = scan_state_runner<Exclusive, ByKey>;
+    using state_type   = typename runner::template state_type<K, acc_type>;
+
+    const bool debug_synchronous = false;
+
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(auto size : test_utils::get_sizes(seed_value))
+        {
+            if(size == 0)
+            {
+                continue;
+            }
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+            hipStream_t stream = 0; // default
+
+            // Generate data, the values are small so that the sums are exact
+            const acc_type initial_value = test_utils::get_random_value<acc_type>(1, 10, seed_value);
+            std::vector<T> input         = test_utils::get_random_data<T>(size, 0, 9, seed_value);
+            std::vector<K> keys          = test_utils::get_random_data<K>(size, 0, 16, seed_value);
+            // Long segments to have segments that span multiple chunks
+            std::sort(keys.begin(), keys.end());
+            std::vector<U> output(size);
+
+            // Calculate expected results on host
+            scan_op_type         scan_op;
+            rocprim::equal_to<K> keys_compare_op;
+            std::vector<U>       expected(size);
+            if(ByKey && Exclusive)
+            {
+                test_utils::host_exclusive_scan_by_key(input.begin(),
+                                                       input.end(),
+                                                       keys.begin(),
+                                                       initial_value,
+                                                       expected.begin(),
+                                                       scan_op,
+                                                       keys_compare_op);
+            }
+            else if(ByKey)
+            {
+                test_utils::host_inclusive_scan_by_key(input.begin(),
+                                                       input.end(),
+                                                       keys.begin(),
+                                                       expected.begin(),
+                                                       scan_op,
+                                                       keys_compare_op);
+            }
+            else if(Exclusive)
+            {
+                test_utils::host_exclusive_scan(input.begin(),
+                                                input.end(),
+                                                initial_value,
+                                                expected.begin(),
+                                                scan_op);
+            }
+            else
+            {
+                test_utils::host_inclusive_scan(input.begin(),
+                                                input.end(),
+                                                expected.begin(),
+                                                scan_op);
+            }
+
+            T* d_input;
+            K* d_keys;
+            U* d_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(T)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys, size * sizeof(K)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, size * sizeof(U)));
+            HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_keys, keys.data(), size * sizeof(K), hipMemcpyHostToDevice));
+
+            void* d_state_storage;
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_state_storage, state_type::storage_size));
+            state_type state(d_state_storage);
+
+            const auto input_iterator
+                = rocprim::make_transform_iterator(d_input,
+                                                   [](T in) { return static_cast<acc_type>(in); });
+
+            const std::vector<size_t> offsets = get_chunk_offsets(size, seed_value);
+
+            // The largest chunk requires the largest temporary storage
+            size_t max_chunk_size = 0;
+            for(size_t i = 0; i + 1 < offsets.size(); i++)
+            {
+                max_chunk_size = std::max(max_chunk_size, offsets[i + 1] - offsets[i]);
+            }
+            size_t temp_storage_size_bytes;
+            void*  d_temp_storage = nullptr;
+            HIP_CHECK(runner::template run<Config>(d_temp_storage,
+                                                   temp_storage_size_bytes,
+                                                   d_keys,
+                                                   input_iterator,
+                                                   d_output,
+                                                   initial_value,
+                                                   max_chunk_size,
+                                                   state,
+                                                   scan_op,
+                                                   keys_compare_op,
+                                                   stream,
+                                                   debug_synchronous));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, temp_storage_size_bytes));
+
+            // Run
+            for(size_t i = 0; i + 1 < offsets.size(); i++)
+            {
+                HIP_CHECK(runner::template run<Config>(d_temp_storage,
+                                                       temp_storage_size_bytes,
+                                                       d_keys + offsets[i],
+                                                       input_iterator + offsets[i],
+                                                       d_output + offsets[i],
+                                                       initial_value,
+                                                       offsets[i + 1] - offsets[i],
+                                                       state,
+                                                       scan_op,
+                                                       keys_compare_op,
+                                                       stream,
+                                                       debug_synchronous));
+            }
+            ASSERT_TRUE(state.has_carry());
+            HIP_CHECK(hipGetLastError());
+            HIP_CHECK(hipDeviceSynchronize());
+
+            // Copy output to host
+            HIP_CHECK(hipMemcpy(output.data(), d_output, size * sizeof(U), hipMemcpyDeviceToHost));
+
+            // Check if output values are as expected
+            ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+
+            // The carry is the inclusive value of the last item
+            acc_type carry;
+            HIP_CHECK(hipMemcpy(&carry, state.carry(), sizeof(acc_type), hipMemcpyDeviceToHost));
+            const acc_type expected_carry
+                = Exclusive ? scan_op(expected.back(), static_cast<acc_type>(input.back()))
+                            : expected.back();
+            ASSERT_EQ(carry, expected_carry);
+
+            hipFree(d_input);
+            hipFree(d_keys);
+            hipFree(d_output);
+            hipFree(d_temp_storage);
+            hipFree(d_state_storage);
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceScanStateTests, InclusiveScan)
+{
+    testScanState<false, false, TestFixture>();
+}
+
+TYPED_TEST(RocprimDeviceScanStateTests, ExclusiveScan)
+{
+    testScanState<true, false, TestFixture>();
+}
+
+TYPED_TEST(RocprimDeviceScanStateTests, InclusiveScanByKey)
+{
+    testScanState<false, true, TestFixture>();
+}
+
+TYPED_TEST(RocprimDeviceScanStateTests, ExclusiveScanByKey)
+{
+    testScanState<true, true, TestFixture>();
+}
@@ -0,0 +1,493 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_segmented_merge_sort.hpp>
+#include <rocprim/functional.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+template<class KeyType,
+         class ValueType,
+         class CompareFunction,
+         unsigned int MinSegmentLength,
+         unsigned int MaxSegmentLength,
+         class Config = rocprim::default_config>
+struct DeviceSegmentedMergeSortParams
+{
+    using key_type                                   = KeyType;
+    using value_type                                 = ValueType;
+    using compare_function                           = CompareFunction;
+    static constexpr unsigned int min_segment_length = MinSegmentLength;
+    static constexpr unsigned int max_segment_length = MaxSegmentLength;
+    using config                                     = Config;
+};
+
+template<class Params>
+class RocprimDeviceSegmentedMergeSortTests : public ::testing::Test
+{
+public:
+    using params = Params;
+};
+
+// Small tiles and low partitioning and large segment thresholds, so that every path (warp sort,
+// block sort, merging of tiles with many passes, device-wide merge sort) is used even for small
+// inputs
+using custom_config = rocprim::segmented_merge_sort_config<64, 2, 16, 2, 64, 4, 2048>;
+
+using RocprimDeviceSegmentedMergeSortTestsParams = ::testing::Types<
+    DeviceSegmentedMergeSortParams<int, int, rocprim::less<int>, 0, 100>,
+    DeviceSegmentedMergeSortParams<short, double, rocprim::greater<short>, 1, 1000>,
+    DeviceSegmentedMergeSortParams<float, int, rocprim::less<float>, 0, 10000>,
+    DeviceSegmentedMergeSortParams<test_utils::custom_test_type<int>,
+                                   int,
+                                   rocprim::less<test_utils::custom_test_type<int>>,
+                                   100,
+                                   3000>,
+    DeviceSegmentedMergeSortParams<rocprim::half, int, rocprim::less<rocprim::half>, 0, 5000>,
+    DeviceSegmentedMergeSortParams<int8_t, int, rocprim::less<int8_t>, 1000, 40000, custom_config>,
+    DeviceSegmentedMergeSortParams<long long,
+                                   test_utils::custom_test_type<double>,
+                                   rocprim::greater<long long>,
+                                   0,
+                                   300,
+                                   custom_config>>;
+
+TYPED_TEST_SUITE(RocprimDeviceSegmentedMergeSortTests, RocprimDeviceSegmentedMergeSortTestsParams);
+
+TYPED_TEST(RocprimDeviceSegmentedMergeSortTests, SortKeys)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type         = typename TestFixture::params::key_type;
+    using compare_function = typename TestFixture::params::compare_function;
+    using config           = typename TestFixture::params::config;
+
+    using offset_type = unsigned int;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    std::random_device         rd;
+    std::default_random_engine gen(rd());
+
+    std::uniform_int_distribution<size_t> segment_length_dis(
+        TestFixture::params::min_segment_length,
+        TestFixture::params::max_segment_length);
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(size_t size : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            // Generate data, the narrow range of keys produces many equivalent keys
+            std::vector<key_type> keys_input
+                = test_utils::get_random_data<key_type>(size, -100, 100, seed_value);
+
+            std::vector<offset_type> offsets;
+            unsigned int             segments_count = 0;
+            size_t                   offset         = 0;
+            while(offset < size)
+            {
+                const size_t segment_length = segment_length_dis(gen);
+                offsets.push_back(offset);
+                segments_count++;
+                offset += segment_length;
+            }
+            offsets.push_back(size);
+
+            key_type* d_keys_input;
+            key_type* d_keys_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_input, size * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_output, size * sizeof(key_type)));
+            HIP_CHECK(hipMemcpy(d_keys_input,
+                                keys_input.data(),
+                                size * sizeof(key_type),
+                                hipMemcpyHostToDevice));
+
+            offset_type* d_offsets;
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_offsets,
+                                                   (segments_count + 1) * sizeof(offset_type)));
+            HIP_CHECK(hipMemcpy(d_offsets,
+                                offsets.data(),
+                                (segments_count + 1) * sizeof(offset_type),
+                                hipMemcpyHostToDevice));
+
+            compare_function compare_op;
+
+            // Calculate expected results on host
+            std::vector<key_type> expected(keys_input);
+            for(size_t i = 0; i < segments_count; i++)
+            {
+                std::stable_sort(expected.begin() + offsets[i],
+                                 expected.begin() + offsets[i + 1],
+                                 compare_op);
+            }
+
+            size_t temporary_storage_bytes = 0;
+            HIP_CHECK(rocprim::segmented_merge_sort_keys<config>(nullptr,
+                                                                 temporary_storage_bytes,
+                                                                 d_keys_input,
+                                                                 d_keys_output,
+                                                                 size,
+                                                                 segments_count,
+                                                                 d_offsets,
+                                                                 d_offsets + 1,
+                                                                 compare_op));
+
+            ASSERT_GT(temporary_storage_bytes, 0U);
+
+            void* d_temporary_storage;
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+
+            HIP_CHECK(rocprim::segmented_merge_sort_keys<config>(d_temporary_storage,
+                                                                 temporary_storage_bytes,
+                                                                 d_keys_input,
+                                                                 d_keys_output,
+                                                                 size,
+                                                                 segments_count,
+                                                                 d_offsets,
+                                                                 d_offsets + 1,
+                                                                 compare_op,
+                                                                 stream,
+                                                                 debug_synchronous));
+
+            std::vector<key_type> keys_output(size);
+            HIP_CHECK(hipMemcpy(keys_output.data(),
+                                d_keys_output,
+                                size * sizeof(key_type),
+                                hipMemcpyDeviceToHost));
+
+            HIP_CHECK(hipFree(d_temporary_storage));
+            HIP_CHECK(hipFree(d_keys_input));
+            HIP_CHECK(hipFree(d_keys_output));
+            HIP_CHECK(hipFree(d_offsets));
+
+            ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(keys_output, expected));
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceSegmentedMergeSortTests, SortPairs)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type         = typename TestFixture::params::key_type;
+    using value_type       = typename TestFixture::params::value_type;
+    using compare_function = typename TestFixture::params::compare_function;
+    using config           = typename TestFixture::params::config;
+
+    using offset_type = unsigned int;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    std::random_device         rd;
+    std::default_random_engine gen(rd());
+
+    std::uniform_int_distribution<size_t> segment_length_dis(
+        TestFixture::params::min_segment_length,
+        TestFixture::params::max_segment_length);
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(size_t size : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            // Generate data, the values are the input positions to check the stability
+            std::vector<key_type> keys_input
+                = test_utils::get_random_data<key_type>(size, -100, 100, seed_value);
+
+            std::vector<value_type> values_input(size);
+            test_utils::iota(values_input.begin(), values_input.end(), 0);
+
+            std::vector<offset_type> offsets;
+            unsigned int             segments_count = 0;
+            size_t                   offset         = 0;
+            while(offset < size)
+            {
+                const size_t segment_length = segment_length_dis(gen);
+                offsets.push_back(offset);
+                segments_count++;
+                offset += segment_length;
+            }
+            offsets.push_back(size);
+
+            key_type*   d_keys_input;
+            key_type*   d_keys_output;
+            value_type* d_values_input;
+            value_type* d_values_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_input, size * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_output, size * sizeof(key_type)));
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_values_input, size * sizeof(value_type)));
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_values_output, size * sizeof(value_type)));
+            HIP_CHECK(hipMemcpy(d_keys_input,
+                                keys_input.data(),
+                                size * sizeof(key_type),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_values_input,
+                                values_input.data(),
+                                size * sizeof(value_type),
+                                hipMemcpyHostToDevice));
+
+            offset_type* d_offsets;
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_offsets,
+                                                   (segments_count + 1) * sizeof(offset_type)));
+            HIP_CHECK(hipMemcpy(d_offsets,
+                                offsets.data(),
+                                (segments_count + 1) * sizeof(offset_type),
+                                hipMemcpyHostToDevice));
+
+            compare_function compare_op;
+
+            // Calculate expected results on host
+            using key_value = std::pair<key_type, value_type>;
+            std::vector<key_value> expected(size);
+            for(size_t i = 0; i < size; i++)
+            {
+                expected[i] = key_value(keys_input[i], values_input[i]);
+            }
+            for(size_t i = 0; i < segments_count; i++)
+            {
+                std::stable_sort(expected.begin() + offsets[i],
+                                 expected.begin() + offsets[i + 1],
+                                 [compare_op](const key_value& a, const key_value& b)
+                                 { return compare_op(a.first, b.first); });
+            }
+
+            std::vector<key_type>   keys_expected(size);
+            std::vector<value_type> values_expected(size);
+            for(size_t i = 0; i < size; i++)
+            {
+                keys_expected[i]   = expected[i].first;
+                values_expected[i] = expected[i].second;
+            }
+
+            size_t temporary_storage_bytes = 0;
+            HIP_CHECK(rocprim::segmented_merge_sort_pairs<config>(nullptr,
+                                                                  temporary_storage_bytes,
+                                                                  d_keys_input,
+                                                                  d_keys_output,
+                                                                  d_values_input,
+                                                                  d_values_output,
+                                                                  size,
+                                                                  segments_count,
+                                                                  d_offsets,
+                                                                  d_offsets + 1,
+                                                                  compare_op));
+
+            ASSERT_GT(temporary_storage_bytes, 0U);
+
+            void* d_temporary_storage;
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+
+            HIP_CHECK(rocprim::segmented_merge_sort_pairs<config>(d_temporary_storage,
+                                                                  temporary_storage_bytes,
+                                                                  d_keys_input,
+                                                                  d_keys_output,
+                                                                  d_values_input,
+                                                                  d_values_output,
+                                                                  size,
+                                                                  segments_count,
+                                                                  d_offsets,
+                                                                  d_offsets + 1,
+                                                                  compare_op,
+                                                                  stream,
+                                                                  debug_synchronous));
+
+            std::vector<key_type>   keys_output(size);
+            std::vector<value_type> values_output(size);
+            HIP_CHECK(hipMemcpy(keys_output.data(),
+                                d_keys_output,
+                                size * sizeof(key_type),
+                                hipMemcpyDeviceToHost));
+            HIP_CHECK(hipMemcpy(values_output.data(),
+                                d_values_output,
+                                size * sizeof(value_type),
+                                hipMemcpyDeviceToHost));
+
+            HIP_CHECK(hipFree(d_temporary_storage));
+            HIP_CHECK(hipFree(d_keys_input));
+            HIP_CHECK(hipFree(d_keys_output));
+            HIP_CHECK(hipFree(d_values_input));
+            HIP_CHECK(hipFree(d_values_output));
+            HIP_CHECK(hipFree(d_offsets));
+
+            ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(keys_output, keys_expected));
+            ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(values_output, values_expected));
+        }
+    }
+}
+
+// A single segment much larger than the large segment threshold between a few short ones, it is
+// sorted by the device-wide merge sort
+TEST(RocprimDeviceSegmentedMergeSortTests, SortPairsHugeSegment)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type    = int;
+    using value_type  = unsigned int;
+    using offset_type = unsigned int;
+
+    const offset_type              size    = (1 << 22) + 300;
+    const std::vector<offset_type> offsets = {0, 100, 100 + (1 << 22), size - 50, size};
+    const unsigned int             segments_count = offsets.size() - 1;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        // The narrow range of keys checks that the sort is stable
+        const std::vector<key_type> keys_input
+            = test_utils::get_random_data<key_type>(size, -1000, 1000, seed_value);
+        std::vector<value_type> values_input(size);
+        std::iota(values_input.begin(), values_input.end(), 0);
+
+        std::vector<std::pair<key_type, value_type>> expected(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            expected[i] = {keys_input[i], values_input[i]};
+        }
+        for(size_t i = 0; i < segments_count; i++)
+        {
+            std::stable_sort(expected.begin() + offsets[i],
+                             expected.begin() + offsets[i + 1],
+                             [](const std::pair<key_type, value_type>& a,
+                                const std::pair<key_type, value_type>& b)
+                             { return a.first < b.first; });
+        }
+
+        key_type*    d_keys_input;
+        key_type*    d_keys_output;
+        value_type*  d_values_input;
+        value_type*  d_values_output;
+        offset_type* d_offsets;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_input, size * sizeof(key_type)));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_output, size * sizeof(key_type)));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_values_input, size * sizeof(value_type)));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_values_output, size * sizeof(value_type)));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_offsets,
+                                                     offsets.size() * sizeof(offset_type)));
+        HIP_CHECK(hipMemcpy(d_keys_input,
+                            keys_input.data(),
+                            size * sizeof(key_type),
+                            hipMemcpyHostToDevice));
+        HIP_CHECK(hipMemcpy(d_values_input,
+                            values_input.data(),
+                            size * sizeof(value_type),
+                            hipMemcpyHostToDevice));
+        HIP_CHECK(hipMemcpy(d_offsets,
+                            offsets.data(),
+                            offsets.size() * sizeof(offset_type),
+                            hipMemcpyHostToDevice));
+
+        size_t temporary_storage_bytes = 0;
+        HIP_CHECK(rocprim::segmented_merge_sort_pairs(nullptr,
+                                                      temporary_storage_bytes,
+                                                      d_keys_input,
+                                                      d_keys_output,
+                                                      d_values_input,
+                                                      d_values_output,
+                                                      size,
+                                                      segments_count,
+                                                      d_offsets,
+                                                      d_offsets + 1));
+
+        void* d_temporary_storage;
+        HIP_CHECK(
+            test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+
+        HIP_CHECK(rocprim::segmented_merge_sort_pairs(d_temporary_storage,
+                                                      temporary_storage_bytes,
+                                                      d_keys_input,
+                                                      d_keys_output,
+                                                      d_values_input,
+                                                      d_values_output,
+                                                      size,
+                                                      segments_count,
+                                                      d_offsets,
+                                                      d_offsets + 1));
+
+        std::vector<key_type>   keys_output(size);
+        std::vector<value_type> values_output(size);
+        HIP_CHECK(hipMemcpy(keys_output.data(),
+                            d_keys_output,
+                            size * sizeof(key_type),
+                            hipMemcpyDeviceToHost));
+        HIP_CHECK(hipMemcpy(values_output.data(),
+                            d_values_output,
+                            size * sizeof(value_type),
+                            hipMemcpyDeviceToHost));
+
+        HIP_CHECK(hipFree(d_temporary_storage));
+        HIP_CHECK(hipFree(d_keys_input));
+        HIP_CHECK(hipFree(d_keys_output));
+        HIP_CHECK(hipFree(d_values_input));
+        HIP_CHECK(hipFree(d_values_output));
+        HIP_CHECK(hipFree(d_offsets));
+
+        std::vector<key_type>   keys_expected(size);
+        std::vector<value_type> values_expected(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            keys_expected[i]   = expected[i].first;
+            values_expected[i] = expected[i].second;
+        }
+        ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(keys_output, keys_expected));
+        ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(values_output, values_expected));
+    }
+}
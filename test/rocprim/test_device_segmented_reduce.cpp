@@ -309,3 +309,292 @@ TYPED_TEST(RocprimDeviceSegmentedReduce, Reduce)
         }
     }
 }
+
+TYPED_TEST(RocprimDeviceSegmentedReduce, ReduceCsr)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using Config
+        = algo_config_t<TestFixture::params::algo, TestFixture::params::use_default_config>;
+
+    using input_type     = typename TestFixture::params::input_type;
+    using output_type    = typename TestFixture::params::output_type;
+    using reduce_op_type = typename TestFixture::params::reduce_op_type;
+    using offset_type    = unsigned int;
+
+    reduce_op_type reduce_op;
+
+    constexpr bool use_identity_iterator = TestFixture::params::use_identity_iterator;
+
+    const input_type init              = input_type{TestFixture::params::init};
+    const bool       debug_synchronous = false;
+
+    std::random_device                    rd;
+    std::default_random_engine            gen(rd());
+    std::uniform_int_distribution<size_t> segment_length_dis(
+        TestFixture::params::min_segment_length,
+        TestFixture::params::max_segment_length);
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        for(size_t size : test_utils::get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            hipStream_t stream = 0; // default
+            if (TestFixture::params::use_graphs)
+            {
+                // Default stream does not support hipGraph stream capture, so create one
+                HIP_CHECK(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+            }
+
+            // Generate data and calculate expected results
+            std::vector<output_type> aggregates_expected;
+
+            std::vector<input_type> values_input
+                = test_utils::get_random_data<input_type>(size, 0, 100, seed_value);
+
+            std::vector<offset_type> offsets;
+            unsigned int             segments_count     = 0;
+            size_t                   offset             = 0;
+            size_t                   max_segment_length = 0;
+            while(offset < size)
+            {
+                const size_t segment_length = segment_length_dis(gen);
+                offsets.push_back(offset);
+
+                const size_t end   = std::min(size, offset + segment_length);
+                max_segment_length = std::max(max_segment_length, end - offset);
+
+                output_type aggregate = init;
+                for(size_t i = offset; i < end; i++)
+                {
+                    aggregate = reduce_op(aggregate, values_input[i]);
+                }
+                aggregates_expected.push_back(aggregate);
+
+                segments_count++;
+                offset += segment_length;
+            }
+            offsets.push_back(size);
+
+            // intermediate results for segmented reduce are stored as output_type,
+            // but reduced by the reduce_op_type operation,
+            // however that opeartion uses the same output_type for all tests
+            const float precision = test_utils::is_plus_operator<reduce_op_type>::value
+                                        ? test_utils::precision<output_type> * max_segment_length
+                                        : 0;
+            if(precision > 0.5)
+            {
+                std::cout << "Test is skipped from size " << size
+                          << " on, potential error of summation is more than 0.5 of the result "
+                             "with current or larger size"
+                          << std::endl;
+                continue;
+            }
+
+            input_type* d_values_input;
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_values_input, size * sizeof(input_type)));
+            HIP_CHECK(hipMemcpy(d_values_input,
+                                values_input.data(),
+                                size * sizeof(input_type),
+                                hipMemcpyHostToDevice));
+
+            offset_type* d_offsets;
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_offsets,
+                                                   (segments_count + 1) * sizeof(offset_type)));
+            HIP_CHECK(hipMemcpy(d_offsets,
+                                offsets.data(),
+                                (segments_count + 1) * sizeof(offset_type),
+                                hipMemcpyHostToDevice));
+
+            output_type* d_aggregates_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_aggregates_output,
+                                                         segments_count * sizeof(output_type)));
+
+            size_t temporary_storage_bytes;
+
+            HIP_CHECK(rocprim::segmented_reduce_csr<Config>(nullptr,
+                                                            temporary_storage_bytes,
+                                                            d_values_input,
+                                                            d_aggregates_output,
+                                                            segments_count,
+                                                            d_offsets,
+                                                            reduce_op,
+                                                            init,
+                                                            stream,
+                                                            debug_synchronous));
+
+            ASSERT_GT(temporary_storage_bytes, 0);
+
+            void* d_temporary_storage;
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+
+            hipGraph_t graph;
+            if(TestFixture::params::use_graphs)
+            {
+                graph = test_utils::createGraphHelper(stream);
+            }
+
+            HIP_CHECK(rocprim::segmented_reduce_csr<Config>(
+                d_temporary_storage,
+                temporary_storage_bytes,
+                d_values_input,
+                test_utils::wrap_in_identity_iterator<use_identity_iterator>(d_aggregates_output),
+                segments_count,
+                d_offsets,
+                reduce_op,
+                init,
+                stream,
+                debug_synchronous));
+
+            hipGraphExec_t graph_instance;
+            if(TestFixture::params::use_graphs)
+            {
+                graph_instance = test_utils::endCaptureGraphHelper(graph, stream, true, true);
+            }
+
+            HIP_CHECK(hipFree(d_temporary_storage));
+
+            std::vector<output_type> aggregates_output(segments_count);
+            HIP_CHECK(hipMemcpy(aggregates_output.data(),
+                                d_aggregates_output,
+                                segments_count * sizeof(output_type),
+                                hipMemcpyDeviceToHost));
+
+            HIP_CHECK(hipFree(d_values_input));
+            HIP_CHECK(hipFree(d_offsets));
+            HIP_CHECK(hipFree(d_aggregates_output));
+
+            if (TestFixture::params::use_graphs)
+            {
+                test_utils::cleanupGraphHelper(graph, graph_instance);
+                HIP_CHECK(hipStreamDestroy(stream));
+            }
+            
+            ASSERT_NO_FATAL_FAILURE(
+                test_utils::assert_near(aggregates_output, aggregates_expected, precision));
+        }
+    }
+}
+
+TEST(RocprimDeviceSegmentedReduceCsr, ReduceSkewed)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using value_type  = int;
+    using offset_type = unsigned int;
+
+    const value_type init              = 7;
+    const bool       debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        std::default_random_engine gen(seed_value);
+        // Mostly empty and short rows with a few very long ones, the long rows span
+        // many blocks
+        std::uniform_int_distribution<size_t> kind_dis(0, 99);
+        std::uniform_int_distribution<size_t> short_length_dis(1, 5);
+        std::uniform_int_distribution<size_t> long_length_dis(50000, 500000);
+
+        std::vector<offset_type> offsets{0};
+        const unsigned int       segments_count = 20000;
+        for(unsigned int segment = 0; segment < segments_count; segment++)
+        {
+            const size_t kind   = kind_dis(gen);
+            const size_t length = kind < 50   ? 0
+                                  : kind < 99 ? short_length_dis(gen)
+                                              : long_length_dis(gen);
+            offsets.push_back(offsets.back() + static_cast<offset_type>(length));
+        }
+        const size_t size = offsets.back();
+
+        std::vector<value_type> values_input
+            = test_utils::get_random_data<value_type>(size, -100, 100, seed_value);
+
+        std::vector<value_type> aggregates_expected(segments_count);
+        for(unsigned int segment = 0; segment < segments_count; segment++)
+        {
+            value_type aggregate = init;
+            for(size_t i = offsets[segment]; i < offsets[segment + 1]; i++)
+            {
+                aggregate += values_input[i];
+            }
+            aggregates_expected[segment] = aggregate;
+        }
+
+        value_type* d_values_input;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_values_input, size * sizeof(value_type)));
+        HIP_CHECK(hipMemcpy(d_values_input,
+                            values_input.data(),
+                            size * sizeof(value_type),
+                            hipMemcpyHostToDevice));
+
+        offset_type* d_offsets;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_offsets,
+                                                     offsets.size() * sizeof(offset_type)));
+        HIP_CHECK(hipMemcpy(d_offsets,
+                            offsets.data(),
+                            offsets.size() * sizeof(offset_type),
+                            hipMemcpyHostToDevice));
+
+        value_type* d_aggregates_output;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_aggregates_output,
+                                                     segments_count * sizeof(value_type)));
+
+        size_t temporary_storage_bytes;
+        HIP_CHECK(rocprim::segmented_reduce_csr(nullptr,
+                                                temporary_storage_bytes,
+                                                d_values_input,
+                                                d_aggregates_output,
+                                                segments_count,
+                                                d_offsets,
+                                                rocprim::plus<value_type>(),
+                                                init,
+                                                hipStream_t(0),
+                                                debug_synchronous));
+
+        void* d_temporary_storage;
+        HIP_CHECK(
+            test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+
+        HIP_CHECK(rocprim::segmented_reduce_csr(d_temporary_storage,
+                                                temporary_storage_bytes,
+                                                d_values_input,
+                                                d_aggregates_output,
+                                                segments_count,
+                                                d_offsets,
+                                                rocprim::plus<value_type>(),
+                                                init,
+                                                hipStream_t(0),
+                                                debug_synchronous));
+
+        std::vector<value_type> aggregates_output(segments_count);
+        HIP_CHECK(hipMemcpy(aggregates_output.data(),
+                            d_aggregates_output,
+                            segments_count * sizeof(value_type),
+                            hipMemcpyDeviceToHost));
+
+        HIP_CHECK(hipFree(d_temporary_storage));
+        HIP_CHECK(hipFree(d_values_input));
+        HIP_CHECK(hipFree(d_offsets));
+        HIP_CHECK(hipFree(d_aggregates_output));
+
+        ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(aggregates_output, aggregates_expected));
+    }
+}
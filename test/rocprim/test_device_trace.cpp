@@ -0,0 +1,343 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_radix_sort.hpp>
+#include <rocprim/device/device_reduce.hpp>
+#include <rocprim/device/device_scan.hpp>
+#include <rocprim/device/device_select.hpp>
+#include <rocprim/device/device_trace.hpp>
+#include <rocprim/functional.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+
+void collect_trace_event(const rocprim::trace_event& event, void* user_data)
+{
+    static_cast<std::vector<rocprim::trace_event>*>(user_data)->push_back(event);
+}
+
+// Checks the fields that every traced kernel reports
+void check_trace_events(const std::vector<rocprim::trace_event>& events,
+                        const char*                              algorithm,
+                        const size_t                             storage_size,
+                        const hipStream_t                        stream,
+                        const bool                               timed)
+{
+    ASSERT_FALSE(events.empty());
+    bool has_storage_size = false;
+    for(const rocprim::trace_event& event : events)
+    {
+        SCOPED_TRACE(testing::Message() << "with kernel = " << event.kernel);
+        ASSERT_STREQ(event.algorithm, algorithm);
+        ASSERT_NE(event.kernel, nullptr);
+        ASSERT_GT(event.grid_size, 0u);
+        ASSERT_GT(event.block_size, 0u);
+        ASSERT_EQ(event.stream, stream);
+        if(timed)
+        {
+            ASSERT_GE(event.elapsed_ms, 0.0f);
+        }
+        else
+        {
+            ASSERT_LT(event.elapsed_ms, 0.0f);
+        }
+        // Nested calls report the size of their own temporary storage
+        has_storage_size = has_storage_size || event.temporary_storage_bytes == storage_size;
+    }
+    ASSERT_TRUE(has_storage_size);
+}
+
+// Items processed by the kernels called kernel
+size_t traced_size(const std::vector<rocprim::trace_event>& events, const char* kernel)
+{
+    size_t size = 0;
+    for(const rocprim::trace_event& event : events)
+    {
+        if(std::strcmp(event.kernel, kernel) == 0)
+        {
+            size += event.size;
+        }
+    }
+    return size;
+}
+
+} // namespace
+
+TEST(RocprimDeviceTraceTests, Reduce)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using T                       = unsigned int;
+    const bool  debug_synchronous = false;
+    hipStream_t stream            = 0; // default
+
+    for(size_t size : {size_t(100), size_t(1) << 20})
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        std::vector<T> input(size);
+        std::iota(input.begin(), input.end(), T(0));
+
+        T* d_input;
+        T* d_output;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(T)));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, sizeof(T)));
+        HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+
+        std::vector<rocprim::trace_event> events;
+        rocprim::trace_scope              scope(collect_trace_event, &events);
+
+        size_t storage_size;
+        HIP_CHECK(rocprim::reduce(nullptr,
+                                  storage_size,
+                                  d_input,
+                                  d_output,
+                                  size,
+                                  rocprim::plus<T>(),
+                                  stream,
+                                  debug_synchronous));
+        // The size query does not launch kernels
+        ASSERT_TRUE(events.empty());
+
+        void* d_temp_storage;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, storage_size));
+        HIP_CHECK(rocprim::reduce(d_temp_storage,
+                                  storage_size,
+                                  d_input,
+                                  d_output,
+                                  size,
+                                  rocprim::plus<T>(),
+                                  stream,
+                                  debug_synchronous));
+        HIP_CHECK(hipGetLastError());
+
+        check_trace_events(events, "reduce", storage_size, stream, false);
+
+        T output;
+        HIP_CHECK(hipMemcpy(&output, d_output, sizeof(T), hipMemcpyDeviceToHost));
+        ASSERT_EQ(output, std::accumulate(input.begin(), input.end(), T(0)));
+
+        HIP_CHECK(hipFree(d_input));
+        HIP_CHECK(hipFree(d_output));
+        HIP_CHECK(hipFree(d_temp_storage));
+    }
+}
+
+TEST(RocprimDeviceTraceTests, InclusiveScanTimed)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using T                       = unsigned int;
+    const bool  debug_synchronous = false;
+    hipStream_t stream;
+    HIP_CHECK(hipStreamCreate(&stream));
+
+    for(size_t size : {size_t(100), size_t(1) << 20})
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        std::vector<T> input(size, T(1));
+
+        T* d_input;
+        T* d_output;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(T)));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, size * sizeof(T)));
+        HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+
+        std::vector<rocprim::trace_event> events;
+        {
+            rocprim::trace_scope scope(collect_trace_event, &events, true);
+
+            size_t storage_size;
+            HIP_CHECK(rocprim::inclusive_scan(nullptr,
+                                              storage_size,
+                                              d_input,
+                                              d_output,
+                                              size,
+                                              rocprim::plus<T>(),
+                                              stream,
+                                              debug_synchronous));
+            void* d_temp_storage;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, storage_size));
+            HIP_CHECK(rocprim::inclusive_scan(d_temp_storage,
+                                              storage_size,
+                                              d_input,
+                                              d_output,
+                                              size,
+                                              rocprim::plus<T>(),
+                                              stream,
+                                              debug_synchronous));
+            HIP_CHECK(hipGetLastError());
+
+            // Waits for the delayed callbacks of the timed kernels
+            HIP_CHECK(rocprim::flush_trace());
+            check_trace_events(events, "inclusive_scan", storage_size, stream, true);
+
+            // Every item is scanned by exactly one kernel
+            ASSERT_EQ(traced_size(events, "lookback_scan_kernel")
+                          + traced_size(events, "single_scan_kernel")
+                          + traced_size(events, "reduce_then_scan_downsweep_kernel"),
+                      size);
+
+            HIP_CHECK(hipFree(d_temp_storage));
+        }
+
+        std::vector<T> output(size);
+        HIP_CHECK(hipMemcpy(output.data(), d_output, size * sizeof(T), hipMemcpyDeviceToHost));
+        for(size_t i = 0; i < size; i++)
+        {
+            ASSERT_EQ(output[i], T(i + 1)) << "where index = " << i;
+        }
+
+        HIP_CHECK(hipFree(d_input));
+        HIP_CHECK(hipFree(d_output));
+    }
+
+    HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST(RocprimDeviceTraceTests, RadixSortAndSelect)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using T                       = unsigned int;
+    const bool  debug_synchronous = false;
+    hipStream_t stream            = 0; // default
+    const size_t size             = size_t(1) << 22;
+
+    const std::vector<T> input = test_utils::get_random_data<T>(size, 0, 1000, 42);
+
+    T*            d_input;
+    T*            d_output;
+    unsigned int* d_selected_count;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(T)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, size * sizeof(T)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_selected_count, sizeof(unsigned int)));
+    HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+
+    std::vector<rocprim::trace_event> events;
+    rocprim::set_trace_callback(collect_trace_event, &events);
+
+    size_t storage_size;
+    HIP_CHECK(rocprim::radix_sort_keys(nullptr,
+                                       storage_size,
+                                       d_input,
+                                       d_output,
+                                       size,
+                                       0,
+                                       8 * sizeof(T),
+                                       stream,
+                                       debug_synchronous));
+    void* d_temp_storage;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, storage_size));
+    HIP_CHECK(rocprim::radix_sort_keys(d_temp_storage,
+                                       storage_size,
+                                       d_input,
+                                       d_output,
+                                       size,
+                                       0,
+                                       8 * sizeof(T),
+                                       stream,
+                                       debug_synchronous));
+    HIP_CHECK(hipGetLastError());
+    HIP_CHECK(hipFree(d_temp_storage));
+
+    check_trace_events(events, "radix_sort", storage_size, stream, false);
+    ASSERT_EQ(traced_size(events, "onesweep_iteration") % size, 0u);
+    ASSERT_GT(traced_size(events, "onesweep_iteration"), 0u);
+    events.clear();
+
+    // A thread-local scope without callback disables the global callback
+    {
+        rocprim::trace_scope scope(nullptr);
+        HIP_CHECK(rocprim::select(nullptr,
+                                  storage_size,
+                                  d_input,
+                                  d_output,
+                                  d_selected_count,
+                                  size,
+                                  rocprim::identity<T>(),
+                                  stream,
+                                  debug_synchronous));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_temp_storage, storage_size));
+        HIP_CHECK(rocprim::select(d_temp_storage,
+                                  storage_size,
+                                  d_input,
+                                  d_output,
+                                  d_selected_count,
+                                  size,
+                                  rocprim::identity<T>(),
+                                  stream,
+                                  debug_synchronous));
+        HIP_CHECK(hipGetLastError());
+        ASSERT_TRUE(events.empty());
+    }
+
+    HIP_CHECK(rocprim::select(d_temp_storage,
+                              storage_size,
+                              d_input,
+                              d_output,
+                              d_selected_count,
+                              size,
+                              rocprim::identity<T>(),
+                              stream,
+                              debug_synchronous));
+    HIP_CHECK(hipGetLastError());
+    check_trace_events(events, "select", storage_size, stream, false);
+    ASSERT_EQ(traced_size(events, "partition_kernel"), size);
+
+    rocprim::set_trace_callback(nullptr);
+    events.clear();
+    HIP_CHECK(rocprim::select(d_temp_storage,
+                              storage_size,
+                              d_input,
+                              d_output,
+                              d_selected_count,
+                              size,
+                              rocprim::identity<T>(),
+                              stream,
+                              debug_synchronous));
+    HIP_CHECK(hipGetLastError());
+    ASSERT_TRUE(events.empty());
+
+    HIP_CHECK(hipFree(d_temp_storage));
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_selected_count));
+}
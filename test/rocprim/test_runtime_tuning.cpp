@@ -0,0 +1,301 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Compile the runtime tuning to test its candidate configs
+#define ROCPRIM_RUNTIME_TUNING 1
+
+#include "../common_test_header.hpp"
+
+#include <rocprim/device/detail/runtime_tuning.hpp>
+#include <rocprim/device/device_reduce.hpp>
+#include <rocprim/device/device_scan.hpp>
+
+#include "test_utils_data_generation.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using rocprim::detail::runtime_tuning_candidate_count;
+using rocprim::detail::runtime_tuning_samples;
+using rocprim::detail::runtime_tuning_state;
+
+TEST(RocprimRuntimeTuningTests, CandidateNames)
+{
+    using rocprim::detail::runtime_tuning_candidate_from_name;
+    using rocprim::detail::runtime_tuning_candidate_name;
+
+    for(unsigned int candidate = 0; candidate < runtime_tuning_candidate_count; ++candidate)
+    {
+        ASSERT_EQ(runtime_tuning_candidate_from_name(runtime_tuning_candidate_name(candidate)),
+                  candidate);
+    }
+    ASSERT_EQ(runtime_tuning_candidate_from_name("gfx000"), runtime_tuning_candidate_count);
+    ASSERT_EQ(runtime_tuning_candidate_from_name(""), runtime_tuning_candidate_count);
+}
+
+TEST(RocprimRuntimeTuningTests, Key)
+{
+    using rocprim::detail::make_runtime_tuning_key;
+    using rocprim::detail::size_bucket;
+
+    ASSERT_EQ(make_runtime_tuning_key("gfx942:sramecc+:xnack-", "reduce", "i", size_bucket::small),
+              "gfx942 reduce i small");
+    ASSERT_EQ(make_runtime_tuning_key("gfx1100", "inclusive_scan", "f", size_bucket::large),
+              "gfx1100 inclusive_scan f large");
+}
+
+TEST(RocprimRuntimeTuningTests, TypeName)
+{
+    using rocprim::detail::runtime_tuning_type_name;
+
+    struct custom_type
+    {
+        int  a;
+        char b;
+    };
+
+    ASSERT_EQ(runtime_tuning_type_name<int>(), "int32");
+    ASSERT_EQ(runtime_tuning_type_name<const unsigned long long>(), "uint64");
+    ASSERT_EQ(runtime_tuning_type_name<float>(), "float32");
+    ASSERT_EQ(runtime_tuning_type_name<double>(), "float64");
+    ASSERT_EQ(runtime_tuning_type_name<rocprim::half>(), "float16");
+    ASSERT_EQ(runtime_tuning_type_name<rocprim::bfloat16>(), "bfloat16");
+    ASSERT_EQ(runtime_tuning_type_name<custom_type>(), "bytes64a4");
+}
+
+// Times of the candidates, the first sample of each candidate is slower (as if the kernels
+// had to be loaded)
+double mocked_time(const unsigned int candidate, const unsigned int sample)
+{
+    constexpr double times[runtime_tuning_candidate_count] = {4.0, 3.0, 1.0, 2.0};
+    return times[candidate] * (sample == 0 ? 10.0 : 1.0);
+}
+
+TEST(RocprimRuntimeTuningTests, StateSelectsFastest)
+{
+    runtime_tuning_state state;
+    ASSERT_FALSE(state.is_tuned());
+
+    unsigned int samples[runtime_tuning_candidate_count] = {};
+    unsigned int calls                                   = 0;
+    while(!state.is_tuned())
+    {
+        const unsigned int candidate = state.candidate();
+        ASSERT_LT(candidate, runtime_tuning_candidate_count);
+        // The candidates are timed in turns
+        ASSERT_EQ(samples[candidate], calls / runtime_tuning_candidate_count);
+
+        const bool completed
+            = state.add_sample(candidate, mocked_time(candidate, samples[candidate]));
+        ++samples[candidate];
+        ++calls;
+        ASSERT_EQ(completed, state.is_tuned());
+    }
+    ASSERT_EQ(calls, runtime_tuning_candidate_count * runtime_tuning_samples);
+    ASSERT_EQ(state.candidate(), 2u);
+
+    // Samples after the tuning are ignored
+    ASSERT_FALSE(state.add_sample(0, 0.0));
+    ASSERT_EQ(state.candidate(), 2u);
+}
+
+TEST(RocprimRuntimeTuningTests, StateUsesBestSample)
+{
+    runtime_tuning_state state;
+    for(unsigned int sample = 0; sample < runtime_tuning_samples; ++sample)
+    {
+        for(unsigned int candidate = 0; candidate < runtime_tuning_candidate_count; ++candidate)
+        {
+            // Candidate 1 is the fastest, except in its first sample
+            const double time = candidate == 1 ? (sample == 0 ? 100.0 : 0.5) : 1.0;
+            state.add_sample(candidate, time);
+        }
+    }
+    ASSERT_TRUE(state.is_tuned());
+    ASSERT_EQ(state.candidate(), 1u);
+}
+
+TEST(RocprimRuntimeTuningTests, CacheReadWrite)
+{
+    using rocprim::detail::read_runtime_tuning_cache;
+    using rocprim::detail::write_runtime_tuning_cache_entry;
+
+    std::stringstream cache;
+    write_runtime_tuning_cache_entry(cache, "gfx942 reduce i large", 1);
+    write_runtime_tuning_cache_entry(cache, "gfx942 reduce f small", 3);
+    cache << "gfx942 reduce d medium gfx000\n"; // Unknown candidate
+    cache << "gfx942 reduce d\n"; // Malformed
+    cache << "\n";
+    write_runtime_tuning_cache_entry(cache, "gfx942 reduce i large", 2); // Overrides the first
+
+    std::map<std::string, runtime_tuning_state> states;
+    read_runtime_tuning_cache(cache, states);
+
+    ASSERT_EQ(states.size(), 2u);
+    ASSERT_TRUE(states["gfx942 reduce i large"].is_tuned());
+    ASSERT_EQ(states["gfx942 reduce i large"].candidate(), 2u);
+    ASSERT_TRUE(states["gfx942 reduce f small"].is_tuned());
+    ASSERT_EQ(states["gfx942 reduce f small"].candidate(), 3u);
+}
+
+TEST(RocprimRuntimeTuningTests, TunerPersistsSelection)
+{
+    using rocprim::detail::runtime_tuner;
+
+    ASSERT_FALSE(runtime_tuner("").enabled());
+
+    const std::string path = ::testing::TempDir() + "rocprim_test_runtime_tuning_cache.txt";
+    std::remove(path.c_str());
+
+    const std::string key = "gfx942 reduce i large";
+    {
+        runtime_tuner tuner(path);
+        ASSERT_TRUE(tuner.enabled());
+
+        unsigned int samples[runtime_tuning_candidate_count] = {};
+        bool         is_tuned                                = false;
+        unsigned int candidate                               = tuner.candidate(key, is_tuned);
+        while(!is_tuned)
+        {
+            tuner.add_sample(key, candidate, mocked_time(candidate, samples[candidate]++));
+            candidate = tuner.candidate(key, is_tuned);
+        }
+        ASSERT_EQ(candidate, 2u);
+
+        // Other keys are tuned separately
+        const std::string other_key = "gfx942 reduce f large";
+        candidate                   = tuner.candidate(other_key, is_tuned);
+        ASSERT_FALSE(is_tuned);
+        std::fill(samples, samples + runtime_tuning_candidate_count, 0u);
+        while(!is_tuned)
+        {
+            tuner.add_sample(other_key, candidate, mocked_time(candidate, samples[candidate]++));
+            candidate = tuner.candidate(other_key, is_tuned);
+        }
+    }
+
+    // Replacing the cache file keeps the entries of earlier keys
+    {
+        runtime_tuner tuner(path);
+        bool          is_tuned = false;
+        tuner.candidate("gfx942 reduce f large", is_tuned);
+        ASSERT_TRUE(is_tuned);
+    }
+
+    // A new process reuses the selection
+    runtime_tuner tuner(path);
+    bool          is_tuned  = false;
+    unsigned int  candidate = tuner.candidate(key, is_tuned);
+    ASSERT_TRUE(is_tuned);
+    ASSERT_EQ(candidate, 2u);
+
+    std::remove(path.c_str());
+}
+
+// All candidates must produce the same results
+template<rocprim::detail::target_arch Arch>
+void test_candidate()
+{
+    using config = rocprim::detail::fixed_arch_config<rocprim::default_config, Arch>;
+    using T      = int;
+
+    const hipStream_t stream = 0;
+    for(size_t size : test_utils::get_sizes(0))
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+        if(size == 0)
+        {
+            continue;
+        }
+
+        std::vector<T> input(size);
+        for(size_t i = 0; i < size; ++i)
+        {
+            input[i] = static_cast<T>(i % 7);
+        }
+        std::vector<T> expected(size);
+        std::partial_sum(input.begin(), input.end(), expected.begin());
+
+        T* d_input;
+        T* d_output;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(T)));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, size * sizeof(T)));
+        HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+
+        size_t reduce_storage_bytes;
+        HIP_CHECK(rocprim::reduce<config>(nullptr, reduce_storage_bytes, d_input, d_output, size));
+        size_t scan_storage_bytes;
+        HIP_CHECK(rocprim::inclusive_scan<config>(nullptr,
+                                                  scan_storage_bytes,
+                                                  d_input,
+                                                  d_output,
+                                                  size,
+                                                  rocprim::plus<T>(),
+                                                  stream));
+
+        void* d_temporary_storage;
+        HIP_CHECK(test_common_utils::hipMallocHelper(
+            &d_temporary_storage,
+            std::max(reduce_storage_bytes, scan_storage_bytes)));
+
+        HIP_CHECK(rocprim::reduce<config>(d_temporary_storage,
+                                          reduce_storage_bytes,
+                                          d_input,
+                                          d_output,
+                                          size,
+                                          rocprim::plus<T>(),
+                                          stream));
+        T reduction;
+        HIP_CHECK(hipMemcpy(&reduction, d_output, sizeof(T), hipMemcpyDeviceToHost));
+        ASSERT_EQ(reduction, expected.back());
+
+        HIP_CHECK(rocprim::inclusive_scan<config>(d_temporary_storage,
+                                                  scan_storage_bytes,
+                                                  d_input,
+                                                  d_output,
+                                                  size,
+                                                  rocprim::plus<T>(),
+                                                  stream));
+        std::vector<T> output(size);
+        HIP_CHECK(hipMemcpy(output.data(), d_output, size * sizeof(T), hipMemcpyDeviceToHost));
+        ASSERT_EQ(output, expected);
+
+        HIP_CHECK(hipFree(d_input));
+        HIP_CHECK(hipFree(d_output));
+        HIP_CHECK(hipFree(d_temporary_storage));
+    }
+}
+
+TEST(RocprimRuntimeTuningTests, Candidates)
+{
+    const int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    test_candidate<rocprim::detail::target_arch::gfx90a>();
+    test_candidate<rocprim::detail::target_arch::gfx1030>();
+    test_candidate<rocprim::detail::target_arch::gfx1102>();
+}
@@ -149,7 +149,11 @@ typedef ::testing::Types<
     warp_sort_param_type(int, 4),
     warp_sort_param_type(test_utils::custom_test_type<int>, 4),
     warp_sort_param_type(uint8_t, 4),
-    warp_sort_param_type(int8_t, 4)
+    warp_sort_param_type(int8_t, 4),
+    warp_sort_param_type(int, 8),
+    warp_sort_param_type(int, 16),
+    warp_sort_param_type(int, 32),
+    warp_sort_param_type(test_utils::custom_test_type<int>, 32)
 > WarpSortParamsIntegralMultiThread;
 
 typedef ::testing::Types<
@@ -1,6 +1,6 @@
 // MIT License
 //
-// Copyright (c) 2017-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -268,3 +268,119 @@ typed_test_def(RocprimWarpSortShuffleBasedTests, name_suffix, SortKeyInt)
     }
 
 }
+
+typed_test_def(RocprimWarpSortShuffleBasedTests, name_suffix, StableSortKeyValue)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id = " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    // logical warp side for warp primitive, execution warp size is always rocprim::warp_size()
+    using T = typename TestFixture::params::type;
+    // Values are the input positions, wider than 4 bytes to test the large value paths
+    using V = long long;
+
+    static constexpr size_t logical_warp_size = TestFixture::params::warp_size;
+    static constexpr size_t items_per_thread  = TestFixture::params::items_per_thread;
+
+    // The different warp sizes
+    static constexpr size_t ws32 = size_t(ROCPRIM_WARP_SIZE_32);
+    static constexpr size_t ws64 = size_t(ROCPRIM_WARP_SIZE_64);
+
+    unsigned int current_device_warp_size;
+    HIP_CHECK(::rocprim::host_warp_size(device_id, current_device_warp_size));
+    static constexpr size_t block_size = std::max<size_t>(256U, logical_warp_size * 4);
+
+    static constexpr unsigned int grid_size = 4;
+    const size_t                  size      = items_per_thread * block_size * grid_size;
+
+    SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+    // Check if warp size is supported
+    if(logical_warp_size > current_device_warp_size
+       || !rocprim::detail::is_power_of_two(logical_warp_size)
+       || (current_device_warp_size != ws32
+           && current_device_warp_size != ws64)) // Only WarpSize 32 and 64 is supported
+    {
+        printf("Unsupported test warp size/computed block size: %zu/%zu. Current device warp "
+               "size: %u.    Skipping test\n",
+               logical_warp_size,
+               block_size,
+               current_device_warp_size);
+        GTEST_SKIP();
+    }
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed = " << seed_value);
+
+        // Generate data, a narrow range of keys has many equivalent keys
+        std::vector<T> output_key = test_utils::get_random_data<T>(size, 0, 10, seed_value);
+        std::vector<V> output_value(size);
+        std::iota(output_value.begin(), output_value.end(), 0);
+
+        // The kernel loads the items warp-striped, so the input order is the order in memory
+        std::vector<size_t> expected_order(size);
+        std::iota(expected_order.begin(), expected_order.end(), 0);
+        const size_t items_per_warp = logical_warp_size * items_per_thread;
+        for(size_t i = 0; i < size / items_per_warp; i++)
+        {
+            std::stable_sort(expected_order.begin() + i * items_per_warp,
+                             expected_order.begin() + (i + 1) * items_per_warp,
+                             [&](const size_t a, const size_t b)
+                             { return rocprim::less<T>()(output_key[a], output_key[b]); });
+        }
+        std::vector<T> expected_key(size);
+        std::vector<V> expected_value(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            expected_key[i]   = output_key[expected_order[i]];
+            expected_value[i] = static_cast<V>(expected_order[i]);
+        }
+
+        // Writing to device memory
+        T* d_output_key;
+        V* d_output_value;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_output_key, size * sizeof(T)));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_output_value, size * sizeof(V)));
+        HIP_CHECK(
+            hipMemcpy(d_output_key, output_key.data(), size * sizeof(T), hipMemcpyHostToDevice));
+        HIP_CHECK(hipMemcpy(d_output_value,
+                            output_value.data(),
+                            size * sizeof(V),
+                            hipMemcpyHostToDevice));
+
+        // Launching kernel
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(test_hip_stable_sort_key_value_kernel<items_per_thread,
+                                                                                 block_size,
+                                                                                 logical_warp_size,
+                                                                                 T,
+                                                                                 V>),
+                           dim3(grid_size),
+                           dim3(block_size),
+                           0,
+                           0,
+                           d_output_key,
+                           d_output_value);
+
+        HIP_CHECK(hipGetLastError());
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Read from device memory
+        HIP_CHECK(
+            hipMemcpy(output_key.data(), d_output_key, size * sizeof(T), hipMemcpyDeviceToHost));
+        HIP_CHECK(hipMemcpy(output_value.data(),
+                            d_output_value,
+                            size * sizeof(V),
+                            hipMemcpyDeviceToHost));
+
+        // Stable: the values (input positions) of equivalent keys must be in input order
+        test_utils::assert_eq(output_key, expected_key);
+        test_utils::assert_eq(output_value, expected_value);
+
+        HIP_CHECK(hipFree(d_output_key));
+        HIP_CHECK(hipFree(d_output_value));
+    }
+}
@@ -1,6 +1,6 @@
 // MIT License
 //
-// Copyright (c) 2017-2021 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2017-2024 Advanced Micro Devices, Inc. All rights reserved.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -156,4 +156,51 @@ auto test_hip_sort_key_value_kernel(KeyType* /*device_key_output*/, ValueType* /
     // of the current device is less than the tested LogicalWarpSize
 }
 
+template<
+    unsigned int ItemsPerThread,
+    unsigned int BlockSize,
+    unsigned int LogicalWarpSize,
+    class KeyType,
+    class ValueType
+>
+__global__
+__launch_bounds__(BlockSize)
+auto test_hip_stable_sort_key_value_kernel(KeyType* device_key_output, ValueType* device_value_output)
+    -> typename std::enable_if<
+        (LogicalWarpSize <= ::rocprim::device_warp_size()), void
+    >::type
+{
+    const unsigned int lid = threadIdx.x;
+    const unsigned int block_offset = blockIdx.x * ItemsPerThread * BlockSize;
+
+    KeyType keys[ItemsPerThread];
+    ValueType values[ItemsPerThread];
+    ::rocprim::block_load_direct_warp_striped<LogicalWarpSize>(lid, device_key_output + block_offset, keys);
+    ::rocprim::block_load_direct_warp_striped<LogicalWarpSize>(lid, device_value_output + block_offset, values);
+
+    rocprim::warp_sort<KeyType, LogicalWarpSize, ValueType> wsort;
+    wsort.stable_sort(keys, values);
+
+    ::rocprim::block_store_direct_blocked(lid, device_key_output + block_offset, keys);
+    ::rocprim::block_store_direct_blocked(lid, device_value_output + block_offset, values);
+}
+
+template<
+    unsigned int ItemsPerThread,
+    unsigned int BlockSize,
+    unsigned int LogicalWarpSize,
+    class KeyType,
+    class ValueType
+>
+__global__
+__launch_bounds__(BlockSize)
+auto test_hip_stable_sort_key_value_kernel(KeyType* /*device_key_output*/, ValueType* /*device_value_output*/)
+    -> typename std::enable_if<
+        (LogicalWarpSize > ::rocprim::device_warp_size()), void
+    >::type
+{
+    // This kernel will never be actually called, the tests are filtered at runtime if the warp size
+    // of the current device is less than the tested LogicalWarpSize
+}
+
 #endif // TEST_WARP_SORT_KERNELS_HPP_